@@ -42,7 +42,7 @@
 
 %global systemd_units NetworkManager.service NetworkManager-wait-online.service NetworkManager-dispatcher.service
 
-%global systemd_units_cloud_setup nm-cloud-setup.service nm-cloud-setup.timer
+%global systemd_units_cloud_setup nm-cloud-setup.service nm-cloud-setup.timer nm-cloud-setup-periodic.service
 
 ###############################################################################
 
@@ -1150,6 +1150,7 @@ fi
 %files cloud-setup
 %{_libexecdir}/nm-cloud-setup
 %{systemd_dir}/nm-cloud-setup.service
+%{systemd_dir}/nm-cloud-setup-periodic.service
 %{systemd_dir}/nm-cloud-setup.timer
 %{nmlibdir}/dispatcher.d/90-nm-cloud-setup.sh
 %{nmlibdir}/dispatcher.d/no-wait.d/90-nm-cloud-setup.sh
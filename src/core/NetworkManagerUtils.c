@@ -1207,6 +1207,10 @@ nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, i
             GET_ATTR("burst", qdisc->tbf.burst, UINT32, uint32, 0);
             GET_ATTR("limit", qdisc->tbf.limit, UINT32, uint32, 0);
             GET_ATTR("latency", qdisc->tbf.latency, UINT32, uint32, 0);
+        } else if (nm_streq(qdisc->kind, "htb")) {
+            /* like tc, default to a rate2quantum of 10. */
+            GET_ATTR("r2q", qdisc->htb.rate2quantum, UINT32, uint32, 10);
+            GET_ATTR("default", qdisc->htb.defcls, UINT32, uint32, 0);
         }
 #undef GET_ATTR
 
@@ -1216,6 +1220,57 @@ nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, i
     return qdiscs;
 }
 
+/* The returned tclass array is valid as long as s_tc is not modified */
+GPtrArray *
+nm_utils_tclasses_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex)
+{
+    GPtrArray *tclasses;
+    guint      ntclasses;
+    guint      i;
+
+    ntclasses = nm_setting_tc_config_get_num_tclasses(s_tc);
+    tclasses  = g_ptr_array_new_full(ntclasses, (GDestroyNotify) nmp_object_unref);
+
+    for (i = 0; i < ntclasses; i++) {
+        NMTCTclass *      s_tclass = nm_setting_tc_config_get_tclass(s_tc, i);
+        NMPObject *       c        = nmp_object_new(NMP_OBJECT_TYPE_TCLASS, NULL);
+        NMPlatformTclass *tclass   = NMP_OBJECT_CAST_TCLASS(c);
+
+        tclass->ifindex     = ip_ifindex;
+        tclass->kind        = nm_tc_tclass_get_kind(s_tclass);
+        tclass->addr_family = AF_UNSPEC;
+        tclass->handle      = nm_tc_tclass_get_handle(s_tclass);
+        tclass->parent      = nm_tc_tclass_get_parent(s_tclass);
+        tclass->info        = 0;
+
+#define GET_ATTR(name, dst, variant_type, type, dflt)                                  \
+    G_STMT_START                                                                       \
+    {                                                                                  \
+        GVariant *_variant = nm_tc_tclass_get_attribute(s_tclass, "" name "");         \
+                                                                                       \
+        if (_variant && g_variant_is_of_type(_variant, G_VARIANT_TYPE_##variant_type)) \
+            (dst) = g_variant_get_##type(_variant);                                    \
+        else                                                                           \
+            (dst) = (dflt);                                                            \
+    }                                                                                  \
+    G_STMT_END
+
+        if (nm_streq(tclass->kind, "htb")) {
+            GET_ATTR("rate", tclass->htb.rate, UINT64, uint64, 0);
+            GET_ATTR("ceil", tclass->htb.ceil, UINT64, uint64, 0);
+            GET_ATTR("burst", tclass->htb.burst, UINT32, uint32, 0);
+            GET_ATTR("cburst", tclass->htb.cburst, UINT32, uint32, 0);
+            GET_ATTR("quantum", tclass->htb.quantum, UINT32, uint32, 0);
+            GET_ATTR("prio", tclass->htb.prio, UINT32, uint32, 0);
+        }
+#undef GET_ATTR
+
+        g_ptr_array_add(tclasses, c);
+    }
+
+    return tclasses;
+}
+
 /* The returned tfilter array is valid as long as s_tc is not modified */
 GPtrArray *
 nm_utils_tfilters_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex)
@@ -1696,8 +1751,20 @@ nm_platform_get()
 
 /*****************************************************************************/
 
+void
+nm_linux_platform_setup_full(gboolean       netlink_reader_thread,
+                             const guint32 *ignored_route_tables,
+                             guint          n_ignored_route_tables)
+{
+    nm_platform_setup(nm_linux_platform_new_full(FALSE,
+                                                 FALSE,
+                                                 netlink_reader_thread,
+                                                 ignored_route_tables,
+                                                 n_ignored_route_tables));
+}
+
 void
 nm_linux_platform_setup(void)
 {
-    nm_platform_setup(nm_linux_platform_new(FALSE, FALSE));
+    nm_linux_platform_setup_full(FALSE, NULL, 0);
 }
@@ -145,6 +145,8 @@ const char *nm_utils_file_is_in_path(const char *abs_filename, const char *abs_p
 GPtrArray *
 nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex);
 GPtrArray *
+nm_utils_tclasses_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex);
+GPtrArray *
 nm_utils_tfilters_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex);
 
 void nm_utils_ip_route_attribute_to_platform(int                addr_family,
@@ -232,6 +234,9 @@ NMPlatform *nm_platform_get(void);
 #define NM_PLATFORM_GET (nm_platform_get())
 
 void nm_linux_platform_setup(void);
+void nm_linux_platform_setup_full(gboolean       netlink_reader_thread,
+                                  const guint32 *ignored_route_tables,
+                                  guint          n_ignored_route_tables);
 
 /*****************************************************************************/
 
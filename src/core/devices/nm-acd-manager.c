@@ -15,6 +15,7 @@
 #include "libnm-platform/nm-platform.h"
 #include "nm-utils.h"
 #include "NetworkManagerUtils.h"
+#include "nm-netns.h"
 #include "n-acd/src/n-acd.h"
 
 /*****************************************************************************/
@@ -33,13 +34,13 @@ typedef struct {
 } AddressInfo;
 
 struct _NMAcdManager {
-    int         ifindex;
-    guint8      hwaddr[ETH_ALEN];
-    State       state;
-    GHashTable *addresses;
-    guint       completed;
-    NAcd *      acd;
-    GSource *   event_source;
+    int               ifindex;
+    guint8            hwaddr[ETH_ALEN];
+    State             state;
+    GHashTable *      addresses;
+    guint             completed;
+    NAcd *            acd;
+    NMNetnsAcdHandle *acd_handle;
 
     NMAcdCallbacks callbacks;
     gpointer       user_data;
@@ -171,82 +172,70 @@ nm_acd_manager_add_address(NMAcdManager *self, in_addr_t address)
     return TRUE;
 }
 
-static gboolean
-acd_event(int fd, GIOCondition condition, gpointer data)
+static void
+acd_event(NAcd *acd, NAcdEvent *event, gpointer data)
 {
     NMAcdManager *self = data;
-    NAcdEvent *   event;
     AddressInfo * info;
-    gboolean      emit_probe_terminated = FALSE;
     char          address_str[INET_ADDRSTRLEN];
+    char          to_string_buffer[ACD_EVENT_TO_STRING_BUF_SIZE];
+    gs_free char *hwaddr_str         = NULL;
+    gboolean      check_probing_done = FALSE;
     int           r;
 
-    if (n_acd_dispatch(self->acd))
-        return G_SOURCE_CONTINUE;
-
-    while (!n_acd_pop_event(self->acd, &event) && event) {
-        char          to_string_buffer[ACD_EVENT_TO_STRING_BUF_SIZE];
-        gs_free char *hwaddr_str         = NULL;
-        gboolean      check_probing_done = FALSE;
-
-        switch (event->event) {
-        case N_ACD_EVENT_READY:
-            n_acd_probe_get_userdata(event->ready.probe, (void **) &info);
-            info->duplicate = FALSE;
-            if (self->state == STATE_ANNOUNCING) {
-                /* fake probe ended, start announcing */
-                r = n_acd_probe_announce(info->probe, N_ACD_DEFEND_ONCE);
-                if (r) {
-                    _LOGW("couldn't announce address %s on interface '%s': %s",
-                          _nm_utils_inet4_ntop(info->address, address_str),
-                          nm_platform_link_get_name(NM_PLATFORM_GET, self->ifindex),
-                          acd_error_to_string(r));
-                } else {
-                    _LOGD("announcing address %s",
-                          _nm_utils_inet4_ntop(info->address, address_str));
-                }
-            }
-            check_probing_done = TRUE;
-            break;
-        case N_ACD_EVENT_USED:
-            n_acd_probe_get_userdata(event->used.probe, (void **) &info);
-            info->duplicate    = TRUE;
-            check_probing_done = TRUE;
-            break;
-        case N_ACD_EVENT_DEFENDED:
-            n_acd_probe_get_userdata(event->defended.probe, (void **) &info);
-            _LOGD("defended address %s from host %s",
-                  _nm_utils_inet4_ntop(info->address, address_str),
-                  (hwaddr_str =
-                       nm_utils_hwaddr_ntoa(event->defended.sender, event->defended.n_sender)));
-            break;
-        case N_ACD_EVENT_CONFLICT:
-            n_acd_probe_get_userdata(event->conflict.probe, (void **) &info);
-            _LOGW("conflict for address %s detected with host %s on interface '%s'",
-                  _nm_utils_inet4_ntop(info->address, address_str),
-                  (hwaddr_str =
-                       nm_utils_hwaddr_ntoa(event->defended.sender, event->defended.n_sender)),
-                  nm_platform_link_get_name(NM_PLATFORM_GET, self->ifindex));
-            break;
-        default:
-            _LOGD("unhandled event '%s'", _acd_event_to_string_buf(event->event, to_string_buffer));
-            break;
-        }
+    if (!event) {
+        _LOGD("shared ACD context failed");
+        return;
+    }
 
-        if (check_probing_done && self->state == STATE_PROBING
-            && ++self->completed == g_hash_table_size(self->addresses)) {
-            self->state           = STATE_PROBE_DONE;
-            emit_probe_terminated = TRUE;
+    switch (event->event) {
+    case N_ACD_EVENT_READY:
+        n_acd_probe_get_userdata(event->ready.probe, (void **) &info);
+        info->duplicate = FALSE;
+        if (self->state == STATE_ANNOUNCING) {
+            /* fake probe ended, start announcing */
+            r = n_acd_probe_announce(info->probe, N_ACD_DEFEND_ONCE);
+            if (r) {
+                _LOGW("couldn't announce address %s on interface '%s': %s",
+                      _nm_utils_inet4_ntop(info->address, address_str),
+                      nm_platform_link_get_name(NM_PLATFORM_GET, self->ifindex),
+                      acd_error_to_string(r));
+            } else {
+                _LOGD("announcing address %s", _nm_utils_inet4_ntop(info->address, address_str));
+            }
         }
+        check_probing_done = TRUE;
+        break;
+    case N_ACD_EVENT_USED:
+        n_acd_probe_get_userdata(event->used.probe, (void **) &info);
+        info->duplicate    = TRUE;
+        check_probing_done = TRUE;
+        break;
+    case N_ACD_EVENT_DEFENDED:
+        n_acd_probe_get_userdata(event->defended.probe, (void **) &info);
+        _LOGD("defended address %s from host %s",
+              _nm_utils_inet4_ntop(info->address, address_str),
+              (hwaddr_str =
+                   nm_utils_hwaddr_ntoa(event->defended.sender, event->defended.n_sender)));
+        break;
+    case N_ACD_EVENT_CONFLICT:
+        n_acd_probe_get_userdata(event->conflict.probe, (void **) &info);
+        _LOGW("conflict for address %s detected with host %s on interface '%s'",
+              _nm_utils_inet4_ntop(info->address, address_str),
+              (hwaddr_str = nm_utils_hwaddr_ntoa(event->defended.sender, event->defended.n_sender)),
+              nm_platform_link_get_name(NM_PLATFORM_GET, self->ifindex));
+        break;
+    default:
+        _LOGD("unhandled event '%s'", _acd_event_to_string_buf(event->event, to_string_buffer));
+        break;
     }
 
-    if (emit_probe_terminated) {
-        if (self->callbacks.probe_terminated_callback) {
+    if (check_probing_done && self->state == STATE_PROBING
+        && ++self->completed == g_hash_table_size(self->addresses)) {
+        self->state = STATE_PROBE_DONE;
+        if (self->callbacks.probe_terminated_callback)
             self->callbacks.probe_terminated_callback(self, self->user_data);
-        }
     }
-
-    return G_SOURCE_CONTINUE;
 }
 
 static gboolean
@@ -301,9 +290,13 @@ acd_init(NMAcdManager *self)
     n_acd_config_set_transport(config, N_ACD_TRANSPORT_ETHERNET);
     n_acd_config_set_mac(config, self->hwaddr, ETH_ALEN);
 
-    r = n_acd_new(&self->acd, config);
+    r = nm_netns_acd_new(NM_NETNS_GET, config, acd_event, self, &self->acd_handle);
     n_acd_config_free(config);
-    return r;
+    if (r)
+        return r;
+
+    self->acd = nm_netns_acd_get_nacd(self->acd_handle);
+    return 0;
 }
 
 /**
@@ -323,7 +316,7 @@ nm_acd_manager_start_probe(NMAcdManager *self, guint timeout)
     GHashTableIter iter;
     AddressInfo *  info;
     gboolean       success = FALSE;
-    int            fd, r;
+    int            r;
 
     g_return_val_if_fail(self, FALSE);
     g_return_val_if_fail(self->state == STATE_INIT, FALSE);
@@ -345,12 +338,6 @@ nm_acd_manager_start_probe(NMAcdManager *self, guint timeout)
     if (success)
         self->state = STATE_PROBING;
 
-    nm_assert(!self->event_source);
-    n_acd_get_fd(self->acd, &fd);
-    self->event_source =
-        nm_g_unix_fd_source_new(fd, G_IO_IN, G_PRIORITY_DEFAULT, acd_event, self, NULL);
-    g_source_attach(self->event_source, NULL);
-
     return success ? 0 : -NME_UNSPEC;
 }
 
@@ -392,7 +379,6 @@ nm_acd_manager_announce_addresses(NMAcdManager *self)
     GHashTableIter iter;
     AddressInfo *  info;
     int            r;
-    int            fd;
     gboolean       success = TRUE;
 
     r = acd_init(self);
@@ -432,13 +418,6 @@ nm_acd_manager_announce_addresses(NMAcdManager *self)
         }
     }
 
-    if (!self->event_source) {
-        n_acd_get_fd(self->acd, &fd);
-        self->event_source =
-            nm_g_unix_fd_source_new(fd, G_IO_IN, G_PRIORITY_DEFAULT, acd_event, self, NULL);
-        g_source_attach(self->event_source, NULL);
-    }
-
     return success ? 0 : -NME_UNSPEC;
 }
 
@@ -489,8 +468,8 @@ nm_acd_manager_free(NMAcdManager *self)
         self->callbacks.user_data_destroy(self->user_data);
 
     nm_clear_pointer(&self->addresses, g_hash_table_destroy);
-    nm_clear_g_source_inst(&self->event_source);
-    nm_clear_pointer(&self->acd, n_acd_unref);
+    self->acd = NULL;
+    nm_clear_pointer(&self->acd_handle, nm_netns_acd_release);
 
     g_slice_free(NMAcdManager, self);
 }
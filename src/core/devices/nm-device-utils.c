@@ -158,6 +158,434 @@ NM_UTILS_LOOKUP_STR_DEFINE(nm_device_ip_state_to_str,
 
 /*****************************************************************************/
 
+static void
+_activation_timing_append(GArray *timing, const char *stage, gint64 now_usec)
+{
+    NMDeviceActivationTimingEntry entry;
+
+    entry = (NMDeviceActivationTimingEntry){
+        .stage          = stage,
+        .timestamp_usec = now_usec,
+    };
+    g_array_append_val(timing, entry);
+}
+
+/**
+ * nm_device_activation_timing_state_changed:
+ * @p_timing: the timeline of the device. Created on the first activation.
+ * @old_state: the previous device state
+ * @new_state: the new device state
+ * @now_usec: the current monotonic timestamp
+ *
+ * Entering "prepare" starts a new timeline. After that, all device states
+ * are recorded until the device leaves "disconnected" (or a lower state).
+ *
+ * Returns: %TRUE if an entry was added.
+ */
+gboolean
+nm_device_activation_timing_state_changed(GArray **     p_timing,
+                                          NMDeviceState old_state,
+                                          NMDeviceState new_state,
+                                          gint64        now_usec)
+{
+    if (new_state == NM_DEVICE_STATE_PREPARE) {
+        /* A new activation starts. Forget about the previous one. */
+        if (!*p_timing)
+            *p_timing = g_array_new(FALSE, FALSE, sizeof(NMDeviceActivationTimingEntry));
+        else
+            g_array_set_size(*p_timing, 0);
+    } else if (!*p_timing || old_state < NM_DEVICE_STATE_PREPARE) {
+        /* Only record the states from the start of the activation until the device
+         * is disconnected again. */
+        return FALSE;
+    }
+
+    if ((*p_timing)->len >= NM_DEVICE_ACTIVATION_TIMING_MAX_ENTRIES)
+        return FALSE;
+
+    _activation_timing_append(*p_timing, nm_device_state_to_str(new_state), now_usec);
+    return TRUE;
+}
+
+/**
+ * nm_device_activation_timing_stage:
+ * @timing: (nullable): the timeline of the device
+ * @state: the current device state
+ * @stage: the name of the sub-stage. Must be a static string.
+ * @now_usec: the current monotonic timestamp
+ *
+ * Records a sub-stage of the activation, but only while the device is
+ * activating and only the first time it is reached.
+ *
+ * Returns: %TRUE if an entry was added.
+ */
+gboolean
+nm_device_activation_timing_stage(GArray *      timing,
+                                  NMDeviceState state,
+                                  const char *  stage,
+                                  gint64        now_usec)
+{
+    guint i;
+
+    if (!timing || state < NM_DEVICE_STATE_PREPARE || state > NM_DEVICE_STATE_ACTIVATED)
+        return FALSE;
+
+    if (timing->len >= NM_DEVICE_ACTIVATION_TIMING_MAX_ENTRIES)
+        return FALSE;
+
+    /* Sub-stages (like a DHCP lease renewal) can happen repeatedly. Only
+     * the first time counts for the activation. */
+    for (i = 0; i < timing->len; i++) {
+        if (nm_streq(g_array_index(timing, NMDeviceActivationTimingEntry, i).stage, stage))
+            return FALSE;
+    }
+
+    _activation_timing_append(timing, stage, now_usec);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+struct _NMDeviceResolveQueue {
+    CList lst_queued_head;
+    CList lst_in_flight_head;
+
+    NMDeviceResolveQueueDoneFunc done_func;
+    gpointer                     user_data;
+
+    gint64 cache_lifetime_nsec;
+    guint  max_parallel;
+    guint  n_in_flight;
+    guint  dispatch_id;
+
+    /* a callback reported a change, done_func is pending. */
+    bool changed : 1;
+};
+
+struct _NMDeviceResolveQueueRequest {
+    CList lst;
+
+    /* %NULL, after the queue was destroyed while the lookup is in flight. */
+    NMDeviceResolveQueue *queue;
+
+    GCancellable *cancellable;
+
+    /* %NULL, after the request got cancelled while its lookup is in flight. It then
+     * only waits for the resolver to complete, to release the slot. */
+    NMDeviceResolveQueueCallback callback;
+    gpointer                     user_data;
+
+    char host[];
+};
+
+typedef struct {
+    GList *addresses;
+    gint64 expiry_nsec;
+    char   host[];
+} ResolveCacheEntry;
+
+static void
+_resolve_cache_entry_free(gpointer data)
+{
+    ResolveCacheEntry *entry = data;
+
+    g_list_free_full(entry->addresses, g_object_unref);
+    g_free(entry);
+}
+
+/* the cache maps host names to ResolveCacheEntry. It is shared by all queues,
+ * because they all use the same resolver. That way, devices that resolve the same
+ * host names only look them up once. */
+static GHashTable *
+_resolve_cache_get(void)
+{
+    static GHashTable *cache;
+
+    if (G_UNLIKELY(!cache))
+        cache = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, _resolve_cache_entry_free);
+    return cache;
+}
+
+static const GList *
+_resolve_cache_lookup(const char *host, gint64 now)
+{
+    GHashTable *       cache = _resolve_cache_get();
+    ResolveCacheEntry *entry;
+
+    entry = g_hash_table_lookup(cache, host);
+    if (!entry)
+        return NULL;
+
+    if (now >= entry->expiry_nsec) {
+        g_hash_table_remove(cache, host);
+        return NULL;
+    }
+
+    return entry->addresses;
+}
+
+static void
+_resolve_cache_add(NMDeviceResolveQueue *queue, const char *host, GList *addresses, gint64 now)
+{
+    GHashTable *       cache = _resolve_cache_get();
+    ResolveCacheEntry *entry;
+    gsize              host_len;
+
+    nm_assert(addresses);
+
+    if (queue->cache_lifetime_nsec <= 0)
+        return;
+
+    if (g_hash_table_size(cache) >= 1024) {
+        GHashTableIter iter;
+
+        /* prune expired entries, so that the cache does not grow unbounded. */
+        g_hash_table_iter_init(&iter, cache);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+            if (now >= entry->expiry_nsec)
+                g_hash_table_iter_remove(&iter);
+        }
+    }
+
+    host_len = strlen(host) + 1;
+    entry    = g_malloc(sizeof(ResolveCacheEntry) + host_len);
+    *entry   = (ResolveCacheEntry){
+        .addresses   = g_list_copy_deep(addresses, (GCopyFunc) g_object_ref, NULL),
+        .expiry_nsec = now + queue->cache_lifetime_nsec,
+    };
+    memcpy(entry->host, host, host_len);
+    g_hash_table_replace(cache, entry->host, entry);
+}
+
+static void
+_resolve_queue_request_free(NMDeviceResolveQueueRequest *request)
+{
+    c_list_unlink(&request->lst);
+    nm_g_object_unref(request->cancellable);
+    g_free(request);
+}
+
+static gboolean _resolve_queue_dispatch_cb(gpointer user_data);
+
+static void
+_resolve_queue_schedule(NMDeviceResolveQueue *queue)
+{
+    if (queue->dispatch_id != 0)
+        return;
+
+    if (c_list_is_empty(&queue->lst_queued_head)) {
+        /* the idle handler also notifies that all requests are done. */
+        if (queue->n_in_flight > 0 || !queue->changed)
+            return;
+    } else if (queue->n_in_flight >= queue->max_parallel)
+        return;
+
+    queue->dispatch_id = g_idle_add(_resolve_queue_dispatch_cb, queue);
+}
+
+static void
+_resolve_queue_complete(NMDeviceResolveQueue *       queue,
+                        NMDeviceResolveQueueRequest *request,
+                        const GList *                addresses,
+                        GError *                     error)
+{
+    NMDeviceResolveQueueCallback callback  = request->callback;
+    gpointer                     user_data = request->user_data;
+
+    _resolve_queue_request_free(request);
+
+    if (callback(addresses, error, user_data))
+        queue->changed = TRUE;
+
+    _resolve_queue_schedule(queue);
+}
+
+static void
+_resolve_queue_lookup_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMDeviceResolveQueueRequest *request = user_data;
+    NMDeviceResolveQueue *       queue   = request->queue;
+    gs_free_error GError *error          = NULL;
+    GList *               addresses;
+
+    addresses = g_resolver_lookup_by_name_finish(G_RESOLVER(source), result, &error);
+
+    if (!queue) {
+        g_list_free_full(addresses, g_object_unref);
+        _resolve_queue_request_free(request);
+        return;
+    }
+
+    nm_assert(queue->n_in_flight > 0);
+    queue->n_in_flight--;
+
+    if (!request->callback) {
+        /* the request was cancelled. The slot is free again. */
+        g_list_free_full(addresses, g_object_unref);
+        _resolve_queue_request_free(request);
+        _resolve_queue_schedule(queue);
+        return;
+    }
+
+    if (addresses) {
+        _resolve_cache_add(queue,
+                           request->host,
+                           addresses,
+                           nm_utils_get_monotonic_timestamp_nsec());
+    }
+
+    _resolve_queue_complete(queue, request, addresses, error);
+
+    g_list_free_full(addresses, g_object_unref);
+}
+
+static gboolean
+_resolve_queue_dispatch_cb(gpointer user_data)
+{
+    NMDeviceResolveQueue *       queue    = user_data;
+    gs_unref_object GResolver *  resolver = NULL;
+    NMDeviceResolveQueueRequest *request;
+    gint64                       now;
+
+    queue->dispatch_id = 0;
+
+    now = nm_utils_get_monotonic_timestamp_nsec();
+
+    while (queue->n_in_flight < queue->max_parallel
+           && (request = c_list_first_entry(&queue->lst_queued_head,
+                                            NMDeviceResolveQueueRequest,
+                                            lst))) {
+        const GList *cached;
+
+        cached = _resolve_cache_lookup(request->host, now);
+        if (cached) {
+            _resolve_queue_complete(queue, request, cached, NULL);
+            continue;
+        }
+
+        if (!resolver)
+            resolver = g_resolver_get_default();
+
+        c_list_unlink_stale(&request->lst);
+        c_list_link_tail(&queue->lst_in_flight_head, &request->lst);
+        request->cancellable = g_cancellable_new();
+        queue->n_in_flight++;
+
+        g_resolver_lookup_by_name_async(resolver,
+                                        request->host,
+                                        request->cancellable,
+                                        _resolve_queue_lookup_cb,
+                                        request);
+    }
+
+    if (queue->changed && queue->n_in_flight == 0 && c_list_is_empty(&queue->lst_queued_head)) {
+        queue->changed = FALSE;
+        queue->done_func(queue->user_data);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+NMDeviceResolveQueue *
+nm_device_resolve_queue_new(guint                        max_parallel,
+                            gint64                       cache_lifetime_msec,
+                            NMDeviceResolveQueueDoneFunc done_func,
+                            gpointer                     user_data)
+{
+    NMDeviceResolveQueue *queue;
+
+    g_return_val_if_fail(max_parallel > 0, NULL);
+    g_return_val_if_fail(done_func, NULL);
+
+    queue  = g_slice_new(NMDeviceResolveQueue);
+    *queue = (NMDeviceResolveQueue){
+        .lst_queued_head     = C_LIST_INIT(queue->lst_queued_head),
+        .lst_in_flight_head  = C_LIST_INIT(queue->lst_in_flight_head),
+        .done_func           = done_func,
+        .user_data           = user_data,
+        .cache_lifetime_nsec = cache_lifetime_msec * NM_UTILS_NSEC_PER_MSEC,
+        .max_parallel        = max_parallel,
+    };
+    return queue;
+}
+
+/* frees the queue. All requests are cancelled, their callbacks are not invoked. */
+void
+nm_device_resolve_queue_free(NMDeviceResolveQueue *queue)
+{
+    NMDeviceResolveQueueRequest *request;
+
+    if (!queue)
+        return;
+
+    while (
+        (request = c_list_first_entry(&queue->lst_queued_head, NMDeviceResolveQueueRequest, lst)))
+        _resolve_queue_request_free(request);
+
+    while ((request =
+                c_list_first_entry(&queue->lst_in_flight_head, NMDeviceResolveQueueRequest, lst))) {
+        c_list_unlink(&request->lst);
+        request->queue = NULL;
+        g_cancellable_cancel(request->cancellable);
+    }
+
+    nm_clear_g_source(&queue->dispatch_id);
+    g_slice_free(NMDeviceResolveQueue, queue);
+}
+
+/* queues a lookup of @host. @callback is invoked from an idle handler or from the
+ * completion of the lookup, never synchronously. */
+NMDeviceResolveQueueRequest *
+nm_device_resolve_queue_add(NMDeviceResolveQueue *       queue,
+                            const char *                 host,
+                            NMDeviceResolveQueueCallback callback,
+                            gpointer                     user_data)
+{
+    NMDeviceResolveQueueRequest *request;
+    gsize                        host_len;
+
+    g_return_val_if_fail(queue, NULL);
+    g_return_val_if_fail(host, NULL);
+    g_return_val_if_fail(callback, NULL);
+
+    host_len = strlen(host) + 1;
+    request  = g_malloc(sizeof(NMDeviceResolveQueueRequest) + host_len);
+    *request = (NMDeviceResolveQueueRequest){
+        .queue     = queue,
+        .callback  = callback,
+        .user_data = user_data,
+    };
+    memcpy(request->host, host, host_len);
+
+    c_list_link_tail(&queue->lst_queued_head, &request->lst);
+    _resolve_queue_schedule(queue);
+    return request;
+}
+
+/* cancels a request whose callback was not yet invoked. A lookup that is in flight
+ * keeps occupying its slot, until the resolver reports the cancellation. */
+void
+nm_device_resolve_queue_cancel(NMDeviceResolveQueueRequest *request)
+{
+    NMDeviceResolveQueue *queue;
+
+    g_return_if_fail(request);
+    g_return_if_fail(request->callback);
+
+    if (!request->cancellable) {
+        queue = request->queue;
+        _resolve_queue_request_free(request);
+        _resolve_queue_schedule(queue);
+        return;
+    }
+
+    request->callback  = NULL;
+    request->user_data = NULL;
+    g_cancellable_cancel(request->cancellable);
+}
+
+/*****************************************************************************/
+
 #define SD_RESOLVED_DNS (1UL << 0)
 /* Don't answer request from locally synthesized records (which includes /etc/hosts) */
 #define SD_RESOLVED_NO_SYNTHESIZE (1UL << 11)
@@ -85,6 +85,63 @@ const char *nm_device_ip_state_to_str(NMDeviceIPState ip_state);
 
 /*****************************************************************************/
 
+/* The number of steps recorded per activation is limited. The device states can
+ * repeat (for example, when asking for secrets), everything else is recorded only
+ * once. */
+#define NM_DEVICE_ACTIVATION_TIMING_MAX_ENTRIES 64
+
+typedef struct {
+    /* a static string, either a device state or the name of a sub-stage. */
+    const char *stage;
+    gint64      timestamp_usec;
+} NMDeviceActivationTimingEntry;
+
+gboolean nm_device_activation_timing_state_changed(GArray **     p_timing,
+                                                   NMDeviceState old_state,
+                                                   NMDeviceState new_state,
+                                                   gint64        now_usec);
+
+gboolean nm_device_activation_timing_stage(GArray *      timing,
+                                           NMDeviceState state,
+                                           const char *  stage,
+                                           gint64        now_usec);
+
+/*****************************************************************************/
+
+/* A queue for looking up host names with g_resolver_get_default(). At most
+ * @max_parallel lookups are ongoing at the same time, the other requests wait.
+ * Successful results are cached for @cache_lifetime_msec. The cache is shared
+ * by all queues of the process. */
+typedef struct _NMDeviceResolveQueue        NMDeviceResolveQueue;
+typedef struct _NMDeviceResolveQueueRequest NMDeviceResolveQueueRequest;
+
+/* Called with either the list of #GInetAddress or an error. The request is
+ * already destroyed at this point. Return %TRUE, if the result changed anything. */
+typedef gboolean (*NMDeviceResolveQueueCallback)(const GList *addresses,
+                                                 GError *     error,
+                                                 gpointer     user_data);
+
+/* Called (from an idle handler) when no requests are left and at least one
+ * callback reported a change since the last time. This allows to apply all
+ * changes at once. */
+typedef void (*NMDeviceResolveQueueDoneFunc)(gpointer user_data);
+
+NMDeviceResolveQueue *nm_device_resolve_queue_new(guint                        max_parallel,
+                                                  gint64                       cache_lifetime_msec,
+                                                  NMDeviceResolveQueueDoneFunc done_func,
+                                                  gpointer                     user_data);
+
+void nm_device_resolve_queue_free(NMDeviceResolveQueue *queue);
+
+NMDeviceResolveQueueRequest *nm_device_resolve_queue_add(NMDeviceResolveQueue *       queue,
+                                                         const char *                 host,
+                                                         NMDeviceResolveQueueCallback callback,
+                                                         gpointer                     user_data);
+
+void nm_device_resolve_queue_cancel(NMDeviceResolveQueueRequest *request);
+
+/*****************************************************************************/
+
 /*****************************************************************************/
 
 void nm_device_resolve_address(int                 addr_family,
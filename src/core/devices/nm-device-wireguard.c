@@ -68,6 +68,15 @@ G_STATIC_ASSERT(NM_WIREGUARD_SYMMETRIC_KEY_LEN == NMP_WIREGUARD_SYMMETRIC_KEY_LE
 
 #define RETRY_IN_MSEC_MAX ((gint64) (30 * 60 * 1000))
 
+/* the maximum number of concurrent name lookups per device. The remaining
+ * peers wait in a queue. */
+#define RESOLVE_MAX_PARALLEL 16
+
+/* how long the result of a successful name lookup is shared with other peers
+ * of the device. GResolver does not expose the TTL of the records, so this
+ * is a fixed, short lifetime. */
+#define RESOLVE_CACHE_LIFETIME_MSEC (60 * 1000)
+
 typedef enum {
     LINK_CONFIG_MODE_FULL,
     LINK_CONFIG_MODE_REAPPLY,
@@ -76,7 +85,7 @@ typedef enum {
 } LinkConfigMode;
 
 typedef struct {
-    GCancellable *cancellable;
+    NMDeviceResolveQueueRequest *resolve_request;
 
     NMSockAddrUnion sockaddr;
 
@@ -86,7 +95,7 @@ typedef struct {
      * It may be set to %NEXT_TRY_AT_NSEC_ASAP to indicate to re-resolve as soon as possible.
      *
      * A @sockaddr is either fixed or it has
-     *   - @cancellable set to indicate an ongoing request
+     *   - @resolve_request set to indicate an ongoing request
      *   - @next_try_at_nsec set to a positive value, indicating when
      *     we ought to retry. */
     gint64 next_try_at_nsec;
@@ -118,7 +127,11 @@ typedef struct {
     CList       lst_peers_head;
     GHashTable *peers;
 
-    /* counts the numbers of peers that are currently resolving. */
+    /* limits the number of parallel name lookups and caches their results. */
+    NMDeviceResolveQueue *resolve_queue;
+
+    /* counts the numbers of peers that are currently resolving (this includes
+     * the peers that still wait in the resolve queue). */
     guint peers_resolving_cnt;
 
     gint64 resolve_next_try_at;
@@ -519,7 +532,7 @@ _peers_resolving_cnt(NMDeviceWireGuardPrivate *priv)
         guint     cnt = 0;
 
         c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
-            if (peer_data->ep_resolv.cancellable)
+            if (peer_data->ep_resolv.resolve_request)
                 cnt++;
         }
         nm_assert(cnt == priv->peers_resolving_cnt);
@@ -550,6 +563,18 @@ _peers_resolving_cnt_decrement(NMDeviceWireGuard *self)
     }
 }
 
+/* abort resolving the endpoint of the peer (whether queued or ongoing).
+ * Returns %TRUE, if the peer was resolving. */
+static gboolean
+_peers_resolve_abort(PeerData *peer_data)
+{
+    if (!peer_data->ep_resolv.resolve_request)
+        return FALSE;
+
+    nm_device_resolve_queue_cancel(g_steal_pointer(&peer_data->ep_resolv.resolve_request));
+    return TRUE;
+}
+
 static void
 _peers_remove(NMDeviceWireGuard *self, PeerData *peer_data)
 {
@@ -562,9 +587,9 @@ _peers_remove(NMDeviceWireGuard *self, PeerData *peer_data)
         nm_assert_not_reached();
 
     c_list_unlink_stale(&peer_data->lst_peers);
-    nm_wireguard_peer_unref(peer_data->peer);
-    if (nm_clear_g_cancellable(&peer_data->ep_resolv.cancellable))
+    if (_peers_resolve_abort(peer_data))
         _peers_resolving_cnt_decrement(self);
+    nm_wireguard_peer_unref(peer_data->peer);
     g_slice_free(PeerData, peer_data);
 
     if (c_list_is_empty(&priv->lst_peers_head)) {
@@ -620,7 +645,7 @@ _peers_resolve_retry_timeout(gpointer user_data)
         if (peer_data->ep_resolv.next_try_at_nsec <= 0)
             continue;
 
-        if (peer_data->ep_resolv.cancellable) {
+        if (peer_data->ep_resolv.resolve_request) {
             /* we are currently resolving a name. We don't need the global
              * watchdog to guard this peer. No need to adjust @next for
              * this one, when the currently ongoing resolving completes, we
@@ -721,31 +746,22 @@ _peers_retry_in_msec(PeerData *peer_data, gboolean after_failure)
     return NM_MIN(RETRY_IN_MSEC_MAX, (1u << peer_data->ep_resolv.resolv_fail_count) * 500);
 }
 
-static void
-_peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
+static gboolean
+_peers_resolve_cb(const GList *list, GError *resolv_error, gpointer user_data)
 {
-    NMDeviceWireGuard *       self;
-    NMDeviceWireGuardPrivate *priv;
-    PeerData *                peer_data;
-    gs_free_error GError *resolv_error = NULL;
-    GList *               list;
-    gboolean              changed;
-    NMSockAddrUnion       sockaddr;
-    gint64                retry_in_msec;
-    char                  s_sockaddr[100];
-    char                  s_retry[100];
-
-    list = g_resolver_lookup_by_name_finish(G_RESOLVER(source_object), res, &resolv_error);
-
-    if (nm_utils_error_is_cancelled(resolv_error))
-        return;
-
-    peer_data = user_data;
-    self      = peer_data->self;
-    priv      = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    PeerData *                peer_data = user_data;
+    NMDeviceWireGuard *       self      = peer_data->self;
+    NMDeviceWireGuardPrivate *priv      = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    gboolean                  changed;
+    NMSockAddrUnion           sockaddr;
+    gint64                    retry_in_msec;
+    char                      s_sockaddr[100];
+    char                      s_retry[100];
 
-    if (nm_clear_g_object(&peer_data->ep_resolv.cancellable))
-        _peers_resolving_cnt_decrement(self);
+    /* the queue already destroyed the request. */
+    nm_assert(peer_data->ep_resolv.resolve_request);
+    peer_data->ep_resolv.resolve_request = NULL;
+    _peers_resolving_cnt_decrement(self);
 
     nm_assert((!resolv_error) != (!list));
     nm_assert(_peers_resolving_cnt(priv) == priv->peers_resolving_cnt);
@@ -771,14 +787,14 @@ _peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
               _retry_in_msec_to_string(retry_in_msec, s_retry));
 
         _peers_resolve_retry_reschedule_for_peer(self, peer_data, retry_in_msec);
-        return;
+        return FALSE;
     }
 
     sockaddr = (NMSockAddrUnion) NM_SOCK_ADDR_UNION_INIT_UNSPEC;
     changed  = FALSE;
 
     if (!resolv_error) {
-        GList *iter;
+        const GList *iter;
 
         for (iter = list; iter; iter = iter->next) {
             GInetAddress *   a = iter->data;
@@ -821,8 +837,6 @@ _peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
                 break;
             }
         }
-
-        g_list_free_full(list, g_object_unref);
     }
 
     if (sockaddr.sa.sa_family == AF_UNSPEC) {
@@ -859,29 +873,44 @@ _peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
 
     _peers_resolve_retry_reschedule_for_peer(self, peer_data, retry_in_msec);
 
-    if (changed) {
-        /* schedule the job in the background, to give multiple resolve events time
-         * to complete. */
-        nm_clear_g_source(&priv->link_config_delayed_id);
-        priv->link_config_delayed_id = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE + 1,
-                                                       link_config_delayed_resolver_cb,
-                                                       self,
-                                                       NULL);
-    }
+    /* don't update the link right away. Other lookups may still be pending,
+     * and we update the link only once, when all of them completed. See
+     * _peers_resolve_done_cb(). */
+    return changed;
+}
+
+static void
+_peers_resolve_done_cb(gpointer user_data)
+{
+    NMDeviceWireGuard *       self = user_data;
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+
+    if (c_list_is_empty(&priv->lst_peers_head))
+        return;
+
+    /* schedule the job in the background, to give multiple resolve events time
+     * to complete. */
+    nm_clear_g_source(&priv->link_config_delayed_id);
+    priv->link_config_delayed_id = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE + 1,
+                                                   link_config_delayed_resolver_cb,
+                                                   self,
+                                                   NULL);
 }
 
 static void
 _peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
 {
-    NMDeviceWireGuardPrivate *priv      = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
-    gs_unref_object GResolver *resolver = NULL;
-    const char *               host;
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    const char *              host;
 
-    resolver = g_resolver_get_default();
+    nm_assert(!peer_data->ep_resolv.resolve_request);
 
-    nm_assert(!peer_data->ep_resolv.cancellable);
+    host = nm_sock_addr_endpoint_get_host(_nm_wireguard_peer_get_endpoint(peer_data->peer));
 
-    peer_data->ep_resolv.cancellable = g_cancellable_new();
+    /* the lookup is started from an idle handler, with a bounded number of
+     * parallel requests. */
+    peer_data->ep_resolv.resolve_request =
+        nm_device_resolve_queue_add(priv->resolve_queue, host, _peers_resolve_cb, peer_data);
     priv->peers_resolving_cnt++;
 
     /* set a special next-try timestamp. It is positive, and indicates
@@ -891,14 +920,6 @@ _peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
      * a next-try timestamp once the try completes. */
     peer_data->ep_resolv.next_try_at_nsec = NEXT_TRY_AT_NSEC_PAST;
 
-    host = nm_sock_addr_endpoint_get_host(_nm_wireguard_peer_get_endpoint(peer_data->peer));
-
-    g_resolver_lookup_by_name_async(resolver,
-                                    host,
-                                    peer_data->ep_resolv.cancellable,
-                                    _peers_resolve_cb,
-                                    peer_data);
-
     _LOGT(LOGD_DEVICE,
           "wireguard-peer[%s]: resolving name \"%s\" for endpoint \"%s\"...",
           nm_wireguard_peer_get_public_key(peer_data->peer),
@@ -915,7 +936,7 @@ _peers_resolve_reresolve_all(NMDeviceWireGuard *self)
     PeerData *                peer_data;
 
     c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
-        if (peer_data->ep_resolv.cancellable) {
+        if (peer_data->ep_resolv.resolve_request) {
             /* remember to retry when the currently ongoing request completes. */
             peer_data->ep_resolv.next_try_at_nsec = NEXT_TRY_AT_NSEC_ASAP;
         } else if (peer_data->ep_resolv.next_try_at_nsec <= 0) {
@@ -980,13 +1001,13 @@ _peers_update(NMDeviceWireGuard *self,
     if (nm_sock_addr_union_cmp(&peer_data->ep_resolv.sockaddr, &sockaddr) != 0)
         changed = TRUE;
 
-    if (nm_clear_g_cancellable(&peer_data->ep_resolv.cancellable))
+    if (_peers_resolve_abort(peer_data))
         _peers_resolving_cnt_decrement(self);
 
     peer_data->ep_resolv = (PeerEndpointResolveData){
         .sockaddr          = sockaddr,
         .resolv_fail_count = 0,
-        .cancellable       = NULL,
+        .resolve_request   = NULL,
         .next_try_at_nsec  = 0,
     };
 
@@ -1486,7 +1507,9 @@ link_config(NMDeviceWireGuard *  self,
 
     wg_lnk = (NMPlatformLnkWireGuard){};
 
-    wg_change_flags = NM_PLATFORM_WIREGUARD_CHANGE_FLAG_NONE;
+    /* Only send what differs from the current configuration of the link. A full replacement
+     * of all peers would briefly interrupt the traffic of unrelated peers. */
+    wg_change_flags = NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC;
 
     if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL)
         || (NM_IN_SET(config_mode, LINK_CONFIG_MODE_REAPPLY) && peers_removed))
@@ -1963,7 +1986,11 @@ nm_device_wireguard_init(NMDeviceWireGuard *self)
     NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
 
     c_list_init(&priv->lst_peers_head);
-    priv->peers = g_hash_table_new(_peer_data_hash, _peer_data_equal);
+    priv->peers         = g_hash_table_new(_peer_data_hash, _peer_data_equal);
+    priv->resolve_queue = nm_device_resolve_queue_new(RESOLVE_MAX_PARALLEL,
+                                                      RESOLVE_CACHE_LIFETIME_MSEC,
+                                                      _peers_resolve_done_cb,
+                                                      self);
 }
 
 static void
@@ -1990,6 +2017,7 @@ finalize(GObject *object)
     }
 
     g_hash_table_destroy(priv->peers);
+    nm_device_resolve_queue_free(priv->resolve_queue);
 
     G_OBJECT_CLASS(nm_device_wireguard_parent_class)->finalize(object);
 }
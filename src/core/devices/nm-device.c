@@ -290,7 +290,8 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMDevice,
                              PROP_STATISTICS_RX_BYTES,
                              PROP_IP4_CONNECTIVITY,
                              PROP_IP6_CONNECTIVITY,
-                             PROP_INTERFACE_FLAGS, );
+                             PROP_INTERFACE_FLAGS,
+                             PROP_ACTIVATION_TIMING, );
 
 typedef struct _NMDevicePrivate {
     bool in_state_changed;
@@ -300,6 +301,10 @@ typedef struct _NMDevicePrivate {
 
     NMDeviceState       state;
     NMDeviceStateReason state_reason;
+
+    /* Timestamps of the steps of the last activation (ActivationTiming). */
+    GArray *activation_timing;
+
     struct {
         guint id;
 
@@ -2787,6 +2792,60 @@ _add_capabilities(NMDevice *self, NMDeviceCapabilities capabilities)
 
 /*****************************************************************************/
 
+static void
+_activation_timing_state_changed(NMDevice *self, NMDeviceState old_state, NMDeviceState new_state)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+
+    if (!nm_device_activation_timing_state_changed(&priv->activation_timing,
+                                                   old_state,
+                                                   new_state,
+                                                   nm_utils_get_monotonic_timestamp_usec()))
+        return;
+
+    _LOGT(LOGD_DEVICE, "activation-timing: %s", nm_device_state_to_str(new_state));
+    _notify(self, PROP_ACTIVATION_TIMING);
+}
+
+static void
+_activation_timing_stage(NMDevice *self, const char *stage)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+
+    if (!nm_device_activation_timing_stage(priv->activation_timing,
+                                           priv->state,
+                                           stage,
+                                           nm_utils_get_monotonic_timestamp_usec()))
+        return;
+
+    _LOGT(LOGD_DEVICE, "activation-timing: %s", stage);
+    _notify(self, PROP_ACTIVATION_TIMING);
+}
+
+static GVariant *
+_activation_timing_to_variant(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    GVariantBuilder  builder;
+    guint            i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(st)"));
+    for (i = 0; priv->activation_timing && i < priv->activation_timing->len; i++) {
+        const NMDeviceActivationTimingEntry *entry =
+            &g_array_index(priv->activation_timing, NMDeviceActivationTimingEntry, i);
+
+        g_variant_builder_add(
+            &builder,
+            "(st)",
+            entry->stage,
+            (guint64) nm_utils_monotonic_timestamp_as_boottime(entry->timestamp_usec,
+                                                               NM_UTILS_NSEC_PER_USEC));
+    }
+    return g_variant_builder_end(&builder);
+}
+
+/*****************************************************************************/
+
 static void
 _set_ip_state(NMDevice *self, int addr_family, NMDeviceIPState new_state)
 {
@@ -2806,6 +2865,11 @@ _set_ip_state(NMDevice *self, int addr_family, NMDeviceIPState new_state)
 
     priv->ip_state_x_[IS_IPv4] = new_state;
 
+    if (new_state == NM_DEVICE_IP_STATE_DONE)
+        _activation_timing_stage(self, IS_IPv4 ? "ip4-done" : "ip6-done");
+    else if (new_state == NM_DEVICE_IP_STATE_FAIL)
+        _activation_timing_stage(self, IS_IPv4 ? "ip4-fail" : "ip6-fail");
+
     if (new_state == NM_DEVICE_IP_STATE_DONE) {
         /* we only set the IPx_READY flag once we reach NM_DEVICE_IP_STATE_DONE state. We don't
          * ever clear it, even if we later enter NM_DEVICE_IP_STATE_FAIL state.
@@ -3998,6 +4062,13 @@ concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
              + (priv->concheck_x[IS_IPv4].p_cur_interval * NM_UTILS_NSEC_PER_SEC);
     tdiff = expiry - now_ns;
 
+    /* delay the check by a random jitter of up to 10% of the interval. Otherwise, all
+     * devices that got connected at the same time would always check at the same time
+     * (and hit the server at the same time). The jitter only delays the timeout, it
+     * does not change the basetime, so it doesn't accumulate. */
+    tdiff += ((gint64) g_random_int_range(0, priv->concheck_x[IS_IPv4].p_cur_interval * 100 + 1))
+             * NM_UTILS_NSEC_PER_MSEC;
+
     _LOGT(LOGD_CONCHECK,
           "connectivity: [IPv%c] periodic-check: %sscheduled in %lld milliseconds (%u seconds "
           "interval)",
@@ -8329,6 +8400,7 @@ static gboolean
 tc_commit(NMDevice *self)
 {
     gs_unref_ptrarray GPtrArray *qdiscs   = NULL;
+    gs_unref_ptrarray GPtrArray *tclasses = NULL;
     gs_unref_ptrarray GPtrArray *tfilters = NULL;
     NMSettingTCConfig *          s_tc;
     NMPlatform *                 platform;
@@ -8344,15 +8416,10 @@ tc_commit(NMDevice *self)
 
     platform = nm_device_get_platform(self);
     qdiscs   = nm_utils_qdiscs_from_tc_setting(platform, s_tc, ip_ifindex);
+    tclasses = nm_utils_tclasses_from_tc_setting(platform, s_tc, ip_ifindex);
     tfilters = nm_utils_tfilters_from_tc_setting(platform, s_tc, ip_ifindex);
 
-    if (!nm_platform_qdisc_sync(platform, ip_ifindex, qdiscs))
-        return FALSE;
-
-    if (!nm_platform_tfilter_sync(platform, ip_ifindex, tfilters))
-        return FALSE;
-
-    return TRUE;
+    return nm_platform_tc_sync(platform, ip_ifindex, qdiscs, tclasses, tfilters);
 }
 
 /*
@@ -8539,6 +8606,8 @@ acd_manager_probe_terminated(NMAcdManager *acd_manager, gpointer user_data)
     self = data->device;
     priv = NM_DEVICE_GET_PRIVATE(self);
 
+    _activation_timing_stage(self, "dad4-done");
+
     for (i = 0; data->configs && data->configs[i]; i++) {
         nm_ip_config_iter_ip4_address_for_each (&ipconf_iter, data->configs[i], &address) {
             char sbuf[NM_UTILS_INET_ADDRSTRLEN];
@@ -8634,6 +8703,8 @@ ipv4_dad_start(NMDevice *self, NMIP4Config **configs, AcdCallback cb)
             nm_acd_manager_add_address(acd_manager, address->address);
     }
 
+    _activation_timing_stage(self, "dad4-start");
+
     r = nm_acd_manager_start_probe(acd_manager, timeout);
     if (r < 0) {
         _LOGW(LOGD_DEVICE, "acd probe failed");
@@ -9322,6 +9393,8 @@ dhcp4_state_changed(NMDhcpClient *client,
             break;
         }
 
+        _activation_timing_stage(self, "dhcp4-bound");
+
         nm_clear_g_source(&priv->dhcp_data_4.grace_id);
         priv->dhcp_data_4.grace_pending = FALSE;
 
@@ -9462,6 +9535,8 @@ dhcp4_start(NMDevice *self)
         return NM_ACT_STAGE_RETURN_FAILURE;
     }
 
+    _activation_timing_stage(self, "dhcp4-start");
+
     priv->dhcp_data_4.state_sigid = g_signal_connect(priv->dhcp_data_4.client,
                                                      NM_DHCP_CLIENT_SIGNAL_STATE_CHANGED,
                                                      G_CALLBACK(dhcp4_state_changed),
@@ -9755,6 +9830,8 @@ dhcp6_state_changed(NMDhcpClient *client,
     switch (state) {
     case NM_DHCP_STATE_BOUND:
     case NM_DHCP_STATE_EXTENDED:
+        _activation_timing_stage(self, "dhcp6-bound");
+
         nm_clear_g_source(&priv->dhcp_data_6.grace_id);
         priv->dhcp_data_6.grace_pending = FALSE;
         /* If the server sends multiple IPv6 addresses, we receive a state
@@ -9915,6 +9992,8 @@ dhcp6_start_with_link_ready(NMDevice *self, NMConnection *connection)
         return FALSE;
     }
 
+    _activation_timing_stage(self, "dhcp6-start");
+
     priv->dhcp_data_6.state_sigid = g_signal_connect(priv->dhcp_data_6.client,
                                                      NM_DHCP_CLIENT_SIGNAL_STATE_CHANGED,
                                                      G_CALLBACK(dhcp6_state_changed),
@@ -10666,6 +10745,8 @@ ndisc_config_changed(NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_int
 
     g_return_if_fail(priv->act_request.obj);
 
+    _activation_timing_stage(self, "ndisc-config");
+
     if (!applied_config_get_current(&priv->ac_ip6_config))
         applied_config_init_new(&priv->ac_ip6_config, self, AF_INET6);
 
@@ -10856,6 +10937,7 @@ addrconf6_start_with_link_ready(NMDevice *self)
                                               self);
 
     ndisc_set_router_config(priv->ndisc, self);
+    _activation_timing_stage(self, "ndisc-start");
     nm_ndisc_start(priv->ndisc);
     priv->ndisc_started = TRUE;
     return;
@@ -11434,6 +11516,8 @@ fw_change_zone_cb(NMFirewalldManager *      firewalld_manager,
     if (nm_utils_error_is_cancelled(error))
         return;
 
+    _activation_timing_stage(self, "firewall-zone-done");
+
     switch (priv->fw_state) {
     case FIREWALL_STATE_WAIT_STAGE_3:
         priv->fw_state = FIREWALL_STATE_INITIALIZED;
@@ -11476,6 +11560,8 @@ fw_change_zone(NMDevice *self)
     if (G_UNLIKELY(!priv->fw_mgr))
         priv->fw_mgr = g_object_ref(nm_firewalld_manager_get());
 
+    _activation_timing_stage(self, "firewall-zone-start");
+
     zone = nm_setting_connection_get_zone(s_con);
 #if WITH_FIREWALLD_ZONE
     if (!zone || zone[0] == '\0') {
@@ -11924,6 +12010,7 @@ activate_stage5_ip_config_result_x(NMDevice *self, int addr_family)
 
             if (priv->dad6_ip6_config) {
                 _LOGD(LOGD_DEVICE | LOGD_IP6, "IPv6 DAD: awaiting termination");
+                _activation_timing_stage(self, "dad6-start");
             } else {
                 _set_ip_state(self, AF_INET6, NM_DEVICE_IP_STATE_DONE);
                 check_ip_state(self, FALSE, TRUE);
@@ -13743,6 +13830,9 @@ dispatcher_complete_proceed_state(NMDispatcherCallId *call_id, gpointer user_dat
 
     g_return_if_fail(call_id == priv->dispatcher.call_id);
 
+    if (priv->dispatcher.post_state == NM_DEVICE_STATE_SECONDARIES)
+        _activation_timing_stage(self, "dispatcher-pre-up-done");
+
     priv->dispatcher.call_id = NULL;
     nm_device_queue_state(self, priv->dispatcher.post_state, priv->dispatcher.post_state_reason);
     priv->dispatcher.post_state        = NM_DEVICE_STATE_UNKNOWN;
@@ -13761,6 +13851,7 @@ ip_check_pre_up(NMDevice *self)
 
     priv->dispatcher.post_state        = NM_DEVICE_STATE_SECONDARIES;
     priv->dispatcher.post_state_reason = NM_DEVICE_STATE_REASON_NONE;
+    _activation_timing_stage(self, "dispatcher-pre-up-start");
     if (!nm_dispatcher_call_device(NM_DISPATCHER_ACTION_PRE_UP,
                                    self,
                                    NULL,
@@ -14475,6 +14566,7 @@ queued_ip_config_change(NMDevice *self, int addr_family)
             && !nm_ip6_config_has_any_dad_pending(priv->ext_ip6_config_captured,
                                                   priv->dad6_ip6_config)) {
             _LOGD(LOGD_DEVICE | LOGD_IP6, "IPv6 DAD terminated");
+            _activation_timing_stage(self, "dad6-done");
             g_clear_object(&priv->dad6_ip6_config);
             _set_ip_state(self, addr_family, NM_DEVICE_IP_STATE_DONE);
             check_ip_state(self, FALSE, TRUE);
@@ -15908,8 +16000,7 @@ nm_device_cleanup(NMDevice *self, NMDeviceStateReason reason, CleanupType cleanu
             set_ipv6_token(self, iid, "::");
 
             if (nm_device_get_applied_setting(self, NM_TYPE_SETTING_TC_CONFIG)) {
-                nm_platform_tfilter_sync(platform, ifindex, NULL);
-                nm_platform_qdisc_sync(platform, ifindex, NULL);
+                nm_platform_tc_sync(platform, ifindex, NULL, NULL, NULL);
             }
         }
     }
@@ -16392,6 +16483,8 @@ _set_state_full(NMDevice *self, NMDeviceState state, NMDeviceStateReason reason,
     priv->state        = state;
     priv->state_reason = reason;
 
+    _activation_timing_state_changed(self, old_state, state);
+
     queued_state_clear(self);
 
     dispatcher_cleanup(self);
@@ -18089,6 +18182,9 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     case PROP_INTERFACE_FLAGS:
         g_value_set_uint(value, priv->interface_flags);
         break;
+    case PROP_ACTIVATION_TIMING:
+        g_value_set_variant(value, _activation_timing_to_variant(self));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -18435,6 +18531,7 @@ finalize(GObject *object)
     g_free(priv->hw_addr_initial);
     g_slist_free(priv->pending_actions);
     g_slist_free_full(priv->dad6_failed_addrs, (GDestroyNotify) nmp_object_unref);
+    nm_clear_pointer(&priv->activation_timing, g_array_unref);
     nm_clear_g_free(&priv->physical_port_id);
     g_free(priv->udi);
     g_free(priv->path);
@@ -18572,7 +18669,10 @@ static const NMDBusInterfaceInfoExtended interface_info_device = {
                                                            NM_DEVICE_INTERFACE_FLAGS),
             NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("HwAddress",
                                                            "s",
-                                                           NM_DEVICE_HW_ADDRESS), ), ),
+                                                           NM_DEVICE_HW_ADDRESS),
+            NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("ActivationTiming",
+                                                           "a(st)",
+                                                           NM_DEVICE_ACTIVATION_TIMING), ), ),
 };
 
 static const NMDBusInterfaceInfoExtended interface_info_device_statistics = {
@@ -18923,6 +19023,13 @@ nm_device_class_init(NMDeviceClass *klass)
                           G_MAXUINT32,
                           0,
                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+    obj_properties[PROP_ACTIVATION_TIMING] =
+        g_param_spec_variant(NM_DEVICE_ACTIVATION_TIMING,
+                             "",
+                             "",
+                             G_VARIANT_TYPE("a(st)"),
+                             NULL,
+                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
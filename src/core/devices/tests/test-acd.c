@@ -10,6 +10,7 @@
 #include <linux/if_ether.h>
 
 #include "devices/nm-acd-manager.h"
+#include "nm-netns.h"
 #include "platform/tests/test-common.h"
 
 #define IFACE_VETH0 "nm-test-veth0"
@@ -220,6 +221,143 @@ test_acd_announce(test_fixture *fixture, gconstpointer user_data)
     g_assert(!nmtst_main_loop_run(loop, 200));
 }
 
+static guint
+_count_fds(void)
+{
+    GDir *dir;
+    guint n = 0;
+
+    dir = g_dir_open("/proc/self/fd", 0, NULL);
+    g_assert(dir);
+    while (g_dir_read_name(dir))
+        n++;
+    g_dir_close(dir);
+    return n;
+}
+
+static void
+_acd_shared_event_cb(NAcd *nacd, NAcdEvent *event, gpointer user_data)
+{
+    g_assert(event);
+}
+
+typedef struct {
+    GMainLoop *loop;
+    guint      n_terminated;
+} SharedData;
+
+static void
+acd_manager_shared_probe_terminated(NMAcdManager *acd_manager, gpointer user_data)
+{
+    SharedData *data = user_data;
+
+    if (++data->n_terminated == 2)
+        g_main_loop_quit(data->loop);
+}
+
+static void
+test_acd_shared(test_fixture *fixture, gconstpointer user_data)
+{
+    nm_auto_free_acdmgr NMAcdManager *manager0 = NULL;
+    nm_auto_free_acdmgr NMAcdManager *manager1 = NULL;
+    nm_auto_unref_gmainloop GMainLoop *loop    = NULL;
+    NMNetnsAcdHandle *                 handle0;
+    NMNetnsAcdHandle *                 handle1;
+    NAcdConfig *                       config;
+    SharedData                         data;
+    int                                fd0;
+    int                                fd1;
+    guint                              n_fds_0;
+    guint                              n_fds_1;
+    guint                              n_fds_2;
+    const guint                        WAIT_TIME_OPTIMISTIC = 50;
+    guint                              wait_time;
+    static const NMAcdCallbacks        callbacks = {
+        .probe_terminated_callback = acd_manager_shared_probe_terminated,
+    };
+    int r;
+
+    if (_skip_acd_test())
+        return;
+
+    /* instances on different interfaces share the file descriptor to poll. */
+    r = n_acd_config_new(&config);
+    g_assert_cmpint(r, ==, 0);
+    n_acd_config_set_transport(config, N_ACD_TRANSPORT_ETHERNET);
+    n_acd_config_set_ifindex(config, fixture->ifindex0);
+    n_acd_config_set_mac(config, fixture->hwaddr0, fixture->hwaddr0_len);
+    r = nm_netns_acd_new(NM_NETNS_GET, config, _acd_shared_event_cb, NULL, &handle0);
+    g_assert_cmpint(r, ==, 0);
+    n_acd_config_set_ifindex(config, fixture->ifindex1);
+    n_acd_config_set_mac(config, fixture->hwaddr1, fixture->hwaddr1_len);
+    r = nm_netns_acd_new(NM_NETNS_GET, config, _acd_shared_event_cb, NULL, &handle1);
+    g_assert_cmpint(r, ==, 0);
+    n_acd_config_free(config);
+    n_acd_get_fd(nm_netns_acd_get_nacd(handle0), &fd0);
+    n_acd_get_fd(nm_netns_acd_get_nacd(handle1), &fd1);
+    g_assert_cmpint(fd0, >=, 0);
+    g_assert_cmpint(fd0, ==, fd1);
+    nm_netns_acd_release(handle0);
+    nm_netns_acd_release(handle1);
+
+    /* each side has an address that the other side probes for. */
+    nmtstp_ip4_address_add(NULL, FALSE, fixture->ifindex1, ADDR4, 24, 0, 3600, 1800, 0, NULL);
+    nmtstp_ip4_address_add(NULL, FALSE, fixture->ifindex0, ADDR3, 24, 0, 3600, 1800, 0, NULL);
+
+    wait_time = WAIT_TIME_OPTIMISTIC;
+again:
+
+    nm_clear_pointer(&manager0, nm_acd_manager_free);
+    nm_clear_pointer(&manager1, nm_acd_manager_free);
+    nm_clear_pointer(&loop, g_main_loop_unref);
+    loop = g_main_loop_new(NULL, FALSE);
+    data = (SharedData){
+        .loop = loop,
+    };
+
+    manager0 = nm_acd_manager_new(fixture->ifindex0,
+                                  fixture->hwaddr0,
+                                  fixture->hwaddr0_len,
+                                  &callbacks,
+                                  &data);
+    g_assert(nm_acd_manager_add_address(manager0, ADDR1));
+    g_assert(nm_acd_manager_add_address(manager0, ADDR4));
+
+    manager1 = nm_acd_manager_new(fixture->ifindex1,
+                                  fixture->hwaddr1,
+                                  fixture->hwaddr1_len,
+                                  &callbacks,
+                                  &data);
+    g_assert(nm_acd_manager_add_address(manager1, ADDR2));
+    g_assert(nm_acd_manager_add_address(manager1, ADDR3));
+
+    /* The first instance creates the shared epoll fd and timerfd, the
+     * second one only adds its packet socket and BPF map. */
+    n_fds_0 = _count_fds();
+    r       = nm_acd_manager_start_probe(manager0, wait_time);
+    g_assert_cmpint(r, ==, 0);
+    n_fds_1 = _count_fds();
+    r       = nm_acd_manager_start_probe(manager1, wait_time);
+    g_assert_cmpint(r, ==, 0);
+    n_fds_2 = _count_fds();
+    g_assert_cmpint(n_fds_1 - n_fds_0, ==, (n_fds_2 - n_fds_1) + 2);
+
+    g_assert(nmtst_main_loop_run(loop, 2000));
+    g_assert_cmpint(data.n_terminated, ==, 2);
+
+    if (!nm_acd_manager_check_address(manager0, ADDR1)
+        || nm_acd_manager_check_address(manager0, ADDR4)
+        || !nm_acd_manager_check_address(manager1, ADDR2)
+        || nm_acd_manager_check_address(manager1, ADDR3)) {
+        if (wait_time == WAIT_TIME_OPTIMISTIC) {
+            /* retry with a large timeout, like test_acd_common(). */
+            wait_time = 1000;
+            goto again;
+        }
+        g_error("unexpected probe results on the shared ACD context");
+    }
+}
+
 static void
 fixture_teardown(test_fixture *fixture, gconstpointer user_data)
 {
@@ -256,4 +394,10 @@ _nmtstp_setup_tests(void)
                fixture_setup,
                test_acd_announce,
                fixture_teardown);
+    g_test_add("/acd/shared",
+               test_fixture,
+               NULL,
+               fixture_setup,
+               test_acd_shared,
+               fixture_teardown);
 }
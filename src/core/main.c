@@ -13,6 +13,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <linux/if.h>
+#include <linux/rtnetlink.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/resource.h>
@@ -285,6 +286,46 @@ _dbus_manager_init(NMConfig *config)
     return TRUE;
 }
 
+static void
+_linux_platform_setup(NMConfig *config)
+{
+    const NMConfigData *   config_data = nm_config_get_data_orig(config);
+    gs_unref_array GArray *tables      = NULL;
+    gs_free const char **  strv        = NULL;
+    gs_free char *         value       = NULL;
+    gsize                  i;
+
+    value = nm_config_data_get_value(config_data,
+                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                     NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_TABLES,
+                                     NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+    strv   = nm_utils_strsplit_set(value, ",; \t");
+    tables = g_array_new(FALSE, FALSE, sizeof(guint32));
+    for (i = 0; strv && strv[i]; i++) {
+        gint64  t;
+        guint32 table;
+
+        t = _nm_utils_ascii_str_to_int64(strv[i], 10, 1, G_MAXUINT32, -1);
+        if (t < 0 || NM_IN_SET(t, RT_TABLE_MAIN, RT_TABLE_LOCAL, RT_TABLE_DEFAULT)) {
+            nm_log_warn(LOGD_CORE,
+                        "config: invalid route table \"%s\" in \"%s\"",
+                        strv[i],
+                        NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_TABLES);
+            continue;
+        }
+        table = t;
+        g_array_append_val(tables, table);
+    }
+
+    nm_linux_platform_setup_full(
+        nm_config_data_get_value_boolean(config_data,
+                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                         NM_CONFIG_KEYFILE_KEY_MAIN_NETLINK_READER_THREAD,
+                                         FALSE),
+        (const guint32 *) tables->data,
+        tables->len);
+}
+
 /*
  * main
  *
@@ -476,7 +517,7 @@ main(int argc, char *argv[])
     if (!_dbus_manager_init(config))
         goto done_no_manager;
 
-    nm_linux_platform_setup();
+    _linux_platform_setup(config);
 
     NM_UTILS_KEEP_ALIVE(config, nm_netns_get(), "NMConfig-depends-on-NMNetns");
 
@@ -31,6 +31,15 @@
 
 /*****************************************************************************/
 
+typedef enum {
+    EXPIRY_TYPE_GATEWAYS,
+    EXPIRY_TYPE_ADDRESSES,
+    EXPIRY_TYPE_ROUTES,
+    EXPIRY_TYPE_DNS_SERVERS,
+    EXPIRY_TYPE_DNS_DOMAINS,
+    _EXPIRY_TYPE_NUM,
+} ExpiryType;
+
 struct _NMNDiscPrivate {
     /* this *must* be the first field. */
     NMNDiscDataInternal rdata;
@@ -49,6 +58,12 @@ struct _NMNDiscPrivate {
 
     GSource *timeout_expire_source;
 
+    /* For each type of data, a lower bound for the earliest expiry of its
+     * elements. Adding or updating an element only ever lowers the bound, so
+     * that check_timestamps() only needs to scan the arrays whose bound is
+     * reached. Scanning an array recomputes the exact value. */
+    gint64 expiry_next_msec[_EXPIRY_TYPE_NUM];
+
     NMUtilsIPv6IfaceId iid;
 
     /* immutable values: */
@@ -254,6 +269,25 @@ expiry_next(gint64 now_msec, gint64 expiry_msec, gint64 *next_msec)
     return TRUE;
 }
 
+static void
+expiry_track(NMNDisc *ndisc, ExpiryType type, gint64 expiry_msec)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+
+    if (priv->expiry_next_msec[type] > expiry_msec)
+        priv->expiry_next_msec[type] = expiry_msec;
+}
+
+static void
+expiry_reset(NMNDisc *ndisc)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+    guint           i;
+
+    for (i = 0; i < _EXPIRY_TYPE_NUM; i++)
+        priv->expiry_next_msec[i] = NM_NDISC_EXPIRY_INFINITY;
+}
+
 static const char *
 _get_exp(char *buf, gsize buf_size, gint64 now_msec, gint64 expiry_time)
 {
@@ -418,6 +452,7 @@ nm_ndisc_add_gateway(NMNDisc *ndisc, const NMNDiscGateway *new_item, gint64 now_
                 return FALSE;
 
             item->expiry_msec = new_item->expiry_msec;
+            expiry_track(ndisc, EXPIRY_TYPE_GATEWAYS, item->expiry_msec);
             _ASSERT_data_gateways(rdata);
             return TRUE;
         }
@@ -440,6 +475,7 @@ nm_ndisc_add_gateway(NMNDisc *ndisc, const NMNDiscGateway *new_item, gint64 now_
     g_array_insert_val(rdata->gateways,
                        insert_idx == G_MAXUINT ? rdata->gateways->len : insert_idx,
                        *new_item);
+    expiry_track(ndisc, EXPIRY_TYPE_GATEWAYS, new_item->expiry_msec);
     _ASSERT_data_gateways(rdata);
     return TRUE;
 }
@@ -589,6 +625,7 @@ nm_ndisc_add_address(NMNDisc *             ndisc,
 
         existing->expiry_msec           = new_expiry_msec;
         existing->expiry_preferred_msec = new_expiry_preferred_msec;
+        expiry_track(ndisc, EXPIRY_TYPE_ADDRESSES, new_expiry_msec);
         return TRUE;
     }
 
@@ -616,6 +653,7 @@ nm_ndisc_add_address(NMNDisc *             ndisc,
         }
     }
 
+    expiry_track(ndisc, EXPIRY_TYPE_ADDRESSES, new2->expiry_msec);
     return TRUE;
 }
 
@@ -670,6 +708,7 @@ nm_ndisc_add_route(NMNDisc *ndisc, const NMNDiscRoute *new_item, gint64 now_msec
 
             item->expiry_msec = new_item->expiry_msec;
             item->gateway     = new_item->gateway;
+            expiry_track(ndisc, EXPIRY_TYPE_ROUTES, item->expiry_msec);
             return TRUE;
         }
 
@@ -691,6 +730,7 @@ nm_ndisc_add_route(NMNDisc *ndisc, const NMNDiscRoute *new_item, gint64 now_msec
     }
 
     g_array_insert_val(rdata->routes, insert_idx == G_MAXUINT ? 0u : insert_idx, *new_item);
+    expiry_track(ndisc, EXPIRY_TYPE_ROUTES, new_item->expiry_msec);
     return TRUE;
 }
 
@@ -717,6 +757,7 @@ nm_ndisc_add_dns_server(NMNDisc *ndisc, const NMNDiscDNSServer *new_item, gint64
                 return FALSE;
 
             item->expiry_msec = new_item->expiry_msec;
+            expiry_track(ndisc, EXPIRY_TYPE_DNS_SERVERS, item->expiry_msec);
             return TRUE;
         }
     }
@@ -728,6 +769,7 @@ nm_ndisc_add_dns_server(NMNDisc *ndisc, const NMNDiscDNSServer *new_item, gint64
         return FALSE;
 
     g_array_append_val(rdata->dns_servers, *new_item);
+    expiry_track(ndisc, EXPIRY_TYPE_DNS_SERVERS, new_item->expiry_msec);
     return TRUE;
 }
 
@@ -756,6 +798,7 @@ nm_ndisc_add_dns_domain(NMNDisc *ndisc, const NMNDiscDNSDomain *new_item, gint64
                 return FALSE;
 
             item->expiry_msec = new_item->expiry_msec;
+            expiry_track(ndisc, EXPIRY_TYPE_DNS_DOMAINS, item->expiry_msec);
             return TRUE;
         }
     }
@@ -771,6 +814,7 @@ nm_ndisc_add_dns_domain(NMNDisc *ndisc, const NMNDiscDNSDomain *new_item, gint64
         .domain      = g_strdup(new_item->domain),
         .expiry_msec = new_item->expiry_msec,
     };
+    expiry_track(ndisc, EXPIRY_TYPE_DNS_DOMAINS, new_item->expiry_msec);
     return TRUE;
 }
 
@@ -1147,6 +1191,7 @@ nm_ndisc_stop(NMNDisc *ndisc)
     g_array_set_size(rdata->routes, 0);
     g_array_set_size(rdata->dns_servers, 0);
     g_array_set_size(rdata->dns_domains, 0);
+    expiry_reset(ndisc);
     priv->rdata.public.hop_limit = 64;
 
     nm_clear_g_source_inst(&priv->ra_timeout_source);
@@ -1474,19 +1519,45 @@ clean_dns_domains(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gi
         *changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
 }
 
+static gint64 *
+expiry_due(NMNDisc *ndisc, ExpiryType type, gint64 now_msec)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+
+    if (priv->expiry_next_msec[type] > now_msec)
+        return NULL;
+
+    /* the clean function recomputes the bound while scanning the array. */
+    priv->expiry_next_msec[type] = NM_NDISC_EXPIRY_INFINITY;
+    return &priv->expiry_next_msec[type];
+}
+
 static void
 check_timestamps(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap changed)
 {
     NMNDiscPrivate *priv      = NM_NDISC_GET_PRIVATE(ndisc);
     gint64          next_msec = G_MAXINT64;
+    gint64 *        type_next_msec;
+    guint           i;
 
     _LOGT("router-data: check for changed router advertisement data");
 
-    clean_gateways(ndisc, now_msec, &changed, &next_msec);
-    clean_addresses(ndisc, now_msec, &changed, &next_msec);
-    clean_routes(ndisc, now_msec, &changed, &next_msec);
-    clean_dns_servers(ndisc, now_msec, &changed, &next_msec);
-    clean_dns_domains(ndisc, now_msec, &changed, &next_msec);
+    /* Only scan the arrays that (possibly) have expired elements. For a router that
+     * refreshes all its data with each RA, this is only the case once per lifetime
+     * and not on every RA. */
+    if ((type_next_msec = expiry_due(ndisc, EXPIRY_TYPE_GATEWAYS, now_msec)))
+        clean_gateways(ndisc, now_msec, &changed, type_next_msec);
+    if ((type_next_msec = expiry_due(ndisc, EXPIRY_TYPE_ADDRESSES, now_msec)))
+        clean_addresses(ndisc, now_msec, &changed, type_next_msec);
+    if ((type_next_msec = expiry_due(ndisc, EXPIRY_TYPE_ROUTES, now_msec)))
+        clean_routes(ndisc, now_msec, &changed, type_next_msec);
+    if ((type_next_msec = expiry_due(ndisc, EXPIRY_TYPE_DNS_SERVERS, now_msec)))
+        clean_dns_servers(ndisc, now_msec, &changed, type_next_msec);
+    if ((type_next_msec = expiry_due(ndisc, EXPIRY_TYPE_DNS_DOMAINS, now_msec)))
+        clean_dns_domains(ndisc, now_msec, &changed, type_next_msec);
+
+    for (i = 0; i < _EXPIRY_TYPE_NUM; i++)
+        next_msec = NM_MIN(next_msec, priv->expiry_next_msec[i]);
 
     nm_assert(next_msec > now_msec);
 
@@ -1671,6 +1742,8 @@ nm_ndisc_init(NMNDisc *ndisc)
     rdata->dns_domains = g_array_new(FALSE, FALSE, sizeof(NMNDiscDNSDomain));
     g_array_set_clear_func(rdata->dns_domains, dns_domain_free);
     priv->rdata.public.hop_limit = 64;
+
+    expiry_reset(ndisc);
 }
 
 static void
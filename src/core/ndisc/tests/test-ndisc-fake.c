@@ -632,6 +632,130 @@ test_dns_solicit_loop(void)
 
 /*****************************************************************************/
 
+#define BENCHMARK_N_RAS          1000
+#define BENCHMARK_N_ROUTES       500
+#define BENCHMARK_N_ROUTES_SHORT 50
+
+typedef struct {
+    GMainLoop *loop;
+    guint      counter;
+    gint64     t_first_nsec;
+    gint64     t_last_nsec;
+} BenchmarkData;
+
+static void
+test_benchmark_many_routes_changed(NMNDisc *          ndisc,
+                                   const NMNDiscData *rdata,
+                                   guint              changed_int,
+                                   BenchmarkData *    data)
+{
+    if (data->counter++ == 0) {
+        /* the routes are in place. Only measure the following RAs. */
+        g_assert_cmpint(rdata->routes_n, ==, BENCHMARK_N_ROUTES + BENCHMARK_N_ROUTES_SHORT);
+        data->t_first_nsec = nm_utils_get_monotonic_timestamp_nsec();
+        return;
+    }
+
+    if (!nm_fake_ndisc_done(NM_FAKE_NDISC(ndisc)))
+        return;
+
+    if (data->t_last_nsec == 0) {
+        /* the last RA. The short-lived routes are not yet expired. */
+        g_assert_cmpint(data->counter, ==, BENCHMARK_N_RAS);
+        g_assert_cmpint(rdata->routes_n, ==, BENCHMARK_N_ROUTES + BENCHMARK_N_ROUTES_SHORT);
+        data->t_last_nsec = nm_utils_get_monotonic_timestamp_nsec();
+        return;
+    }
+
+    /* the short-lived routes from the first RA expired. */
+    if (rdata->routes_n == BENCHMARK_N_ROUTES)
+        g_main_loop_quit(data->loop);
+}
+
+static void
+test_benchmark_many_routes(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop = g_main_loop_new(NULL, FALSE);
+    gs_unref_object NMFakeNDisc *ndisc      = ndisc_new();
+    const gint64                 now_msec   = nm_utils_get_monotonic_timestamp_msec();
+    BenchmarkData                data       = {
+        .loop = loop,
+    };
+    gint64 t;
+    guint  i;
+    guint  j;
+
+    /* The first RA announces many RIO routes. The following RAs only refresh
+     * the gateway and the DNS server, so that each of them is a change but
+     * none of them adds a route. Timing these RAs measures the expiry
+     * handling with many routes in the list, and not the linear lookup in
+     * nm_ndisc_add_route(). */
+    for (i = 0; i < BENCHMARK_N_RAS; i++) {
+        guint id;
+
+        id = nm_fake_ndisc_add_ra(ndisc, 0, NM_NDISC_DHCP_LEVEL_NONE, 4, 1500);
+        g_assert(id);
+
+        nm_fake_ndisc_add_gateway(ndisc,
+                                  id,
+                                  "fe80::1",
+                                  now_msec + 1800000 + i,
+                                  NM_ICMPV6_ROUTER_PREF_MEDIUM);
+        nm_fake_ndisc_add_dns_server(ndisc, id, "2001:db8:c:c::1", now_msec + 1800000 + i);
+
+        if (i > 0)
+            continue;
+
+        for (j = 0; j < BENCHMARK_N_ROUTES; j++) {
+            char network[NM_UTILS_INET_ADDRSTRLEN];
+
+            nm_sprintf_buf(network, "2001:db8:%x::", j);
+            nm_fake_ndisc_add_prefix(ndisc,
+                                     id,
+                                     network,
+                                     48,
+                                     "fe80::1",
+                                     now_msec + 1800000,
+                                     now_msec + 1800000,
+                                     NM_ICMPV6_ROUTER_PREF_MEDIUM);
+        }
+
+        for (j = 0; j < BENCHMARK_N_ROUTES_SHORT; j++) {
+            char network[NM_UTILS_INET_ADDRSTRLEN];
+
+            nm_sprintf_buf(network, "2001:db8:ffff:%x::", j);
+            nm_fake_ndisc_add_prefix(ndisc,
+                                     id,
+                                     network,
+                                     64,
+                                     "fe80::1",
+                                     now_msec + 2000,
+                                     now_msec + 2000,
+                                     NM_ICMPV6_ROUTER_PREF_MEDIUM);
+        }
+    }
+
+    g_signal_connect(ndisc,
+                     NM_NDISC_CONFIG_RECEIVED,
+                     G_CALLBACK(test_benchmark_many_routes_changed),
+                     &data);
+
+    nm_ndisc_start(NM_NDISC(ndisc));
+    nmtst_main_loop_run_assert(data.loop, 15000);
+
+    g_assert(nm_fake_ndisc_done(ndisc));
+    g_assert_cmpint(data.t_last_nsec, >=, data.t_first_nsec);
+
+    t = data.t_last_nsec - data.t_first_nsec;
+    g_test_message("%u RAs with %u routes in %ld.%06ld msec",
+                   (guint) (BENCHMARK_N_RAS - 1),
+                   (guint) (BENCHMARK_N_ROUTES + BENCHMARK_N_ROUTES_SHORT),
+                   (long) (t / NM_UTILS_NSEC_PER_MSEC),
+                   (long) (t % NM_UTILS_NSEC_PER_MSEC));
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -652,6 +776,7 @@ main(int argc, char **argv)
     g_test_add_func("/ndisc/preference-order", test_preference_order);
     g_test_add_func("/ndisc/preference-changed", test_preference_changed);
     g_test_add_func("/ndisc/dns-solicit-loop", test_dns_solicit_loop);
+    g_test_add_func("/ndisc/benchmark-many-routes", test_benchmark_many_routes);
 
     return g_test_run();
 }
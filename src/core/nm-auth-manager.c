@@ -21,9 +21,15 @@
 #define CANCELLATION_ID_PREFIX  "cancellation-id-"
 #define CANCELLATION_TIMEOUT_MS 5000
 
+/* How long a cached authorization result stays valid. polkit announces
+ * changes to its configuration and sessions via the "Changed" signal,
+ * which invalidates the cache. The timeout only limits the damage if we
+ * miss such an event (for example, when a temporary authorization expires). */
+#define CACHE_TIMEOUT_MSEC 10000
+
 /*****************************************************************************/
 
-NM_GOBJECT_PROPERTIES_DEFINE_BASE(PROP_POLKIT_ENABLED, );
+NM_GOBJECT_PROPERTIES_DEFINE_BASE(PROP_POLKIT_ENABLED, PROP_DBUS_CONNECTION, );
 
 enum {
     CHANGED_SIGNAL,
@@ -38,8 +44,16 @@ typedef struct {
     GCancellable *   main_cancellable;
     char *           name_owner;
     guint64          call_numid_counter;
+
+    /* cached authorization results, by D-Bus sender (CacheSubject). */
+    GHashTable *cache_subjects;
+    guint64     cache_generation;
+    guint64     cache_hits;
+    guint64     cache_misses;
+
     guint            changed_id;
     guint            name_owner_changed_id;
+    guint            cache_name_owner_changed_id;
     bool             disposing : 1;
     bool             shutting_down : 1;
     bool             got_name_owner : 1;
@@ -145,8 +159,237 @@ struct _NMAuthManagerCallId {
     guint64                                 call_numid;
     guint                                   idle_id;
     bool                                    idle_is_authorized : 1;
+
+    /* if set, the result of the D-Bus call gets cached. */
+    struct {
+        NMAuthSubject *subject;
+        char *         action_id;
+        guint64        generation;
+        bool           allow_user_interaction : 1;
+    } cache;
 };
 
+/*****************************************************************************/
+
+typedef struct {
+    char * dbus_sender;
+    CList  entries_lst_head;
+    gulong pid;
+    gulong uid;
+} CacheSubject;
+
+typedef struct {
+    CList  entries_lst;
+    gint64 expiry_msec;
+    bool   allow_user_interaction : 1;
+    bool   is_authorized : 1;
+    char   action_id[];
+} CacheEntry;
+
+static void
+_cache_entry_free(CacheEntry *entry)
+{
+    c_list_unlink_stale(&entry->entries_lst);
+    g_free(entry);
+}
+
+static void
+_cache_subject_free(gpointer data)
+{
+    CacheSubject *cache_subject = data;
+    CacheEntry *  entry;
+
+    while ((entry = c_list_first_entry(&cache_subject->entries_lst_head, CacheEntry, entries_lst)))
+        _cache_entry_free(entry);
+    g_free(cache_subject->dbus_sender);
+    g_slice_free(CacheSubject, cache_subject);
+}
+
+static void
+_cache_clear(NMAuthManager *self, const char *reason)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    /* pending requests that were started before, must not add their
+     * (possibly outdated) result to the cache. */
+    priv->cache_generation++;
+
+    if (!priv->cache_subjects || g_hash_table_size(priv->cache_subjects) == 0)
+        return;
+
+    _LOGT("cache: clear (%s)", reason);
+    g_hash_table_remove_all(priv->cache_subjects);
+}
+
+static gboolean
+_cache_subject_is_cacheable(NMAuthSubject *subject)
+{
+    /* only results for D-Bus clients are cached. The unique name of the sender
+     * identifies the process, and we notice when it disconnects. */
+    return nm_auth_subject_get_subject_type(subject) == NM_AUTH_SUBJECT_TYPE_UNIX_PROCESS
+           && nm_auth_subject_get_unix_process_dbus_sender(subject);
+}
+
+static CacheSubject *
+_cache_subject_lookup(NMAuthManager *self, NMAuthSubject *subject)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    CacheSubject *        cache_subject;
+
+    if (!priv->cache_subjects)
+        return NULL;
+
+    cache_subject = g_hash_table_lookup(priv->cache_subjects,
+                                        nm_auth_subject_get_unix_process_dbus_sender(subject));
+    if (!cache_subject)
+        return NULL;
+
+    if (cache_subject->pid != nm_auth_subject_get_unix_process_pid(subject)
+        || cache_subject->uid != nm_auth_subject_get_unix_process_uid(subject)) {
+        /* this is not expected to happen, the unique name belongs to one process. */
+        g_hash_table_remove(priv->cache_subjects, cache_subject->dbus_sender);
+        return NULL;
+    }
+
+    return cache_subject;
+}
+
+static gboolean
+_cache_lookup(NMAuthManager *self,
+              NMAuthSubject *subject,
+              const char *   action_id,
+              gboolean       allow_user_interaction,
+              gboolean *     out_is_authorized)
+{
+    CacheSubject *cache_subject;
+    CacheEntry *  entry;
+    gint64        now_msec;
+
+    cache_subject = _cache_subject_lookup(self, subject);
+    if (!cache_subject)
+        return FALSE;
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    c_list_for_each_entry (entry, &cache_subject->entries_lst_head, entries_lst) {
+        if (!nm_streq(entry->action_id, action_id)
+            || entry->allow_user_interaction != (!!allow_user_interaction))
+            continue;
+
+        if (entry->expiry_msec <= now_msec) {
+            _cache_entry_free(entry);
+            return FALSE;
+        }
+
+        *out_is_authorized = entry->is_authorized;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void
+_cache_name_owner_changed_cb(GDBusConnection *connection,
+                             const char *     sender_name,
+                             const char *     object_path,
+                             const char *     interface_name,
+                             const char *     signal_name,
+                             GVariant *       parameters,
+                             gpointer         user_data)
+{
+    NMAuthManager *       self = user_data;
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    NMAuthManagerCallId * call_id;
+    const char *          name;
+    const char *          new_owner;
+
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)")))
+        return;
+
+    g_variant_get(parameters, "(&s&s&s)", &name, NULL, &new_owner);
+    if (name[0] != ':' || new_owner[0])
+        return;
+
+    /* a client disconnected. Its unique name is never reused. Drop its results,
+     * and don't cache the results of its pending requests. */
+    c_list_for_each_entry (call_id, &priv->calls_lst_head, calls_lst) {
+        if (call_id->cache.subject
+            && nm_streq0(nm_auth_subject_get_unix_process_dbus_sender(call_id->cache.subject),
+                         name))
+            g_clear_object(&call_id->cache.subject);
+    }
+
+    if (priv->cache_subjects && g_hash_table_remove(priv->cache_subjects, name))
+        _LOGT("cache: drop results for %s (disconnected)", name);
+}
+
+static void
+_cache_add(NMAuthManager *self, NMAuthManagerCallId *call_id, gboolean is_authorized)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    CacheSubject *        cache_subject;
+    CacheEntry *          entry;
+    gsize                 action_id_len;
+
+    if (!call_id->cache.subject)
+        return;
+
+    if (call_id->cache.generation != priv->cache_generation || !priv->dbus_connection
+        || priv->shutting_down || priv->disposing)
+        return;
+
+    cache_subject = _cache_subject_lookup(self, call_id->cache.subject);
+    if (!cache_subject) {
+        if (!priv->cache_subjects) {
+            priv->cache_subjects =
+                g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, _cache_subject_free);
+        }
+
+        cache_subject  = g_slice_new(CacheSubject);
+        *cache_subject = (CacheSubject){
+            .dbus_sender =
+                g_strdup(nm_auth_subject_get_unix_process_dbus_sender(call_id->cache.subject)),
+            .entries_lst_head = C_LIST_INIT(cache_subject->entries_lst_head),
+            .pid              = nm_auth_subject_get_unix_process_pid(call_id->cache.subject),
+            .uid              = nm_auth_subject_get_unix_process_uid(call_id->cache.subject),
+        };
+        g_hash_table_insert(priv->cache_subjects, cache_subject->dbus_sender, cache_subject);
+    } else {
+        c_list_for_each_entry (entry, &cache_subject->entries_lst_head, entries_lst) {
+            if (nm_streq(entry->action_id, call_id->cache.action_id)
+                && entry->allow_user_interaction == call_id->cache.allow_user_interaction) {
+                _cache_entry_free(entry);
+                break;
+            }
+        }
+    }
+
+    action_id_len = strlen(call_id->cache.action_id) + 1;
+    entry         = g_malloc(sizeof(CacheEntry) + action_id_len);
+    *entry        = (CacheEntry){
+        .expiry_msec            = nm_utils_get_monotonic_timestamp_msec() + CACHE_TIMEOUT_MSEC,
+        .allow_user_interaction = call_id->cache.allow_user_interaction,
+        .is_authorized          = is_authorized,
+    };
+    memcpy(entry->action_id, call_id->cache.action_id, action_id_len);
+    c_list_link_tail(&cache_subject->entries_lst_head, &entry->entries_lst);
+}
+
+void
+nm_auth_manager_get_cache_stats(NMAuthManager *self, guint64 *out_hits, guint64 *out_misses)
+{
+    NMAuthManagerPrivate *priv;
+
+    g_return_if_fail(NM_IS_AUTH_MANAGER(self));
+
+    priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    NM_SET_OUT(out_hits, priv->cache_hits);
+    NM_SET_OUT(out_misses, priv->cache_misses);
+}
+
+/*****************************************************************************/
+
 #define cancellation_id_to_str_a(call_numid)                     \
     nm_sprintf_bufa(NM_STRLEN(CANCELLATION_ID_PREFIX) + 60,      \
                     CANCELLATION_ID_PREFIX "%" G_GUINT64_FORMAT, \
@@ -165,6 +408,8 @@ _call_id_free(NMAuthManagerCallId *call_id)
         return;
     }
 
+    g_clear_object(&call_id->cache.subject);
+    g_free(call_id->cache.action_id);
     g_object_unref(call_id->self);
     g_slice_free(NMAuthManagerCallId, call_id);
 }
@@ -260,6 +505,10 @@ _call_check_authorize_cb(GObject *proxy, GAsyncResult *res, gpointer user_data)
     if (!error) {
         g_variant_get(value, "((bb@a{ss}))", &is_authorized, &is_challenge, NULL);
         _LOG2T(call_id, "completed: authorized=%d, challenge=%d", is_authorized, is_challenge);
+
+        /* a challenge depends on the user interaction. Don't cache it. */
+        if (!is_challenge)
+            _cache_add(self, call_id, is_authorized);
     } else
         _LOG2T(call_id, "completed: failed: %s", error->message);
 
@@ -310,6 +559,7 @@ nm_auth_manager_check_authorization(NMAuthManager *                         self
     PolkitCheckAuthorizationFlags flags;
     char                          subject_buf[64];
     NMAuthManagerCallId *         call_id;
+    gboolean                      is_authorized;
 
     g_return_val_if_fail(NM_IS_AUTH_MANAGER(self), NULL);
     g_return_val_if_fail(NM_IN_SET(nm_auth_subject_get_subject_type(subject),
@@ -357,6 +607,15 @@ nm_auth_manager_check_authorization(NMAuthManager *                         self
                priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ALLOW_ALL ? "grant" : "deny");
         call_id->idle_is_authorized = (priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ALLOW_ALL);
         call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
+    } else if (_cache_subject_is_cacheable(subject)
+               && _cache_lookup(self, subject, action_id, allow_user_interaction, &is_authorized)) {
+        priv->cache_hits++;
+        _LOG2T(call_id,
+               "CheckAuthorization(%s), subject=%s (cached result)",
+               action_id,
+               nm_auth_subject_to_string(subject, subject_buf, sizeof(subject_buf)));
+        call_id->idle_is_authorized = is_authorized;
+        call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
     } else {
         GVariant *      parameters;
         GVariantBuilder builder;
@@ -384,6 +643,14 @@ nm_auth_manager_check_authorization(NMAuthManager *                         self
 
         call_id->dbus_cancellable = g_cancellable_new();
 
+        if (_cache_subject_is_cacheable(subject)) {
+            priv->cache_misses++;
+            call_id->cache.subject                = g_object_ref(subject);
+            call_id->cache.action_id              = g_strdup(action_id);
+            call_id->cache.generation             = priv->cache_generation;
+            call_id->cache.allow_user_interaction = allow_user_interaction;
+        }
+
         nm_assert(priv->main_cancellable);
 
         g_dbus_connection_call(priv->dbus_connection,
@@ -445,8 +712,10 @@ changed_signal_cb(GDBusConnection *connection,
 
     _LOGD("dbus-signal: \"Changed\" notification%s", valid_sender ? "" : " (ignore)");
 
-    if (valid_sender)
+    if (valid_sender) {
+        _cache_clear(self, "polkit changed");
         _emit_changed_signal(self);
+    }
 }
 
 static void
@@ -490,6 +759,8 @@ _name_owner_changed(NMAuthManager *self, const char *name_owner, gboolean is_ini
             _LOGT("name-owner: polkit started (now %s)", priv->name_owner);
     }
 
+    _cache_clear(self, "polkit name owner changed");
+
     if (priv->name_owner)
         _emit_changed_signal(self);
 }
@@ -566,6 +837,7 @@ nm_auth_manager_force_shutdown(NMAuthManager *self)
 
     priv->shutting_down = TRUE;
     nm_clear_g_cancellable(&priv->main_cancellable);
+    _cache_clear(self, "shutdown");
 }
 
 /*****************************************************************************/
@@ -587,6 +859,10 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
         priv->auth_polkit_mode = v_int;
         nm_assert(priv->auth_polkit_mode == v_int);
         break;
+    case PROP_DBUS_CONNECTION:
+        /* construct-only */
+        priv->dbus_connection = g_value_dup_object(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -615,6 +891,7 @@ constructed(GObject *object)
     G_OBJECT_CLASS(nm_auth_manager_parent_class)->constructed(object);
 
     if (priv->auth_polkit_mode != NM_AUTH_POLKIT_MODE_USE_POLKIT) {
+        g_clear_object(&priv->dbus_connection);
         if (priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ROOT_ONLY)
             create_message = "polkit disabled, root-only";
         else
@@ -622,7 +899,8 @@ constructed(GObject *object)
         goto out;
     }
 
-    priv->dbus_connection = nm_g_object_ref(NM_MAIN_DBUS_CONNECTION_GET);
+    if (!priv->dbus_connection)
+        priv->dbus_connection = nm_g_object_ref(NM_MAIN_DBUS_CONNECTION_GET);
 
     if (!priv->dbus_connection) {
         /* This warrants an info level message. */
@@ -642,6 +920,15 @@ constructed(GObject *object)
                                                                self,
                                                                NULL);
 
+    /* one subscription for all clients. A match rule per client would soon
+     * exhaust the limit of match rules per connection of the bus daemon. */
+    priv->cache_name_owner_changed_id =
+        nm_dbus_connection_signal_subscribe_name_owner_changed(priv->dbus_connection,
+                                                               NULL,
+                                                               _cache_name_owner_changed_cb,
+                                                               self,
+                                                               NULL);
+
     priv->changed_id = g_dbus_connection_signal_subscribe(priv->dbus_connection,
                                                           POLKIT_SERVICE,
                                                           POLKIT_INTERFACE,
@@ -710,8 +997,13 @@ dispose(GObject *object)
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->name_owner_changed_id);
 
+    nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->cache_name_owner_changed_id);
+
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->changed_id);
 
+    _cache_clear(self, "dispose");
+    nm_clear_pointer(&priv->cache_subjects, g_hash_table_unref);
+
     G_OBJECT_CLASS(nm_auth_manager_parent_class)->dispose(object);
 
     g_clear_object(&priv->dbus_connection);
@@ -737,6 +1029,13 @@ nm_auth_manager_class_init(NMAuthManagerClass *klass)
                          NM_AUTH_POLKIT_MODE_USE_POLKIT,
                          G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
 
+    obj_properties[PROP_DBUS_CONNECTION] =
+        g_param_spec_object(NM_AUTH_MANAGER_DBUS_CONNECTION,
+                            "",
+                            "",
+                            G_TYPE_DBUS_CONNECTION,
+                            G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
     g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
     signals[CHANGED_SIGNAL] = g_signal_new(NM_AUTH_MANAGER_SIGNAL_CHANGED,
@@ -48,7 +48,8 @@ nm_auth_call_result_eval(gboolean is_authorized, gboolean is_challenge, GError *
 #define NM_AUTH_MANAGER_GET_CLASS(obj) \
     (G_TYPE_INSTANCE_GET_CLASS((obj), NM_TYPE_AUTH_MANAGER, NMAuthManagerClass))
 
-#define NM_AUTH_MANAGER_POLKIT_ENABLED "polkit-enabled"
+#define NM_AUTH_MANAGER_POLKIT_ENABLED  "polkit-enabled"
+#define NM_AUTH_MANAGER_DBUS_CONNECTION "dbus-connection"
 
 #define NM_AUTH_MANAGER_SIGNAL_CHANGED "changed"
 
@@ -64,6 +65,8 @@ void nm_auth_manager_force_shutdown(NMAuthManager *self);
 
 gboolean nm_auth_manager_get_polkit_enabled(NMAuthManager *self);
 
+void nm_auth_manager_get_cache_stats(NMAuthManager *self, guint64 *out_hits, guint64 *out_misses);
+
 /*****************************************************************************/
 
 typedef struct _NMAuthManagerCallId NMAuthManagerCallId;
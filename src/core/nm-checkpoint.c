@@ -22,12 +22,21 @@
 /*****************************************************************************/
 
 typedef struct {
-    char *             original_dev_path;
-    char *             original_dev_name;
-    NMDeviceType       dev_type;
-    NMDevice *         device;
-    NMConnection *     applied_connection;
-    NMConnection *     settings_connection;
+    char *       original_dev_path;
+    char *       original_dev_name;
+    NMDeviceType dev_type;
+    NMDevice *   device;
+
+    /* The applied connection gets modified in place (for example, when secrets
+     * are cleared or updated) without any notification, so there is no point
+     * where a copy-on-write could happen. We need our own copy right away. */
+    NMConnection *applied_connection;
+
+    /* The connection of a NMSettingsConnection is immutable, an update replaces
+     * it. That makes a reference as good as a copy, and a copy only happens
+     * implicitly, when the profile changes. */
+    NMConnection *settings_connection;
+
     guint64            ac_version_id;
     NMDeviceState      state;
     bool               is_software : 1;
@@ -168,22 +177,41 @@ find_settings_connection(NMCheckpoint *    self,
     if (!sett_conn)
         return NULL;
 
-    /* Now check if the connection changed, ... */
-    if (!nm_connection_compare(dev_checkpoint->settings_connection,
-                               nm_settings_connection_get_connection(sett_conn),
-                               NM_SETTING_COMPARE_FLAG_EXACT)) {
+    /* Now check if the connection changed (if the profile was not modified
+     * in the meantime, it is still the very same instance), ... */
+    if (nm_settings_connection_get_connection(sett_conn) != dev_checkpoint->settings_connection
+        && !nm_connection_compare(dev_checkpoint->settings_connection,
+                                  nm_settings_connection_get_connection(sett_conn),
+                                  NM_SETTING_COMPARE_FLAG_EXACT)) {
         _LOGT("rollback: settings connection %s changed", uuid);
         *need_update     = TRUE;
         *need_activation = TRUE;
     }
 
     /* ... is active, ... */
-    nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
-        ac_uuid =
-            nm_settings_connection_get_uuid(nm_active_connection_get_settings_connection(active));
-        if (nm_streq(uuid, ac_uuid)) {
+    active = NULL;
+    if (dev_checkpoint->device) {
+        NMActRequest *act_request;
+
+        /* Usually the profile is still active on the same device. Check that first,
+         * instead of iterating over all active connections. */
+        act_request = nm_device_get_act_request(dev_checkpoint->device);
+        if (act_request
+            && nm_streq0(uuid,
+                         nm_settings_connection_get_uuid(
+                             nm_act_request_get_settings_connection(act_request)))) {
             _LOGT("rollback: connection %s is active", uuid);
-            break;
+            active = NM_ACTIVE_CONNECTION(act_request);
+        }
+    }
+    if (!active) {
+        nm_manager_for_each_active_connection (priv->manager, active, tmp_clist) {
+            ac_uuid = nm_settings_connection_get_uuid(
+                nm_active_connection_get_settings_connection(active));
+            if (nm_streq(uuid, ac_uuid)) {
+                _LOGT("rollback: connection %s is active", uuid);
+                break;
+            }
         }
     }
 
@@ -203,7 +231,9 @@ find_settings_connection(NMCheckpoint *    self,
 }
 
 static gboolean
-restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkpoint)
+restore_and_activate_connection(NMCheckpoint *    self,
+                                DeviceCheckpoint *dev_checkpoint,
+                                gboolean *        out_touched)
 {
     NMCheckpointPrivate * priv = NM_CHECKPOINT_GET_PRIVATE(self);
     NMSettingsConnection *connection;
@@ -228,6 +258,7 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
     if (connection) {
         if (need_update) {
             _LOGD("rollback: updating connection %s", nm_settings_connection_get_uuid(connection));
+            *out_touched = TRUE;
             persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_KEEP;
             nm_settings_connection_update(
                 connection,
@@ -244,6 +275,7 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
         /* The connection was deleted, recreate it */
         _LOGD("rollback: adding connection %s again",
               nm_connection_get_uuid(dev_checkpoint->settings_connection));
+        *out_touched = TRUE;
 
         persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK;
         if (!nm_settings_add_connection(NM_SETTINGS_GET,
@@ -275,7 +307,8 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
 
     if (need_activation) {
         _LOGD("rollback: reactivating connection %s", nm_settings_connection_get_uuid(connection));
-        subject = nm_auth_subject_new_internal();
+        *out_touched = TRUE;
+        subject      = nm_auth_subject_new_internal();
 
         /* Disconnect the device if needed. This necessary because now
          * the manager prevents the reactivation of the same connection by
@@ -311,6 +344,82 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
     return TRUE;
 }
 
+static void
+_rollback_add_device(NMCheckpoint *    self,
+                     GArray *          rb_devices,
+                     DeviceCheckpoint *dev_checkpoint,
+                     guint32           result,
+                     gboolean          touched,
+                     gint64            t_dev_start)
+{
+    gint64 t_usec;
+
+    t_usec = (nm_utils_get_monotonic_timestamp_nsec() - t_dev_start) / 1000;
+
+    _LOGD("rollback: device %s %s%s (%" G_GINT64_FORMAT ".%03d msec)",
+          dev_checkpoint->original_dev_name,
+          touched ? "restored" : "unchanged",
+          result == NM_ROLLBACK_RESULT_OK ? "" : " (failed)",
+          t_usec / 1000,
+          (int) (t_usec % 1000));
+
+    g_array_append_val(rb_devices,
+                       ((NMCheckpointRollbackDevice){
+                           .dev_path      = dev_checkpoint->original_dev_path,
+                           .duration_usec = t_usec,
+                           .result        = result,
+                           .changed       = touched,
+                       }));
+}
+
+/**
+ * nm_checkpoint_rollback_result_new:
+ * @devices: the result for each device.
+ * @n_devices: the number of elements in @devices.
+ * @duration_usec: the time that the entire rollback took.
+ *
+ * Returns: (transfer full): the "a{sv}" result of the rollback, as returned
+ *   by the CheckpointRollback2() D-Bus method. CheckpointRollback() only
+ *   returns its "devices" entry.
+ */
+GVariant *
+nm_checkpoint_rollback_result_new(const NMCheckpointRollbackDevice *devices,
+                                  guint                             n_devices,
+                                  gint64                            duration_usec)
+{
+    GVariantBuilder builder;
+    GVariantBuilder builder_results;
+    GVariantBuilder builder_changed;
+    GVariantBuilder builder_durations;
+    guint           i;
+
+    g_variant_builder_init(&builder_results, G_VARIANT_TYPE("a{su}"));
+    g_variant_builder_init(&builder_changed, G_VARIANT_TYPE("as"));
+    g_variant_builder_init(&builder_durations, G_VARIANT_TYPE("a{st}"));
+
+    for (i = 0; i < n_devices; i++) {
+        const NMCheckpointRollbackDevice *d = &devices[i];
+
+        g_variant_builder_add(&builder_results, "{su}", d->dev_path, d->result);
+        if (d->changed)
+            g_variant_builder_add(&builder_changed, "s", d->dev_path);
+        g_variant_builder_add(&builder_durations, "{st}", d->dev_path, (guint64) d->duration_usec);
+    }
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    g_variant_builder_add(&builder, "{sv}", "devices", g_variant_builder_end(&builder_results));
+    g_variant_builder_add(&builder,
+                          "{sv}",
+                          "devices-changed",
+                          g_variant_builder_end(&builder_changed));
+    g_variant_builder_add(&builder,
+                          "{sv}",
+                          "device-durations-usec",
+                          g_variant_builder_end(&builder_durations));
+    g_variant_builder_add(&builder, "{sv}", "duration-usec", g_variant_new_uint64(duration_usec));
+    return g_variant_ref_sink(g_variant_builder_end(&builder));
+}
+
 GVariant *
 nm_checkpoint_rollback(NMCheckpoint *self)
 {
@@ -318,17 +427,26 @@ nm_checkpoint_rollback(NMCheckpoint *self)
     DeviceCheckpoint *   dev_checkpoint;
     GHashTableIter       iter;
     NMDevice *           device;
-    GVariantBuilder      builder;
-    uint                 i;
+    gs_unref_array GArray *rb_devices = NULL;
+    GVariant *             result_variant;
+    uint                   i;
+    gint64                 t_start;
+    gint64                 t_dev_start;
+    guint                  n_touched = 0;
+    gboolean               touched;
 
     _LOGI("rollback of %s", nm_dbus_object_get_path(NM_DBUS_OBJECT(self)));
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{su}"));
+
+    rb_devices = g_array_new(FALSE, FALSE, sizeof(NMCheckpointRollbackDevice));
+    t_start    = nm_utils_get_monotonic_timestamp_nsec();
 
     /* Start creating removed devices (if any and if possible) */
     if (priv->removed_devices) {
         for (i = 0; i < priv->removed_devices->len; i++) {
             guint32 result = NM_ROLLBACK_RESULT_OK;
 
+            t_dev_start    = nm_utils_get_monotonic_timestamp_nsec();
+            touched        = FALSE;
             dev_checkpoint = priv->removed_devices->pdata[i];
             _LOGD("rollback: restoring removed device %s (state %d, realized %d, explicitly "
                   "unmanaged %d)",
@@ -338,10 +456,12 @@ nm_checkpoint_rollback(NMCheckpoint *self)
                   dev_checkpoint->unmanaged_explicit);
 
             if (dev_checkpoint->applied_connection) {
-                if (!restore_and_activate_connection(self, dev_checkpoint))
+                if (!restore_and_activate_connection(self, dev_checkpoint, &touched))
                     result = NM_ROLLBACK_RESULT_ERR_FAILED;
             }
-            g_variant_builder_add(&builder, "{su}", dev_checkpoint->original_dev_path, result);
+            _rollback_add_device(self, rb_devices, dev_checkpoint, result, touched, t_dev_start);
+            if (touched)
+                n_touched++;
         }
     }
 
@@ -350,6 +470,9 @@ nm_checkpoint_rollback(NMCheckpoint *self)
     while (g_hash_table_iter_next(&iter, (gpointer *) &device, (gpointer *) &dev_checkpoint)) {
         guint32 result = NM_ROLLBACK_RESULT_OK;
 
+        t_dev_start = nm_utils_get_monotonic_timestamp_nsec();
+        touched     = FALSE;
+
         _LOGD("rollback: restoring device %s (state %d, realized %d, explicitly unmanaged %d)",
               dev_checkpoint->original_dev_name,
               (int) dev_checkpoint->state,
@@ -359,6 +482,7 @@ nm_checkpoint_rollback(NMCheckpoint *self)
         if (nm_device_is_real(device)) {
             if (!dev_checkpoint->realized) {
                 _LOGD("rollback: device was not realized, unmanage it");
+                touched = TRUE;
                 nm_device_set_unmanaged_by_flags_queue(device,
                                                        NM_UNMANAGED_USER_EXPLICIT,
                                                        TRUE,
@@ -383,6 +507,7 @@ nm_checkpoint_rollback(NMCheckpoint *self)
         if (nm_device_get_unmanaged_flags(device, NM_UNMANAGED_USER_EXPLICIT)
             && dev_checkpoint->unmanaged_explicit != NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
             _LOGD("rollback: restore unmanaged user-explicit");
+            touched = TRUE;
             nm_device_set_unmanaged_by_flags_queue(device,
                                                    NM_UNMANAGED_USER_EXPLICIT,
                                                    dev_checkpoint->unmanaged_explicit,
@@ -393,6 +518,7 @@ nm_checkpoint_rollback(NMCheckpoint *self)
             if (nm_device_get_state(device) != NM_DEVICE_STATE_UNMANAGED
                 || dev_checkpoint->unmanaged_explicit == NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
                 _LOGD("rollback: explicitly unmanage device");
+                touched = TRUE;
                 nm_device_set_unmanaged_by_flags_queue(device,
                                                        NM_UNMANAGED_USER_EXPLICIT,
                                                        TRUE,
@@ -403,16 +529,16 @@ nm_checkpoint_rollback(NMCheckpoint *self)
 
 activate:
         if (dev_checkpoint->applied_connection) {
-            if (!restore_and_activate_connection(self, dev_checkpoint)) {
+            if (!restore_and_activate_connection(self, dev_checkpoint, &touched)) {
                 result = NM_ROLLBACK_RESULT_ERR_FAILED;
                 goto next_dev;
             }
         } else {
             /* The device was initially disconnected, deactivate any existing connection */
-            _LOGD("rollback: disconnecting device");
-
             if (nm_device_get_state(device) > NM_DEVICE_STATE_DISCONNECTED
                 && nm_device_get_state(device) < NM_DEVICE_STATE_DEACTIVATING) {
+                _LOGD("rollback: disconnecting device");
+                touched = TRUE;
                 nm_device_state_changed(device,
                                         NM_DEVICE_STATE_DEACTIVATING,
                                         NM_DEVICE_STATE_REASON_USER_REQUESTED);
@@ -420,14 +546,27 @@ activate:
         }
 
 next_dev:
-        g_variant_builder_add(&builder, "{su}", dev_checkpoint->original_dev_path, result);
+        _rollback_add_device(self, rb_devices, dev_checkpoint, result, touched, t_dev_start);
+        if (touched)
+            n_touched++;
     }
 
+    result_variant = nm_checkpoint_rollback_result_new(
+        (const NMCheckpointRollbackDevice *) rb_devices->data,
+        rb_devices->len,
+        (nm_utils_get_monotonic_timestamp_nsec() - t_start) / 1000);
+
+    _LOGI("rollback of %s: %u of %u devices changed (%" G_GINT64_FORMAT " msec)",
+          nm_dbus_object_get_path(NM_DBUS_OBJECT(self)),
+          n_touched,
+          rb_devices->len,
+          (nm_utils_get_monotonic_timestamp_nsec() - t_start) / NM_UTILS_NSEC_PER_MSEC);
+
     if (NM_FLAGS_HAS(priv->flags, NM_CHECKPOINT_CREATE_FLAG_DELETE_NEW_CONNECTIONS)) {
         NMSettingsConnection *con;
         gs_free NMSettingsConnection **list = NULL;
 
-        g_return_val_if_fail(priv->connection_uuids, NULL);
+        g_return_val_if_fail(priv->connection_uuids, result_variant);
         list = nm_settings_get_connections_clone(
             NM_SETTINGS_GET,
             NULL,
@@ -463,7 +602,7 @@ next_dev:
         }
     }
 
-    return g_variant_new("(a{su})", &builder);
+    return result_variant;
 }
 
 static void
@@ -549,9 +688,9 @@ device_checkpoint_create(NMCheckpoint *checkpoint, NMDevice *device)
         settings_connection = nm_act_request_get_settings_connection(act_request);
         applied_connection  = nm_act_request_get_applied_connection(act_request);
 
-        dev_checkpoint->applied_connection  = nm_simple_connection_new_clone(applied_connection);
-        dev_checkpoint->settings_connection = nm_simple_connection_new_clone(
-            nm_settings_connection_get_connection(settings_connection));
+        dev_checkpoint->applied_connection = nm_simple_connection_new_clone(applied_connection);
+        dev_checkpoint->settings_connection =
+            g_object_ref(nm_settings_connection_get_connection(settings_connection));
         dev_checkpoint->ac_version_id =
             nm_active_connection_version_id_get(NM_ACTIVE_CONNECTION(act_request));
         dev_checkpoint->activation_reason =
@@ -47,6 +47,17 @@ void nm_checkpoint_set_timeout_callback(NMCheckpoint *              self,
                                         NMCheckpointTimeoutCallback callback,
                                         gpointer                    user_data);
 
+typedef struct {
+    const char *dev_path;
+    gint64      duration_usec;
+    guint32     result;
+    bool        changed;
+} NMCheckpointRollbackDevice;
+
+GVariant *nm_checkpoint_rollback_result_new(const NMCheckpointRollbackDevice *devices,
+                                            guint                             n_devices,
+                                            gint64                            duration_usec);
+
 GVariant *nm_checkpoint_rollback(NMCheckpoint *self);
 
 void nm_checkpoint_adjust_rollback_timeout(NMCheckpoint *self, guint32 add_timeout);
@@ -24,6 +24,15 @@
 
 #define HEADER_STATUS_ONLINE "X-NetworkManager-Status: online\r\n"
 
+/* after the server replied with the expected response, we still read
+ * the remainder of the reply (up to this size), so that the connection
+ * can be reused for the next check. */
+#define CONCHECK_DRAIN_MAX_SIZE ((gsize) (16 * 1024))
+
+/* how long we keep the connections and DNS entries of an interface around
+ * after the last check on it completed. */
+#define CONCHECK_SHARE_IDLE_TIMEOUT_SEC 120
+
 /*****************************************************************************/
 
 static NM_UTILS_LOOKUP_STR_DEFINE(_state_to_string,
@@ -57,6 +66,22 @@ typedef struct {
     char *response;
 } ConConfig;
 
+#if WITH_CONCHECK
+/* The state that consecutive checks on the same interface and address
+ * family share: the DNS cache (which contains the addresses that we resolved
+ * via systemd-resolved for this interface) and the connection cache. Keeping
+ * them separate per interface ensures that a check never uses a connection
+ * or address that belongs to another interface. */
+typedef struct {
+    CList   shares_lst;
+    char *  ifspec;
+    CURLSH *curl_shandle;
+    guint   ref_count;
+    guint   idle_id;
+    int     addr_family;
+} ConCurlShare;
+#endif
+
 struct _NMConnectivityCheckHandle {
     CList                       handles_lst;
     NMConnectivity *            self;
@@ -73,15 +98,14 @@ struct _NMConnectivityCheckHandle {
         ConConfig *con_config;
 
         GCancellable *     resolve_cancellable;
-        CURLM *            curl_mhandle;
         CURL *             curl_ehandle;
-        struct curl_slist *request_headers;
+        ConCurlShare *     share;
         struct curl_slist *hosts;
 
         gsize response_good_cnt;
+        gsize response_drain_cnt;
 
-        guint curl_timer;
-        int   ch_ifindex;
+        int ch_ifindex;
     } concheck;
 #endif
 
@@ -110,6 +134,17 @@ typedef struct {
     ConConfig *con_config;
     guint      interval;
 
+#if WITH_CONCHECK
+    struct {
+        /* all checks share one multi handle, so that they are driven by
+         * one set of sockets and one timer. */
+        CURLM *curl_mhandle;
+        guint  curl_timer;
+
+        CList shares_lst_head;
+    } concheck;
+#endif
+
     bool enabled : 1;
     bool uri_valid : 1;
 } NMConnectivityPrivate;
@@ -197,6 +232,79 @@ _con_config_get_response(const ConConfig *con_config)
 
 /*****************************************************************************/
 
+#if WITH_CONCHECK
+static void
+_con_curl_share_free(ConCurlShare *share)
+{
+    nm_assert(share->ref_count == 0);
+
+    c_list_unlink_stale(&share->shares_lst);
+    nm_clear_g_source(&share->idle_id);
+    curl_share_cleanup(share->curl_shandle);
+    g_free(share->ifspec);
+    g_slice_free(ConCurlShare, share);
+}
+
+static gboolean
+_con_curl_share_idle_cb(gpointer user_data)
+{
+    ConCurlShare *share = user_data;
+
+    share->idle_id = 0;
+    _con_curl_share_free(share);
+    return G_SOURCE_REMOVE;
+}
+
+static ConCurlShare *
+_con_curl_share_acquire(NMConnectivity *self, const char *ifspec, int addr_family)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    ConCurlShare *         share;
+    CURLSH *               shandle;
+
+    c_list_for_each_entry (share, &priv->concheck.shares_lst_head, shares_lst) {
+        if (share->addr_family == addr_family && nm_streq(share->ifspec, ifspec)) {
+            nm_clear_g_source(&share->idle_id);
+            share->ref_count++;
+            return share;
+        }
+    }
+
+    shandle = curl_share_init();
+    if (!shandle)
+        return NULL;
+
+    curl_share_setopt(shandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    curl_share_setopt(shandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+
+    share  = g_slice_new(ConCurlShare);
+    *share = (ConCurlShare){
+        .ifspec       = g_strdup(ifspec),
+        .curl_shandle = shandle,
+        .ref_count    = 1,
+        .addr_family  = addr_family,
+    };
+    c_list_link_tail(&priv->concheck.shares_lst_head, &share->shares_lst);
+    return share;
+}
+
+static void
+_con_curl_share_release(ConCurlShare *share)
+{
+    nm_assert(share->ref_count > 0);
+
+    if (--share->ref_count > 0)
+        return;
+
+    /* keep the share around for a while, so that the next check on this
+     * interface can reuse the connection. */
+    share->idle_id =
+        g_timeout_add_seconds(CONCHECK_SHARE_IDLE_TIMEOUT_SEC, _con_curl_share_idle_cb, share);
+}
+#endif
+
 static void
 cb_data_complete(NMConnectivityCheckHandle *cb_data,
                  NMConnectivityState        state,
@@ -232,16 +340,15 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HEADERFUNCTION, NULL);
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HEADERDATA, NULL);
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_PRIVATE, NULL);
-        curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HTTPHEADER, NULL);
 
-        curl_multi_remove_handle(cb_data->concheck.curl_mhandle, cb_data->concheck.curl_ehandle);
+        curl_multi_remove_handle(NM_CONNECTIVITY_GET_PRIVATE(self)->concheck.curl_mhandle,
+                                 cb_data->concheck.curl_ehandle);
         curl_easy_cleanup(cb_data->concheck.curl_ehandle);
-        curl_multi_cleanup(cb_data->concheck.curl_mhandle);
 
-        curl_slist_free_all(cb_data->concheck.request_headers);
         curl_slist_free_all(cb_data->concheck.hosts);
     }
-    nm_clear_g_source(&cb_data->concheck.curl_timer);
+    if (cb_data->concheck.share)
+        _con_curl_share_release(cb_data->concheck.share);
     nm_clear_g_cancellable(&cb_data->concheck.resolve_cancellable);
 #endif
 
@@ -269,10 +376,10 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
 #if WITH_CONCHECK
 
 static void
-cb_data_queue_completed(NMConnectivityCheckHandle *cb_data,
-                        NMConnectivityState        state,
-                        const char *               log_message_static,
-                        char *                     log_message_take /* take */)
+cb_data_set_result(NMConnectivityCheckHandle *cb_data,
+                   NMConnectivityState        state,
+                   const char *               log_message_static,
+                   char *                     log_message_take /* take */)
 {
     nm_assert(cb_data);
     nm_assert(NM_IS_CONNECTIVITY(cb_data->self));
@@ -280,12 +387,20 @@ cb_data_queue_completed(NMConnectivityCheckHandle *cb_data,
     nm_assert(log_message_static || log_message_take);
     nm_assert(cb_data->completed_state == NM_CONNECTIVITY_UNKNOWN);
     nm_assert(!cb_data->completed_log_message);
-    nm_assert(c_list_contains(&NM_CONNECTIVITY_GET_PRIVATE(cb_data->self)->handles_lst_head,
-                              &cb_data->handles_lst));
 
     cb_data->completed_state            = state;
     cb_data->completed_log_message      = log_message_static ?: log_message_take;
     cb_data->completed_log_message_free = log_message_take;
+}
+
+static void
+cb_data_queue_completed(NMConnectivityCheckHandle *cb_data)
+{
+    nm_assert(cb_data);
+    nm_assert(NM_IS_CONNECTIVITY(cb_data->self));
+    nm_assert(cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN);
+    nm_assert(c_list_contains(&NM_CONNECTIVITY_GET_PRIVATE(cb_data->self)->handles_lst_head,
+                              &cb_data->handles_lst));
 
     c_list_unlink_stale(&cb_data->handles_lst);
     c_list_link_tail(&NM_CONNECTIVITY_GET_PRIVATE(cb_data->self)->completed_handles_lst_head,
@@ -309,26 +424,74 @@ _complete_queued(NMConnectivity *self)
     nm_g_object_unref(self_keep_alive);
 }
 
+static void
+_con_curl_set_result_from_msg(NMConnectivityCheckHandle *cb_data, CURLMsg *msg)
+{
+    const char *response;
+    long        response_code;
+
+    if (msg->data.result != CURLE_OK) {
+        cb_data_set_result(cb_data,
+                           NM_CONNECTIVITY_LIMITED,
+                           NULL,
+                           g_strdup_printf("check failed: (%d) %s",
+                                           msg->data.result,
+                                           curl_easy_strerror(msg->data.result)));
+        return;
+    }
+
+    response = _con_config_get_response(cb_data->concheck.con_config);
+
+    if (response[0] == '\0'
+        && (curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &response_code)
+            == CURLE_OK)) {
+        if (response_code == 204) {
+            /* We expected an empty response, and we got a 204 response code (no content).
+             * We may or may not have received any content (we would ignore it).
+             * Anyway, the response_code 204 means we are good. */
+            cb_data_set_result(cb_data, NM_CONNECTIVITY_FULL, "no content, as expected", NULL);
+            return;
+        }
+
+        if (response_code == 200 && cb_data->concheck.response_good_cnt == 0) {
+            /* we expected no response, and indeed we got an empty reply (with status code 200) */
+            cb_data_set_result(cb_data,
+                               NM_CONNECTIVITY_FULL,
+                               "empty response, as expected",
+                               NULL);
+            return;
+        }
+    }
+
+    /* If we get here, it means that easy_write_cb() didn't read enough
+     * bytes to be able to do a match, or that we were asking for no content
+     * (204 response code) and we actually got some. Either way, that is
+     * an indication of a captive portal */
+    cb_data_set_result(cb_data, NM_CONNECTIVITY_PORTAL, "unexpected short response", NULL);
+}
+
 static gboolean
-_con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
+_con_curl_check_connectivity(NMConnectivity *self, int sockfd, int ev_bitmask)
 {
+    NMConnectivityPrivate *    priv = NM_CONNECTIVITY_GET_PRIVATE(self);
     NMConnectivityCheckHandle *cb_data;
     CURLMsg *                  msg;
     int                        m_left;
-    long                       response_code;
     CURLMcode                  ret;
     int                        running_handles;
     gboolean                   success = TRUE;
 
-    ret = curl_multi_socket_action(mhandle, sockfd, ev_bitmask, &running_handles);
+    ret = curl_multi_socket_action(priv->concheck.curl_mhandle,
+                                   sockfd,
+                                   ev_bitmask,
+                                   &running_handles);
     if (ret != CURLM_OK) {
         _LOGD("connectivity check failed: (%d) %s", ret, curl_multi_strerror(ret));
         success = FALSE;
     }
 
-    while ((msg = curl_multi_info_read(mhandle, &m_left))) {
-        const char *response;
-        CURLcode    eret;
+    while ((msg = curl_multi_info_read(priv->concheck.curl_mhandle, &m_left))) {
+        CURLcode eret;
 
         if (msg->msg != CURLMSG_DONE)
             continue;
@@ -346,52 +509,12 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
         nm_assert(cb_data);
         nm_assert(NM_IS_CONNECTIVITY(cb_data->self));
 
-        if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
-            /* callback was already invoked earlier. Nothing to do. */
-            continue;
-        }
-
-        if (msg->data.result != CURLE_OK) {
-            cb_data_queue_completed(cb_data,
-                                    NM_CONNECTIVITY_LIMITED,
-                                    NULL,
-                                    g_strdup_printf("check failed: (%d) %s",
-                                                    msg->data.result,
-                                                    curl_easy_strerror(msg->data.result)));
-            continue;
-        }
-
-        response = _con_config_get_response(cb_data->concheck.con_config);
-
-        if (response[0] == '\0'
-            && (curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &response_code)
-                == CURLE_OK)) {
-            if (response_code == 204) {
-                /* We expected an empty response, and we got a 204 response code (no content).
-                 * We may or may not have received any content (we would ignore it).
-                 * Anyway, the response_code 204 means we are good. */
-                cb_data_queue_completed(cb_data,
-                                        NM_CONNECTIVITY_FULL,
-                                        "no content, as expected",
-                                        NULL);
-                continue;
-            }
-
-            if (response_code == 200 && cb_data->concheck.response_good_cnt == 0) {
-                /* we expected no response, and indeed we got an empty reply (with status code 200) */
-                cb_data_queue_completed(cb_data,
-                                        NM_CONNECTIVITY_FULL,
-                                        "empty response, as expected",
-                                        NULL);
-                continue;
-            }
-        }
+        /* the result might be known already, because the callbacks already saw
+         * enough of the response. */
+        if (cb_data->completed_state == NM_CONNECTIVITY_UNKNOWN)
+            _con_curl_set_result_from_msg(cb_data, msg);
 
-        /* If we get here, it means that easy_write_cb() didn't read enough
-         * bytes to be able to do a match, or that we were asking for no content
-         * (204 response code) and we actually got some. Either way, that is
-         * an indication of a captive portal */
-        cb_data_queue_completed(cb_data, NM_CONNECTIVITY_PORTAL, "unexpected short response", NULL);
+        cb_data_queue_completed(cb_data);
     }
 
     /* if we return a failure, we don't know what went wrong. It's likely serious, because
@@ -404,26 +527,27 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
 static gboolean
 _con_curl_timeout_cb(gpointer user_data)
 {
-    NMConnectivityCheckHandle *cb_data = user_data;
+    NMConnectivity *self = user_data;
 
-    _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, CURL_SOCKET_TIMEOUT, 0);
-    _complete_queued(cb_data->self);
+    _con_curl_check_connectivity(self, CURL_SOCKET_TIMEOUT, 0);
+    _complete_queued(self);
     return G_SOURCE_CONTINUE;
 }
 
 static int
 multi_timer_cb(CURLM *multi, long timeout_msec, void *userdata)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
+    NMConnectivity *       self = userdata;
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
 
-    nm_clear_g_source(&cb_data->concheck.curl_timer);
+    nm_clear_g_source(&priv->concheck.curl_timer);
     if (timeout_msec != -1)
-        cb_data->concheck.curl_timer = g_timeout_add(timeout_msec, _con_curl_timeout_cb, cb_data);
+        priv->concheck.curl_timer = g_timeout_add(timeout_msec, _con_curl_timeout_cb, self);
     return 0;
 }
 
 typedef struct {
-    NMConnectivityCheckHandle *cb_data;
+    NMConnectivity *self;
 
     GSource *source;
 
@@ -439,11 +563,11 @@ typedef struct {
 static gboolean
 _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
 {
-    ConCurlSockData *          fdp           = user_data;
-    NMConnectivityCheckHandle *cb_data       = fdp->cb_data;
-    int                        action        = 0;
-    gboolean                   fdp_destroyed = FALSE;
-    gboolean                   success;
+    ConCurlSockData *fdp           = user_data;
+    NMConnectivity * self          = fdp->self;
+    int              action        = 0;
+    gboolean         fdp_destroyed = FALSE;
+    gboolean         success;
 
     if (condition & G_IO_IN)
         action |= CURL_CSELECT_IN;
@@ -455,7 +579,7 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
     nm_assert(!fdp->destroy_notify);
     fdp->destroy_notify = &fdp_destroyed;
 
-    success = _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, fd, action);
+    success = _con_curl_check_connectivity(self, fd, action);
 
     if (fdp_destroyed) {
         /* hups. fdp got invalidated during _con_curl_check_connectivity(). That's fine,
@@ -467,7 +591,7 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
             nm_clear_g_source_inst(&fdp->source);
     }
 
-    _complete_queued(cb_data->self);
+    _complete_queued(self);
 
     return G_SOURCE_CONTINUE;
 }
@@ -475,8 +599,9 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
 static int
 multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void *socketp)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
-    ConCurlSockData *          fdp     = socketp;
+    NMConnectivity *       self = userdata;
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    ConCurlSockData *      fdp  = socketp;
 
     (void) _NM_ENSURE_TYPE(int, fd);
 
@@ -485,7 +610,7 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
             if (fdp->destroy_notify)
                 *fdp->destroy_notify = TRUE;
             nm_clear_g_source_inst(&fdp->source);
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, NULL);
+            curl_multi_assign(priv->concheck.curl_mhandle, fd, NULL);
             g_slice_free(ConCurlSockData, fdp);
         }
     } else {
@@ -494,9 +619,9 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
         if (!fdp) {
             fdp  = g_slice_new(ConCurlSockData);
             *fdp = (ConCurlSockData){
-                .cb_data = cb_data,
+                .self = self,
             };
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, fdp);
+            curl_multi_assign(priv->concheck.curl_mhandle, fd, fdp);
         } else
             nm_clear_g_source_inst(&fdp->source);
 
@@ -530,14 +655,15 @@ easy_header_cb(char *buffer, size_t size, size_t nitems, void *userdata)
     size_t                     len     = size * nitems;
 
     if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
-        /* already completed. */
-        return 0;
+        /* already completed. We only keep receiving, so that the connection
+         * can be reused. */
+        return len;
     }
 
     if (len >= sizeof(HEADER_STATUS_ONLINE) - 1
         && !g_ascii_strncasecmp(buffer, HEADER_STATUS_ONLINE, sizeof(HEADER_STATUS_ONLINE) - 1)) {
-        cb_data_queue_completed(cb_data, NM_CONNECTIVITY_FULL, "status header found", NULL);
-        return 0;
+        cb_data_set_result(cb_data, NM_CONNECTIVITY_FULL, "status header found", NULL);
+        return len;
     }
 
     return len;
@@ -553,8 +679,14 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
     const char *               response;
 
     if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
-        /* already completed. */
-        return 0;
+        /* already completed. If we are online, we read the rest of a (short) reply,
+         * so that the connection can be reused. Otherwise, abort the transfer. */
+        if (cb_data->completed_state != NM_CONNECTIVITY_FULL)
+            return 0;
+        cb_data->concheck.response_drain_cnt += len;
+        if (cb_data->concheck.response_drain_cnt > CONCHECK_DRAIN_MAX_SIZE)
+            return 0;
+        return len;
     }
 
     if (len == 0) {
@@ -584,10 +716,10 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
              *
              * However, if we get an excessive amount of data, we put a stop on it
              * and fail. */
-            cb_data_queue_completed(cb_data,
-                                    NM_CONNECTIVITY_PORTAL,
-                                    "unexpected non-empty response",
-                                    NULL);
+            cb_data_set_result(cb_data,
+                               NM_CONNECTIVITY_PORTAL,
+                               "unexpected non-empty response",
+                               NULL);
             return 0;
         }
 
@@ -601,7 +733,7 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
     check_len = NM_MIN(len, response_len - cb_data->concheck.response_good_cnt);
 
     if (strncmp(&response[cb_data->concheck.response_good_cnt], buffer, check_len) != 0) {
-        cb_data_queue_completed(cb_data, NM_CONNECTIVITY_PORTAL, "unexpected response", NULL);
+        cb_data_set_result(cb_data, NM_CONNECTIVITY_PORTAL, "unexpected response", NULL);
         return 0;
     }
 
@@ -609,8 +741,8 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
 
     if (cb_data->concheck.response_good_cnt >= response_len) {
         /* We already have enough data, and it matched. */
-        cb_data_queue_completed(cb_data, NM_CONNECTIVITY_FULL, "expected response", NULL);
-        return 0;
+        cb_data_set_result(cb_data, NM_CONNECTIVITY_FULL, "expected response", NULL);
+        return len;
     }
 
     return len;
@@ -625,6 +757,14 @@ _timeout_cb(gpointer user_data)
     nm_assert(c_list_contains(&NM_CONNECTIVITY_GET_PRIVATE(cb_data->self)->handles_lst_head,
                               &cb_data->handles_lst));
 
+    if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
+        /* the result is already known and we were only draining the rest of
+         * the reply, so that the connection can be reused. Don't turn that
+         * into a failure. */
+        cb_data_complete(cb_data, cb_data->completed_state, cb_data->completed_log_message);
+        return G_SOURCE_REMOVE;
+    }
+
     cb_data_complete(cb_data, NM_CONNECTIVITY_LIMITED, "timeout");
     return G_SOURCE_REMOVE;
 }
@@ -646,6 +786,28 @@ _idle_cb(gpointer user_data)
 }
 
 #if WITH_CONCHECK
+static CURLM *
+_con_curl_get_mhandle(NMConnectivity *self)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    CURLM *                mhandle;
+
+    if (priv->concheck.curl_mhandle)
+        return priv->concheck.curl_mhandle;
+
+    mhandle = curl_multi_init();
+    if (!mhandle)
+        return NULL;
+
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, self);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, self);
+
+    priv->concheck.curl_mhandle = mhandle;
+    return mhandle;
+}
+
 static void
 do_curl_request(NMConnectivityCheckHandle *cb_data)
 {
@@ -653,7 +815,7 @@ do_curl_request(NMConnectivityCheckHandle *cb_data)
     CURL * ehandle;
     long   resolve;
 
-    mhandle = curl_multi_init();
+    mhandle = _con_curl_get_mhandle(cb_data->self);
     if (!mhandle) {
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
@@ -661,20 +823,14 @@ do_curl_request(NMConnectivityCheckHandle *cb_data)
 
     ehandle = curl_easy_init();
     if (!ehandle) {
-        curl_multi_cleanup(mhandle);
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
     }
 
-    cb_data->concheck.curl_mhandle    = mhandle;
-    cb_data->concheck.curl_ehandle    = ehandle;
-    cb_data->concheck.request_headers = curl_slist_append(NULL, "Connection: close");
-    cb_data->timeout_id               = g_timeout_add_seconds(20, _timeout_cb, cb_data);
-
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, cb_data);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, cb_data);
+    cb_data->concheck.curl_ehandle = ehandle;
+    cb_data->concheck.share =
+        _con_curl_share_acquire(cb_data->self, cb_data->ifspec, cb_data->addr_family);
+    cb_data->timeout_id = g_timeout_add_seconds(20, _timeout_cb, cb_data);
 
     switch (cb_data->addr_family) {
     case AF_INET:
@@ -697,10 +853,11 @@ do_curl_request(NMConnectivityCheckHandle *cb_data)
     curl_easy_setopt(ehandle, CURLOPT_HEADERFUNCTION, easy_header_cb);
     curl_easy_setopt(ehandle, CURLOPT_HEADERDATA, cb_data);
     curl_easy_setopt(ehandle, CURLOPT_PRIVATE, cb_data);
-    curl_easy_setopt(ehandle, CURLOPT_HTTPHEADER, cb_data->concheck.request_headers);
     curl_easy_setopt(ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
     curl_easy_setopt(ehandle, CURLOPT_RESOLVE, cb_data->concheck.hosts);
     curl_easy_setopt(ehandle, CURLOPT_IPRESOLVE, resolve);
+    if (cb_data->concheck.share)
+        curl_easy_setopt(ehandle, CURLOPT_SHARE, cb_data->concheck.share->curl_shandle);
 
     curl_multi_add_handle(mhandle, ehandle);
 }
@@ -904,7 +1061,14 @@ nm_connectivity_check_start(NMConnectivity *            self,
          * This is relatively cumbersome to avoid, because we would have to go through
          * NMDnsSystemdResolved trying to asynchronously start the service, to ensure there
          * is only one attempt to start the service. */
-        has_systemd_resolved = !!nm_dns_manager_get_systemd_resolved(nm_dns_manager_get());
+        if (nm_utils_parse_inaddr_bin(AF_UNSPEC,
+                                      cb_data->concheck.con_config->host,
+                                      NULL,
+                                      NULL)) {
+            /* the host is an IP address already. There is nothing to resolve. */
+            has_systemd_resolved = FALSE;
+        } else
+            has_systemd_resolved = !!nm_dns_manager_get_systemd_resolved(nm_dns_manager_get());
 
         if (has_systemd_resolved) {
             GDBusConnection *dbus_connection;
@@ -1163,6 +1327,9 @@ nm_connectivity_init(NMConnectivity *self)
 
     c_list_init(&priv->handles_lst_head);
     c_list_init(&priv->completed_handles_lst_head);
+#if WITH_CONCHECK
+    c_list_init(&priv->concheck.shares_lst_head);
+#endif
 
     priv->config = g_object_ref(nm_config_get());
     g_signal_connect(G_OBJECT(priv->config),
@@ -1188,6 +1355,9 @@ dispose(GObject *object)
     NMConnectivity *           self = NM_CONNECTIVITY(object);
     NMConnectivityPrivate *    priv = NM_CONNECTIVITY_GET_PRIVATE(self);
     NMConnectivityCheckHandle *cb_data;
+#if WITH_CONCHECK
+    ConCurlShare *share;
+#endif
 
     nm_assert(c_list_is_empty(&priv->completed_handles_lst_head));
 
@@ -1199,6 +1369,14 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->con_config, _con_config_unref);
 
 #if WITH_CONCHECK
+    while ((share = c_list_first_entry(&priv->concheck.shares_lst_head,
+                                       ConCurlShare,
+                                       shares_lst))) {
+        nm_assert(share->ref_count == 0);
+        _con_curl_share_free(share);
+    }
+    nm_clear_g_source(&priv->concheck.curl_timer);
+    nm_clear_pointer(&priv->concheck.curl_mhandle, curl_multi_cleanup);
     curl_global_cleanup();
 #endif
 
@@ -168,8 +168,8 @@ typedef struct _NML3CfgPrivate {
 
     CList acd_event_notify_lst_head;
 
-    NAcd *   nacd;
-    GSource *nacd_source;
+    NAcd *            nacd;
+    NMNetnsAcdHandle *nacd_handle;
 
     GSource *nacd_event_down_source;
     gint64   nacd_event_down_ratelimited_until_msec;
@@ -1133,47 +1133,35 @@ _l3_acd_nacd_event_down_timeout_cb(gpointer user_data)
     return G_SOURCE_REMOVE;
 }
 
-static gboolean
-_l3_acd_nacd_event(int fd, GIOCondition condition, gpointer user_data)
+static void
+_l3_acd_nacd_event(NAcd *nacd, NAcdEvent *event, gpointer user_data)
 {
-    NML3Cfg *self    = user_data;
-    gboolean success = FALSE;
-    int      r;
+    NML3Cfg *          self = user_data;
+    NMEtherAddr        sender_addr_data;
+    const NMEtherAddr *sender_addr;
+    AcdData *          acd_data;
 
     nm_assert(NM_IS_L3CFG(self));
     nm_assert(self->priv.p->nacd);
+    nm_assert(self->priv.p->nacd == nacd);
 
-    r = n_acd_dispatch(self->priv.p->nacd);
-    if (!NM_IN_SET(r, 0, N_ACD_E_PREEMPTED)) {
-        _LOGT("acd: dispatch failed with error %d", r);
-        goto out;
+    if (!event) {
+        /* Something is seriously wrong with our nacd instance. We handle that by
+         * resetting the ACD instance. */
+        _LOGT("acd: dispatching nacd instance failed");
+        _l3_acd_nacd_instance_reset(self, NM_TERNARY_TRUE, TRUE);
+        return;
     }
 
-    while (TRUE) {
-        NMEtherAddr        sender_addr_data;
-        const NMEtherAddr *sender_addr;
-        AcdData *          acd_data;
-        NAcdEvent *        event;
-
-        r = n_acd_pop_event(self->priv.p->nacd, &event);
-        if (r) {
-            _LOGT("acd: pop-event failed with error %d", r);
-            goto out;
-        }
-        if (!event) {
-            success = TRUE;
-            goto out;
-        }
-
-        switch (event->event) {
-        case N_ACD_EVENT_READY:
-            n_acd_probe_get_userdata(event->ready.probe, (void **) &acd_data);
-            _l3_acd_data_state_change(self, acd_data, ACD_STATE_CHANGE_MODE_NACD_READY, NULL, NULL);
-            break;
-        case N_ACD_EVENT_USED:
-        case N_ACD_EVENT_DEFENDED:
-        case N_ACD_EVENT_CONFLICT:
-        {
+    switch (event->event) {
+    case N_ACD_EVENT_READY:
+        n_acd_probe_get_userdata(event->ready.probe, (void **) &acd_data);
+        _l3_acd_data_state_change(self, acd_data, ACD_STATE_CHANGE_MODE_NACD_READY, NULL, NULL);
+        break;
+    case N_ACD_EVENT_USED:
+    case N_ACD_EVENT_DEFENDED:
+    case N_ACD_EVENT_CONFLICT:
+    {
 #define _acd_event_payload_with_sender(event)          \
     ({                                                 \
         NAcdEvent *_event = (event);                   \
@@ -1188,72 +1176,60 @@ _l3_acd_nacd_event(int fd, GIOCondition condition, gpointer user_data)
         &_event->used;                                 \
     })
 
-            n_acd_probe_get_userdata(_acd_event_payload_with_sender(event)->probe,
-                                     (void **) &acd_data);
-
-            if (_acd_event_payload_with_sender(event)->n_sender == ETH_ALEN) {
-                G_STATIC_ASSERT_EXPR(_nm_alignof(NMEtherAddr) == 1);
-                nm_assert(_acd_event_payload_with_sender(event)->sender);
-                memcpy(&sender_addr_data, _acd_event_payload_with_sender(event)->sender, ETH_ALEN);
-                sender_addr = &sender_addr_data;
-            } else {
-                nm_assert_not_reached();
-                sender_addr = &nm_ether_addr_zero;
-            }
+        n_acd_probe_get_userdata(_acd_event_payload_with_sender(event)->probe,
+                                 (void **) &acd_data);
 
-            _l3_acd_data_state_change(self,
-                                      acd_data,
-                                      (AcdStateChangeMode) event->event,
-                                      sender_addr,
-                                      NULL);
-            break;
-        }
-        case N_ACD_EVENT_DOWN:
-            if (!self->priv.p->nacd_event_down_source) {
-                gint64  now_msec;
-                guint32 timeout_msec;
-
-                now_msec = nm_utils_get_monotonic_timestamp_msec();
-                if (self->priv.p->nacd_event_down_ratelimited_until_msec > 0
-                    && now_msec < self->priv.p->nacd_event_down_ratelimited_until_msec)
-                    timeout_msec = self->priv.p->nacd_event_down_ratelimited_until_msec - now_msec;
-                else {
-                    timeout_msec                                         = 0;
-                    self->priv.p->nacd_event_down_ratelimited_until_msec = now_msec + 2000;
-                }
-                _LOGT("acd: message possibly dropped due to device down (schedule handling event "
-                      "in %u msec)",
-                      timeout_msec);
-                self->priv.p->nacd_event_down_source =
-                    nm_g_timeout_source_new(timeout_msec,
-                                            G_PRIORITY_DEFAULT,
-                                            _l3_acd_nacd_event_down_timeout_cb,
-                                            self,
-                                            NULL);
-                g_source_attach(self->priv.p->nacd_event_down_source, NULL);
-            }
-            break;
-        default:
-            _LOGE("acd: unexpected event %u. Ignore", event->event);
+        if (_acd_event_payload_with_sender(event)->n_sender == ETH_ALEN) {
+            G_STATIC_ASSERT_EXPR(_nm_alignof(NMEtherAddr) == 1);
+            nm_assert(_acd_event_payload_with_sender(event)->sender);
+            memcpy(&sender_addr_data, _acd_event_payload_with_sender(event)->sender, ETH_ALEN);
+            sender_addr = &sender_addr_data;
+        } else {
             nm_assert_not_reached();
-            break;
+            sender_addr = &nm_ether_addr_zero;
         }
 
-        /* We are on an idle handler, and the n-acd events are expected to be independent. So, after
-         * each event emit all queued AcdEvent signals. */
-        _nm_l3cfg_emit_signal_notify_acd_event_all(self);
+        _l3_acd_data_state_change(self,
+                                  acd_data,
+                                  (AcdStateChangeMode) event->event,
+                                  sender_addr,
+                                  NULL);
+        break;
     }
-
-    nm_assert_not_reached();
-
-out:
-    if (!success) {
-        /* Something is seriously wrong with our nacd instance. We handle that by resetting the
-         * ACD instance. */
-        _l3_acd_nacd_instance_reset(self, NM_TERNARY_TRUE, TRUE);
+    case N_ACD_EVENT_DOWN:
+        if (!self->priv.p->nacd_event_down_source) {
+            gint64  now_msec;
+            guint32 timeout_msec;
+
+            now_msec = nm_utils_get_monotonic_timestamp_msec();
+            if (self->priv.p->nacd_event_down_ratelimited_until_msec > 0
+                && now_msec < self->priv.p->nacd_event_down_ratelimited_until_msec)
+                timeout_msec = self->priv.p->nacd_event_down_ratelimited_until_msec - now_msec;
+            else {
+                timeout_msec                                         = 0;
+                self->priv.p->nacd_event_down_ratelimited_until_msec = now_msec + 2000;
+            }
+            _LOGT("acd: message possibly dropped due to device down (schedule handling event "
+                  "in %u msec)",
+                  timeout_msec);
+            self->priv.p->nacd_event_down_source =
+                nm_g_timeout_source_new(timeout_msec,
+                                        G_PRIORITY_DEFAULT,
+                                        _l3_acd_nacd_event_down_timeout_cb,
+                                        self,
+                                        NULL);
+            g_source_attach(self->priv.p->nacd_event_down_source, NULL);
+        }
+        break;
+    default:
+        _LOGE("acd: unexpected event %u. Ignore", event->event);
+        nm_assert_not_reached();
+        break;
     }
 
-    return G_SOURCE_CONTINUE;
+    /* We are on an idle handler, and the n-acd events are expected to be independent. So, after
+     * each event emit all queued AcdEvent signals. */
+    _nm_l3cfg_emit_signal_notify_acd_event_all(self);
 }
 
 static gboolean
@@ -1275,9 +1251,9 @@ _l3_acd_nacd_instance_reset(NML3Cfg *self, NMTernary start_timer, gboolean acd_d
 
     if (self->priv.p->nacd) {
         _LOGT("acd: clear nacd instance");
-        self->priv.p->nacd = n_acd_unref(self->priv.p->nacd);
+        self->priv.p->nacd = NULL;
+        nm_clear_pointer(&self->priv.p->nacd_handle, nm_netns_acd_release);
     }
-    nm_clear_g_source_inst(&self->priv.p->nacd_source);
     nm_clear_g_source_inst(&self->priv.p->nacd_instance_ensure_retry);
 
     if (c_list_is_empty(&self->priv.p->acd_lst_head))
@@ -1319,11 +1295,9 @@ static NAcd *
 _l3_acd_nacd_instance_ensure(NML3Cfg *self, gboolean *out_acd_not_supported)
 {
     nm_auto(n_acd_config_freep) NAcdConfig *config = NULL;
-    nm_auto(n_acd_unrefp) NAcd *            nacd   = NULL;
     const guint8 *                          addr_bin;
     gboolean                                acd_not_supported;
     gboolean                                valid;
-    int                                     fd;
     int                                     r;
 
     nm_assert(NM_IS_L3CFG(self));
@@ -1356,17 +1330,16 @@ again:
     n_acd_config_set_transport(config, N_ACD_TRANSPORT_ETHERNET);
     n_acd_config_set_mac(config, addr_bin, ACD_SUPPORTED_ETH_ALEN);
 
-    r = n_acd_new(&nacd, config);
+    /* All instances of the netns share one event source. */
+    r = nm_netns_acd_new(self->priv.netns,
+                         config,
+                         _l3_acd_nacd_event,
+                         self,
+                         &self->priv.p->nacd_handle);
     if (r)
         goto failed_create_acd;
 
-    self->priv.p->nacd = g_steal_pointer(&nacd);
-
-    n_acd_get_fd(self->priv.p->nacd, &fd);
-
-    self->priv.p->nacd_source =
-        nm_g_unix_fd_source_new(fd, G_IO_IN, G_PRIORITY_DEFAULT, _l3_acd_nacd_event, self, NULL);
-    nm_g_source_attach(self->priv.p->nacd_source, NULL);
+    self->priv.p->nacd = nm_netns_acd_get_nacd(self->priv.p->nacd_handle);
 
     NM_SET_OUT(out_acd_not_supported, FALSE);
     return self->priv.p->nacd;
@@ -3797,8 +3770,8 @@ finalize(GObject *object)
     nm_assert(nm_g_hash_table_size(self->priv.p->acd_lst_hash) == 0);
 
     nm_clear_pointer(&self->priv.p->acd_lst_hash, g_hash_table_unref);
-    nm_clear_pointer(&self->priv.p->nacd, n_acd_unref);
-    nm_clear_g_source_inst(&self->priv.p->nacd_source);
+    self->priv.p->nacd = NULL;
+    nm_clear_pointer(&self->priv.p->nacd_handle, nm_netns_acd_release);
     nm_clear_g_source_inst(&self->priv.p->nacd_instance_ensure_retry);
 
     nm_clear_pointer(&self->priv.p->last_addresses_4, g_ptr_array_unref);
@@ -25,6 +25,7 @@
 #include "devices/nm-device-generic.h"
 #include "libnm-platform/nm-platform.h"
 #include "libnm-platform/nmp-object.h"
+#include "libnm-platform/nm-netlink.h"
 #include "nm-hostname-manager.h"
 #include "nm-keep-alive.h"
 #include "nm-rfkill-manager.h"
@@ -307,6 +308,7 @@ NM_DEFINE_SINGLETON_INSTANCE(NMManager);
 /*****************************************************************************/
 
 static const NMDBusInterfaceInfoExtended interface_info_manager;
+static const NMDBusInterfaceInfoExtended interface_info_manager_debug;
 static const GDBusSignalInfo             signal_info_check_permissions;
 static const GDBusSignalInfo             signal_info_state_changed;
 static const GDBusSignalInfo             signal_info_device_added;
@@ -7400,10 +7402,23 @@ checkpoint_auth_done_cb(NMAuthChain *chain, GDBusMethodInvocation *context, gpoi
         } else if (nm_streq0(op, NM_AUDIT_OP_CHECKPOINT_DESTROY)) {
             nm_checkpoint_manager_destroy(_checkpoint_mgr_get(self, TRUE), checkpoint_path, &error);
         } else if (nm_streq0(op, NM_AUDIT_OP_CHECKPOINT_ROLLBACK)) {
-            nm_checkpoint_manager_rollback(_checkpoint_mgr_get(self, TRUE),
-                                           checkpoint_path,
-                                           &variant,
-                                           &error);
+            gs_unref_variant GVariant *rollback_result = NULL;
+
+            if (nm_checkpoint_manager_rollback(_checkpoint_mgr_get(self, TRUE),
+                                               checkpoint_path,
+                                               &rollback_result,
+                                               &error)) {
+                if (nm_auth_chain_get_data(chain, "rollback2"))
+                    variant = g_variant_new("(@a{sv})", rollback_result);
+                else {
+                    gs_unref_variant GVariant *devices = NULL;
+
+                    devices = g_variant_lookup_value(rollback_result,
+                                                     "devices",
+                                                     G_VARIANT_TYPE("a{su}"));
+                    variant = g_variant_new("(@a{su})", devices);
+                }
+            }
         } else if (nm_streq0(op, NM_AUDIT_OP_CHECKPOINT_ADJUST_ROLLBACK_TIMEOUT)) {
             add_timeout = GPOINTER_TO_UINT(nm_auth_chain_get_data(chain, "add_timeout"));
             nm_checkpoint_manager_adjust_rollback_timeout(_checkpoint_mgr_get(self, TRUE),
@@ -7525,6 +7540,52 @@ impl_manager_checkpoint_rollback(NMDBusObject *                     obj,
     nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_CHECKPOINT_ROLLBACK, TRUE);
 }
 
+static void
+impl_manager_checkpoint_rollback2(NMDBusObject *                     obj,
+                                  const NMDBusInterfaceInfoExtended *interface_info,
+                                  const NMDBusMethodInfoExtended *   method_info,
+                                  GDBusConnection *                  connection,
+                                  const char *                       sender,
+                                  GDBusMethodInvocation *            invocation,
+                                  GVariant *                         parameters)
+{
+    NMManager *       self = NM_MANAGER(obj);
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    NMAuthChain *     chain;
+    const char *      checkpoint_path;
+    gs_unref_variant GVariant *args = NULL;
+    GVariantIter               iter;
+    const char *               args_name;
+
+    g_variant_get(parameters, "(&o@a{sv})", &checkpoint_path, &args);
+
+    /* no arguments are supported yet. */
+    g_variant_iter_init(&iter, args);
+    if (g_variant_iter_next(&iter, "{&sv}", &args_name, NULL)) {
+        g_dbus_method_invocation_return_error(invocation,
+                                              NM_MANAGER_ERROR,
+                                              NM_MANAGER_ERROR_INVALID_ARGUMENTS,
+                                              "unsupported argument '%s'",
+                                              args_name);
+        return;
+    }
+
+    chain = nm_auth_chain_new_context(invocation, checkpoint_auth_done_cb, self);
+    if (!chain) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_AUTH_FAILED);
+        return;
+    }
+
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "audit-op", NM_AUDIT_OP_CHECKPOINT_ROLLBACK, NULL);
+    nm_auth_chain_set_data(chain, "checkpoint_path", g_strdup(checkpoint_path), g_free);
+    nm_auth_chain_set_data(chain, "rollback2", GUINT_TO_POINTER(TRUE), NULL);
+    nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_CHECKPOINT_ROLLBACK, TRUE);
+}
+
 static void
 impl_manager_checkpoint_adjust_rollback_timeout(NMDBusObject *                     obj,
                                                 const NMDBusInterfaceInfoExtended *interface_info,
@@ -7560,6 +7621,103 @@ impl_manager_checkpoint_adjust_rollback_timeout(NMDBusObject *
 
 /*****************************************************************************/
 
+static void
+_statistics_add(GVariantBuilder *builder, const char *key, guint64 value)
+{
+    g_variant_builder_add(builder, "{sv}", key, g_variant_new_uint64(value));
+}
+
+static GVariant *
+_statistics_to_variant(NMManager *self)
+{
+    NMManagerPrivate *     priv = NM_MANAGER_GET_PRIVATE(self);
+    NMPlatformStatistics   stats;
+    NMDedupMultiIndexStats idx_stats;
+    GVariantBuilder        builder;
+    guint64                auth_hits;
+    guint64                auth_misses;
+    char                   key[100];
+    guint                  i;
+
+    nm_platform_get_statistics(priv->platform, &stats);
+    nm_dedup_multi_index_get_stats(nm_platform_get_multi_idx(priv->platform), &idx_stats);
+    nm_auth_manager_get_cache_stats(priv->auth_mgr, &auth_hits, &auth_misses);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+
+    for (i = 0; i < G_N_ELEMENTS(stats.netlink.nl_msgs); i++) {
+        const char *type_str;
+
+        if (stats.netlink.nl_msgs[i] == 0)
+            continue;
+
+        type_str = nl_nlmsg_type_to_str(i);
+        if (type_str)
+            nm_sprintf_buf(key, "platform.netlink.rx.%s", type_str);
+        else
+            nm_sprintf_buf(key, "platform.netlink.rx.%u", i);
+        _statistics_add(&builder, key, stats.netlink.nl_msgs[i]);
+    }
+    _statistics_add(&builder, "platform.netlink.rx-other", stats.netlink.nl_msgs_other);
+    _statistics_add(&builder, "platform.netlink.overflows", stats.netlink.nl_overflows);
+
+    for (i = 0; i < _NM_PLATFORM_DUMP_REASON_NUM; i++) {
+        nm_sprintf_buf(key, "platform.dumps.%s", nm_platform_dump_reason_to_string(i));
+        _statistics_add(&builder, key, stats.netlink.dumps[i]);
+    }
+    _statistics_add(&builder, "platform.dumps.completed", stats.netlink.dumps_completed);
+    _statistics_add(&builder, "platform.dumps.failed", stats.netlink.dumps_failed);
+    _statistics_add(&builder,
+                    "platform.dumps.time-total-usec",
+                    stats.netlink.dump_time_total_usec);
+    _statistics_add(&builder, "platform.dumps.time-max-usec", stats.netlink.dump_time_max_usec);
+
+    for (i = 1; i < G_N_ELEMENTS(stats.cache); i++) {
+        const char *obj_type_name;
+
+        if (stats.cache[i].n_objs == 0)
+            continue;
+
+        obj_type_name = nmp_class_from_type(i)->obj_type_name;
+        nm_sprintf_buf(key, "platform.cache.%s.objects", obj_type_name);
+        _statistics_add(&builder, key, stats.cache[i].n_objs);
+        nm_sprintf_buf(key, "platform.cache.%s.size", obj_type_name);
+        _statistics_add(&builder, key, stats.cache[i].size);
+    }
+
+    _statistics_add(&builder, "platform.multi-idx.objects", idx_stats.n_objs);
+    _statistics_add(&builder, "platform.multi-idx.entries", idx_stats.n_entries);
+    _statistics_add(&builder, "platform.multi-idx.head-entries", idx_stats.n_head_entries);
+    _statistics_add(&builder, "platform.multi-idx.entries-size", idx_stats.entries_size);
+    _statistics_add(&builder, "platform.multi-idx.tables-size", idx_stats.tables_size);
+    _statistics_add(&builder, "platform.multi-idx.intern-hits", idx_stats.intern_hits);
+    _statistics_add(&builder, "platform.multi-idx.intern-misses", idx_stats.intern_misses);
+    _statistics_add(&builder, "platform.multi-idx.entries-added", idx_stats.entries_added);
+    _statistics_add(&builder, "platform.multi-idx.entries-removed", idx_stats.entries_removed);
+
+    _statistics_add(&builder, "auth.cache-hits", auth_hits);
+    _statistics_add(&builder, "auth.cache-misses", auth_misses);
+
+    return g_variant_builder_end(&builder);
+}
+
+static void
+impl_manager_debug_get_statistics(NMDBusObject *                     obj,
+                                  const NMDBusInterfaceInfoExtended *interface_info,
+                                  const NMDBusMethodInfoExtended *   method_info,
+                                  GDBusConnection *                  connection,
+                                  const char *                       sender,
+                                  GDBusMethodInvocation *            invocation,
+                                  GVariant *                         parameters)
+{
+    NMManager *self = NM_MANAGER(obj);
+
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(@a{sv})", _statistics_to_variant(self)));
+}
+
+/*****************************************************************************/
+
 static void
 auth_mgr_changed(NMAuthManager *auth_manager, gpointer user_data)
 {
@@ -8411,6 +8569,15 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
                     .out_args =
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("result", "a{su}"), ), ),
                 .handle = impl_manager_checkpoint_rollback, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "CheckpointRollback2",
+                    .in_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("checkpoint", "o"),
+                                                  NM_DEFINE_GDBUS_ARG_INFO("args", "a{sv}"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("result", "a{sv}"), ), ),
+                .handle = impl_manager_checkpoint_rollback2, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "CheckpointAdjustRollbackTimeout",
@@ -8502,6 +8669,17 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
                 NM_AUDIT_OP_NET_CONTROL), ), ),
 };
 
+static const NMDBusInterfaceInfoExtended interface_info_manager_debug = {
+    .parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT(
+        NM_DBUS_INTERFACE_DEBUG,
+        .methods = NM_DEFINE_GDBUS_METHOD_INFOS(NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+            NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                "GetStatistics",
+                .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                    NM_DEFINE_GDBUS_ARG_INFO("statistics", "a{sv}"), ), ),
+            .handle = impl_manager_debug_get_statistics, ), ), ),
+};
+
 static void
 nm_manager_class_init(NMManagerClass *manager_class)
 {
@@ -8509,7 +8687,8 @@ nm_manager_class_init(NMManagerClass *manager_class)
     NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS(manager_class);
 
     dbus_object_class->export_path     = NM_DBUS_EXPORT_PATH_STATIC(NM_DBUS_PATH);
-    dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS(&interface_info_manager);
+    dbus_object_class->interface_infos =
+        NM_DBUS_INTERFACE_INFOS(&interface_info_manager, &interface_info_manager_debug);
 
     object_class->constructed  = constructed;
     object_class->set_property = set_property;
@@ -16,20 +16,24 @@
 #include "libnm-platform/nm-platform.h"
 #include "libnm-platform/nmp-netns.h"
 #include "libnm-platform/nmp-rules-manager.h"
+#include "n-acd/src/n-acd.h"
 
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE_BASE(PROP_PLATFORM, );
 
 typedef struct {
-    NMNetns *        _self_signal_user_data;
-    NMPlatform *     platform;
-    NMPNetns *       platform_netns;
-    NMPRulesManager *rules_manager;
-    GHashTable *     l3cfgs;
-    GHashTable *     shared_ips;
-    CList            l3cfg_signal_pending_lst_head;
-    guint            signal_pending_idle_id;
+    NMNetns *         _self_signal_user_data;
+    NMPlatform *      platform;
+    NMPNetns *        platform_netns;
+    NMPRulesManager * rules_manager;
+    GHashTable *      l3cfgs;
+    GHashTable *      shared_ips;
+    NAcdShared *      acd_shared;
+    GSource *         acd_shared_source;
+    CList             acd_lst_head;
+    CList             l3cfg_signal_pending_lst_head;
+    guint             signal_pending_idle_id;
 } NMNetnsPrivate;
 
 struct _NMNetns {
@@ -352,6 +356,211 @@ nm_netns_shared_ip_release(NMNetnsSharedIPHandle *handle)
 
 /*****************************************************************************/
 
+struct _NMNetnsAcdHandle {
+    CList               acd_lst;
+    NMNetns *           self;
+    NAcd *              nacd;
+    NAcdShared *        acd_shared;
+    NMNetnsAcdEventFunc event_func;
+    gpointer            user_data;
+    bool                fail_pending : 1;
+};
+
+static void
+_acd_shared_clear(NMNetns *self)
+{
+    NMNetnsPrivate *priv = NM_NETNS_GET_PRIVATE(self);
+
+    if (!priv->acd_shared)
+        return;
+
+    _LOGT("acd: release shared context");
+    nm_clear_g_source_inst(&priv->acd_shared_source);
+    priv->acd_shared = n_acd_shared_unref(priv->acd_shared);
+}
+
+static gboolean
+_acd_shared_event_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    gs_unref_object NMNetns *                self       = g_object_ref(NM_NETNS(user_data));
+    NMNetnsPrivate *                         priv       = NM_NETNS_GET_PRIVATE(self);
+    nm_auto(n_acd_shared_unrefp) NAcdShared *acd_shared = NULL;
+    NMNetnsAcdHandle *                       handle;
+    int                                      r;
+
+    /* Callbacks may release the last instance, and with it the shared context. */
+    acd_shared = n_acd_shared_ref(priv->acd_shared);
+
+    r = n_acd_shared_dispatch(acd_shared);
+    if (!NM_IN_SET(r, 0, N_ACD_E_PREEMPTED)) {
+        _LOGT("acd: dispatch failed with error %d", r);
+        goto fail;
+    }
+
+    while (TRUE) {
+        NAcdEvent *event;
+        NAcd *     nacd;
+
+        r = n_acd_shared_pop_event(acd_shared, &nacd, &event);
+        if (r) {
+            _LOGT("acd: pop-event failed with error %d", r);
+            goto fail;
+        }
+        if (!event)
+            return G_SOURCE_CONTINUE;
+
+        n_acd_get_userdata(nacd, (void **) &handle);
+        if (!handle) {
+            /* The user already released this instance, but probes still keep
+             * it alive. Drop the event. */
+            continue;
+        }
+
+        nm_assert(handle->nacd == nacd);
+        handle->event_func(nacd, event, handle->user_data);
+    }
+
+fail:
+    /* We cannot tell which instance is broken. Stop polling the shared context,
+     * so that new instances get a new one, and notify all users, so that they
+     * reset their instance.
+     *
+     * The callbacks may release and create handles while we iterate. Mark the
+     * handles to notify, and restart from the head after each callback. */
+    c_list_for_each_entry (handle, &priv->acd_lst_head, acd_lst)
+        handle->fail_pending = (handle->acd_shared == acd_shared);
+
+    if (priv->acd_shared == acd_shared)
+        _acd_shared_clear(self);
+
+again:
+    c_list_for_each_entry (handle, &priv->acd_lst_head, acd_lst) {
+        if (handle->fail_pending) {
+            handle->fail_pending = FALSE;
+            handle->event_func(handle->nacd, NULL, handle->user_data);
+            goto again;
+        }
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * nm_netns_acd_new:
+ * @self: the #NMNetns
+ * @config: the NAcdConfig for the new instance
+ * @event_func: the callback for events of the new instance
+ * @user_data: the user data for @event_func
+ * @out_handle: (out): the handle for the new NAcd instance
+ *
+ * All NAcd instances of one network namespace share one n-acd context,
+ * that is one epoll file descriptor, one timer and one GSource, regardless
+ * of the number of interfaces. Only the packet socket is per instance.
+ * The events of the instance are passed to @event_func. The handle must
+ * be released with nm_netns_acd_release().
+ *
+ * Returns: zero on success, or an n-acd error code.
+ */
+int
+nm_netns_acd_new(NMNetns *           self,
+                 NAcdConfig *        config,
+                 NMNetnsAcdEventFunc event_func,
+                 gpointer            user_data,
+                 NMNetnsAcdHandle ** out_handle)
+{
+    NMNetnsPrivate *  priv;
+    NMNetnsAcdHandle *handle;
+    NAcd *            nacd;
+    int               fd;
+    int               r;
+
+    g_return_val_if_fail(NM_IS_NETNS(self), -EINVAL);
+    g_return_val_if_fail(config, -EINVAL);
+    g_return_val_if_fail(event_func, -EINVAL);
+    g_return_val_if_fail(out_handle, -EINVAL);
+
+    priv = NM_NETNS_GET_PRIVATE(self);
+
+    if (!priv->acd_shared) {
+        r = n_acd_shared_new(&priv->acd_shared);
+        if (r)
+            return r;
+
+        n_acd_shared_get_fd(priv->acd_shared, &fd);
+        priv->acd_shared_source = nm_g_unix_fd_source_new(fd,
+                                                          G_IO_IN,
+                                                          G_PRIORITY_DEFAULT,
+                                                          _acd_shared_event_cb,
+                                                          self,
+                                                          NULL);
+        nm_g_source_attach(priv->acd_shared_source, NULL);
+        _LOGT("acd: create shared context");
+    }
+
+    n_acd_config_set_shared(config, priv->acd_shared);
+    r = n_acd_new(&nacd, config);
+    n_acd_config_set_shared(config, NULL);
+    if (r) {
+        if (c_list_is_empty(&priv->acd_lst_head))
+            _acd_shared_clear(self);
+        return r;
+    }
+
+    if (c_list_is_empty(&priv->acd_lst_head)) {
+        /* the handles keep the netns alive. */
+        g_object_ref(self);
+    }
+
+    handle  = g_slice_new(NMNetnsAcdHandle);
+    *handle = (NMNetnsAcdHandle){
+        .self       = self,
+        .nacd       = nacd,
+        .acd_shared = priv->acd_shared,
+        .event_func = event_func,
+        .user_data  = user_data,
+    };
+    c_list_link_tail(&priv->acd_lst_head, &handle->acd_lst);
+    n_acd_set_userdata(nacd, handle);
+
+    *out_handle = handle;
+    return 0;
+}
+
+NAcd *
+nm_netns_acd_get_nacd(const NMNetnsAcdHandle *handle)
+{
+    g_return_val_if_fail(handle, NULL);
+
+    return handle->nacd;
+}
+
+void
+nm_netns_acd_release(NMNetnsAcdHandle *handle)
+{
+    NMNetns *       self;
+    NMNetnsPrivate *priv;
+
+    g_return_if_fail(handle);
+
+    self = handle->self;
+    priv = NM_NETNS_GET_PRIVATE(self);
+
+    nm_assert(c_list_contains(&priv->acd_lst_head, &handle->acd_lst));
+
+    /* The instance may outlive this call, as long as there are probes on it.
+     * Clear the user data, so that we ignore events that are still queued. */
+    n_acd_set_userdata(handle->nacd, NULL);
+    n_acd_unref(handle->nacd);
+    c_list_unlink_stale(&handle->acd_lst);
+    nm_g_slice_free(handle);
+
+    if (c_list_is_empty(&priv->acd_lst_head)) {
+        _acd_shared_clear(self);
+        g_object_unref(self);
+    }
+}
+
+/*****************************************************************************/
+
 static void
 set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
 {
@@ -380,6 +589,7 @@ nm_netns_init(NMNetns *self)
     NMNetnsPrivate *priv = NM_NETNS_GET_PRIVATE(self);
 
     priv->_self_signal_user_data = self;
+    c_list_init(&priv->acd_lst_head);
     c_list_init(&priv->l3cfg_signal_pending_lst_head);
 }
 
@@ -459,6 +669,8 @@ dispose(GObject *object)
     nm_assert(nm_g_hash_table_size(priv->l3cfgs) == 0);
     nm_assert(c_list_is_empty(&priv->l3cfg_signal_pending_lst_head));
     nm_assert(!priv->shared_ips);
+    nm_assert(c_list_is_empty(&priv->acd_lst_head));
+    nm_assert(!priv->acd_shared);
 
     nm_clear_g_source(&priv->signal_pending_idle_id);
 
@@ -51,4 +51,27 @@ NMNetnsSharedIPHandle *nm_netns_shared_ip_reserve(NMNetns *self);
 
 void nm_netns_shared_ip_release(NMNetnsSharedIPHandle *handle);
 
+/*****************************************************************************/
+
+struct NAcd;
+struct NAcdConfig;
+struct NAcdEvent;
+
+typedef struct _NMNetnsAcdHandle NMNetnsAcdHandle;
+
+/* Called for each event of an NAcd instance created via nm_netns_acd_new().
+ * A %NULL @event means that the shared ACD context failed, and the user is
+ * expected to release and recreate its instance. */
+typedef void (*NMNetnsAcdEventFunc)(struct NAcd *nacd, struct NAcdEvent *event, gpointer user_data);
+
+int nm_netns_acd_new(NMNetns *           self,
+                     struct NAcdConfig * config,
+                     NMNetnsAcdEventFunc event_func,
+                     gpointer            user_data,
+                     NMNetnsAcdHandle ** out_handle);
+
+struct NAcd *nm_netns_acd_get_nacd(const NMNetnsAcdHandle *handle);
+
+void nm_netns_acd_release(NMNetnsAcdHandle *handle);
+
 #endif /* __NM_NETNS_H__ */
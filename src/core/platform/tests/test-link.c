@@ -2512,6 +2512,159 @@ test_create_many_links(gconstpointer user_data)
 
 /*****************************************************************************/
 
+static guint
+_wireguard_peers_len(int ifindex)
+{
+    const NMPlatformLnkWireGuard *plnk;
+
+    plnk = nm_platform_link_get_lnk_wireguard(NM_PLATFORM_GET, ifindex, NULL);
+    g_assert(plnk);
+    return NMP_OBJECT_UP_CAST(plnk)->_lnk_wireguard.peers_len;
+}
+
+static gint64
+_wireguard_change_timed(int                            ifindex,
+                        const NMPlatformLnkWireGuard * lnk_wireguard,
+                        GArray *                       peers,
+                        NMPlatformWireGuardChangeFlags change_flags)
+{
+    gint64 start_time = nm_utils_get_monotonic_timestamp_nsec();
+    int    r;
+
+    r = nm_platform_link_wireguard_change(NM_PLATFORM_GET,
+                                          ifindex,
+                                          lnk_wireguard,
+                                          (const NMPWireGuardPeer *) peers->data,
+                                          NULL,
+                                          peers->len,
+                                          change_flags);
+    g_assert(NMTST_NM_ERR_SUCCESS(r));
+    return NM_MAX(nm_utils_get_monotonic_timestamp_nsec() - start_time, (gint64) 1);
+}
+
+static void
+test_wireguard_sync_peers(gconstpointer user_data)
+{
+    const NMPlatformWireGuardChangeFlags CHANGE_FLAGS =
+        NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT
+        | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK
+        | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS;
+    guint                          n_peers = GPOINTER_TO_UINT(user_data);
+    gs_unref_array GArray *peers           = NULL;
+    gs_free NMPWireGuardAllowedIP *aips    = NULL;
+    NMPlatformLnkWireGuard         lnk_wireguard;
+    const NMPlatformLink *         plink;
+    gint64                         t_replace;
+    gint64                         t_sync;
+    int                            ifindex;
+    int                            r;
+    guint                          i;
+
+    if (n_peers > 1000 && nmtst_test_quick()) {
+        g_print("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n",
+                g_get_prgname() ?: "test-link-linux");
+        g_test_skip("Skip long running test");
+        return;
+    }
+
+    r = nm_platform_link_wireguard_add(NM_PLATFORM_GET, DEVICE_NAME, &plink);
+    if (r == -EOPNOTSUPP) {
+        g_test_skip("wireguard not supported (modprobe wireguard?)");
+        return;
+    }
+    g_assert(NMTST_NM_ERR_SUCCESS(r));
+    ifindex = plink->ifindex;
+
+    lnk_wireguard = (NMPlatformLnkWireGuard){
+        .listen_port = 50755,
+        .fwmark      = 0x1103,
+    };
+
+    peers = g_array_sized_new(FALSE, TRUE, sizeof(NMPWireGuardPeer), n_peers);
+    aips  = g_new0(NMPWireGuardAllowedIP, n_peers);
+    for (i = 0; i < n_peers; i++) {
+        NMPWireGuardPeer peer = {
+            .persistent_keepalive_interval = 25,
+            .endpoint.in =
+                {
+                    .sin_family      = AF_INET,
+                    .sin_addr.s_addr = htonl(0xC0A80000u + i),
+                    .sin_port        = htons(51820),
+                },
+            .allowed_ips     = &aips[i],
+            .allowed_ips_len = 1,
+        };
+
+        aips[i] = (NMPWireGuardAllowedIP){
+            .family     = AF_INET,
+            .addr.addr4 = htonl(0x0A000000u + i),
+            .mask       = 32,
+        };
+        nmtst_rand_buf(NULL, peer.public_key, sizeof(peer.public_key));
+        g_array_append_val(peers, peer);
+    }
+
+    t_replace = _wireguard_change_timed(ifindex, &lnk_wireguard, peers, CHANGE_FLAGS);
+    g_assert_cmpint(_wireguard_peers_len(ifindex), ==, n_peers);
+
+    /* re-applying the same configuration sends nothing. */
+    t_sync = _wireguard_change_timed(ifindex,
+                                     &lnk_wireguard,
+                                     peers,
+                                     CHANGE_FLAGS | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC);
+    g_assert_cmpint(_wireguard_peers_len(ifindex), ==, n_peers);
+
+    _LOGI(">>> %u peers: replace %" G_GINT64_FORMAT " usec (%" G_GINT64_FORMAT
+          " peers/sec), unchanged sync %" G_GINT64_FORMAT " usec",
+          n_peers,
+          t_replace / 1000,
+          ((gint64) n_peers) * NM_UTILS_NSEC_PER_SEC / t_replace,
+          t_sync / 1000);
+
+    /* change the endpoint of one peer, and drop another one. */
+    if (n_peers >= 2) {
+        const NMPlatformLnkWireGuard *plnk;
+        const NMPObject *             lnk;
+        NMPWireGuardPeer *            p0 = &g_array_index(peers, NMPWireGuardPeer, 0);
+        guint8                        removed_key[NMP_WIREGUARD_PUBLIC_KEY_LEN];
+        gboolean                      found_p0 = FALSE;
+
+        p0->endpoint.in.sin_port = htons(51821);
+        memcpy(removed_key,
+               g_array_index(peers, NMPWireGuardPeer, n_peers - 1).public_key,
+               sizeof(removed_key));
+        g_array_set_size(peers, n_peers - 1);
+
+        t_sync = _wireguard_change_timed(ifindex,
+                                         &lnk_wireguard,
+                                         peers,
+                                         CHANGE_FLAGS | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC);
+
+        plnk = nm_platform_link_get_lnk_wireguard(NM_PLATFORM_GET, ifindex, NULL);
+        g_assert(plnk);
+        lnk = NMP_OBJECT_UP_CAST(plnk);
+        g_assert_cmpint(lnk->_lnk_wireguard.peers_len, ==, n_peers - 1);
+        for (i = 0; i < lnk->_lnk_wireguard.peers_len; i++) {
+            const NMPWireGuardPeer *p = &lnk->_lnk_wireguard.peers[i];
+
+            g_assert(memcmp(p->public_key, removed_key, sizeof(removed_key)) != 0);
+            if (memcmp(p->public_key, p0->public_key, sizeof(p0->public_key)) == 0) {
+                g_assert_cmpint(nm_sock_addr_union_cmp(&p->endpoint, &p0->endpoint), ==, 0);
+                found_p0 = TRUE;
+            }
+        }
+        g_assert(found_p0);
+
+        _LOGI(">>> %u peers: sync of 2 changed peers %" G_GINT64_FORMAT " usec",
+              n_peers,
+              t_sync / 1000);
+    }
+
+    nmtstp_link_delete(NULL, -1, ifindex, DEVICE_NAME, TRUE);
+}
+
+/*****************************************************************************/
+
 static void
 test_nl_bugs_veth(void)
 {
@@ -2716,7 +2869,7 @@ _test_netns_create_platform(void)
     netns = nmp_netns_new();
     g_assert(NMP_IS_NETNS(netns));
 
-    platform = nm_linux_platform_new(TRUE, TRUE);
+    platform = nm_linux_platform_new(TRUE, TRUE, FALSE);
     g_assert(NM_IS_LINUX_PLATFORM(platform));
 
     nmp_netns_pop(netns);
@@ -2805,7 +2958,7 @@ test_netns_general(gpointer fixture, gconstpointer test_data)
     if (_check_sysctl_skip())
         return;
 
-    platform_1 = nm_linux_platform_new(TRUE, TRUE);
+    platform_1 = nm_linux_platform_new(TRUE, TRUE, FALSE);
     platform_2 = _test_netns_create_platform();
 
     /* add some dummy devices. The "other-*" devices are there to bump the ifindex */
@@ -2933,7 +3086,7 @@ test_netns_set_netns(gpointer fixture, gconstpointer test_data)
     if (_test_netns_check_skip())
         return;
 
-    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE);
+    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE, FALSE);
     platforms[1] = platform_1 = _test_netns_create_platform();
     platforms[2] = platform_2 = _test_netns_create_platform();
 
@@ -3032,7 +3185,7 @@ test_netns_push(gpointer fixture, gconstpointer test_data)
     if (_check_sysctl_skip())
         return;
 
-    pl[0].platform = platform_0 = nm_linux_platform_new(TRUE, TRUE);
+    pl[0].platform = platform_0 = nm_linux_platform_new(TRUE, TRUE, FALSE);
     pl[1].platform = platform_1 = _test_netns_create_platform();
     pl[2].platform = platform_2 = _test_netns_create_platform();
 
@@ -3179,7 +3332,7 @@ test_netns_bind_to_path(gpointer fixture, gconstpointer test_data)
     if (_test_netns_check_skip())
         return;
 
-    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE);
+    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE, FALSE);
     platforms[1] = platform_1 = _test_netns_create_platform();
     platforms[2] = platform_2 = _test_netns_create_platform();
 
@@ -3344,7 +3497,7 @@ test_sysctl_netns_switch(void)
     if (_test_netns_check_skip())
         return;
 
-    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE);
+    platforms[0] = platform_0 = nm_linux_platform_new(TRUE, TRUE, FALSE);
     platforms[1] = platform_1 = _test_netns_create_platform();
     platforms[2] = platform_2 = _test_netns_create_platform();
     PL                        = platforms[nmtst_get_rand_uint32() % 3];
@@ -3724,7 +3877,7 @@ test_ethtool_features_get(void)
 
         _LOGT(">>> ethtool-features-get RUN %u (do-set=%s", i_run, do_set ? "set" : "reset");
 
-        features = nmp_utils_ethtool_get_features(IFINDEX);
+        features = nmp_utils_ethtool_get_features(NULL, IFINDEX);
         g_ptr_array_add(gfree_keeper, features);
 
         ethtool_features_dump(features);
@@ -3737,8 +3890,137 @@ test_ethtool_features_get(void)
             features  = gfree_keeper->pdata[i_run * 2 - 1];
         }
 
-        nmp_utils_ethtool_set_features(IFINDEX, features, requested, do_set);
+        nmp_utils_ethtool_set_features(NULL, IFINDEX, features, requested, do_set);
+    }
+}
+
+static void
+_assert_ethtool_features_equal(const NMEthtoolFeatureStates *a, const NMEthtoolFeatureStates *b)
+{
+    guint i;
+
+    g_assert(a);
+    g_assert(b);
+    g_assert_cmpint(a->n_ss_features, ==, b->n_ss_features);
+    g_assert_cmpint(a->n_states, ==, b->n_states);
+    for (i = 0; i < a->n_states; i++) {
+        g_assert(a->states_list[i].info == b->states_list[i].info);
+        g_assert_cmpint(a->states_list[i].idx_ss_features, ==, b->states_list[i].idx_ss_features);
+        g_assert_cmpint(a->states_list[i].available, ==, b->states_list[i].available);
+        g_assert_cmpint(a->states_list[i].requested, ==, b->states_list[i].requested);
+        g_assert_cmpint(a->states_list[i].active, ==, b->states_list[i].active);
+        g_assert_cmpint(a->states_list[i].never_changed, ==, b->states_list[i].never_changed);
+    }
+}
+
+static void
+test_ethtool_netlink(void)
+{
+    const int                       IFINDEX        = 1;
+    gs_free NMEthtoolFeatureStates *features1      = NULL;
+    gs_free NMEthtoolFeatureStates *features2      = NULL;
+    gs_free NMEthtoolFeatureStates *features_nl    = NULL;
+    gs_free NMEthtoolFeatureStates *features_ioctl = NULL;
+    NMPUtilsEthtoolNl *             enl;
+    NMEthtoolRingState              ring_nl        = {};
+    NMEthtoolRingState              ring_ioctl     = {};
+    NMEthtoolPauseState             pause_nl       = {};
+    NMEthtoolPauseState             pause_ioctl    = {};
+    NMEthtoolCoalesceState          coalesce_nl    = {};
+    NMEthtoolCoalesceState          coalesce_ioctl = {};
+    NMOptionBool                    requested[_NM_ETHTOOL_ID_FEATURE_NUM];
+    const NMEthtoolFeatureState *   toggle         = NULL;
+    gboolean                        success;
+    gboolean                        has_monitor;
+    guint64                         n_round_trips;
+    guint                           i;
+
+    /* the second call gets the feature names from the string set cache. */
+    features1 = nmp_utils_ethtool_get_features(NULL, IFINDEX);
+    features2 = nmp_utils_ethtool_get_features(NULL, IFINDEX);
+    _assert_ethtool_features_equal(features1, features2);
+
+    enl = nmp_utils_ethtool_nl_new();
+    if (!enl) {
+        g_test_skip("ethtool netlink family not supported by kernel");
+        return;
+    }
+
+    has_monitor = (nmp_utils_ethtool_nl_get_monitor_fd(enl) >= 0);
+
+    /* netlink and ioctl must agree, both in failure and in the result. */
+    success = nmp_utils_ethtool_get_ring(enl, IFINDEX, &ring_nl);
+    g_assert_cmpint(success, ==, nmp_utils_ethtool_get_ring(NULL, IFINDEX, &ring_ioctl));
+    if (success) {
+        g_assert_cmpint(ring_nl.rx_pending, ==, ring_ioctl.rx_pending);
+        g_assert_cmpint(ring_nl.rx_mini_pending, ==, ring_ioctl.rx_mini_pending);
+        g_assert_cmpint(ring_nl.rx_jumbo_pending, ==, ring_ioctl.rx_jumbo_pending);
+        g_assert_cmpint(ring_nl.tx_pending, ==, ring_ioctl.tx_pending);
+    }
+
+    success = nmp_utils_ethtool_get_pause(enl, IFINDEX, &pause_nl);
+    g_assert_cmpint(success, ==, nmp_utils_ethtool_get_pause(NULL, IFINDEX, &pause_ioctl));
+    if (success) {
+        g_assert_cmpint(pause_nl.autoneg, ==, pause_ioctl.autoneg);
+        g_assert_cmpint(pause_nl.rx, ==, pause_ioctl.rx);
+        g_assert_cmpint(pause_nl.tx, ==, pause_ioctl.tx);
+    }
+
+    success = nmp_utils_ethtool_get_coalesce(enl, IFINDEX, &coalesce_nl);
+    g_assert_cmpint(success, ==, nmp_utils_ethtool_get_coalesce(NULL, IFINDEX, &coalesce_ioctl));
+    if (success) {
+        for (i = 0; i < _NM_ETHTOOL_ID_COALESCE_NUM; i++)
+            g_assert_cmpint(coalesce_nl.s[i], ==, coalesce_ioctl.s[i]);
+    }
+
+    features_nl = nmp_utils_ethtool_get_features(enl, IFINDEX);
+    _assert_ethtool_features_equal(features_nl, features1);
+
+    /* with notifications, everything is cached now. */
+    n_round_trips = nmp_utils_ethtool_nl_get_n_round_trips(enl);
+    nmp_utils_ethtool_get_ring(enl, IFINDEX, &ring_nl);
+    nmp_utils_ethtool_get_pause(enl, IFINDEX, &pause_nl);
+    nmp_utils_ethtool_get_coalesce(enl, IFINDEX, &coalesce_nl);
+    nm_clear_g_free(&features_nl);
+    features_nl = nmp_utils_ethtool_get_features(enl, IFINDEX);
+    _assert_ethtool_features_equal(features_nl, features1);
+    if (has_monitor)
+        g_assert_cmpint(nmp_utils_ethtool_nl_get_n_round_trips(enl), ==, n_round_trips);
+
+    for (i = 0; i < features1->n_states; i++) {
+        const NMEthtoolFeatureState *s = &features1->states_list[i];
+
+        if (s->available && !s->never_changed && s->info->n_kernel_names == 1) {
+            toggle = s;
+            break;
+        }
+    }
+
+    if (has_monitor && toggle) {
+        /* change a feature behind the back of the cache. The notification updates it. */
+        for (i = 0; i < _NM_ETHTOOL_ID_FEATURE_NUM; i++)
+            requested[i] = NM_OPTION_BOOL_DEFAULT;
+        requested[_NM_ETHTOOL_ID_FEATURE_AS_IDX(toggle->info->ethtool_id)] =
+            toggle->active ? NM_OPTION_BOOL_FALSE : NM_OPTION_BOOL_TRUE;
+        nmp_utils_ethtool_set_features(NULL, IFINDEX, features1, requested, TRUE);
+
+        nmp_utils_ethtool_nl_process_monitor(enl);
+
+        n_round_trips  = nmp_utils_ethtool_nl_get_n_round_trips(enl);
+        features_ioctl = nmp_utils_ethtool_get_features(NULL, IFINDEX);
+        nm_clear_g_free(&features_nl);
+        features_nl = nmp_utils_ethtool_get_features(enl, IFINDEX);
+        _assert_ethtool_features_equal(features_nl, features_ioctl);
+        g_assert_cmpint(nmp_utils_ethtool_nl_get_n_round_trips(enl), ==, n_round_trips);
+
+        /* and restore it via netlink. */
+        g_assert(nmp_utils_ethtool_set_features(enl, IFINDEX, features1, requested, FALSE));
+        nm_clear_g_free(&features_ioctl);
+        features_ioctl = nmp_utils_ethtool_get_features(NULL, IFINDEX);
+        _assert_ethtool_features_equal(features_ioctl, features1);
     }
+
+    nmp_utils_ethtool_nl_free(enl);
 }
 
 /*****************************************************************************/
@@ -3802,6 +4084,13 @@ _nmtstp_setup_tests(void)
                              GUINT_TO_POINTER(1000),
                              test_create_many_links);
 
+        g_test_add_data_func("/link/wireguard/sync-peers/100",
+                             GUINT_TO_POINTER(100),
+                             test_wireguard_sync_peers);
+        g_test_add_data_func("/link/wireguard/sync-peers/20000",
+                             GUINT_TO_POINTER(20000),
+                             test_wireguard_sync_peers);
+
         g_test_add_func("/link/nl-bugs/veth", test_nl_bugs_veth);
         g_test_add_func("/link/nl-bugs/spurious-newlink", test_nl_bugs_spuroius_newlink);
         g_test_add_func("/link/nl-bugs/spurious-dellink", test_nl_bugs_spuroius_dellink);
@@ -3839,5 +4128,6 @@ _nmtstp_setup_tests(void)
         g_test_add_func("/general/sysctl/set-async-fail", test_sysctl_set_async_fail);
 
         g_test_add_func("/link/ethtool/features/get", test_ethtool_features_get);
+        g_test_add_func("/link/ethtool/netlink", test_ethtool_netlink);
     }
 }
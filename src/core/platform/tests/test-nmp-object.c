@@ -559,6 +559,106 @@ test_cache_qdisc(void)
 
 /*****************************************************************************/
 
+/* The bucket arrays of a GHashTable used as a set (g_hash_table_add()) after
+ * adding @n keys, which is how NMDedupMultiIndex kept its entries and objects
+ * before. GHashTable grows once it is 15/16 full, to the next power of two
+ * above 4/3 of the number of keys. Each bucket has a key pointer and a hash,
+ * and the values array is shared with the keys. */
+static gsize
+_ghashtable_set_size(guint n)
+{
+    guint n_buckets = 8;
+    guint i;
+
+    for (i = 1; i <= n; i++) {
+        if (n_buckets <= i + i / 16u)
+            n_buckets = 1u << NM_MAX(g_bit_storage(i * 4u / 3u), 3u);
+    }
+    return n_buckets * (sizeof(gpointer) + sizeof(guint));
+}
+
+static void
+test_cache_route_memory(void)
+{
+    const guint                     n_routes = nmtst_test_quick() ? 1000u : 100000u;
+    NMPCache *                      cache;
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = NULL;
+    NMDedupMultiIndexStats                             stats;
+    gsize                                              objs_size;
+    gsize                                              old_entries_size;
+    gsize                                              old_tables_size;
+    guint                                              i;
+
+    multi_idx = nm_dedup_multi_index_new();
+    cache     = nmp_cache_new(multi_idx, nmtst_get_rand_uint32() % 2);
+
+    for (i = 0; i < n_routes; i++) {
+        const NMPlatformIP4Route r = {
+            .ifindex   = 1 + (i % 16),
+            .rt_source = NM_IP_CONFIG_SOURCE_RTPROT_STATIC,
+            .network   = htonl((10u << 24) + (i << 8)),
+            .plen      = 24,
+            .metric    = 100,
+        };
+        nm_auto_nmpobj NMPObject *obj = nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r);
+
+        g_assert(nmp_cache_update_netlink_route(cache,
+                                                obj,
+                                                TRUE,
+                                                0,
+                                                NULL,
+                                                NULL,
+                                                NULL,
+                                                NULL)
+                 == NMP_CACHE_OPS_ADDED);
+    }
+
+    nm_dedup_multi_index_get_stats(multi_idx, &stats);
+    g_assert_cmpint(stats.n_objs, ==, n_routes);
+    g_assert_cmpint(stats.n_entries, >=, n_routes);
+    g_assert_cmpint(stats.entries_size, >=, stats.n_entries * sizeof(NMDedupMultiEntry));
+    g_assert_cmpint(stats.tables_size, >=, (stats.n_entries + stats.n_objs) * sizeof(gpointer));
+
+    objs_size = stats.n_objs
+                * (nmp_class_from_type(NMP_OBJECT_TYPE_IP4_ROUTE)->sizeof_data
+                   + G_STRUCT_OFFSET(NMPObject, object));
+
+    /* the "before" figures are what the same index cost with entries allocated
+     * one by one, and with GHashTable for the entries and the objects. */
+    old_entries_size = stats.n_entries * sizeof(NMDedupMultiEntry)
+                       + stats.n_head_entries * sizeof(NMDedupMultiHeadEntry);
+    old_tables_size  = _ghashtable_set_size(stats.n_entries + stats.n_head_entries)
+                      + _ghashtable_set_size(stats.n_objs);
+
+    if (!nmtst_test_quick()) {
+        g_print(">>> %u routes, %u entries (%.2f per route), %u head entries\n",
+                n_routes,
+                stats.n_entries,
+                ((double) stats.n_entries) / n_routes,
+                stats.n_head_entries);
+        g_print(">>> bytes per route: entries %.1f, tables %.1f, objects %.1f, total %.1f\n",
+                ((double) stats.entries_size) / n_routes,
+                ((double) stats.tables_size) / n_routes,
+                ((double) objs_size) / n_routes,
+                ((double) (stats.entries_size + stats.tables_size + objs_size)) / n_routes);
+        g_print(">>> bytes per route before: entries %.1f, tables %.1f, objects %.1f, "
+                "total %.1f\n",
+                ((double) old_entries_size) / n_routes,
+                ((double) old_tables_size) / n_routes,
+                ((double) objs_size) / n_routes,
+                ((double) (old_entries_size + old_tables_size + objs_size)) / n_routes);
+    }
+
+    nmp_cache_free(cache);
+
+    nm_dedup_multi_index_get_stats(multi_idx, &stats);
+    g_assert_cmpint(stats.n_objs, ==, 0);
+    g_assert_cmpint(stats.n_entries, ==, 0);
+    g_assert_cmpint(stats.n_head_entries, ==, 0);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -603,6 +703,7 @@ main(int argc, char **argv)
     g_test_add_func("/nmp-object/obj-base", test_obj_base);
     g_test_add_func("/nmp-object/cache_link", test_cache_link);
     g_test_add_func("/nmp-object/cache_qdisc", test_cache_qdisc);
+    g_test_add_func("/nmp-object/cache_route_memory", test_cache_route_memory);
 
     result = g_test_run();
 
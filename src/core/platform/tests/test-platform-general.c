@@ -31,7 +31,7 @@ test_init_linux_platform(void)
 {
     gs_unref_object NMPlatform *platform = NULL;
 
-    platform = nm_linux_platform_new(TRUE, NM_PLATFORM_NETNS_SUPPORT_DEFAULT);
+    platform = nm_linux_platform_new(TRUE, NM_PLATFORM_NETNS_SUPPORT_DEFAULT, FALSE);
 }
 
 /*****************************************************************************/
@@ -42,7 +42,7 @@ test_link_get_all(void)
     gs_unref_object NMPlatform *platform = NULL;
     gs_unref_ptrarray GPtrArray *links   = NULL;
 
-    platform = nm_linux_platform_new(TRUE, NM_PLATFORM_NETNS_SUPPORT_DEFAULT);
+    platform = nm_linux_platform_new(TRUE, NM_PLATFORM_NETNS_SUPPORT_DEFAULT, FALSE);
 
     links = nm_platform_link_get_all(platform, TRUE);
 }
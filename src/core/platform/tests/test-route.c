@@ -5,10 +5,12 @@
 
 #include "src/core/nm-default-daemon.h"
 
+#include <sys/wait.h>
 #include <linux/rtnetlink.h>
 #include <linux/fib_rules.h>
 
 #include "nm-core-utils.h"
+#include "libnm-platform/nm-linux-platform.h"
 #include "libnm-platform/nm-platform-utils.h"
 #include "libnm-platform/nmp-rules-manager.h"
 
@@ -1886,6 +1888,574 @@ again:
 
 /*****************************************************************************/
 
+static gint64
+_rules_manager_sync_timed(NMPRulesManager *rules_manager)
+{
+    gint64 start_time = nm_utils_get_monotonic_timestamp_nsec();
+
+    nmp_rules_manager_sync(rules_manager, FALSE);
+    return NM_MAX(nm_utils_get_monotonic_timestamp_nsec() - start_time, (gint64) 1);
+}
+
+static void
+test_rule_sync_many(gconstpointer user_data)
+{
+    const guint                                  n_rules       = GPOINTER_TO_UINT(user_data);
+    NMPlatform *                                 platform      = NM_PLATFORM_GET;
+    nm_auto_unref_rules_manager NMPRulesManager *rules_manager = NULL;
+    gconstpointer                                USER_TAG      = &platform;
+    NMPlatformRoutingRule                        rr;
+    NMPObject                                    obj_stack;
+    guint                                        n_initial;
+    gint64                                       t_add;
+    gint64                                       t_update;
+    gint64                                       t_noop;
+    gint64                                       t_remove;
+    guint                                        i;
+
+    if (n_rules > 1000 && nmtst_test_quick()) {
+        g_print("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n",
+                g_get_prgname() ?: "test-route-linux");
+        g_test_skip("Skip long running test");
+        return;
+    }
+
+    nm_platform_process_events(platform);
+    n_initial = nmtstp_platform_routing_rules_get_count(platform, AF_UNSPEC);
+
+    rules_manager = nmp_rules_manager_new(platform);
+
+#define _RR_MANY(idx)                           \
+    ((NMPlatformRoutingRule){                   \
+        .addr_family = AF_INET,                 \
+        .priority    = 1000u + (idx),           \
+        .action      = FR_ACT_TO_TBL,           \
+        .table       = 10000u + ((idx) % 100u), \
+        .protocol    = RTPROT_STATIC,           \
+    })
+
+    for (i = 0; i < n_rules; i++) {
+        rr = _RR_MANY(i);
+        nmp_rules_manager_track(rules_manager, &rr, 10, USER_TAG, NULL);
+    }
+
+    t_add = _rules_manager_sync_timed(rules_manager);
+    g_assert_cmpint(nmtstp_platform_routing_rules_get_count(platform, AF_UNSPEC),
+                    ==,
+                    n_initial + n_rules);
+
+    /* change a single rule. Only that one must be touched. */
+    rr = _RR_MANY(0);
+    nmp_rules_manager_untrack(rules_manager, &rr, USER_TAG);
+    rr = _RR_MANY(n_rules);
+    nmp_rules_manager_track(rules_manager, &rr, 10, USER_TAG, NULL);
+
+    t_update = _rules_manager_sync_timed(rules_manager);
+    g_assert_cmpint(nmtstp_platform_routing_rules_get_count(platform, AF_UNSPEC),
+                    ==,
+                    n_initial + n_rules);
+    rr = _RR_MANY(0);
+    g_assert(!_platform_has_routing_rule(
+        platform,
+        nmp_object_stackinit(&obj_stack, NMP_OBJECT_TYPE_ROUTING_RULE, &rr)));
+
+    t_noop = _rules_manager_sync_timed(rules_manager);
+    g_assert_cmpint(nmtstp_platform_routing_rules_get_count(platform, AF_UNSPEC),
+                    ==,
+                    n_initial + n_rules);
+
+    nmp_rules_manager_untrack_all(rules_manager, USER_TAG, TRUE);
+    t_remove = _rules_manager_sync_timed(rules_manager);
+    g_assert_cmpint(nmtstp_platform_routing_rules_get_count(platform, AF_UNSPEC), ==, n_initial);
+
+#undef _RR_MANY
+
+    _LOGI(">>> %u rules: add %" G_GINT64_FORMAT " usec, update %" G_GINT64_FORMAT
+          " usec, no-op %" G_GINT64_FORMAT " usec, remove %" G_GINT64_FORMAT " usec",
+          n_rules,
+          t_add / 1000,
+          t_update / 1000,
+          t_noop / 1000,
+          t_remove / 1000);
+}
+
+/*****************************************************************************/
+
+static void
+_route_event_flood_run_batch(const char *filename, const GString *batch)
+{
+    gs_free_error GError *error = NULL;
+
+    g_file_set_contents(filename, batch->str, batch->len, &error);
+    g_assert_no_error(error);
+    g_assert_cmpint(nmtstp_run_command("ip -batch %s", filename), ==, 0);
+}
+
+/* Reads the number of dropped messages of the NETLINK_ROUTE sockets in the
+ * namespace from /proc/net/netlink. The kernel counts a message as dropped when
+ * the receive buffer of the socket overflows. The sockets subscribed to link
+ * events are the main sockets of the platform, the sockets subscribed only to
+ * route events are the separate route event sockets. */
+static void
+_netlink_route_drops_get(guint64 *out_drops_main, guint64 *out_drops_route_events)
+{
+    gs_free_error GError *error    = NULL;
+    gs_free char *        contents = NULL;
+    gs_free const char ** lines    = NULL;
+    guint                 n_route_events_socks;
+    guint                 i;
+
+    *out_drops_main         = 0;
+    *out_drops_route_events = 0;
+    n_route_events_socks    = 0;
+
+    g_file_get_contents("/proc/net/netlink", &contents, NULL, &error);
+    g_assert_no_error(error);
+
+    lines = nm_strsplit_set(contents, "\n");
+    g_assert(lines && lines[0]);
+
+    /* skip the header line. The columns are:
+     *   sk Eth Pid Groups Rmem Wmem Dump Locks Drops Inode */
+    for (i = 1; lines[i]; i++) {
+        gs_free const char **cols = NULL;
+        guint32              groups;
+        guint64              drops;
+
+        cols = nm_strsplit_set(lines[i], " \t");
+        g_assert_cmpint(NM_PTRARRAY_LEN(cols), >=, 9);
+
+        if (_nm_utils_ascii_str_to_int64(cols[1], 10, 0, G_MAXINT, -1) != NETLINK_ROUTE)
+            continue;
+
+        groups = _nm_utils_ascii_str_to_int64(cols[3], 16, 0, G_MAXUINT32, 0);
+        drops  = _nm_utils_ascii_str_to_uint64(cols[8], 10, 0, G_MAXUINT64, 0);
+
+        if (groups & (1u << (RTNLGRP_LINK - 1)))
+            *out_drops_main += drops;
+        else if (groups & (1u << (RTNLGRP_IPV4_ROUTE - 1))) {
+            *out_drops_route_events += drops;
+            n_route_events_socks++;
+        }
+    }
+
+    g_assert_cmpint(n_route_events_socks, >, 0);
+}
+
+static void
+_route_event_flood(NMPlatform *platform, guint n_routes, NMTernary expect_overflow)
+{
+    const guint32                 metric   = 22987;
+    const int                     ifindex  = DEVICE_IFINDEX;
+    gs_free_error GError *        error    = NULL;
+    gs_free char *                filename = NULL;
+    nm_auto_free_gstring GString *batch    = NULL;
+    gs_unref_ptrarray GPtrArray * routes   = NULL;
+    guint64                       drops_main_before;
+    guint64                       drops_main_after;
+    guint64                       drops_route_events_before;
+    guint64                       drops_route_events_after;
+    gint64                        t_start;
+    gint64                        t_process;
+    guint                         n_found;
+    guint                         i;
+    int                           fd;
+
+    nm_platform_process_events(platform);
+
+    fd = g_file_open_tmp("nm-test-route-flood-XXXXXX", &filename, &error);
+    g_assert_no_error(error);
+    nm_close(fd);
+
+#define _ROUTE_FLOOD_NETWORK(idx) (htonl((10u << 24) | ((idx) << 8)))
+#define _ROUTE_FLOOD_CMD(cmd, idx)                                                \
+    g_string_append_printf(batch,                                                 \
+                           "route " cmd " %s/24 dev %s metric %u\n",              \
+                           _nm_utils_inet4_ntop(_ROUTE_FLOOD_NETWORK(idx), sbuf), \
+                           DEVICE_NAME,                                           \
+                           metric)
+
+    /* Add all routes and delete every other route again, without reading the
+     * events in between. With many routes, that overflows the socket that
+     * receives the route events. */
+    batch = g_string_new(NULL);
+    for (i = 0; i < n_routes; i++) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        _ROUTE_FLOOD_CMD("add", i);
+    }
+    for (i = 0; i < n_routes; i += 2) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        _ROUTE_FLOOD_CMD("del", i);
+    }
+    _netlink_route_drops_get(&drops_main_before, &drops_route_events_before);
+    _route_event_flood_run_batch(filename, batch);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    nm_platform_process_events(platform);
+    t_process = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+    _netlink_route_drops_get(&drops_main_after, &drops_route_events_after);
+
+    _LOGI(">>> %u routes: %" G_GUINT64_FORMAT " route events dropped",
+          n_routes,
+          drops_route_events_after - drops_route_events_before);
+
+    if (expect_overflow != NM_TERNARY_DEFAULT) {
+        /* the small batch fits into the receive buffer, the large one does not. */
+        g_assert_cmpint(drops_route_events_after > drops_route_events_before,
+                        ==,
+                        expect_overflow);
+    }
+
+    /* only the route event socket overflows. The main socket, that receives
+     * links and addresses, loses nothing, so links and addresses need no
+     * resync. */
+    g_assert_cmpint(drops_main_after, ==, drops_main_before);
+
+    /* the cache must agree with kernel, regardless whether we had to resync. */
+    routes  = nmtstp_ip4_route_get_all(platform, ifindex);
+    n_found = 0;
+    for (i = 0; i < routes->len; i++) {
+        if (NMP_OBJECT_CAST_IP4_ROUTE(routes->pdata[i])->metric == metric)
+            n_found++;
+    }
+    g_assert_cmpint(n_found, ==, n_routes / 2);
+    for (i = 0; i < n_routes; i++) {
+        const NMPlatformIP4Route *r;
+
+        r = nmtstp_ip4_route_get(platform, ifindex, _ROUTE_FLOOD_NETWORK(i), 24, metric, 0);
+        g_assert((i % 2 == 1) == !!r);
+    }
+
+    g_string_truncate(batch, 0);
+    for (i = 1; i < n_routes; i += 2) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        _ROUTE_FLOOD_CMD("del", i);
+    }
+    _route_event_flood_run_batch(filename, batch);
+
+#undef _ROUTE_FLOOD_CMD
+#undef _ROUTE_FLOOD_NETWORK
+
+    nm_platform_process_events(platform);
+    g_clear_pointer(&routes, g_ptr_array_unref);
+    routes = nmtstp_ip4_route_get_all(platform, ifindex);
+    for (i = 0; i < routes->len; i++)
+        g_assert_cmpint(NMP_OBJECT_CAST_IP4_ROUTE(routes->pdata[i])->metric, !=, metric);
+
+    unlink(filename);
+
+    _LOGI(">>> %u routes: processing %u route events took %" G_GINT64_FORMAT " usec",
+          n_routes,
+          n_routes + (n_routes + 1) / 2,
+          t_process / 1000);
+}
+
+static void
+test_ip4_route_event_flood(gconstpointer user_data)
+{
+    const guint n_routes = GPOINTER_TO_UINT(user_data);
+
+    if (n_routes > 1000 && nmtst_test_quick()) {
+        g_print("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n",
+                g_get_prgname() ?: "test-route-linux");
+        g_test_skip("Skip long running test");
+        return;
+    }
+
+    _route_event_flood(NM_PLATFORM_GET, n_routes, n_routes > 1000);
+}
+
+static void
+test_ip4_route_event_flood_reader_thread(void)
+{
+    gs_unref_object NMPlatform *platform = NULL;
+
+    /* a second platform instance that reads the route events on a separate
+     * thread. Its cache must be just as accurate. */
+    platform = nm_linux_platform_new(TRUE, FALSE, TRUE);
+
+    /* whether the reader thread keeps up with the kernel depends on the
+     * scheduling, so don't assert whether the socket overflowed. */
+    _route_event_flood(platform, nmtst_test_quick() ? 1000 : 50000, NM_TERNARY_DEFAULT);
+}
+
+static guint
+_count_ip4_routes_with_metric(NMPlatform *platform, int ifindex, guint32 metric)
+{
+    gs_unref_ptrarray GPtrArray *routes = NULL;
+    guint                        n      = 0;
+    guint                        i;
+
+    routes = nmtstp_ip4_route_get_all(platform, ifindex);
+    for (i = 0; i < routes->len; i++) {
+        if (NMP_OBJECT_CAST_IP4_ROUTE(routes->pdata[i])->metric == metric)
+            n++;
+    }
+    return n;
+}
+
+static void
+test_ip4_route_event_flood_reader_thread_progress(void)
+{
+    const guint32                 metric   = 22988;
+    const int                     ifindex  = DEVICE_IFINDEX;
+    const guint                   n_routes = nmtst_test_quick() ? 5000 : 100000;
+    gs_unref_object NMPlatform *  platform = NULL;
+    gs_free_error GError *        error    = NULL;
+    gs_free char *                filename = NULL;
+    nm_auto_free_gstring GString *batch    = NULL;
+    const char *                  argv[]   = {"ip", "-batch", NULL, NULL};
+    GPid                          pid;
+    guint                         n_calls      = 0;
+    guint                         n_cached     = 0;
+    guint                         n_cached_max = 0;
+    gint64                        t_start;
+    gint64                        t_max = 0;
+    guint                         i;
+    int                           status;
+    int                           fd;
+
+    platform = nm_linux_platform_new(TRUE, FALSE, TRUE);
+    nm_platform_process_events(platform);
+
+    fd = g_file_open_tmp("nm-test-route-flood-XXXXXX", &filename, &error);
+    g_assert_no_error(error);
+    nm_close(fd);
+
+    batch = g_string_new(NULL);
+    for (i = 0; i < n_routes; i++) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        g_string_append_printf(batch,
+                               "route add %s/24 dev %s metric %u\n",
+                               _nm_utils_inet4_ntop(htonl((10u << 24) | (i << 8)), sbuf),
+                               DEVICE_NAME,
+                               metric);
+    }
+    g_file_set_contents(filename, batch->str, batch->len, &error);
+    g_assert_no_error(error);
+
+    /* While ip keeps adding routes, the reader thread does not see the socket
+     * empty. Still, processing the events must return after a bounded batch,
+     * with the routes that were added so far in the cache. */
+    argv[2] = filename;
+    g_spawn_async(NULL,
+                  (char **) argv,
+                  NULL,
+                  G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
+                  NULL,
+                  NULL,
+                  &pid,
+                  &error);
+    g_assert_no_error(error);
+
+    for (;;) {
+        t_start = nm_utils_get_monotonic_timestamp_nsec();
+        nm_platform_process_events(platform);
+        t_max = NM_MAX(t_max, nm_utils_get_monotonic_timestamp_nsec() - t_start);
+
+        if (waitpid(pid, &status, WNOHANG) == pid)
+            break;
+
+        n_calls++;
+        n_cached = _count_ip4_routes_with_metric(platform, ifindex, metric);
+        g_assert_cmpint(n_cached, >=, n_cached_max);
+        n_cached_max = n_cached;
+    }
+    g_assert(WIFEXITED(status));
+    g_assert_cmpint(WEXITSTATUS(status), ==, 0);
+
+    _LOGI(">>> %u routes: %u calls in flood, %u cached, longest %" G_GINT64_FORMAT " usec",
+          n_routes,
+          n_calls,
+          n_cached_max,
+          t_max / 1000);
+
+    if (!nmtst_test_quick()) {
+        /* with many routes, ip runs long enough that the main thread must
+         * have caught up with a part of them before the flood was over. */
+        g_assert_cmpint(n_calls, >, 1);
+        g_assert_cmpint(n_cached_max, >, 0);
+        g_assert_cmpint(n_cached_max, <, n_routes);
+    }
+
+    nm_platform_process_events(platform);
+    g_assert_cmpint(_count_ip4_routes_with_metric(platform, ifindex, metric), ==, n_routes);
+
+    g_string_truncate(batch, 0);
+    for (i = 0; i < n_routes; i++) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        g_string_append_printf(batch,
+                               "route del %s/24 dev %s metric %u\n",
+                               _nm_utils_inet4_ntop(htonl((10u << 24) | (i << 8)), sbuf),
+                               DEVICE_NAME,
+                               metric);
+    }
+    _route_event_flood_run_batch(filename, batch);
+    nm_platform_process_events(platform);
+    g_assert_cmpint(_count_ip4_routes_with_metric(platform, ifindex, metric), ==, 0);
+
+    unlink(filename);
+}
+
+/*****************************************************************************/
+
+static guint
+_count_ip4_routes_in_table(NMPlatform *platform, int ifindex, guint32 table)
+{
+    NMDedupMultiIter iter;
+    NMPLookup        lookup;
+    const NMPObject *o;
+    guint            n = 0;
+
+    nmp_cache_iter_for_each (
+        &iter,
+        nm_platform_lookup(platform,
+                           nmp_lookup_init_object(&lookup, NMP_OBJECT_TYPE_IP4_ROUTE, ifindex)),
+        &o) {
+        if (nm_platform_route_table_uncoerce(NMP_OBJECT_CAST_IP4_ROUTE(o)->table_coerced, TRUE)
+            == table)
+            n++;
+    }
+    return n;
+}
+
+static void
+test_ip4_route_ignored_tables(gconstpointer user_data)
+{
+    const guint                   n_routes  = GPOINTER_TO_UINT(user_data);
+    const guint32                 table     = 10010;
+    const int                     ifindex   = DEVICE_IFINDEX;
+    gs_free_error GError *        error     = NULL;
+    gs_free char *                filename  = NULL;
+    nm_auto_free_gstring GString *batch_add = NULL;
+    nm_auto_free_gstring GString *batch_del = NULL;
+    gint64                        t_dump[2];
+    gint64                        t_events[2];
+    guint                         n_cached[2];
+    guint                         i;
+    int                           fd;
+    int                           ignore;
+
+    if (n_routes > 1000 && nmtst_test_quick()) {
+        g_print("Skipping test: don't run long running test %s (NMTST_DEBUG=slow)\n",
+                g_get_prgname() ?: "test-route-linux");
+        g_test_skip("Skip long running test");
+        return;
+    }
+
+    fd = g_file_open_tmp("nm-test-route-tables-XXXXXX", &filename, &error);
+    g_assert_no_error(error);
+    nm_close(fd);
+
+    batch_add = g_string_new(NULL);
+    batch_del = g_string_new(NULL);
+    for (i = 0; i < n_routes; i++) {
+        char sbuf[NM_UTILS_INET_ADDRSTRLEN];
+
+        _nm_utils_inet4_ntop(htonl((10u << 24) | (i << 8)), sbuf);
+        g_string_append_printf(batch_add,
+                               "route add %s/24 dev %s table %u\n",
+                               sbuf,
+                               DEVICE_NAME,
+                               table);
+        g_string_append_printf(batch_del,
+                               "route del %s/24 dev %s table %u\n",
+                               sbuf,
+                               DEVICE_NAME,
+                               table);
+    }
+
+    /* Compare a platform instance that caches the routes of @table with
+     * one that ignores the table. Measure the initial dump, and the
+     * processing of the notifications when deleting all routes. */
+    for (ignore = 0; ignore < 2; ignore++) {
+        gs_unref_object NMPlatform *platform = NULL;
+        gint64                      t_start;
+
+        _route_event_flood_run_batch(filename, batch_add);
+
+        t_start  = nm_utils_get_monotonic_timestamp_nsec();
+        platform = nm_linux_platform_new_full(TRUE, FALSE, FALSE, ignore ? &table : NULL, ignore);
+
+        t_dump[ignore] = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+        n_cached[ignore] = _count_ip4_routes_in_table(platform, ifindex, table);
+        g_assert_cmpint(n_cached[ignore], ==, ignore ? 0 : n_routes);
+
+        _route_event_flood_run_batch(filename, batch_del);
+
+        t_start = nm_utils_get_monotonic_timestamp_nsec();
+        nm_platform_process_events(platform);
+        t_events[ignore] = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+        g_assert_cmpint(_count_ip4_routes_in_table(platform, ifindex, table), ==, 0);
+    }
+
+    unlink(filename);
+
+    _LOGI(">>> %u routes in table %u: dump %" G_GINT64_FORMAT " usec -> %" G_GINT64_FORMAT
+          " usec, events %" G_GINT64_FORMAT " usec -> %" G_GINT64_FORMAT
+          " usec, cached objects %u (~%zu KiB) -> %u",
+          n_routes,
+          table,
+          t_dump[0] / 1000,
+          t_dump[1] / 1000,
+          t_events[0] / 1000,
+          t_events[1] / 1000,
+          n_cached[0],
+          (n_cached[0] * sizeof(NMPObject)) / 1024,
+          n_cached[1]);
+}
+
+static void
+test_ip4_route_ignored_tables_route_get(void)
+{
+    const guint32               table    = 10011;
+    const int                   ifindex  = DEVICE_IFINDEX;
+    gs_unref_object NMPlatform *platform = NULL;
+    nm_auto_nmpobj NMPObject *route      = NULL;
+    const NMPlatformIP4Route *r;
+    NMPlatformIP4Route        r_add;
+    in_addr_t                 a;
+
+    platform = nm_linux_platform_new_full(TRUE, FALSE, FALSE, &table, 1);
+
+    nmtstp_run_command_check("ip route add 1.2.4.0/24 dev %s table %u", DEVICE_NAME, table);
+    nmtstp_run_command_check("ip rule add to 1.2.4.0/24 table %u priority 10011", table);
+
+    /* The route is not cached, but the response to RTM_GETROUTE must
+     * still be parsed. */
+    a = nmtst_inet4_from_string("1.2.4.1");
+    g_assert(NMTST_NM_ERR_SUCCESS(nm_platform_ip_route_get(platform, AF_INET, &a, 0, &route)));
+    r = NMP_OBJECT_CAST_IP4_ROUTE(route);
+    g_assert_cmpint(r->ifindex, ==, ifindex);
+    g_assert_cmpint(r->network, ==, a);
+    g_assert_cmpint(nm_platform_route_table_uncoerce(r->table_coerced, TRUE), ==, table);
+    g_assert_cmpint(_count_ip4_routes_in_table(platform, ifindex, table), ==, 0);
+
+    /* Routes for an ignored table are refused. */
+    r_add = (NMPlatformIP4Route){
+        .ifindex       = ifindex,
+        .network       = nmtst_inet4_from_string("1.2.5.0"),
+        .plen          = 24,
+        .table_coerced = nm_platform_route_table_coerce(table),
+        .rt_source     = NM_IP_CONFIG_SOURCE_USER,
+    };
+    g_assert_cmpint(nm_platform_ip4_route_add(platform, NMP_NLM_FLAG_REPLACE, &r_add),
+                    ==,
+                    -NME_PL_OPNOTSUPP);
+
+    nmtstp_run_command_check("ip rule del to 1.2.4.0/24 table %u priority 10011", table);
+    nmtstp_run_command_check("ip route flush table %u", table);
+}
+
+/*****************************************************************************/
+
 NMTstpSetupFunc const _nmtstp_setup_platform_func = SETUP;
 
 void
@@ -1915,6 +2485,24 @@ _nmtstp_setup_tests(void)
         add_test_func("/route/ip4_route_get", test_ip4_route_get);
         add_test_func("/route/ip6_route_get", test_ip6_route_get);
         add_test_func("/route/ip4_zero_gateway", test_ip4_zero_gateway);
+        add_test_func_data("/route/ip4_event_flood/100",
+                           test_ip4_route_event_flood,
+                           GUINT_TO_POINTER(100));
+        add_test_func_data("/route/ip4_event_flood/50000",
+                           test_ip4_route_event_flood,
+                           GUINT_TO_POINTER(50000));
+        add_test_func("/route/ip4_event_flood/reader-thread",
+                      test_ip4_route_event_flood_reader_thread);
+        add_test_func("/route/ip4_event_flood/reader-thread-progress",
+                      test_ip4_route_event_flood_reader_thread_progress);
+        add_test_func_data("/route/ip4_ignored_tables/1000",
+                           test_ip4_route_ignored_tables,
+                           GUINT_TO_POINTER(1000));
+        add_test_func_data("/route/ip4_ignored_tables/50000",
+                           test_ip4_route_ignored_tables,
+                           GUINT_TO_POINTER(50000));
+        add_test_func("/route/ip4_ignored_tables/route-get",
+                      test_ip4_route_ignored_tables_route_get);
     }
 
     if (nmtstp_is_root_test()) {
@@ -1922,5 +2510,11 @@ _nmtstp_setup_tests(void)
         add_test_func_data("/route/rule/2", test_rule, GINT_TO_POINTER(2));
         add_test_func_data("/route/rule/3", test_rule, GINT_TO_POINTER(3));
         add_test_func_data("/route/rule/4", test_rule, GINT_TO_POINTER(4));
+        add_test_func_data("/route/rule/sync-many/100",
+                           test_rule_sync_many,
+                           GUINT_TO_POINTER(100));
+        add_test_func_data("/route/rule/sync-many/50000",
+                           test_rule_sync_many,
+                           GUINT_TO_POINTER(50000));
     }
 }
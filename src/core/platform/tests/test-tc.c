@@ -36,6 +36,35 @@ qdiscs_lookup(int ifindex)
                                     NULL);
 }
 
+static NMPObject *
+tclass_new(int ifindex, guint32 handle, guint32 parent, guint64 rate)
+{
+    NMPObject *obj;
+
+    obj         = nmp_object_new(NMP_OBJECT_TYPE_TCLASS, NULL);
+    obj->tclass = (NMPlatformTclass){
+        .ifindex  = ifindex,
+        .kind     = "htb",
+        .handle   = handle,
+        .parent   = parent,
+        .htb.rate = rate,
+    };
+
+    return obj;
+}
+
+static GPtrArray *
+tclasses_lookup(int ifindex)
+{
+    NMPLookup lookup;
+
+    return nm_platform_lookup_clone(
+        NM_PLATFORM_GET,
+        nmp_lookup_init_object(&lookup, NMP_OBJECT_TYPE_TCLASS, ifindex),
+        NULL,
+        NULL);
+}
+
 static void
 test_qdisc1(void)
 {
@@ -200,6 +229,103 @@ test_qdisc_tbf(void)
     g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8005 << 16, 0));
 }
 
+static void
+test_tclass_htb(void)
+{
+#define HANDLE(minor) TC_H_MAKE(0x1 << 16, (minor))
+    int               ifindex;
+    gs_unref_ptrarray GPtrArray *qdiscs   = NULL;
+    gs_unref_ptrarray GPtrArray *tclasses = NULL;
+    gs_unref_ptrarray GPtrArray *plat     = NULL;
+    NMPObject *                  obj;
+    const NMPlatformTclass *     tclass;
+    NMPlatformStatistics         stats_before;
+    NMPlatformStatistics         stats_after;
+    guint                        i;
+
+    ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    g_assert_cmpint(ifindex, >, 0);
+
+    nmtstp_run_command("tc qdisc del dev %s root", DEVICE_NAME);
+
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 0);
+
+    qdiscs                      = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    obj                         = qdisc_new(ifindex, "htb", TC_H_ROOT);
+    obj->qdisc.handle           = HANDLE(0);
+    obj->qdisc.htb.rate2quantum = 10;
+    obj->qdisc.htb.defcls       = 0x20;
+    g_ptr_array_add(qdiscs, obj);
+
+    tclasses = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    g_ptr_array_add(tclasses, tclass_new(ifindex, HANDLE(0x1), HANDLE(0), 1250000));
+    g_ptr_array_add(tclasses, tclass_new(ifindex, HANDLE(0x10), HANDLE(0x1), 125000));
+    g_ptr_array_add(tclasses, tclass_new(ifindex, HANDLE(0x20), HANDLE(0x1), 62500));
+
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, qdiscs, tclasses, NULL));
+    plat = tclasses_lookup(ifindex);
+    g_assert(plat);
+    g_assert_cmpint(plat->len, ==, 3);
+
+    /* The second sync finds everything in place. It must neither send a request
+     * (which kernel would acknowledge) nor dump anything. */
+    nm_platform_get_statistics(NM_PLATFORM_GET, &stats_before);
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, qdiscs, tclasses, NULL));
+    nm_platform_get_statistics(NM_PLATFORM_GET, &stats_after);
+    g_assert_cmpint(stats_after.netlink.nl_msgs[NLMSG_ERROR],
+                    ==,
+                    stats_before.netlink.nl_msgs[NLMSG_ERROR]);
+    g_assert_cmpint(stats_after.netlink.nl_msgs[NLMSG_DONE],
+                    ==,
+                    stats_before.netlink.nl_msgs[NLMSG_DONE]);
+    for (i = 0; i < _NM_PLATFORM_DUMP_REASON_NUM; i++)
+        g_assert_cmpint(stats_after.netlink.dumps[i], ==, stats_before.netlink.dumps[i]);
+
+    nm_clear_pointer(&plat, g_ptr_array_unref);
+    plat = tclasses_lookup(ifindex);
+    g_assert(plat);
+    g_assert_cmpint(plat->len, ==, 3);
+
+    for (i = 0; i < plat->len; i++) {
+        tclass = NMP_OBJECT_CAST_TCLASS(plat->pdata[i]);
+        g_assert_cmpstr(tclass->kind, ==, "htb");
+        g_assert_cmpint(TC_H_MAJ(tclass->handle), ==, HANDLE(0));
+        if (tclass->handle == HANDLE(0x10)) {
+            g_assert_cmpint(tclass->parent, ==, HANDLE(0x1));
+            g_assert_cmpint(tclass->htb.rate, ==, 125000);
+            g_assert_cmpint(tclass->htb.ceil, ==, 125000);
+        }
+    }
+
+    /* Dropping a class removes it, but leaves its siblings alone. */
+    g_ptr_array_remove_index(tclasses, 2);
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, qdiscs, tclasses, NULL));
+    nm_clear_pointer(&plat, g_ptr_array_unref);
+    plat = tclasses_lookup(ifindex);
+    g_assert(plat);
+    g_assert_cmpint(plat->len, ==, 2);
+
+    /* Removing a qdisc makes the platform dump the classes of all devices
+     * again. The classes that still exist must survive that. */
+    nm_platform_get_statistics(NM_PLATFORM_GET, &stats_before);
+    nmtstp_run_command("tc qdisc add dev %s ingress", DEVICE_NAME);
+    nmtstp_run_command("tc qdisc del dev %s ingress", DEVICE_NAME);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 0);
+    nm_platform_process_events(NM_PLATFORM_GET);
+    nm_platform_get_statistics(NM_PLATFORM_GET, &stats_after);
+    g_assert_cmpint(stats_after.netlink.dumps_completed, >, stats_before.netlink.dumps_completed);
+    nm_clear_pointer(&plat, g_ptr_array_unref);
+    plat = tclasses_lookup(ifindex);
+    g_assert(plat);
+    g_assert_cmpint(plat->len, ==, 2);
+
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, NULL, NULL, NULL));
+    nm_clear_pointer(&plat, g_ptr_array_unref);
+    plat = tclasses_lookup(ifindex);
+    g_assert(!plat || plat->len == 0);
+#undef HANDLE
+}
+
 /*****************************************************************************/
 
 NMTstpSetupFunc const _nmtstp_setup_platform_func = SETUP;
@@ -218,5 +344,6 @@ _nmtstp_setup_tests(void)
         nmtstp_env1_add_test_func("/link/qdisc/fq_codel", test_qdisc_fq_codel, TRUE);
         nmtstp_env1_add_test_func("/link/qdisc/sfq", test_qdisc_sfq, TRUE);
         nmtstp_env1_add_test_func("/link/qdisc/tbf", test_qdisc_tbf, TRUE);
+        nmtstp_env1_add_test_func("/link/tclass/htb", test_tclass_htb, TRUE);
     }
 }
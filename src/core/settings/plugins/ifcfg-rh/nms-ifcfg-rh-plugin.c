@@ -175,11 +175,17 @@ nm_assert_self(NMSIfcfgRHPlugin *self, gboolean unhandled_specs_consistent)
 /*****************************************************************************/
 
 static NMSIfcfgRHStorage *
-_load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
+_load_file(NMSIfcfgRHPlugin *         self,
+           const char *               filename,
+           NMSIfcfgRHReadCache *      read_cache,
+           const NMSIfcfgRHFilesStat *files_stat,
+           GError **                  error)
 {
     gs_unref_object NMConnection *connection = NULL;
     gs_free_error GError *load_error         = NULL;
     gs_free char *        unhandled_spec     = NULL;
+    NMSIfcfgRHStorage *   storage;
+    NMSIfcfgRHFilesStat   files_stat_stack;
     gboolean              load_error_ignore;
     struct stat           st;
 
@@ -193,7 +199,18 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
         return NULL;
     }
 
-    connection = connection_from_file(filename, &unhandled_spec, &load_error, &load_error_ignore);
+    /* Unless the caller already did, remember the stat data from before
+     * reading the files. A modification during reading then causes the
+     * next reload to read the files again. */
+    if (!files_stat
+        && nms_ifcfg_rh_reader_get_files_stat(read_cache, filename, &files_stat_stack))
+        files_stat = &files_stat_stack;
+
+    connection = connection_from_file(filename,
+                                      read_cache,
+                                      &unhandled_spec,
+                                      &load_error,
+                                      &load_error_ignore);
     if (load_error) {
         if (error) {
             nm_utils_error_set(error,
@@ -224,25 +241,31 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
             nm_assert_not_reached();
             return NULL;
         }
-        return nms_ifcfg_rh_storage_new_unhandled(self,
-                                                  filename,
-                                                  unmanaged_spec,
-                                                  unrecognized_spec);
+        storage = nms_ifcfg_rh_storage_new_unhandled(self,
+                                                     filename,
+                                                     unmanaged_spec,
+                                                     unrecognized_spec);
+    } else {
+        storage = nms_ifcfg_rh_storage_new_connection(self,
+                                                      filename,
+                                                      g_steal_pointer(&connection),
+                                                      &st.st_mtim);
     }
 
-    return nms_ifcfg_rh_storage_new_connection(self,
-                                               filename,
-                                               g_steal_pointer(&connection),
-                                               &st.st_mtim);
+    nms_ifcfg_rh_storage_set_files_stat(storage, files_stat);
+    return storage;
 }
 
 static void
 _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 {
-    gs_unref_hashtable GHashTable *dupl_filenames = NULL;
-    gs_free_error GError *local                   = NULL;
+    NMSIfcfgRHPluginPrivate *priv = NMS_IFCFG_RH_PLUGIN_GET_PRIVATE(self);
+    nm_auto_free_ifcfg_rh_read_cache NMSIfcfgRHReadCache *read_cache = NULL;
+    gs_unref_hashtable GHashTable *dupl_filenames                    = NULL;
+    gs_free_error GError *local                                      = NULL;
     const char *          f_filename;
     GDir *                dir;
+    guint                 n_unchanged = 0;
 
     dir = g_dir_open(IFCFG_DIR, 0, &local);
     if (!dir) {
@@ -252,10 +275,15 @@ _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
 
+    read_cache = nms_ifcfg_rh_read_cache_new();
+
     while ((f_filename = g_dir_read_name(dir))) {
-        gs_free char *     full_path = NULL;
-        NMSIfcfgRHStorage *storage;
-        char *             full_filename;
+        gs_free char *      full_path = NULL;
+        NMSIfcfgRHStorage * storage;
+        NMSIfcfgRHStorage * storage_old;
+        NMSIfcfgRHFilesStat files_stat;
+        gboolean            has_files_stat;
+        char *              full_filename;
 
         full_path     = g_build_filename(IFCFG_DIR, f_filename, NULL);
         full_filename = utils_detect_ifcfg_path(full_path, TRUE);
@@ -267,11 +295,29 @@ _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 
         nm_assert(!nm_sett_util_storages_lookup_by_filename(storages, full_filename));
 
-        storage = _load_file(self, full_filename, NULL);
+        has_files_stat =
+            nms_ifcfg_rh_reader_get_files_stat(read_cache, full_filename, &files_stat);
+
+        storage_old = nm_sett_util_storages_lookup_by_filename(&priv->storages, full_filename);
+        if (has_files_stat && storage_old && storage_old->files_stat_valid
+            && memcmp(&storage_old->files_stat, &files_stat, sizeof(files_stat)) == 0) {
+            /* None of the files changed since we read them last time. Skip them. */
+            storage = nms_ifcfg_rh_storage_new_unchanged(self, storage_old);
+            n_unchanged++;
+        } else {
+            storage = _load_file(self,
+                                 full_filename,
+                                 read_cache,
+                                 has_files_stat ? &files_stat : NULL,
+                                 NULL);
+        }
         if (storage)
             nm_sett_util_storages_add_take(storages, storage);
     }
     g_dir_close(dir);
+
+    if (n_unchanged > 0)
+        _LOGT("load: skipped %u unchanged files", n_unchanged);
 }
 
 static void
@@ -325,6 +371,7 @@ _storages_consolidate(NMSIfcfgRHPlugin *                     self,
                 else
                     nms_ifcfg_rh_storage_destroy(storage_old);
             }
+            nm_assert(!storage_new->unchanged);
             storage_new->dirty = FALSE;
             nm_sett_util_storages_add_take(&priv->storages, storage_new);
             g_ptr_array_add(storages_modified, g_object_ref(storage_new));
@@ -332,6 +379,23 @@ _storages_consolidate(NMSIfcfgRHPlugin *                     self,
         }
 
         storage_old->dirty = FALSE;
+        if (storage_new->unchanged) {
+            /* the files were not read again. Keep the old storage and
+             * don't emit an event for it. */
+            nms_ifcfg_rh_storage_destroy(storage_new);
+            continue;
+        }
+        if (replace_all && storage_old->files_connection && storage_new->files_connection
+            && nm_connection_compare(storage_old->files_connection,
+                                     storage_new->files_connection,
+                                     NM_SETTING_COMPARE_FLAG_EXACT)) {
+            /* the files were touched, but the profile read from them is the same.
+             * Only remember the new stat data, and don't emit an event. */
+            nms_ifcfg_rh_storage_copy_content(storage_old, storage_new);
+            g_clear_object(&storage_old->connection);
+            nms_ifcfg_rh_storage_destroy(storage_new);
+            continue;
+        }
         nms_ifcfg_rh_storage_copy_content(storage_old, storage_new);
         nms_ifcfg_rh_storage_destroy(storage_new);
         g_ptr_array_add(storages_modified, g_object_ref(storage_old));
@@ -412,16 +476,19 @@ load_connections(NMSettingsPlugin *                     plugin,
     NMSIfcfgRHPluginPrivate *priv = NMS_IFCFG_RH_PLUGIN_GET_PRIVATE(self);
     nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_ifcfg_rh_storage_destroy);
-    gs_unref_hashtable GHashTable *dupl_filenames    = NULL;
-    gs_unref_hashtable GHashTable *storages_replaced = NULL;
-    gs_unref_hashtable GHashTable *loaded_uuids      = NULL;
-    const char *                   loaded_uuid;
-    GHashTableIter                 h_iter;
-    gsize                          i;
+    nm_auto_free_ifcfg_rh_read_cache NMSIfcfgRHReadCache *read_cache        = NULL;
+    gs_unref_hashtable GHashTable *                       dupl_filenames    = NULL;
+    gs_unref_hashtable GHashTable *                       storages_replaced = NULL;
+    gs_unref_hashtable GHashTable *                       loaded_uuids      = NULL;
+    const char *                                          loaded_uuid;
+    GHashTableIter                                        h_iter;
+    gsize                                                 i;
 
     if (n_entries == 0)
         return;
 
+    read_cache = nms_ifcfg_rh_read_cache_new();
+
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
 
     loaded_uuids = g_hash_table_new(nm_str_hash, g_str_equal);
@@ -473,7 +540,7 @@ load_connections(NMSettingsPlugin *                     plugin,
         if (!g_hash_table_insert(dupl_filenames, g_steal_pointer(&full_filename_keep), entry))
             nm_assert_not_reached();
 
-        storage = _load_file(self, full_filename, &local);
+        storage = _load_file(self, full_filename, read_cache, NULL, &local);
         if (!storage) {
             if (nm_utils_file_stat(full_filename, NULL) == -ENOENT) {
                 NMSIfcfgRHStorage *storage2;
@@ -522,7 +589,7 @@ load_connections(NMSettingsPlugin *                     plugin,
              * Reload that file too despite not being told to do so. The reason is to get
              * the latest file timestamp so that we get the priorities right. */
 
-            storage_new = _load_file(self, full_filename, &local);
+            storage_new = _load_file(self, full_filename, read_cache, NULL, &local);
             if (storage_new
                 && !nm_streq0(loaded_uuid, nms_ifcfg_rh_storage_get_uuid_opt(storage_new))) {
                 /* the file now references a different UUID. We are not told to reload
@@ -707,6 +774,10 @@ update_connection(NMSettingsPlugin *  plugin,
 
     storage->stat_mtime = *nm_sett_util_stat_mtime(full_filename, FALSE, &mtime);
 
+    /* the profile that was read last from the files is outdated. Read the
+     * files again on the next reload and emit the result. */
+    nms_ifcfg_rh_storage_set_files_stat(storage, NULL);
+
     *out_storage    = NM_SETTINGS_STORAGE(g_object_ref(storage));
     *out_connection = g_steal_pointer(&reread);
 
@@ -9,6 +9,7 @@
 
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <sys/wait.h>
@@ -2095,14 +2096,207 @@ make_ip4_setting(shvarFile *ifcfg,
     return NM_SETTING(g_steal_pointer(&s_ip4));
 }
 
+/*****************************************************************************/
+
+#define NETWORK_FILE SYSCONFDIR "/sysconfig/network"
+
+struct _NMSIfcfgRHReadCache {
+    /* dirname -> GHashTable (ifcfg basename -> GPtrArray of alias file basenames). */
+    GHashTable *aliases_by_dir;
+
+    shvarFile *        network_ifcfg;
+    NMSIfcfgRHFileStat network_stat;
+
+    bool network_ifcfg_loaded : 1;
+    bool network_stat_loaded : 1;
+};
+
+NMSIfcfgRHReadCache *
+nms_ifcfg_rh_read_cache_new(void)
+{
+    NMSIfcfgRHReadCache *cache;
+
+    cache  = g_slice_new(NMSIfcfgRHReadCache);
+    *cache = (NMSIfcfgRHReadCache){
+        .aliases_by_dir = g_hash_table_new_full(nm_str_hash,
+                                                g_str_equal,
+                                                g_free,
+                                                (GDestroyNotify) g_hash_table_unref),
+    };
+    return cache;
+}
+
+void
+nms_ifcfg_rh_read_cache_free(NMSIfcfgRHReadCache *cache)
+{
+    if (!cache)
+        return;
+
+    g_hash_table_unref(cache->aliases_by_dir);
+    if (cache->network_ifcfg)
+        svCloseFile(cache->network_ifcfg);
+    g_slice_free(NMSIfcfgRHReadCache, cache);
+}
+
+static shvarFile *
+_read_cache_get_network_ifcfg(NMSIfcfgRHReadCache *cache)
+{
+    if (!cache->network_ifcfg_loaded) {
+        cache->network_ifcfg_loaded = TRUE;
+        cache->network_ifcfg        = svOpenFile(NETWORK_FILE, NULL);
+    }
+    return cache->network_ifcfg;
+}
+
+static GHashTable *
+_aliases_read_dir(const char *dirname, GError **error)
+{
+    GHashTable *aliases;
+    const char *item;
+    GDir *      dir;
+
+    dir = g_dir_open(dirname, 0, error);
+    if (!dir)
+        return NULL;
+
+    aliases = g_hash_table_new_full(nm_str_hash,
+                                    g_str_equal,
+                                    g_free,
+                                    (GDestroyNotify) g_ptr_array_unref);
+
+    while ((item = g_dir_read_name(dir))) {
+        const char *p;
+
+        if (!utils_is_ifcfg_alias_file(item, NULL))
+            continue;
+
+        /* The alias "ifcfg-a:b" belongs to "ifcfg-a". Index the file by every
+         * possible prefix, to match utils_is_ifcfg_alias_file(item, base). */
+        for (p = strchr(item, ':'); p; p = strchr(&p[1], ':')) {
+            gs_free char *base = g_strndup(item, p - item);
+            GPtrArray *   items;
+
+            items = g_hash_table_lookup(aliases, base);
+            if (!items) {
+                items = g_ptr_array_new_with_free_func(g_free);
+                g_hash_table_insert(aliases, g_steal_pointer(&base), items);
+            }
+            g_ptr_array_add(items, g_strdup(item));
+        }
+    }
+
+    g_dir_close(dir);
+    return aliases;
+}
+
+static GHashTable *
+_read_cache_get_aliases(NMSIfcfgRHReadCache *cache, const char *dirname, GError **error)
+{
+    GHashTable *aliases;
+
+    aliases = g_hash_table_lookup(cache->aliases_by_dir, dirname);
+    if (!aliases) {
+        aliases = _aliases_read_dir(dirname, error);
+        if (!aliases)
+            return NULL;
+        g_hash_table_insert(cache->aliases_by_dir, g_strdup(dirname), aliases);
+    }
+    return aliases;
+}
+
 static void
-read_aliases(NMSettingIPConfig *s_ip4, gboolean read_defroute, const char *filename)
+_file_stat(const char *filename, NMSIfcfgRHFileStat *out_stat)
+{
+    struct stat st;
+
+    /* clear also the padding, so that the result can be compared with memcmp(). */
+    memset(out_stat, 0, sizeof(*out_stat));
+
+    if (!filename || stat(filename, &st) != 0)
+        return;
+
+    out_stat->st_dev  = st.st_dev;
+    out_stat->st_ino  = st.st_ino;
+    out_stat->st_size = st.st_size;
+    out_stat->st_mtim = st.st_mtim;
+    out_stat->st_ctim = st.st_ctim;
+}
+
+/**
+ * nms_ifcfg_rh_reader_get_files_stat:
+ * @cache: the #NMSIfcfgRHReadCache
+ * @filename: the ifcfg file
+ * @out_files_stat: (out): the stat data of all files that are read
+ *   for the profile.
+ *
+ * If the stat data is unchanged, reading the profile again would give
+ * the same result. That allows to skip unchanged files on reload.
+ *
+ * Returns: %FALSE if the profile depends on files that are not covered by
+ *   @out_files_stat (alias files). Such profiles must always be read.
+ */
+gboolean
+nms_ifcfg_rh_reader_get_files_stat(NMSIfcfgRHReadCache *cache,
+                                   const char *         filename,
+                                   NMSIfcfgRHFilesStat *out_files_stat)
 {
-    GDir *        dir;
-    gs_free char *dirname   = NULL;
-    gs_free char *base      = NULL;
-    NMIPAddress * base_addr = NULL;
-    GError *      err       = NULL;
+    gs_free char *dirname = NULL;
+    gs_free char *base    = NULL;
+    GHashTable *  aliases;
+
+    nm_assert(cache);
+    nm_assert(filename);
+    nm_assert(out_files_stat);
+
+    dirname = g_path_get_dirname(filename);
+    base    = g_path_get_basename(filename);
+
+    aliases = _read_cache_get_aliases(cache, dirname, NULL);
+    if (!aliases || g_hash_table_contains(aliases, base))
+        return FALSE;
+
+    if (!cache->network_stat_loaded) {
+        cache->network_stat_loaded = TRUE;
+        _file_stat(NETWORK_FILE, &cache->network_stat);
+    }
+
+    {
+        gs_free char *keys_path   = utils_get_keys_path(filename);
+        gs_free char *route_path  = utils_get_route_path(filename);
+        gs_free char *route6_path = utils_get_route6_path(filename);
+        gs_free char *rule_path   = utils_get_rule_path(filename);
+        gs_free char *rule6_path  = utils_get_rule6_path(filename);
+
+        G_STATIC_ASSERT_EXPR(G_N_ELEMENTS(out_files_stat->files) == 7);
+
+        _file_stat(filename, &out_files_stat->files[0]);
+        _file_stat(keys_path, &out_files_stat->files[1]);
+        _file_stat(route_path, &out_files_stat->files[2]);
+        _file_stat(route6_path, &out_files_stat->files[3]);
+        _file_stat(rule_path, &out_files_stat->files[4]);
+        _file_stat(rule6_path, &out_files_stat->files[5]);
+        memcpy(&out_files_stat->files[6], &cache->network_stat, sizeof(cache->network_stat));
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static void
+read_aliases(NMSettingIPConfig *  s_ip4,
+             gboolean             read_defroute,
+             const char *         filename,
+             NMSIfcfgRHReadCache *cache)
+{
+    gs_unref_hashtable GHashTable *aliases_free = NULL;
+    GHashTable *                   aliases;
+    const GPtrArray *              items;
+    gs_free char *                 dirname   = NULL;
+    gs_free char *                 base      = NULL;
+    NMIPAddress *                  base_addr = NULL;
+    GError *                       err       = NULL;
+    guint                          i;
 
     g_return_if_fail(s_ip4 != NULL);
     g_return_if_fail(filename != NULL);
@@ -2115,104 +2309,110 @@ read_aliases(NMSettingIPConfig *s_ip4, gboolean read_defroute, const char *filen
     base = g_path_get_basename(filename);
     nm_assert(base != NULL);
 
-    dir = g_dir_open(dirname, 0, &err);
-    if (dir) {
-        const char * item;
-        NMIPAddress *addr;
-        gboolean     ok;
-
-        while ((item = g_dir_read_name(dir))) {
-            nm_auto_shvar_file_close shvarFile *parsed       = NULL;
-            gs_free char *                      gateway      = NULL;
-            gs_free char *                      device_value = NULL;
-            gs_free char *                      full_path    = NULL;
-            const char *                        device;
-            const char *                        p;
-
-            if (!utils_is_ifcfg_alias_file(item, base))
-                continue;
+    /* With a @cache, the directory is only read once for all profiles. */
+    if (cache)
+        aliases = _read_cache_get_aliases(cache, dirname, &err);
+    else
+        aliases = aliases_free = _aliases_read_dir(dirname, &err);
 
-            full_path = g_build_filename(dirname, item, NULL);
+    if (!aliases) {
+        PARSE_WARNING("can not read directory '%s': %s", dirname, err->message);
+        g_error_free(err);
+        return;
+    }
 
-            p = strchr(item, ':');
-            g_assert(p != NULL); /* we know this is true from utils_is_ifcfg_alias_file() */
-            for (p++; *p; p++) {
-                if (!g_ascii_isalnum(*p) && *p != '_')
-                    break;
-            }
-            if (*p) {
-                PARSE_WARNING("ignoring alias file '%s' with invalid name", full_path);
-                continue;
-            }
+    items = g_hash_table_lookup(aliases, base);
+    if (!items)
+        return;
 
-            parsed = svOpenFile(full_path, &err);
-            if (!parsed) {
-                PARSE_WARNING("couldn't parse alias file '%s': %s", full_path, err->message);
-                g_clear_error(&err);
-                continue;
-            }
+    for (i = 0; i < items->len; i++) {
+        const char *                        item         = items->pdata[i];
+        nm_auto_shvar_file_close shvarFile *parsed       = NULL;
+        gs_free char *                      gateway      = NULL;
+        gs_free char *                      device_value = NULL;
+        gs_free char *                      full_path    = NULL;
+        const char *                        device;
+        const char *                        p;
+        NMIPAddress *                       addr;
+        gboolean                            ok;
+
+        nm_assert(utils_is_ifcfg_alias_file(item, base));
+
+        full_path = g_build_filename(dirname, item, NULL);
+
+        p = strchr(item, ':');
+        g_assert(p != NULL); /* we know this is true from utils_is_ifcfg_alias_file() */
+        for (p++; *p; p++) {
+            if (!g_ascii_isalnum(*p) && *p != '_')
+                break;
+        }
+        if (*p) {
+            PARSE_WARNING("ignoring alias file '%s' with invalid name", full_path);
+            continue;
+        }
 
-            device = svGetValueStr(parsed, "DEVICE", &device_value);
-            if (!device) {
-                PARSE_WARNING("alias file '%s' has no DEVICE", full_path);
-                continue;
-            }
-            /* We know that item starts with IFCFG_TAG from utils_is_ifcfg_alias_file() */
-            if (strcmp(device, item + strlen(IFCFG_TAG)) != 0) {
-                PARSE_WARNING("alias file '%s' has invalid DEVICE (%s) for filename",
-                              full_path,
-                              device);
-                continue;
-            }
+        parsed = svOpenFile(full_path, &err);
+        if (!parsed) {
+            PARSE_WARNING("couldn't parse alias file '%s': %s", full_path, err->message);
+            g_clear_error(&err);
+            continue;
+        }
 
-            addr = NULL;
-            ok   = read_full_ip4_address(parsed,
-                                       -1,
-                                       base_addr,
-                                       &addr,
-                                       read_defroute ? &gateway : NULL,
-                                       &err);
-            if (ok) {
-                nm_ip_address_set_attribute(addr,
-                                            NM_IP_ADDRESS_ATTRIBUTE_LABEL,
-                                            g_variant_new_string(device));
-                if (!nm_setting_ip_config_add_address(s_ip4, addr))
-                    PARSE_WARNING("duplicate IP4 address in alias file %s", item);
-                if (nm_streq0(nm_setting_ip_config_get_method(s_ip4),
-                              NM_SETTING_IP4_CONFIG_METHOD_DISABLED))
+        device = svGetValueStr(parsed, "DEVICE", &device_value);
+        if (!device) {
+            PARSE_WARNING("alias file '%s' has no DEVICE", full_path);
+            continue;
+        }
+        /* We know that item starts with IFCFG_TAG from utils_is_ifcfg_alias_file() */
+        if (strcmp(device, item + strlen(IFCFG_TAG)) != 0) {
+            PARSE_WARNING("alias file '%s' has invalid DEVICE (%s) for filename",
+                          full_path,
+                          device);
+            continue;
+        }
+
+        addr = NULL;
+        ok   = read_full_ip4_address(parsed,
+                                   -1,
+                                   base_addr,
+                                   &addr,
+                                   read_defroute ? &gateway : NULL,
+                                   &err);
+        if (ok) {
+            nm_ip_address_set_attribute(addr,
+                                        NM_IP_ADDRESS_ATTRIBUTE_LABEL,
+                                        g_variant_new_string(device));
+            if (!nm_setting_ip_config_add_address(s_ip4, addr))
+                PARSE_WARNING("duplicate IP4 address in alias file %s", item);
+            if (nm_streq0(nm_setting_ip_config_get_method(s_ip4),
+                          NM_SETTING_IP4_CONFIG_METHOD_DISABLED))
+                g_object_set(s_ip4,
+                             NM_SETTING_IP_CONFIG_METHOD,
+                             NM_SETTING_IP4_CONFIG_METHOD_MANUAL,
+                             NULL);
+            if (read_defroute) {
+                int v;
+
+                if (gateway) {
+                    g_object_set(s_ip4, NM_SETTING_IP_CONFIG_GATEWAY, gateway, NULL);
+                    read_defroute = FALSE;
+                }
+                v = svGetValueBoolean(parsed, "DEFROUTE", -1);
+                if (v != -1) {
                     g_object_set(s_ip4,
-                                 NM_SETTING_IP_CONFIG_METHOD,
-                                 NM_SETTING_IP4_CONFIG_METHOD_MANUAL,
+                                 NM_SETTING_IP_CONFIG_NEVER_DEFAULT,
+                                 (gboolean) !v,
                                  NULL);
-                if (read_defroute) {
-                    int i;
-
-                    if (gateway) {
-                        g_object_set(s_ip4, NM_SETTING_IP_CONFIG_GATEWAY, gateway, NULL);
-                        read_defroute = FALSE;
-                    }
-                    i = svGetValueBoolean(parsed, "DEFROUTE", -1);
-                    if (i != -1) {
-                        g_object_set(s_ip4,
-                                     NM_SETTING_IP_CONFIG_NEVER_DEFAULT,
-                                     (gboolean) !i,
-                                     NULL);
-                        read_defroute = FALSE;
-                    }
+                    read_defroute = FALSE;
                 }
-            } else {
-                PARSE_WARNING("error reading IP4 address from alias file '%s': %s",
-                              full_path,
-                              err ? err->message : "no address");
-                g_clear_error(&err);
             }
-            nm_ip_address_unref(addr);
+        } else {
+            PARSE_WARNING("error reading IP4 address from alias file '%s': %s",
+                          full_path,
+                          err ? err->message : "no address");
+            g_clear_error(&err);
         }
-
-        g_dir_close(dir);
-    } else {
-        PARSE_WARNING("can not read directory '%s': %s", dirname, err->message);
-        g_error_free(err);
+        nm_ip_address_unref(addr);
     }
 }
 
@@ -6282,17 +6482,19 @@ check_dns_search_domains(shvarFile *ifcfg, NMSetting *s_ip4, NMSetting *s_ip6)
 }
 
 static NMConnection *
-connection_from_file_full(const char *filename,
-                          const char *network_file, /* for unit tests only */
-                          const char *test_type,    /* for unit tests only */
-                          char **     out_unhandled,
-                          GError **   error,
-                          gboolean *  out_ignore_error)
+connection_from_file_full(const char *         filename,
+                          const char *         network_file, /* for unit tests only */
+                          const char *         test_type,    /* for unit tests only */
+                          NMSIfcfgRHReadCache *cache,
+                          char **              out_unhandled,
+                          GError **            error,
+                          gboolean *           out_ignore_error)
 {
-    nm_auto_shvar_file_close shvarFile *main_ifcfg    = NULL;
-    nm_auto_shvar_file_close shvarFile *network_ifcfg = NULL;
-    gs_unref_object NMConnection *connection          = NULL;
-    gs_free char *                type                = NULL;
+    nm_auto_shvar_file_close shvarFile *main_ifcfg         = NULL;
+    nm_auto_shvar_file_close shvarFile *network_ifcfg_free = NULL;
+    shvarFile *                         network_ifcfg;
+    gs_unref_object NMConnection *connection               = NULL;
+    gs_free char *                type                     = NULL;
     char *                        devtype, *bootproto;
     NMSetting *                   setting;
     NMSetting *                   s_ip4;
@@ -6307,9 +6509,11 @@ connection_from_file_full(const char *filename,
 
     NM_SET_OUT(out_ignore_error, FALSE);
 
+    nm_assert(!network_file || !cache);
+
     /* Non-NULL only for unit tests; normally use /etc/sysconfig/network */
     if (!network_file)
-        network_file = SYSCONFDIR "/sysconfig/network";
+        network_file = NETWORK_FILE;
 
     ifcfg_name = utils_get_ifcfg_name(filename, TRUE);
     if (!ifcfg_name) {
@@ -6325,7 +6529,10 @@ connection_from_file_full(const char *filename,
     if (!main_ifcfg)
         return NULL;
 
-    network_ifcfg = svOpenFile(network_file, NULL);
+    if (cache)
+        network_ifcfg = _read_cache_get_network_ifcfg(cache);
+    else
+        network_ifcfg = network_ifcfg_free = svOpenFile(network_file, NULL);
 
     if (!svGetValueBoolean(main_ifcfg, "NM_CONTROLLED", TRUE)) {
         connection = create_unhandled_connection(filename, main_ifcfg, "unmanaged", out_unhandled);
@@ -6576,7 +6783,8 @@ connection_from_file_full(const char *filename,
     read_aliases(NM_SETTING_IP_CONFIG(s_ip4),
                  !has_ip4_defroute
                      && !nm_setting_ip_config_get_gateway(NM_SETTING_IP_CONFIG(s_ip4)),
-                 filename);
+                 filename,
+                 cache);
     nm_connection_add_setting(connection, s_ip4);
 
     read_routing_rules(main_ifcfg,
@@ -6634,12 +6842,19 @@ connection_from_file_full(const char *filename,
 }
 
 NMConnection *
-connection_from_file(const char *filename,
-                     char **     out_unhandled,
-                     GError **   error,
-                     gboolean *  out_ignore_error)
+connection_from_file(const char *         filename,
+                     NMSIfcfgRHReadCache *cache,
+                     char **              out_unhandled,
+                     GError **            error,
+                     gboolean *           out_ignore_error)
 {
-    return connection_from_file_full(filename, NULL, NULL, out_unhandled, error, out_ignore_error);
+    return connection_from_file_full(filename,
+                                     NULL,
+                                     NULL,
+                                     cache,
+                                     out_unhandled,
+                                     error,
+                                     out_ignore_error);
 }
 
 NMConnection *
@@ -6649,5 +6864,11 @@ nmtst_connection_from_file(const char *filename,
                            char **     out_unhandled,
                            GError **   error)
 {
-    return connection_from_file_full(filename, network_file, test_type, out_unhandled, error, NULL);
+    return connection_from_file_full(filename,
+                                     network_file,
+                                     test_type,
+                                     NULL,
+                                     out_unhandled,
+                                     error,
+                                     NULL);
 }
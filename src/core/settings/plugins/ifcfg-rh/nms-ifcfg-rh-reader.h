@@ -8,10 +8,48 @@
 
 #include "nm-connection.h"
 
-NMConnection *connection_from_file(const char *filename,
-                                   char **     out_unhandled,
-                                   GError **   error,
-                                   gboolean *  out_ignore_error);
+/*****************************************************************************/
+
+typedef struct {
+    dev_t           st_dev;
+    ino_t           st_ino;
+    off_t           st_size;
+    struct timespec st_mtim;
+    struct timespec st_ctim;
+} NMSIfcfgRHFileStat;
+
+typedef struct {
+    /* The stat data of all files that are read for one profile: the ifcfg file,
+     * its "keys-", "route-", "route6-", "rule-" and "rule6-" files and the
+     * network file. Files that don't exist are all zero. */
+    NMSIfcfgRHFileStat files[7];
+} NMSIfcfgRHFilesStat;
+
+/* A cache for reading many profiles at once (e.g. when reloading all files).
+ * It shares the files that are the same for all profiles. The cache must not
+ * outlive the reload, as it doesn't notice changes on disk. */
+typedef struct _NMSIfcfgRHReadCache NMSIfcfgRHReadCache;
+
+NMSIfcfgRHReadCache *nms_ifcfg_rh_read_cache_new(void);
+
+void nms_ifcfg_rh_read_cache_free(NMSIfcfgRHReadCache *cache);
+
+NM_AUTO_DEFINE_FCN0(NMSIfcfgRHReadCache *,
+                    _nm_auto_free_ifcfg_rh_read_cache,
+                    nms_ifcfg_rh_read_cache_free);
+#define nm_auto_free_ifcfg_rh_read_cache nm_auto(_nm_auto_free_ifcfg_rh_read_cache)
+
+gboolean nms_ifcfg_rh_reader_get_files_stat(NMSIfcfgRHReadCache *cache,
+                                            const char *         filename,
+                                            NMSIfcfgRHFilesStat *out_files_stat);
+
+/*****************************************************************************/
+
+NMConnection *connection_from_file(const char *         filename,
+                                   NMSIfcfgRHReadCache *cache,
+                                   char **              out_unhandled,
+                                   GError **            error,
+                                   gboolean *           out_ignore_error);
 
 NMConnection *nmtst_connection_from_file(const char *filename,
                                          const char *network_file,
@@ -50,6 +50,10 @@ nms_ifcfg_rh_storage_copy_content(NMSIfcfgRHStorage *dst, const NMSIfcfgRHStorag
     dst->unmanaged_spec    = g_strdup(src->unmanaged_spec);
     dst->unrecognized_spec = g_strdup(src->unrecognized_spec);
     dst->stat_mtime        = src->stat_mtime;
+    dst->files_stat_valid  = src->files_stat_valid;
+    if (src->files_stat_valid)
+        memcpy(&dst->files_stat, &src->files_stat, sizeof(src->files_stat));
+    nm_g_object_ref_set(&dst->files_connection, src->files_connection);
 }
 
 NMConnection *
@@ -137,6 +141,42 @@ nms_ifcfg_rh_storage_new_unhandled(NMSIfcfgRHPlugin *plugin,
     return self;
 }
 
+NMSIfcfgRHStorage *
+nms_ifcfg_rh_storage_new_unchanged(NMSIfcfgRHPlugin *plugin, const NMSIfcfgRHStorage *storage_old)
+{
+    NMSIfcfgRHStorage *self;
+
+    nm_assert(NMS_IS_IFCFG_RH_STORAGE(storage_old));
+    nm_assert(storage_old->files_stat_valid);
+
+    self = _storage_new(plugin,
+                        nms_ifcfg_rh_storage_get_uuid_opt(storage_old),
+                        nms_ifcfg_rh_storage_get_filename(storage_old));
+    self->unmanaged_spec    = g_strdup(storage_old->unmanaged_spec);
+    self->unrecognized_spec = g_strdup(storage_old->unrecognized_spec);
+    self->stat_mtime        = storage_old->stat_mtime;
+    self->unchanged         = TRUE;
+    memcpy(&self->files_stat, &storage_old->files_stat, sizeof(self->files_stat));
+    self->files_stat_valid = TRUE;
+    self->files_connection = nm_g_object_ref(storage_old->files_connection);
+    return self;
+}
+
+void
+nms_ifcfg_rh_storage_set_files_stat(NMSIfcfgRHStorage *self, const NMSIfcfgRHFilesStat *files_stat)
+{
+    nm_assert(NMS_IS_IFCFG_RH_STORAGE(self));
+
+    if (files_stat) {
+        memcpy(&self->files_stat, files_stat, sizeof(*files_stat));
+        self->files_stat_valid = TRUE;
+        nm_g_object_ref_set(&self->files_connection, self->connection);
+    } else {
+        self->files_stat_valid = FALSE;
+        g_clear_object(&self->files_connection);
+    }
+}
+
 static void
 _storage_clear(NMSIfcfgRHStorage *self)
 {
@@ -145,6 +185,7 @@ _storage_clear(NMSIfcfgRHStorage *self)
     nm_clear_g_free(&self->unmanaged_spec);
     nm_clear_g_free(&self->unrecognized_spec);
     g_clear_object(&self->connection);
+    g_clear_object(&self->files_connection);
 }
 
 static void
@@ -8,6 +8,7 @@
 
 #include "c-list/src/c-list.h"
 #include "settings/nm-settings-storage.h"
+#include "nms-ifcfg-rh-reader.h"
 
 /*****************************************************************************/
 
@@ -34,8 +35,23 @@ typedef struct {
      * higher priority. */
     struct timespec stat_mtime;
 
+    /* The stat data of the files that were read, if @files_stat_valid. On
+     * reload, the profile is only read again if that changed. */
+    NMSIfcfgRHFilesStat files_stat;
+
+    /* The connection as it was read from the files of @files_stat. When a
+     * reload reads the files again because their stat data changed, but the
+     * profile is still the same, no event is emitted. */
+    NMConnection *files_connection;
+
     bool dirty : 1;
 
+    bool files_stat_valid : 1;
+
+    /* Set for storages that are created during reload for unchanged files.
+     * They don't have a connection and no event is emitted for them. */
+    bool unchanged : 1;
+
 } NMSIfcfgRHStorage;
 
 typedef struct _NMSIfcfgRHStorageClass NMSIfcfgRHStorageClass;
@@ -54,6 +70,12 @@ NMSIfcfgRHStorage *nms_ifcfg_rh_storage_new_unhandled(struct _NMSIfcfgRHPlugin *
                                                       const char *              unmanaged_spec,
                                                       const char *              unrecognized_spec);
 
+NMSIfcfgRHStorage *nms_ifcfg_rh_storage_new_unchanged(struct _NMSIfcfgRHPlugin *plugin,
+                                                      const NMSIfcfgRHStorage * storage_old);
+
+void nms_ifcfg_rh_storage_set_files_stat(NMSIfcfgRHStorage *        self,
+                                         const NMSIfcfgRHFilesStat *files_stat);
+
 void nms_ifcfg_rh_storage_destroy(NMSIfcfgRHStorage *self);
 
 /*****************************************************************************/
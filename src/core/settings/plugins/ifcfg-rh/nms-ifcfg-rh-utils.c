@@ -217,6 +217,18 @@ utils_get_route6_path(const char *parent)
     return utils_get_extra_path(parent, ROUTE6_TAG);
 }
 
+char *
+utils_get_rule_path(const char *parent)
+{
+    return utils_get_extra_path(parent, RULE_TAG);
+}
+
+char *
+utils_get_rule6_path(const char *parent)
+{
+    return utils_get_extra_path(parent, RULE6_TAG);
+}
+
 shvarFile *
 utils_get_extra_ifcfg(const char *parent, const char *tag, gboolean should_create)
 {
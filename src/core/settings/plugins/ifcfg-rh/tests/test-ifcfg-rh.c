@@ -2340,6 +2340,114 @@ test_read_wired_aliases_good(gconstpointer test_data)
     g_object_unref(connection);
 }
 
+static void
+test_read_cache(void)
+{
+    nm_auto_free_ifcfg_rh_read_cache NMSIfcfgRHReadCache *cache = NULL;
+    gs_unref_object NMConnection *connection1                   = NULL;
+    gs_unref_object NMConnection *connection2                   = NULL;
+    gs_free_error GError *error                                 = NULL;
+    gs_free char *        unhandled                             = NULL;
+    NMSIfcfgRHFilesStat   files_stat1;
+    NMSIfcfgRHFilesStat   files_stat2;
+
+    cache = nms_ifcfg_rh_read_cache_new();
+
+    /* profiles with alias files are not covered by the stat data. */
+    g_assert(!nms_ifcfg_rh_reader_get_files_stat(cache,
+                                                 TEST_IFCFG_DIR "/ifcfg-aliasem0",
+                                                 &files_stat1));
+
+    g_assert(nms_ifcfg_rh_reader_get_files_stat(cache,
+                                                TEST_IFCFG_DIR "/ifcfg-test-minimal",
+                                                &files_stat1));
+    g_assert(files_stat1.files[0].st_ino != 0);
+    g_assert(files_stat1.files[1].st_ino == 0);
+    g_assert(nms_ifcfg_rh_reader_get_files_stat(cache,
+                                                TEST_IFCFG_DIR "/ifcfg-test-minimal",
+                                                &files_stat2));
+    g_assert(memcmp(&files_stat1, &files_stat2, sizeof(files_stat1)) == 0);
+
+    /* reading with the cache gives the same result. */
+    connection1 = connection_from_file(TEST_IFCFG_DIR "/ifcfg-aliasem0",
+                                       cache,
+                                       &unhandled,
+                                       &error,
+                                       NULL);
+    nmtst_assert_success(connection1, error);
+    g_assert(!unhandled);
+    connection2 = _connection_from_file(TEST_IFCFG_DIR "/ifcfg-aliasem0", NULL, NULL, NULL);
+    nmtst_assert_connection_equals(connection1, FALSE, connection2, FALSE);
+}
+
+static NMConnection *
+_reload_read(const char *filename, NMSIfcfgRHFilesStat *out_files_stat)
+{
+    nm_auto_free_ifcfg_rh_read_cache NMSIfcfgRHReadCache *cache = NULL;
+    gs_free_error GError *error                                 = NULL;
+    gs_free char *        unhandled                             = NULL;
+    NMConnection *        connection;
+
+    cache = nms_ifcfg_rh_read_cache_new();
+    g_assert(nms_ifcfg_rh_reader_get_files_stat(cache, filename, out_files_stat));
+    connection = connection_from_file(filename, cache, &unhandled, &error, NULL);
+    nmtst_assert_success(connection, error);
+    g_assert(!unhandled);
+    return connection;
+}
+
+static void
+test_read_reload_unchanged(void)
+{
+    const char *const FILENAME_A = TEST_SCRATCH_DIR "/ifcfg-reload-a";
+    const char *const FILENAME_B = TEST_SCRATCH_DIR "/ifcfg-reload-b";
+    const char *const CONTENT    = "DEVICE=eth0\nHWADDR=00:16:41:11:22:33\n";
+
+    gs_unref_object NMConnection *connection_a1 = NULL;
+    gs_unref_object NMConnection *connection_a2 = NULL;
+    gs_unref_object NMConnection *connection_b1 = NULL;
+    gs_unref_object NMConnection *connection_b2 = NULL;
+    gs_unref_object NMConnection *connection_b3 = NULL;
+    NMSIfcfgRHFilesStat           files_stat_a1;
+    NMSIfcfgRHFilesStat           files_stat_a2;
+    NMSIfcfgRHFilesStat           files_stat_b1;
+    NMSIfcfgRHFilesStat           files_stat_b2;
+    NMSIfcfgRHFilesStat           files_stat_b3;
+
+    /* On reload, the plugin skips a profile without an event if the stat data
+     * of its files is unchanged. If the stat data changed, it reads the files
+     * again, but only emits an event if the profile differs from the one read
+     * before. Check both decisions for untouched, touched and modified files. */
+    nmtst_file_set_contents(FILENAME_A, CONTENT);
+    nmtst_file_set_contents(FILENAME_B, CONTENT);
+
+    connection_a1 = _reload_read(FILENAME_A, &files_stat_a1);
+    connection_b1 = _reload_read(FILENAME_B, &files_stat_b1);
+
+    /* nothing changed. */
+    connection_a2 = _reload_read(FILENAME_A, &files_stat_a2);
+    g_assert(memcmp(&files_stat_a1, &files_stat_a2, sizeof(files_stat_a1)) == 0);
+
+    /* B gets written again with the same content. */
+    nmtst_file_set_contents(FILENAME_B, CONTENT);
+    connection_b2 = _reload_read(FILENAME_B, &files_stat_b2);
+    g_assert(memcmp(&files_stat_b1, &files_stat_b2, sizeof(files_stat_b1)) != 0);
+    g_assert(nm_connection_compare(connection_b1, connection_b2, NM_SETTING_COMPARE_FLAG_EXACT));
+
+    /* B gets modified. A is still untouched. */
+    nmtst_file_set_contents(FILENAME_B, "DEVICE=eth0\nHWADDR=00:16:41:11:22:33\nMTU=1400\n");
+    connection_b3 = _reload_read(FILENAME_B, &files_stat_b3);
+    g_assert(memcmp(&files_stat_b2, &files_stat_b3, sizeof(files_stat_b2)) != 0);
+    g_assert(!nm_connection_compare(connection_b2, connection_b3, NM_SETTING_COMPARE_FLAG_EXACT));
+
+    g_clear_object(&connection_a2);
+    connection_a2 = _reload_read(FILENAME_A, &files_stat_a2);
+    g_assert(memcmp(&files_stat_a1, &files_stat_a2, sizeof(files_stat_a1)) == 0);
+
+    nmtst_file_unlink(FILENAME_A);
+    nmtst_file_unlink(FILENAME_B);
+}
+
 static void
 test_read_wired_aliases_bad(const char *base, const char *expected_id)
 {
@@ -11640,6 +11748,8 @@ main(int argc, char **argv)
                          GINT_TO_POINTER(3),
                          test_read_wired_aliases_good);
     g_test_add_func(TPATH "wired/read/aliases/bad1", test_read_wired_aliases_bad_1);
+    g_test_add_func(TPATH "wired/read/cache", test_read_cache);
+    g_test_add_func(TPATH "wired/read/reload-unchanged", test_read_reload_unchanged);
     g_test_add_func(TPATH "wired/read/aliases/bad2", test_read_wired_aliases_bad_2);
     g_test_add_func(TPATH "wifi/read/open", test_read_wifi_open);
     g_test_add_func(TPATH "wifi/read/open/auto", test_read_wifi_open_auto);
@@ -9,6 +9,8 @@
 
 #include <sys/stat.h>
 
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-secret-utils.h"
 #include "libnm-core-intern/nm-keyfile-internal.h"
 
 #include "NetworkManagerUtils.h"
@@ -165,8 +167,11 @@ nms_keyfile_reader_from_file(const char * full_filename,
                              GError **    error)
 {
     nm_auto_unref_keyfile GKeyFile *key_file     = NULL;
+    gs_free char *                  contents     = NULL;
+    gsize                           contents_len = 0;
     NMConnection *                  connection   = NULL;
     GError *                        verify_error = NULL;
+    gboolean                        success;
 
     nm_assert(full_filename && full_filename[0] == '/');
     nm_assert(!profile_dir || profile_dir[0] == '/');
@@ -182,8 +187,22 @@ nms_keyfile_reader_from_file(const char * full_filename,
                                                   error))
         return NULL;
 
+    /* Read the file at once, instead of g_key_file_load_from_file() which
+     * reads it in small chunks. Parsing is still left to GKeyFile. */
+    if (!nm_utils_file_get_contents(-1,
+                                    full_filename,
+                                    0,
+                                    NM_UTILS_FILE_GET_CONTENTS_FLAG_SECRET,
+                                    &contents,
+                                    &contents_len,
+                                    NULL,
+                                    error))
+        return NULL;
+
     key_file = g_key_file_new();
-    if (!g_key_file_load_from_file(key_file, full_filename, G_KEY_FILE_NONE, error))
+    success  = g_key_file_load_from_data(key_file, contents, contents_len, G_KEY_FILE_NONE, error);
+    nm_explicit_bzero(contents, contents_len);
+    if (!success)
         return NULL;
 
     connection =
@@ -2298,6 +2298,35 @@ test_read_missing_id_uuid(void)
     g_assert_cmpstr(nm_connection_get_uuid(connection), ==, expected_uuid);
 }
 
+static void
+test_read_duplicate_keys_groups(void)
+{
+    gs_unref_object NMConnection *connection = NULL;
+    NMSettingConnection *         s_con;
+    NMSettingIPConfig *           s_ip4;
+
+    connection =
+        keyfile_read_connection_from_file(TEST_KEYFILES_DIR "/Test_Duplicate_Keys_Groups");
+
+    s_con = nm_connection_get_setting_connection(connection);
+    g_assert(s_con);
+    g_assert_cmpstr(nm_setting_connection_get_id(s_con), ==, "Test Duplicate Keys Groups");
+    g_assert_cmpstr(nm_setting_connection_get_uuid(s_con),
+                    ==,
+                    "0b3e3a4e-6f1c-4a0e-9d7a-2a6c5c8e1f21");
+    g_assert(!nm_setting_connection_get_autoconnect(s_con));
+
+    s_ip4 = nm_connection_get_setting_ip4_config(connection);
+    g_assert(s_ip4);
+    g_assert_cmpstr(nm_setting_ip_config_get_method(s_ip4),
+                    ==,
+                    NM_SETTING_IP4_CONFIG_METHOD_MANUAL);
+    g_assert_cmpint(nm_setting_ip_config_get_num_addresses(s_ip4), ==, 1);
+    check_ip_address(s_ip4, 0, "192.0.2.2", 24);
+    g_assert_cmpint(nm_setting_ip_config_get_num_dns(s_ip4), ==, 1);
+    g_assert_cmpstr(nm_setting_ip_config_get_dns(s_ip4, 0), ==, "198.51.100.53");
+}
+
 static void
 test_read_minimal(void)
 {
@@ -2903,6 +2932,7 @@ main(int argc, char **argv)
     g_test_add_func("/keyfile/test_read_missing_vlan_setting", test_read_missing_vlan_setting);
     g_test_add_func("/keyfile/test_read_missing_vlan_flags", test_read_missing_vlan_flags);
     g_test_add_func("/keyfile/test_read_missing_id_uuid", test_read_missing_id_uuid);
+    g_test_add_func("/keyfile/test_read_duplicate_keys_groups", test_read_duplicate_keys_groups);
 
     g_test_add_func("/keyfile/test_read_minimal", test_read_minimal);
     g_test_add_func("/keyfile/test_read_minimal_slave", test_read_minimal_slave);
@@ -6,6 +6,7 @@
 #include "src/core/nm-default-daemon.h"
 
 #include <unistd.h>
+#include <sys/socket.h>
 
 #include "nm-config.h"
 #include "nm-test-device.h"
@@ -421,6 +422,99 @@ test_config_connectivity_check(void)
 #endif
 }
 
+#if WITH_CONCHECK
+    #define CONCHECK_SERVER_RESPONSE "NetworkManager is online"
+
+static gboolean
+_concheck_can_bind_to_lo(void)
+{
+    nm_auto_close int fd = -1;
+
+    /* curl binds the socket to the interface. Depending on the kernel, that
+     * requires CAP_NET_RAW. */
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    g_assert_cmpint(fd, >=, 0);
+    return setsockopt(fd, SOL_SOCKET, SO_BINDTODEVICE, "lo", NM_STRLEN("lo")) == 0;
+}
+
+static void
+_concheck_reuse_cb(NMConnectivity *           connectivity,
+                   NMConnectivityCheckHandle *handle,
+                   NMConnectivityState        state,
+                   gpointer                   user_data)
+{
+    NMConnectivityState *p_state = user_data;
+
+    *p_state = state;
+}
+#endif
+
+static void
+test_config_connectivity_check_reuse(void)
+{
+#if WITH_CONCHECK
+    const char *    CONFIG_INTERN = BUILD_DIR "/test-connectivity-check-reuse-intern.conf";
+    const int       N_CHECKS      = 5;
+    NMTstHttpServer server;
+    gs_free char *  uri = NULL;
+    NMConfig *      config;
+    NMConnectivity *connectivity;
+    int             i;
+
+    if (!_concheck_can_bind_to_lo()) {
+        g_test_skip("cannot bind to interface \"lo\"");
+        return;
+    }
+
+    nmtst_http_server_start(&server, CONCHECK_SERVER_RESPONSE, NULL);
+    uri = g_strdup_printf("http://127.0.0.1:%d/", server.port);
+
+    g_assert(g_file_set_contents(CONFIG_INTERN, "", 0, NULL));
+    config       = setup_config(NULL,
+                          TEST_DIR "/NetworkManager.conf",
+                          CONFIG_INTERN,
+                          NULL,
+                          "/no/such/dir",
+                          "",
+                          "--connectivity-uri",
+                          uri,
+                          "--connectivity-response",
+                          CONCHECK_SERVER_RESPONSE,
+                          NULL);
+    connectivity = nm_connectivity_get();
+
+    g_assert(nm_connectivity_check_enabled(connectivity));
+
+    for (i = 0; i < N_CHECKS; i++) {
+        NMConnectivityState state = NM_CONNECTIVITY_UNKNOWN;
+
+        nm_connectivity_check_start(connectivity,
+                                    AF_INET,
+                                    NULL,
+                                    1,
+                                    "lo",
+                                    _concheck_reuse_cb,
+                                    &state);
+        nmtst_main_context_iterate_until_assert(NULL, 5000, state != NM_CONNECTIVITY_UNKNOWN);
+        g_assert_cmpint(state, ==, NM_CONNECTIVITY_FULL);
+    }
+
+    /* this closes the connections. */
+    g_object_unref(connectivity);
+    g_object_unref(config);
+
+    nmtst_http_server_stop(&server);
+
+    /* all the checks were answered via the same connection. */
+    g_assert_cmpint(server.n_requests, ==, N_CHECKS);
+    g_assert_cmpint(server.n_connections, ==, 1);
+
+    g_assert(remove(CONFIG_INTERN) == 0);
+#else
+    g_test_skip("concheck disabled");
+#endif
+}
+
 static void
 test_config_no_auto_default(void)
 {
@@ -1373,6 +1467,7 @@ main(int argc, char **argv)
     g_test_add_func("/config/set-values", test_config_set_values);
     g_test_add_func("/config/global-dns", test_config_global_dns);
     g_test_add_func("/config/connectivity-check", test_config_connectivity_check);
+    g_test_add_func("/config/connectivity-check-reuse", test_config_connectivity_check_reuse);
 
     g_test_add_func("/config/signal", test_config_signal);
 
@@ -0,0 +1,284 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "src/core/nm-auth-manager.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define POLKIT_SERVICE     "org.freedesktop.PolicyKit1"
+#define POLKIT_OBJECT_PATH "/org/freedesktop/PolicyKit1/Authority"
+#define POLKIT_INTERFACE   "org.freedesktop.PolicyKit1.Authority"
+
+#define ACTION_ID "org.freedesktop.NetworkManager.network-control"
+
+static const char *const polkit_introspection_xml =
+    "<node>"
+    "  <interface name='" POLKIT_INTERFACE "'>"
+    "    <method name='CheckAuthorization'>"
+    "      <arg type='(sa{sv})' name='subject' direction='in'/>"
+    "      <arg type='s' name='action_id' direction='in'/>"
+    "      <arg type='a{ss}' name='details' direction='in'/>"
+    "      <arg type='u' name='flags' direction='in'/>"
+    "      <arg type='s' name='cancellation_id' direction='in'/>"
+    "      <arg type='(bba{ss})' name='result' direction='out'/>"
+    "    </method>"
+    "    <method name='CancelCheckAuthorization'>"
+    "      <arg type='s' name='cancellation_id' direction='in'/>"
+    "    </method>"
+    "    <signal name='Changed'/>"
+    "  </interface>"
+    "</node>";
+
+typedef struct {
+    guint n_check_authorization;
+} MockPolkit;
+
+static void
+_mock_polkit_method_call(GDBusConnection *      connection,
+                         const char *           sender,
+                         const char *           object_path,
+                         const char *           interface_name,
+                         const char *           method_name,
+                         GVariant *             parameters,
+                         GDBusMethodInvocation *invocation,
+                         gpointer               user_data)
+{
+    MockPolkit *mock = user_data;
+
+    if (nm_streq(method_name, "CheckAuthorization")) {
+        GVariant *details;
+
+        mock->n_check_authorization++;
+        details = g_variant_new_array(G_VARIANT_TYPE("{ss}"), NULL, 0);
+        g_dbus_method_invocation_return_value(invocation,
+                                              g_variant_new("((bb@a{ss}))", TRUE, FALSE, details));
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(invocation, NULL);
+}
+
+static GDBusConnection *
+_connection_new(GTestDBus *bus)
+{
+    GDBusConnection *connection;
+    gs_free_error GError *error = NULL;
+
+    connection = g_dbus_connection_new_for_address_sync(
+        g_test_dbus_get_bus_address(bus),
+        G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT
+            | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+        NULL,
+        NULL,
+        &error);
+    nmtst_assert_success(connection, error);
+    g_dbus_connection_set_exit_on_close(connection, FALSE);
+    return connection;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    guint    n_called;
+    gboolean is_authorized;
+} CheckData;
+
+static void
+_check_cb(NMAuthManager *      auth_manager,
+          NMAuthManagerCallId *call_id,
+          gboolean             is_authorized,
+          gboolean             is_challenge,
+          GError *             error,
+          gpointer             user_data)
+{
+    CheckData *data = user_data;
+
+    g_assert_no_error(error);
+    g_assert(!is_challenge);
+    data->n_called++;
+    data->is_authorized = is_authorized;
+}
+
+static void
+_check(NMAuthManager *auth_manager, NMAuthSubject *subject)
+{
+    CheckData data = {};
+
+    nm_auth_manager_check_authorization(auth_manager, subject, ACTION_ID, FALSE, _check_cb, &data);
+    nmtst_main_context_iterate_until_assert(NULL, 5000, data.n_called > 0);
+    g_assert_cmpint(data.n_called, ==, 1);
+    g_assert(data.is_authorized);
+}
+
+static void
+_assert_stats(NMAuthManager *auth_manager, guint64 hits, guint64 misses)
+{
+    guint64 h;
+    guint64 m;
+
+    nm_auth_manager_get_cache_stats(auth_manager, &h, &m);
+    g_assert_cmpint(h, ==, hits);
+    g_assert_cmpint(m, ==, misses);
+}
+
+static void
+_changed_cb(NMAuthManager *auth_manager, gpointer user_data)
+{
+    (*((guint *) user_data))++;
+}
+
+static void
+_client_vanished_cb(GDBusConnection *connection,
+                    const char *     sender_name,
+                    const char *     object_path,
+                    const char *     interface_name,
+                    const char *     signal_name,
+                    GVariant *       parameters,
+                    gpointer         user_data)
+{
+    *((gboolean *) user_data) = TRUE;
+}
+
+static void
+test_cache(void)
+{
+    gs_unref_object GTestDBus *bus               = NULL;
+    gs_unref_object GDBusConnection *polkit_conn = NULL;
+    gs_unref_object GDBusConnection *nm_conn     = NULL;
+    gs_unref_object GDBusConnection *client_conn = NULL;
+    gs_unref_object NMAuthManager *auth_manager  = NULL;
+    gs_unref_object NMAuthSubject *subject       = NULL;
+    gs_free char * client_name                   = NULL;
+    gs_free char * program                       = NULL;
+    gs_free_error GError *error                  = NULL;
+    gs_unref_variant GVariant *ret               = NULL;
+    GDBusNodeInfo *node_info;
+    MockPolkit     mock                          = {};
+    guint          registration_id;
+    guint          n_changed                     = 0;
+    guint          vanished_id;
+    gboolean       vanished                      = FALSE;
+
+    program = g_find_program_in_path("dbus-daemon");
+    if (!program) {
+        g_test_skip("dbus-daemon not available");
+        return;
+    }
+
+    bus = g_test_dbus_new(G_TEST_DBUS_NONE);
+    g_test_dbus_up(bus);
+
+    polkit_conn = _connection_new(bus);
+    nm_conn     = _connection_new(bus);
+    client_conn = _connection_new(bus);
+
+    node_info = g_dbus_node_info_new_for_xml(polkit_introspection_xml, &error);
+    nmtst_assert_success(node_info, error);
+    registration_id = g_dbus_connection_register_object(
+        polkit_conn,
+        POLKIT_OBJECT_PATH,
+        node_info->interfaces[0],
+        &((const GDBusInterfaceVTable){.method_call = _mock_polkit_method_call}),
+        &mock,
+        NULL,
+        &error);
+    nmtst_assert_success(registration_id, error);
+    g_dbus_node_info_unref(node_info);
+
+    ret = g_dbus_connection_call_sync(polkit_conn,
+                                      DBUS_SERVICE_DBUS,
+                                      DBUS_PATH_DBUS,
+                                      DBUS_INTERFACE_DBUS,
+                                      "RequestName",
+                                      g_variant_new("(su)", POLKIT_SERVICE, 0u),
+                                      G_VARIANT_TYPE("(u)"),
+                                      G_DBUS_CALL_FLAGS_NONE,
+                                      -1,
+                                      NULL,
+                                      &error);
+    nmtst_assert_success(ret, error);
+
+    auth_manager = g_object_new(NM_TYPE_AUTH_MANAGER,
+                                NM_AUTH_MANAGER_POLKIT_ENABLED,
+                                (int) NM_AUTH_POLKIT_MODE_USE_POLKIT,
+                                NM_AUTH_MANAGER_DBUS_CONNECTION,
+                                nm_conn,
+                                NULL);
+    g_signal_connect(auth_manager,
+                     NM_AUTH_MANAGER_SIGNAL_CHANGED,
+                     G_CALLBACK(_changed_cb),
+                     &n_changed);
+
+    /* the manager emits "changed" once it found the polkit name owner. */
+    nmtst_main_context_iterate_until_assert(NULL, 5000, n_changed > 0);
+
+    client_name = g_strdup(g_dbus_connection_get_unique_name(client_conn));
+    subject     = nm_auth_subject_new_unix_process(client_name, getpid(), 1000);
+    g_assert(subject);
+
+    _check(auth_manager, subject);
+    g_assert_cmpint(mock.n_check_authorization, ==, 1);
+    _assert_stats(auth_manager, 0, 1);
+
+    _check(auth_manager, subject);
+    g_assert_cmpint(mock.n_check_authorization, ==, 1);
+    _assert_stats(auth_manager, 1, 1);
+
+    /* polkit's "Changed" signal invalidates the cache. */
+    n_changed = 0;
+    g_assert(g_dbus_connection_emit_signal(polkit_conn,
+                                           NULL,
+                                           POLKIT_OBJECT_PATH,
+                                           POLKIT_INTERFACE,
+                                           "Changed",
+                                           NULL,
+                                           NULL));
+    nmtst_main_context_iterate_until_assert(NULL, 5000, n_changed > 0);
+
+    _check(auth_manager, subject);
+    g_assert_cmpint(mock.n_check_authorization, ==, 2);
+    _assert_stats(auth_manager, 1, 2);
+
+    _check(auth_manager, subject);
+    g_assert_cmpint(mock.n_check_authorization, ==, 2);
+    _assert_stats(auth_manager, 2, 2);
+
+    /* when the client disconnects, its results are dropped. */
+    vanished_id = nm_dbus_connection_signal_subscribe_name_owner_changed(nm_conn,
+                                                                         client_name,
+                                                                         _client_vanished_cb,
+                                                                         &vanished,
+                                                                         NULL);
+    g_dbus_connection_close_sync(client_conn, NULL, NULL);
+    nmtst_main_context_iterate_until_assert(NULL, 5000, vanished);
+    g_dbus_connection_signal_unsubscribe(nm_conn, vanished_id);
+
+    _check(auth_manager, subject);
+    g_assert_cmpint(mock.n_check_authorization, ==, 3);
+    _assert_stats(auth_manager, 2, 3);
+
+    g_signal_handlers_disconnect_by_func(auth_manager, _changed_cb, &n_changed);
+    g_clear_object(&auth_manager);
+    g_dbus_connection_unregister_object(polkit_conn, registration_id);
+    g_clear_object(&polkit_conn);
+    g_clear_object(&nm_conn);
+    g_clear_object(&client_conn);
+    g_test_dbus_down(bus);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_assert_logging(&argc, &argv, "INFO", "DEFAULT");
+
+    g_test_add_func("/auth-manager/cache", test_cache);
+
+    return g_test_run();
+}
@@ -18,7 +18,9 @@
 #include "libnm-systemd-core/nm-sd-utils-core.h"
 
 #include "dns/nm-dns-manager.h"
+#include "nm-checkpoint.h"
 #include "nm-connectivity.h"
+#include "devices/nm-device-utils.h"
 
 #include "nm-test-utils-core.h"
 
@@ -2582,6 +2584,381 @@ test_connectivity_state_cmp(void)
 
 /*****************************************************************************/
 
+static void
+test_device_activation_timing(void)
+{
+    static const NMDeviceActivationTimingEntry expected[] = {
+        {"prepare", 10},
+        {"config", 20},
+        {"dhcp4-start", 30},
+        {"ip-config", 35},
+        {"dhcp4-bound", 40},
+        {"activated", 60},
+        {"deactivating", 70},
+        {"disconnected", 80},
+    };
+    GArray *timing = NULL;
+    guint   i;
+
+#define _state(old, new, now)                                        \
+    nm_device_activation_timing_state_changed(&timing,               \
+                                              NM_DEVICE_STATE_##old, \
+                                              NM_DEVICE_STATE_##new, \
+                                              (now))
+#define _stage(state, stage, now) \
+    nm_device_activation_timing_stage(timing, NM_DEVICE_STATE_##state, "" stage "", (now))
+
+    /* Nothing is recorded before the first activation. */
+    g_assert(!_state(UNAVAILABLE, DISCONNECTED, 1));
+    g_assert(!timing);
+    g_assert(!_stage(CONFIG, "dhcp4-start", 2));
+
+    g_assert(_state(DISCONNECTED, PREPARE, 10));
+    g_assert(_state(PREPARE, CONFIG, 20));
+    g_assert(_stage(CONFIG, "dhcp4-start", 30));
+    g_assert(_state(CONFIG, IP_CONFIG, 35));
+    g_assert(_stage(IP_CONFIG, "dhcp4-bound", 40));
+    g_assert(_state(IP_CONFIG, ACTIVATED, 60));
+
+    /* A lease renewal does not count again. */
+    g_assert(!_stage(ACTIVATED, "dhcp4-bound", 65));
+
+    /* Sub-stages are only recorded while activating. */
+    g_assert(_state(ACTIVATED, DEACTIVATING, 70));
+    g_assert(!_stage(DEACTIVATING, "dhcp6-start", 75));
+
+    /* The timeline ends with the device being disconnected, and is kept. */
+    g_assert(_state(DEACTIVATING, DISCONNECTED, 80));
+    g_assert(!_state(DISCONNECTED, UNAVAILABLE, 90));
+
+    g_assert_cmpint(timing->len, ==, G_N_ELEMENTS(expected));
+    for (i = 0; i < timing->len; i++) {
+        const NMDeviceActivationTimingEntry *e =
+            &g_array_index(timing, NMDeviceActivationTimingEntry, i);
+
+        g_assert_cmpstr(e->stage, ==, expected[i].stage);
+        g_assert_cmpint(e->timestamp_usec, ==, expected[i].timestamp_usec);
+    }
+
+    /* A new activation starts over. */
+    g_assert(_state(UNAVAILABLE, PREPARE, 100));
+    g_assert_cmpint(timing->len, ==, 1);
+    g_assert_cmpstr(g_array_index(timing, NMDeviceActivationTimingEntry, 0).stage, ==, "prepare");
+
+    /* Asking for secrets repeatedly cannot grow the timeline without bound. */
+    for (i = 0; i < 2 * NM_DEVICE_ACTIVATION_TIMING_MAX_ENTRIES; i++) {
+        if (i % 2)
+            _state(NEED_AUTH, CONFIG, 200 + i);
+        else
+            _state(CONFIG, NEED_AUTH, 200 + i);
+    }
+    g_assert_cmpint(timing->len, ==, NM_DEVICE_ACTIVATION_TIMING_MAX_ENTRIES);
+    g_assert(!_stage(CONFIG, "dhcp4-start", 500));
+    g_assert(!_state(CONFIG, IP_CONFIG, 501));
+
+#undef _state
+#undef _stage
+
+    g_array_unref(timing);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GResolver  parent;
+    GPtrArray *tasks;
+    guint      n_lookups;
+    guint      n_in_flight_max;
+} TestResolver;
+
+typedef struct {
+    GResolverClass parent;
+} TestResolverClass;
+
+G_DEFINE_TYPE(TestResolver, test_resolver, G_TYPE_RESOLVER)
+
+static void
+test_resolver_lookup_by_name_async(GResolver *         resolver,
+                                   const char *        hostname,
+                                   GCancellable *      cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer            user_data)
+{
+    TestResolver *self = (TestResolver *) resolver;
+    GTask *       task;
+
+    task = g_task_new(resolver, cancellable, callback, user_data);
+    g_task_set_task_data(task, g_strdup(hostname), g_free);
+    g_ptr_array_add(self->tasks, task);
+
+    self->n_lookups++;
+    self->n_in_flight_max = NM_MAX(self->n_in_flight_max, self->tasks->len);
+}
+
+static GList *
+test_resolver_lookup_by_name_finish(GResolver *resolver, GAsyncResult *result, GError **error)
+{
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+static void
+test_resolver_init(TestResolver *self)
+{
+    self->tasks = g_ptr_array_new_with_free_func(g_object_unref);
+}
+
+static void
+test_resolver_finalize(GObject *object)
+{
+    TestResolver *self = (TestResolver *) object;
+
+    g_assert_cmpint(self->tasks->len, ==, 0);
+    g_ptr_array_unref(self->tasks);
+
+    G_OBJECT_CLASS(test_resolver_parent_class)->finalize(object);
+}
+
+static void
+test_resolver_class_init(TestResolverClass *klass)
+{
+    GObjectClass *  object_class   = G_OBJECT_CLASS(klass);
+    GResolverClass *resolver_class = G_RESOLVER_CLASS(klass);
+
+    object_class->finalize                = test_resolver_finalize;
+    resolver_class->lookup_by_name_async  = test_resolver_lookup_by_name_async;
+    resolver_class->lookup_by_name_finish = test_resolver_lookup_by_name_finish;
+}
+
+/* completes all pending lookups. Names starting with "fail" are not found. */
+static void
+_test_resolver_complete_all(TestResolver *self)
+{
+    gs_unref_ptrarray GPtrArray *tasks = NULL;
+    guint                        i;
+
+    tasks       = g_steal_pointer(&self->tasks);
+    self->tasks = g_ptr_array_new_with_free_func(g_object_unref);
+
+    for (i = 0; i < tasks->len; i++) {
+        GTask *     task = tasks->pdata[i];
+        const char *host = g_task_get_task_data(task);
+
+        if (g_str_has_prefix(host, "fail")) {
+            g_task_return_new_error(task,
+                                    G_RESOLVER_ERROR,
+                                    G_RESOLVER_ERROR_NOT_FOUND,
+                                    "no such host %s",
+                                    host);
+        } else {
+            g_task_return_pointer(task,
+                                  g_list_prepend(NULL, g_inet_address_new_from_string("192.0.2.1")),
+                                  (GDestroyNotify) g_resolver_free_addresses);
+        }
+    }
+}
+
+typedef struct {
+    guint    n_done;
+    guint    n_errors;
+    guint    n_waves;
+    gboolean report_changed;
+} ResolveQueueData;
+
+static gboolean
+_resolve_queue_cb(const GList *addresses, GError *error, gpointer user_data)
+{
+    ResolveQueueData *data = user_data;
+
+    g_assert((!addresses) != (!error));
+
+    data->n_done++;
+    if (error)
+        data->n_errors++;
+    return data->report_changed;
+}
+
+static void
+_resolve_queue_done_cb(gpointer user_data)
+{
+    ResolveQueueData *data = user_data;
+
+    data->n_waves++;
+}
+
+static void
+_resolve_queue_run(TestResolver *resolver, ResolveQueueData *data, guint n_done)
+{
+    while (data->n_done < n_done) {
+        nmtst_main_context_iterate_until_assert(NULL,
+                                                2000,
+                                                resolver->tasks->len > 0 || data->n_done >= n_done);
+        _test_resolver_complete_all(resolver);
+    }
+    g_assert_cmpint(data->n_done, ==, n_done);
+
+    /* give the queue a chance to notify (or wrongly notify again). */
+    nmtst_main_context_iterate_until(NULL, 50, FALSE);
+}
+
+static void
+test_device_resolve_queue(void)
+{
+    gs_unref_object GResolver *   resolver_old = NULL;
+    gs_unref_object TestResolver *resolver     = NULL;
+    NMDeviceResolveQueue *        queue;
+    NMDeviceResolveQueue *        queue2;
+    NMDeviceResolveQueueRequest * requests[6];
+    ResolveQueueData              data = {
+        .report_changed = TRUE,
+    };
+    guint i;
+
+    resolver_old = g_resolver_get_default();
+    resolver     = g_object_new(test_resolver_get_type(), NULL);
+    g_resolver_set_default(G_RESOLVER(resolver));
+
+    queue = nm_device_resolve_queue_new(4, 500, _resolve_queue_done_cb, &data);
+
+    /* the lookups are bounded, and all results are reported at once. */
+    for (i = 0; i < 10; i++) {
+        char host[100];
+
+        nm_sprintf_buf(host, "host%u.example.com", i);
+        nm_device_resolve_queue_add(queue, host, _resolve_queue_cb, &data);
+    }
+    g_assert_cmpint(resolver->n_lookups, ==, 0);
+    _resolve_queue_run(resolver, &data, 10);
+    g_assert_cmpint(resolver->n_lookups, ==, 10);
+    g_assert_cmpint(resolver->n_in_flight_max, ==, 4);
+    g_assert_cmpint(data.n_errors, ==, 0);
+    g_assert_cmpint(data.n_waves, ==, 1);
+
+    /* the cached results are used. Without a change, there is no notification. */
+    data.report_changed = FALSE;
+    nm_device_resolve_queue_add(queue, "host0.example.com", _resolve_queue_cb, &data);
+    nm_device_resolve_queue_add(queue, "host1.example.com", _resolve_queue_cb, &data);
+    _resolve_queue_run(resolver, &data, 12);
+    g_assert_cmpint(resolver->n_lookups, ==, 10);
+    g_assert_cmpint(data.n_waves, ==, 1);
+
+    /* other queues use the same cache. */
+    queue2 = nm_device_resolve_queue_new(1, 500, _resolve_queue_done_cb, &data);
+    nm_device_resolve_queue_add(queue2, "host3.example.com", _resolve_queue_cb, &data);
+    _resolve_queue_run(resolver, &data, 13);
+    g_assert_cmpint(resolver->n_lookups, ==, 10);
+    g_assert_cmpint(data.n_waves, ==, 1);
+    nm_device_resolve_queue_free(queue2);
+
+    /* failures are not cached. */
+    data.report_changed = TRUE;
+    nm_device_resolve_queue_add(queue, "fail.example.com", _resolve_queue_cb, &data);
+    nm_device_resolve_queue_add(queue, "host2.example.com", _resolve_queue_cb, &data);
+    _resolve_queue_run(resolver, &data, 15);
+    nm_device_resolve_queue_add(queue, "fail.example.com", _resolve_queue_cb, &data);
+    _resolve_queue_run(resolver, &data, 16);
+    g_assert_cmpint(resolver->n_lookups, ==, 12);
+    g_assert_cmpint(data.n_errors, ==, 2);
+    g_assert_cmpint(data.n_waves, ==, 3);
+
+    /* after the lifetime, cache entries expire. */
+    g_usleep(600 * 1000);
+    nm_device_resolve_queue_add(queue, "host0.example.com", _resolve_queue_cb, &data);
+    _resolve_queue_run(resolver, &data, 17);
+    g_assert_cmpint(resolver->n_lookups, ==, 13);
+    g_assert_cmpint(data.n_waves, ==, 4);
+
+    /* cancelled requests don't invoke the callback. A cancelled lookup keeps
+     * its slot, until the resolver completes it. */
+    resolver->n_in_flight_max = 0;
+    for (i = 0; i < G_N_ELEMENTS(requests); i++) {
+        char host[100];
+
+        nm_sprintf_buf(host, "cancel%u.example.com", i);
+        requests[i] = nm_device_resolve_queue_add(queue, host, _resolve_queue_cb, &data);
+    }
+    nmtst_main_context_iterate_until_assert(NULL, 2000, resolver->tasks->len == 4);
+    nm_device_resolve_queue_cancel(requests[0]);
+    nm_device_resolve_queue_cancel(requests[5]);
+    nmtst_main_context_iterate_until(NULL, 50, FALSE);
+    g_assert_cmpint(resolver->tasks->len, ==, 4);
+    _resolve_queue_run(resolver, &data, 21);
+    g_assert_cmpint(resolver->n_lookups, ==, 18);
+    g_assert_cmpint(resolver->n_in_flight_max, ==, 4);
+    g_assert_cmpint(data.n_waves, ==, 5);
+
+    /* destroying the queue cancels the lookups in flight. */
+    nm_device_resolve_queue_add(queue, "destroy.example.com", _resolve_queue_cb, &data);
+    nmtst_main_context_iterate_until_assert(NULL, 2000, resolver->tasks->len == 1);
+    nm_device_resolve_queue_free(queue);
+    _test_resolver_complete_all(resolver);
+    nmtst_main_context_iterate_until(NULL, 50, FALSE);
+    g_assert_cmpint(data.n_done, ==, 21);
+    g_assert_cmpint(data.n_waves, ==, 5);
+
+    g_resolver_set_default(resolver_old);
+}
+
+/*****************************************************************************/
+
+static void
+test_checkpoint_rollback_result(void)
+{
+    const NMCheckpointRollbackDevice devices[] = {
+        {
+            .dev_path      = "/org/freedesktop/NetworkManager/Devices/1",
+            .duration_usec = 1500,
+            .result        = NM_ROLLBACK_RESULT_OK,
+            .changed       = FALSE,
+        },
+        {
+            .dev_path      = "/org/freedesktop/NetworkManager/Devices/2",
+            .duration_usec = 42000,
+            .result        = NM_ROLLBACK_RESULT_ERR_FAILED,
+            .changed       = TRUE,
+        },
+    };
+    gs_unref_variant GVariant *result      = NULL;
+    gs_unref_variant GVariant *v_devices   = NULL;
+    gs_unref_variant GVariant *v_changed   = NULL;
+    gs_unref_variant GVariant *v_durations = NULL;
+    gs_free const char **      changed     = NULL;
+    guint32                    u32;
+    guint64                    u64;
+
+    result = nm_checkpoint_rollback_result_new(devices, G_N_ELEMENTS(devices), 43700);
+    g_assert(result);
+    g_assert(!g_variant_is_floating(result));
+    g_assert(g_variant_is_of_type(result, G_VARIANT_TYPE_VARDICT));
+    g_assert_cmpint(g_variant_n_children(result), ==, 4);
+
+    v_devices = g_variant_lookup_value(result, "devices", G_VARIANT_TYPE("a{su}"));
+    g_assert(v_devices);
+    g_assert_cmpint(g_variant_n_children(v_devices), ==, 2);
+    g_assert(g_variant_lookup(v_devices, devices[0].dev_path, "u", &u32));
+    g_assert_cmpint(u32, ==, NM_ROLLBACK_RESULT_OK);
+    g_assert(g_variant_lookup(v_devices, devices[1].dev_path, "u", &u32));
+    g_assert_cmpint(u32, ==, NM_ROLLBACK_RESULT_ERR_FAILED);
+
+    v_changed = g_variant_lookup_value(result, "devices-changed", G_VARIANT_TYPE("as"));
+    g_assert(v_changed);
+    changed = g_variant_get_strv(v_changed, NULL);
+    g_assert_cmpint(NM_PTRARRAY_LEN(changed), ==, 1);
+    g_assert_cmpstr(changed[0], ==, devices[1].dev_path);
+
+    v_durations = g_variant_lookup_value(result, "device-durations-usec", G_VARIANT_TYPE("a{st}"));
+    g_assert(v_durations);
+    g_assert_cmpint(g_variant_n_children(v_durations), ==, 2);
+    g_assert(g_variant_lookup(v_durations, devices[0].dev_path, "t", &u64));
+    g_assert_cmpint(u64, ==, 1500);
+    g_assert(g_variant_lookup(v_durations, devices[1].dev_path, "t", &u64));
+    g_assert_cmpint(u64, ==, 42000);
+
+    g_assert(g_variant_lookup(result, "duration-usec", "t", &u64));
+    g_assert_cmpint(u64, ==, 43700);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2656,6 +3033,11 @@ main(int argc, char **argv)
     g_test_add_func("/core/general/test_connectivity_state_cmp", test_connectivity_state_cmp);
     g_test_add_func("/core/general/test_kernel_cmdline_match_check",
                     test_kernel_cmdline_match_check);
+    g_test_add_func("/core/general/test_device_activation_timing",
+                    test_device_activation_timing);
+    g_test_add_func("/core/general/test_device_resolve_queue", test_device_resolve_queue);
+    g_test_add_func("/core/general/test_checkpoint_rollback_result",
+                    test_checkpoint_rollback_result);
 
     return g_test_run();
 }
@@ -61,7 +61,8 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMDevice,
                              PROP_IP4_CONNECTIVITY,
                              PROP_IP6_CONNECTIVITY,
                              PROP_INTERFACE_FLAGS,
-                             PROP_HW_ADDRESS, );
+                             PROP_HW_ADDRESS,
+                             PROP_ACTIVATION_TIMING, );
 
 enum {
     STATE_CHANGED,
@@ -84,6 +85,7 @@ typedef struct _NMDevicePrivate {
     NMLDBusPropertyO  property_o[_PROPERTY_O_IDX_NUM];
     NMLDBusPropertyAO available_connections;
     GPtrArray *       lldp_neighbors;
+    GVariant *        activation_timing;
     char *            driver;
     char *            driver_version;
     char *            hw_address;
@@ -266,6 +268,21 @@ _notify_update_prop_lldp_neighbors(NMClient *              client,
     return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
 }
 
+static NMLDBusNotifyUpdatePropFlags
+_notify_update_prop_activation_timing(NMClient *              client,
+                                      NMLDBusObject *         dbobj,
+                                      const NMLDBusMetaIface *meta_iface,
+                                      guint                   dbus_property_idx,
+                                      GVariant *              value)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(dbobj->nmobj);
+
+    nm_clear_pointer(&priv->activation_timing, g_variant_unref);
+    if (value)
+        priv->activation_timing = g_variant_ref(value);
+    return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+}
+
 /*****************************************************************************/
 
 static NMDeviceType
@@ -331,6 +348,7 @@ finalize(GObject *object)
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(object);
 
     nm_clear_pointer(&priv->lldp_neighbors, g_ptr_array_unref);
+    nm_clear_pointer(&priv->activation_timing, g_variant_unref);
 
     g_free(priv->interface);
     g_free(priv->ip_interface);
@@ -457,6 +475,9 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     case PROP_HW_ADDRESS:
         g_value_set_string(value, nm_device_get_hw_address(device));
         break;
+    case PROP_ACTIVATION_TIMING:
+        g_value_set_variant(value, nm_device_get_activation_timing(device));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -496,6 +517,10 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
     nm_device_get_type,
     NML_DBUS_META_INTERFACE_PRIO_PARENT_TYPE,
     NML_DBUS_META_IFACE_DBUS_PROPERTIES(
+        NML_DBUS_META_PROPERTY_INIT_FCN("ActivationTiming",
+                                        PROP_ACTIVATION_TIMING,
+                                        "a(st)",
+                                        _notify_update_prop_activation_timing),
         NML_DBUS_META_PROPERTY_INIT_O_PROP("ActiveConnection",
                                            PROP_ACTIVE_CONNECTION,
                                            NMDevicePrivate,
@@ -1034,6 +1059,22 @@ nm_device_class_init(NMDeviceClass *klass)
                             NULL,
                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+    /**
+     * NMDevice:activation-timing:
+     *
+     * The timeline of the last activation, as a #GVariant of type "a(st)".
+     * See nm_device_get_activation_timing().
+     *
+     * Since: 1.34
+     **/
+    obj_properties[PROP_ACTIVATION_TIMING] =
+        g_param_spec_variant(NM_DEVICE_ACTIVATION_TIMING,
+                             "",
+                             "",
+                             G_VARIANT_TYPE("a(st)"),
+                             NULL,
+                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
     _nml_dbus_meta_class_init_with_properties(object_class, &_nml_dbus_meta_iface_nm_device);
 
     /**
@@ -1580,6 +1621,28 @@ nm_device_get_interface_flags(NMDevice *device)
     return NM_DEVICE_GET_PRIVATE(device)->interface_flags;
 }
 
+/**
+ * nm_device_get_activation_timing:
+ * @device: a #NMDevice
+ *
+ * Gets the timeline of the last activation of the device. That is an array
+ * of tuples, with the name of a step (a device state like "prepare" or a
+ * sub-stage like "dhcp4-bound") and the CLOCK_BOOTTIME timestamp in
+ * microseconds when the step was reached.
+ *
+ * Returns: (transfer none) (nullable): a #GVariant of type "a(st)" or %NULL
+ *   if the timeline is not known.
+ *
+ * Since: 1.34
+ **/
+GVariant *
+nm_device_get_activation_timing(NMDevice *device)
+{
+    g_return_val_if_fail(NM_IS_DEVICE(device), NULL);
+
+    return NM_DEVICE_GET_PRIVATE(device)->activation_timing;
+}
+
 /**
  * nm_device_get_state:
  * @device: a #NMDevice
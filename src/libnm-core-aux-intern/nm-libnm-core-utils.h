@@ -33,6 +33,9 @@ NM_AUTO_DEFINE_FCN0(NMSriovVF *, _nm_auto_unref_sriov_vf, nm_sriov_vf_unref);
 #define nm_auto_unref_tc_qdisc nm_auto(_nm_auto_unref_tc_qdisc)
 NM_AUTO_DEFINE_FCN0(NMTCQdisc *, _nm_auto_unref_tc_qdisc, nm_tc_qdisc_unref);
 
+#define nm_auto_unref_tc_tclass nm_auto(_nm_auto_unref_tc_tclass)
+NM_AUTO_DEFINE_FCN0(NMTCTclass *, _nm_auto_unref_tc_tclass, nm_tc_tclass_unref);
+
 #define nm_auto_unref_tc_tfilter nm_auto(_nm_auto_unref_tc_tfilter)
 NM_AUTO_DEFINE_FCN0(NMTCTfilter *, _nm_auto_unref_tc_tfilter, nm_tc_tfilter_unref);
 
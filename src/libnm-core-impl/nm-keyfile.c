@@ -1976,6 +1976,53 @@ qdisc_parser(KeyfileReaderInfo *info, NMSetting *setting, const char *key)
         g_object_set(setting, key, qdiscs, NULL);
 }
 
+static void
+tclass_parser(KeyfileReaderInfo *info, NMSetting *setting, const char *key)
+{
+    const char *      setting_name        = nm_setting_get_name(setting);
+    gs_unref_ptrarray GPtrArray *tclasses = NULL;
+    gs_strfreev char **          keys     = NULL;
+    gsize                        n_keys   = 0;
+    int                          i;
+
+    keys = nm_keyfile_plugin_kf_get_keys(info->keyfile, setting_name, &n_keys, NULL);
+    if (n_keys == 0)
+        return;
+
+    tclasses = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_tclass_unref);
+
+    for (i = 0; i < n_keys; i++) {
+        NMTCTclass *  tclass;
+        const char *  tclass_classid;
+        gs_free char *tclass_rest = NULL;
+        gs_free char *tclass_str  = NULL;
+        gs_free_error GError *err = NULL;
+
+        if (!g_str_has_prefix(keys[i], "tclass."))
+            continue;
+
+        tclass_classid = keys[i] + sizeof("tclass.") - 1;
+        tclass_rest =
+            nm_keyfile_plugin_kf_get_string(info->keyfile, setting_name, keys[i], NULL);
+        tclass_str = g_strdup_printf("classid %s %s", tclass_classid, tclass_rest);
+
+        tclass = nm_utils_tc_tclass_from_str(tclass_str, &err);
+        if (!tclass) {
+            handle_warn(info,
+                        keys[i],
+                        key,
+                        NM_KEYFILE_WARN_SEVERITY_WARN,
+                        _("invalid tclass: %s"),
+                        err->message);
+        } else {
+            g_ptr_array_add(tclasses, tclass);
+        }
+    }
+
+    if (tclasses->len >= 1)
+        g_object_set(setting, key, tclasses, NULL);
+}
+
 static void
 tfilter_parser(KeyfileReaderInfo *info, NMSetting *setting, const char *key)
 {
@@ -2140,6 +2187,9 @@ write_ip_values(GKeyFile *  file,
         guint32                  plen;
         char                     key_name[64];
         char *                   key_name_idx;
+        NMIPAddr                 addr_bin;
+        char                     addr_str[NM_UTILS_INET_ADDRSTRLEN];
+        char                     gw_str[NM_UTILS_INET_ADDRSTRLEN];
 
         addr_family =
             nm_streq(setting_name, NM_SETTING_IP4_CONFIG_SETTING_NAME) ? AF_INET : AF_INET6;
@@ -2153,14 +2203,18 @@ write_ip_values(GKeyFile *  file,
             if (is_route) {
                 NMIPRoute *route = array->pdata[i];
 
-                addr   = nm_ip_route_get_dest(route);
+                nm_ip_route_get_dest_binary(route, &addr_bin);
+                addr   = nm_utils_inet_ntop(addr_family, &addr_bin, addr_str);
                 plen   = nm_ip_route_get_prefix(route);
-                gw     = nm_ip_route_get_next_hop(route);
                 metric = nm_ip_route_get_metric(route);
+                gw     = NULL;
+                if (nm_ip_route_get_next_hop_binary(route, &addr_bin))
+                    gw = nm_utils_inet_ntop(addr_family, &addr_bin, gw_str);
             } else {
                 NMIPAddress *address = array->pdata[i];
 
-                addr = nm_ip_address_get_address(address);
+                nm_ip_address_get_address_binary(address, &addr_bin);
+                addr = nm_utils_inet_ntop(addr_family, &addr_bin, addr_str);
                 plen = nm_ip_address_get_prefix(address);
                 gw   = (i == 0) ? gateway : NULL;
             }
@@ -2195,10 +2249,7 @@ write_ip_values(GKeyFile *  file,
             if (is_route) {
                 gs_free char *attributes = NULL;
 
-                attributes =
-                    nm_utils_format_variant_attributes(_nm_ip_route_get_attributes(array->pdata[i]),
-                                                       ',',
-                                                       '=');
+                attributes = _nm_ip_route_format_attributes(array->pdata[i], ',', '=');
                 if (attributes) {
                     g_strlcat(key_name, "_options", sizeof(key_name));
                     nm_keyfile_plugin_kf_set_string(file, setting_name, key_name, attributes);
@@ -2378,6 +2429,35 @@ qdisc_writer(KeyfileWriterInfo *info, NMSetting *setting, const char *key, const
     }
 }
 
+static void
+tclass_writer(KeyfileWriterInfo *info, NMSetting *setting, const char *key, const GValue *value)
+{
+    nm_auto_free_gstring GString *key_name  = NULL;
+    nm_auto_free_gstring GString *value_str = NULL;
+    GPtrArray *                   array;
+    guint                         i;
+
+    array = g_value_get_boxed(value);
+    if (!array || !array->len)
+        return;
+
+    for (i = 0; i < array->len; i++) {
+        NMTCTclass *tclass = array->pdata[i];
+        guint32     handle = nm_tc_tclass_get_handle(tclass);
+
+        nm_gstring_prepare(&key_name);
+        nm_gstring_prepare(&value_str);
+
+        g_string_append_printf(key_name, "tclass.%x:%x", TC_H_MAJ(handle) >> 16, TC_H_MIN(handle));
+        _nm_utils_string_append_tc_tclass_rest(value_str, tclass);
+
+        nm_keyfile_plugin_kf_set_string(info->keyfile,
+                                        NM_SETTING_TC_CONFIG_SETTING_NAME,
+                                        key_name->str,
+                                        value_str->str);
+    }
+}
+
 static void
 tfilter_writer(KeyfileWriterInfo *info, NMSetting *setting, const char *key, const GValue *value)
 {
@@ -2922,6 +3002,10 @@ static const ParseInfoSetting *const parse_infos[_NM_META_SETTING_TYPE_NUM] = {
                                                                  .parser_no_check_key = TRUE,
                                                                  .parser = qdisc_parser,
                                                                  .writer = qdisc_writer, ),
+                                             PARSE_INFO_PROPERTY(NM_SETTING_TC_CONFIG_TCLASSES,
+                                                                 .parser_no_check_key = TRUE,
+                                                                 .parser = tclass_parser,
+                                                                 .writer = tclass_writer, ),
                                              PARSE_INFO_PROPERTY(NM_SETTING_TC_CONFIG_TFILTERS,
                                                                  .parser_no_check_key = TRUE,
                                                                  .parser = tfilter_parser,
@@ -12,6 +12,7 @@
 #include <linux/fib_rules.h>
 
 #include "libnm-base/nm-net-aux.h"
+#include "libnm-glib-aux/nm-ref-string.h"
 #include "libnm-glib-aux/nm-str-buf.h"
 #include "nm-setting-ip4-config.h"
 #include "nm-setting-ip6-config.h"
@@ -81,29 +82,8 @@ canonicalize_ip(int family, const char *ip, gboolean null_any)
     return g_strdup(inet_ntop(family, addr_bytes, addr_str, sizeof(addr_str)));
 }
 
-static char *
-canonicalize_ip_binary(int family, gconstpointer ip, gboolean null_any)
-{
-    char string[NM_UTILS_INET_ADDRSTRLEN];
-
-    if (!ip) {
-        if (null_any)
-            return NULL;
-        if (family == AF_INET)
-            return g_strdup("0.0.0.0");
-        if (family == AF_INET6)
-            return g_strdup("::");
-        g_return_val_if_reached(NULL);
-    }
-    if (null_any) {
-        if (!memcmp(ip, &in6addr_any, nm_utils_addr_family_to_size(family)))
-            return NULL;
-    }
-    return g_strdup(inet_ntop(family, ip, string, sizeof(string)));
-}
-
 static gboolean
-valid_ip(int family, const char *ip, GError **error)
+valid_ip(int family, const char *ip, NMIPAddr *out_addr, GError **error)
 {
     if (!ip) {
         g_set_error(error,
@@ -112,7 +92,7 @@ valid_ip(int family, const char *ip, GError **error)
                     family == AF_INET ? _("Missing IPv4 address") : _("Missing IPv6 address"));
         return FALSE;
     }
-    if (!nm_utils_ipaddr_is_valid(family, ip)) {
+    if (!nm_utils_parse_inaddr_bin(family, ip, NULL, out_addr)) {
         g_set_error(error,
                     NM_CONNECTION_ERROR,
                     NM_CONNECTION_ERROR_FAILED,
@@ -160,6 +140,195 @@ valid_metric(gint64 metric, GError **error)
     return TRUE;
 }
 
+/*****************************************************************************
+ * Attributes of NMIPAddress and NMIPRoute
+ *****************************************************************************/
+
+/* The attributes of NMIPAddress and NMIPRoute are kept in an exactly sized array,
+ * sorted by name. Objects commonly have no or only a handful of attributes (like
+ * "table", "src", "mtu" or "onlink"), where a binary search over a small array
+ * is cheaper and much smaller than a GHashTable per object.
+ *
+ * The names are interned NMRefString instances. Thus, the same attribute name is
+ * shared between all objects, and names can be compared by pointer. */
+typedef struct {
+    NMUtilsNamedValue *arr;
+    guint              len;
+} IPAttrs;
+
+static void
+_ip_attrs_clear(IPAttrs *attrs)
+{
+    guint i;
+
+    for (i = 0; i < attrs->len; i++) {
+        nm_ref_string_unref(NM_REF_STRING_UPCAST(attrs->arr[i].name));
+        g_variant_unref(attrs->arr[i].value_ptr);
+    }
+    nm_clear_g_free(&attrs->arr);
+    attrs->len = 0;
+}
+
+static gboolean
+_ip_attrs_find(const IPAttrs *attrs, const char *name, guint *out_idx)
+{
+    guint lo = 0;
+    guint hi = attrs->len;
+
+    while (lo < hi) {
+        guint mid = lo + ((hi - lo) / 2u);
+        int   c   = strcmp(attrs->arr[mid].name, name);
+
+        if (c == 0) {
+            *out_idx = mid;
+            return TRUE;
+        }
+        if (c < 0)
+            lo = mid + 1u;
+        else
+            hi = mid;
+    }
+
+    *out_idx = lo;
+    return FALSE;
+}
+
+static GVariant *
+_ip_attrs_get(const IPAttrs *attrs, const char *name)
+{
+    guint idx;
+
+    if (!_ip_attrs_find(attrs, name, &idx))
+        return NULL;
+    return attrs->arr[idx].value_ptr;
+}
+
+static void
+_ip_attrs_set(IPAttrs *attrs, const char *name, GVariant *value)
+{
+    guint idx;
+
+    if (_ip_attrs_find(attrs, name, &idx)) {
+        GVariant *old = attrs->arr[idx].value_ptr;
+
+        if (value) {
+            attrs->arr[idx].value_ptr = g_variant_ref_sink(value);
+            g_variant_unref(old);
+            return;
+        }
+
+        nm_ref_string_unref(NM_REF_STRING_UPCAST(attrs->arr[idx].name));
+        g_variant_unref(old);
+        attrs->len--;
+        if (attrs->len == 0) {
+            nm_clear_g_free(&attrs->arr);
+            return;
+        }
+        memmove(&attrs->arr[idx],
+                &attrs->arr[idx + 1u],
+                sizeof(NMUtilsNamedValue) * (attrs->len - idx));
+        attrs->arr = g_renew(NMUtilsNamedValue, attrs->arr, attrs->len);
+        return;
+    }
+
+    if (!value)
+        return;
+
+    attrs->arr = g_renew(NMUtilsNamedValue, attrs->arr, attrs->len + 1u);
+    memmove(&attrs->arr[idx + 1u],
+            &attrs->arr[idx],
+            sizeof(NMUtilsNamedValue) * (attrs->len - idx));
+    attrs->arr[idx] = (NMUtilsNamedValue){
+        .name      = nm_ref_string_new(name)->str,
+        .value_ptr = g_variant_ref_sink(value),
+    };
+    attrs->len++;
+}
+
+static void
+_ip_attrs_copy(IPAttrs *dst, const IPAttrs *src)
+{
+    guint i;
+
+    nm_assert(dst->len == 0);
+
+    if (src->len == 0)
+        return;
+
+    dst->arr = nm_memdup(src->arr, sizeof(NMUtilsNamedValue) * src->len);
+    dst->len = src->len;
+    for (i = 0; i < dst->len; i++) {
+        nm_ref_string_ref(NM_REF_STRING_UPCAST(dst->arr[i].name));
+        g_variant_ref(dst->arr[i].value_ptr);
+    }
+}
+
+static gboolean
+_ip_attrs_equal(const IPAttrs *a, const IPAttrs *b)
+{
+    guint i;
+
+    if (a->len != b->len)
+        return FALSE;
+
+    for (i = 0; i < a->len; i++) {
+        /* Names are interned, so they can be compared by pointer. Note that
+         * we cannot really compare GVariants with a total order, so only check
+         * for equality. */
+        if (a->arr[i].name != b->arr[i].name)
+            return FALSE;
+        if (!g_variant_equal(a->arr[i].value_ptr, b->arr[i].value_ptr))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static const char **
+_ip_attrs_get_names(const IPAttrs *attrs, guint *out_length)
+{
+    const char **names;
+    guint        i;
+
+    /* by convention, we never return an empty array. In that
+     * case, always %NULL. */
+    if (attrs->len == 0) {
+        NM_SET_OUT(out_length, 0);
+        return NULL;
+    }
+
+    names = g_new(const char *, attrs->len + 1u);
+    for (i = 0; i < attrs->len; i++)
+        names[i] = attrs->arr[i].name;
+    names[i] = NULL;
+
+    NM_SET_OUT(out_length, attrs->len);
+    return names;
+}
+
+/*****************************************************************************/
+
+/* Returns the string representation of @addr, which is cached in @p_str.
+ *
+ * The getters that call this take a shared object and only read it. Several
+ * threads may do so at the same time, so the cached string is published
+ * atomically. The thread that loses the race frees its own string. */
+static const char *
+_ip_addr_str_cached(char **p_str, int family, const NMIPAddr *addr)
+{
+    char *str;
+
+    str = g_atomic_pointer_get(p_str);
+    if (G_LIKELY(str))
+        return str;
+
+    str = nm_utils_inet_ntop_dup(family, addr);
+    if (!g_atomic_pointer_compare_and_exchange(p_str, NULL, str)) {
+        g_free(str);
+        str = g_atomic_pointer_get(p_str);
+    }
+    return str;
+}
+
 /*****************************************************************************
  * NMIPAddress
  *****************************************************************************/
@@ -169,12 +338,33 @@ G_DEFINE_BOXED_TYPE(NMIPAddress, nm_ip_address, nm_ip_address_dup, nm_ip_address
 struct NMIPAddress {
     guint refcount;
 
-    char *address;
-    int   prefix, family;
+    guint8 family;
+    guint8 prefix;
 
-    GHashTable *attributes;
+    NMIPAddr address_bin;
+
+    /* The string representation of @address_bin. It is only created on demand
+     * by nm_ip_address_get_address(). */
+    char *address_str;
+
+    IPAttrs attrs;
 };
 
+static NMIPAddress *
+_ip_address_new(int family, const NMIPAddr *addr, guint prefix)
+{
+    NMIPAddress *address;
+
+    address  = g_slice_new(NMIPAddress);
+    *address = (NMIPAddress){
+        .refcount    = 1,
+        .family      = family,
+        .prefix      = prefix,
+        .address_bin = nm_ip_addr_init(family, addr),
+    };
+    return address;
+}
+
 /**
  * nm_ip_address_new:
  * @family: the IP address family (<literal>AF_INET</literal> or
@@ -190,24 +380,17 @@ struct NMIPAddress {
 NMIPAddress *
 nm_ip_address_new(int family, const char *addr, guint prefix, GError **error)
 {
-    NMIPAddress *address;
+    NMIPAddr addr_bin;
 
     g_return_val_if_fail(family == AF_INET || family == AF_INET6, NULL);
     g_return_val_if_fail(addr != NULL, NULL);
 
-    if (!valid_ip(family, addr, error))
+    if (!valid_ip(family, addr, &addr_bin, error))
         return NULL;
     if (!valid_prefix(family, prefix, error))
         return NULL;
 
-    address           = g_slice_new0(NMIPAddress);
-    address->refcount = 1;
-
-    address->family  = family;
-    address->address = canonicalize_ip(family, addr, FALSE);
-    address->prefix  = prefix;
-
-    return address;
+    return _ip_address_new(family, &addr_bin, prefix);
 }
 
 /**
@@ -226,23 +409,13 @@ nm_ip_address_new(int family, const char *addr, guint prefix, GError **error)
 NMIPAddress *
 nm_ip_address_new_binary(int family, gconstpointer addr, guint prefix, GError **error)
 {
-    NMIPAddress *address;
-    char         string[NM_UTILS_INET_ADDRSTRLEN];
-
     g_return_val_if_fail(family == AF_INET || family == AF_INET6, NULL);
     g_return_val_if_fail(addr != NULL, NULL);
 
     if (!valid_prefix(family, prefix, error))
         return NULL;
 
-    address           = g_slice_new0(NMIPAddress);
-    address->refcount = 1;
-
-    address->family  = family;
-    address->address = g_strdup(inet_ntop(family, addr, string, sizeof(string)));
-    address->prefix  = prefix;
-
-    return address;
+    return _ip_address_new(family, addr, prefix);
 }
 
 /**
@@ -275,9 +448,8 @@ nm_ip_address_unref(NMIPAddress *address)
 
     address->refcount--;
     if (address->refcount == 0) {
-        g_free(address->address);
-        if (address->attributes)
-            g_hash_table_unref(address->attributes);
+        g_free(address->address_str);
+        _ip_attrs_clear(&address->attrs);
         g_slice_free(NMIPAddress, address);
     }
 }
@@ -307,35 +479,29 @@ nm_ip_address_cmp_full(const NMIPAddress *a, const NMIPAddress *b, NMIPAddressCm
 
     NM_CMP_FIELD(a, b, family);
     NM_CMP_FIELD(a, b, prefix);
-    NM_CMP_FIELD_STR(a, b, address);
+
+    if (!nm_ip_addr_equal(a->family, &a->address_bin, &b->address_bin)) {
+        char sbuf_a[NM_UTILS_INET_ADDRSTRLEN];
+        char sbuf_b[NM_UTILS_INET_ADDRSTRLEN];
+
+        /* Historically, the addresses were sorted by their string representation.
+         * Keep that order. */
+        NM_CMP_DIRECT_STRCMP(nm_utils_inet_ntop(a->family, &a->address_bin, sbuf_a),
+                             nm_utils_inet_ntop(b->family, &b->address_bin, sbuf_b));
+    }
 
     if (NM_FLAGS_HAS(cmp_flags, NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS)) {
-        GHashTableIter iter;
-        const char *   key;
-        GVariant *     value, *value2;
-        guint          n;
-
-        n = a->attributes ? g_hash_table_size(a->attributes) : 0u;
-        NM_CMP_DIRECT(n, (b->attributes ? g_hash_table_size(b->attributes) : 0u));
-
-        if (n > 0) {
-            g_hash_table_iter_init(&iter, a->attributes);
-            while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value)) {
-                value2 = g_hash_table_lookup(b->attributes, key);
-                /* We cannot really compare GVariants, because g_variant_compare() does
-                 * not work in general. So, don't bother. NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS is
-                 * documented to not provide a total order for the attribute contents.
-                 *
-                 * Theoretically, we can implement also a total order. However we should
-                 * not do that by default because it would require us to sort the keys
-                 * first. Most callers don't care about total order, so they shouldn't
-                 * pay the overhead. */
-                if (!value2)
-                    return -2;
-                if (!g_variant_equal(value, value2))
-                    return -2;
-            }
-        }
+        NM_CMP_DIRECT(a->attrs.len, b->attrs.len);
+
+        /* We cannot really compare GVariants, because g_variant_compare() does
+         * not work in general. So, don't bother. NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS is
+         * documented to not provide a total order for the attribute contents.
+         *
+         * Theoretically, we can implement also a total order. However, most
+         * callers don't care about total order, so they shouldn't pay the
+         * overhead. */
+        if (!_ip_attrs_equal(&a->attrs, &b->attrs))
+            return -2;
     }
 
     return 0;
@@ -379,17 +545,8 @@ nm_ip_address_dup(NMIPAddress *address)
     g_return_val_if_fail(address != NULL, NULL);
     g_return_val_if_fail(address->refcount > 0, NULL);
 
-    copy = nm_ip_address_new(address->family, address->address, address->prefix, NULL);
-    if (address->attributes) {
-        GHashTableIter iter;
-        const char *   key;
-        GVariant *     value;
-
-        g_hash_table_iter_init(&iter, address->attributes);
-        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
-            nm_ip_address_set_attribute(copy, key, value);
-    }
-
+    copy = _ip_address_new(address->family, &address->address_bin, address->prefix);
+    _ip_attrs_copy(&copy->attrs, &address->attrs);
     return copy;
 }
 
@@ -425,7 +582,7 @@ nm_ip_address_get_address(NMIPAddress *address)
     g_return_val_if_fail(address != NULL, NULL);
     g_return_val_if_fail(address->refcount > 0, NULL);
 
-    return address->address;
+    return _ip_addr_str_cached(&address->address_str, address->family, &address->address_bin);
 }
 
 /**
@@ -441,12 +598,13 @@ nm_ip_address_get_address(NMIPAddress *address)
 void
 nm_ip_address_set_address(NMIPAddress *address, const char *addr)
 {
+    NMIPAddr addr_bin;
+
     g_return_if_fail(address != NULL);
     g_return_if_fail(addr != NULL);
-    g_return_if_fail(nm_utils_ipaddr_is_valid(address->family, addr));
+    g_return_if_fail(nm_utils_parse_inaddr_bin(address->family, addr, NULL, &addr_bin));
 
-    g_free(address->address);
-    address->address = canonicalize_ip(address->family, addr, FALSE);
+    nm_ip_address_set_address_binary(address, &addr_bin);
 }
 
 /**
@@ -464,7 +622,7 @@ nm_ip_address_get_address_binary(NMIPAddress *address, gpointer addr)
     g_return_if_fail(address != NULL);
     g_return_if_fail(addr != NULL);
 
-    inet_pton(address->family, address->address, addr);
+    nm_ip_addr_set(address->family, addr, &address->address_bin);
 }
 
 /**
@@ -479,13 +637,11 @@ nm_ip_address_get_address_binary(NMIPAddress *address, gpointer addr)
 void
 nm_ip_address_set_address_binary(NMIPAddress *address, gconstpointer addr)
 {
-    char string[NM_UTILS_INET_ADDRSTRLEN];
-
     g_return_if_fail(address != NULL);
     g_return_if_fail(addr != NULL);
 
-    g_free(address->address);
-    address->address = g_strdup(inet_ntop(address->family, addr, string, sizeof(string)));
+    address->address_bin = nm_ip_addr_init(address->family, addr);
+    nm_clear_g_free(&address->address_str);
 }
 
 /**
@@ -527,7 +683,8 @@ _nm_ip_address_get_attribute_names(const NMIPAddress *address, gboolean sorted,
 {
     nm_assert(address);
 
-    return nm_utils_strdict_get_keys(address->attributes, sorted, out_length);
+    /* the attributes are always sorted. */
+    return _ip_attrs_get_names(&address->attrs, out_length);
 }
 
 /**
@@ -565,10 +722,7 @@ nm_ip_address_get_attribute(NMIPAddress *address, const char *name)
     g_return_val_if_fail(address != NULL, NULL);
     g_return_val_if_fail(name != NULL && *name != '\0', NULL);
 
-    if (address->attributes)
-        return g_hash_table_lookup(address->attributes, name);
-    else
-        return NULL;
+    return _ip_attrs_get(&address->attrs, name);
 }
 
 /**
@@ -586,17 +740,7 @@ nm_ip_address_set_attribute(NMIPAddress *address, const char *name, GVariant *va
     g_return_if_fail(name != NULL && *name != '\0');
     g_return_if_fail(strcmp(name, "address") != 0 && strcmp(name, "prefix") != 0);
 
-    if (!address->attributes) {
-        address->attributes = g_hash_table_new_full(nm_str_hash,
-                                                    g_str_equal,
-                                                    g_free,
-                                                    (GDestroyNotify) g_variant_unref);
-    }
-
-    if (value)
-        g_hash_table_insert(address->attributes, g_strdup(name), g_variant_ref_sink(value));
-    else
-        g_hash_table_remove(address->attributes, name);
+    _ip_attrs_set(&address->attrs, name, value);
 }
 
 /*****************************************************************************
@@ -608,15 +752,45 @@ G_DEFINE_BOXED_TYPE(NMIPRoute, nm_ip_route, nm_ip_route_dup, nm_ip_route_unref)
 struct NMIPRoute {
     guint refcount;
 
-    int    family;
-    char * dest;
-    guint  prefix;
-    char * next_hop;
+    guint8 family;
+    guint8 prefix;
+
     gint64 metric;
 
-    GHashTable *attributes;
+    NMIPAddr dest_bin;
+
+    /* An all-zero next hop means that the route has no next hop. */
+    NMIPAddr next_hop_bin;
+
+    /* The string representations of @dest_bin and @next_hop_bin. They are
+     * only created on demand by the string getters. */
+    char *dest_str;
+    char *next_hop_str;
+
+    IPAttrs attrs;
 };
 
+static NMIPRoute *
+_ip_route_new(int             family,
+              const NMIPAddr *dest,
+              guint           prefix,
+              gconstpointer   next_hop,
+              gint64          metric)
+{
+    NMIPRoute *route;
+
+    route  = g_slice_new(NMIPRoute);
+    *route = (NMIPRoute){
+        .refcount     = 1,
+        .family       = family,
+        .prefix       = prefix,
+        .metric       = metric,
+        .dest_bin     = nm_ip_addr_init(family, dest),
+        .next_hop_bin = next_hop ? nm_ip_addr_init(family, next_hop) : nm_ip_addr_zero,
+    };
+    return route;
+}
+
 /**
  * nm_ip_route_new:
  * @family: the IP address family (<literal>AF_INET</literal> or
@@ -639,30 +813,22 @@ nm_ip_route_new(int         family,
                 gint64      metric,
                 GError **   error)
 {
-    NMIPRoute *route;
+    NMIPAddr dest_bin;
+    NMIPAddr next_hop_bin;
 
     g_return_val_if_fail(family == AF_INET || family == AF_INET6, NULL);
     g_return_val_if_fail(dest, NULL);
 
-    if (!valid_ip(family, dest, error))
+    if (!valid_ip(family, dest, &dest_bin, error))
         return NULL;
     if (!valid_prefix(family, prefix, error))
         return NULL;
-    if (next_hop && !valid_ip(family, next_hop, error))
+    if (next_hop && !valid_ip(family, next_hop, &next_hop_bin, error))
         return NULL;
     if (!valid_metric(metric, error))
         return NULL;
 
-    route           = g_slice_new0(NMIPRoute);
-    route->refcount = 1;
-
-    route->family   = family;
-    route->dest     = canonicalize_ip(family, dest, FALSE);
-    route->prefix   = prefix;
-    route->next_hop = canonicalize_ip(family, next_hop, TRUE);
-    route->metric   = metric;
-
-    return route;
+    return _ip_route_new(family, &dest_bin, prefix, next_hop ? &next_hop_bin : NULL, metric);
 }
 
 /**
@@ -688,8 +854,6 @@ nm_ip_route_new_binary(int           family,
                        gint64        metric,
                        GError **     error)
 {
-    NMIPRoute *route;
-
     g_return_val_if_fail(family == AF_INET || family == AF_INET6, NULL);
     g_return_val_if_fail(dest, NULL);
 
@@ -698,16 +862,7 @@ nm_ip_route_new_binary(int           family,
     if (!valid_metric(metric, error))
         return NULL;
 
-    route           = g_slice_new0(NMIPRoute);
-    route->refcount = 1;
-
-    route->family   = family;
-    route->dest     = canonicalize_ip_binary(family, dest, FALSE);
-    route->prefix   = prefix;
-    route->next_hop = canonicalize_ip_binary(family, next_hop, TRUE);
-    route->metric   = metric;
-
-    return route;
+    return _ip_route_new(family, dest, prefix, next_hop, metric);
 }
 
 /**
@@ -740,10 +895,9 @@ nm_ip_route_unref(NMIPRoute *route)
 
     route->refcount--;
     if (route->refcount == 0) {
-        g_free(route->dest);
-        g_free(route->next_hop);
-        if (route->attributes)
-            g_hash_table_unref(route->attributes);
+        g_free(route->dest_str);
+        g_free(route->next_hop_str);
+        _ip_attrs_clear(&route->attrs);
         g_slice_free(NMIPRoute, route);
     }
 }
@@ -778,28 +932,13 @@ nm_ip_route_equal_full(NMIPRoute *route, NMIPRoute *other, guint cmp_flags)
                          FALSE);
 
     if (route->prefix != other->prefix || route->metric != other->metric
-        || strcmp(route->dest, other->dest) != 0
-        || g_strcmp0(route->next_hop, other->next_hop) != 0)
+        || route->family != other->family
+        || !nm_ip_addr_equal(route->family, &route->dest_bin, &other->dest_bin)
+        || !nm_ip_addr_equal(route->family, &route->next_hop_bin, &other->next_hop_bin))
         return FALSE;
     if (cmp_flags == NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS) {
-        GHashTableIter iter;
-        const char *   key;
-        GVariant *     value, *value2;
-        guint          n;
-
-        n = route->attributes ? g_hash_table_size(route->attributes) : 0u;
-        if (n != (other->attributes ? g_hash_table_size(other->attributes) : 0u))
+        if (!_ip_attrs_equal(&route->attrs, &other->attrs))
             return FALSE;
-        if (n) {
-            g_hash_table_iter_init(&iter, route->attributes);
-            while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value)) {
-                value2 = g_hash_table_lookup(other->attributes, key);
-                if (!value2)
-                    return FALSE;
-                if (!g_variant_equal(value, value2))
-                    return FALSE;
-            }
-        }
     }
     return TRUE;
 }
@@ -842,22 +981,12 @@ nm_ip_route_dup(NMIPRoute *route)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(route->refcount > 0, NULL);
 
-    copy = nm_ip_route_new(route->family,
-                           route->dest,
-                           route->prefix,
-                           route->next_hop,
-                           route->metric,
-                           NULL);
-    if (route->attributes) {
-        GHashTableIter iter;
-        const char *   key;
-        GVariant *     value;
-
-        g_hash_table_iter_init(&iter, route->attributes);
-        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
-            nm_ip_route_set_attribute(copy, key, value);
-    }
-
+    copy = _ip_route_new(route->family,
+                         &route->dest_bin,
+                         route->prefix,
+                         &route->next_hop_bin,
+                         route->metric);
+    _ip_attrs_copy(&copy->attrs, &route->attrs);
     return copy;
 }
 
@@ -893,7 +1022,7 @@ nm_ip_route_get_dest(NMIPRoute *route)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(route->refcount > 0, NULL);
 
-    return route->dest;
+    return _ip_addr_str_cached(&route->dest_str, route->family, &route->dest_bin);
 }
 
 /**
@@ -909,11 +1038,12 @@ nm_ip_route_get_dest(NMIPRoute *route)
 void
 nm_ip_route_set_dest(NMIPRoute *route, const char *dest)
 {
+    NMIPAddr dest_bin;
+
     g_return_if_fail(route != NULL);
-    g_return_if_fail(nm_utils_ipaddr_is_valid(route->family, dest));
+    g_return_if_fail(dest && nm_utils_parse_inaddr_bin(route->family, dest, NULL, &dest_bin));
 
-    g_free(route->dest);
-    route->dest = canonicalize_ip(route->family, dest, FALSE);
+    nm_ip_route_set_dest_binary(route, &dest_bin);
 }
 
 /**
@@ -931,7 +1061,7 @@ nm_ip_route_get_dest_binary(NMIPRoute *route, gpointer dest)
     g_return_if_fail(route != NULL);
     g_return_if_fail(dest != NULL);
 
-    inet_pton(route->family, route->dest, dest);
+    nm_ip_addr_set(route->family, dest, &route->dest_bin);
 }
 
 /**
@@ -946,13 +1076,11 @@ nm_ip_route_get_dest_binary(NMIPRoute *route, gpointer dest)
 void
 nm_ip_route_set_dest_binary(NMIPRoute *route, gconstpointer dest)
 {
-    char string[NM_UTILS_INET_ADDRSTRLEN];
-
     g_return_if_fail(route != NULL);
     g_return_if_fail(dest != NULL);
 
-    g_free(route->dest);
-    route->dest = g_strdup(inet_ntop(route->family, dest, string, sizeof(string)));
+    route->dest_bin = nm_ip_addr_init(route->family, dest);
+    nm_clear_g_free(&route->dest_str);
 }
 
 /**
@@ -1003,7 +1131,10 @@ nm_ip_route_get_next_hop(NMIPRoute *route)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(route->refcount > 0, NULL);
 
-    return route->next_hop;
+    if (nm_ip_addr_is_null(route->family, &route->next_hop_bin))
+        return NULL;
+
+    return _ip_addr_str_cached(&route->next_hop_str, route->family, &route->next_hop_bin);
 }
 
 /**
@@ -1020,11 +1151,13 @@ nm_ip_route_get_next_hop(NMIPRoute *route)
 void
 nm_ip_route_set_next_hop(NMIPRoute *route, const char *next_hop)
 {
+    NMIPAddr next_hop_bin;
+
     g_return_if_fail(route != NULL);
-    g_return_if_fail(!next_hop || nm_utils_ipaddr_is_valid(route->family, next_hop));
+    g_return_if_fail(!next_hop
+                     || nm_utils_parse_inaddr_bin(route->family, next_hop, NULL, &next_hop_bin));
 
-    g_free(route->next_hop);
-    route->next_hop = canonicalize_ip(route->family, next_hop, TRUE);
+    nm_ip_route_set_next_hop_binary(route, next_hop ? &next_hop_bin : NULL);
 }
 
 /**
@@ -1045,13 +1178,8 @@ nm_ip_route_get_next_hop_binary(NMIPRoute *route, gpointer next_hop)
     g_return_val_if_fail(route != NULL, FALSE);
     g_return_val_if_fail(next_hop != NULL, FALSE);
 
-    if (route->next_hop) {
-        inet_pton(route->family, route->next_hop, next_hop);
-        return TRUE;
-    } else {
-        memset(next_hop, 0, nm_utils_addr_family_to_size(route->family));
-        return FALSE;
-    }
+    nm_ip_addr_set(route->family, next_hop, &route->next_hop_bin);
+    return !nm_ip_addr_is_null(route->family, &route->next_hop_bin);
 }
 
 /**
@@ -1069,8 +1197,8 @@ nm_ip_route_set_next_hop_binary(NMIPRoute *route, gconstpointer next_hop)
 {
     g_return_if_fail(route != NULL);
 
-    g_free(route->next_hop);
-    route->next_hop = canonicalize_ip_binary(route->family, next_hop, TRUE);
+    route->next_hop_bin = next_hop ? nm_ip_addr_init(route->family, next_hop) : nm_ip_addr_zero;
+    nm_clear_g_free(&route->next_hop_str);
 }
 
 /**
@@ -1108,12 +1236,39 @@ nm_ip_route_set_metric(NMIPRoute *route, gint64 metric)
     route->metric = metric;
 }
 
-GHashTable *
-_nm_ip_route_get_attributes(NMIPRoute *route)
+/**
+ * _nm_ip_route_format_attributes:
+ * @route: the #NMIPRoute
+ * @attr_separator: the attribute separator character
+ * @key_value_separator: character separating key and values
+ *
+ * Like nm_utils_format_variant_attributes(), but formats the
+ * attributes of @route directly, without first collecting them
+ * in a #GHashTable.
+ *
+ * Returns: (transfer full): the formatted attributes, or %NULL
+ *   if @route has no attributes.
+ **/
+char *
+_nm_ip_route_format_attributes(const NMIPRoute *route,
+                               char             attr_separator,
+                               char             key_value_separator)
 {
+    GString *str;
+
     nm_assert(route);
 
-    return route->attributes;
+    if (route->attrs.len == 0)
+        return NULL;
+
+    str = g_string_new("");
+    _nm_utils_format_variant_attributes_full(str,
+                                             route->attrs.arr,
+                                             route->attrs.len,
+                                             NULL,
+                                             attr_separator,
+                                             key_value_separator);
+    return g_string_free(str, FALSE);
 }
 
 /**
@@ -1134,7 +1289,8 @@ _nm_ip_route_get_attribute_names(const NMIPRoute *route, gboolean sorted, guint
 {
     nm_assert(route);
 
-    return nm_utils_strdict_get_keys(route->attributes, sorted, out_length);
+    /* the attributes are always sorted. */
+    return _ip_attrs_get_names(&route->attrs, out_length);
 }
 
 /**
@@ -1172,10 +1328,7 @@ nm_ip_route_get_attribute(NMIPRoute *route, const char *name)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(name != NULL && *name != '\0', NULL);
 
-    if (route->attributes)
-        return g_hash_table_lookup(route->attributes, name);
-    else
-        return NULL;
+    return _ip_attrs_get(&route->attrs, name);
 }
 
 /**
@@ -1194,17 +1347,7 @@ nm_ip_route_set_attribute(NMIPRoute *route, const char *name, GVariant *value)
     g_return_if_fail(strcmp(name, "dest") != 0 && strcmp(name, "prefix") != 0
                      && strcmp(name, "next-hop") != 0 && strcmp(name, "metric") != 0);
 
-    if (!route->attributes) {
-        route->attributes = g_hash_table_new_full(nm_str_hash,
-                                                  g_str_equal,
-                                                  g_free,
-                                                  (GDestroyNotify) g_variant_unref);
-    }
-
-    if (value)
-        g_hash_table_insert(route->attributes, g_strdup(name), g_variant_ref_sink(value));
-    else
-        g_hash_table_remove(route->attributes, name);
+    _ip_attrs_set(&route->attrs, name, value);
 }
 
 static const NMVariantAttributeSpec *const ip_route_attribute_spec[] = {
@@ -1418,33 +1561,22 @@ nm_ip_route_attribute_validate(const char *name,
 gboolean
 _nm_ip_route_attribute_validate_all(const NMIPRoute *route, GError **error)
 {
-    NMUtilsNamedValue attrs_static[G_N_ELEMENTS(ip_route_attribute_spec)];
-    gs_free NMUtilsNamedValue *attrs_free = NULL;
-    const NMUtilsNamedValue *  attrs;
-    guint                      attrs_len;
-    GVariant *                 val;
-    guint                      i;
-    guint8                     u8;
+    GVariant *val;
+    guint     i;
+    guint8    u8;
 
     g_return_val_if_fail(route, FALSE);
     g_return_val_if_fail(!error || !*error, FALSE);
 
-    if (!route->attributes)
-        return TRUE;
-
-    attrs = nm_utils_named_values_from_strdict(route->attributes,
-                                               &attrs_len,
-                                               attrs_static,
-                                               &attrs_free);
-    for (i = 0; i < attrs_len; i++) {
-        const char *key  = attrs[i].name;
-        GVariant *  val2 = attrs[i].value_ptr;
+    for (i = 0; i < route->attrs.len; i++) {
+        const char *key  = route->attrs.arr[i].name;
+        GVariant *  val2 = route->attrs.arr[i].value_ptr;
 
         if (!nm_ip_route_attribute_validate(key, val2, route->family, NULL, NULL))
             return FALSE;
     }
 
-    if ((val = g_hash_table_lookup(route->attributes, NM_IP_ROUTE_ATTRIBUTE_TYPE))) {
+    if ((val = _ip_attrs_get(&route->attrs, NM_IP_ROUTE_ATTRIBUTE_TYPE))) {
         int v_i;
 
         nm_assert(g_variant_is_of_type(val, G_VARIANT_TYPE_STRING));
@@ -1453,7 +1585,7 @@ _nm_ip_route_attribute_validate_all(const NMIPRoute *route, GError **error)
         nm_assert(v_i >= 0);
 
         if (v_i == RTN_LOCAL && route->family == AF_INET
-            && (val = g_hash_table_lookup(route->attributes, NM_IP_ROUTE_ATTRIBUTE_SCOPE))) {
+            && (val = _ip_attrs_get(&route->attrs, NM_IP_ROUTE_ATTRIBUTE_SCOPE))) {
             nm_assert(g_variant_is_of_type(val, G_VARIANT_TYPE_BYTE));
             u8 = g_variant_get_byte(val);
 
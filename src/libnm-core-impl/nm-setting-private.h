@@ -291,6 +291,38 @@ _nm_setting_property_to_dbus_fcn_get_string(const NMSettInfoSetting *
                                             NMConnectionSerializationFlags          flags,
                                             const NMConnectionSerializationOptions *options);
 
+gboolean _nm_setting_property_compare_fcn_default(const NMSettInfoSetting *sett_info,
+                                                  guint                    property_idx,
+                                                  NMConnection *           con_a,
+                                                  NMSetting *              set_a,
+                                                  NMConnection *           con_b,
+                                                  NMSetting *              set_b,
+                                                  NMSettingCompareFlags    flags);
+
+gboolean _nm_setting_property_compare_fcn_gprop(const NMSettInfoSetting *sett_info,
+                                                guint                    property_idx,
+                                                NMConnection *           con_a,
+                                                NMSetting *              set_a,
+                                                NMConnection *           con_b,
+                                                NMSetting *              set_b,
+                                                NMSettingCompareFlags    flags);
+
+gboolean _nm_setting_property_compare_fcn_get_boolean(const NMSettInfoSetting *sett_info,
+                                                      guint                    property_idx,
+                                                      NMConnection *           con_a,
+                                                      NMSetting *              set_a,
+                                                      NMConnection *           con_b,
+                                                      NMSetting *              set_b,
+                                                      NMSettingCompareFlags    flags);
+
+gboolean _nm_setting_property_compare_fcn_get_string(const NMSettInfoSetting *sett_info,
+                                                     guint                    property_idx,
+                                                     NMConnection *           con_a,
+                                                     NMSetting *              set_a,
+                                                     NMConnection *           con_b,
+                                                     NMSetting *              set_b,
+                                                     NMSettingCompareFlags    flags);
+
 GVariant *_nm_setting_to_dbus(NMSetting *                             setting,
                               NMConnection *                          connection,
                               NMConnectionSerializationFlags          flags,
@@ -353,7 +385,7 @@ _nm_setting_class_commit(NMSettingClass *setting_class, NMMetaSettingType meta_t
 #define NM_SETT_INFO_PROPERT_TYPE_GPROP_INIT(_dbus_type, ...)                           \
     {                                                                                   \
         .dbus_type = _dbus_type, .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_gprop, \
-        __VA_ARGS__                                                                     \
+        .compare_fcn = _nm_setting_property_compare_fcn_gprop, __VA_ARGS__              \
     }
 
 #define NM_SETT_INFO_PROPERT_TYPE(init)               \
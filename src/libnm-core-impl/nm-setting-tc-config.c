@@ -387,6 +387,333 @@ nm_tc_qdisc_set_attribute(NMTCQdisc *qdisc, const char *name, GVariant *value)
 
 /*****************************************************************************/
 
+G_DEFINE_BOXED_TYPE(NMTCTclass, nm_tc_tclass, nm_tc_tclass_dup, nm_tc_tclass_unref)
+
+struct NMTCTclass {
+    guint refcount;
+
+    char *      kind;
+    guint32     handle;
+    guint32     parent;
+    GHashTable *attributes;
+};
+
+/**
+ * nm_tc_tclass_new:
+ * @kind: name of the queueing discipline the class belongs to
+ * @handle: the class handle (class ID)
+ * @parent: the parent queueing discipline or class
+ * @error: location to store error, or %NULL
+ *
+ * Creates a new #NMTCTclass object.
+ *
+ * Returns: (transfer full): the new #NMTCTclass object, or %NULL on error
+ *
+ * Since: 1.34
+ **/
+NMTCTclass *
+nm_tc_tclass_new(const char *kind, guint32 handle, guint32 parent, GError **error)
+{
+    NMTCTclass *tclass;
+
+    if (!kind || !*kind) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("kind is missing"));
+        return NULL;
+    }
+
+    if (strchr(kind, ' ') || strchr(kind, '\t')) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("'%s' is not a valid kind"),
+                    kind);
+        return NULL;
+    }
+
+    if (TC_H_MAJ(handle) == TC_H_UNSPEC || TC_H_MIN(handle) == TC_H_UNSPEC) {
+        g_set_error_literal(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("invalid class handle"));
+        return NULL;
+    }
+
+    if (TC_H_MAJ(parent) != TC_H_MAJ(handle)) {
+        g_set_error_literal(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("parent doesn't belong to the same queueing discipline"));
+        return NULL;
+    }
+
+    tclass           = g_slice_new0(NMTCTclass);
+    tclass->refcount = 1;
+
+    tclass->kind   = g_strdup(kind);
+    tclass->handle = handle;
+    tclass->parent = parent;
+
+    return tclass;
+}
+
+/**
+ * nm_tc_tclass_ref:
+ * @tclass: the #NMTCTclass
+ *
+ * Increases the reference count of the object.
+ *
+ * Since: 1.34
+ **/
+void
+nm_tc_tclass_ref(NMTCTclass *tclass)
+{
+    g_return_if_fail(tclass != NULL);
+    g_return_if_fail(tclass->refcount > 0);
+
+    tclass->refcount++;
+}
+
+/**
+ * nm_tc_tclass_unref:
+ * @tclass: the #NMTCTclass
+ *
+ * Decreases the reference count of the object.  If the reference count
+ * reaches zero, the object will be destroyed.
+ *
+ * Since: 1.34
+ **/
+void
+nm_tc_tclass_unref(NMTCTclass *tclass)
+{
+    g_return_if_fail(tclass != NULL);
+    g_return_if_fail(tclass->refcount > 0);
+
+    tclass->refcount--;
+    if (tclass->refcount == 0) {
+        g_free(tclass->kind);
+        if (tclass->attributes)
+            g_hash_table_unref(tclass->attributes);
+        g_slice_free(NMTCTclass, tclass);
+    }
+}
+
+/**
+ * nm_tc_tclass_equal:
+ * @tclass: the #NMTCTclass
+ * @other: the #NMTCTclass to compare @tclass to.
+ *
+ * Determines if two #NMTCTclass objects contain the same kind, handle,
+ * parent and attributes.
+ *
+ * Returns: %TRUE if the objects contain the same values, %FALSE if they do not.
+ *
+ * Since: 1.34
+ **/
+gboolean
+nm_tc_tclass_equal(NMTCTclass *tclass, NMTCTclass *other)
+{
+    GHashTableIter iter;
+    const char *   key;
+    GVariant *     value, *value2;
+    guint          n;
+
+    g_return_val_if_fail(tclass != NULL, FALSE);
+    g_return_val_if_fail(tclass->refcount > 0, FALSE);
+
+    g_return_val_if_fail(other != NULL, FALSE);
+    g_return_val_if_fail(other->refcount > 0, FALSE);
+
+    if (tclass->handle != other->handle || tclass->parent != other->parent
+        || g_strcmp0(tclass->kind, other->kind) != 0)
+        return FALSE;
+
+    n = tclass->attributes ? g_hash_table_size(tclass->attributes) : 0;
+    if (n != (other->attributes ? g_hash_table_size(other->attributes) : 0))
+        return FALSE;
+    if (n) {
+        g_hash_table_iter_init(&iter, tclass->attributes);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value)) {
+            value2 = g_hash_table_lookup(other->attributes, key);
+            if (!value2)
+                return FALSE;
+            if (!g_variant_equal(value, value2))
+                return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * nm_tc_tclass_dup:
+ * @tclass: the #NMTCTclass
+ *
+ * Creates a copy of @tclass
+ *
+ * Returns: (transfer full): a copy of @tclass
+ *
+ * Since: 1.34
+ **/
+NMTCTclass *
+nm_tc_tclass_dup(NMTCTclass *tclass)
+{
+    NMTCTclass *copy;
+
+    g_return_val_if_fail(tclass != NULL, NULL);
+    g_return_val_if_fail(tclass->refcount > 0, NULL);
+
+    copy = nm_tc_tclass_new(tclass->kind, tclass->handle, tclass->parent, NULL);
+
+    if (tclass->attributes) {
+        GHashTableIter iter;
+        const char *   key;
+        GVariant *     value;
+
+        g_hash_table_iter_init(&iter, tclass->attributes);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
+            nm_tc_tclass_set_attribute(copy, key, value);
+    }
+
+    return copy;
+}
+
+/**
+ * nm_tc_tclass_get_kind:
+ * @tclass: the #NMTCTclass
+ *
+ * Returns: the kind of the queueing discipline the class belongs to
+ *
+ * Since: 1.34
+ **/
+const char *
+nm_tc_tclass_get_kind(NMTCTclass *tclass)
+{
+    g_return_val_if_fail(tclass != NULL, NULL);
+    g_return_val_if_fail(tclass->refcount > 0, NULL);
+
+    return tclass->kind;
+}
+
+/**
+ * nm_tc_tclass_get_handle:
+ * @tclass: the #NMTCTclass
+ *
+ * Returns: the class handle
+ *
+ * Since: 1.34
+ **/
+guint32
+nm_tc_tclass_get_handle(NMTCTclass *tclass)
+{
+    g_return_val_if_fail(tclass != NULL, TC_H_UNSPEC);
+    g_return_val_if_fail(tclass->refcount > 0, TC_H_UNSPEC);
+
+    return tclass->handle;
+}
+
+/**
+ * nm_tc_tclass_get_parent:
+ * @tclass: the #NMTCTclass
+ *
+ * Returns: the parent queueing discipline or class
+ *
+ * Since: 1.34
+ **/
+guint32
+nm_tc_tclass_get_parent(NMTCTclass *tclass)
+{
+    g_return_val_if_fail(tclass != NULL, TC_H_UNSPEC);
+    g_return_val_if_fail(tclass->refcount > 0, TC_H_UNSPEC);
+
+    return tclass->parent;
+}
+
+/**
+ * nm_tc_tclass_get_attribute_names:
+ * @tclass: the #NMTCTclass
+ *
+ * Gets an array of attribute names defined on @tclass.
+ *
+ * Returns: (transfer container): a %NULL-terminated array of attribute names
+ *   or %NULL if no attributes are set.
+ *
+ * Since: 1.34
+ **/
+const char **
+nm_tc_tclass_get_attribute_names(NMTCTclass *tclass)
+{
+    g_return_val_if_fail(tclass, NULL);
+
+    return nm_utils_strdict_get_keys(tclass->attributes, TRUE, NULL);
+}
+
+GHashTable *
+_nm_tc_tclass_get_attributes(NMTCTclass *tclass)
+{
+    nm_assert(tclass);
+
+    return tclass->attributes;
+}
+
+/**
+ * nm_tc_tclass_get_attribute:
+ * @tclass: the #NMTCTclass
+ * @name: the name of a class attribute
+ *
+ * Gets the value of the attribute with name @name on @tclass
+ *
+ * Returns: (transfer none): the value of the attribute with name @name on
+ *   @tclass, or %NULL if @tclass has no such attribute.
+ *
+ * Since: 1.34
+ **/
+GVariant *
+nm_tc_tclass_get_attribute(NMTCTclass *tclass, const char *name)
+{
+    g_return_val_if_fail(tclass != NULL, NULL);
+    g_return_val_if_fail(name != NULL && *name != '\0', NULL);
+
+    if (tclass->attributes)
+        return g_hash_table_lookup(tclass->attributes, name);
+    else
+        return NULL;
+}
+
+/**
+ * nm_tc_tclass_set_attribute:
+ * @tclass: the #NMTCTclass
+ * @name: the name of a class attribute
+ * @value: (transfer none) (allow-none): the value
+ *
+ * Sets or clears the named attribute on @tclass to the given value.
+ *
+ * Since: 1.34
+ **/
+void
+nm_tc_tclass_set_attribute(NMTCTclass *tclass, const char *name, GVariant *value)
+{
+    g_return_if_fail(tclass != NULL);
+    g_return_if_fail(name != NULL && *name != '\0');
+    g_return_if_fail(!NM_IN_STRSET(name, "kind", "handle", "parent"));
+
+    if (!tclass->attributes) {
+        tclass->attributes = g_hash_table_new_full(nm_str_hash,
+                                                   g_str_equal,
+                                                   g_free,
+                                                   (GDestroyNotify) g_variant_unref);
+    }
+
+    if (value)
+        g_hash_table_insert(tclass->attributes, g_strdup(name), g_variant_ref_sink(value));
+    else
+        g_hash_table_remove(tclass->attributes, name);
+}
+
+/*****************************************************************************/
+
 G_DEFINE_BOXED_TYPE(NMTCAction, nm_tc_action, nm_tc_action_dup, nm_tc_action_unref)
 
 struct NMTCAction {
@@ -973,7 +1300,7 @@ nm_tc_tfilter_set_action(NMTCTfilter *tfilter, NMTCAction *action)
 
 /*****************************************************************************/
 
-NM_GOBJECT_PROPERTIES_DEFINE(NMSettingTCConfig, PROP_QDISCS, PROP_TFILTERS, );
+NM_GOBJECT_PROPERTIES_DEFINE(NMSettingTCConfig, PROP_QDISCS, PROP_TCLASSES, PROP_TFILTERS, );
 
 /**
  * NMSettingTCConfig:
@@ -985,6 +1312,7 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMSettingTCConfig, PROP_QDISCS, PROP_TFILTERS, );
 struct _NMSettingTCConfig {
     NMSetting  parent;
     GPtrArray *qdiscs;
+    GPtrArray *tclasses;
     GPtrArray *tfilters;
 };
 
@@ -1130,6 +1458,141 @@ nm_setting_tc_config_clear_qdiscs(NMSettingTCConfig *self)
     }
 }
 
+/*****************************************************************************/
+
+/**
+ * nm_setting_tc_config_get_num_tclasses:
+ * @setting: the #NMSettingTCConfig
+ *
+ * Returns: the number of configured traffic classes
+ *
+ * Since: 1.34
+ **/
+guint
+nm_setting_tc_config_get_num_tclasses(NMSettingTCConfig *self)
+{
+    g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), 0);
+
+    return self->tclasses->len;
+}
+
+/**
+ * nm_setting_tc_config_get_tclass:
+ * @setting: the #NMSettingTCConfig
+ * @idx: index number of the class to return
+ *
+ * Returns: (transfer none): the class at index @idx
+ *
+ * Since: 1.34
+ **/
+NMTCTclass *
+nm_setting_tc_config_get_tclass(NMSettingTCConfig *self, guint idx)
+{
+    g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), NULL);
+    g_return_val_if_fail(idx < self->tclasses->len, NULL);
+
+    return self->tclasses->pdata[idx];
+}
+
+/**
+ * nm_setting_tc_config_add_tclass:
+ * @setting: the #NMSettingTCConfig
+ * @tclass: the class to add
+ *
+ * Appends a new class and associated information to the setting.  The
+ * given class is duplicated internally and is not changed by this function.
+ * If an identical class (considering attributes as well) already exists, the
+ * class is not added and the function returns %FALSE.
+ *
+ * Returns: %TRUE if the class was added; %FALSE if the class was already known.
+ *
+ * Since: 1.34
+ **/
+gboolean
+nm_setting_tc_config_add_tclass(NMSettingTCConfig *self, NMTCTclass *tclass)
+{
+    guint i;
+
+    g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
+    g_return_val_if_fail(tclass != NULL, FALSE);
+
+    for (i = 0; i < self->tclasses->len; i++) {
+        if (nm_tc_tclass_equal(self->tclasses->pdata[i], tclass))
+            return FALSE;
+    }
+
+    g_ptr_array_add(self->tclasses, nm_tc_tclass_dup(tclass));
+    _notify(self, PROP_TCLASSES);
+    return TRUE;
+}
+
+/**
+ * nm_setting_tc_config_remove_tclass:
+ * @setting: the #NMSettingTCConfig
+ * @idx: index number of the class
+ *
+ * Removes the class at index @idx.
+ *
+ * Since: 1.34
+ **/
+void
+nm_setting_tc_config_remove_tclass(NMSettingTCConfig *self, guint idx)
+{
+    g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
+    g_return_if_fail(idx < self->tclasses->len);
+
+    g_ptr_array_remove_index(self->tclasses, idx);
+    _notify(self, PROP_TCLASSES);
+}
+
+/**
+ * nm_setting_tc_config_remove_tclass_by_value:
+ * @setting: the #NMSettingTCConfig
+ * @tclass: the class to remove
+ *
+ * Removes the first class that matches @tclass.
+ *
+ * Returns: %TRUE if the class was found and removed; %FALSE if it was not.
+ *
+ * Since: 1.34
+ **/
+gboolean
+nm_setting_tc_config_remove_tclass_by_value(NMSettingTCConfig *self, NMTCTclass *tclass)
+{
+    guint i;
+
+    g_return_val_if_fail(NM_IS_SETTING_TC_CONFIG(self), FALSE);
+    g_return_val_if_fail(tclass != NULL, FALSE);
+
+    for (i = 0; i < self->tclasses->len; i++) {
+        if (nm_tc_tclass_equal(self->tclasses->pdata[i], tclass)) {
+            g_ptr_array_remove_index(self->tclasses, i);
+            _notify(self, PROP_TCLASSES);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * nm_setting_tc_config_clear_tclasses:
+ * @setting: the #NMSettingTCConfig
+ *
+ * Removes all configured traffic classes.
+ *
+ * Since: 1.34
+ **/
+void
+nm_setting_tc_config_clear_tclasses(NMSettingTCConfig *self)
+{
+    g_return_if_fail(NM_IS_SETTING_TC_CONFIG(self));
+
+    if (self->tclasses->len != 0) {
+        g_ptr_array_set_size(self->tclasses, 0);
+        _notify(self, PROP_TCLASSES);
+    }
+}
+
 /*****************************************************************************/
 /**
  * nm_setting_tc_config_get_num_tfilters:
@@ -1291,6 +1754,53 @@ verify(NMSetting *setting, NMConnection *connection, GError **error)
         }
     }
 
+    if (self->tclasses->len != 0) {
+        gs_unref_hashtable GHashTable *ht = NULL;
+
+        ht = g_hash_table_new(nm_direct_hash, NULL);
+        for (i = 0; i < self->tclasses->len; i++) {
+            NMTCTclass *tclass = self->tclasses->pdata[i];
+            guint32     handle = nm_tc_tclass_get_handle(tclass);
+            guint       j;
+
+            if (!g_hash_table_add(ht, GUINT_TO_POINTER(handle))) {
+                g_set_error(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("there are duplicate TC classes with handle %x:%x"),
+                            TC_H_MAJ(handle) >> 16,
+                            TC_H_MIN(handle));
+                g_prefix_error(error,
+                               "%s.%s: ",
+                               NM_SETTING_TC_CONFIG_SETTING_NAME,
+                               NM_SETTING_TC_CONFIG_TCLASSES);
+                return FALSE;
+            }
+
+            for (j = 0; j < self->qdiscs->len; j++) {
+                NMTCQdisc *qdisc = self->qdiscs->pdata[j];
+
+                if (nm_tc_qdisc_get_handle(qdisc) == TC_H_MAJ(handle)
+                    && nm_streq(nm_tc_qdisc_get_kind(qdisc), nm_tc_tclass_get_kind(tclass)))
+                    break;
+            }
+            if (j == self->qdiscs->len) {
+                g_set_error(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("class %x:%x doesn't belong to a configured '%s' qdisc"),
+                            TC_H_MAJ(handle) >> 16,
+                            TC_H_MIN(handle),
+                            nm_tc_tclass_get_kind(tclass));
+                g_prefix_error(error,
+                               "%s.%s: ",
+                               NM_SETTING_TC_CONFIG_SETTING_NAME,
+                               NM_SETTING_TC_CONFIG_TCLASSES);
+                return FALSE;
+            }
+        }
+    }
+
     if (self->tfilters->len != 0) {
         gs_unref_hashtable GHashTable *ht = NULL;
 
@@ -1339,6 +1849,19 @@ compare_property(const NMSettInfoSetting *sett_info,
         return TRUE;
     }
 
+    if (nm_streq(sett_info->property_infos[property_idx].name, NM_SETTING_TC_CONFIG_TCLASSES)) {
+        if (set_b) {
+            if (a_tc_config->tclasses->len != b_tc_config->tclasses->len)
+                return FALSE;
+            for (i = 0; i < a_tc_config->tclasses->len; i++) {
+                if (!nm_tc_tclass_equal(a_tc_config->tclasses->pdata[i],
+                                        b_tc_config->tclasses->pdata[i]))
+                    return FALSE;
+            }
+        }
+        return TRUE;
+    }
+
     if (nm_streq(sett_info->property_infos[property_idx].name, NM_SETTING_TC_CONFIG_TFILTERS)) {
         if (set_b) {
             if (a_tc_config->tfilters->len != b_tc_config->tfilters->len)
@@ -1511,6 +2034,149 @@ tc_qdiscs_set(NMSetting *         setting,
     return TRUE;
 }
 
+/**
+ * _tclasses_to_variant:
+ * @tclasses: (element-type NMTCTclass): an array of #NMTCTclass objects
+ *
+ * Utility function to convert a #GPtrArray of #NMTCTclass objects representing
+ * TC classes into a #GVariant of type 'aa{sv}' representing an array
+ * of NetworkManager TC classes.
+ *
+ * Returns: (transfer none): a new floating #GVariant representing @tclasses.
+ **/
+static GVariant *
+_tclasses_to_variant(GPtrArray *tclasses)
+{
+    GVariantBuilder builder;
+    guint           i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+
+    if (tclasses) {
+        for (i = 0; i < tclasses->len; i++) {
+            NMUtilsNamedValue attrs_static[30];
+            gs_free NMUtilsNamedValue *attrs_free = NULL;
+            const NMUtilsNamedValue *  attrs;
+            NMTCTclass *               tclass = tclasses->pdata[i];
+            guint                      length;
+            GVariantBuilder            tclass_builder;
+            guint                      y;
+
+            g_variant_builder_init(&tclass_builder, G_VARIANT_TYPE_VARDICT);
+
+            g_variant_builder_add(&tclass_builder,
+                                  "{sv}",
+                                  "kind",
+                                  g_variant_new_string(nm_tc_tclass_get_kind(tclass)));
+
+            g_variant_builder_add(&tclass_builder,
+                                  "{sv}",
+                                  "handle",
+                                  g_variant_new_uint32(nm_tc_tclass_get_handle(tclass)));
+
+            g_variant_builder_add(&tclass_builder,
+                                  "{sv}",
+                                  "parent",
+                                  g_variant_new_uint32(nm_tc_tclass_get_parent(tclass)));
+
+            attrs = nm_utils_named_values_from_strdict(tclass->attributes,
+                                                       &length,
+                                                       attrs_static,
+                                                       &attrs_free);
+            for (y = 0; y < length; y++)
+                g_variant_builder_add(&tclass_builder, "{sv}", attrs[y].name, attrs[y].value_ptr);
+
+            g_variant_builder_add(&builder, "a{sv}", &tclass_builder);
+        }
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
+/**
+ * _tclasses_from_variant:
+ * @value: a #GVariant of type 'aa{sv}'
+ *
+ * Utility function to convert a #GVariant representing a list of TC classes
+ * into a #GPtrArray of #NMTCTclass objects.
+ *
+ * Returns: (transfer full) (element-type NMTCTclass): a newly allocated
+ *   #GPtrArray of #NMTCTclass objects
+ **/
+static GPtrArray *
+_tclasses_from_variant(GVariant *value)
+{
+    GPtrArray *  tclasses;
+    GVariant *   tclass_var;
+    GVariantIter iter;
+
+    g_return_val_if_fail(g_variant_is_of_type(value, G_VARIANT_TYPE("aa{sv}")), NULL);
+
+    g_variant_iter_init(&iter, value);
+    tclasses = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_tclass_unref);
+
+    while (g_variant_iter_next(&iter, "@a{sv}", &tclass_var)) {
+        const char * kind;
+        guint32      handle;
+        guint32      parent;
+        NMTCTclass * tclass;
+        GVariantIter tclass_iter;
+        const char * key;
+        GVariant *   attr_value;
+
+        if (!g_variant_lookup(tclass_var, "kind", "&s", &kind)
+            || !g_variant_lookup(tclass_var, "handle", "u", &handle)
+            || !g_variant_lookup(tclass_var, "parent", "u", &parent))
+            goto next;
+
+        tclass = nm_tc_tclass_new(kind, handle, parent, NULL);
+        if (!tclass)
+            goto next;
+
+        g_variant_iter_init(&tclass_iter, tclass_var);
+        while (g_variant_iter_next(&tclass_iter, "{&sv}", &key, &attr_value)) {
+            if (!NM_IN_STRSET(key, "kind", "handle", "parent"))
+                nm_tc_tclass_set_attribute(tclass, key, attr_value);
+            g_variant_unref(attr_value);
+        }
+
+        g_ptr_array_add(tclasses, tclass);
+next:
+        g_variant_unref(tclass_var);
+    }
+
+    return tclasses;
+}
+
+static GVariant *
+tc_tclasses_get(const NMSettInfoSetting *               sett_info,
+                guint                                   property_idx,
+                NMConnection *                          connection,
+                NMSetting *                             setting,
+                NMConnectionSerializationFlags          flags,
+                const NMConnectionSerializationOptions *options)
+{
+    gs_unref_ptrarray GPtrArray *tclasses = NULL;
+
+    g_object_get(setting, NM_SETTING_TC_CONFIG_TCLASSES, &tclasses, NULL);
+    return _tclasses_to_variant(tclasses);
+}
+
+static gboolean
+tc_tclasses_set(NMSetting *         setting,
+                GVariant *          connection_dict,
+                const char *        property,
+                GVariant *          value,
+                NMSettingParseFlags parse_flags,
+                GError **           error)
+{
+    gs_unref_ptrarray GPtrArray *tclasses = NULL;
+
+    tclasses = _tclasses_from_variant(value);
+    g_object_set(setting, NM_SETTING_TC_CONFIG_TCLASSES, tclasses, NULL);
+    return TRUE;
+}
+
 static GVariant *
 _action_to_variant(NMTCAction *action)
 {
@@ -1721,6 +2387,12 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
                                                 (NMUtilsCopyFunc) nm_tc_qdisc_dup,
                                                 (GDestroyNotify) nm_tc_qdisc_unref));
         break;
+    case PROP_TCLASSES:
+        g_value_take_boxed(value,
+                           _nm_utils_copy_array(self->tclasses,
+                                                (NMUtilsCopyFunc) nm_tc_tclass_dup,
+                                                (GDestroyNotify) nm_tc_tclass_unref));
+        break;
     case PROP_TFILTERS:
         g_value_take_boxed(value,
                            _nm_utils_copy_array(self->tfilters,
@@ -1745,6 +2417,12 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
                                             (NMUtilsCopyFunc) nm_tc_qdisc_dup,
                                             (GDestroyNotify) nm_tc_qdisc_unref);
         break;
+    case PROP_TCLASSES:
+        g_ptr_array_unref(self->tclasses);
+        self->tclasses = _nm_utils_copy_array(g_value_get_boxed(value),
+                                              (NMUtilsCopyFunc) nm_tc_tclass_dup,
+                                              (GDestroyNotify) nm_tc_tclass_unref);
+        break;
     case PROP_TFILTERS:
         g_ptr_array_unref(self->tfilters);
         self->tfilters = _nm_utils_copy_array(g_value_get_boxed(value),
@@ -1763,6 +2441,7 @@ static void
 nm_setting_tc_config_init(NMSettingTCConfig *self)
 {
     self->qdiscs   = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_qdisc_unref);
+    self->tclasses = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_tclass_unref);
     self->tfilters = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_tfilter_unref);
 }
 
@@ -1787,6 +2466,7 @@ finalize(GObject *object)
     NMSettingTCConfig *self = NM_SETTING_TC_CONFIG(object);
 
     g_ptr_array_unref(self->qdiscs);
+    g_ptr_array_unref(self->tclasses);
     g_ptr_array_unref(self->tfilters);
 
     G_OBJECT_CLASS(nm_setting_tc_config_parent_class)->finalize(object);
@@ -1842,6 +2522,32 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
                                                                 .to_dbus_fcn   = tc_qdiscs_get,
                                                                 .from_dbus_fcn = tc_qdiscs_set, ));
 
+    /**
+     * NMSettingTCConfig:tclasses: (type GPtrArray(NMTCTclass))
+     *
+     * Array of TC traffic classes, for example the classes of a "htb" qdisc.
+     *
+     * When the #NMSettingTCConfig setting is present, classes from this
+     * property are applied upon activation. Classes which are already
+     * configured on the interface with the same parameters are left
+     * untouched. If the property is empty, NetworkManager removes all
+     * the classes.
+     *
+     * Since: 1.34
+     **/
+    obj_properties[PROP_TCLASSES] = g_param_spec_boxed(
+        NM_SETTING_TC_CONFIG_TCLASSES,
+        "",
+        "",
+        G_TYPE_PTR_ARRAY,
+        G_PARAM_READWRITE | NM_SETTING_PARAM_INFERRABLE | G_PARAM_STATIC_STRINGS);
+    _nm_properties_override_gobj(
+        properties_override,
+        obj_properties[PROP_TCLASSES],
+        NM_SETT_INFO_PROPERT_TYPE_DBUS(NM_G_VARIANT_TYPE("aa{sv}"),
+                                       .to_dbus_fcn   = tc_tclasses_get,
+                                       .from_dbus_fcn = tc_tclasses_set, ));
+
     /**
      * NMSettingTCConfig:tfilters: (type GPtrArray(NMTCTfilter))
      *
@@ -633,6 +633,185 @@ _nm_setting_property_to_dbus_fcn_gprop(const NMSettInfoSetting *               s
     return nm_assert_unreachable_val(NULL);
 }
 
+static GVariant *property_to_dbus(const NMSettInfoSetting *               sett_info,
+                                  guint                                   property_idx,
+                                  NMConnection *                          connection,
+                                  NMSetting *                             setting,
+                                  NMConnectionSerializationFlags          flags,
+                                  const NMConnectionSerializationOptions *options,
+                                  gboolean                                ignore_flags);
+
+/*****************************************************************************/
+
+gboolean
+_nm_setting_property_compare_fcn_default(const NMSettInfoSetting *sett_info,
+                                         guint                    property_idx,
+                                         NMConnection *           con_a,
+                                         NMSetting *              set_a,
+                                         NMConnection *           con_b,
+                                         NMSetting *              set_b,
+                                         NMSettingCompareFlags    flags)
+{
+    gs_unref_variant GVariant *value1 = NULL;
+    gs_unref_variant GVariant *value2 = NULL;
+
+    value1 = property_to_dbus(sett_info,
+                              property_idx,
+                              con_a,
+                              set_a,
+                              NM_CONNECTION_SERIALIZE_ALL,
+                              NULL,
+                              TRUE);
+    value2 = property_to_dbus(sett_info,
+                              property_idx,
+                              con_b,
+                              set_b,
+                              NM_CONNECTION_SERIALIZE_ALL,
+                              NULL,
+                              TRUE);
+    return nm_property_compare(value1, value2) == 0;
+}
+
+gboolean
+_nm_setting_property_compare_fcn_get_boolean(const NMSettInfoSetting *sett_info,
+                                             guint                    property_idx,
+                                             NMConnection *           con_a,
+                                             NMSetting *              set_a,
+                                             NMConnection *           con_b,
+                                             NMSetting *              set_b,
+                                             NMSettingCompareFlags    flags)
+{
+    const NMSettInfoProperty *property_info = &sett_info->property_infos[property_idx];
+
+    nm_assert(property_info->property_type->to_dbus_fcn
+              == _nm_setting_property_to_dbus_fcn_get_boolean);
+
+    return (!property_info->to_dbus_data.get_boolean(set_a))
+           == (!property_info->to_dbus_data.get_boolean(set_b));
+}
+
+gboolean
+_nm_setting_property_compare_fcn_get_string(const NMSettInfoSetting *sett_info,
+                                            guint                    property_idx,
+                                            NMConnection *           con_a,
+                                            NMSetting *              set_a,
+                                            NMConnection *           con_b,
+                                            NMSetting *              set_b,
+                                            NMSettingCompareFlags    flags)
+{
+    const NMSettInfoProperty *property_info = &sett_info->property_infos[property_idx];
+
+    nm_assert(property_info->property_type->to_dbus_fcn
+              == _nm_setting_property_to_dbus_fcn_get_string);
+
+    /* A NULL string is not serialized to D-Bus, so it differs from "". */
+    return nm_streq0(property_info->to_dbus_data.get_string(set_a),
+                     property_info->to_dbus_data.get_string(set_b));
+}
+
+gboolean
+_nm_setting_property_compare_fcn_gprop(const NMSettInfoSetting *sett_info,
+                                       guint                    property_idx,
+                                       NMConnection *           con_a,
+                                       NMSetting *              set_a,
+                                       NMConnection *           con_b,
+                                       NMSetting *              set_b,
+                                       NMSettingCompareFlags    flags)
+{
+    const NMSettInfoProperty *const property = &sett_info->property_infos[property_idx];
+    nm_auto_unset_gvalue GValue     value_a  = G_VALUE_INIT;
+    nm_auto_unset_gvalue GValue     value_b  = G_VALUE_INIT;
+    GType                           vtype;
+
+    nm_assert(property->param_spec);
+
+    if (property->property_type->to_dbus_fcn != _nm_setting_property_to_dbus_fcn_gprop
+        || property->to_dbus_data.gprop_to_dbus_fcn
+        || !NM_IN_SET(property->property_type->typdata_to_dbus.gprop_type,
+                      NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_DEFAULT,
+                      NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_BYTES,
+                      NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_ENUM,
+                      NM_SETTING_PROPERTY_TO_DBUS_FCN_GPROP_TYPE_FLAGS)) {
+        /* The D-Bus representation is not a plain conversion of the GValue
+         * (e.g. MAC addresses get normalized). Compare the variants. */
+        return _nm_setting_property_compare_fcn_default(sett_info,
+                                                        property_idx,
+                                                        con_a,
+                                                        set_a,
+                                                        con_b,
+                                                        set_b,
+                                                        flags);
+    }
+
+    vtype = property->param_spec->value_type;
+
+    g_value_init(&value_a, vtype);
+    g_value_init(&value_b, vtype);
+    g_object_get_property(G_OBJECT(set_a), property->param_spec->name, &value_a);
+    g_object_get_property(G_OBJECT(set_b), property->param_spec->name, &value_b);
+
+    if (!property->to_dbus_data.including_default) {
+        gboolean is_default_a = g_param_value_defaults(property->param_spec, &value_a);
+        gboolean is_default_b = g_param_value_defaults(property->param_spec, &value_b);
+
+        /* like _nm_setting_property_to_dbus_fcn_gprop(), default values are
+         * not serialized and differ from every other value. */
+        if (is_default_a || is_default_b)
+            return is_default_a == is_default_b;
+    }
+
+    switch (G_TYPE_FUNDAMENTAL(vtype)) {
+    case G_TYPE_BOOLEAN:
+        return (!g_value_get_boolean(&value_a)) == (!g_value_get_boolean(&value_b));
+    case G_TYPE_UCHAR:
+        return g_value_get_uchar(&value_a) == g_value_get_uchar(&value_b);
+    case G_TYPE_INT:
+        return g_value_get_int(&value_a) == g_value_get_int(&value_b);
+    case G_TYPE_UINT:
+        return g_value_get_uint(&value_a) == g_value_get_uint(&value_b);
+    case G_TYPE_INT64:
+        return g_value_get_int64(&value_a) == g_value_get_int64(&value_b);
+    case G_TYPE_UINT64:
+        return g_value_get_uint64(&value_a) == g_value_get_uint64(&value_b);
+    case G_TYPE_ENUM:
+        return g_value_get_enum(&value_a) == g_value_get_enum(&value_b);
+    case G_TYPE_FLAGS:
+        return g_value_get_flags(&value_a) == g_value_get_flags(&value_b);
+    case G_TYPE_STRING:
+        /* g_dbus_gvalue_to_gvariant() converts a NULL string to "". */
+        return nm_streq(g_value_get_string(&value_a) ?: "", g_value_get_string(&value_b) ?: "");
+    case G_TYPE_BOXED:
+        if (vtype == G_TYPE_STRV) {
+            const char *const *strv_a = g_value_get_boxed(&value_a);
+            const char *const *strv_b = g_value_get_boxed(&value_b);
+
+            return nm_utils_strv_equal(strv_a ?: NM_STRV_EMPTY_CC(), strv_b ?: NM_STRV_EMPTY_CC());
+        }
+        if (vtype == G_TYPE_BYTES) {
+            GBytes *      bytes_b = g_value_get_boxed(&value_b);
+            gconstpointer p       = NULL;
+            gsize         l       = 0;
+
+            if (bytes_b)
+                p = g_bytes_get_data(bytes_b, &l);
+            return nm_utils_gbytes_equal_mem(g_value_get_boxed(&value_a), p, l);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return _nm_setting_property_compare_fcn_default(sett_info,
+                                                    property_idx,
+                                                    con_a,
+                                                    set_a,
+                                                    con_b,
+                                                    set_b,
+                                                    flags);
+}
+
+/*****************************************************************************/
+
 static GVariant *
 property_to_dbus(const NMSettInfoSetting *               sett_info,
                  guint                                   property_idx,
@@ -1398,25 +1577,26 @@ compare_property(const NMSettInfoSetting *sett_info,
         return NM_TERNARY_DEFAULT;
 
     if (set_b) {
-        gs_unref_variant GVariant *value1 = NULL;
-        gs_unref_variant GVariant *value2 = NULL;
-
-        value1 = property_to_dbus(sett_info,
-                                  property_idx,
-                                  con_a,
-                                  set_a,
-                                  NM_CONNECTION_SERIALIZE_ALL,
-                                  NULL,
-                                  TRUE);
-        value2 = property_to_dbus(sett_info,
-                                  property_idx,
-                                  con_b,
-                                  set_b,
-                                  NM_CONNECTION_SERIALIZE_ALL,
-                                  NULL,
-                                  TRUE);
-        if (nm_property_compare(value1, value2) != 0)
+        NMSettInfoPropCompareFcn compare_fcn = property_info->property_type->compare_fcn;
+
+        if (!compare_fcn)
+            compare_fcn = _nm_setting_property_compare_fcn_default;
+
+        if (!compare_fcn(sett_info, property_idx, con_a, set_a, con_b, set_b, flags))
             return NM_TERNARY_FALSE;
+
+#if NM_MORE_ASSERTS > 10
+        /* assert that the typed comparison agrees with comparing the D-Bus
+         * representation. */
+        nm_assert(compare_fcn == _nm_setting_property_compare_fcn_default
+                  || _nm_setting_property_compare_fcn_default(sett_info,
+                                                              property_idx,
+                                                              con_a,
+                                                              set_a,
+                                                              con_b,
+                                                              set_b,
+                                                              flags));
+#endif
     }
 
     return NM_TERNARY_TRUE;
@@ -2404,11 +2584,13 @@ const NMSettInfoPropertType nm_sett_info_propert_type_plain_u =
 
 const NMSettInfoPropertType nm_sett_info_propert_type_boolean = NM_SETT_INFO_PROPERT_TYPE_DBUS_INIT(
     G_VARIANT_TYPE_BOOLEAN,
-    .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_get_boolean);
+    .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_get_boolean,
+    .compare_fcn = _nm_setting_property_compare_fcn_get_boolean);
 
 const NMSettInfoPropertType nm_sett_info_propert_type_string =
     NM_SETT_INFO_PROPERT_TYPE_DBUS_INIT(G_VARIANT_TYPE_STRING,
-                                        .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_get_string);
+                                        .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_get_string,
+                                        .compare_fcn = _nm_setting_property_compare_fcn_get_string);
 
 /*****************************************************************************/
 
@@ -1919,12 +1919,18 @@ nm_utils_ip_addresses_to_variant(GPtrArray *addresses)
             GVariantBuilder      addr_builder;
             gs_free const char **names = NULL;
             guint                j, len;
+            NMIPAddr             addr_bin;
+            char                 addr_str[NM_UTILS_INET_ADDRSTRLEN];
+
+            nm_ip_address_get_address_binary(addr, &addr_bin);
 
             g_variant_builder_init(&addr_builder, G_VARIANT_TYPE("a{sv}"));
-            g_variant_builder_add(&addr_builder,
-                                  "{sv}",
-                                  "address",
-                                  g_variant_new_string(nm_ip_address_get_address(addr)));
+            g_variant_builder_add(
+                &addr_builder,
+                "{sv}",
+                "address",
+                g_variant_new_string(
+                    nm_utils_inet_ntop(nm_ip_address_get_family(addr), &addr_bin, addr_str)));
             g_variant_builder_add(&addr_builder,
                                   "{sv}",
                                   "prefix",
@@ -2027,25 +2033,32 @@ nm_utils_ip_routes_to_variant(GPtrArray *routes)
 
     if (routes) {
         for (i = 0; i < routes->len; i++) {
-            NMIPRoute *          route = routes->pdata[i];
+            NMIPRoute *          route       = routes->pdata[i];
+            const int            addr_family = nm_ip_route_get_family(route);
             GVariantBuilder      route_builder;
             gs_free const char **names = NULL;
             guint                j, len;
+            NMIPAddr             addr_bin;
+            char                 addr_str[NM_UTILS_INET_ADDRSTRLEN];
+
+            nm_ip_route_get_dest_binary(route, &addr_bin);
 
             g_variant_builder_init(&route_builder, G_VARIANT_TYPE("a{sv}"));
-            g_variant_builder_add(&route_builder,
-                                  "{sv}",
-                                  "dest",
-                                  g_variant_new_string(nm_ip_route_get_dest(route)));
+            g_variant_builder_add(
+                &route_builder,
+                "{sv}",
+                "dest",
+                g_variant_new_string(nm_utils_inet_ntop(addr_family, &addr_bin, addr_str)));
             g_variant_builder_add(&route_builder,
                                   "{sv}",
                                   "prefix",
                                   g_variant_new_uint32(nm_ip_route_get_prefix(route)));
-            if (nm_ip_route_get_next_hop(route)) {
-                g_variant_builder_add(&route_builder,
-                                      "{sv}",
-                                      "next-hop",
-                                      g_variant_new_string(nm_ip_route_get_next_hop(route)));
+            if (nm_ip_route_get_next_hop_binary(route, &addr_bin)) {
+                g_variant_builder_add(
+                    &route_builder,
+                    "{sv}",
+                    "next-hop",
+                    g_variant_new_string(nm_utils_inet_ntop(addr_family, &addr_bin, addr_str)));
             }
             if (nm_ip_route_get_metric(route) != -1) {
                 g_variant_builder_add(
@@ -2226,6 +2239,7 @@ static const NMVariantAttributeSpec *const tc_object_attribute_spec[] = {
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("root", G_VARIANT_TYPE_BOOLEAN, .no_value = TRUE, ),
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("parent", G_VARIANT_TYPE_STRING, ),
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("handle", G_VARIANT_TYPE_STRING, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("classid", G_VARIANT_TYPE_STRING, ),
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("kind", G_VARIANT_TYPE_STRING, .no_value = TRUE, ),
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("",
                                      G_VARIANT_TYPE_STRING,
@@ -2272,6 +2286,14 @@ static const NMVariantAttributeSpec *const tc_qdisc_fq_codel_spec[] = {
     NULL,
 };
 
+static const NMVariantAttributeSpec *const tc_qdisc_htb_spec[] = {
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("r2q", G_VARIANT_TYPE_UINT32, ),
+
+    /* the minor number of the class that gets unclassified traffic. */
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("default", G_VARIANT_TYPE_UINT32, ),
+    NULL,
+};
+
 typedef struct {
     const char *                         kind;
     const NMVariantAttributeSpec *const *attrs;
@@ -2279,11 +2301,28 @@ typedef struct {
 
 static const NMQdiscAttributeSpec *const tc_qdisc_attribute_spec[] = {
     &(const NMQdiscAttributeSpec){"fq_codel", tc_qdisc_fq_codel_spec},
+    &(const NMQdiscAttributeSpec){"htb", tc_qdisc_htb_spec},
     &(const NMQdiscAttributeSpec){"sfq", tc_qdisc_sfq_spec},
     &(const NMQdiscAttributeSpec){"tbf", tc_qdisc_tbf_spec},
     NULL,
 };
 
+static const NMVariantAttributeSpec *const tc_tclass_htb_spec[] = {
+    /* rates are in bytes per second, bursts in bytes. */
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("rate", G_VARIANT_TYPE_UINT64, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("ceil", G_VARIANT_TYPE_UINT64, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("burst", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("cburst", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("quantum", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("prio", G_VARIANT_TYPE_UINT32, ),
+    NULL,
+};
+
+static const NMQdiscAttributeSpec *const tc_tclass_attribute_spec[] = {
+    &(const NMQdiscAttributeSpec){"htb", tc_tclass_htb_spec},
+    NULL,
+};
+
 /*****************************************************************************/
 
 /**
@@ -2346,6 +2385,7 @@ static gboolean
 _tc_read_common_opts(const char *str,
                      guint32 *   handle,
                      guint32 *   parent,
+                     guint32 *   classid,
                      char **     kind,
                      char **     rest,
                      GError **   error)
@@ -2357,6 +2397,17 @@ _tc_read_common_opts(const char *str,
     if (!ht)
         return FALSE;
 
+    variant = g_hash_table_lookup(ht, "classid");
+    if (variant) {
+        if (!classid) {
+            g_set_error(error, 1, 0, _("unsupported option: 'classid'."));
+            return FALSE;
+        }
+        *classid = _nm_utils_parse_tc_handle(g_variant_get_string(variant, NULL), error);
+        if (*classid == TC_H_UNSPEC)
+            return FALSE;
+    }
+
     if (g_hash_table_contains(ht, "root"))
         *parent = TC_H_ROOT;
 
@@ -2445,7 +2496,7 @@ nm_utils_tc_qdisc_from_str(const char *str, GError **error)
     nm_assert(str);
     nm_assert(!error || !*error);
 
-    if (!_tc_read_common_opts(str, &handle, &parent, &kind, &rest, error))
+    if (!_tc_read_common_opts(str, &handle, &parent, NULL, &kind, &rest, error))
         return NULL;
 
     for (i = 0; rest && tc_qdisc_attribute_spec[i]; i++) {
@@ -2491,6 +2542,135 @@ nm_utils_tc_qdisc_from_str(const char *str, GError **error)
 
 /*****************************************************************************/
 
+/**
+ * _nm_utils_string_append_tc_tclass_rest:
+ * @string: the string to write the formatted class to
+ * @tclass: the %NMTCTclass
+ *
+ * This formats the rest of the class string but the class ID. Useful to
+ * format the keyfile value and nowhere else.
+ * Use nm_utils_tc_tclass_to_str() that also includes the class ID instead.
+ */
+void
+_nm_utils_string_append_tc_tclass_rest(GString *string, NMTCTclass *tclass)
+{
+    gs_free char *str = NULL;
+
+    _nm_utils_string_append_tc_parent(string, "parent", nm_tc_tclass_get_parent(tclass));
+    g_string_append(string, nm_tc_tclass_get_kind(tclass));
+
+    str = nm_utils_format_variant_attributes(_nm_tc_tclass_get_attributes(tclass), ' ', ' ');
+    if (str) {
+        g_string_append_c(string, ' ');
+        g_string_append(string, str);
+    }
+}
+
+/**
+ * nm_utils_tc_tclass_to_str:
+ * @tclass: the %NMTCTclass
+ * @error: location of the error
+ *
+ * Turns the %NMTCTclass into a tc style string representation of the
+ * traffic class.
+ *
+ * Returns: formatted string or %NULL
+ *
+ * Since: 1.34
+ */
+char *
+nm_utils_tc_tclass_to_str(NMTCTclass *tclass, GError **error)
+{
+    GString *string;
+
+    string = g_string_sized_new(60);
+
+    g_string_append(string, "classid ");
+    _string_append_tc_handle(string, nm_tc_tclass_get_handle(tclass));
+    g_string_append_c(string, ' ');
+    _nm_utils_string_append_tc_tclass_rest(string, tclass);
+
+    return g_string_free(string, FALSE);
+}
+
+/**
+ * nm_utils_tc_tclass_from_str:
+ * @str: the string representation of a class
+ * @error: location of the error
+ *
+ * Parses the tc style string representation of a traffic class
+ * to a %NMTCTclass instance. Supports a subset of the tc language.
+ *
+ * Returns: the %NMTCTclass or %NULL
+ *
+ * Since: 1.34
+ */
+NMTCTclass *
+nm_utils_tc_tclass_from_str(const char *str, GError **error)
+{
+    guint32            handle              = TC_H_UNSPEC;
+    guint32            parent              = TC_H_UNSPEC;
+    guint32            classid             = TC_H_UNSPEC;
+    gs_free char *     kind                = NULL;
+    gs_free char *     rest                = NULL;
+    NMTCTclass *       tclass              = NULL;
+    gs_unref_hashtable GHashTable *options = NULL;
+    GHashTableIter                 iter;
+    gpointer                       key, value;
+    guint                          i;
+
+    nm_assert(str);
+    nm_assert(!error || !*error);
+
+    if (!_tc_read_common_opts(str, &handle, &parent, &classid, &kind, &rest, error))
+        return NULL;
+
+    if (handle != TC_H_UNSPEC) {
+        g_set_error(error, 1, 0, _("a class has a 'classid', not a 'handle'."));
+        return NULL;
+    }
+
+    for (i = 0; rest && tc_tclass_attribute_spec[i]; i++) {
+        if (nm_streq(tc_tclass_attribute_spec[i]->kind, kind)) {
+            options = nm_utils_parse_variant_attributes(rest,
+                                                        ' ',
+                                                        ' ',
+                                                        FALSE,
+                                                        tc_tclass_attribute_spec[i]->attrs,
+                                                        error);
+            if (!options)
+                return NULL;
+            break;
+        }
+    }
+    nm_clear_g_free(&rest);
+
+    if (options) {
+        value = g_hash_table_lookup(options, "");
+        if (value)
+            rest = g_variant_dup_string(value, NULL);
+    }
+
+    if (rest) {
+        g_set_error(error, 1, 0, _("unsupported class option: '%s'."), rest);
+        return NULL;
+    }
+
+    tclass = nm_tc_tclass_new(kind, classid, parent, error);
+    if (!tclass)
+        return NULL;
+
+    if (options) {
+        g_hash_table_iter_init(&iter, options);
+        while (g_hash_table_iter_next(&iter, &key, &value))
+            nm_tc_tclass_set_attribute(tclass, key, g_variant_ref_sink(value));
+    }
+
+    return tclass;
+}
+
+/*****************************************************************************/
+
 static const NMVariantAttributeSpec *const tc_action_simple_attribute_spec[] = {
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("sdata", G_VARIANT_TYPE_BYTESTRING, ),
     NULL,
@@ -2742,7 +2922,7 @@ nm_utils_tc_tfilter_from_str(const char *str, GError **error)
     nm_assert(str);
     nm_assert(!error || !*error);
 
-    if (!_tc_read_common_opts(str, &handle, &parent, &kind, &rest, error))
+    if (!_tc_read_common_opts(str, &handle, &parent, NULL, &kind, &rest, error))
         return NULL;
 
     if (rest) {
@@ -1790,6 +1790,82 @@ test_dedup_multi(void)
     nm_dedup_multi_index_unref(idx);
 }
 
+static void
+test_dedup_multi_stats(void)
+{
+    NMDedupMultiIndex *       idx;
+    DedupIdxType              IDX_20_3_a_stack;
+    const DedupIdxType *const IDX_20_3_a = DEDUP_IDX_TYPE_INIT(&IDX_20_3_a_stack, 20, 3);
+    const NMDedupMultiEntry * entry1;
+    const NMDedupMultiEntry * entry2;
+    const NMDedupMultiObj *   obj;
+    NMDedupMultiIndexStats    stats;
+
+#define _assert_stats(idx,                                              \
+                      _n_objs,                                          \
+                      _n_entries,                                       \
+                      _n_head_entries,                                  \
+                      _entries_added,                                   \
+                      _entries_removed,                                 \
+                      _intern_hits,                                     \
+                      _intern_misses)                                   \
+    G_STMT_START                                                        \
+    {                                                                   \
+        nm_dedup_multi_index_get_stats((idx), &stats);                  \
+        g_assert_cmpint(stats.n_objs, ==, (_n_objs));                   \
+        g_assert_cmpint(stats.n_entries, ==, (_n_entries));             \
+        g_assert_cmpint(stats.n_head_entries, ==, (_n_head_entries));   \
+        g_assert_cmpint(stats.entries_added, ==, (_entries_added));     \
+        g_assert_cmpint(stats.entries_removed, ==, (_entries_removed)); \
+        g_assert_cmpint(stats.intern_hits, ==, (_intern_hits));         \
+        g_assert_cmpint(stats.intern_misses, ==, (_intern_misses));     \
+    }                                                                   \
+    G_STMT_END
+
+    idx = nm_dedup_multi_index_new();
+
+    _assert_stats(idx, 0, 0, 0, 0, 0, 0, 0);
+    g_assert_cmpint(stats.entries_size, ==, 0);
+
+    /* two partitions, each with its own head entry. */
+    g_assert(_dedup_idx_add(idx,
+                            IDX_20_3_a,
+                            DEDUP_OBJ_INIT(1, 1),
+                            NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                            &entry1));
+    g_assert(_dedup_idx_add(idx,
+                            IDX_20_3_a,
+                            DEDUP_OBJ_INIT(25, 1),
+                            NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                            &entry2));
+    _assert_stats(idx, 2, 2, 2, 2, 0, 0, 2);
+    g_assert_cmpint(stats.entries_size, >, 0);
+    g_assert_cmpint(stats.tables_size, >, 0);
+
+    /* replacing the object of an entry interns the new object and releases the
+     * old one. It does not add an entry. */
+    g_assert(_dedup_idx_add(idx,
+                            IDX_20_3_a,
+                            DEDUP_OBJ_INIT(1, 2),
+                            NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                            &entry1));
+    _assert_stats(idx, 2, 2, 2, 2, 0, 0, 3);
+
+    /* interning an equal object is a hit. */
+    obj = nm_dedup_multi_index_obj_intern(idx, DEDUP_OBJ_INIT(25, 1));
+    g_assert(obj == entry2->obj);
+    nm_dedup_multi_obj_unref(obj);
+    _assert_stats(idx, 2, 2, 2, 2, 0, 1, 3);
+
+    /* removing the last entry of a partition also removes its head entry. */
+    g_assert_cmpint(nm_dedup_multi_index_remove_entry(idx, entry2), ==, 1);
+    _assert_stats(idx, 1, 1, 1, 2, 1, 1, 3);
+
+#undef _assert_stats
+
+    nm_dedup_multi_index_unref(idx);
+}
+
 /*****************************************************************************/
 
 static NMConnection *
@@ -2442,6 +2518,80 @@ test_setting_ip_route_attributes(void)
 #undef TEST_ATTR
 }
 
+#define IP_STR_N_THREADS 4
+#define IP_STR_N_OBJS    200
+
+typedef struct {
+    NMIPAddress **addrs;
+    NMIPRoute **  routes;
+    const char *  strs[IP_STR_N_OBJS][3];
+} IPStrThreadData;
+
+static gpointer
+_ip_str_thread(gpointer user_data)
+{
+    IPStrThreadData *data = user_data;
+    guint            i;
+
+    for (i = 0; i < IP_STR_N_OBJS; i++) {
+        data->strs[i][0] = nm_ip_address_get_address(data->addrs[i]);
+        data->strs[i][1] = nm_ip_route_get_dest(data->routes[i]);
+        data->strs[i][2] = nm_ip_route_get_next_hop(data->routes[i]);
+    }
+    return NULL;
+}
+
+static void
+test_ip_address_route_str_threads(void)
+{
+    NMIPAddress *   addrs[IP_STR_N_OBJS];
+    NMIPRoute *     routes[IP_STR_N_OBJS];
+    IPStrThreadData data[IP_STR_N_THREADS];
+    GThread *       threads[IP_STR_N_THREADS];
+    guint           i;
+    guint           j;
+
+    /* the getters create the strings on demand. Concurrent readers of the same
+     * objects must all get the same string, and none of them may leak. */
+    for (i = 0; i < IP_STR_N_OBJS; i++) {
+        char dest[NM_UTILS_INET_ADDRSTRLEN];
+
+        nm_sprintf_buf(dest, "192.168.%u.0", i);
+        addrs[i]  = nm_ip_address_new(AF_INET6, "1:2:3::4", 64, NULL);
+        routes[i] = nm_ip_route_new(AF_INET, dest, 24, "10.0.0.1", -1, NULL);
+        g_assert(addrs[i]);
+        g_assert(routes[i]);
+    }
+
+    for (j = 0; j < IP_STR_N_THREADS; j++) {
+        data[j] = (IPStrThreadData){
+            .addrs  = addrs,
+            .routes = routes,
+        };
+
+        threads[j] = g_thread_new("ip-str", _ip_str_thread, &data[j]);
+    }
+    for (j = 0; j < IP_STR_N_THREADS; j++)
+        g_thread_join(threads[j]);
+
+    for (i = 0; i < IP_STR_N_OBJS; i++) {
+        char dest[NM_UTILS_INET_ADDRSTRLEN];
+
+        nm_sprintf_buf(dest, "192.168.%u.0", i);
+        g_assert_cmpstr(data[0].strs[i][0], ==, "1:2:3::4");
+        g_assert_cmpstr(data[0].strs[i][1], ==, dest);
+        g_assert_cmpstr(data[0].strs[i][2], ==, "10.0.0.1");
+        for (j = 1; j < IP_STR_N_THREADS; j++) {
+            g_assert(data[j].strs[i][0] == data[0].strs[i][0]);
+            g_assert(data[j].strs[i][1] == data[0].strs[i][1]);
+            g_assert(data[j].strs[i][2] == data[0].strs[i][2]);
+        }
+        g_assert(nm_ip_address_get_address(addrs[i]) == data[0].strs[i][0]);
+        nm_ip_address_unref(addrs[i]);
+        nm_ip_route_unref(routes[i]);
+    }
+}
+
 static void
 test_setting_gsm_apn_spaces(void)
 {
@@ -10650,6 +10800,7 @@ main(int argc, char **argv)
     g_test_add_func("/core/general/test_nm_g_slice_free_fcn", test_nm_g_slice_free_fcn);
     g_test_add_func("/core/general/test_c_list_sort", test_c_list_sort);
     g_test_add_func("/core/general/test_dedup_multi", test_dedup_multi);
+    g_test_add_func("/core/general/test_dedup_multi_stats", test_dedup_multi_stats);
     g_test_add_func("/core/general/test_utils_str_utf8safe", test_utils_str_utf8safe);
     g_test_add_func("/core/general/test_nm_utils_strsplit_set", test_nm_utils_strsplit_set);
     g_test_add_func("/core/general/test_nm_utils_escaped_tokens", test_nm_utils_escaped_tokens);
@@ -10665,6 +10816,8 @@ main(int argc, char **argv)
                     test_setting_ip4_config_address_data);
     g_test_add_func("/core/general/test_setting_ip_route_attributes",
                     test_setting_ip_route_attributes);
+    g_test_add_func("/core/general/test_ip_address_route_str_threads",
+                    test_ip_address_route_str_threads);
     g_test_add_func("/core/general/test_setting_gsm_apn_spaces", test_setting_gsm_apn_spaces);
     g_test_add_func("/core/general/test_setting_gsm_apn_bad_chars", test_setting_gsm_apn_bad_chars);
     g_test_add_func("/core/general/test_setting_gsm_apn_underscore",
@@ -887,6 +887,78 @@ test_bridge_port_vlans(void)
 
 /*****************************************************************************/
 
+static void
+test_read_benchmark(void)
+{
+    /* Loading a profile means parsing it into a GKeyFile and setting the
+     * properties from it with nm_keyfile_read(). Measure how the time to
+     * load a typical profile splits up between the two. */
+    static const char DATA[] = "[connection]\n"
+                               "id=benchmark\n"
+                               "uuid=8d6ac8d3-5b6f-4c3d-9a58-d0e0f2c7a311\n"
+                               "type=ethernet\n"
+                               "interface-name=eth0\n"
+                               "autoconnect-priority=10\n"
+                               "permissions=\n"
+                               "\n"
+                               "[ethernet]\n"
+                               "mac-address=00:11:22:33:44:55\n"
+                               "mtu=1500\n"
+                               "\n"
+                               "[ipv4]\n"
+                               "address1=192.0.2.2/24,192.0.2.1\n"
+                               "address2=198.51.100.2/24\n"
+                               "dns=192.0.2.53;198.51.100.53;\n"
+                               "dns-search=example.com;\n"
+                               "method=manual\n"
+                               "route1=203.0.113.0/24,192.0.2.254,100\n"
+                               "route1_options=table=100\n"
+                               "\n"
+                               "[ipv6]\n"
+                               "addr-gen-mode=stable-privacy\n"
+                               "method=auto\n"
+                               "\n"
+                               "[proxy]\n";
+    const guint                     N   = nmtst_test_quick() ? 1000u : 20000u;
+    nm_auto_unref_keyfile GKeyFile *kf  = NULL;
+    gs_free char *                  msg = NULL;
+    gint64                          t_gkeyfile;
+    gint64                          t_read;
+    gint64                          t_start;
+    guint                           i;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        nm_auto_unref_keyfile GKeyFile *kf2 = g_key_file_new();
+
+        if (!g_key_file_load_from_data(kf2, DATA, NM_STRLEN(DATA), G_KEY_FILE_NONE, NULL))
+            g_assert_not_reached();
+    }
+    t_gkeyfile = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    kf = _keyfile_load_from_data(DATA);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        gs_unref_object NMConnection *con = NULL;
+
+        con = nm_keyfile_read(kf, "/", NM_KEYFILE_HANDLER_FLAGS_NONE, NULL, NULL, NULL);
+        g_assert(NM_IS_CONNECTION(con));
+    }
+    t_read = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    msg = g_strdup_printf("load %u profiles: GKeyFile parser %" G_GINT64_FORMAT
+                          " usec, nm_keyfile_read() %" G_GINT64_FORMAT " usec",
+                          N,
+                          t_gkeyfile / 1000,
+                          t_read / 1000);
+    g_test_message("%s", msg);
+    if (nmtst_is_debug())
+        g_print(">>> %s\n", msg);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -904,6 +976,7 @@ main(int argc, char **argv)
     g_test_add_func("/core/keyfile/test_vpn/1", test_vpn_1);
     g_test_add_func("/core/keyfile/bridge/vlans", test_bridge_vlans);
     g_test_add_func("/core/keyfile/bridge-port/vlans", test_bridge_port_vlans);
+    g_test_add_func("/core/keyfile/read-benchmark", test_read_benchmark);
 
     return g_test_run();
 }
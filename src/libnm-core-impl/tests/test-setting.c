@@ -6,10 +6,12 @@
 #include "libnm-core-impl/nm-default-libnm-core.h"
 
 #include <linux/pkt_sched.h>
+#include <malloc.h>
 #include <net/if.h>
 
 #include "libnm-glib-aux/nm-uuid.h"
 #include "libnm-glib-aux/nm-json-aux.h"
+#include "libnm-glib-aux/nm-time-utils.h"
 #include "libnm-base/nm-ethtool-utils-base.h"
 #include "libnm-core-intern/nm-core-internal.h"
 #include "nm-utils.h"
@@ -2961,6 +2963,46 @@ test_tc_config_tfilter_matchall_mirred(void)
     nm_tc_tfilter_unref(tfilter1);
 }
 
+static void
+test_tc_config_tclass(void)
+{
+    NMTCTclass *tclass1, *tclass2;
+    char *      str;
+    GError *    error = NULL;
+
+    tclass1 =
+        nm_tc_tclass_new("htb", TC_H_MAKE(0x1u << 16, 0x10u), TC_H_MAKE(0x1u << 16, 0), &error);
+    nmtst_assert_success(tclass1, error);
+
+    tclass2 =
+        nm_tc_tclass_new("htb", TC_H_MAKE(0x2u << 16, 0x10u), TC_H_MAKE(0x1u << 16, 0), &error);
+    nmtst_assert_no_success(tclass2, error);
+    g_clear_error(&error);
+
+    nm_tc_tclass_set_attribute(tclass1, "rate", g_variant_new_uint64(125000));
+    nm_tc_tclass_set_attribute(tclass1, "ceil", g_variant_new_uint64(250000));
+
+    str = nm_utils_tc_tclass_to_str(tclass1, &error);
+    nmtst_assert_success(str, error);
+    g_assert_cmpstr(str, ==, "classid 1:10 parent 1: htb ceil 250000 rate 125000");
+
+    tclass2 = nm_utils_tc_tclass_from_str(str, &error);
+    nmtst_assert_success(tclass2, error);
+    g_free(str);
+
+    g_assert(nm_tc_tclass_equal(tclass1, tclass2));
+    g_assert_cmpint(g_variant_get_uint64(nm_tc_tclass_get_attribute(tclass2, "rate")),
+                    ==,
+                    125000);
+
+    nm_tc_tclass_unref(tclass2);
+    tclass2 = nm_utils_tc_tclass_from_str("classid 1:10 handle 1: htb", &error);
+    nmtst_assert_no_success(tclass2, error);
+    g_clear_error(&error);
+
+    nm_tc_tclass_unref(tclass1);
+}
+
 static void
 test_tc_config_setting_valid(void)
 {
@@ -4423,6 +4465,21 @@ check_done:;
             g_assert(!sip->property_type->from_dbus_fcn
                      || !sip->property_type->gprop_from_dbus_fcn);
 
+            if (sip->property_type->compare_fcn) {
+                g_assert(sip->param_spec);
+                if (sip->property_type->compare_fcn == _nm_setting_property_compare_fcn_gprop)
+                    g_assert(sip->property_type->to_dbus_fcn
+                             == _nm_setting_property_to_dbus_fcn_gprop);
+                else if (sip->property_type->compare_fcn
+                         == _nm_setting_property_compare_fcn_get_boolean)
+                    g_assert(sip->property_type->to_dbus_fcn
+                             == _nm_setting_property_to_dbus_fcn_get_boolean);
+                else if (sip->property_type->compare_fcn
+                         == _nm_setting_property_compare_fcn_get_string)
+                    g_assert(sip->property_type->to_dbus_fcn
+                             == _nm_setting_property_to_dbus_fcn_get_string);
+            }
+
             if (!g_hash_table_insert(h_properties, (char *) sip->name, sip->param_spec))
                 g_assert_not_reached();
 
@@ -4695,6 +4752,316 @@ test_setting_connection_secondaries_verify(void)
 
 /*****************************************************************************/
 
+#define _bench_print(t_start, what, n)                                                \
+    G_STMT_START                                                                     \
+    {                                                                                \
+        const gint64 _t = nm_utils_get_monotonic_timestamp_nsec() - (t_start);       \
+                                                                                     \
+        if (nmtst_is_debug()) {                                                      \
+            g_print(">>> %-12s %6u objects in %4ld.%06ld msec\n",                    \
+                    (what),                                                          \
+                    (guint) (n),                                                     \
+                    (long) (_t / NM_UTILS_NSEC_PER_MSEC),                            \
+                    (long) (_t % NM_UTILS_NSEC_PER_MSEC));                           \
+        }                                                                            \
+    }                                                                                \
+    G_STMT_END
+
+static gsize
+_heap_in_use(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+#define _bench_print_mem(heap_start, what, n)                                      \
+    G_STMT_START                                                                   \
+    {                                                                              \
+        const gssize _m = (gssize) _heap_in_use() - (gssize) (heap_start);         \
+        gs_free char *_msg = NULL;                                                 \
+                                                                                   \
+        _msg = g_strdup_printf("%-12s %6u objects use %zd bytes (%zd per object)", \
+                               (what),                                             \
+                               (guint) (n),                                        \
+                               _m,                                                 \
+                               _m / (gssize) (n));                                 \
+        g_test_message("%s", _msg);                                                \
+        if (nmtst_is_debug())                                                      \
+            g_print(">>> %s\n", _msg);                                             \
+    }                                                                              \
+    G_STMT_END
+
+static void
+test_ip_route_many(gconstpointer test_data)
+{
+    const int                     addr_family = GPOINTER_TO_INT(test_data);
+    const guint                   N           = nmtst_test_quick() ? 2000u : 20000u;
+    gs_unref_object NMConnection *con         = NULL;
+    gs_unref_object NMConnection *con2        = NULL;
+    gs_unref_variant GVariant *routes_var     = NULL;
+    gs_unref_ptrarray GPtrArray *routes       = NULL;
+    gs_unref_ptrarray GPtrArray *routes2      = NULL;
+    gs_unref_ptrarray GPtrArray *addrs        = NULL;
+    NMSettingIPConfig *          s_ip;
+    gint64                       t_start;
+    gsize                        heap_start;
+    guint                        i;
+
+    routes = g_ptr_array_new_full(N, (GDestroyNotify) nm_ip_route_unref);
+    addrs  = g_ptr_array_new_full(N / 10u, (GDestroyNotify) nm_ip_address_unref);
+
+    heap_start = _heap_in_use();
+    t_start    = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        char       dest[NM_UTILS_INET_ADDRSTRLEN];
+        char       src[NM_UTILS_INET_ADDRSTRLEN];
+        NMIPRoute *route;
+
+        if (addr_family == AF_INET) {
+            nm_sprintf_buf(dest, "10.%u.%u.0", (i >> 8) & 0xFFu, i & 0xFFu);
+            nm_sprintf_buf(src, "192.168.%u.%u", (i >> 8) & 0xFFu, i & 0xFFu);
+        } else {
+            nm_sprintf_buf(dest, "2001:DB8:%x::", i);
+            nm_sprintf_buf(src, "fd01::%x", i);
+        }
+
+        route = nm_ip_route_new(addr_family,
+                                dest,
+                                addr_family == AF_INET ? 24 : 64,
+                                i % 2 ? NULL : (addr_family == AF_INET ? "10.255.255.1" : "fe80::1"),
+                                i % 3 ? (gint64) -1 : (gint64) (100 + i),
+                                NULL);
+        g_assert(route);
+        nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_TABLE, g_variant_new_uint32(1000));
+        nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_SRC, g_variant_new_string(src));
+        nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_MTU, g_variant_new_uint32(1400));
+        nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_ONLINK, g_variant_new_boolean(TRUE));
+        g_ptr_array_add(routes, route);
+
+        if (i < N / 10u) {
+            NMIPAddress *addr;
+
+            addr = nm_ip_address_new(addr_family, src, addr_family == AF_INET ? 16 : 64, NULL);
+            g_assert(addr);
+            g_ptr_array_add(addrs, addr);
+        }
+    }
+    _bench_print(t_start, "create", N);
+    _bench_print_mem(heap_start, "create", N);
+
+    /* the string accessors still return the canonical string representation. */
+    g_assert_cmpstr(nm_ip_route_get_dest(routes->pdata[1]),
+                    ==,
+                    addr_family == AF_INET ? "10.0.1.0" : "2001:db8:1::");
+    g_assert_cmpstr(nm_ip_route_get_next_hop(routes->pdata[1]), ==, NULL);
+    g_assert_cmpstr(nm_ip_route_get_next_hop(routes->pdata[2]),
+                    ==,
+                    addr_family == AF_INET ? "10.255.255.1" : "fe80::1");
+    nm_ip_route_set_next_hop(routes->pdata[2], NULL);
+    g_assert_cmpstr(nm_ip_route_get_next_hop(routes->pdata[2]), ==, NULL);
+    nm_ip_route_set_next_hop(routes->pdata[2],
+                             addr_family == AF_INET ? "10.255.255.1" : "FE80:0::1");
+    g_assert_cmpstr(nm_ip_route_get_next_hop(routes->pdata[2]),
+                    ==,
+                    addr_family == AF_INET ? "10.255.255.1" : "fe80::1");
+
+    /* attributes are returned sorted by name. */
+    {
+        gs_strfreev char **names = nm_ip_route_get_attribute_names(routes->pdata[0]);
+
+        g_assert_cmpint(NM_PTRARRAY_LEN(names), ==, 4);
+        g_assert_cmpstr(names[0], ==, NM_IP_ROUTE_ATTRIBUTE_MTU);
+        g_assert_cmpstr(names[1], ==, NM_IP_ROUTE_ATTRIBUTE_ONLINK);
+        g_assert_cmpstr(names[2], ==, NM_IP_ROUTE_ATTRIBUTE_SRC);
+        g_assert_cmpstr(names[3], ==, NM_IP_ROUTE_ATTRIBUTE_TABLE);
+    }
+
+    con = nmtst_create_minimal_connection("test-ip-route-many",
+                                          NULL,
+                                          NM_SETTING_WIRED_SETTING_NAME,
+                                          NULL);
+    s_ip = addr_family == AF_INET ? (NMSettingIPConfig *) nm_setting_ip4_config_new()
+                                  : (NMSettingIPConfig *) nm_setting_ip6_config_new();
+    g_object_set(s_ip, NM_SETTING_IP_CONFIG_METHOD, "manual", NULL);
+    nm_connection_add_setting(con, NM_SETTING(s_ip));
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < addrs->len; i++)
+        nm_setting_ip_config_add_address(s_ip, addrs->pdata[i]);
+    for (i = 0; i < routes->len; i++)
+        nm_setting_ip_config_add_route(s_ip, routes->pdata[i]);
+    _bench_print(t_start, "add", N);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    nmtst_connection_normalize(con);
+    nmtst_assert_connection_verifies_without_normalization(con);
+    _bench_print(t_start, "verify", N);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    routes2 = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_route_unref);
+    for (i = 0; i < routes->len; i++)
+        g_ptr_array_add(routes2, nm_ip_route_dup(routes->pdata[i]));
+    _bench_print(t_start, "dup", N);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < routes->len; i++) {
+        g_assert(nm_ip_route_equal_full(routes->pdata[i],
+                                        routes2->pdata[i],
+                                        NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS));
+    }
+    _bench_print(t_start, "equal", N);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    routes_var = nm_utils_ip_routes_to_variant(routes);
+    _bench_print(t_start, "to-variant", N);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    con2 = nmtst_clone_connection(con);
+    _bench_print(t_start, "clone", N);
+
+    nmtst_assert_connection_equals(con, FALSE, con2, FALSE);
+
+    /* the string getters cache their result with the object. Internal users
+     * format into stack buffers instead. Show what the cache would cost. */
+    heap_start = _heap_in_use();
+    for (i = 0; i < routes2->len; i++) {
+        g_assert(nm_ip_route_get_dest(routes2->pdata[i]));
+        nm_ip_route_get_next_hop(routes2->pdata[i]);
+    }
+    _bench_print_mem(heap_start, "get-string", N);
+}
+
+static guint
+_compare_connection_properties(NMConnection *con_a, NMConnection *con_b, gboolean use_default)
+{
+    gs_free NMSetting **settings = NULL;
+    guint               n_settings;
+    guint               n_equal = 0;
+    guint               i, j;
+
+    settings = nm_connection_get_settings(con_a, &n_settings);
+    for (i = 0; i < n_settings; i++) {
+        const NMSettInfoSetting *sett_info =
+            _nm_setting_class_get_sett_info(NM_SETTING_GET_CLASS(settings[i]));
+        NMSetting *set_b = nm_connection_get_setting(con_b, G_OBJECT_TYPE(settings[i]));
+
+        g_assert(set_b);
+
+        for (j = 0; j < sett_info->property_infos_len; j++) {
+            const NMSettInfoProperty *property_info = &sett_info->property_infos[j];
+            NMSettInfoPropCompareFcn  compare_fcn;
+
+            if (!property_info->param_spec)
+                continue;
+
+            compare_fcn = use_default ? _nm_setting_property_compare_fcn_default
+                                      : property_info->property_type->compare_fcn
+                                            ?: _nm_setting_property_compare_fcn_default;
+            if (compare_fcn(sett_info,
+                            j,
+                            con_a,
+                            settings[i],
+                            con_b,
+                            set_b,
+                            NM_SETTING_COMPARE_FLAG_EXACT))
+                n_equal++;
+        }
+    }
+    return n_equal;
+}
+
+static void
+test_connection_compare_many(void)
+{
+    const guint                   N    = nmtst_test_quick() ? 1000u : 20000u;
+    const guint                   RUNS = 20;
+    gs_unref_object NMConnection *con  = NULL;
+    gs_unref_object NMConnection *con2 = NULL;
+    gs_unref_object NMConnection *con3 = NULL;
+    NMSettingIPConfig *           s_ip;
+    NMSettingConnection *         s_con;
+    gint64                        t_start;
+    guint                         n_equal;
+    guint                         i;
+
+    con = nmtst_create_minimal_connection("test-compare-many",
+                                          NULL,
+                                          NM_SETTING_WIRED_SETTING_NAME,
+                                          &s_con);
+    g_object_set(s_con,
+                 NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY,
+                 10,
+                 NM_SETTING_CONNECTION_INTERFACE_NAME,
+                 "eth0",
+                 NULL);
+    s_ip = (NMSettingIPConfig *) nm_setting_ip4_config_new();
+    g_object_set(s_ip,
+                 NM_SETTING_IP_CONFIG_METHOD,
+                 NM_SETTING_IP4_CONFIG_METHOD_AUTO,
+                 NM_SETTING_IP_CONFIG_DHCP_HOSTNAME,
+                 "host",
+                 NM_SETTING_IP_CONFIG_ROUTE_TABLE,
+                 (guint) 100,
+                 NULL);
+    nm_setting_ip_config_add_dns(s_ip, "192.0.2.1");
+    nm_setting_ip_config_add_dns_search(s_ip, "example.com");
+    for (i = 0; i < N; i++) {
+        NMIPRoute *route;
+        char       dest[NM_UTILS_INET_ADDRSTRLEN];
+
+        nm_sprintf_buf(dest, "10.%u.%u.0", (i >> 8) & 0xFFu, i & 0xFFu);
+        route = nm_ip_route_new(AF_INET, dest, 24, "192.0.2.254", -1, NULL);
+        g_assert(route);
+        nm_ip_route_set_attribute(route, NM_IP_ROUTE_ATTRIBUTE_TABLE, g_variant_new_uint32(1000));
+        nm_setting_ip_config_add_route(s_ip, route);
+        nm_ip_route_unref(route);
+    }
+    nm_connection_add_setting(con, NM_SETTING(s_ip));
+    nmtst_connection_normalize(con);
+
+    con2 = nmtst_clone_connection(con);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < RUNS; i++)
+        g_assert(nm_connection_compare(con, con2, NM_SETTING_COMPARE_FLAG_EXACT));
+    _bench_print(t_start, "compare", RUNS);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < RUNS; i++)
+        n_equal = _compare_connection_properties(con, con2, FALSE);
+    _bench_print(t_start, "typed", RUNS);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < RUNS; i++)
+        g_assert_cmpint(n_equal, ==, _compare_connection_properties(con, con2, TRUE));
+    _bench_print(t_start, "via-dbus", RUNS);
+
+    /* modify a few properties and check that both ways to compare agree. */
+    con3 = nmtst_clone_connection(con);
+    g_object_set(nm_connection_get_setting_connection(con3),
+                 NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY,
+                 11,
+                 NM_SETTING_CONNECTION_INTERFACE_NAME,
+                 "eth1",
+                 NULL);
+    g_object_set(nm_connection_get_setting_ip4_config(con3),
+                 NM_SETTING_IP_CONFIG_DHCP_HOSTNAME,
+                 NULL,
+                 NM_SETTING_IP_CONFIG_ROUTE_TABLE,
+                 (guint) 0,
+                 NULL);
+    nm_setting_ip_config_add_dns_search(nm_connection_get_setting_ip4_config(con3), "foo.com");
+    g_assert(!nm_connection_compare(con, con3, NM_SETTING_COMPARE_FLAG_EXACT));
+    n_equal = _compare_connection_properties(con, con3, FALSE);
+    g_assert_cmpint(n_equal, ==, _compare_connection_properties(con, con3, TRUE));
+    g_assert_cmpint(n_equal + 5u, ==, _compare_connection_properties(con, con2, TRUE));
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -4746,6 +5113,7 @@ main(int argc, char **argv)
                     test_tc_config_tfilter_matchall_sdata);
     g_test_add_func("/libnm/settings/tc_config/tfilter/matchall_mirred",
                     test_tc_config_tfilter_matchall_mirred);
+    g_test_add_func("/libnm/settings/tc_config/tclass", test_tc_config_tclass);
     g_test_add_func("/libnm/settings/tc_config/setting/valid", test_tc_config_setting_valid);
     g_test_add_func("/libnm/settings/tc_config/setting/duplicates",
                     test_tc_config_setting_duplicates);
@@ -4800,6 +5168,14 @@ main(int argc, char **argv)
 
     g_test_add_data_func("/libnm/settings/routing-rule/1", GINT_TO_POINTER(0), test_routing_rule);
 
+    g_test_add_data_func("/libnm/settings/ip-route/many/4",
+                         GINT_TO_POINTER(AF_INET),
+                         test_ip_route_many);
+    g_test_add_data_func("/libnm/settings/ip-route/many/6",
+                         GINT_TO_POINTER(AF_INET6),
+                         test_ip_route_many);
+    g_test_add_func("/libnm/settings/compare/many", test_connection_compare_many);
+
     g_test_add_func("/libnm/parse-tc-handle", test_parse_tc_handle);
 
     g_test_add_func("/libnm/test_team_setting", test_team_setting);
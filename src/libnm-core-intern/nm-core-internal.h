@@ -323,7 +323,9 @@ gboolean _nm_setting_wired_is_valid_s390_option_value(const char *name, const ch
 gboolean _nm_ip_route_attribute_validate_all(const NMIPRoute *route, GError **error);
 const char **
 _nm_ip_route_get_attribute_names(const NMIPRoute *route, gboolean sorted, guint *out_length);
-GHashTable *_nm_ip_route_get_attributes(NMIPRoute *route);
+char *_nm_ip_route_format_attributes(const NMIPRoute *route,
+                                     char             attr_separator,
+                                     char             key_value_separator);
 
 NMSriovVF *_nm_utils_sriov_vf_from_strparts(const char *index,
                                             const char *detail,
@@ -544,10 +546,12 @@ gboolean nm_team_link_watchers_equal(const GPtrArray *a, const GPtrArray *b, gbo
 guint32 _nm_utils_parse_tc_handle(const char *str, GError **error);
 void    _nm_utils_string_append_tc_parent(GString *string, const char *prefix, guint32 parent);
 void    _nm_utils_string_append_tc_qdisc_rest(GString *string, NMTCQdisc *qdisc);
+void    _nm_utils_string_append_tc_tclass_rest(GString *string, NMTCTclass *tclass);
 gboolean
 _nm_utils_string_append_tc_tfilter_rest(GString *string, NMTCTfilter *tfilter, GError **error);
 
 GHashTable *_nm_tc_qdisc_get_attributes(NMTCQdisc *qdisc);
+GHashTable *_nm_tc_tclass_get_attributes(NMTCTclass *tclass);
 GHashTable *_nm_tc_action_get_attributes(NMTCAction *action);
 
 /*****************************************************************************/
@@ -666,6 +670,13 @@ typedef gboolean (*NMSettInfoPropMissingFromDBusFcn)(NMSetting *         setting
                                                      const char *        property,
                                                      NMSettingParseFlags parse_flags,
                                                      GError **           error);
+typedef gboolean (*NMSettInfoPropCompareFcn)(const NMSettInfoSetting *sett_info,
+                                             guint                    property_idx,
+                                             NMConnection *           con_a,
+                                             NMSetting *              set_a,
+                                             NMConnection *           con_b,
+                                             NMSetting *              set_b,
+                                             NMSettingCompareFlags    flags);
 typedef GVariant *(*NMSettInfoPropGPropToDBusFcn)(const GValue *from);
 typedef void (*NMSettInfoPropGPropFromDBusFcn)(GVariant *from, GValue *to);
 
@@ -692,6 +703,11 @@ typedef struct {
      * on the GValue value of the GObject property. */
     NMSettInfoPropGPropFromDBusFcn gprop_from_dbus_fcn;
 
+    /* Compares the property of two settings directly, without first converting
+     * them to GVariant. If unset, both values are serialized with @to_dbus_fcn
+     * and the variants are compared. */
+    NMSettInfoPropCompareFcn compare_fcn;
+
     struct {
         union {
             NMSettingPropertyToDBusFcnGPropType gprop_type;
@@ -48,6 +48,38 @@ GVariant *nm_tc_qdisc_get_attribute(NMTCQdisc *qdisc, const char *name);
 NM_AVAILABLE_IN_1_18
 void nm_tc_qdisc_set_attribute(NMTCQdisc *qdisc, const char *name, GVariant *value);
 
+typedef struct NMTCTclass NMTCTclass;
+
+NM_AVAILABLE_IN_1_34
+GType nm_tc_tclass_get_type(void);
+
+NM_AVAILABLE_IN_1_34
+NMTCTclass *nm_tc_tclass_new(const char *kind, guint32 handle, guint32 parent, GError **error);
+
+NM_AVAILABLE_IN_1_34
+void nm_tc_tclass_ref(NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+void nm_tc_tclass_unref(NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+gboolean nm_tc_tclass_equal(NMTCTclass *tclass, NMTCTclass *other);
+
+NM_AVAILABLE_IN_1_34
+NMTCTclass *nm_tc_tclass_dup(NMTCTclass *tclass);
+
+NM_AVAILABLE_IN_1_34
+const char *nm_tc_tclass_get_kind(NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+guint32 nm_tc_tclass_get_handle(NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+guint32 nm_tc_tclass_get_parent(NMTCTclass *tclass);
+
+NM_AVAILABLE_IN_1_34
+const char **nm_tc_tclass_get_attribute_names(NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+GVariant *nm_tc_tclass_get_attribute(NMTCTclass *tclass, const char *name);
+NM_AVAILABLE_IN_1_34
+void nm_tc_tclass_set_attribute(NMTCTclass *tclass, const char *name, GVariant *value);
+
 typedef struct NMTCAction NMTCAction;
 
 NM_AVAILABLE_IN_1_12
@@ -121,6 +153,7 @@ void nm_tc_tfilter_set_action(NMTCTfilter *tfilter, NMTCAction *action);
 #define NM_SETTING_TC_CONFIG_SETTING_NAME "tc"
 
 #define NM_SETTING_TC_CONFIG_QDISCS   "qdiscs"
+#define NM_SETTING_TC_CONFIG_TCLASSES "tclasses"
 #define NM_SETTING_TC_CONFIG_TFILTERS "tfilters"
 
 typedef struct _NMSettingTCConfigClass NMSettingTCConfigClass;
@@ -143,6 +176,20 @@ gboolean nm_setting_tc_config_remove_qdisc_by_value(NMSettingTCConfig *setting,
 NM_AVAILABLE_IN_1_12
 void nm_setting_tc_config_clear_qdiscs(NMSettingTCConfig *setting);
 
+NM_AVAILABLE_IN_1_34
+guint nm_setting_tc_config_get_num_tclasses(NMSettingTCConfig *setting);
+NM_AVAILABLE_IN_1_34
+NMTCTclass *nm_setting_tc_config_get_tclass(NMSettingTCConfig *setting, guint idx);
+NM_AVAILABLE_IN_1_34
+gboolean nm_setting_tc_config_add_tclass(NMSettingTCConfig *setting, NMTCTclass *tclass);
+NM_AVAILABLE_IN_1_34
+void nm_setting_tc_config_remove_tclass(NMSettingTCConfig *setting, guint idx);
+NM_AVAILABLE_IN_1_34
+gboolean nm_setting_tc_config_remove_tclass_by_value(NMSettingTCConfig *setting,
+                                                     NMTCTclass *       tclass);
+NM_AVAILABLE_IN_1_34
+void nm_setting_tc_config_clear_tclasses(NMSettingTCConfig *setting);
+
 NM_AVAILABLE_IN_1_12
 guint nm_setting_tc_config_get_num_tfilters(NMSettingTCConfig *setting);
 NM_AVAILABLE_IN_1_12
@@ -228,6 +228,11 @@ NMTCQdisc *nm_utils_tc_qdisc_from_str(const char *str, GError **error);
 NM_AVAILABLE_IN_1_12
 char *nm_utils_tc_qdisc_to_str(NMTCQdisc *qdisc, GError **error);
 
+NM_AVAILABLE_IN_1_34
+NMTCTclass *nm_utils_tc_tclass_from_str(const char *str, GError **error);
+NM_AVAILABLE_IN_1_34
+char *nm_utils_tc_tclass_to_str(NMTCTclass *tclass, GError **error);
+
 NM_AVAILABLE_IN_1_12
 NMTCAction *nm_utils_tc_action_from_str(const char *str, GError **error);
 NM_AVAILABLE_IN_1_12
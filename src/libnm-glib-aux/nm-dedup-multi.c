@@ -26,14 +26,240 @@ typedef struct {
     bool                       lookup_head;
 } LookupEntry;
 
+/* A hash set with open addressing and linear probing. The slots only hold the
+ * pointers to the elements, the hash of each element is cached inside the
+ * element itself at @hash_offset. That way, growing the table or probing
+ * does not need to call the (expensive) hash functions of the idx-type, and
+ * the equal function is only called for elements with matching hash. */
+typedef struct {
+    gconstpointer *slots;
+    guint          n_slots;
+    guint          len;
+    guint          hash_offset;
+} DedupTable;
+
+/* The NMDedupMultiEntry instances are numerous and small. Allocate them in
+ * chunks to save the per-allocation overhead. An entry finds its chunk via its
+ * position in the chunk (@_chunk_idx). */
+#define ENTRY_CHUNK_N_ENTRIES 256u
+
+typedef struct {
+    CList              lst_chunks;
+    NMDedupMultiEntry *free_list;
+    guint              n_used;
+    guint              n_init;
+    NMDedupMultiEntry  entries[ENTRY_CHUNK_N_ENTRIES];
+} EntryChunk;
+
+G_STATIC_ASSERT(ENTRY_CHUNK_N_ENTRIES <= ((guint) G_MAXUINT16) + 1u);
+
 struct _NMDedupMultiIndex {
-    int         ref_count;
-    GHashTable *idx_entries;
-    GHashTable *idx_objs;
+    int        ref_count;
+    DedupTable idx_entries;
+    DedupTable idx_objs;
+
+    /* the chunks that have unused entries. Full chunks are not tracked.
+     * A chunk that becomes empty is freed, except for one that is kept
+     * in @entry_chunk_spare. */
+    CList       lst_entry_chunks;
+    EntryChunk *entry_chunk_spare;
+    guint       n_entry_chunks;
+
+    /* statistics. These are plain counters, so that they can be always on. */
+    guint   n_head_entries;
+    guint64 intern_hits;
+    guint64 intern_misses;
+    guint64 entries_added;
+    guint64 entries_removed;
 };
 
 /*****************************************************************************/
 
+#define _table_elem_hash(table, elem) \
+    (*((const guint *) (((const char *) (elem)) + (table)->hash_offset)))
+
+static gconstpointer
+_table_lookup(const DedupTable *table, guint hash, gconstpointer key, GEqualFunc equal)
+{
+    const guint mask = table->n_slots - 1u;
+    guint       i;
+
+    if (table->len == 0)
+        return NULL;
+
+    for (i = hash & mask;; i = (i + 1u) & mask) {
+        gconstpointer elem = table->slots[i];
+
+        if (!elem)
+            return NULL;
+        if (_table_elem_hash(table, elem) == hash && equal(elem, key))
+            return elem;
+    }
+}
+
+static gboolean
+_table_contains(const DedupTable *table, gconstpointer elem)
+{
+    const guint mask = table->n_slots - 1u;
+    guint       i;
+
+    if (table->len == 0)
+        return FALSE;
+
+    for (i = _table_elem_hash(table, elem) & mask; table->slots[i]; i = (i + 1u) & mask) {
+        if (table->slots[i] == elem)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+_table_insert(DedupTable *table, gconstpointer elem)
+{
+    const guint mask = table->n_slots - 1u;
+    guint       i;
+
+    for (i = _table_elem_hash(table, elem) & mask; table->slots[i]; i = (i + 1u) & mask)
+        nm_assert(table->slots[i] != elem);
+    table->slots[i] = elem;
+}
+
+static void
+_table_resize(DedupTable *table, guint n_slots)
+{
+    gconstpointer *old_slots   = table->slots;
+    guint          old_n_slots = table->n_slots;
+    guint          i;
+
+    nm_assert(nm_utils_is_power_of_two(n_slots));
+    nm_assert(n_slots > table->len);
+
+    table->slots   = g_new0(gconstpointer, n_slots);
+    table->n_slots = n_slots;
+    for (i = 0; i < old_n_slots; i++) {
+        if (old_slots[i])
+            _table_insert(table, old_slots[i]);
+    }
+    g_free(old_slots);
+}
+
+static void
+_table_add(DedupTable *table, gconstpointer elem)
+{
+    /* keep the load factor at most 3/4. */
+    if ((table->len + 1u) * 4u > table->n_slots * 3u)
+        _table_resize(table, NM_MAX(table->n_slots * 2u, 16u));
+    _table_insert(table, elem);
+    table->len++;
+}
+
+static void
+_table_remove(DedupTable *table, gconstpointer elem)
+{
+    const guint mask = table->n_slots - 1u;
+    guint       i;
+    guint       j;
+
+    nm_assert(table->len > 0);
+
+    for (i = _table_elem_hash(table, elem) & mask; table->slots[i] != elem; i = (i + 1u) & mask)
+        nm_assert(table->slots[i]);
+
+    /* backward shift deletion. Move the following elements of the cluster into
+     * the gap, unless their home slot lies cyclically in (i, j]. Then no
+     * tombstones are needed. */
+    for (j = (i + 1u) & mask; table->slots[j]; j = (j + 1u) & mask) {
+        const guint k = _table_elem_hash(table, table->slots[j]) & mask;
+
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        table->slots[i] = table->slots[j];
+        i               = j;
+    }
+    table->slots[i] = NULL;
+    table->len--;
+
+    if (table->n_slots > 16u && table->len * 8u < table->n_slots)
+        _table_resize(table, table->n_slots / 2u);
+}
+
+/*****************************************************************************/
+
+static EntryChunk *
+_entry_get_chunk(const NMDedupMultiEntry *entry)
+{
+    EntryChunk *chunk;
+
+    chunk = (EntryChunk *) (((char *) (entry - entry->_chunk_idx))
+                            - G_STRUCT_OFFSET(EntryChunk, entries));
+    nm_assert(&chunk->entries[entry->_chunk_idx] == entry);
+    return chunk;
+}
+
+static NMDedupMultiEntry *
+_entry_alloc(NMDedupMultiIndex *self)
+{
+    EntryChunk *       chunk;
+    NMDedupMultiEntry *entry;
+
+    chunk = c_list_first_entry(&self->lst_entry_chunks, EntryChunk, lst_chunks);
+    if (!chunk) {
+        chunk = g_steal_pointer(&self->entry_chunk_spare);
+        if (!chunk) {
+            chunk = g_malloc(sizeof(EntryChunk));
+            self->n_entry_chunks++;
+        }
+        chunk->free_list = NULL;
+        chunk->n_used    = 0;
+        chunk->n_init    = 0;
+        c_list_link_front(&self->lst_entry_chunks, &chunk->lst_chunks);
+    }
+
+    if (chunk->free_list) {
+        entry            = chunk->free_list;
+        chunk->free_list = (NMDedupMultiEntry *) entry->lst_entries.next;
+    } else {
+        nm_assert(chunk->n_init < ENTRY_CHUNK_N_ENTRIES);
+        entry = &chunk->entries[chunk->n_init++];
+    }
+
+    if (++chunk->n_used == ENTRY_CHUNK_N_ENTRIES)
+        c_list_unlink(&chunk->lst_chunks);
+
+    *entry = (NMDedupMultiEntry){
+        ._chunk_idx = entry - chunk->entries,
+    };
+    return entry;
+}
+
+static void
+_entry_free(NMDedupMultiIndex *self, NMDedupMultiEntry *entry)
+{
+    EntryChunk *chunk = _entry_get_chunk(entry);
+
+    nm_assert(chunk->n_used > 0);
+
+    if (chunk->n_used-- == ENTRY_CHUNK_N_ENTRIES)
+        c_list_link_tail(&self->lst_entry_chunks, &chunk->lst_chunks);
+
+    if (chunk->n_used == 0) {
+        /* keep one empty chunk around, so that adding and removing a single
+         * entry does not allocate each time. */
+        c_list_unlink(&chunk->lst_chunks);
+        if (self->entry_chunk_spare) {
+            g_free(chunk);
+            self->n_entry_chunks--;
+        } else
+            self->entry_chunk_spare = chunk;
+        return;
+    }
+
+    entry->lst_entries.next = (CList *) chunk->free_list;
+    chunk->free_list        = entry;
+}
+
+/*****************************************************************************/
+
 static void
 ASSERT_idx_type(const NMDedupMultiIdxType *idx_type)
 {
@@ -64,6 +290,8 @@ nm_dedup_multi_idx_type_init(NMDedupMultiIdxType *idx_type, const NMDedupMultiId
 
 /*****************************************************************************/
 
+static gpointer _idx_entries_lookup(const NMDedupMultiIndex *self, gconstpointer entry);
+
 static NMDedupMultiEntry *
 _entry_lookup_obj(const NMDedupMultiIndex *  self,
                   const NMDedupMultiIdxType *idx_type,
@@ -76,7 +304,7 @@ _entry_lookup_obj(const NMDedupMultiIndex *  self,
     };
 
     ASSERT_idx_type(idx_type);
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
+    return _idx_entries_lookup(self, &stack_entry);
 }
 
 static NMDedupMultiHeadEntry *
@@ -100,11 +328,11 @@ _entry_lookup_head(const NMDedupMultiIndex *  self,
             nm_assert(c_list_length(&idx_type->lst_idx_head) == 1);
             head_entry = c_list_entry(idx_type->lst_idx_head.next, NMDedupMultiHeadEntry, lst_idx);
         }
-        nm_assert(head_entry == g_hash_table_lookup(self->idx_entries, &stack_entry));
+        nm_assert(head_entry == _idx_entries_lookup(self, &stack_entry));
         return head_entry;
     }
 
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
+    return _idx_entries_lookup(self, &stack_entry);
 }
 
 static void
@@ -126,6 +354,8 @@ _entry_unpack(const NMDedupMultiEntry *   entry,
                          == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, idx_type));
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, is_head)
                          == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, is_head));
+    G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, _hash)
+                         == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, _hash));
 
     if (!entry->lst_entries.next) {
         /* the entry is stack-allocated by _entry_lookup(). */
@@ -168,7 +398,10 @@ _dict_idx_entries_hash(const NMDedupMultiEntry *entry)
 
     _entry_unpack(entry, &idx_type, &obj, &lookup_head);
 
-    nm_hash_init(&h, 1914869417u);
+    if (idx_type->klass->idx_obj_hash_fast)
+        nm_hash_init_fast(&h, 1914869417u);
+    else
+        nm_hash_init(&h, 1914869417u);
     if (idx_type->klass->idx_obj_partition_hash_update) {
         nm_assert(obj);
         idx_type->klass->idx_obj_partition_hash_update(idx_type, obj, &h);
@@ -200,6 +433,16 @@ _dict_idx_entries_equal(const NMDedupMultiEntry *entry_a, const NMDedupMultiEntr
     return TRUE;
 }
 
+static gpointer
+_idx_entries_lookup(const NMDedupMultiIndex *self, gconstpointer entry)
+{
+    /* @entry is either a stack-allocated LookupEntry or an entry of the index. */
+    return (gpointer) _table_lookup(&self->idx_entries,
+                                    _dict_idx_entries_hash(entry),
+                                    entry,
+                                    (GEqualFunc) _dict_idx_entries_equal);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -330,7 +573,7 @@ _add(NMDedupMultiIndex *       self,
         nm_assert(c_list_contains(&entry_order->lst_entries, &head_entry->lst_entries_head));
     }
 
-    entry       = g_slice_new0(NMDedupMultiEntry);
+    entry       = _entry_alloc(self);
     entry->obj  = obj_new;
     entry->head = head_entry;
 
@@ -353,11 +596,18 @@ _add(NMDedupMultiIndex *       self,
     idx_type->len++;
     head_entry->len++;
 
-    if (add_head_entry && !g_hash_table_add(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    if (add_head_entry) {
+        nm_assert(!_idx_entries_lookup(self, head_entry));
+        head_entry->_hash = _dict_idx_entries_hash((const NMDedupMultiEntry *) head_entry);
+        _table_add(&self->idx_entries, head_entry);
+        self->n_head_entries++;
+    }
+
+    nm_assert(!_idx_entries_lookup(self, entry));
+    entry->_hash = _dict_idx_entries_hash(entry);
+    _table_add(&self->idx_entries, entry);
 
-    if (!g_hash_table_add(self->idx_entries, entry))
-        nm_assert_not_reached();
+    self->entries_added++;
 
     NM_SET_OUT(out_entry, entry);
     NM_SET_OUT(out_obj_old, NULL);
@@ -479,14 +729,14 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
     nm_assert(entry->obj);
     nm_assert(entry->head);
     nm_assert(!c_list_is_empty(&entry->lst_entries));
-    nm_assert(g_hash_table_lookup(self->idx_entries, entry) == entry);
+    nm_assert(_table_contains(&self->idx_entries, entry));
 
     head_entry = (NMDedupMultiHeadEntry *) entry->head;
     obj        = entry->obj;
 
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_table_contains(&self->idx_entries, head_entry));
 
     idx_type = (NMDedupMultiIdxType *) head_entry->idx_type;
     ASSERT_idx_type(idx_type);
@@ -500,14 +750,18 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
 
     NM_SET_OUT(out_head_entry_removed, head_entry != NULL);
 
-    if (!g_hash_table_remove(self->idx_entries, entry))
-        nm_assert_not_reached();
+    _table_remove(&self->idx_entries, entry);
 
-    if (head_entry && !g_hash_table_remove(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    self->entries_removed++;
+
+    if (head_entry) {
+        _table_remove(&self->idx_entries, head_entry);
+        nm_assert(self->n_head_entries > 0);
+        self->n_head_entries--;
+    }
 
     c_list_unlink_stale(&entry->lst_entries);
-    g_slice_free(NMDedupMultiEntry, entry);
+    _entry_free(self, entry);
 
     if (head_entry) {
         nm_assert(c_list_is_empty(&head_entry->lst_entries_head));
@@ -532,7 +786,7 @@ _remove_head(NMDedupMultiIndex *    self,
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
     nm_assert(head_entry->len == c_list_length(&head_entry->lst_entries_head));
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_table_contains(&self->idx_entries, head_entry));
 
     n = 0;
     c_list_for_each_safe (iter_entry, iter_entry_safe, &head_entry->lst_entries_head) {
@@ -757,7 +1011,10 @@ _dict_idx_objs_hash(const NMDedupMultiObj *obj)
 {
     NMHashState h;
 
-    nm_hash_init(&h, 1748638583u);
+    if (obj->klass->obj_full_hash_fast)
+        nm_hash_init_fast(&h, 1748638583u);
+    else
+        nm_hash_init(&h, 1748638583u);
     obj->klass->obj_full_hash_update(obj, &h);
     return nm_hash_complete(&h);
 }
@@ -775,12 +1032,11 @@ nm_dedup_multi_index_obj_release(NMDedupMultiIndex *                         sel
 {
     nm_assert(self);
     nm_assert(obj);
-    nm_assert(g_hash_table_lookup(self->idx_objs, obj) == obj);
+    nm_assert(_table_contains(&self->idx_objs, obj));
     nm_assert(((const NMDedupMultiObj *) obj)->_multi_idx == self);
 
     ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
-    if (!g_hash_table_remove(self->idx_objs, obj))
-        nm_assert_not_reached();
+    _table_remove(&self->idx_objs, obj);
 }
 
 gconstpointer
@@ -790,7 +1046,10 @@ nm_dedup_multi_index_obj_find(NMDedupMultiIndex *                         self,
     g_return_val_if_fail(self, NULL);
     g_return_val_if_fail(obj, NULL);
 
-    return g_hash_table_lookup(self->idx_objs, obj);
+    return _table_lookup(&self->idx_objs,
+                         _dict_idx_objs_hash(obj),
+                         obj,
+                         (GEqualFunc) _dict_idx_objs_equal);
 }
 
 gconstpointer
@@ -799,25 +1058,31 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex *                         self
 {
     const NMDedupMultiObj *obj_new = obj;
     const NMDedupMultiObj *obj_old;
+    guint                  hash;
 
     nm_assert(self);
     nm_assert(obj_new);
 
     if (obj_new->_multi_idx == self) {
-        nm_assert(g_hash_table_lookup(self->idx_objs, obj_new) == obj_new);
+        nm_assert(_table_contains(&self->idx_objs, obj_new));
+        self->intern_hits++;
         nm_dedup_multi_obj_ref(obj_new);
         return obj_new;
     }
 
-    obj_old = g_hash_table_lookup(self->idx_objs, obj_new);
+    hash    = _dict_idx_objs_hash(obj_new);
+    obj_old = _table_lookup(&self->idx_objs, hash, obj_new, (GEqualFunc) _dict_idx_objs_equal);
     nm_assert(obj_old != obj_new);
 
     if (obj_old) {
         nm_assert(obj_old->_multi_idx == self);
+        self->intern_hits++;
         nm_dedup_multi_obj_ref(obj_old);
         return obj_old;
     }
 
+    self->intern_misses++;
+
     if (nm_dedup_multi_obj_needs_clone(obj_new))
         obj_new = nm_dedup_multi_obj_clone(obj_new);
     else
@@ -826,8 +1091,8 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex *                         self
     nm_assert(obj_new);
     nm_assert(!obj_new->_multi_idx);
 
-    if (!g_hash_table_add(self->idx_objs, (gpointer) obj_new))
-        nm_assert_not_reached();
+    ((NMDedupMultiObj *) obj_new)->_hash = hash;
+    _table_add(&self->idx_objs, obj_new);
 
     ((NMDedupMultiObj *) obj_new)->_multi_idx = self;
     return obj_new;
@@ -999,17 +1264,47 @@ nm_dedup_multi_entry_reorder(const NMDedupMultiEntry *entry,
 
 /*****************************************************************************/
 
+void
+nm_dedup_multi_index_get_stats(const NMDedupMultiIndex *self, NMDedupMultiIndexStats *out_stats)
+{
+    guint n_entries;
+
+    g_return_if_fail(self);
+    g_return_if_fail(out_stats);
+
+    /* the head entries are tracked in the same dictionary. */
+    nm_assert(self->idx_entries.len >= self->n_head_entries);
+    n_entries = self->idx_entries.len - self->n_head_entries;
+
+    *out_stats = (NMDedupMultiIndexStats){
+        .n_objs          = self->idx_objs.len,
+        .n_entries       = n_entries,
+        .n_head_entries  = self->n_head_entries,
+        .entries_size    = (self->n_entry_chunks * sizeof(EntryChunk))
+                        + (self->n_head_entries * sizeof(NMDedupMultiHeadEntry)),
+        .tables_size     = (self->idx_entries.n_slots + self->idx_objs.n_slots)
+                        * sizeof(gconstpointer),
+        .intern_hits     = self->intern_hits,
+        .intern_misses   = self->intern_misses,
+        .entries_added   = self->entries_added,
+        .entries_removed = self->entries_removed,
+    };
+}
+
+/*****************************************************************************/
+
 NMDedupMultiIndex *
 nm_dedup_multi_index_new(void)
 {
     NMDedupMultiIndex *self;
 
-    self            = g_slice_new0(NMDedupMultiIndex);
-    self->ref_count = 1;
-    self->idx_entries =
-        g_hash_table_new((GHashFunc) _dict_idx_entries_hash, (GEqualFunc) _dict_idx_entries_equal);
-    self->idx_objs =
-        g_hash_table_new((GHashFunc) _dict_idx_objs_hash, (GEqualFunc) _dict_idx_objs_equal);
+    self  = g_slice_new(NMDedupMultiIndex);
+    *self = (NMDedupMultiIndex){
+        .ref_count        = 1,
+        .idx_entries      = {.hash_offset = G_STRUCT_OFFSET(NMDedupMultiEntry, _hash)},
+        .idx_objs         = {.hash_offset = G_STRUCT_OFFSET(NMDedupMultiObj, _hash)},
+        .lst_entry_chunks = C_LIST_INIT(self->lst_entry_chunks),
+    };
     return self;
 }
 
@@ -1026,10 +1321,10 @@ nm_dedup_multi_index_ref(NMDedupMultiIndex *self)
 NMDedupMultiIndex *
 nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
 {
-    GHashTableIter             iter;
     const NMDedupMultiIdxType *idx_type;
-    NMDedupMultiEntry *        entry;
+    const NMDedupMultiEntry *  entry;
     const NMDedupMultiObj *    obj;
+    guint                      i;
 
     g_return_val_if_fail(self, NULL);
     g_return_val_if_fail(self->ref_count > 0, NULL);
@@ -1038,8 +1333,10 @@ nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
         return NULL;
 
 more:
-    g_hash_table_iter_init(&iter, self->idx_entries);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &entry, NULL)) {
+    for (i = 0; i < self->idx_entries.n_slots; i++) {
+        entry = self->idx_entries.slots[i];
+        if (!entry)
+            continue;
         if (entry->is_head)
             idx_type = ((NMDedupMultiHeadEntry *) entry)->idx_type;
         else
@@ -1048,17 +1345,21 @@ more:
         goto more;
     }
 
-    nm_assert(g_hash_table_size(self->idx_entries) == 0);
+    nm_assert(self->idx_entries.len == 0);
+    nm_assert(c_list_is_empty(&self->lst_entry_chunks));
+    nm_assert(self->n_entry_chunks == (self->entry_chunk_spare ? 1u : 0u));
 
-    g_hash_table_iter_init(&iter, self->idx_objs);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &obj, NULL)) {
+    for (i = 0; i < self->idx_objs.n_slots; i++) {
+        obj = self->idx_objs.slots[i];
+        if (!obj)
+            continue;
         nm_assert(obj->_multi_idx == self);
         ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
     }
-    g_hash_table_remove_all(self->idx_objs);
 
-    g_hash_table_unref(self->idx_entries);
-    g_hash_table_unref(self->idx_objs);
+    g_free(self->idx_entries.slots);
+    g_free(self->idx_objs.slots);
+    g_free(self->entry_chunk_spare);
 
     g_slice_free(NMDedupMultiIndex, self);
     return NULL;
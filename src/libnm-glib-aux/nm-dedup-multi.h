@@ -44,6 +44,10 @@ struct _NMDedupMultiObj {
     };
     NMDedupMultiIndex *_multi_idx;
     guint              _ref_count;
+
+    /* the cached hash of obj_full_hash_update(). Only valid while the
+     * object is interned in _multi_idx. */
+    guint _hash;
 };
 
 struct _NMDedupMultiObjClass {
@@ -59,6 +63,10 @@ struct _NMDedupMultiObjClass {
      * and obj_full_equal() compare *all* fields of the object, even minor ones. */
     void (*obj_full_hash_update)(const NMDedupMultiObj *obj, struct _NMHashState *h);
     gboolean (*obj_full_equal)(const NMDedupMultiObj *obj_a, const NMDedupMultiObj *obj_b);
+
+    /* hash the interned objects with nm_hash_init_fast() instead of nm_hash_init().
+     * See NMHashFast for when that is appropriate. */
+    bool obj_full_hash_fast;
 };
 
 /*****************************************************************************/
@@ -160,6 +168,10 @@ struct _NMDedupMultiIdxTypeClass {
     gboolean (*idx_obj_partition_equal)(const NMDedupMultiIdxType *idx_type,
                                         const NMDedupMultiObj *    obj_a,
                                         const NMDedupMultiObj *    obj_b);
+
+    /* hash the index entries with nm_hash_init_fast() instead of nm_hash_init().
+     * See NMHashFast for when that is appropriate. */
+    bool idx_obj_hash_fast;
 };
 
 static inline gboolean
@@ -197,6 +209,11 @@ struct _NMDedupMultiEntry {
     bool is_head;
     bool dirty;
 
+    /* private fields of NMDedupMultiIndex. The position of the entry in its
+     * allocation chunk and the cached hash in the index. */
+    guint16 _chunk_idx;
+    guint   _hash;
+
     const NMDedupMultiHeadEntry *head;
 };
 
@@ -209,6 +226,8 @@ struct _NMDedupMultiHeadEntry {
 
     bool is_head;
 
+    guint _hash;
+
     guint len;
 
     CList lst_idx;
@@ -244,6 +263,29 @@ NMDedupMultiIndex *nm_dedup_multi_index_new(void);
 NMDedupMultiIndex *nm_dedup_multi_index_ref(NMDedupMultiIndex *self);
 NMDedupMultiIndex *nm_dedup_multi_index_unref(NMDedupMultiIndex *self);
 
+typedef struct {
+    /* the number of interned objects, and the number of entries and head entries
+     * currently in the index. @entries_size is the memory used by the latter
+     * (including the unused slots of partially filled allocation chunks), and
+     * @tables_size is the memory of the hash tables for entries and objects. */
+    guint n_objs;
+    guint n_entries;
+    guint n_head_entries;
+    gsize entries_size;
+    gsize tables_size;
+
+    /* counters since the index was created. An intern "hit" means that
+     * nm_dedup_multi_index_obj_intern() found an equal object already in the
+     * index. */
+    guint64 intern_hits;
+    guint64 intern_misses;
+    guint64 entries_added;
+    guint64 entries_removed;
+} NMDedupMultiIndexStats;
+
+void nm_dedup_multi_index_get_stats(const NMDedupMultiIndex *self,
+                                    NMDedupMultiIndexStats * out_stats);
+
 static inline void
 _nm_auto_unref_dedup_multi_index(NMDedupMultiIndex **v)
 {
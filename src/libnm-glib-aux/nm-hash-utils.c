@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include "libnm-std-aux/unaligned.h"
 #include "nm-shared-utils.h"
 #include "nm-random-utils.h"
 
@@ -126,6 +127,109 @@ nm_hash_siphash42_init(CSipHash *h, guint static_seed)
     c_siphash_init(h, (const guint8 *) &seed);
 }
 
+/*****************************************************************************/
+
+static inline guint64
+_fast_mum(guint64 a, guint64 b)
+{
+    /* multiply to 128 bit and fold the upper and lower half. */
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = ((unsigned __int128) a) * b;
+
+    return ((guint64) r) ^ ((guint64) (r >> 64));
+#else
+    guint64 a_hi = a >> 32;
+    guint64 a_lo = (guint32) a;
+    guint64 b_hi = b >> 32;
+    guint64 b_lo = (guint32) b;
+    guint64 m0   = a_hi * b_lo;
+    guint64 m1   = a_lo * b_hi;
+    guint64 lo   = a_lo * b_lo;
+    guint64 t    = lo + (m0 << 32);
+    guint64 r_lo = t + (m1 << 32);
+    guint64 r_hi = (a_hi * b_hi) + (m0 >> 32) + (m1 >> 32) + (t < lo) + (r_lo < t);
+
+    return r_lo ^ r_hi;
+#endif
+}
+
+#define FAST_P0 ((guint64) 0xa0761d6478bd642full)
+#define FAST_P1 ((guint64) 0xe7037ed1a0b428dbull)
+#define FAST_P2 ((guint64) 0x8ebc6af09c88c6e3ull)
+
+static inline void
+_fast_round(NMHashFast *h, guint64 w)
+{
+    h->h = _fast_mum(h->h ^ w ^ FAST_P0, h->k);
+}
+
+void
+nm_hash_fast_init(NMHashFast *h, guint static_seed)
+{
+    const guint8 *g;
+    union {
+        guint64 v64[HASH_KEY_SIZE / sizeof(guint64)];
+        guint   arr[HASH_KEY_SIZE_GUINT];
+    } seed;
+
+    nm_assert(h);
+
+    g = _get_hash_key();
+    memcpy(&seed, g, HASH_KEY_SIZE);
+    seed.arr[0] ^= static_seed;
+
+    /* the multiplier must be odd, otherwise every round would shift
+     * out low bits. */
+    *h = (NMHashFast){
+        .h = seed.v64[0] ^ FAST_P1,
+        .k = (seed.v64[1] ^ FAST_P2) | 1u,
+    };
+}
+
+void
+nm_hash_fast_append(NMHashFast *h, const void *ptr, gsize n)
+{
+    const guint8 *p = ptr;
+    guint         shift;
+
+    nm_assert(h);
+    nm_assert(n == 0 || ptr);
+
+    /* This gives the same result, regardless how the data is split into
+     * chunks. Bytes that don't fill a whole word are collected in @padding
+     * (in little endian order, like unaligned_read_le64()). */
+    shift = (h->n_bytes & 7u) * 8u;
+    h->n_bytes += n;
+
+    if (shift > 0) {
+        for (; n > 0 && shift < 64; n--, shift += 8)
+            h->padding |= ((guint64) *(p++)) << shift;
+        if (shift < 64)
+            return;
+        _fast_round(h, h->padding);
+        h->padding = 0;
+    }
+
+    for (; n >= 8; n -= 8, p += 8)
+        _fast_round(h, unaligned_read_le64(p));
+
+    for (shift = 0; n > 0; n--, shift += 8)
+        h->padding |= ((guint64) *(p++)) << shift;
+}
+
+guint64
+nm_hash_fast_finalize(NMHashFast *h)
+{
+    nm_assert(h);
+
+    /* Like siphash, the remaining bytes are hashed together with the
+     * length in the most significant byte. */
+    _fast_round(h, h->padding | (((guint64) h->n_bytes) << 56));
+    return _fast_mum(h->h ^ FAST_P1, h->k ^ FAST_P2);
+}
+
+/*****************************************************************************/
+
 guint
 nm_hash_str(const char *str)
 {
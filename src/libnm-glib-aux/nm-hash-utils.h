@@ -45,8 +45,32 @@ nm_hash_siphash42(guint static_seed, const void *ptr, gsize n)
 
 /*****************************************************************************/
 
+/* NMHashFast is a keyed hash that is considerably cheaper than siphash24 for
+ * the short keys that we commonly hash (a few integers or an IP address).
+ * It mixes one 64 bit word with a single 64x64->128 bit multiplication.
+ *
+ * It uses the same randomized, per-run seed as siphash, but it is not designed
+ * to withstand hash flooding by somebody who can observe the hash values.
+ * NMHashState only uses it, when initialized with nm_hash_init_fast(). */
+typedef struct {
+    guint64 h;
+    guint64 k;
+    guint64 padding;
+    gsize   n_bytes;
+} NMHashFast;
+
+void    nm_hash_fast_init(NMHashFast *h, guint static_seed);
+void    nm_hash_fast_append(NMHashFast *h, const void *ptr, gsize n);
+guint64 nm_hash_fast_finalize(NMHashFast *h);
+
+/*****************************************************************************/
+
 struct _NMHashState {
-    CSipHash _state;
+    union {
+        CSipHash   _siphash;
+        NMHashFast _fast;
+    };
+    bool _is_fast;
 };
 
 typedef struct _NMHashState NMHashState;
@@ -58,7 +82,21 @@ nm_hash_init(NMHashState *state, guint static_seed)
 {
     nm_assert(state);
 
-    nm_hash_siphash42_init(&state->_state, static_seed);
+    state->_is_fast = FALSE;
+    nm_hash_siphash42_init(&state->_siphash, static_seed);
+}
+
+/* Like nm_hash_init(), but uses NMHashFast instead of siphash24. That is
+ * cheaper for short keys, but it is not hash flooding resistant. Only use
+ * it for hot hash tables, whose keys are not chosen freely by somebody else,
+ * like the IDs of the platform cache. */
+static inline void
+nm_hash_init_fast(NMHashState *state, guint static_seed)
+{
+    nm_assert(state);
+
+    state->_is_fast = TRUE;
+    nm_hash_fast_init(&state->_fast, static_seed);
 }
 
 static inline guint64
@@ -72,10 +110,13 @@ nm_hash_complete_u64(NMHashState *state)
      * - the type, guint64 vs. guint.
      * - nm_hash_complete() never returns zero.
      *
-     * In practice, nm_hash*() API is implemented via siphash24, so this returns
-     * the siphash24 value. But that is not guaranteed by the API, and if you need
-     * siphash24 directly, use c_siphash_*() and nm_hash_siphash42*() API. */
-    return c_siphash_finalize(&state->_state);
+     * In practice, nm_hash_init() is implemented via siphash24, so this returns
+     * the siphash24 value (unlike nm_hash_init_fast()). But that is not guaranteed
+     * by the API, and if you need siphash24 directly, use c_siphash_*() and
+     * nm_hash_siphash42*() API. */
+    if (state->_is_fast)
+        return nm_hash_fast_finalize(&state->_fast);
+    return c_siphash_finalize(&state->_siphash);
 }
 
 static inline guint
@@ -101,8 +142,12 @@ nm_hash_update(NMHashState *state, const void *ptr, gsize n)
      * that we should nm_explicit_bzero() afterwards. However, since
      * we are using siphash24 with a random key, that is not really
      * necessary. Something to keep in mind, if we ever move away from
-     * this hash implementation. */
-    c_siphash_append(&state->_state, ptr, n);
+     * this hash implementation. NMHashFast also uses a random key, but
+     * it is not a cryptographic hash. */
+    if (state->_is_fast)
+        nm_hash_fast_append(&state->_fast, ptr, n);
+    else
+        c_siphash_append(&state->_siphash, ptr, n);
 }
 
 #define nm_hash_update_val(state, val)                \
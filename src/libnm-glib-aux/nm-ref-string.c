@@ -6,11 +6,39 @@
 
 /*****************************************************************************/
 
-G_LOCK_DEFINE_STATIC(gl_lock);
-static GHashTable *gl_hash;
+/* The interned strings are distributed over several shards by their hash.
+ * Each shard has its own lock and hash table, so threads that intern
+ * different strings rarely contend for the same lock.
+ *
+ * Taking a reference, and dropping one that is not the last, does not take
+ * any lock (see nm_ref_string_ref() and nm_ref_string_unref()). */
+#define N_SHARDS 32u
+
+typedef struct {
+    GMutex      lock;
+    GHashTable *hash;
+} _nm_align(64) RefStringShard;
+
+static RefStringShard gl_shards[N_SHARDS];
+
+static RefStringShard *
+_shard_get(guint hash)
+{
+    /* GHashTable uses the lower bits of the hash, use the higher bits for
+     * selecting the shard. */
+    return &gl_shards[(hash >> 24) % N_SHARDS];
+}
 
 /*****************************************************************************/
 
+static guint
+_ref_string_hash(gconstpointer ptr)
+{
+    const NMRefString *rstr = ptr;
+
+    return rstr->len == G_MAXSIZE ? rstr->_priv_lookup.l_hash : rstr->_hash;
+}
+
 static void
 _ref_string_get(const NMRefString *rstr, const char **out_str, gsize *out_len)
 {
@@ -23,16 +51,6 @@ _ref_string_get(const NMRefString *rstr, const char **out_str, gsize *out_len)
     }
 }
 
-static guint
-_ref_string_hash(gconstpointer ptr)
-{
-    const char *cstr;
-    gsize       len;
-
-    _ref_string_get(ptr, &cstr, &len);
-    return nm_hash_mem(1463435489u, cstr, len);
-}
-
 static gboolean
 _ref_string_equal(gconstpointer ptr_a, gconstpointer ptr_b)
 {
@@ -41,6 +59,9 @@ _ref_string_equal(gconstpointer ptr_a, gconstpointer ptr_b)
     gsize       len_a;
     gsize       len_b;
 
+    if (_ref_string_hash(ptr_a) != _ref_string_hash(ptr_b))
+        return FALSE;
+
     _ref_string_get(ptr_a, &cstr_a, &len_a);
     _ref_string_get(ptr_b, &cstr_b, &len_b);
 
@@ -69,13 +90,17 @@ _nm_assert_nm_ref_string(NMRefString *rstr)
     nm_assert(rstr->str[rstr->len] == '\0');
 
     if (NM_MORE_ASSERTS > 10) {
-        G_LOCK(gl_lock);
+        RefStringShard *shard = _shard_get(rstr->_hash);
+
+        nm_assert(rstr->_hash == nm_hash_mem(1463435489u, rstr->str, rstr->len));
+
+        g_mutex_lock(&shard->lock);
         r = g_atomic_int_get(&rstr->_ref_count);
         nm_assert(r > 0);
         nm_assert(r < G_MAXINT);
 
-        nm_assert(rstr == g_hash_table_lookup(gl_hash, rstr));
-        G_UNLOCK(gl_lock);
+        nm_assert(rstr == g_hash_table_lookup(shard->hash, rstr));
+        g_mutex_unlock(&shard->lock);
     }
 }
 
@@ -123,36 +148,45 @@ _nm_assert_nm_ref_string(NMRefString *rstr)
 NMRefString *
 nm_ref_string_new_len(const char *cstr, gsize len)
 {
-    NMRefString *rstr;
+    RefStringShard *shard;
+    NMRefString *   rstr;
+    guint           hash;
 
     /* @len cannot be close to G_MAXSIZE. For one, that would mean our call
      * to malloc() below overflows. Also, we use G_MAXSIZE as special length
      * to indicate using _priv_lookup. */
     nm_assert(len < G_MAXSIZE - G_STRUCT_OFFSET(NMRefString, str) - 1u);
 
-    G_LOCK(gl_lock);
+    /* hash outside the lock. */
+    hash  = nm_hash_mem(1463435489u, cstr, len);
+    shard = _shard_get(hash);
 
-    if (G_UNLIKELY(!gl_hash)) {
-        gl_hash = g_hash_table_new_full(_ref_string_hash, _ref_string_equal, g_free, NULL);
-        rstr    = NULL;
+    g_mutex_lock(&shard->lock);
+
+    if (G_UNLIKELY(!shard->hash)) {
+        shard->hash = g_hash_table_new_full(_ref_string_hash, _ref_string_equal, g_free, NULL);
+        rstr        = NULL;
     } else {
         NMRefString rr_lookup = {
             .len = G_MAXSIZE,
             ._priv_lookup =
                 {
-                    .l_len = len,
-                    .l_str = cstr,
+                    .l_len  = len,
+                    .l_str  = cstr,
+                    .l_hash = hash,
                 },
         };
 
-        rstr = g_hash_table_lookup(gl_hash, &rr_lookup);
+        rstr = g_hash_table_lookup(shard->hash, &rr_lookup);
     }
 
     if (rstr) {
+        /* the last reference is only dropped while holding the lock of the
+         * shard. So the instance is alive, and we can take a reference. */
         nm_assert(({
             int r = g_atomic_int_get(&rstr->_ref_count);
 
-            (r >= 0 && r < G_MAXINT);
+            (r > 0 && r < G_MAXINT);
         }));
         g_atomic_int_inc(&rstr->_ref_count);
     } else {
@@ -161,13 +195,14 @@ nm_ref_string_new_len(const char *cstr, gsize len)
             memcpy((char *) rstr->str, cstr, len);
         ((char *) rstr->str)[len] = '\0';
         *((gsize *) &rstr->len)   = len;
+        *((guint *) &rstr->_hash) = hash;
         rstr->_ref_count          = 1;
 
-        if (!g_hash_table_add(gl_hash, rstr))
+        if (!g_hash_table_add(shard->hash, rstr))
             nm_assert_not_reached();
     }
 
-    G_UNLOCK(gl_lock);
+    g_mutex_unlock(&shard->lock);
 
     return rstr;
 }
@@ -175,16 +210,18 @@ nm_ref_string_new_len(const char *cstr, gsize len)
 void
 _nm_ref_string_unref_slow_path(NMRefString *rstr)
 {
-    G_LOCK(gl_lock);
+    RefStringShard *shard = _shard_get(rstr->_hash);
+
+    g_mutex_lock(&shard->lock);
 
-    nm_assert(g_hash_table_lookup(gl_hash, rstr) == rstr);
+    nm_assert(g_hash_table_lookup(shard->hash, rstr) == rstr);
 
     if (G_LIKELY(g_atomic_int_dec_and_test(&rstr->_ref_count))) {
-        if (!g_hash_table_remove(gl_hash, rstr))
+        if (!g_hash_table_remove(shard->hash, rstr))
             nm_assert_not_reached();
     }
 
-    G_UNLOCK(gl_lock);
+    g_mutex_unlock(&shard->lock);
 }
 
 /*****************************************************************************/
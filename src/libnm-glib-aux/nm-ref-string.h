@@ -10,7 +10,11 @@ typedef struct _NMRefString {
     union {
         struct {
             volatile int _ref_count;
-            const char   str[];
+
+            /* the hash of the string. It selects the shard of the global
+             * table, and avoids rehashing the string on lookup and resize. */
+            const guint _hash;
+            const char  str[];
         };
         struct {
             /* This union field is only used during lookup by external string.
@@ -18,6 +22,7 @@ typedef struct _NMRefString {
              * are set in _priv_lookup. */
             gsize       l_len;
             const char *l_str;
+            guint       l_hash;
         } _priv_lookup;
     };
 } NMRefString;
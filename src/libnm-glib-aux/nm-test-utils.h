@@ -86,6 +86,7 @@
 #endif
 
 #include <arpa/inet.h>
+#include <sys/socket.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <stdlib.h>
@@ -2857,4 +2858,170 @@ nmtst_ip_address_new(int addr_family, const char *str)
 
 /*****************************************************************************/
 
+/* A minimal HTTP server on the loopback interface, for testing HTTP clients.
+ * It answers every request with the same @response. If @etag is set, the
+ * reply carries it and a request with a matching "If-None-Match" header
+ * gets a 304 (Not Modified). Connections are kept alive until the client
+ * closes them. */
+typedef struct {
+    const char *response;
+    const char *etag;
+    int         listen_fd;
+    int         port;
+    int         n_connections;
+    int         n_requests;
+    int         n_not_modified;
+    GThread *   accept_thread;
+    GPtrArray * conn_threads;
+    GMutex      lock;
+} NMTstHttpServer;
+
+typedef struct {
+    NMTstHttpServer *server;
+    int              fd;
+} _NMTstHttpServerConn;
+
+static inline gpointer
+_nmtst_http_server_conn_thread(gpointer user_data)
+{
+    _NMTstHttpServerConn *conn   = user_data;
+    NMTstHttpServer *     server = conn->server;
+    int                   fd     = conn->fd;
+    char                  buf[4096];
+    gsize                 buf_len = 0;
+
+    g_slice_free(_NMTstHttpServerConn, conn);
+
+    for (;;) {
+        gs_free char *if_none_match = NULL;
+        gs_free char *reply         = NULL;
+        const char *  end;
+        ssize_t       n;
+
+        end = g_strstr_len(buf, buf_len, "\r\n\r\n");
+        if (!end) {
+            g_assert_cmpint(buf_len, <, sizeof(buf));
+            n = read(fd, &buf[buf_len], sizeof(buf) - buf_len);
+            if (n <= 0)
+                break;
+            buf_len += n;
+            continue;
+        }
+
+        g_atomic_int_inc(&server->n_requests);
+
+        if (server->etag)
+            if_none_match = g_strdup_printf("If-None-Match: %s\r\n", server->etag);
+
+        if (if_none_match && g_strstr_len(buf, end - buf, if_none_match)) {
+            g_atomic_int_inc(&server->n_not_modified);
+            reply = g_strdup_printf("HTTP/1.1 304 Not Modified\r\n"
+                                    "ETag: %s\r\n"
+                                    "\r\n",
+                                    server->etag);
+        } else {
+            reply = g_strdup_printf("HTTP/1.1 200 OK\r\n"
+                                    "%s%s%s"
+                                    "Content-Length: %zu\r\n"
+                                    "\r\n"
+                                    "%s",
+                                    NM_PRINT_FMT_QUOTED(server->etag,
+                                                        "ETag: ",
+                                                        server->etag,
+                                                        "\r\n",
+                                                        ""),
+                                    strlen(server->response),
+                                    server->response);
+        }
+
+        buf_len -= (end + 4) - buf;
+        memmove(buf, end + 4, buf_len);
+
+        if (write(fd, reply, strlen(reply)) != (ssize_t) strlen(reply))
+            break;
+    }
+
+    nm_close(fd);
+    return NULL;
+}
+
+static inline gpointer
+_nmtst_http_server_accept_thread(gpointer user_data)
+{
+    NMTstHttpServer *server = user_data;
+
+    for (;;) {
+        _NMTstHttpServerConn *conn;
+        int                   fd;
+
+        fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0)
+            break;
+
+        g_atomic_int_inc(&server->n_connections);
+
+        conn  = g_slice_new(_NMTstHttpServerConn);
+        *conn = (_NMTstHttpServerConn){
+            .server = server,
+            .fd     = fd,
+        };
+
+        g_mutex_lock(&server->lock);
+        g_ptr_array_add(server->conn_threads,
+                        g_thread_new("nmtst-http-conn", _nmtst_http_server_conn_thread, conn));
+        g_mutex_unlock(&server->lock);
+    }
+
+    return NULL;
+}
+
+static inline void
+nmtst_http_server_start(NMTstHttpServer *server, const char *response, const char *etag)
+{
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    socklen_t addr_len = sizeof(addr);
+
+    g_assert(server);
+    g_assert(response);
+
+    *server = (NMTstHttpServer){
+        .response     = response,
+        .etag         = etag,
+        .conn_threads = g_ptr_array_new(),
+    };
+    g_mutex_init(&server->lock);
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    g_assert_cmpint(server->listen_fd, >=, 0);
+    g_assert_cmpint(bind(server->listen_fd, (struct sockaddr *) &addr, sizeof(addr)), ==, 0);
+    g_assert_cmpint(listen(server->listen_fd, 16), ==, 0);
+    g_assert_cmpint(getsockname(server->listen_fd, (struct sockaddr *) &addr, &addr_len), ==, 0);
+    server->port = ntohs(addr.sin_port);
+
+    server->accept_thread =
+        g_thread_new("nmtst-http-accept", _nmtst_http_server_accept_thread, server);
+}
+
+static inline void
+nmtst_http_server_stop(NMTstHttpServer *server)
+{
+    guint i;
+
+    shutdown(server->listen_fd, SHUT_RDWR);
+    g_thread_join(server->accept_thread);
+    nm_close(server->listen_fd);
+
+    /* the caller must have closed the client connections, otherwise this
+     * blocks. */
+    for (i = 0; i < server->conn_threads->len; i++)
+        g_thread_join(server->conn_threads->pdata[i]);
+    g_ptr_array_unref(server->conn_threads);
+    g_mutex_clear(&server->lock);
+}
+
+/*****************************************************************************/
+
 #endif /* __NM_TEST_UTILS_H__ */
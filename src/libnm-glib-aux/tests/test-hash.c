@@ -0,0 +1,519 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include <linux/pkt_sched.h>
+#include <linux/rtnetlink.h>
+
+#include "libnm-glib-aux/nm-dedup-multi.h"
+#include "libnm-glib-aux/nm-time-utils.h"
+
+#include "libnm-glib-aux/nm-test-utils.h"
+
+/*****************************************************************************/
+
+typedef enum {
+    HASH_ALGO_SIPHASH,
+    HASH_ALGO_FAST,
+    HASH_ALGO_NM_HASH,
+    HASH_ALGO_NM_HASH_FAST,
+    _HASH_ALGO_NUM,
+} HashAlgo;
+
+static const char *const hash_algo_names[_HASH_ALGO_NUM] = {
+    [HASH_ALGO_SIPHASH]      = "siphash24",
+    [HASH_ALGO_FAST]         = "fast",
+    [HASH_ALGO_NM_HASH]      = "nm-hash",
+    [HASH_ALGO_NM_HASH_FAST] = "nm-hash-fast",
+};
+
+static guint64
+_hash_one(HashAlgo algo, guint static_seed, const void *ptr, gsize n)
+{
+    switch (algo) {
+    case HASH_ALGO_SIPHASH:
+        return nm_hash_siphash42(static_seed, ptr, n);
+    case HASH_ALGO_FAST:
+    {
+        NMHashFast h;
+
+        nm_hash_fast_init(&h, static_seed);
+        nm_hash_fast_append(&h, ptr, n);
+        return nm_hash_fast_finalize(&h);
+    }
+    case HASH_ALGO_NM_HASH:
+    case HASH_ALGO_NM_HASH_FAST:
+    {
+        NMHashState h;
+
+        if (algo == HASH_ALGO_NM_HASH_FAST)
+            nm_hash_init_fast(&h, static_seed);
+        else
+            nm_hash_init(&h, static_seed);
+        nm_hash_update(&h, ptr, n);
+        return nm_hash_complete_u64(&h);
+    }
+    case _HASH_ALGO_NUM:
+        break;
+    }
+    g_assert_not_reached();
+    return 0;
+}
+
+/*****************************************************************************/
+
+static void
+test_hash_fast_chunks(void)
+{
+    guint8 buf[200];
+    gsize  len;
+
+    nmtst_rand_buf(NULL, buf, sizeof(buf));
+
+    for (len = 0; len <= sizeof(buf); len++) {
+        const guint64 expected = _hash_one(HASH_ALGO_FAST, 1234, buf, len);
+        int           i;
+
+        /* the result does not depend on how the data is split into chunks. */
+        for (i = 0; i < 20; i++) {
+            NMHashFast h;
+            gsize      offset = 0;
+
+            nm_hash_fast_init(&h, 1234);
+            while (offset < len) {
+                gsize n = nmtst_get_rand_uint32() % (len - offset + 1);
+
+                nm_hash_fast_append(&h, &buf[offset], n);
+                offset += n;
+            }
+            g_assert_cmpint(nm_hash_fast_finalize(&h), ==, expected);
+        }
+
+        g_assert_cmpint(_hash_one(HASH_ALGO_FAST, 1234, buf, len), ==, expected);
+        g_assert_cmpint(_hash_one(HASH_ALGO_FAST, 1235, buf, len), !=, expected);
+        if (len > 0)
+            g_assert_cmpint(_hash_one(HASH_ALGO_FAST, 1234, buf, len - 1), !=, expected);
+    }
+}
+
+static void
+test_hash_fast_distribution(void)
+{
+    guint n_buckets[256] = {};
+    guint i;
+
+    /* sequential integers (like ifindexes or addresses in one subnet) must
+     * spread evenly over the buckets, also in the lower bits that GHashTable
+     * uses. */
+    for (i = 0; i < 256u * 256u; i++) {
+        const guint64 h = _hash_one(HASH_ALGO_FAST, 555, &i, sizeof(i));
+
+        n_buckets[(((guint) (h >> 32)) ^ ((guint) h)) % G_N_ELEMENTS(n_buckets)]++;
+    }
+    for (i = 0; i < G_N_ELEMENTS(n_buckets); i++) {
+        g_assert_cmpint(n_buckets[i], >, 128);
+        g_assert_cmpint(n_buckets[i], <, 400);
+    }
+}
+
+static void
+test_hash_state(void)
+{
+    guint8 buf[100];
+    gsize  len;
+
+    nmtst_rand_buf(NULL, buf, sizeof(buf));
+
+    /* NMHashState uses siphash24, unless the user opts in to NMHashFast. */
+    for (len = 0; len <= sizeof(buf); len++) {
+        g_assert_cmpint(_hash_one(HASH_ALGO_NM_HASH, 1234, buf, len),
+                        ==,
+                        _hash_one(HASH_ALGO_SIPHASH, 1234, buf, len));
+        g_assert_cmpint(_hash_one(HASH_ALGO_NM_HASH_FAST, 1234, buf, len),
+                        ==,
+                        _hash_one(HASH_ALGO_FAST, 1234, buf, len));
+    }
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    NMDedupMultiObj parent;
+    guint32         val;
+} HashObj;
+
+static void
+_hash_obj_destroy(NMDedupMultiObj *obj)
+{
+    g_free(obj);
+}
+
+static void
+_hash_obj_full_hash_update(const NMDedupMultiObj *obj, NMHashState *h)
+{
+    nm_hash_update_val(h, ((const HashObj *) obj)->val);
+}
+
+static gboolean
+_hash_obj_full_equal(const NMDedupMultiObj *obj_a, const NMDedupMultiObj *obj_b)
+{
+    return ((const HashObj *) obj_a)->val == ((const HashObj *) obj_b)->val;
+}
+
+static const NMDedupMultiObjClass hash_obj_classes[] = {
+    {
+        .obj_destroy          = _hash_obj_destroy,
+        .obj_full_hash_update = _hash_obj_full_hash_update,
+        .obj_full_equal       = _hash_obj_full_equal,
+    },
+    {
+        .obj_destroy          = _hash_obj_destroy,
+        .obj_full_hash_update = _hash_obj_full_hash_update,
+        .obj_full_equal       = _hash_obj_full_equal,
+        .obj_full_hash_fast   = TRUE,
+    },
+};
+
+static HashObj *
+_hash_obj_new(const NMDedupMultiObjClass *klass, guint32 val)
+{
+    HashObj *obj;
+
+    obj                    = g_new0(HashObj, 1);
+    obj->parent.klass      = klass;
+    obj->parent._ref_count = 1;
+    obj->val               = val;
+    return obj;
+}
+
+static void
+test_hash_dedup_obj(void)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    const HashObj *                                    interned[500];
+    guint                                              k;
+    guint                                              i;
+
+    /* the interned objects are hashed with the hash that their class
+     * selects, and deduplication works the same with both. */
+    for (k = 0; k < G_N_ELEMENTS(hash_obj_classes); k++) {
+        const NMDedupMultiObjClass *klass = &hash_obj_classes[k];
+
+        for (i = 0; i < G_N_ELEMENTS(interned); i++) {
+            HashObj *   obj = _hash_obj_new(klass, i);
+            NMHashState h;
+
+            interned[i] = nm_dedup_multi_index_obj_intern(multi_idx, obj);
+            g_assert(interned[i] == obj);
+            nm_dedup_multi_obj_unref(&obj->parent);
+
+            if (klass->obj_full_hash_fast)
+                nm_hash_init_fast(&h, 1748638583u);
+            else
+                nm_hash_init(&h, 1748638583u);
+            nm_hash_update_val(&h, (guint32) i);
+            g_assert_cmpint(interned[i]->parent._hash, ==, nm_hash_complete(&h));
+        }
+
+        for (i = 0; i < G_N_ELEMENTS(interned); i++) {
+            HashObj *      obj = _hash_obj_new(klass, i);
+            const HashObj *obj2;
+
+            g_assert(nm_dedup_multi_index_obj_find(multi_idx, obj) == interned[i]);
+            obj2 = nm_dedup_multi_index_obj_intern(multi_idx, obj);
+            g_assert(obj2 == interned[i]);
+            nm_dedup_multi_obj_unref(&obj2->parent);
+            nm_dedup_multi_obj_unref(&obj->parent);
+        }
+
+        for (i = 0; i < G_N_ELEMENTS(interned); i++)
+            nm_dedup_multi_obj_unref(&interned[i]->parent);
+    }
+}
+
+/*****************************************************************************/
+
+static volatile guint64 _sink;
+
+static gint64
+_bench_run(HashAlgo algo, const guint8 *keys, gsize key_size, guint n_keys, guint n_iterations)
+{
+    gint64  t_start;
+    guint64 sum = 0;
+    guint   i;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < n_iterations; i++)
+        sum += _hash_one(algo, 1867854211u, &keys[(i % n_keys) * key_size], key_size);
+    _sink = sum;
+    return nm_utils_get_monotonic_timestamp_nsec() - t_start;
+}
+
+static void
+_bench_print(const char *name, gsize key_size, guint n_iterations, const gint64 *t_nsec)
+{
+    HashAlgo algo;
+
+    if (nmtst_test_quick())
+        return;
+
+    for (algo = 0; algo < _HASH_ALGO_NUM; algo++) {
+        const double nsec = (double) (t_nsec[algo] ?: 1);
+
+        g_print(">>> %-14s %4zu bytes: %-12s %6.2f nsec/hash, %8.1f MiB/s (%.2fx siphash24)\n",
+                name,
+                key_size,
+                hash_algo_names[algo],
+                nsec / n_iterations,
+                ((double) key_size * n_iterations * 1000000000.0) / (nsec * 1024.0 * 1024.0),
+                ((double) t_nsec[HASH_ALGO_SIPHASH]) / nsec);
+    }
+}
+
+static guint
+_bench_n_iterations(void)
+{
+    return nmtst_test_quick() ? 2000u : 5000000u;
+}
+
+static const gsize bench_key_sizes[] = {4, 8, 16, 20, 32, 64, 256, 1024};
+
+static void
+test_hash_benchmark_throughput(void)
+{
+    const guint     n_keys = 64;
+    const guint     n_iter = _bench_n_iterations();
+    gs_free guint8 *keys   = NULL;
+    guint           i;
+
+    keys = g_malloc(n_keys * bench_key_sizes[G_N_ELEMENTS(bench_key_sizes) - 1]);
+    nmtst_rand_buf(NULL, keys, n_keys * bench_key_sizes[G_N_ELEMENTS(bench_key_sizes) - 1]);
+
+    for (i = 0; i < G_N_ELEMENTS(bench_key_sizes); i++) {
+        gint64   t_nsec[_HASH_ALGO_NUM];
+        HashAlgo algo;
+
+        for (algo = 0; algo < _HASH_ALGO_NUM; algo++)
+            t_nsec[algo] = _bench_run(algo, keys, bench_key_sizes[i], n_keys, n_iter);
+        _bench_print("throughput", bench_key_sizes[i], n_iter, t_nsec);
+    }
+}
+
+/*****************************************************************************/
+
+/* These generate keys shaped like what the ID hash functions of the platform
+ * cache feed to nm_hash_update_vals() (see _vt_cmd_plobj_id_hash_update_*()
+ * in "nmp-object.c"). The "-full" keys are shaped like the full route hash
+ * (NM_PLATFORM_IP_ROUTE_CMP_TYPE_FULL), which NMDedupMultiIndex uses to intern
+ * the objects. The values are made up, but the field types and thus the size
+ * of the packed key are the same. */
+
+#define _BENCH_KEY(buf, ...)                   \
+    ({                                         \
+        NM_HASH_COMBINE_VALS(_v, __VA_ARGS__); \
+                                               \
+        G_STATIC_ASSERT(sizeof(_v) <= 128);    \
+        memcpy((buf), &_v, sizeof(_v));        \
+        sizeof(_v);                            \
+    })
+
+static gsize
+_bench_key_link(guint i, guint8 *buf)
+{
+    return _BENCH_KEY(buf, (int) (i + 1));
+}
+
+static gsize
+_bench_key_ip4_address(guint i, guint8 *buf)
+{
+    const in_addr_t a = htonl((10u << 24) | i);
+
+    return _BENCH_KEY(buf, (int) (i % 16 + 1), (guint8) 24, a, a & htonl(0xFFFFFF00u));
+}
+
+static gsize
+_bench_key_ip6_address(guint i, guint8 *buf)
+{
+    struct in6_addr a = {{{0x20, 0x01, 0x0d, 0xb8}}};
+
+    a.s6_addr32[3] = htonl(i);
+    return _BENCH_KEY(buf, (int) (i % 16 + 1), a);
+}
+
+static gsize
+_bench_key_ip4_route(guint i, guint8 *buf)
+{
+    return _BENCH_KEY(buf,
+                      (guint8) RTN_UNICAST,
+                      (guint32) RT_TABLE_MAIN,
+                      (in_addr_t) htonl((10u << 24) | (i << 8)),
+                      (guint8) 24,
+                      (guint32) 100,
+                      (guint8) 0,
+                      (int) (i % 16 + 1),
+                      (guint8) RTPROT_STATIC,
+                      (guint8) 0,
+                      (in_addr_t) htonl(0xC0A80001u),
+                      (guint32) 0,
+                      (in_addr_t) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint8) 0);
+}
+
+static gsize
+_bench_key_ip6_route(guint i, guint8 *buf)
+{
+    struct in6_addr network = {{{0x20, 0x01, 0x0d, 0xb8}}};
+    struct in6_addr gateway = {{{0xfe, 0x80}}};
+
+    network.s6_addr32[2] = htonl(i);
+    gateway.s6_addr32[3] = htonl(1);
+    return _BENCH_KEY(buf,
+                      (guint8) RTN_UNICAST,
+                      (guint32) RT_TABLE_MAIN,
+                      network,
+                      (guint8) 64,
+                      (guint32) 1024,
+                      nm_ip_addr_zero.addr6,
+                      (guint8) 0,
+                      (int) (i % 16 + 1),
+                      (guint8) RTPROT_RA,
+                      gateway,
+                      (guint32) 0,
+                      nm_ip_addr_zero.addr6,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint8) 0,
+                      (guint8) 0);
+}
+
+static gsize
+_bench_key_ip4_route_full(guint i, guint8 *buf)
+{
+    return _BENCH_KEY(buf,
+                      (guint8) RTN_UNICAST,
+                      (guint32) RT_TABLE_MAIN,
+                      (int) (i % 16 + 1),
+                      (in_addr_t) htonl((10u << 24) | (i << 8)),
+                      (guint8) 24,
+                      (guint32) 100,
+                      (in_addr_t) htonl(0xC0A80001u),
+                      (int) 0,
+                      (guint8) 0,
+                      (guint8) 0,
+                      (guint32) 0,
+                      (in_addr_t) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (unsigned) 0,
+                      (guint8) 0);
+}
+
+static gsize
+_bench_key_ip6_route_full(guint i, guint8 *buf)
+{
+    struct in6_addr network = {{{0x20, 0x01, 0x0d, 0xb8}}};
+    struct in6_addr gateway = {{{0xfe, 0x80}}};
+
+    network.s6_addr32[2] = htonl(i);
+    gateway.s6_addr32[3] = htonl(1);
+    return _BENCH_KEY(buf,
+                      (guint8) RTN_UNICAST,
+                      (guint32) RT_TABLE_MAIN,
+                      (int) (i % 16 + 1),
+                      network,
+                      (guint32) 1024,
+                      gateway,
+                      nm_ip_addr_zero.addr6,
+                      nm_ip_addr_zero.addr6,
+                      (guint8) 0,
+                      (int) 0,
+                      (guint32) 0,
+                      (unsigned) 0,
+                      (guint8) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint32) 0,
+                      (guint8) 0);
+}
+
+static gsize
+_bench_key_qdisc(guint i, guint8 *buf)
+{
+    return _BENCH_KEY(buf, (int) (i + 1), (guint32) TC_H_ROOT);
+}
+
+static void
+test_hash_benchmark_object_types(void)
+{
+    static const struct {
+        const char *name;
+        gsize (*make_key)(guint i, guint8 *buf);
+    } types[] = {
+        {"link", _bench_key_link},
+        {"ip4-address", _bench_key_ip4_address},
+        {"ip6-address", _bench_key_ip6_address},
+        {"ip4-route", _bench_key_ip4_route},
+        {"ip6-route", _bench_key_ip6_route},
+        {"ip4-route-full", _bench_key_ip4_route_full},
+        {"ip6-route-full", _bench_key_ip6_route_full},
+        {"qdisc", _bench_key_qdisc},
+    };
+    const guint n_keys = 256;
+    const guint n_iter = _bench_n_iterations();
+    guint       i;
+
+    for (i = 0; i < G_N_ELEMENTS(types); i++) {
+        gs_free guint8 *keys     = g_malloc0(n_keys * 128u);
+        gint64          t_nsec[_HASH_ALGO_NUM];
+        HashAlgo        algo;
+        gsize           key_size = 0;
+        guint           j;
+
+        for (j = 0; j < n_keys; j++) {
+            guint8 key[128];
+            gsize  n;
+
+            n = types[i].make_key(j, key);
+            g_assert(j == 0 || n == key_size);
+            key_size = n;
+            memcpy(&keys[j * n], key, n);
+        }
+
+        for (algo = 0; algo < _HASH_ALGO_NUM; algo++)
+            t_nsec[algo] = _bench_run(algo, keys, key_size, n_keys, n_iter);
+        _bench_print(types[i].name, key_size, n_iter, t_nsec);
+    }
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init(&argc, &argv, TRUE);
+
+    g_test_add_func("/hash/fast/chunks", test_hash_fast_chunks);
+    g_test_add_func("/hash/fast/distribution", test_hash_fast_distribution);
+    g_test_add_func("/hash/state", test_hash_state);
+    g_test_add_func("/hash/dedup-obj", test_hash_dedup_obj);
+    g_test_add_func("/hash/benchmark/throughput", test_hash_benchmark_throughput);
+    g_test_add_func("/hash/benchmark/object-types", test_hash_benchmark_object_types);
+
+    return g_test_run();
+}
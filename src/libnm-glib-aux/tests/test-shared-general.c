@@ -678,6 +678,131 @@ test_nm_ref_string(void)
 
 /*****************************************************************************/
 
+#define REF_STRING_MT_N_PINNED    256u
+#define REF_STRING_MT_MAX_THREADS 8u
+
+typedef struct {
+    NMRefString *const *pinned;
+    guint               n_iterations;
+    guint32             seed;
+} RefStringMTData;
+
+static void
+_ref_string_mt_name(char buf[static 64], guint idx)
+{
+    g_snprintf(buf, 64, "ref-string-mt-%u", idx);
+}
+
+static gpointer
+_ref_string_mt_thread(gpointer user_data)
+{
+    const RefStringMTData *data     = user_data;
+    NMRefString *          held[16] = {};
+    guint32                x        = data->seed;
+    guint                  i;
+
+    for (i = 0; i < data->n_iterations; i++) {
+        NMRefString *rstr;
+        char         buf[64];
+        guint        idx;
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+
+        /* half of the strings are held by the main thread for the whole time,
+         * the other half gets created and destroyed concurrently. */
+        idx = x % (2u * REF_STRING_MT_N_PINNED);
+        _ref_string_mt_name(buf, idx);
+
+        rstr = nm_ref_string_new(buf);
+        g_assert_cmpstr(rstr->str, ==, buf);
+        if (idx < REF_STRING_MT_N_PINNED)
+            g_assert(rstr == data->pinned[idx]);
+
+        /* keep some references for a while, so that the last unref happens on
+         * various threads and races with lookups of the same string. */
+        nm_ref_string_unref(held[i % G_N_ELEMENTS(held)]);
+        held[i % G_N_ELEMENTS(held)] = rstr;
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(held); i++)
+        nm_ref_string_unref(held[i]);
+
+    return NULL;
+}
+
+static gint64
+_ref_string_mt_run(NMRefString *const *pinned, guint n_threads, guint n_iterations)
+{
+    GThread *       threads[REF_STRING_MT_MAX_THREADS];
+    RefStringMTData data[REF_STRING_MT_MAX_THREADS];
+    gint64          t_start;
+    guint           i;
+
+    g_assert(n_threads <= REF_STRING_MT_MAX_THREADS);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < n_threads; i++) {
+        data[i] = (RefStringMTData){
+            .pinned       = pinned,
+            .n_iterations = n_iterations,
+            .seed         = nmtst_get_rand_uint32() ?: 1u,
+        };
+        threads[i] = g_thread_new("ref-string-mt", _ref_string_mt_thread, &data[i]);
+    }
+    for (i = 0; i < n_threads; i++)
+        g_thread_join(threads[i]);
+    return nm_utils_get_monotonic_timestamp_nsec() - t_start;
+}
+
+static void
+test_nm_ref_string_mt(void)
+{
+    const guint  n_iterations = nmtst_test_quick() ? 20000u : 1000000u;
+    NMRefString *pinned[REF_STRING_MT_N_PINNED];
+    char         buf[64];
+    guint        n_threads;
+    guint        i;
+
+    for (i = 0; i < REF_STRING_MT_N_PINNED; i++) {
+        _ref_string_mt_name(buf, i);
+        pinned[i] = nm_ref_string_new(buf);
+    }
+
+    for (n_threads = 1; n_threads <= REF_STRING_MT_MAX_THREADS; n_threads *= 2) {
+        gint64 t_nsec;
+
+        t_nsec = _ref_string_mt_run(pinned, n_threads, n_iterations);
+        if (!nmtst_test_quick()) {
+            g_print(">>> ref-string: %u threads with %u lookups each: %" G_GINT64_FORMAT
+                    " msec, %.1f lookups/usec\n",
+                    n_threads,
+                    n_iterations,
+                    t_nsec / NM_UTILS_NSEC_PER_MSEC,
+                    ((double) n_threads * n_iterations * 1000.0) / (double) (t_nsec ?: 1));
+        }
+    }
+
+    /* all references taken by the threads are released again. */
+    for (i = 0; i < 2u * REF_STRING_MT_N_PINNED; i++) {
+        nm_auto_ref_string NMRefString *rstr = NULL;
+
+        _ref_string_mt_name(buf, i);
+        rstr = nm_ref_string_new(buf);
+        if (i < REF_STRING_MT_N_PINNED)
+            g_assert(rstr == pinned[i]);
+        g_assert_cmpint(g_atomic_int_get(&rstr->_ref_count),
+                        ==,
+                        i < REF_STRING_MT_N_PINNED ? 2 : 1);
+    }
+
+    for (i = 0; i < REF_STRING_MT_N_PINNED; i++)
+        nm_ref_string_unref(pinned[i]);
+}
+
+/*****************************************************************************/
+
 static NM_UTILS_STRING_TABLE_LOOKUP_DEFINE(
     _do_string_table_lookup,
     int,
@@ -1392,6 +1517,7 @@ main(int argc, char **argv)
     g_test_add_func("/general/test_strstrip_avoid_copy", test_strstrip_avoid_copy);
     g_test_add_func("/general/test_nm_utils_bin2hexstr", test_nm_utils_bin2hexstr);
     g_test_add_func("/general/test_nm_ref_string", test_nm_ref_string);
+    g_test_add_func("/general/test_nm_ref_string_mt", test_nm_ref_string_mt);
     g_test_add_func("/general/test_string_table_lookup", test_string_table_lookup);
     g_test_add_func("/general/test_nm_utils_get_next_realloc_size",
                     test_nm_utils_get_next_realloc_size);
@@ -14,6 +14,7 @@
 #include <libudev.h>
 #include <net/ethernet.h>
 #include <linux/fib_rules.h>
+#include <linux/filter.h>
 #include <linux/ip.h>
 #include <linux/if.h>
 #include <linux/if_bridge.h>
@@ -29,6 +30,7 @@
 #include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/eventfd.h>
 #include <sys/statvfs.h>
 #include <unistd.h>
 
@@ -308,7 +310,8 @@ typedef enum {
     REFRESH_ALL_TYPE_ROUTING_RULES_IP4 = 5,
     REFRESH_ALL_TYPE_ROUTING_RULES_IP6 = 6,
     REFRESH_ALL_TYPE_QDISCS            = 7,
-    REFRESH_ALL_TYPE_TFILTERS          = 8,
+    REFRESH_ALL_TYPE_TCLASSES          = 8,
+    REFRESH_ALL_TYPE_TFILTERS          = 9,
 
     _REFRESH_ALL_TYPE_NUM,
 } RefreshAllType;
@@ -334,13 +337,14 @@ typedef enum {
     DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_IP6 = 1
                                                         << F(6, REFRESH_ALL_TYPE_ROUTING_RULES_IP6),
     DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS   = 1 << F(7, REFRESH_ALL_TYPE_QDISCS),
-    DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS = 1 << F(8, REFRESH_ALL_TYPE_TFILTERS),
+    DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES = 1 << F(8, REFRESH_ALL_TYPE_TCLASSES),
+    DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS = 1 << F(9, REFRESH_ALL_TYPE_TFILTERS),
 #undef F
 
-    DELAYED_ACTION_TYPE_REFRESH_LINK         = 1 << 9,
-    DELAYED_ACTION_TYPE_MASTER_CONNECTED     = 1 << 10,
-    DELAYED_ACTION_TYPE_READ_NETLINK         = 1 << 11,
-    DELAYED_ACTION_TYPE_WAIT_FOR_NL_RESPONSE = 1 << 12,
+    DELAYED_ACTION_TYPE_REFRESH_LINK         = 1 << 10,
+    DELAYED_ACTION_TYPE_MASTER_CONNECTED     = 1 << 11,
+    DELAYED_ACTION_TYPE_READ_NETLINK         = 1 << 12,
+    DELAYED_ACTION_TYPE_WAIT_FOR_NL_RESPONSE = 1 << 13,
 
     __DELAYED_ACTION_TYPE_MAX,
 
@@ -348,12 +352,17 @@ typedef enum {
         DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_IP4
         | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_IP6,
 
+    /* the types whose events are received on the separate route event socket. */
+    DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTE_EVENTS =
+        DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ROUTES | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ROUTES
+        | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_ALL,
+
     DELAYED_ACTION_TYPE_REFRESH_ALL =
         DELAYED_ACTION_TYPE_REFRESH_ALL_LINKS | DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ADDRESSES
         | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ADDRESSES | DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ROUTES
         | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ROUTES
         | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_ALL | DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS
-        | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
+        | DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
 
     DELAYED_ACTION_TYPE_MAX = __DELAYED_ACTION_TYPE_MAX - 1,
 } DelayedActionType;
@@ -400,6 +409,7 @@ typedef struct {
     guint32                            seq_number;
     WaitForNlResponseResult            seq_result;
     DelayedActionWaitForNlResponseType response_type;
+    gint64                             start_ns;
     gint64                             timeout_abs_ns;
     WaitForNlResponseResult *          out_seq_result;
     char **                            out_errmsg;
@@ -415,9 +425,54 @@ typedef struct {
 typedef struct {
     struct nl_sock *genl;
 
+    /* requests to the "ethtool" generic netlink family, with their own sockets.
+     * Created on first use, and NULL if kernel does not support it. */
+    NMPUtilsEthtoolNl *ethtool_nl;
+    GSource *          ethtool_nl_event_source;
+    bool               ethtool_nl_tried : 1;
+
     struct nl_sock *nlh;
 
+    /* A socket that is only subscribed to the route and routing rule
+     * multicast groups and never used for requests. Those events can come
+     * at a high rate, and if they overflow the socket, we only need to
+     * resync routes and rules, but not links and addresses. */
+    struct nl_sock *nlh_route_events;
+
     GSource *event_source;
+    GSource *event_source_route_events;
+
+    /* Optionally, a thread keeps reading @nlh_route_events and queues the
+     * messages. That way, the kernel socket buffer does not overflow while
+     * the main thread is busy. The main thread then processes the queue
+     * instead of reading the socket. */
+    struct {
+        GThread *thread;
+        GMutex   lock;
+        GCond    cond;
+
+        /* protected by @lock. @queue_size counts the messages in @queue and
+         * @queue_main, @queue_main_size the part that is in @queue_main. */
+        GQueue  queue;
+        gsize   queue_size;
+        gsize   queue_main_size;
+        guint64 sync_requested;
+        guint64 sync_done;
+        bool    wakeup_pending;
+        bool    main_waiting;
+        bool    stop;
+
+        /* only accessed by the main thread. */
+        GQueue  queue_main;
+        guint64 sync_main;
+        bool    sync_main_done;
+
+        /* the reader thread signals new messages to the main thread. */
+        int fd_wakeup;
+
+        /* the main thread signals a stop or sync request to the reader thread. */
+        int fd_kick;
+    } reader;
 
     guint32 nlh_seq_next;
 #if NM_MORE_LOGGING
@@ -427,6 +482,12 @@ typedef struct {
 
     guint32 pruning[_REFRESH_ALL_TYPE_NUM];
 
+    bool netlink_reader_thread : 1;
+
+    /* routes in these tables are never added to the cache. Sorted. */
+    guint32 *ignored_route_tables;
+    guint    ignored_route_tables_len;
+
     GHashTable *sysctl_get_prev_values;
     CList       sysctl_list;
     CList       sysctl_clear_cache_lst;
@@ -449,6 +510,16 @@ typedef struct {
         int is_handling;
     } delayed_action;
 
+    struct {
+        NMPlatformNetlinkStats counters;
+
+        /* the refresh-all actions that were scheduled because of an overflow
+         * or a route resync. The next dump of these types is accounted
+         * to that reason. */
+        DelayedActionType pending_overflow;
+        DelayedActionType pending_route_resync;
+    } stats;
+
 } NMLinuxPlatformPrivate;
 
 struct _NMLinuxPlatform {
@@ -462,6 +533,13 @@ struct _NMLinuxPlatformClass {
 
 G_DEFINE_TYPE(NMLinuxPlatform, nm_linux_platform, NM_TYPE_PLATFORM)
 
+enum {
+    PROP_0,
+    PROP_NETLINK_READER_THREAD,
+    PROP_IGNORED_ROUTE_TABLES,
+    LAST_PROP,
+};
+
 #define NM_LINUX_PLATFORM_GET_PRIVATE(self) \
     _NM_GET_PRIVATE(self, NMLinuxPlatform, NM_IS_LINUX_PLATFORM, NMPlatform)
 
@@ -551,7 +629,9 @@ static void
 delayed_action_schedule(NMPlatform *platform, DelayedActionType action_type, gpointer user_data);
 static gboolean delayed_action_handle_all(NMPlatform *platform, gboolean read_netlink);
 static void do_request_link_no_delayed_actions(NMPlatform *platform, int ifindex, const char *name);
-static void do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action_type);
+static void do_request_all_no_delayed_actions(NMPlatform *         platform,
+                                              DelayedActionType    action_type,
+                                              NMPlatformDumpReason reason);
 static void cache_on_change(NMPlatform *     platform,
                             NMPCacheOpsType  cache_op,
                             const NMPObject *obj_old,
@@ -2630,9 +2710,8 @@ _wireguard_create_change_nlmsgs(NMPlatform *                              platfo
     idx_peer_curr        = IDX_NIL;
     idx_allowed_ips_curr = IDX_NIL;
 
-    /* TODO: for the moment, we always reset all peers and allowed-ips (WGDEVICE_F_REPLACE_PEERS, WGPEER_F_REPLACE_ALLOWEDIPS).
-     * The platform API should be extended to also support partial updates. In particular, configuring the same configuration
-     * multiple times, should not clear and re-add all settings, but rather sync the existing settings with the desired configuration. */
+    /* Partial updates are done by the caller, see _wireguard_sync_peers(). Here we only
+     * translate the peers and their flags to netlink messages. */
 
 again:
 
@@ -2827,6 +2906,224 @@ nla_put_failure:
 #undef _nla_nest_end
 }
 
+static guint
+_wireguard_public_key_hash(gconstpointer key)
+{
+    return nm_hash_mem(1573497107u, key, NMP_WIREGUARD_PUBLIC_KEY_LEN);
+}
+
+static gboolean
+_wireguard_public_key_equal(gconstpointer a, gconstpointer b)
+{
+    return memcmp(a, b, NMP_WIREGUARD_PUBLIC_KEY_LEN) == 0;
+}
+
+static int
+_wireguard_allowed_ip_cmp(gconstpointer p_a, gconstpointer p_b, gpointer user_data)
+{
+    const NMPWireGuardAllowedIP *a = p_a;
+    const NMPWireGuardAllowedIP *b = p_b;
+
+    NM_CMP_FIELD(a, b, family);
+    NM_CMP_FIELD(a, b, mask);
+    NM_CMP_RETURN(memcmp(&a->addr, &b->addr, nm_utils_addr_family_to_size(a->family)));
+    return 0;
+}
+
+static guint
+_wireguard_allowed_ips_normalize(const NMPWireGuardAllowedIP *src,
+                                 guint                        len,
+                                 NMPWireGuardAllowedIP *      dst)
+{
+    guint i, j;
+
+    /* The kernel clears the host part and does not keep duplicates. Normalize
+     * the list the same way, so that it can be compared with what we read back. */
+    for (i = 0; i < len; i++) {
+        dst[i] = (NMPWireGuardAllowedIP){
+            .family = src[i].family,
+            .mask   = src[i].mask,
+        };
+        nm_utils_ipx_address_clear_host_address(src[i].family,
+                                                &dst[i].addr,
+                                                &src[i].addr,
+                                                src[i].mask);
+    }
+
+    if (len <= 1)
+        return len;
+
+    g_qsort_with_data(dst, len, sizeof(dst[0]), _wireguard_allowed_ip_cmp, NULL);
+
+    for (i = 1, j = 1; i < len; i++) {
+        if (_wireguard_allowed_ip_cmp(&dst[j - 1], &dst[i], NULL) != 0)
+            dst[j++] = dst[i];
+    }
+    return j;
+}
+
+static gboolean
+_wireguard_allowed_ips_equal(const NMPWireGuardPeer *peer_old, const NMPWireGuardPeer *peer_new)
+{
+    gs_free NMPWireGuardAllowedIP *buf_old = NULL;
+    gs_free NMPWireGuardAllowedIP *buf_new = NULL;
+    guint                          len_old;
+    guint                          len_new;
+
+    if (peer_old->allowed_ips_len == 0 || peer_new->allowed_ips_len == 0)
+        return peer_old->allowed_ips_len == peer_new->allowed_ips_len;
+
+    buf_old = g_new(NMPWireGuardAllowedIP, peer_old->allowed_ips_len);
+    buf_new = g_new(NMPWireGuardAllowedIP, peer_new->allowed_ips_len);
+
+    len_old =
+        _wireguard_allowed_ips_normalize(peer_old->allowed_ips, peer_old->allowed_ips_len, buf_old);
+    len_new =
+        _wireguard_allowed_ips_normalize(peer_new->allowed_ips, peer_new->allowed_ips_len, buf_new);
+
+    return len_old == len_new && memcmp(buf_old, buf_new, sizeof(buf_old[0]) * len_old) == 0;
+}
+
+/*
+ * _wireguard_sync_peers:
+ * @lnk_old: the current configuration of the device, as read from kernel.
+ * @lnk_wireguard: the requested device configuration.
+ * @peers: the requested peers.
+ * @peer_flags: (allow-none): the flags for @peers.
+ * @peers_len: number of @peers.
+ * @change_flags: the requested change flags.
+ * @out_peers: (out): the peers that need to be sent.
+ * @out_peer_flags: (out): the flags for @out_peers.
+ *
+ * Compare the requested configuration with the current one and return only
+ * the peers that are added, changed or (with %NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS)
+ * removed. The returned peers are shallow copies, they reference the allowed-ips
+ * of @peers.
+ *
+ * Returns: the change flags to use. %NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS
+ *   is always cleared, it is replaced by explicitly removing the superfluous peers.
+ */
+static NMPlatformWireGuardChangeFlags
+_wireguard_sync_peers(const NMPObject *                         lnk_old,
+                      const NMPlatformLnkWireGuard *            lnk_wireguard,
+                      const NMPWireGuardPeer *                  peers,
+                      const NMPlatformWireGuardChangePeerFlags *peer_flags,
+                      guint                                     peers_len,
+                      NMPlatformWireGuardChangeFlags            change_flags,
+                      GArray **                                 out_peers,
+                      GArray **                                 out_peer_flags)
+{
+    const NMPlatformLnkWireGuard *old     = &lnk_old->lnk_wireguard;
+    gs_unref_hashtable GHashTable *old_idx = NULL;
+    gs_unref_hashtable GHashTable *seen    = NULL;
+    GArray *                       res_peers;
+    GArray *                       res_flags;
+    guint                          i;
+
+    nm_assert(NMP_OBJECT_GET_TYPE(lnk_old) == NMP_OBJECT_TYPE_LNK_WIREGUARD);
+
+    /* We don't read back the private key, so it is always sent. Setting the same
+     * key again is a no-op in kernel. */
+    if (NM_FLAGS_HAS(change_flags, NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT)
+        && old->listen_port == lnk_wireguard->listen_port)
+        change_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT;
+    if (NM_FLAGS_HAS(change_flags, NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK)
+        && old->fwmark == lnk_wireguard->fwmark)
+        change_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK;
+
+    old_idx = g_hash_table_new(_wireguard_public_key_hash, _wireguard_public_key_equal);
+    for (i = 0; i < lnk_old->_lnk_wireguard.peers_len; i++) {
+        const NMPWireGuardPeer *p = &lnk_old->_lnk_wireguard.peers[i];
+
+        g_hash_table_insert(old_idx, (gpointer) p->public_key, (gpointer) p);
+    }
+
+    res_peers = g_array_new(FALSE, FALSE, sizeof(NMPWireGuardPeer));
+    res_flags = g_array_new(FALSE, FALSE, sizeof(NMPlatformWireGuardChangePeerFlags));
+
+    if (NM_FLAGS_HAS(change_flags, NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS))
+        seen = g_hash_table_new(_wireguard_public_key_hash, _wireguard_public_key_equal);
+
+    for (i = 0; i < peers_len; i++) {
+        const NMPWireGuardPeer *           p = &peers[i];
+        const NMPWireGuardPeer *           p_old;
+        NMPlatformWireGuardChangePeerFlags p_flags;
+
+        p_flags = peer_flags ? peer_flags[i] : NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_DEFAULT;
+
+        if (p_flags == NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_NONE)
+            continue;
+
+        p_old = g_hash_table_lookup(old_idx, p->public_key);
+
+        if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REMOVE_ME)) {
+            if (!p_old)
+                continue;
+            g_hash_table_remove(old_idx, p->public_key);
+            goto add;
+        }
+
+        if (seen)
+            g_hash_table_add(seen, (gpointer) p->public_key);
+
+        if (!p_old)
+            goto add;
+
+        if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_PRESHARED_KEY)
+            && memcmp(p_old->preshared_key, p->preshared_key, sizeof(p->preshared_key)) == 0)
+            p_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_PRESHARED_KEY;
+
+        if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_KEEPALIVE_INTERVAL)
+            && p_old->persistent_keepalive_interval == p->persistent_keepalive_interval)
+            p_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_KEEPALIVE_INTERVAL;
+
+        if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_ENDPOINT)
+            && nm_sock_addr_union_cmp(&p_old->endpoint, &p->endpoint) == 0)
+            p_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_ENDPOINT;
+
+        if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_ALLOWEDIPS)) {
+            if (_wireguard_allowed_ips_equal(p_old, p)) {
+                p_flags &= ~(NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_ALLOWEDIPS
+                             | NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REPLACE_ALLOWEDIPS);
+            }
+        } else if (NM_FLAGS_HAS(p_flags, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REPLACE_ALLOWEDIPS)
+                   && p_old->allowed_ips_len == 0)
+            p_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REPLACE_ALLOWEDIPS;
+
+        if (p_flags == NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_NONE)
+            continue;
+
+add:
+        g_array_append_val(res_peers, *p);
+        g_array_append_val(res_flags, p_flags);
+    }
+
+    if (seen) {
+        for (i = 0; i < lnk_old->_lnk_wireguard.peers_len; i++) {
+            const NMPWireGuardPeer *           p_old = &lnk_old->_lnk_wireguard.peers[i];
+            NMPlatformWireGuardChangePeerFlags p_flags;
+            NMPWireGuardPeer                   p;
+
+            if (g_hash_table_contains(seen, p_old->public_key))
+                continue;
+            if (!g_hash_table_contains(old_idx, p_old->public_key)) {
+                /* already explicitly removed. */
+                continue;
+            }
+
+            p = (NMPWireGuardPeer){};
+            memcpy(p.public_key, p_old->public_key, sizeof(p.public_key));
+            p_flags = NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REMOVE_ME;
+            g_array_append_val(res_peers, p);
+            g_array_append_val(res_flags, p_flags);
+        }
+    }
+
+    *out_peers      = res_peers;
+    *out_peer_flags = res_flags;
+    return change_flags & ~NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS;
+}
+
 static int
 link_wireguard_change(NMPlatform *                              platform,
                       int                                       ifindex,
@@ -2836,8 +3133,10 @@ link_wireguard_change(NMPlatform *                              platform,
                       guint                                     peers_len,
                       NMPlatformWireGuardChangeFlags            change_flags)
 {
-    NMLinuxPlatformPrivate *priv      = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
-    gs_unref_ptrarray GPtrArray *msgs = NULL;
+    NMLinuxPlatformPrivate *priv                 = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gs_unref_ptrarray GPtrArray *msgs            = NULL;
+    gs_unref_array GArray *      sync_peers      = NULL;
+    gs_unref_array GArray *      sync_peer_flags = NULL;
     int                          wireguard_family_id;
     guint                        i;
     int                          r;
@@ -2846,6 +3145,47 @@ link_wireguard_change(NMPlatform *                              platform,
     if (wireguard_family_id < 0)
         return -NME_PL_NO_FIRMWARE;
 
+    if (NM_FLAGS_HAS(change_flags, NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC)) {
+        const NMPObject *plink;
+
+        change_flags &= ~NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC;
+
+        /* there are no netlink notifications for changes of the wireguard configuration.
+         * But the cached configuration is re-read on every link notification and after
+         * every change that we make. Diff against that, and only read the configuration
+         * if it is not in the cache yet. */
+        nm_platform_process_events(platform);
+        plink = nm_platform_link_get_obj(platform, ifindex, TRUE);
+        if (!plink || plink->link.type != NM_LINK_TYPE_WIREGUARD
+            || NMP_OBJECT_GET_TYPE(plink->_link.netlink.lnk) != NMP_OBJECT_TYPE_LNK_WIREGUARD)
+            plink = _wireguard_refresh_link(platform, wireguard_family_id, ifindex);
+        if (plink && plink->_link.netlink.lnk
+            && NMP_OBJECT_GET_TYPE(plink->_link.netlink.lnk) == NMP_OBJECT_TYPE_LNK_WIREGUARD) {
+            change_flags = _wireguard_sync_peers(plink->_link.netlink.lnk,
+                                                 lnk_wireguard,
+                                                 peers,
+                                                 peer_flags,
+                                                 peers_len,
+                                                 change_flags,
+                                                 &sync_peers,
+                                                 &sync_peer_flags);
+            peers      = (const NMPWireGuardPeer *) sync_peers->data;
+            peer_flags = (const NMPlatformWireGuardChangePeerFlags *) sync_peer_flags->data;
+            peers_len  = sync_peers->len;
+
+            _LOGT("wireguard: set-device, sync %u changed peers", peers_len);
+
+            if (peers_len == 0
+                && !NM_FLAGS_ANY(change_flags,
+                                 NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_PRIVATE_KEY
+                                     | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT
+                                     | NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK)) {
+                _LOGT("wireguard: set-device, configuration is up to date");
+                return 0;
+            }
+        }
+    }
+
     r = _wireguard_create_change_nlmsgs(platform,
                                         ifindex,
                                         wireguard_family_id,
@@ -2855,6 +3195,8 @@ link_wireguard_change(NMPlatform *                              platform,
                                         peers_len,
                                         change_flags,
                                         &msgs);
+    if (sync_peers)
+        nm_explicit_bzero(sync_peers->data, sizeof(NMPWireGuardPeer) * sync_peers->len);
     if (r < 0) {
         _LOGW("wireguard: set-device, cannot construct netlink message: %s", nm_strerror(r));
         return r;
@@ -2878,6 +3220,8 @@ link_wireguard_change(NMPlatform *                              platform,
         _LOGT("wireguard: set-device, message #%u sent and confirmed", i);
     }
 
+    /* kernel does not notify about the change. Read it back, so that the cache
+     * (and the next sync) sees the new configuration. */
     _wireguard_refresh_link(platform, wireguard_family_id, ifindex);
 
     return 0;
@@ -3348,9 +3692,27 @@ _new_from_nl_addr(struct nlmsghdr *nlh, gboolean id_only)
     return g_steal_pointer(&obj);
 }
 
+static gboolean
+_route_table_is_ignored(NMPlatform *platform, guint32 table)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    return priv->ignored_route_tables_len > 0
+           && nm_utils_array_find_binary_search(priv->ignored_route_tables,
+                                                sizeof(guint32),
+                                                priv->ignored_route_tables_len,
+                                                &table,
+                                                nm_cmp_uint32_p_with_data,
+                                                NULL)
+                  >= 0;
+}
+
 /* Copied and heavily modified from libnl3's rtnl_route_parse() and parse_multipath(). */
 static NMPObject *
-_new_from_nl_route(struct nlmsghdr *nlh, gboolean id_only)
+_new_from_nl_route(NMPlatform *     platform,
+                   struct nlmsghdr *nlh,
+                   gboolean         id_only,
+                   gboolean         skip_ignored_tables)
 {
     static const struct nla_policy policy[] = {
         [RTA_TABLE]     = {.type = NLA_U32},
@@ -3398,9 +3760,19 @@ _new_from_nl_route(struct nlmsghdr *nlh, gboolean id_only)
     if (!NM_IN_SET(rtm->rtm_type, RTN_UNICAST, RTN_LOCAL))
         return NULL;
 
+    /* tables above 255 are only in RTA_TABLE. Check the others before
+     * parsing the attributes. */
+    if (skip_ignored_tables && rtm->rtm_table != RT_TABLE_COMPAT
+        && _route_table_is_ignored(platform, rtm->rtm_table))
+        return NULL;
+
     if (nlmsg_parse_arr(nlh, sizeof(struct rtmsg), tb, policy) < 0)
         return NULL;
 
+    if (skip_ignored_tables && tb[RTA_TABLE]
+        && _route_table_is_ignored(platform, nla_get_u32(tb[RTA_TABLE])))
+        return NULL;
+
     /*****************************************************************/
 
     is_v4    = rtm->rtm_family == AF_INET;
@@ -3834,8 +4206,8 @@ _new_from_nl_routing_rule(struct nlmsghdr *nlh, gboolean id_only)
     return g_steal_pointer(&obj);
 }
 
-static guint32
-psched_tick_to_time(NMPlatform *platform, guint32 tick)
+static double
+psched_get_tick_in_usec(NMPlatform *platform)
 {
     static gboolean initialized;
     static double   tick_in_usec = 1;
@@ -3861,7 +4233,32 @@ psched_tick_to_time(NMPlatform *platform, guint32 tick)
         }
     }
 
-    return tick / tick_in_usec;
+    return tick_in_usec;
+}
+
+static guint32
+psched_tick_to_time(NMPlatform *platform, guint32 tick)
+{
+    return tick / psched_get_tick_in_usec(platform);
+}
+
+static guint32
+psched_buffer_to_size(NMPlatform *platform, guint64 rate, guint32 buffer)
+{
+    return ((double) rate * psched_tick_to_time(platform, buffer)) / PSCHED_TIME_UNITS_PER_SEC;
+}
+
+static guint32
+psched_size_to_buffer(NMPlatform *platform, guint64 rate, guint32 size)
+{
+    double usec;
+
+    if (rate == 0)
+        return 0;
+
+    /* see tc_calc_xmittime() in iproute2 */
+    usec = ((double) size * PSCHED_TIME_UNITS_PER_SEC) / rate;
+    return MIN(usec * psched_get_tick_in_usec(platform), (double) G_MAXUINT32);
 }
 
 static NMPObject *
@@ -3930,10 +4327,23 @@ _new_from_nl_qdisc(NMPlatform *platform, struct nlmsghdr *nlh, gboolean id_only)
             obj->qdisc.tbf.rate = opt.rate.rate;
             if (tbf_tb[TCA_TBF_RATE64])
                 obj->qdisc.tbf.rate = nla_get_u64(tbf_tb[TCA_TBF_RATE64]);
-            obj->qdisc.tbf.burst =
-                ((double) obj->qdisc.tbf.rate * psched_tick_to_time(platform, opt.buffer))
-                / PSCHED_TIME_UNITS_PER_SEC;
+            obj->qdisc.tbf.burst = psched_buffer_to_size(platform, obj->qdisc.tbf.rate, opt.buffer);
             obj->qdisc.tbf.limit = opt.limit;
+        } else if (nm_streq0(obj->qdisc.kind, "htb")) {
+            static const struct nla_policy htb_policy[] = {
+                [TCA_HTB_INIT] = {.minlen = sizeof(struct tc_htb_glob)},
+            };
+            struct nlattr *    htb_tb[G_N_ELEMENTS(htb_policy)];
+            struct tc_htb_glob glob;
+
+            if (nla_parse_nested_arr(htb_tb, tb[TCA_OPTIONS], htb_policy) < 0)
+                return NULL;
+            if (!htb_tb[TCA_HTB_INIT])
+                return NULL;
+
+            nla_memcpy_checked_size(&glob, htb_tb[TCA_HTB_INIT], sizeof(glob));
+            obj->qdisc.htb.rate2quantum = glob.rate2quantum;
+            obj->qdisc.htb.defcls       = glob.defcls;
         } else {
             nla_for_each_nested (options_attr, tb[TCA_OPTIONS], remaining) {
                 if (nla_len(options_attr) < sizeof(uint32_t))
@@ -3974,6 +4384,65 @@ _new_from_nl_qdisc(NMPlatform *platform, struct nlmsghdr *nlh, gboolean id_only)
     return g_steal_pointer(&obj);
 }
 
+static NMPObject *
+_new_from_nl_tclass(NMPlatform *platform, struct nlmsghdr *nlh, gboolean id_only)
+{
+    static const struct nla_policy policy[] = {
+        [TCA_KIND]    = {.type = NLA_STRING},
+        [TCA_OPTIONS] = {.type = NLA_NESTED},
+    };
+    struct nlattr *     tb[G_N_ELEMENTS(policy)];
+    const struct tcmsg *tcm;
+    nm_auto_nmpobj NMPObject *obj = NULL;
+
+    if (nlmsg_parse_arr(nlh, sizeof(*tcm), tb, policy) < 0)
+        return NULL;
+
+    if (!tb[TCA_KIND])
+        return NULL;
+
+    tcm = nlmsg_data(nlh);
+
+    obj = nmp_object_new(NMP_OBJECT_TYPE_TCLASS, NULL);
+
+    obj->tclass.kind        = g_intern_string(nla_get_string(tb[TCA_KIND]));
+    obj->tclass.ifindex     = tcm->tcm_ifindex;
+    obj->tclass.addr_family = tcm->tcm_family;
+    obj->tclass.handle      = tcm->tcm_handle;
+    obj->tclass.parent      = tcm->tcm_parent;
+    obj->tclass.info        = tcm->tcm_info;
+
+    if (tb[TCA_OPTIONS] && nm_streq0(obj->tclass.kind, "htb")) {
+        static const struct nla_policy htb_policy[] = {
+            [TCA_HTB_PARMS]  = {.minlen = sizeof(struct tc_htb_opt)},
+            [TCA_HTB_RATE64] = {.type = NLA_U64},
+            [TCA_HTB_CEIL64] = {.type = NLA_U64},
+        };
+        struct nlattr *   htb_tb[G_N_ELEMENTS(htb_policy)];
+        struct tc_htb_opt opt;
+
+        if (nla_parse_nested_arr(htb_tb, tb[TCA_OPTIONS], htb_policy) < 0)
+            return NULL;
+        if (!htb_tb[TCA_HTB_PARMS])
+            return NULL;
+
+        nla_memcpy_checked_size(&opt, htb_tb[TCA_HTB_PARMS], sizeof(opt));
+        obj->tclass.htb.rate = opt.rate.rate;
+        if (htb_tb[TCA_HTB_RATE64])
+            obj->tclass.htb.rate = nla_get_u64(htb_tb[TCA_HTB_RATE64]);
+        obj->tclass.htb.ceil = opt.ceil.rate;
+        if (htb_tb[TCA_HTB_CEIL64])
+            obj->tclass.htb.ceil = nla_get_u64(htb_tb[TCA_HTB_CEIL64]);
+        obj->tclass.htb.burst  = psched_buffer_to_size(platform, obj->tclass.htb.rate, opt.buffer);
+        obj->tclass.htb.cburst = psched_buffer_to_size(platform, obj->tclass.htb.ceil, opt.cbuffer);
+
+        obj->tclass.htb.quantum = opt.quantum;
+        obj->tclass.htb.prio    = opt.prio;
+    }
+
+    return g_steal_pointer(&obj);
+}
+
 static NMPObject *
 _new_from_nl_tfilter(struct nlmsghdr *nlh, gboolean id_only)
 {
@@ -4013,6 +4482,8 @@ _new_from_nl_tfilter(struct nlmsghdr *nlh, gboolean id_only)
  *   If a cache is given, the object is completed with information from the cache.
  * @nlh: the netlink message header
  * @id_only: whether only to create an empty object with only the ID fields set.
+ * @is_route_get: whether the message is the response to our RTM_GETROUTE request.
+ *   Such a response is parsed even if the route is in an ignored table.
  *
  * Returns: %NULL or a newly created NMPObject instance.
  **/
@@ -4020,7 +4491,8 @@ static NMPObject *
 nmp_object_new_from_nl(NMPlatform *    platform,
                        const NMPCache *cache,
                        struct nl_msg * msg,
-                       gboolean        id_only)
+                       gboolean        id_only,
+                       gboolean        is_route_get)
 {
     struct nlmsghdr *msghdr;
 
@@ -4042,7 +4514,7 @@ nmp_object_new_from_nl(NMPlatform *    platform,
     case RTM_NEWROUTE:
     case RTM_DELROUTE:
     case RTM_GETROUTE:
-        return _new_from_nl_route(msghdr, id_only);
+        return _new_from_nl_route(platform, msghdr, id_only, !is_route_get);
     case RTM_NEWRULE:
     case RTM_DELRULE:
     case RTM_GETRULE:
@@ -4051,6 +4523,10 @@ nmp_object_new_from_nl(NMPlatform *    platform,
     case RTM_DELQDISC:
     case RTM_GETQDISC:
         return _new_from_nl_qdisc(platform, msghdr, id_only);
+    case RTM_NEWTCLASS:
+    case RTM_DELTCLASS:
+    case RTM_GETTCLASS:
+        return _new_from_nl_tclass(platform, msghdr, id_only);
     case RTM_NEWTFILTER:
     case RTM_DELTFILTER:
     case RTM_GETTFILTER:
@@ -4946,6 +5422,19 @@ _nl_msg_new_qdisc(int nlmsg_type, int nlmsg_flags, const NMPlatformQdisc *qdisc)
         struct tc_prio_qopt opt = {3, {1, 2, 2, 2, 1, 2, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
 
         NLA_PUT(msg, TCA_OPTIONS, sizeof(opt), &opt);
+    } else if (nm_streq(qdisc->kind, "htb")) {
+        const struct tc_htb_glob glob = {
+            .version      = TC_HTB_PROTOVER,
+            .rate2quantum = qdisc->htb.rate2quantum,
+            .defcls       = qdisc->htb.defcls,
+        };
+
+        if (!(tc_options = nla_nest_start(msg, TCA_OPTIONS)))
+            goto nla_put_failure;
+
+        NLA_PUT(msg, TCA_HTB_INIT, sizeof(glob), &glob);
+
+        nla_nest_end(msg, tc_options);
     } else {
         if (!(tc_options = nla_nest_start(msg, TCA_OPTIONS)))
             goto nla_put_failure;
@@ -4978,6 +5467,71 @@ nla_put_failure:
     g_return_val_if_reached(NULL);
 }
 
+static struct nl_msg *
+_nl_msg_new_tclass(NMPlatform *            platform,
+                   int                     nlmsg_type,
+                   int                     nlmsg_flags,
+                   const NMPlatformTclass *tclass)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    struct nlattr *              tc_options;
+    const struct tcmsg           tcm = {
+        .tcm_family  = tclass->addr_family,
+        .tcm_ifindex = tclass->ifindex,
+        .tcm_handle  = tclass->handle,
+        .tcm_parent  = tclass->parent,
+        .tcm_info    = tclass->info,
+    };
+
+    msg = nlmsg_alloc_simple(nlmsg_type, nlmsg_flags | NMP_NLM_FLAG_F_ECHO);
+
+    if (nlmsg_append_struct(msg, &tcm) < 0)
+        goto nla_put_failure;
+
+    NLA_PUT_STRING(msg, TCA_KIND, tclass->kind);
+
+    if (nlmsg_type != RTM_NEWTCLASS)
+        return g_steal_pointer(&msg);
+
+    if (nm_streq(tclass->kind, "htb")) {
+        struct tc_htb_opt opt = {};
+        guint64           ceil;
+        guint32           burst;
+        guint32           cburst;
+
+        ceil   = tclass->htb.ceil ?: tclass->htb.rate;
+        burst  = tclass->htb.burst ?: NM_PLATFORM_TCLASS_HTB_DEFAULT_BURST;
+        cburst = tclass->htb.cburst ?: NM_PLATFORM_TCLASS_HTB_DEFAULT_BURST;
+
+        if (!(tc_options = nla_nest_start(msg, TCA_OPTIONS)))
+            goto nla_put_failure;
+
+        /* With an ethernet link layer, kernel computes the transmission times
+         * itself and we don't need to pass rate tables. */
+        opt.rate.linklayer = TC_LINKLAYER_ETHERNET;
+        opt.rate.rate      = (tclass->htb.rate >= (1ULL << 32)) ? ~0U : (guint32) tclass->htb.rate;
+        opt.ceil.linklayer = TC_LINKLAYER_ETHERNET;
+        opt.ceil.rate      = (ceil >= (1ULL << 32)) ? ~0U : (guint32) ceil;
+        opt.buffer         = psched_size_to_buffer(platform, tclass->htb.rate, burst);
+        opt.cbuffer        = psched_size_to_buffer(platform, ceil, cburst);
+        opt.quantum        = tclass->htb.quantum;
+        opt.prio           = tclass->htb.prio;
+
+        NLA_PUT(msg, TCA_HTB_PARMS, sizeof(opt), &opt);
+        if (tclass->htb.rate >= (1ULL << 32))
+            NLA_PUT_U64(msg, TCA_HTB_RATE64, tclass->htb.rate);
+        if (ceil >= (1ULL << 32))
+            NLA_PUT_U64(msg, TCA_HTB_CEIL64, ceil);
+
+        nla_nest_end(msg, tc_options);
+    }
+
+    return g_steal_pointer(&msg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
 static struct nl_msg *
 _nl_msg_new_tfilter(int nlmsg_type, int nlmsg_flags, const NMPlatformTfilter *tfilter)
 {
@@ -5648,6 +6202,12 @@ process_events(NMPlatform *platform)
     delayed_action_handle_all(platform, TRUE);
 }
 
+static void
+get_netlink_stats(NMPlatform *platform, NMPlatformNetlinkStats *out_stats)
+{
+    *out_stats = NM_LINUX_PLATFORM_GET_PRIVATE(platform)->stats.counters;
+}
+
 /*****************************************************************************/
 
 static const RefreshAllInfo *
@@ -5667,6 +6227,7 @@ refresh_all_type_get_info(RefreshAllType refresh_all_type)
         R(REFRESH_ALL_TYPE_ROUTING_RULES_IP4, NMP_OBJECT_TYPE_ROUTING_RULE, AF_INET),
         R(REFRESH_ALL_TYPE_ROUTING_RULES_IP6, NMP_OBJECT_TYPE_ROUTING_RULE, AF_INET6),
         R(REFRESH_ALL_TYPE_QDISCS, NMP_OBJECT_TYPE_QDISC, AF_UNSPEC),
+        R(REFRESH_ALL_TYPE_TCLASSES, NMP_OBJECT_TYPE_TCLASS, AF_UNSPEC),
         R(REFRESH_ALL_TYPE_TFILTERS, NMP_OBJECT_TYPE_TFILTER, AF_UNSPEC),
 #undef R
     };
@@ -5695,6 +6256,7 @@ static NM_UTILS_LOOKUP_DEFINE(
     NM_UTILS_LOOKUP_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_IP6,
                          REFRESH_ALL_TYPE_ROUTING_RULES_IP6),
     NM_UTILS_LOOKUP_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS, REFRESH_ALL_TYPE_QDISCS),
+    NM_UTILS_LOOKUP_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES, REFRESH_ALL_TYPE_TCLASSES),
     NM_UTILS_LOOKUP_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS, REFRESH_ALL_TYPE_TFILTERS),
     NM_UTILS_LOOKUP_ITEM_IGNORE_OTHER(), );
 
@@ -5728,6 +6290,8 @@ refresh_all_type_from_needle_object(const NMPObject *obj_needle)
         return REFRESH_ALL_TYPE_IP6_ROUTES;
     case NMP_OBJECT_TYPE_QDISC:
         return REFRESH_ALL_TYPE_QDISCS;
+    case NMP_OBJECT_TYPE_TCLASS:
+        return REFRESH_ALL_TYPE_TCLASSES;
     case NMP_OBJECT_TYPE_TFILTER:
         return REFRESH_ALL_TYPE_TFILTERS;
     case NMP_OBJECT_TYPE_ROUTING_RULE:
@@ -5791,6 +6355,7 @@ static NM_UTILS_LOOKUP_STR_DEFINE(
     NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_IP6,
                              "refresh-all-routing-rules-ip6"),
     NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS, "refresh-all-qdiscs"),
+    NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES, "refresh-all-tclasses"),
     NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS, "refresh-all-tfilters"),
     NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_REFRESH_LINK, "refresh-link"),
     NM_UTILS_LOOKUP_STR_ITEM(DELAYED_ACTION_TYPE_MASTER_CONNECTED, "master-connected"),
@@ -5879,6 +6444,48 @@ delayed_action_refresh_all_in_progress(NMPlatform *platform, DelayedActionType a
     return (priv->delayed_action.refresh_all_in_progress[refresh_all_type] > 0);
 }
 
+static gboolean
+delayed_action_route_get_in_progress(NMPlatform *platform, guint32 seq_number)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint                   i;
+
+    if (!NM_FLAGS_HAS(priv->delayed_action.flags, DELAYED_ACTION_TYPE_WAIT_FOR_NL_RESPONSE))
+        return FALSE;
+
+    for (i = 0; i < priv->delayed_action.list_wait_for_nl_response->len; i++) {
+        const DelayedActionWaitForNlResponseData *data =
+            &g_array_index(priv->delayed_action.list_wait_for_nl_response,
+                           DelayedActionWaitForNlResponseData,
+                           i);
+
+        if (data->response_type == DELAYED_ACTION_RESPONSE_TYPE_ROUTE_GET
+            && data->seq_number == seq_number)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+_stats_dump_complete(NMLinuxPlatformPrivate *                  priv,
+                     const DelayedActionWaitForNlResponseData *data,
+                     WaitForNlResponseResult                   seq_result)
+{
+    NMPlatformNetlinkStats *counters = &priv->stats.counters;
+    guint64                 duration_usec;
+
+    if (seq_result != WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
+        counters->dumps_failed++;
+        return;
+    }
+
+    duration_usec = (nm_utils_get_monotonic_timestamp_nsec() - data->start_ns) / 1000;
+
+    counters->dumps_completed++;
+    counters->dump_time_total_usec += duration_usec;
+    counters->dump_time_max_usec = NM_MAX(counters->dump_time_max_usec, duration_usec);
+}
+
 static void
 delayed_action_wait_for_nl_response_complete(NMPlatform *            platform,
                                              guint                   idx,
@@ -5897,6 +6504,9 @@ delayed_action_wait_for_nl_response_complete(NMPlatform *            platform,
 
     _LOGt_delayed_action(DELAYED_ACTION_TYPE_WAIT_FOR_NL_RESPONSE, data, "complete");
 
+    if (data->response_type == DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS)
+        _stats_dump_complete(priv, data, seq_result);
+
     if (priv->delayed_action.list_wait_for_nl_response->len <= 1)
         priv->delayed_action.flags &= ~DELAYED_ACTION_TYPE_WAIT_FOR_NL_RESPONSE;
     if (data->out_seq_result)
@@ -6008,7 +6618,7 @@ delayed_action_handle_REFRESH_LINK(NMPlatform *platform, int ifindex)
 static void
 delayed_action_handle_REFRESH_ALL(NMPlatform *platform, DelayedActionType flags)
 {
-    do_request_all_no_delayed_actions(platform, flags);
+    do_request_all_no_delayed_actions(platform, flags, NM_PLATFORM_DUMP_REASON_SYNC);
 }
 
 static void
@@ -6181,10 +6791,11 @@ delayed_action_schedule_WAIT_FOR_NL_RESPONSE(NMPlatform *
                                              DelayedActionWaitForNlResponseType response_type,
                                              gpointer                           response_out_data)
 {
-    DelayedActionWaitForNlResponseData data = {
-        .seq_number = seq_number,
-        .timeout_abs_ns =
-            nm_utils_get_monotonic_timestamp_nsec() + (200 * (NM_UTILS_NSEC_PER_SEC / 1000)),
+    const gint64                       now_ns = nm_utils_get_monotonic_timestamp_nsec();
+    DelayedActionWaitForNlResponseData data   = {
+        .seq_number        = seq_number,
+        .start_ns          = now_ns,
+        .timeout_abs_ns    = now_ns + (200 * (NM_UTILS_NSEC_PER_SEC / 1000)),
         .out_seq_result    = out_seq_result,
         .out_errmsg        = out_errmsg,
         .response_type     = response_type,
@@ -6332,10 +6943,20 @@ cache_on_change(NMPlatform *     platform,
                                             | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ROUTES
                                             | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_ALL
                                             | DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS
+                                            | DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES
                                             | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
                                         NULL);
             }
         }
+        {
+            NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+            /* the ethtool settings of a removed link are gone. A new link might
+             * get the same ifindex. */
+            if (cache_op == NMP_CACHE_OPS_REMOVED && obj_old /* <-- make coverity happy */
+                && priv->ethtool_nl)
+                nmp_utils_ethtool_nl_forget_link(priv->ethtool_nl, obj_old->link.ifindex);
+        }
         {
             int ifindex = -1;
 
@@ -6495,6 +7116,17 @@ cache_on_change(NMPlatform *     platform,
                                     NULL);
         }
     } break;
+    case NMP_OBJECT_TYPE_QDISC:
+    {
+        /* Deleting a qdisc also destroys its classes and the filters attached to
+         * it, but kernel doesn't notify about that. */
+        if (cache_op == NMP_CACHE_OPS_REMOVED) {
+            delayed_action_schedule(platform,
+                                    DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES
+                                        | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
+                                    NULL);
+        }
+    } break;
     default:
         break;
     }
@@ -6688,6 +7320,7 @@ _nl_msg_new_dump(NMPObjectType obj_type, int preferred_addr_family)
 
     switch (klass->obj_type) {
     case NMP_OBJECT_TYPE_QDISC:
+    case NMP_OBJECT_TYPE_TCLASS:
     case NMP_OBJECT_TYPE_TFILTER:
     {
         const struct tcmsg tcmsg = {
@@ -6719,7 +7352,82 @@ _nl_msg_new_dump(NMPObjectType obj_type, int preferred_addr_family)
 }
 
 static void
-do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action_type)
+_request_all_tclasses(NMPlatform *platform, int *out_refresh_all_in_progress)
+{
+    gs_unref_array GArray *ifindexes   = NULL;
+    gs_unref_array GArray *seq_results = NULL;
+    NMPLookup              lookup;
+    NMDedupMultiIter       iter;
+    const NMPlatformLink * l;
+    guint                  i;
+    guint                  j;
+
+    /* Unlike qdiscs and filters, kernel refuses to dump the classes of all
+     * devices at once. Request them device by device.
+     *
+     * Kernel also only runs one dump per socket at a time, and rejects a dump
+     * request with EBUSY while another one is still in progress. But a dump that
+     * fits into one message completes right away, which is the common case for
+     * classes. So send the requests for all devices at once and wait for them
+     * together. Then repeat that for the devices that got rejected. */
+    ifindexes = g_array_new(FALSE, FALSE, sizeof(int));
+    nmp_lookup_init_obj_type(&lookup, NMP_OBJECT_TYPE_LINK);
+    nmp_cache_iter_for_each_link (&iter,
+                                  nmp_cache_lookup(nm_platform_get_cache(platform), &lookup),
+                                  &l) {
+        if (NMP_OBJECT_UP_CAST(l)->_link.netlink.is_in_netlink)
+            g_array_append_val(ifindexes, l->ifindex);
+    }
+
+    seq_results = g_array_new(FALSE, TRUE, sizeof(WaitForNlResponseResult));
+
+    while (ifindexes->len > 0) {
+        /* no other dump may be in progress, so that the first request succeeds. */
+        event_handler_read_netlink(platform, TRUE);
+
+        g_array_set_size(seq_results, 0);
+        g_array_set_size(seq_results, ifindexes->len);
+
+        for (i = 0; i < ifindexes->len; i++) {
+            nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+            struct tcmsg *               tcm;
+
+            nlmsg = _nl_msg_new_dump(NMP_OBJECT_TYPE_TCLASS, AF_UNSPEC);
+            if (!nlmsg)
+                break;
+
+            tcm              = nlmsg_data(nlmsg_hdr(nlmsg));
+            tcm->tcm_ifindex = g_array_index(ifindexes, int, i);
+
+            *out_refresh_all_in_progress += 1;
+            if (_nl_send_nlmsg(platform,
+                               nlmsg,
+                               &g_array_index(seq_results, WaitForNlResponseResult, i),
+                               NULL,
+                               DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS,
+                               out_refresh_all_in_progress)
+                < 0)
+                *out_refresh_all_in_progress -= 1;
+        }
+
+        event_handler_read_netlink(platform, TRUE);
+
+        for (i = 0, j = 0; i < ifindexes->len; i++) {
+            if (g_array_index(seq_results, WaitForNlResponseResult, i) == -EBUSY)
+                g_array_index(ifindexes, int, j++) = g_array_index(ifindexes, int, i);
+        }
+        if (j == ifindexes->len) {
+            /* not even the first request got through. Don't loop forever. */
+            break;
+        }
+        g_array_set_size(ifindexes, j);
+    }
+}
+
+static void
+do_request_all_no_delayed_actions(NMPlatform *         platform,
+                                  DelayedActionType    action_type,
+                                  NMPlatformDumpReason reason)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
     DelayedActionType       action_type_prune;
@@ -6761,6 +7469,15 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
         nm_auto_nlmsg struct nl_msg *nlmsg     = NULL;
         int *                        out_refresh_all_in_progress;
 
+        if (NM_FLAGS_ANY(priv->stats.pending_overflow, iflags))
+            priv->stats.counters.dumps[NM_PLATFORM_DUMP_REASON_OVERFLOW]++;
+        else if (NM_FLAGS_ANY(priv->stats.pending_route_resync, iflags))
+            priv->stats.counters.dumps[NM_PLATFORM_DUMP_REASON_ROUTE_RESYNC]++;
+        else
+            priv->stats.counters.dumps[reason]++;
+        priv->stats.pending_overflow &= ~iflags;
+        priv->stats.pending_route_resync &= ~iflags;
+
         out_refresh_all_in_progress =
             &priv->delayed_action.refresh_all_in_progress[refresh_all_type];
         nm_assert(*out_refresh_all_in_progress >= 0);
@@ -6783,7 +7500,14 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
             }
         }
 
-        event_handler_read_netlink(platform, FALSE);
+        if (refresh_all_type == REFRESH_ALL_TYPE_TCLASSES) {
+            _request_all_tclasses(platform, out_refresh_all_in_progress);
+            /* each per-device dump holds its own reference. */
+            *out_refresh_all_in_progress -= 1;
+            continue;
+        }
+
+        event_handler_read_netlink(platform, FALSE);
 
         nlmsg = _nl_msg_new_dump(refresh_all_info->obj_type, refresh_all_info->addr_family);
         if (!nlmsg)
@@ -6810,7 +7534,8 @@ static void
 do_request_one_type_by_needle_object(NMPlatform *platform, const NMPObject *obj_needle)
 {
     do_request_all_no_delayed_actions(platform,
-                                      delayed_action_refresh_from_needle_object(obj_needle));
+                                      delayed_action_refresh_from_needle_object(obj_needle),
+                                      NM_PLATFORM_DUMP_REASON_REQUESTED);
     delayed_action_handle_all(platform, FALSE);
 }
 
@@ -6890,16 +7615,20 @@ event_seq_check(NMPlatform *            platform,
 }
 
 static void
-event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events)
+event_valid_msg(NMPlatform *   platform,
+                struct nl_msg *msg,
+                gboolean       handle_events,
+                gboolean       from_route_events)
 {
     NMLinuxPlatformPrivate *priv;
     nm_auto_nmpobj NMPObject *obj = NULL;
     NMPCacheOpsType           cache_op;
     struct nlmsghdr *         msghdr;
     char                      buf_nlmsghdr[400];
-    gboolean                  is_del  = FALSE;
-    gboolean                  is_dump = FALSE;
-    NMPCache *                cache   = nm_platform_get_cache(platform);
+    gboolean                  is_del       = FALSE;
+    gboolean                  is_dump      = FALSE;
+    gboolean                  is_route_get = FALSE;
+    NMPCache *                cache        = nm_platform_get_cache(platform);
 
     msghdr = nlmsg_hdr(msg);
 
@@ -6933,26 +7662,33 @@ event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events
                   RTM_DELROUTE,
                   RTM_DELRULE,
                   RTM_DELQDISC,
+                  RTM_DELTCLASS,
                   RTM_DELTFILTER)) {
         /* The event notifies about a deleted object. We don't need to initialize all
          * fields of the object. */
         is_del = TRUE;
     }
 
-    obj = nmp_object_new_from_nl(platform, cache, msg, is_del);
+    /* The response to RTM_GETROUTE must be parsed even if the route is in an
+     * ignored table. Only dumps and notifications are filtered. */
+    if (msghdr->nlmsg_type == RTM_NEWROUTE && !from_route_events)
+        is_route_get = delayed_action_route_get_in_progress(platform, msghdr->nlmsg_seq);
+
+    obj = nmp_object_new_from_nl(platform, cache, msg, is_del, is_route_get);
     if (!obj) {
         _LOGT("event-notification: %s: ignore",
               nl_nlmsghdr_to_str(msghdr, buf_nlmsghdr, sizeof(buf_nlmsghdr)));
         return;
     }
 
-    if (!is_del
+    if (!is_del && !from_route_events
         && NM_IN_SET(msghdr->nlmsg_type,
                      RTM_NEWADDR,
                      RTM_NEWLINK,
                      RTM_NEWROUTE,
                      RTM_NEWRULE,
                      RTM_NEWQDISC,
+                     RTM_NEWTCLASS,
                      RTM_NEWTFILTER)) {
         is_dump =
             delayed_action_refresh_all_in_progress(platform,
@@ -6977,6 +7713,7 @@ event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events
         case RTM_NEWLINK:
         case RTM_NEWQDISC:
         case RTM_NEWRULE:
+        case RTM_NEWTCLASS:
         case RTM_NEWTFILTER:
             cache_op = nmp_cache_update_netlink(cache, obj, is_dump, &obj_old, &obj_new);
             if (cache_op != NMP_CACHE_OPS_UNCHANGED) {
@@ -7022,6 +7759,15 @@ event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events
                 }
             }
 
+            if (is_route_get
+                && _route_table_is_ignored(
+                    platform,
+                    nm_platform_route_table_uncoerce(obj->ip_route.table_coerced, TRUE))) {
+                /* we only needed the response. Routes of ignored tables don't
+                 * go into the cache. */
+                break;
+            }
+
             cache_op = nmp_cache_update_netlink_route(cache,
                                                       obj,
                                                       is_dump,
@@ -7066,12 +7812,13 @@ event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events
             }
 
             if (resync_required) {
+                const DelayedActionType resync = delayed_action_refresh_from_needle_object(obj);
+
                 /* we'd like to avoid such resyncs as they are expensive and we should only rely on the
                  * netlink events. This needs investigation. */
                 _LOGT("schedule resync of routes after RTM_NEWROUTE");
-                delayed_action_schedule(platform,
-                                        delayed_action_refresh_from_needle_object(obj),
-                                        NULL);
+                NM_LINUX_PLATFORM_GET_PRIVATE(platform)->stats.pending_route_resync |= resync;
+                delayed_action_schedule(platform, resync, NULL);
             }
             break;
         }
@@ -7081,6 +7828,7 @@ event_valid_msg(NMPlatform *platform, struct nl_msg *msg, gboolean handle_events
         case RTM_DELQDISC:
         case RTM_DELROUTE:
         case RTM_DELRULE:
+        case RTM_DELTCLASS:
         case RTM_DELTFILTER:
             cache_op = nmp_cache_remove_netlink(cache, obj, &obj_old, &obj_new);
             if (cache_op != NMP_CACHE_OPS_UNCHANGED) {
@@ -7266,6 +8014,7 @@ do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *n
     if (NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
                   NMP_OBJECT_TYPE_IP6_ADDRESS,
                   NMP_OBJECT_TYPE_QDISC,
+                  NMP_OBJECT_TYPE_TCLASS,
                   NMP_OBJECT_TYPE_TFILTER)) {
         /* In rare cases, the object is still there after we receive the ACK from
          * kernel. Need to refetch.
@@ -8268,6 +9017,46 @@ infiniband_partition_delete(NMPlatform *platform, int parent, int p_key)
 
 /*****************************************************************************/
 
+static gboolean
+ethtool_nl_event_handler(int fd, GIOCondition io_condition, gpointer user_data)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(user_data);
+
+    nmp_utils_ethtool_nl_process_monitor(priv->ethtool_nl);
+    return TRUE;
+}
+
+static NMPUtilsEthtoolNl *
+ethtool_get_nl(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    int                     fd;
+
+    if (!priv->ethtool_nl_tried) {
+        priv->ethtool_nl_tried = TRUE;
+
+        /* the caller already switched to our netns. The sockets stay there. */
+        priv->ethtool_nl = nmp_utils_ethtool_nl_new();
+
+        /* also read the notifications when nobody asks, so that the socket
+         * does not overflow. */
+        if (priv->ethtool_nl && (fd = nmp_utils_ethtool_nl_get_monitor_fd(priv->ethtool_nl)) >= 0) {
+            priv->ethtool_nl_event_source =
+                nm_g_unix_fd_source_new(fd,
+                                        G_IO_IN | G_IO_NVAL | G_IO_PRI | G_IO_ERR | G_IO_HUP,
+                                        G_PRIORITY_DEFAULT,
+                                        ethtool_nl_event_handler,
+                                        platform,
+                                        NULL);
+            g_source_attach(priv->ethtool_nl_event_source, NULL);
+        }
+    }
+
+    return priv->ethtool_nl;
+}
+
+/*****************************************************************************/
+
 static GObject *
 get_ext_data(NMPlatform *platform, int ifindex)
 {
@@ -8656,6 +9445,16 @@ ip_route_add(NMPlatform *             platform,
 
     nm_platform_ip_route_normalize(addr_family, NMP_OBJECT_CAST_IP_ROUTE(&obj));
 
+    if (_route_table_is_ignored(platform,
+                                nm_platform_route_table_uncoerce(route->table_coerced, TRUE))) {
+        /* we would never see the route in the cache, and could not track it. */
+        _LOGW("route: refuse to add route to table %u which is configured in "
+              "main.ignore-route-tables: %s",
+              nm_platform_route_table_uncoerce(route->table_coerced, TRUE),
+              nmp_object_to_string(&obj, NMP_OBJECT_TO_STRING_PUBLIC, NULL, 0));
+        return -NME_PL_OPNOTSUPP;
+    }
+
     nlmsg = _nl_msg_new_route(RTM_NEWROUTE, flags & NMP_NLM_FLAG_FMASK, &obj);
     if (!nlmsg)
         g_return_val_if_reached(-NME_BUG);
@@ -8685,6 +9484,9 @@ object_delete(NMPlatform *platform, const NMPObject *obj)
     case NMP_OBJECT_TYPE_QDISC:
         nlmsg = _nl_msg_new_qdisc(RTM_DELQDISC, 0, NMP_OBJECT_CAST_QDISC(obj));
         break;
+    case NMP_OBJECT_TYPE_TCLASS:
+        nlmsg = _nl_msg_new_tclass(platform, RTM_DELTCLASS, 0, NMP_OBJECT_CAST_TCLASS(obj));
+        break;
     case NMP_OBJECT_TYPE_TFILTER:
         nlmsg = _nl_msg_new_tfilter(RTM_DELTFILTER, 0, NMP_OBJECT_CAST_TFILTER(obj));
         break;
@@ -8868,6 +9670,50 @@ qdisc_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformQdisc *qdisc)
 
 /*****************************************************************************/
 
+static int
+tclass_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformTclass *tclass)
+{
+    WaitForNlResponseResult      seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+    gs_free char *               errmsg     = NULL;
+    int                          nle;
+    char                         s_buf[256];
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+    /* Note: @tclass must not be copied or kept alive because the lifetime of tclass.kind
+     * is undefined. */
+
+    msg = _nl_msg_new_tclass(platform, RTM_NEWTCLASS, flags, tclass);
+
+    event_handler_read_netlink(platform, FALSE);
+
+    nle = _nl_send_nlmsg(platform,
+                         msg,
+                         &seq_result,
+                         &errmsg,
+                         DELAYED_ACTION_RESPONSE_TYPE_VOID,
+                         NULL);
+    if (nle < 0) {
+        _LOGE("do-add-tclass: failed sending netlink request \"%s\" (%d)", nm_strerror(nle), -nle);
+        return -NME_PL_NETLINK;
+    }
+
+    delayed_action_handle_all(platform, FALSE);
+
+    nm_assert(seq_result);
+
+    _NMLOG(seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK ? LOGL_DEBUG : LOGL_WARN,
+           "do-add-tclass: %s",
+           wait_for_nl_response_to_string(seq_result, errmsg, s_buf, sizeof(s_buf)));
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK)
+        return 0;
+    if (seq_result < 0)
+        return seq_result;
+    return -NME_UNSPEC;
+}
+
+/*****************************************************************************/
+
 static int
 tfilter_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformTfilter *tfilter)
 {
@@ -8911,6 +9757,121 @@ tfilter_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformTfilter *tf
 
 /*****************************************************************************/
 
+/* Maximum number of requests that are in flight at the same time. The responses
+ * (including the echo of the object) must fit into the socket receive buffer. */
+#define OBJECT_APPLY_BATCH_SIZE 128
+
+static struct nl_msg *
+_nl_msg_new_obj_change(NMPlatform *platform, const NMPlatformObjChange *change)
+{
+    const NMPObject *obj   = change->obj;
+    NMPNlmFlags      flags = change->delete ? 0 : change->nlmflags;
+
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_ROUTING_RULE:
+        return _nl_msg_new_routing_rule(change->delete ? RTM_DELRULE : RTM_NEWRULE,
+                                        flags,
+                                        NMP_OBJECT_CAST_ROUTING_RULE(obj));
+    case NMP_OBJECT_TYPE_QDISC:
+        return _nl_msg_new_qdisc(change->delete ? RTM_DELQDISC : RTM_NEWQDISC,
+                                 flags,
+                                 NMP_OBJECT_CAST_QDISC(obj));
+    case NMP_OBJECT_TYPE_TCLASS:
+        return _nl_msg_new_tclass(platform,
+                                  change->delete ? RTM_DELTCLASS : RTM_NEWTCLASS,
+                                  flags,
+                                  NMP_OBJECT_CAST_TCLASS(obj));
+    case NMP_OBJECT_TYPE_TFILTER:
+        return _nl_msg_new_tfilter(change->delete ? RTM_DELTFILTER : RTM_NEWTFILTER,
+                                   flags,
+                                   NMP_OBJECT_CAST_TFILTER(obj));
+    default:
+        g_return_val_if_reached(NULL);
+    }
+}
+
+static gboolean
+object_apply(NMPlatform *platform, const NMPlatformObjChange *changes, guint len)
+{
+    gboolean success = TRUE;
+    guint    i_batch;
+
+    /* Netlink has no transactions. Still, instead of waiting for the response
+     * to each request before sending the next one, send a batch of requests
+     * at once and collect the results afterwards. Kernel processes the requests
+     * of one socket in order, so the order of @changes is preserved. */
+    for (i_batch = 0; i_batch < len; i_batch += OBJECT_APPLY_BATCH_SIZE) {
+        const guint             n = MIN(len - i_batch, (guint) OBJECT_APPLY_BATCH_SIZE);
+        WaitForNlResponseResult seq_results[OBJECT_APPLY_BATCH_SIZE];
+        char *                  errmsgs[OBJECT_APPLY_BATCH_SIZE];
+        guint                   i;
+
+        event_handler_read_netlink(platform, FALSE);
+
+        for (i = 0; i < n; i++) {
+            nm_auto_nlmsg struct nl_msg *msg = NULL;
+            int                          nle;
+
+            seq_results[i] = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+            errmsgs[i]     = NULL;
+
+            msg = _nl_msg_new_obj_change(platform, &changes[i_batch + i]);
+            if (!msg)
+                continue;
+
+            nle = _nl_send_nlmsg(platform,
+                                 msg,
+                                 &seq_results[i],
+                                 &errmsgs[i],
+                                 DELAYED_ACTION_RESPONSE_TYPE_VOID,
+                                 NULL);
+            if (nle < 0) {
+                _LOGE("do-object-apply: failed sending netlink request \"%s\" (%d)",
+                      nm_strerror(nle),
+                      -nle);
+            }
+        }
+
+        delayed_action_handle_all(platform, FALSE);
+
+        for (i = 0; i < n; i++) {
+            const NMPlatformObjChange *change = &changes[i_batch + i];
+            gs_free char *            errmsg = g_steal_pointer(&errmsgs[i]);
+            char                      s_buf[256];
+            char                      sbuf_obj[sizeof(_nm_utils_to_string_buffer)];
+            gboolean                  ok;
+
+            if (seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN) {
+                /* the request was never sent. */
+                success = FALSE;
+                continue;
+            }
+
+            ok = (seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK);
+            if (!ok && change->delete && NM_IN_SET(-((int) seq_results[i]), ENOENT, ESRCH)) {
+                /* the object is already gone. */
+                ok = TRUE;
+            }
+
+            _NMLOG(ok ? LOGL_DEBUG : LOGL_WARN,
+                   "do-object-apply: %s %s: %s",
+                   change->delete ? "delete" : "add",
+                   nmp_object_to_string(change->obj,
+                                        NMP_OBJECT_TO_STRING_PUBLIC,
+                                        sbuf_obj,
+                                        sizeof(sbuf_obj)),
+                   wait_for_nl_response_to_string(seq_results[i], errmsg, s_buf, sizeof(s_buf)));
+
+            if (!ok)
+                success = FALSE;
+        }
+    }
+
+    return success;
+}
+
+/*****************************************************************************/
+
 static gboolean
 event_handler(int fd, GIOCondition io_condition, gpointer user_data)
 {
@@ -8920,12 +9881,369 @@ event_handler(int fd, GIOCondition io_condition, gpointer user_data)
 
 /*****************************************************************************/
 
+/* Upper bound for the messages that the reader thread queues. When the main
+ * thread does not catch up, the reader thread stops reading and the kernel
+ * socket buffer fills up, as it would without the thread. */
+#define READER_QUEUE_MAX_SIZE ((gsize) (32 * 1024 * 1024))
+
+/* How long the main thread waits for the next message from the reader thread,
+ * before it gives up on a sync request. Usually the reader thread answers
+ * much sooner, with a message or by reaching the barrier. */
+#define READER_SYNC_TIMEOUT_USEC (200 * G_TIME_SPAN_MILLISECOND)
+
+typedef struct {
+    unsigned char *    buf;
+    struct sockaddr_nl nla;
+    struct ucred       creds;
+    int                n;
+    bool               creds_has;
+} ReaderMsg;
+
+static void
+_reader_msg_free(gpointer data)
+{
+    ReaderMsg *rmsg = data;
+
+    free(rmsg->buf);
+    nm_g_slice_free(rmsg);
+}
+
+static void
+_eventfd_signal(int fd)
+{
+    /* the counter cannot overflow in practice, so this cannot block. */
+    eventfd_write(fd, 1);
+}
+
+static void
+_eventfd_clear(int fd)
+{
+    eventfd_t v;
+
+    eventfd_read(fd, &v);
+}
+
+/* Sends a NLMSG_NOOP request, that kernel acknowledges. The ack is queued after
+ * all the notifications that kernel sent before. Returns the sequence number
+ * of the request or 0 on failure. */
+static guint32
+_reader_send_barrier(struct nl_sock *sk)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+    msg = nlmsg_alloc_simple(NLMSG_NOOP, NLM_F_ACK);
+    if (nl_send_auto(sk, msg) < 0)
+        return 0;
+    return nlmsg_hdr(msg)->nlmsg_seq;
+}
+
+/* The route event socket sends no other requests, so all acks are for
+ * barriers, also the late ones. */
+static gboolean
+_reader_msg_is_ack(const ReaderMsg *rmsg, guint32 *out_seq)
+{
+    const struct nlmsghdr *hdr = (const struct nlmsghdr *) rmsg->buf;
+
+    if (rmsg->n < (int) NLMSG_HDRLEN || hdr->nlmsg_type != NLMSG_ERROR || rmsg->nla.nl_pid != 0)
+        return FALSE;
+    *out_seq = hdr->nlmsg_seq;
+    return TRUE;
+}
+
+static gpointer
+_reader_thread(gpointer user_data)
+{
+    NMLinuxPlatformPrivate *priv = user_data;
+    struct nl_sock *        sk   = priv->nlh_route_events;
+    struct pollfd           pfds[2];
+    guint64                 sync_seq;
+    guint64                 barrier_sync = 0;
+    guint32                 barrier_seq  = 0;
+
+    memset(pfds, 0, sizeof(pfds));
+    pfds[0].fd     = nl_socket_get_fd(sk);
+    pfds[0].events = POLLIN;
+    pfds[1].fd     = priv->reader.fd_kick;
+    pfds[1].events = POLLIN;
+
+    for (;;) {
+        ReaderMsg *rmsg;
+        gboolean   creds_has;
+        gboolean   wakeup;
+        gboolean   sync_pending;
+        guint32    ack_seq;
+
+        {
+            NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+            if (priv->reader.queue_size >= READER_QUEUE_MAX_SIZE) {
+                g_cond_broadcast(&priv->reader.cond);
+                while (!priv->reader.stop && priv->reader.queue_size >= READER_QUEUE_MAX_SIZE)
+                    g_cond_wait(&priv->reader.cond, &priv->reader.lock);
+            }
+            if (priv->reader.stop)
+                return NULL;
+
+            /* all sync requests up to here are satisfied, once we see
+             * the socket empty or receive the ack for a barrier. */
+            sync_seq     = priv->reader.sync_requested;
+            sync_pending = (sync_seq != priv->reader.sync_done);
+        }
+
+        rmsg = g_slice_new0(ReaderMsg);
+        rmsg->n = nl_recv(sk, &rmsg->nla, &rmsg->buf, &rmsg->creds, &creds_has);
+
+        if (_reader_msg_is_ack(rmsg, &ack_seq)) {
+            _reader_msg_free(rmsg);
+            if (barrier_seq != 0 && ack_seq == barrier_seq) {
+                NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+                barrier_seq = 0;
+                if (priv->reader.sync_done < barrier_sync) {
+                    priv->reader.sync_done = barrier_sync;
+                    g_cond_broadcast(&priv->reader.cond);
+                }
+            }
+            continue;
+        }
+
+        if (rmsg->n == -EAGAIN || rmsg->n == 0) {
+            _reader_msg_free(rmsg);
+
+            {
+                NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+                if (priv->reader.sync_done != sync_seq) {
+                    priv->reader.sync_done = sync_seq;
+                    g_cond_broadcast(&priv->reader.cond);
+                }
+            }
+
+            if (poll(pfds, G_N_ELEMENTS(pfds), -1) > 0 && (pfds[1].revents & POLLIN))
+                _eventfd_clear(priv->reader.fd_kick);
+            continue;
+        }
+
+        rmsg->creds_has = creds_has;
+
+        if (rmsg->n == -NME_NL_MSG_TRUNC) {
+            int buf_size;
+
+            /* the thread owns the socket. Increase the buffer size here and
+             * let the main thread only handle the lost message. */
+            buf_size = nl_socket_get_msg_buf_size(sk);
+            if (buf_size < 512 * 1024)
+                nl_socket_set_msg_buf_size(sk, buf_size * 2);
+        }
+
+        {
+            NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+            g_queue_push_tail(&priv->reader.queue, rmsg);
+            priv->reader.queue_size += sizeof(ReaderMsg) + NM_MAX(rmsg->n, 0);
+
+            if (rmsg->n < 0) {
+                /* the ack of the barrier might be lost too. The main thread
+                 * resyncs anyway, so consider the pending requests done. */
+                barrier_seq            = 0;
+                sync_pending           = FALSE;
+                priv->reader.sync_done = sync_seq;
+            }
+
+            if (priv->reader.main_waiting || rmsg->n < 0)
+                g_cond_broadcast(&priv->reader.cond);
+
+            wakeup                      = !priv->reader.wakeup_pending;
+            priv->reader.wakeup_pending = TRUE;
+        }
+
+        if (wakeup)
+            _eventfd_signal(priv->reader.fd_wakeup);
+
+        if (sync_pending && barrier_seq == 0) {
+            /* During a storm of events, the socket might not get empty. The
+             * barrier tells which messages kernel sent before the request. */
+            barrier_seq  = _reader_send_barrier(sk);
+            barrier_sync = sync_seq;
+        }
+    }
+}
+
+static void
+_reader_release_queue_main_locked(NMLinuxPlatformPrivate *priv)
+{
+    nm_assert(g_queue_is_empty(&priv->reader.queue_main));
+
+    if (priv->reader.queue_main_size == 0)
+        return;
+
+    /* the main thread processed the previous batch. Only now its
+     * messages no longer count against the limit. */
+    if (priv->reader.queue_size >= READER_QUEUE_MAX_SIZE)
+        g_cond_broadcast(&priv->reader.cond);
+    priv->reader.queue_size -= nm_steal_int(&priv->reader.queue_main_size);
+}
+
+static void
+_reader_take_queue_locked(NMLinuxPlatformPrivate *priv)
+{
+    GList *lst;
+
+    if (g_queue_is_empty(&priv->reader.queue_main))
+        _reader_release_queue_main_locked(priv);
+
+    if (g_queue_is_empty(&priv->reader.queue))
+        return;
+
+    while ((lst = g_queue_pop_head_link(&priv->reader.queue)))
+        g_queue_push_tail_link(&priv->reader.queue_main, lst);
+
+    priv->reader.queue_main_size = priv->reader.queue_size;
+    priv->reader.wakeup_pending  = FALSE;
+}
+
+static int
+_reader_recv(NMPlatform *        platform,
+             struct sockaddr_nl *nla,
+             unsigned char **    buf,
+             struct ucred *      out_creds,
+             gboolean *          out_creds_has)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    ReaderMsg *             rmsg;
+    gint64                  end_time;
+    gboolean                timed_out;
+    int                     n;
+
+    if (g_queue_is_empty(&priv->reader.queue_main)) {
+        /* The caller expects to see all events that kernel sent so far,
+         * for example the notifications for a request that just completed.
+         * The reader thread reports when it saw the socket empty or reached
+         * a barrier. Meanwhile, hand out the messages as they come in. Once
+         * the batch that contains the barrier is processed, return -EAGAIN,
+         * so that a storm of events does not keep the caller busy. */
+        NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+        _reader_release_queue_main_locked(priv);
+
+        if (!priv->reader.sync_main_done) {
+            if (priv->reader.sync_main == 0) {
+                priv->reader.sync_main = ++priv->reader.sync_requested;
+                _eventfd_signal(priv->reader.fd_kick);
+            }
+
+            end_time = g_get_monotonic_time() + READER_SYNC_TIMEOUT_USEC;
+            for (;;) {
+                if (priv->reader.sync_done >= priv->reader.sync_main)
+                    priv->reader.sync_main_done = TRUE;
+                _reader_take_queue_locked(priv);
+                if (priv->reader.sync_main_done || !g_queue_is_empty(&priv->reader.queue_main))
+                    break;
+
+                priv->reader.main_waiting = TRUE;
+                timed_out =
+                    !g_cond_wait_until(&priv->reader.cond, &priv->reader.lock, end_time);
+                priv->reader.main_waiting = FALSE;
+                if (timed_out) {
+                    _LOGT("netlink: reader thread did not reach the barrier in time");
+                    priv->reader.sync_main_done = TRUE;
+                }
+            }
+        }
+
+        if (g_queue_is_empty(&priv->reader.queue_main)) {
+            priv->reader.sync_main      = 0;
+            priv->reader.sync_main_done = FALSE;
+            return -EAGAIN;
+        }
+    }
+
+    rmsg = g_queue_pop_head(&priv->reader.queue_main);
+
+    n = rmsg->n;
+    if (n > 0) {
+        *buf           = g_steal_pointer(&rmsg->buf);
+        *nla           = rmsg->nla;
+        *out_creds     = rmsg->creds;
+        *out_creds_has = rmsg->creds_has;
+    }
+    _reader_msg_free(rmsg);
+    return n;
+}
+
+static gboolean
+_reader_wakeup_cb(int fd, GIOCondition io_condition, gpointer user_data)
+{
+    _eventfd_clear(fd);
+    delayed_action_handle_all(NM_PLATFORM(user_data), TRUE);
+    return TRUE;
+}
+
+static void
+_reader_start(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    priv->reader.fd_wakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    priv->reader.fd_kick   = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (priv->reader.fd_wakeup < 0 || priv->reader.fd_kick < 0) {
+        _LOGW("netlink: failed to create eventfd for reader thread. Read events on main thread");
+        nm_close(priv->reader.fd_wakeup);
+        nm_close(priv->reader.fd_kick);
+        priv->reader.fd_wakeup = -1;
+        priv->reader.fd_kick   = -1;
+        return;
+    }
+
+    priv->reader.thread = g_thread_new("nm-netlink-rd", _reader_thread, priv);
+
+    _LOGD("netlink: started reader thread for route events");
+
+    priv->event_source_route_events =
+        nm_g_unix_fd_source_new(priv->reader.fd_wakeup,
+                                G_IO_IN | G_IO_NVAL | G_IO_PRI | G_IO_ERR | G_IO_HUP,
+                                G_PRIORITY_DEFAULT,
+                                _reader_wakeup_cb,
+                                platform,
+                                NULL);
+    g_source_attach(priv->event_source_route_events, NULL);
+}
+
+static void
+_reader_stop(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    ReaderMsg *             rmsg;
+
+    if (priv->reader.thread) {
+        NM_G_MUTEX_LOCKED(&priv->reader.lock);
+
+        priv->reader.stop = TRUE;
+        g_cond_broadcast(&priv->reader.cond);
+        _eventfd_signal(priv->reader.fd_kick);
+    }
+
+    if (priv->reader.thread)
+        g_thread_join(g_steal_pointer(&priv->reader.thread));
+
+    while ((rmsg = g_queue_pop_head(&priv->reader.queue)))
+        _reader_msg_free(rmsg);
+    while ((rmsg = g_queue_pop_head(&priv->reader.queue_main)))
+        _reader_msg_free(rmsg);
+    nm_close(priv->reader.fd_wakeup);
+    nm_close(priv->reader.fd_kick);
+    priv->reader.fd_wakeup = -1;
+    priv->reader.fd_kick   = -1;
+}
+
+/*****************************************************************************/
+
 /* copied from libnl3's recvmsgs() */
 static int
-event_handler_recvmsgs(NMPlatform *platform, gboolean handle_events)
+event_handler_recvmsgs(NMPlatform *platform, struct nl_sock *sk, gboolean handle_events)
 {
-    NMLinuxPlatformPrivate *    priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
-    struct nl_sock *            sk   = priv->nlh;
+    NMLinuxPlatformPrivate *    priv              = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const gboolean              from_route_events = (sk == priv->nlh_route_events);
     int                         n;
     int                         err         = 0;
     gboolean                    multipart   = 0;
@@ -8939,10 +10257,13 @@ event_handler_recvmsgs(NMPlatform *platform, gboolean handle_events)
 
 continue_reading:
     nm_clear_pointer(&buf, free);
-    n = nl_recv(sk, &nla, &buf, &creds, &creds_has);
+    if (from_route_events && priv->reader.thread)
+        n = _reader_recv(platform, &nla, &buf, &creds, &creds_has);
+    else
+        n = nl_recv(sk, &nla, &buf, &creds, &creds_has);
 
     if (n <= 0) {
-        if (n == -NME_NL_MSG_TRUNC) {
+        if (n == -NME_NL_MSG_TRUNC && !(from_route_events && priv->reader.thread)) {
             int buf_size;
 
             /* the message receive buffer was too small. We lost one message, which
@@ -8988,6 +10309,11 @@ continue_reading:
         _LOGt("netlink: recvmsg: new message %s",
               nl_nlmsghdr_to_str(hdr, buf_nlmsghdr, sizeof(buf_nlmsghdr)));
 
+        if (hdr->nlmsg_type < NM_PLATFORM_NETLINK_STATS_MSG_TYPE_NUM)
+            priv->stats.counters.nl_msgs[hdr->nlmsg_type]++;
+        else
+            priv->stats.counters.nl_msgs_other++;
+
         nlmsg_set_creds(msg, &creds);
 
         if (hdr->nlmsg_flags & NLM_F_MULTI)
@@ -9074,6 +10400,20 @@ continue_reading:
         } else
             process_valid_msg = TRUE;
 
+        if (from_route_events) {
+            /* The route event socket never sends requests. Notifications that
+             * are caused by our own requests carry the sequence number of that
+             * request, but the response is only received on the main socket.
+             * Don't let them complete the pending request. */
+            if (process_valid_msg)
+                event_valid_msg(platform, msg, handle_events, TRUE);
+            if (abort_parsing)
+                goto stop;
+            err = 0;
+            hdr = nlmsg_next(hdr, &n);
+            continue;
+        }
+
         seq_number = nlmsg_hdr(msg)->nlmsg_seq;
 
         /* check whether the seq number is different from before, and
@@ -9090,7 +10430,7 @@ continue_reading:
              * get along with broken kernels. NL_SKIP has no
              * effect on this.  */
 
-            event_valid_msg(platform, msg, handle_events);
+            event_valid_msg(platform, msg, handle_events, FALSE);
 
             seq_result = WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK;
         }
@@ -9123,6 +10463,82 @@ stop:
 
 /*****************************************************************************/
 
+static gboolean
+event_handler_read_netlink_socket(NMPlatform *platform, struct nl_sock *sk)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gboolean                any  = FALSE;
+
+    for (;;) {
+        DelayedActionType resync;
+        RefreshAllType    refresh_all_type;
+        int               nle;
+
+        nle = event_handler_recvmsgs(platform, sk, TRUE);
+
+        if (nle < 0) {
+            switch (nle) {
+            case -EAGAIN:
+                return any;
+            case -NME_NL_DUMP_INTR:
+                _LOGD("netlink: read: uncritical failure to retrieve incoming events: %s (%d)",
+                      nm_strerror(nle),
+                      nle);
+                break;
+            case -NME_NL_MSG_TRUNC:
+            case -ENOBUFS:
+                _LOGI("netlink: read%s: %s. Need to resynchronize platform cache",
+                      sk == priv->nlh_route_events ? " route events" : "",
+                      ({
+                          const char *_reason = "unknown";
+                          switch (nle) {
+                          case -NME_NL_MSG_TRUNC:
+                              _reason = "message truncated";
+                              break;
+                          case -ENOBUFS:
+                              _reason = "too many netlink events";
+                              break;
+                          }
+                          _reason;
+                      }));
+                event_handler_recvmsgs(platform, sk, FALSE);
+
+                priv->stats.counters.nl_overflows++;
+
+                if (sk == priv->nlh_route_events) {
+                    /* only route and rule events got lost. Responses to our
+                     * requests are not affected. */
+                    resync = DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTE_EVENTS;
+                } else {
+                    /* we might have lost responses to dump requests. Those
+                     * must be repeated, including for routes and rules. */
+                    resync = DELAYED_ACTION_TYPE_REFRESH_ALL
+                             & ~DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTE_EVENTS;
+                    for (refresh_all_type = _REFRESH_ALL_TYPE_FIRST;
+                         refresh_all_type < _REFRESH_ALL_TYPE_NUM;
+                         refresh_all_type++) {
+                        if (priv->delayed_action.refresh_all_in_progress[refresh_all_type] > 0)
+                            resync |= delayed_action_type_from_refresh_all_type(refresh_all_type);
+                    }
+                    delayed_action_wait_for_nl_response_complete_all(
+                        platform,
+                        WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC);
+                }
+
+                priv->stats.pending_overflow |= resync;
+                delayed_action_schedule(platform, resync, NULL);
+                break;
+            default:
+                _LOGE("netlink: read: failed to retrieve incoming events: %s (%d)",
+                      nm_strerror(nle),
+                      nle);
+                break;
+            }
+        }
+        any = TRUE;
+    }
+}
+
 static gboolean
 event_handler_read_netlink(NMPlatform *platform, gboolean wait_for_acks)
 {
@@ -9145,59 +10561,15 @@ event_handler_read_netlink(NMPlatform *platform, gboolean wait_for_acks)
     }
 
     for (;;) {
-        for (;;) {
-            int nle;
-
-            nle = event_handler_recvmsgs(platform, TRUE);
-
-            if (nle < 0) {
-                switch (nle) {
-                case -EAGAIN:
-                    goto after_read;
-                case -NME_NL_DUMP_INTR:
-                    _LOGD("netlink: read: uncritical failure to retrieve incoming events: %s (%d)",
-                          nm_strerror(nle),
-                          nle);
-                    break;
-                case -NME_NL_MSG_TRUNC:
-                case -ENOBUFS:
-                    _LOGI("netlink: read: %s. Need to resynchronize platform cache", ({
-                              const char *_reason = "unknown";
-                              switch (nle) {
-                              case -NME_NL_MSG_TRUNC:
-                                  _reason = "message truncated";
-                                  break;
-                              case -ENOBUFS:
-                                  _reason = "too many netlink events";
-                                  break;
-                              }
-                              _reason;
-                          }));
-                    event_handler_recvmsgs(platform, FALSE);
-                    delayed_action_wait_for_nl_response_complete_all(
-                        platform,
-                        WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC);
+        if (event_handler_read_netlink_socket(platform, priv->nlh))
+            any = TRUE;
 
-                    delayed_action_schedule(platform,
-                                            DELAYED_ACTION_TYPE_REFRESH_ALL_LINKS
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ADDRESSES
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ADDRESSES
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ROUTES
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ROUTES
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_ALL
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS
-                                                | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
-                                            NULL);
-                    break;
-                default:
-                    _LOGE("netlink: read: failed to retrieve incoming events: %s (%d)",
-                          nm_strerror(nle),
-                          nle);
-                    break;
-                }
-            }
+        /* Read the route events after the main socket. When we receive the
+         * response to a request, the notifications that it caused are already
+         * queued on the route event socket, so the cache is up to date when the
+         * request completes. */
+        if (event_handler_read_netlink_socket(platform, priv->nlh_route_events))
             any = TRUE;
-        }
 
 after_read:
 
@@ -9388,6 +10760,189 @@ nm_linux_platform_init(NMLinuxPlatform *self)
     priv->delayed_action.list_refresh_link     = g_ptr_array_new();
     priv->delayed_action.list_wait_for_nl_response =
         g_array_new(FALSE, TRUE, sizeof(DelayedActionWaitForNlResponseData));
+
+    g_mutex_init(&priv->reader.lock);
+    g_cond_init(&priv->reader.cond);
+    g_queue_init(&priv->reader.queue);
+    g_queue_init(&priv->reader.queue_main);
+    priv->reader.fd_wakeup = -1;
+    priv->reader.fd_kick   = -1;
+}
+
+static void
+set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(object);
+
+    switch (prop_id) {
+    case PROP_NETLINK_READER_THREAD:
+        /* construct-only */
+        priv->netlink_reader_thread = g_value_get_boolean(value);
+        break;
+    case PROP_IGNORED_ROUTE_TABLES:
+    {
+        GArray *arr = g_value_get_boxed(value);
+
+        /* construct-only */
+        if (arr && arr->len > 0) {
+            guint i;
+            guint j;
+
+            priv->ignored_route_tables = nm_memdup(arr->data, sizeof(guint32) * arr->len);
+            g_qsort_with_data(priv->ignored_route_tables,
+                              arr->len,
+                              sizeof(guint32),
+                              nm_cmp_uint32_p_with_data,
+                              NULL);
+            for (i = 0, j = 0; i < arr->len; i++) {
+                if (j > 0 && priv->ignored_route_tables[j - 1] == priv->ignored_route_tables[i])
+                    continue;
+                priv->ignored_route_tables[j++] = priv->ignored_route_tables[i];
+            }
+            priv->ignored_route_tables_len = j;
+        }
+        break;
+    }
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static struct nl_sock *
+_nl_socket_new_route(void)
+{
+    struct nl_sock *sk;
+    int             nle;
+
+    sk = nl_socket_alloc();
+    g_assert(sk);
+
+    nle = nl_connect(sk, NETLINK_ROUTE);
+    g_assert(!nle);
+    nle = nl_socket_set_passcred(sk, 1);
+    g_assert(!nle);
+
+    /* No blocking for event socket, so that we can drain it safely. */
+    nle = nl_socket_set_nonblocking(sk);
+    g_assert(!nle);
+
+    /* use 8 MB for receive socket kernel queue. */
+    nle = nl_socket_set_buffer_size(sk, 8 * 1024 * 1024, 0);
+    g_assert(!nle);
+
+    /* explicitly set the msg buffer size and disable MSG_PEEK.
+     * If we later encounter NME_NL_MSG_TRUNC, we will adjust the buffer size. */
+    nl_socket_disable_msg_peek(sk);
+    nle = nl_socket_set_msg_buf_size(sk, 32 * 1024);
+    g_assert(!nle);
+
+    return sk;
+}
+
+/* Classic BPF jump offsets are 8 bit. That limits how many tables we
+ * can check in the kernel. With more tables, we filter only in user space. */
+#define ROUTE_TABLE_FILTER_MAX_TABLES 100
+
+static void
+_nl_socket_attach_route_table_filter(NMPlatform *platform, struct nl_sock *sk)
+{
+    NMLinuxPlatformPrivate *    priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const guint                 n    = priv->ignored_route_tables_len;
+    gs_free struct sock_filter *filter = NULL;
+    struct sock_fprog           fprog;
+    guint                       n_compat;
+    guint                       i_compat;
+    guint                       i_accept;
+    guint                       i;
+    guint                       j;
+
+    if (n == 0)
+        return;
+
+    if (n > ROUTE_TABLE_FILTER_MAX_TABLES) {
+        _LOGD("netlink: too many ignored route tables (%u) to filter route events in kernel", n);
+        return;
+    }
+
+    n_compat = 0;
+    for (i = 0; i < n; i++) {
+        if (priv->ignored_route_tables[i] < RT_TABLE_COMPAT)
+            n_compat++;
+    }
+
+    /* Drop RTM_NEWROUTE and RTM_DELROUTE notifications for the ignored
+     * tables. The table is in the RTA_TABLE attribute. If we don't find
+     * it, fall back to rtm_table.
+     *
+     * Note that BPF loads words in network byte order, while netlink uses
+     * host byte order. */
+    i_compat = 9 + n + 1;
+    i_accept = i_compat + 1 + n_compat;
+    filter   = g_new(struct sock_filter, i_accept + 2);
+    j        = 0;
+
+    /* A <- nlmsg_type */
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+                                                offsetof(struct nlmsghdr, nlmsg_type));
+    filter[j++] =
+        (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_NEWROUTE), 1, 0);
+    filter[j++] = (struct sock_filter)
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_DELROUTE), 0, i_accept - 3);
+
+    /* A <- offset of RTA_TABLE, or zero */
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_IMM,
+                                                NLMSG_HDRLEN + NLMSG_ALIGN(sizeof(struct rtmsg)));
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_LDX | BPF_IMM, RTA_TABLE);
+    filter[j++] =
+        (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_NLATTR);
+    filter[j++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, i_compat - 7, 0);
+
+    /* A <- RTA_TABLE */
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_MISC | BPF_TAX, 0);
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_IND, NLA_HDRLEN);
+    nm_assert(j == 9);
+    for (i = 0; i < n; i++) {
+        filter[j] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                  htonl(priv->ignored_route_tables[i]),
+                                                  i_accept + 1 - (j + 1),
+                                                  0);
+        j++;
+    }
+    filter[j] = (struct sock_filter) BPF_STMT(BPF_JMP | BPF_JA, i_accept - (j + 1));
+    j++;
+
+    /* A <- rtm_table */
+    nm_assert(j == i_compat);
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_B | BPF_ABS,
+                                                NLMSG_HDRLEN + offsetof(struct rtmsg, rtm_table));
+    for (i = 0; i < n; i++) {
+        if (priv->ignored_route_tables[i] >= RT_TABLE_COMPAT)
+            continue;
+        filter[j] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                  priv->ignored_route_tables[i],
+                                                  i_accept + 1 - (j + 1),
+                                                  0);
+        j++;
+    }
+
+    nm_assert(j == i_accept);
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFFu);
+    filter[j++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0);
+
+    fprog = (struct sock_fprog){
+        .filter = filter,
+        .len    = j,
+    };
+    if (setsockopt(nl_socket_get_fd(sk), SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog))
+        < 0) {
+        int errsv = errno;
+
+        _LOGD("netlink: failed to attach route table filter: %s", nm_strerror_native(errsv));
+        return;
+    }
+
+    _LOGD("netlink: filter route events for %u ignored tables in kernel", n);
 }
 
 static void
@@ -9427,49 +10982,37 @@ constructed(GObject *_object)
         priv->genl = NULL;
     }
 
-    priv->nlh = nl_socket_alloc();
-    g_assert(priv->nlh);
-
-    nle = nl_connect(priv->nlh, NETLINK_ROUTE);
-    g_assert(!nle);
-    nle = nl_socket_set_passcred(priv->nlh, 1);
-    g_assert(!nle);
-
-    /* No blocking for event socket, so that we can drain it safely. */
-    nle = nl_socket_set_nonblocking(priv->nlh);
-    g_assert(!nle);
-
-    /* use 8 MB for receive socket kernel queue. */
-    nle = nl_socket_set_buffer_size(priv->nlh, 8 * 1024 * 1024, 0);
-    g_assert(!nle);
+    priv->nlh = _nl_socket_new_route();
 
     nle = nl_socket_set_ext_ack(priv->nlh, TRUE);
     if (nle)
         _LOGD("could not enable extended acks on netlink socket");
 
-    /* explicitly set the msg buffer size and disable MSG_PEEK.
-     * If we later encounter NME_NL_MSG_TRUNC, we will adjust the buffer size. */
-    nl_socket_disable_msg_peek(priv->nlh);
-    nle = nl_socket_set_msg_buf_size(priv->nlh, 32 * 1024);
-    g_assert(!nle);
-
     nle = nl_socket_add_memberships(priv->nlh,
                                     RTNLGRP_IPV4_IFADDR,
+                                    RTNLGRP_IPV6_IFADDR,
+                                    RTNLGRP_LINK,
+                                    RTNLGRP_TC,
+                                    0);
+    g_assert(!nle);
+
+    priv->nlh_route_events = _nl_socket_new_route();
+
+    nle = nl_socket_add_memberships(priv->nlh_route_events,
                                     RTNLGRP_IPV4_ROUTE,
                                     RTNLGRP_IPV4_RULE,
                                     RTNLGRP_IPV6_RULE,
-                                    RTNLGRP_IPV6_IFADDR,
                                     RTNLGRP_IPV6_ROUTE,
-                                    RTNLGRP_LINK,
-                                    RTNLGRP_TC,
                                     0);
     g_assert(!nle);
 
     fd = nl_socket_get_fd(priv->nlh);
 
-    _LOGD("Netlink socket for events established: port=%u, fd=%d",
+    _LOGD("Netlink socket for events established: port=%u, fd=%d (route events: port=%u, fd=%d)",
           nl_socket_get_local_port(priv->nlh),
-          fd);
+          fd,
+          nl_socket_get_local_port(priv->nlh_route_events),
+          nl_socket_get_fd(priv->nlh_route_events));
 
     priv->event_source =
         nm_g_unix_fd_source_new(fd,
@@ -9480,6 +11023,22 @@ constructed(GObject *_object)
                                 NULL);
     g_source_attach(priv->event_source, NULL);
 
+    _nl_socket_attach_route_table_filter(platform, priv->nlh_route_events);
+
+    if (priv->netlink_reader_thread)
+        _reader_start(platform);
+
+    if (!priv->reader.thread) {
+        priv->event_source_route_events =
+            nm_g_unix_fd_source_new(nl_socket_get_fd(priv->nlh_route_events),
+                                    G_IO_IN | G_IO_NVAL | G_IO_PRI | G_IO_ERR | G_IO_HUP,
+                                    G_PRIORITY_DEFAULT,
+                                    event_handler,
+                                    platform,
+                                    NULL);
+        g_source_attach(priv->event_source_route_events, NULL);
+    }
+
     /* complete construction of the GObject instance before populating the cache. */
     G_OBJECT_CLASS(nm_linux_platform_parent_class)->constructed(_object);
 
@@ -9491,7 +11050,8 @@ constructed(GObject *_object)
             | DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ROUTES
             | DELAYED_ACTION_TYPE_REFRESH_ALL_IP6_ROUTES
             | DELAYED_ACTION_TYPE_REFRESH_ALL_ROUTING_RULES_ALL
-            | DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
+            | DELAYED_ACTION_TYPE_REFRESH_ALL_QDISCS | DELAYED_ACTION_TYPE_REFRESH_ALL_TCLASSES
+            | DELAYED_ACTION_TYPE_REFRESH_ALL_TFILTERS,
         NULL);
 
     delayed_action_handle_all(platform, FALSE);
@@ -9548,13 +11108,23 @@ path_is_read_only_fs(const char *path)
 }
 
 NMPlatform *
-nm_linux_platform_new(gboolean log_with_ptr, gboolean netns_support)
+nm_linux_platform_new_full(gboolean       log_with_ptr,
+                           gboolean       netns_support,
+                           gboolean       netlink_reader_thread,
+                           const guint32 *ignored_route_tables,
+                           guint          n_ignored_route_tables)
 {
-    gboolean use_udev = FALSE;
+    gs_unref_array GArray *tables   = NULL;
+    gboolean               use_udev = FALSE;
 
     if (nmp_netns_is_initial() && path_is_read_only_fs("/sys") == FALSE)
         use_udev = TRUE;
 
+    if (n_ignored_route_tables > 0) {
+        tables = g_array_sized_new(FALSE, FALSE, sizeof(guint32), n_ignored_route_tables);
+        g_array_append_vals(tables, ignored_route_tables, n_ignored_route_tables);
+    }
+
     return g_object_new(NM_TYPE_LINUX_PLATFORM,
                         NM_PLATFORM_LOG_WITH_PTR,
                         log_with_ptr,
@@ -9562,9 +11132,19 @@ nm_linux_platform_new(gboolean log_with_ptr, gboolean netns_support)
                         use_udev,
                         NM_PLATFORM_NETNS_SUPPORT,
                         netns_support,
+                        NM_LINUX_PLATFORM_NETLINK_READER_THREAD,
+                        netlink_reader_thread,
+                        NM_LINUX_PLATFORM_IGNORED_ROUTE_TABLES,
+                        tables,
                         NULL);
 }
 
+NMPlatform *
+nm_linux_platform_new(gboolean log_with_ptr, gboolean netns_support, gboolean netlink_reader_thread)
+{
+    return nm_linux_platform_new_full(log_with_ptr, netns_support, netlink_reader_thread, NULL, 0);
+}
+
 static void
 dispose(GObject *object)
 {
@@ -9594,9 +11174,20 @@ finalize(GObject *object)
 
     nl_socket_free(priv->genl);
 
+    nm_clear_g_source_inst(&priv->ethtool_nl_event_source);
+    nmp_utils_ethtool_nl_free(priv->ethtool_nl);
+
     nm_clear_g_source_inst(&priv->event_source);
+    nm_clear_g_source_inst(&priv->event_source_route_events);
+
+    _reader_stop(NM_PLATFORM(object));
+    g_mutex_clear(&priv->reader.lock);
+    g_cond_clear(&priv->reader.cond);
+
+    g_free(priv->ignored_route_tables);
 
     nl_socket_free(priv->nlh);
+    nl_socket_free(priv->nlh_route_events);
 
     {
         NM_G_MUTEX_LOCKED(&sysctl_clear_cache_lock);
@@ -9621,9 +11212,28 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     GObjectClass *   object_class   = G_OBJECT_CLASS(klass);
     NMPlatformClass *platform_class = NM_PLATFORM_CLASS(klass);
 
-    object_class->constructed = constructed;
-    object_class->dispose     = dispose;
-    object_class->finalize    = finalize;
+    object_class->constructed  = constructed;
+    object_class->set_property = set_property;
+    object_class->dispose      = dispose;
+    object_class->finalize     = finalize;
+
+    g_object_class_install_property(
+        object_class,
+        PROP_NETLINK_READER_THREAD,
+        g_param_spec_boolean(NM_LINUX_PLATFORM_NETLINK_READER_THREAD,
+                             "",
+                             "",
+                             FALSE,
+                             G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        object_class,
+        PROP_IGNORED_ROUTE_TABLES,
+        g_param_spec_boxed(NM_LINUX_PLATFORM_IGNORED_ROUTE_TABLES,
+                           "",
+                           "",
+                           G_TYPE_ARRAY,
+                           G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 
     platform_class->sysctl_set       = sysctl_set;
     platform_class->sysctl_set_async = sysctl_set_async;
@@ -9669,6 +11279,8 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->infiniband_partition_add    = infiniband_partition_add;
     platform_class->infiniband_partition_delete = infiniband_partition_delete;
 
+    platform_class->ethtool_get_nl = ethtool_get_nl;
+
     platform_class->wifi_get_capabilities            = wifi_get_capabilities;
     platform_class->wifi_get_frequency               = wifi_get_frequency;
     platform_class->wifi_get_station                 = wifi_get_station;
@@ -9693,6 +11305,7 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->link_tun_add = link_tun_add;
 
     platform_class->object_delete      = object_delete;
+    platform_class->object_apply       = object_apply;
     platform_class->ip4_address_add    = ip4_address_add;
     platform_class->ip6_address_add    = ip6_address_add;
     platform_class->ip4_address_delete = ip4_address_delete;
@@ -9704,7 +11317,9 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->routing_rule_add = routing_rule_add;
 
     platform_class->qdisc_add   = qdisc_add;
+    platform_class->tclass_add  = tclass_add;
     platform_class->tfilter_add = tfilter_add;
 
-    platform_class->process_events = process_events;
+    platform_class->process_events    = process_events;
+    platform_class->get_netlink_stats = get_netlink_stats;
 }
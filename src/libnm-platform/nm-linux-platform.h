@@ -18,11 +18,22 @@
 #define NM_LINUX_PLATFORM_GET_CLASS(obj) \
     (G_TYPE_INSTANCE_GET_CLASS((obj), NM_TYPE_LINUX_PLATFORM, NMLinuxPlatformClass))
 
+#define NM_LINUX_PLATFORM_NETLINK_READER_THREAD "netlink-reader-thread"
+#define NM_LINUX_PLATFORM_IGNORED_ROUTE_TABLES  "ignored-route-tables"
+
 typedef struct _NMLinuxPlatform      NMLinuxPlatform;
 typedef struct _NMLinuxPlatformClass NMLinuxPlatformClass;
 
 GType nm_linux_platform_get_type(void);
 
-NMPlatform *nm_linux_platform_new(gboolean log_with_ptr, gboolean netns_support);
+NMPlatform *nm_linux_platform_new(gboolean log_with_ptr,
+                                  gboolean netns_support,
+                                  gboolean netlink_reader_thread);
+
+NMPlatform *nm_linux_platform_new_full(gboolean       log_with_ptr,
+                                       gboolean       netns_support,
+                                       gboolean       netlink_reader_thread,
+                                       const guint32 *ignored_route_tables,
+                                       guint          n_ignored_route_tables);
 
 #endif /* __NETWORKMANAGER_LINUX_PLATFORM_H__ */
@@ -73,6 +73,36 @@ NM_UTILS_FLAGS2STR_DEFINE(nl_nlmsg_flags2str,
 
 /*****************************************************************************/
 
+NM_UTILS_LOOKUP_STR_DEFINE(nl_nlmsg_type_to_str,
+                           guint16,
+                           NM_UTILS_LOOKUP_DEFAULT(NULL),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETLINK, "RTM_GETLINK"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWLINK, "RTM_NEWLINK"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELLINK, "RTM_DELLINK"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_SETLINK, "RTM_SETLINK"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETADDR, "RTM_GETADDR"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWADDR, "RTM_NEWADDR"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELADDR, "RTM_DELADDR"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETROUTE, "RTM_GETROUTE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWROUTE, "RTM_NEWROUTE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELROUTE, "RTM_DELROUTE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETRULE, "RTM_GETRULE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWRULE, "RTM_NEWRULE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELRULE, "RTM_DELRULE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETQDISC, "RTM_GETQDISC"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWQDISC, "RTM_NEWQDISC"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELQDISC, "RTM_DELQDISC"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETTCLASS, "RTM_GETTCLASS"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWTCLASS, "RTM_NEWTCLASS"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELTCLASS, "RTM_DELTCLASS"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_GETTFILTER, "RTM_GETTFILTER"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_NEWTFILTER, "RTM_NEWTFILTER"),
+                           NM_UTILS_LOOKUP_STR_ITEM(RTM_DELTFILTER, "RTM_DELTFILTER"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NLMSG_NOOP, "NLMSG_NOOP"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NLMSG_ERROR, "NLMSG_ERROR"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NLMSG_DONE, "NLMSG_DONE"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NLMSG_OVERRUN, "NLMSG_OVERRUN"), );
+
 const char *
 nl_nlmsghdr_to_str(const struct nlmsghdr *hdr, char *buf, gsize len)
 {
@@ -86,80 +116,7 @@ nl_nlmsghdr_to_str(const struct nlmsghdr *hdr, char *buf, gsize len)
 
     b = buf;
 
-    switch (hdr->nlmsg_type) {
-    case RTM_GETLINK:
-        s = "RTM_GETLINK";
-        break;
-    case RTM_NEWLINK:
-        s = "RTM_NEWLINK";
-        break;
-    case RTM_DELLINK:
-        s = "RTM_DELLINK";
-        break;
-    case RTM_SETLINK:
-        s = "RTM_SETLINK";
-        break;
-    case RTM_GETADDR:
-        s = "RTM_GETADDR";
-        break;
-    case RTM_NEWADDR:
-        s = "RTM_NEWADDR";
-        break;
-    case RTM_DELADDR:
-        s = "RTM_DELADDR";
-        break;
-    case RTM_GETROUTE:
-        s = "RTM_GETROUTE";
-        break;
-    case RTM_NEWROUTE:
-        s = "RTM_NEWROUTE";
-        break;
-    case RTM_DELROUTE:
-        s = "RTM_DELROUTE";
-        break;
-    case RTM_GETRULE:
-        s = "RTM_GETRULE";
-        break;
-    case RTM_NEWRULE:
-        s = "RTM_NEWRULE";
-        break;
-    case RTM_DELRULE:
-        s = "RTM_DELRULE";
-        break;
-    case RTM_GETQDISC:
-        s = "RTM_GETQDISC";
-        break;
-    case RTM_NEWQDISC:
-        s = "RTM_NEWQDISC";
-        break;
-    case RTM_DELQDISC:
-        s = "RTM_DELQDISC";
-        break;
-    case RTM_GETTFILTER:
-        s = "RTM_GETTFILTER";
-        break;
-    case RTM_NEWTFILTER:
-        s = "RTM_NEWTFILTER";
-        break;
-    case RTM_DELTFILTER:
-        s = "RTM_DELTFILTER";
-        break;
-    case NLMSG_NOOP:
-        s = "NLMSG_NOOP";
-        break;
-    case NLMSG_ERROR:
-        s = "NLMSG_ERROR";
-        break;
-    case NLMSG_DONE:
-        s = "NLMSG_DONE";
-        break;
-    case NLMSG_OVERRUN:
-        s = "NLMSG_OVERRUN";
-        break;
-    default:
-        s = NULL;
-        break;
-    }
+    s = nl_nlmsg_type_to_str(hdr->nlmsg_type);
 
     if (s)
         nm_utils_strbuf_append_str(&buf, &len, s);
@@ -203,6 +160,7 @@ nl_nlmsghdr_to_str(const struct nlmsghdr *hdr, char *buf, gsize len)
     case RTM_NEWADDR:
     case RTM_NEWROUTE:
     case RTM_NEWQDISC:
+    case RTM_NEWTCLASS:
     case RTM_NEWTFILTER:
         _F(NLM_F_REPLACE, "replace");
         _F(NLM_F_EXCL, "excl");
@@ -213,6 +171,7 @@ nl_nlmsghdr_to_str(const struct nlmsghdr *hdr, char *buf, gsize len)
     case RTM_GETADDR:
     case RTM_GETROUTE:
     case RTM_DELQDISC:
+    case RTM_DELTCLASS:
     case RTM_DELTFILTER:
         _F(NLM_F_DUMP, "dump");
         _F(NLM_F_ROOT, "root");
@@ -808,6 +767,12 @@ genlmsg_parse(struct nlmsghdr *        nlh,
                      policy);
 }
 
+typedef struct {
+    const char *grp_name;
+    gint32      family_id;
+    gint32      grp_id;
+} GenlGetFamilyData;
+
 static int
 _genl_parse_getfamily(struct nl_msg *msg, void *arg)
 {
@@ -820,28 +785,51 @@ _genl_parse_getfamily(struct nl_msg *msg, void *arg)
         [CTRL_ATTR_OPS]          = {.type = NLA_NESTED},
         [CTRL_ATTR_MCAST_GROUPS] = {.type = NLA_NESTED},
     };
-    struct nlattr *  tb[G_N_ELEMENTS(ctrl_policy)];
-    struct nlmsghdr *nlh           = nlmsg_hdr(msg);
-    gint32 *         response_data = arg;
+    static const struct nla_policy grp_policy[] = {
+        [CTRL_ATTR_MCAST_GRP_NAME] = {.type = NLA_STRING, .maxlen = GENL_NAMSIZ},
+        [CTRL_ATTR_MCAST_GRP_ID]   = {.type = NLA_U32},
+    };
+    struct nlattr *    tb[G_N_ELEMENTS(ctrl_policy)];
+    struct nlmsghdr *  nlh           = nlmsg_hdr(msg);
+    GenlGetFamilyData *response_data = arg;
 
     if (genlmsg_parse_arr(nlh, 0, tb, ctrl_policy) < 0)
         return NL_SKIP;
 
     if (tb[CTRL_ATTR_FAMILY_ID])
-        *response_data = nla_get_u16(tb[CTRL_ATTR_FAMILY_ID]);
+        response_data->family_id = nla_get_u16(tb[CTRL_ATTR_FAMILY_ID]);
+
+    if (response_data->grp_name && tb[CTRL_ATTR_MCAST_GROUPS]) {
+        struct nlattr *nla;
+        int            rem;
+
+        nla_for_each_nested (nla, tb[CTRL_ATTR_MCAST_GROUPS], rem) {
+            struct nlattr *tb_grp[G_N_ELEMENTS(grp_policy)];
+
+            if (nla_parse_nested_arr(tb_grp, nla, grp_policy) < 0)
+                continue;
+            if (!tb_grp[CTRL_ATTR_MCAST_GRP_NAME] || !tb_grp[CTRL_ATTR_MCAST_GRP_ID])
+                continue;
+            if (!nm_streq(nla_get_string(tb_grp[CTRL_ATTR_MCAST_GRP_NAME]),
+                          response_data->grp_name))
+                continue;
+
+            response_data->grp_id = nla_get_u32(tb_grp[CTRL_ATTR_MCAST_GRP_ID]);
+            break;
+        }
+    }
 
     return NL_STOP;
 }
 
-int
-genl_ctrl_resolve(struct nl_sock *sk, const char *name)
+static int
+_genl_ctrl_getfamily(struct nl_sock *sk, const char *name, GenlGetFamilyData *response_data)
 {
     nm_auto_nlmsg struct nl_msg *msg = NULL;
     int                          nmerr;
-    gint32                       response_data = -1;
-    const struct nl_cb           cb            = {
+    const struct nl_cb           cb = {
         .valid_cb  = _genl_parse_getfamily,
-        .valid_arg = &response_data,
+        .valid_arg = response_data,
     };
 
     msg = nlmsg_alloc();
@@ -862,14 +850,47 @@ genl_ctrl_resolve(struct nl_sock *sk, const char *name)
         return nmerr;
 
     /* If search was successful, request may be ACKed after data */
-    nmerr = nl_wait_for_ack(sk, NULL);
+    return nl_wait_for_ack(sk, NULL);
+}
+
+int
+genl_ctrl_resolve(struct nl_sock *sk, const char *name)
+{
+    GenlGetFamilyData response_data = {
+        .family_id = -1,
+    };
+    int               nmerr;
+
+    nmerr = _genl_ctrl_getfamily(sk, name, &response_data);
+    if (nmerr < 0)
+        return nmerr;
+
+    if (response_data.family_id < 0)
+        return -NME_UNSPEC;
+
+    return response_data.family_id;
+}
+
+int
+genl_ctrl_resolve_grp(struct nl_sock *sk, const char *family_name, const char *grp_name)
+{
+    GenlGetFamilyData response_data = {
+        .grp_name  = grp_name,
+        .family_id = -1,
+        .grp_id    = -1,
+    };
+    int               nmerr;
+
+    nm_assert(grp_name);
+
+    nmerr = _genl_ctrl_getfamily(sk, family_name, &response_data);
     if (nmerr < 0)
         return nmerr;
 
-    if (response_data < 0)
+    if (response_data.grp_id < 0)
         return -NME_UNSPEC;
 
-    return response_data;
+    return response_data.grp_id;
 }
 
 /*****************************************************************************/
@@ -1040,6 +1061,14 @@ nl_socket_set_ext_ack(struct nl_sock *sk, gboolean enable)
     return 0;
 }
 
+void
+nl_socket_disable_auto_ack(struct nl_sock *sk)
+{
+    /* Messages are no longer sent with NLM_F_ACK, and nl_recvmsgs() no longer
+     * checks the sequence numbers. The caller must do that itself. */
+    sk->s_flags |= NL_NO_AUTO_ACK;
+}
+
 void
 nl_socket_disable_msg_peek(struct nl_sock *sk)
 {
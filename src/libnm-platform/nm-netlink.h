@@ -57,6 +57,8 @@ const char *nl_nlmsgtype2str(int type, char *buf, size_t size);
 
 const char *nl_nlmsg_flags2str(int flags, char *buf, size_t len);
 
+const char *nl_nlmsg_type_to_str(guint16 type);
+
 const char *nl_nlmsghdr_to_str(const struct nlmsghdr *hdr, char *buf, gsize len);
 
 /*****************************************************************************/
@@ -519,6 +521,8 @@ int nl_socket_set_nonblocking(const struct nl_sock *sk);
 
 void nl_socket_disable_msg_peek(struct nl_sock *sk);
 
+void nl_socket_disable_auto_ack(struct nl_sock *sk);
+
 uint32_t nl_socket_get_local_port(const struct nl_sock *sk);
 
 int nl_socket_add_memberships(struct nl_sock *sk, int group, ...);
@@ -611,6 +615,8 @@ int genlmsg_parse(struct nlmsghdr *        nlh,
 
 int genl_ctrl_resolve(struct nl_sock *sk, const char *name);
 
+int genl_ctrl_resolve_grp(struct nl_sock *sk, const char *family_name, const char *grp_name);
+
 /*****************************************************************************/
 
 #endif /* __NM_NETLINK_H__ */
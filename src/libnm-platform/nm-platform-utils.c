@@ -10,6 +10,7 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <linux/ethtool.h>
+#include <linux/ethtool_netlink.h>
 #include <linux/sockios.h>
 #include <linux/mii.h>
 #include <linux/if.h>
@@ -21,6 +22,7 @@
 #include "libnm-base/nm-ethtool-base.h"
 #include "libnm-log-core/nm-logging.h"
 #include "libnm-glib-aux/nm-time-utils.h"
+#include "libnm-platform/nm-netlink.h"
 
 /*****************************************************************************/
 
@@ -353,6 +355,981 @@ _ethtool_call_once(int ifindex, gpointer edata, gsize edata_size)
 
 /*****************************************************************************/
 
+/* Kernels since 5.6 also expose ethtool via the "ethtool" generic netlink family.
+ * For settings that are supported there, we prefer it over SIOCETHTOOL. The
+ * requests go via a generic netlink socket of the platform instance (thus in the
+ * right netns), they don't require to resolve the ifname, and several of them can
+ * be sent at once.
+ *
+ * Kernel also sends ETHTOOL_MSG_*_NTF notifications to the "monitor" group whenever
+ * the features, ring, coalesce or pause settings of a device change. We listen to
+ * those, and cache these settings per ifindex. Reading them again is then free.
+ *
+ * Older kernels (or kernels without CONFIG_ETHTOOL_NETLINK) have no family or
+ * reject a message type with EOPNOTSUPP. In that case, the ioctl is used. */
+
+/* all messages have the request header as first attribute. */
+#define ETHTOOL_NL_A_HEADER 1
+
+G_STATIC_ASSERT(ETHTOOL_A_FEATURES_HEADER == ETHTOOL_NL_A_HEADER);
+G_STATIC_ASSERT(ETHTOOL_A_COALESCE_HEADER == ETHTOOL_NL_A_HEADER);
+G_STATIC_ASSERT(ETHTOOL_A_RINGS_HEADER == ETHTOOL_NL_A_HEADER);
+G_STATIC_ASSERT(ETHTOOL_A_PAUSE_HEADER == ETHTOOL_NL_A_HEADER);
+G_STATIC_ASSERT(ETHTOOL_A_LINKMODES_HEADER == ETHTOOL_NL_A_HEADER);
+G_STATIC_ASSERT(ETHTOOL_A_STRSET_HEADER == ETHTOOL_NL_A_HEADER);
+
+typedef enum {
+    ETHTOOL_NL_STATE_FEATURES,
+    ETHTOOL_NL_STATE_COALESCE,
+    ETHTOOL_NL_STATE_RING,
+    ETHTOOL_NL_STATE_PAUSE,
+    _ETHTOOL_NL_STATE_NUM,
+} EthtoolNlStateType;
+
+static const struct {
+    const char *log_subtype;
+    guint32     flags;
+    guint8      cmd_get;
+} _ethtool_nl_state_infos[_ETHTOOL_NL_STATE_NUM] = {
+    [ETHTOOL_NL_STATE_FEATURES] =
+        {
+            .log_subtype = "get-features",
+            .cmd_get     = ETHTOOL_MSG_FEATURES_GET,
+            .flags       = ETHTOOL_FLAG_COMPACT_BITSETS,
+        },
+    [ETHTOOL_NL_STATE_COALESCE] =
+        {
+            .log_subtype = "get-coalesce",
+            .cmd_get     = ETHTOOL_MSG_COALESCE_GET,
+        },
+    [ETHTOOL_NL_STATE_RING] =
+        {
+            .log_subtype = "get-ring",
+            .cmd_get     = ETHTOOL_MSG_RINGS_GET,
+        },
+    [ETHTOOL_NL_STATE_PAUSE] =
+        {
+            .log_subtype = "get-pause",
+            .cmd_get     = ETHTOOL_MSG_PAUSE_GET,
+        },
+};
+
+/* the state is not cached. */
+#define ETHTOOL_NL_R_UNKNOWN 1
+
+typedef struct {
+    int ifindex;
+
+    /* per EthtoolNlStateType, 0 if the cached state is valid, ETHTOOL_NL_R_UNKNOWN
+     * if it must be fetched, or -EOPNOTSUPP or -ENODEV if kernel failed it. */
+    int r[_ETHTOOL_NL_STATE_NUM];
+
+    NMEthtoolCoalesceState coalesce;
+    NMEthtoolRingState     ring;
+    NMEthtoolPauseState    pause;
+
+    /* the bitsets ETHTOOL_A_FEATURES_HW, _WANTED, _ACTIVE and _NOCHANGE, one after
+     * the other. Each has as many bits as there are feature names in @ss_features. */
+    guint32 *features;
+} EthtoolNlLinkState;
+
+struct _NMPUtilsEthtoolNl {
+    /* the socket for our requests. It is not shared with other users, and it checks
+     * the sequence numbers of the replies itself. */
+    struct nl_sock *sk;
+
+    /* subscribed to the "monitor" multicast group. Without it, nothing is cached. */
+    struct nl_sock *sk_monitor;
+
+    GHashTable *link_states;
+
+    /* the names of the features (ETH_SS_FEATURES). They are the same for all devices. */
+    struct ethtool_gstrings *ss_features;
+
+    guint64 n_round_trips;
+
+    int family_id;
+};
+
+static void
+_ethtool_nl_link_state_free(gpointer data)
+{
+    EthtoolNlLinkState *state = data;
+
+    g_free(state->features);
+    g_slice_free(EthtoolNlLinkState, state);
+}
+
+static EthtoolNlLinkState *
+_ethtool_nl_link_state_lookup(NMPUtilsEthtoolNl *enl, int ifindex, gboolean create)
+{
+    EthtoolNlLinkState *state;
+    guint               i;
+
+    state = g_hash_table_lookup(enl->link_states, &ifindex);
+    if (state || !create)
+        return state;
+
+    state  = g_slice_new(EthtoolNlLinkState);
+    *state = (EthtoolNlLinkState){
+        .ifindex = ifindex,
+    };
+    for (i = 0; i < _ETHTOOL_NL_STATE_NUM; i++)
+        state->r[i] = ETHTOOL_NL_R_UNKNOWN;
+    g_hash_table_add(enl->link_states, state);
+    return state;
+}
+
+static void
+_ethtool_nl_link_state_invalidate(NMPUtilsEthtoolNl *enl, int ifindex, EthtoolNlStateType type)
+{
+    EthtoolNlLinkState *state;
+
+    state = _ethtool_nl_link_state_lookup(enl, ifindex, FALSE);
+    if (state)
+        state->r[type] = ETHTOOL_NL_R_UNKNOWN;
+}
+
+/*****************************************************************************/
+
+static struct nl_msg *
+_ethtool_nl_msg_new(NMPUtilsEthtoolNl *enl, int ifindex, guint8 cmd, guint32 flags)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    struct nlattr *              header;
+
+    msg = nlmsg_alloc();
+
+    if (!genlmsg_put(msg,
+                     NL_AUTO_PORT,
+                     NL_AUTO_SEQ,
+                     enl->family_id,
+                     0,
+                     NLM_F_ACK,
+                     cmd,
+                     ETHTOOL_GENL_VERSION))
+        goto nla_put_failure;
+
+    if (!(header = nla_nest_start(msg, ETHTOOL_NL_A_HEADER)))
+        goto nla_put_failure;
+    if (ifindex > 0)
+        NLA_PUT_U32(msg, ETHTOOL_A_HEADER_DEV_INDEX, (guint32) ifindex);
+    if (flags != 0)
+        NLA_PUT_U32(msg, ETHTOOL_A_HEADER_FLAGS, flags);
+    nla_nest_end(msg, header);
+
+    return g_steal_pointer(&msg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
+typedef struct {
+    struct nl_msg *     msg;
+    const char *        log_subtype;
+    nl_recvmsg_msg_cb_t valid_cb;
+    gpointer            valid_arg;
+    guint32             seq;
+    int                 r;
+    bool                done : 1;
+} EthtoolNlRequest;
+
+typedef struct {
+    EthtoolNlRequest *reqs;
+    guint             n_reqs;
+    guint             n_done;
+} EthtoolNlBatch;
+
+static EthtoolNlRequest *
+_ethtool_nl_batch_find(EthtoolNlBatch *batch, guint32 seq)
+{
+    guint i;
+
+    for (i = 0; i < batch->n_reqs; i++) {
+        EthtoolNlRequest *req = &batch->reqs[i];
+
+        if (!req->done && req->seq == seq)
+            return req;
+    }
+
+    /* a late reply for a request that we already gave up on. Drop it. */
+    return NULL;
+}
+
+static void
+_ethtool_nl_batch_complete(EthtoolNlBatch *batch, EthtoolNlRequest *req, int r)
+{
+    nm_assert(!req->done);
+
+    req->r    = r;
+    req->done = TRUE;
+    batch->n_done++;
+}
+
+static int
+_ethtool_nl_batch_valid_handler(struct nl_msg *msg, void *arg)
+{
+    EthtoolNlRequest *req;
+
+    req = _ethtool_nl_batch_find(arg, nlmsg_hdr(msg)->nlmsg_seq);
+    if (req && req->valid_cb)
+        req->valid_cb(msg, req->valid_arg);
+    return NL_OK;
+}
+
+static int
+_ethtool_nl_batch_ack_handler(struct nl_msg *msg, void *arg)
+{
+    EthtoolNlBatch *  batch = arg;
+    EthtoolNlRequest *req;
+
+    req = _ethtool_nl_batch_find(batch, nlmsg_hdr(msg)->nlmsg_seq);
+    if (req)
+        _ethtool_nl_batch_complete(batch, req, 0);
+    return NL_OK;
+}
+
+static int
+_ethtool_nl_batch_error_handler(struct sockaddr_nl *nla, struct nlmsgerr *err, void *arg)
+{
+    EthtoolNlBatch *  batch = arg;
+    EthtoolNlRequest *req;
+
+    req = _ethtool_nl_batch_find(batch, err->msg.nlmsg_seq);
+    if (req)
+        _ethtool_nl_batch_complete(batch, req, err->error < 0 ? err->error : -EINVAL);
+    return NL_SKIP;
+}
+
+/* Sends all requests at once, and then waits for all replies. Kernel handles the
+ * requests in order, so the batch costs a single round trip. */
+static void
+_ethtool_nl_batch_run(NMPUtilsEthtoolNl *enl, int ifindex, EthtoolNlRequest *reqs, guint n_reqs)
+{
+    EthtoolNlBatch batch = {
+        .reqs   = reqs,
+        .n_reqs = n_reqs,
+    };
+    const struct nl_cb cb = {
+        .valid_cb  = _ethtool_nl_batch_valid_handler,
+        .valid_arg = &batch,
+        .ack_cb    = _ethtool_nl_batch_ack_handler,
+        .ack_arg   = &batch,
+        .err_cb    = _ethtool_nl_batch_error_handler,
+        .err_arg   = &batch,
+    };
+    guint i;
+    int   r;
+
+    for (i = 0; i < n_reqs; i++) {
+        EthtoolNlRequest *req = &reqs[i];
+
+        r = req->msg ? nl_send_auto(enl->sk, req->msg) : -ENOMEM;
+        if (r < 0) {
+            _ethtool_nl_batch_complete(&batch, req, r);
+            continue;
+        }
+        req->seq = nlmsg_hdr(req->msg)->nlmsg_seq;
+    }
+
+    if (batch.n_done < n_reqs)
+        enl->n_round_trips++;
+
+    while (batch.n_done < n_reqs) {
+        r = nl_recvmsgs(enl->sk, &cb);
+        if (r < 0 && r != -EAGAIN) {
+            /* give up. If the missing replies arrive later, they are dropped
+             * because nobody waits for their sequence number. */
+            for (i = 0; i < n_reqs; i++) {
+                if (!reqs[i].done)
+                    _ethtool_nl_batch_complete(&batch, &reqs[i], r);
+            }
+        }
+    }
+
+    for (i = 0; i < n_reqs; i++) {
+        if (reqs[i].r < 0) {
+            nm_log_trace(LOGD_PLATFORM,
+                         "ethtool[%d]: %s: netlink request failed: %s%s",
+                         ifindex,
+                         reqs[i].log_subtype,
+                         nm_strerror(reqs[i].r),
+                         reqs[i].r == -EOPNOTSUPP ? " (fallback to ioctl)" : "");
+        } else {
+            nm_log_trace(LOGD_PLATFORM,
+                         "ethtool[%d]: %s: netlink request succeeded",
+                         ifindex,
+                         reqs[i].log_subtype);
+        }
+    }
+}
+
+static int
+_ethtool_nl_request(NMPUtilsEthtoolNl * enl,
+                    int                 ifindex,
+                    const char *        log_subtype,
+                    struct nl_msg *     msg,
+                    nl_recvmsg_msg_cb_t valid_cb,
+                    gpointer            valid_arg)
+{
+    EthtoolNlRequest req = {
+        .msg         = msg,
+        .log_subtype = log_subtype,
+        .valid_cb    = valid_cb,
+        .valid_arg   = valid_arg,
+    };
+
+    _ethtool_nl_batch_run(enl, ifindex, &req, 1);
+    return req.r;
+}
+
+/*****************************************************************************/
+
+static int
+_ethtool_nl_header_get_ifindex(struct nlattr *header)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_HEADER_DEV_INDEX] = {.type = NLA_U32},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+
+    if (!header || nla_parse_nested_arr(tb, header, policy) < 0
+        || !tb[ETHTOOL_A_HEADER_DEV_INDEX])
+        return 0;
+
+    return (int) nla_get_u32(tb[ETHTOOL_A_HEADER_DEV_INDEX]);
+}
+
+static gboolean
+_ethtool_nl_parse_bitset(struct nlattr *nla, guint n_bits, guint32 *bitmap)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_BITSET_NOMASK] = {.type = NLA_FLAG},
+        [ETHTOOL_A_BITSET_SIZE]   = {.type = NLA_U32},
+        [ETHTOOL_A_BITSET_BITS]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_BITSET_VALUE]  = {.type = NLA_BINARY},
+        [ETHTOOL_A_BITSET_MASK]   = {.type = NLA_BINARY},
+    };
+    static const struct nla_policy bit_policy[] = {
+        [ETHTOOL_A_BITSET_BIT_INDEX] = {.type = NLA_U32},
+        [ETHTOOL_A_BITSET_BIT_NAME]  = {.type = NLA_STRING},
+        [ETHTOOL_A_BITSET_BIT_VALUE] = {.type = NLA_FLAG},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+    struct nlattr *nla_bit;
+    int            rem;
+
+    memset(bitmap, 0, NM_DIV_ROUND_UP(n_bits, 32u) * sizeof(guint32));
+
+    if (!nla || nla_parse_nested_arr(tb, nla, policy) < 0 || !tb[ETHTOOL_A_BITSET_SIZE]
+        || nla_get_u32(tb[ETHTOOL_A_BITSET_SIZE]) != n_bits)
+        return FALSE;
+
+    if (tb[ETHTOOL_A_BITSET_VALUE]) {
+        /* the compact form, that we request. */
+        nla_memcpy(bitmap, tb[ETHTOOL_A_BITSET_VALUE], NM_DIV_ROUND_UP(n_bits, 32u) * 4u);
+        return TRUE;
+    }
+
+    if (!tb[ETHTOOL_A_BITSET_BITS])
+        return TRUE;
+
+    nla_for_each_nested (nla_bit, tb[ETHTOOL_A_BITSET_BITS], rem) {
+        struct nlattr *tb_bit[G_N_ELEMENTS(bit_policy)];
+        guint32        idx;
+
+        if (nla_type(nla_bit) != ETHTOOL_A_BITSET_BITS_BIT)
+            continue;
+        if (nla_parse_nested_arr(tb_bit, nla_bit, bit_policy) < 0
+            || !tb_bit[ETHTOOL_A_BITSET_BIT_INDEX])
+            return FALSE;
+
+        idx = nla_get_u32(tb_bit[ETHTOOL_A_BITSET_BIT_INDEX]);
+        if (idx >= n_bits)
+            return FALSE;
+
+        if (tb[ETHTOOL_A_BITSET_NOMASK] || tb_bit[ETHTOOL_A_BITSET_BIT_VALUE])
+            bitmap[idx / 32u] |= (1u << (idx % 32u));
+    }
+
+    return TRUE;
+}
+
+static int
+_ethtool_nl_parse_features(NMPUtilsEthtoolNl * enl,
+                           struct nlmsghdr *   nlh,
+                           EthtoolNlLinkState *state)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_FEATURES_HEADER]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_FEATURES_HW]       = {.type = NLA_NESTED},
+        [ETHTOOL_A_FEATURES_WANTED]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_FEATURES_ACTIVE]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_FEATURES_NOCHANGE] = {.type = NLA_NESTED},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+    guint          n_words;
+    int            attr;
+
+    /* without the names, the bits are meaningless. */
+    if (!enl->ss_features)
+        return ETHTOOL_NL_R_UNKNOWN;
+
+    if (genlmsg_parse_arr(nlh, 0, tb, policy) < 0)
+        return -EINVAL;
+
+    n_words = NM_DIV_ROUND_UP(enl->ss_features->len, 32u);
+    if (!state->features)
+        state->features = g_new(guint32, 4u * n_words);
+
+    for (attr = ETHTOOL_A_FEATURES_HW; attr <= ETHTOOL_A_FEATURES_NOCHANGE; attr++) {
+        if (!_ethtool_nl_parse_bitset(
+                tb[attr],
+                enl->ss_features->len,
+                &state->features[(attr - ETHTOOL_A_FEATURES_HW) * n_words])) {
+            /* the bitsets don't match the names that we have. Use the ioctl. */
+            return -EOPNOTSUPP;
+        }
+    }
+
+    return 0;
+}
+
+#define _COALESCE_ATTR(nm_id, attr) [_NM_ETHTOOL_ID_COALESCE_AS_IDX(nm_id)] = (attr)
+
+static const guint8 _ethtool_nl_coalesce_attrs[_NM_ETHTOOL_ID_COALESCE_NUM] = {
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_ADAPTIVE_RX, ETHTOOL_A_COALESCE_USE_ADAPTIVE_RX),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_ADAPTIVE_TX, ETHTOOL_A_COALESCE_USE_ADAPTIVE_TX),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_PKT_RATE_HIGH, ETHTOOL_A_COALESCE_PKT_RATE_HIGH),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_PKT_RATE_LOW, ETHTOOL_A_COALESCE_PKT_RATE_LOW),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_FRAMES, ETHTOOL_A_COALESCE_RX_MAX_FRAMES),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_FRAMES_HIGH, ETHTOOL_A_COALESCE_RX_MAX_FRAMES_HIGH),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_FRAMES_IRQ, ETHTOOL_A_COALESCE_RX_MAX_FRAMES_IRQ),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_FRAMES_LOW, ETHTOOL_A_COALESCE_RX_MAX_FRAMES_LOW),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_USECS, ETHTOOL_A_COALESCE_RX_USECS),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_USECS_HIGH, ETHTOOL_A_COALESCE_RX_USECS_HIGH),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_USECS_IRQ, ETHTOOL_A_COALESCE_RX_USECS_IRQ),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_RX_USECS_LOW, ETHTOOL_A_COALESCE_RX_USECS_LOW),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_SAMPLE_INTERVAL, ETHTOOL_A_COALESCE_RATE_SAMPLE_INTERVAL),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_STATS_BLOCK_USECS, ETHTOOL_A_COALESCE_STATS_BLOCK_USECS),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_FRAMES, ETHTOOL_A_COALESCE_TX_MAX_FRAMES),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_FRAMES_HIGH, ETHTOOL_A_COALESCE_TX_MAX_FRAMES_HIGH),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_FRAMES_IRQ, ETHTOOL_A_COALESCE_TX_MAX_FRAMES_IRQ),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_FRAMES_LOW, ETHTOOL_A_COALESCE_TX_MAX_FRAMES_LOW),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_USECS, ETHTOOL_A_COALESCE_TX_USECS),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_USECS_HIGH, ETHTOOL_A_COALESCE_TX_USECS_HIGH),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_USECS_IRQ, ETHTOOL_A_COALESCE_TX_USECS_IRQ),
+    _COALESCE_ATTR(NM_ETHTOOL_ID_COALESCE_TX_USECS_LOW, ETHTOOL_A_COALESCE_TX_USECS_LOW),
+};
+
+#undef _COALESCE_ATTR
+
+static gboolean
+_ethtool_nl_coalesce_attr_is_u8(int attr)
+{
+    return NM_IN_SET(attr,
+                     ETHTOOL_A_COALESCE_USE_ADAPTIVE_RX,
+                     ETHTOOL_A_COALESCE_USE_ADAPTIVE_TX);
+}
+
+static int
+_ethtool_nl_parse_coalesce(struct nlmsghdr *nlh, NMEthtoolCoalesceState *coalesce)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_COALESCE_HEADER]               = {.type = NLA_NESTED},
+        [ETHTOOL_A_COALESCE_RX_USECS]             = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_MAX_FRAMES]        = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_USECS_IRQ]         = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_MAX_FRAMES_IRQ]    = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_USECS]             = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_MAX_FRAMES]        = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_USECS_IRQ]         = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_MAX_FRAMES_IRQ]    = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_STATS_BLOCK_USECS]    = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_USE_ADAPTIVE_RX]      = {.type = NLA_U8},
+        [ETHTOOL_A_COALESCE_USE_ADAPTIVE_TX]      = {.type = NLA_U8},
+        [ETHTOOL_A_COALESCE_PKT_RATE_LOW]         = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_USECS_LOW]         = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_MAX_FRAMES_LOW]    = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_USECS_LOW]         = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_MAX_FRAMES_LOW]    = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_PKT_RATE_HIGH]        = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_USECS_HIGH]        = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RX_MAX_FRAMES_HIGH]   = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_USECS_HIGH]        = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_TX_MAX_FRAMES_HIGH]   = {.type = NLA_U32},
+        [ETHTOOL_A_COALESCE_RATE_SAMPLE_INTERVAL] = {.type = NLA_U32},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+    guint          i;
+
+    if (genlmsg_parse_arr(nlh, 0, tb, policy) < 0)
+        return -EINVAL;
+
+    for (i = 0; i < _NM_ETHTOOL_ID_COALESCE_NUM; i++) {
+        const int      attr = _ethtool_nl_coalesce_attrs[i];
+        struct nlattr *nla  = tb[attr];
+
+        if (!nla)
+            coalesce->s[i] = 0;
+        else if (_ethtool_nl_coalesce_attr_is_u8(attr))
+            coalesce->s[i] = nla_get_u8(nla);
+        else
+            coalesce->s[i] = nla_get_u32(nla);
+    }
+
+    return 0;
+}
+
+static int
+_ethtool_nl_parse_ring(struct nlmsghdr *nlh, NMEthtoolRingState *ring)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_RINGS_HEADER]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_RINGS_RX]       = {.type = NLA_U32},
+        [ETHTOOL_A_RINGS_RX_MINI]  = {.type = NLA_U32},
+        [ETHTOOL_A_RINGS_RX_JUMBO] = {.type = NLA_U32},
+        [ETHTOOL_A_RINGS_TX]       = {.type = NLA_U32},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+
+    if (genlmsg_parse_arr(nlh, 0, tb, policy) < 0)
+        return -EINVAL;
+
+    *ring = (NMEthtoolRingState){};
+    if (tb[ETHTOOL_A_RINGS_RX])
+        ring->rx_pending = nla_get_u32(tb[ETHTOOL_A_RINGS_RX]);
+    if (tb[ETHTOOL_A_RINGS_RX_JUMBO])
+        ring->rx_jumbo_pending = nla_get_u32(tb[ETHTOOL_A_RINGS_RX_JUMBO]);
+    if (tb[ETHTOOL_A_RINGS_RX_MINI])
+        ring->rx_mini_pending = nla_get_u32(tb[ETHTOOL_A_RINGS_RX_MINI]);
+    if (tb[ETHTOOL_A_RINGS_TX])
+        ring->tx_pending = nla_get_u32(tb[ETHTOOL_A_RINGS_TX]);
+    return 0;
+}
+
+static int
+_ethtool_nl_parse_pause(struct nlmsghdr *nlh, NMEthtoolPauseState *pause)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_PAUSE_HEADER]  = {.type = NLA_NESTED},
+        [ETHTOOL_A_PAUSE_AUTONEG] = {.type = NLA_U8},
+        [ETHTOOL_A_PAUSE_RX]      = {.type = NLA_U8},
+        [ETHTOOL_A_PAUSE_TX]      = {.type = NLA_U8},
+    };
+    struct nlattr *tb[G_N_ELEMENTS(policy)];
+
+    if (genlmsg_parse_arr(nlh, 0, tb, policy) < 0)
+        return -EINVAL;
+
+    *pause = (NMEthtoolPauseState){
+        .autoneg = nla_get_u8_cond(tb, ETHTOOL_A_PAUSE_AUTONEG, 0) == 1,
+        .rx      = nla_get_u8_cond(tb, ETHTOOL_A_PAUSE_RX, 0) == 1,
+        .tx      = nla_get_u8_cond(tb, ETHTOOL_A_PAUSE_TX, 0) == 1,
+    };
+    return 0;
+}
+
+/* Handles both the reply to our GET requests and the notifications. Both have
+ * the same content, and both update the cached state. */
+static int
+_ethtool_nl_parse_state_handler(struct nl_msg *msg, void *arg)
+{
+    NMPUtilsEthtoolNl * enl = arg;
+    struct nlmsghdr *   nlh = nlmsg_hdr(msg);
+    EthtoolNlLinkState *state;
+    EthtoolNlStateType  type;
+    int                 r;
+
+    if (!genlmsg_valid_hdr(nlh, 0))
+        return NL_SKIP;
+
+    switch (genlmsg_hdr(nlh)->cmd) {
+    case ETHTOOL_MSG_FEATURES_GET_REPLY:
+    case ETHTOOL_MSG_FEATURES_NTF:
+        type = ETHTOOL_NL_STATE_FEATURES;
+        break;
+    case ETHTOOL_MSG_COALESCE_GET_REPLY:
+    case ETHTOOL_MSG_COALESCE_NTF:
+        type = ETHTOOL_NL_STATE_COALESCE;
+        break;
+    case ETHTOOL_MSG_RINGS_GET_REPLY:
+    case ETHTOOL_MSG_RINGS_NTF:
+        type = ETHTOOL_NL_STATE_RING;
+        break;
+    case ETHTOOL_MSG_PAUSE_GET_REPLY:
+    case ETHTOOL_MSG_PAUSE_NTF:
+        type = ETHTOOL_NL_STATE_PAUSE;
+        break;
+    default:
+        return NL_SKIP;
+    }
+
+    /* we only track links that somebody asked about. */
+    state = _ethtool_nl_link_state_lookup(
+        enl,
+        _ethtool_nl_header_get_ifindex(nlmsg_find_attr(nlh, GENL_HDRLEN, ETHTOOL_NL_A_HEADER)),
+        FALSE);
+    if (!state)
+        return NL_SKIP;
+
+    switch (type) {
+    case ETHTOOL_NL_STATE_FEATURES:
+        r = _ethtool_nl_parse_features(enl, nlh, state);
+        break;
+    case ETHTOOL_NL_STATE_COALESCE:
+        r = _ethtool_nl_parse_coalesce(nlh, &state->coalesce);
+        break;
+    case ETHTOOL_NL_STATE_RING:
+        r = _ethtool_nl_parse_ring(nlh, &state->ring);
+        break;
+    case ETHTOOL_NL_STATE_PAUSE:
+        r = _ethtool_nl_parse_pause(nlh, &state->pause);
+        break;
+    default:
+        nm_assert_not_reached();
+        return NL_SKIP;
+    }
+
+    state->r[type] = r;
+    return NL_OK;
+}
+
+static int
+_ethtool_nl_strset_handler(struct nl_msg *msg, void *arg)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_STRSET_HEADER]     = {.type = NLA_NESTED},
+        [ETHTOOL_A_STRSET_STRINGSETS] = {.type = NLA_NESTED},
+    };
+    static const struct nla_policy set_policy[] = {
+        [ETHTOOL_A_STRINGSET_ID]      = {.type = NLA_U32},
+        [ETHTOOL_A_STRINGSET_COUNT]   = {.type = NLA_U32},
+        [ETHTOOL_A_STRINGSET_STRINGS] = {.type = NLA_NESTED},
+    };
+    static const struct nla_policy string_policy[] = {
+        [ETHTOOL_A_STRING_INDEX] = {.type = NLA_U32},
+        [ETHTOOL_A_STRING_VALUE] = {.type = NLA_STRING},
+    };
+    NMPUtilsEthtoolNl *enl = arg;
+    struct nlattr *    tb[G_N_ELEMENTS(policy)];
+    struct nlattr *    nla_set;
+    int                rem;
+
+    if (genlmsg_parse_arr(nlmsg_hdr(msg), 0, tb, policy) < 0 || !tb[ETHTOOL_A_STRSET_STRINGSETS])
+        return NL_SKIP;
+
+    nla_for_each_nested (nla_set, tb[ETHTOOL_A_STRSET_STRINGSETS], rem) {
+        gs_free struct ethtool_gstrings *gstrings = NULL;
+        struct nlattr *                  tb_set[G_N_ELEMENTS(set_policy)];
+        struct nlattr *                  nla_string;
+        guint32                          len;
+        int                              rem_string;
+
+        if (nla_parse_nested_arr(tb_set, nla_set, set_policy) < 0
+            || !tb_set[ETHTOOL_A_STRINGSET_ID] || !tb_set[ETHTOOL_A_STRINGSET_COUNT]
+            || nla_get_u32(tb_set[ETHTOOL_A_STRINGSET_ID]) != ETH_SS_FEATURES)
+            continue;
+
+        len                  = nla_get_u32(tb_set[ETHTOOL_A_STRINGSET_COUNT]);
+        gstrings             = g_malloc0(sizeof(*gstrings) + (len * ETH_GSTRING_LEN));
+        gstrings->cmd        = ETHTOOL_GSTRINGS;
+        gstrings->string_set = ETH_SS_FEATURES;
+        gstrings->len        = len;
+
+        if (tb_set[ETHTOOL_A_STRINGSET_STRINGS]) {
+            nla_for_each_nested (nla_string, tb_set[ETHTOOL_A_STRINGSET_STRINGS], rem_string) {
+                struct nlattr *tb_string[G_N_ELEMENTS(string_policy)];
+                guint32        idx;
+
+                if (nla_parse_nested_arr(tb_string, nla_string, string_policy) < 0
+                    || !tb_string[ETHTOOL_A_STRING_INDEX] || !tb_string[ETHTOOL_A_STRING_VALUE])
+                    continue;
+
+                idx = nla_get_u32(tb_string[ETHTOOL_A_STRING_INDEX]);
+                if (idx >= len)
+                    continue;
+
+                g_strlcpy((char *) &gstrings->data[idx * ETH_GSTRING_LEN],
+                          nla_get_string(tb_string[ETHTOOL_A_STRING_VALUE]),
+                          ETH_GSTRING_LEN);
+            }
+        }
+
+        g_free(enl->ss_features);
+        enl->ss_features = g_steal_pointer(&gstrings);
+    }
+
+    return NL_OK;
+}
+
+static struct nl_msg *
+_ethtool_nl_msg_new_strset(NMPUtilsEthtoolNl *enl)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    struct nlattr *              nest_sets;
+    struct nlattr *              nest_set;
+
+    /* the feature names are not specific to a device. Don't pass an ifindex. */
+    msg = _ethtool_nl_msg_new(enl, 0, ETHTOOL_MSG_STRSET_GET, 0);
+    if (!msg)
+        return NULL;
+
+    if (!(nest_sets = nla_nest_start(msg, ETHTOOL_A_STRSET_STRINGSETS)))
+        goto nla_put_failure;
+    if (!(nest_set = nla_nest_start(msg, ETHTOOL_A_STRINGSETS_STRINGSET)))
+        goto nla_put_failure;
+    NLA_PUT_U32(msg, ETHTOOL_A_STRINGSET_ID, ETH_SS_FEATURES);
+    nla_nest_end(msg, nest_set);
+    nla_nest_end(msg, nest_sets);
+
+    return g_steal_pointer(&msg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
+/*****************************************************************************/
+
+static void
+_ethtool_nl_process_monitor(NMPUtilsEthtoolNl *enl)
+{
+    const struct nl_cb cb = {
+        .valid_cb  = _ethtool_nl_parse_state_handler,
+        .valid_arg = enl,
+    };
+    int r;
+
+    if (!enl->sk_monitor)
+        return;
+
+    while (TRUE) {
+        r = nl_recvmsgs(enl->sk_monitor, &cb);
+        if (r > 0)
+            continue;
+        if (r == -ENOBUFS) {
+            /* we lost notifications. We cannot trust the cache anymore. */
+            nm_log_dbg(LOGD_PLATFORM, "ethtool: lost notifications, drop cached settings");
+            g_hash_table_remove_all(enl->link_states);
+            continue;
+        }
+        if (r < 0 && r != -EAGAIN)
+            nm_log_dbg(LOGD_PLATFORM, "ethtool: reading notifications failed: %s", nm_strerror(r));
+        return;
+    }
+}
+
+/* Returns the cached state of @ifindex, after fetching what is not cached yet. All
+ * missing settings are requested in one batch. The return value is zero, if the
+ * setting of @type is valid, or a negative errno. Only -EOPNOTSUPP and -ENODEV
+ * are cached, other errors are returned once. */
+static int
+_ethtool_nl_link_state_get(NMPUtilsEthtoolNl *  enl,
+                           int                  ifindex,
+                           EthtoolNlStateType   type,
+                           EthtoolNlLinkState **out_state)
+{
+    EthtoolNlLinkState *state;
+    EthtoolNlRequest    reqs[1 + _ETHTOOL_NL_STATE_NUM];
+    int                 req_types[1 + _ETHTOOL_NL_STATE_NUM];
+    guint               n_reqs = 0;
+    int                 r_type = 0;
+    guint               i;
+
+    /* first catch up with the notifications that kernel already sent. */
+    _ethtool_nl_process_monitor(enl);
+
+    state = _ethtool_nl_link_state_lookup(enl, ifindex, TRUE);
+
+    if (!enl->sk_monitor) {
+        /* without notifications, we don't notice when the cached state gets stale. */
+        for (i = 0; i < _ETHTOOL_NL_STATE_NUM; i++)
+            state->r[i] = ETHTOOL_NL_R_UNKNOWN;
+    }
+
+    if (!enl->ss_features && state->r[ETHTOOL_NL_STATE_FEATURES] == ETHTOOL_NL_R_UNKNOWN) {
+        req_types[n_reqs] = -1;
+        reqs[n_reqs++]    = (EthtoolNlRequest){
+            .msg         = _ethtool_nl_msg_new_strset(enl),
+            .log_subtype = "get-feature-names",
+            .valid_cb    = _ethtool_nl_strset_handler,
+            .valid_arg   = enl,
+        };
+    }
+
+    for (i = 0; i < _ETHTOOL_NL_STATE_NUM; i++) {
+        if (state->r[i] != ETHTOOL_NL_R_UNKNOWN)
+            continue;
+        req_types[n_reqs] = i;
+        reqs[n_reqs++]    = (EthtoolNlRequest){
+            .msg         = _ethtool_nl_msg_new(enl,
+                                       ifindex,
+                                       _ethtool_nl_state_infos[i].cmd_get,
+                                       _ethtool_nl_state_infos[i].flags),
+            .log_subtype = _ethtool_nl_state_infos[i].log_subtype,
+            .valid_cb    = _ethtool_nl_parse_state_handler,
+            .valid_arg   = enl,
+        };
+    }
+
+    if (n_reqs > 0) {
+        _ethtool_nl_batch_run(enl, ifindex, reqs, n_reqs);
+
+        for (i = 0; i < n_reqs; i++) {
+            int r;
+
+            nlmsg_free(reqs[i].msg);
+
+            if (req_types[i] < 0)
+                continue;
+            if (reqs[i].r < 0)
+                r = reqs[i].r;
+            else if (state->r[req_types[i]] == ETHTOOL_NL_R_UNKNOWN) {
+                /* kernel acknowledged the request without a usable reply. Use the ioctl. */
+                r = -EOPNOTSUPP;
+            } else
+                continue;
+
+            if (req_types[i] == type)
+                r_type = r;
+
+            /* only remember definitive failures. Others, like -EBUSY or -ENOBUFS, are
+             * retried with the next request. */
+            if (NM_IN_SET(r, -EOPNOTSUPP, -ENODEV))
+                state->r[req_types[i]] = r;
+        }
+    }
+
+    NM_SET_OUT(out_state, state);
+
+    if (state->r[type] == ETHTOOL_NL_R_UNKNOWN) {
+        nm_assert(r_type < 0);
+        return r_type;
+    }
+    return state->r[type];
+}
+
+/*****************************************************************************/
+
+static struct nl_sock *
+_ethtool_nl_monitor_new(int grp_id)
+{
+    struct nl_sock *sk;
+
+    sk = nl_socket_alloc();
+
+    if (nl_connect(sk, NETLINK_GENERIC) < 0 || nl_socket_set_nonblocking(sk) < 0
+        || nl_socket_add_memberships(sk, grp_id, 0) < 0) {
+        nl_socket_free(sk);
+        return NULL;
+    }
+
+    /* notifications have no sequence number. */
+    nl_socket_disable_auto_ack(sk);
+    return sk;
+}
+
+NMPUtilsEthtoolNl *
+nmp_utils_ethtool_nl_new(void)
+{
+    NMPUtilsEthtoolNl *enl;
+    struct nl_sock *   sk;
+    int                family_id;
+    int                grp_id;
+
+    sk = nl_socket_alloc();
+
+    if (nl_connect(sk, NETLINK_GENERIC) < 0) {
+        nl_socket_free(sk);
+        return NULL;
+    }
+
+    family_id = genl_ctrl_resolve(sk, ETHTOOL_GENL_NAME);
+    if (family_id < 0) {
+        nm_log_dbg(LOGD_PLATFORM, "ethtool: generic netlink family not available, use ioctl");
+        nl_socket_free(sk);
+        return NULL;
+    }
+
+    grp_id = genl_ctrl_resolve_grp(sk, ETHTOOL_GENL_NAME, ETHTOOL_MCGRP_MONITOR_NAME);
+
+    /* from now on, _ethtool_nl_batch_run() matches the replies to the requests
+     * itself. A reply that arrives after we gave up on a request is dropped. */
+    nl_socket_disable_auto_ack(sk);
+
+    enl  = g_slice_new(NMPUtilsEthtoolNl);
+    *enl = (NMPUtilsEthtoolNl){
+        .sk          = sk,
+        .sk_monitor  = grp_id >= 0 ? _ethtool_nl_monitor_new(grp_id) : NULL,
+        .link_states = g_hash_table_new_full(nm_pint_hash,
+                                             nm_pint_equal,
+                                             _ethtool_nl_link_state_free,
+                                             NULL),
+        .family_id   = family_id,
+    };
+
+    if (!enl->sk_monitor)
+        nm_log_dbg(LOGD_PLATFORM, "ethtool: cannot subscribe to notifications, don't cache");
+
+    return enl;
+}
+
+void
+nmp_utils_ethtool_nl_free(NMPUtilsEthtoolNl *enl)
+{
+    if (!enl)
+        return;
+
+    nl_socket_free(enl->sk);
+    nl_socket_free(enl->sk_monitor);
+    g_hash_table_unref(enl->link_states);
+    g_free(enl->ss_features);
+    g_slice_free(NMPUtilsEthtoolNl, enl);
+}
+
+int
+nmp_utils_ethtool_nl_get_monitor_fd(NMPUtilsEthtoolNl *enl)
+{
+    g_return_val_if_fail(enl, -1);
+
+    return enl->sk_monitor ? nl_socket_get_fd(enl->sk_monitor) : -1;
+}
+
+void
+nmp_utils_ethtool_nl_process_monitor(NMPUtilsEthtoolNl *enl)
+{
+    g_return_if_fail(enl);
+
+    _ethtool_nl_process_monitor(enl);
+}
+
+void
+nmp_utils_ethtool_nl_forget_link(NMPUtilsEthtoolNl *enl, int ifindex)
+{
+    g_return_if_fail(enl);
+
+    g_hash_table_remove(enl->link_states, &ifindex);
+}
+
+guint64
+nmp_utils_ethtool_nl_get_n_round_trips(NMPUtilsEthtoolNl *enl)
+{
+    g_return_val_if_fail(enl, 0);
+
+    return enl->n_round_trips;
+}
+
+/*****************************************************************************/
+
+/* The netdev feature names (ETH_SS_FEATURES) are defined by the kernel and the
+ * same for all devices. Fetching them via ETHTOOL_GSTRINGS copies them out of the
+ * kernel on every request, so cache them. An entry is only used, if the number of
+ * strings still matches.
+ *
+ * The other string sets are provided by the driver and not cached. */
+static GMutex                   _ethtool_stringset_cache_lock;
+static struct ethtool_gstrings *_ethtool_stringset_cache_features;
+
 static struct ethtool_gstrings *
 ethtool_get_stringset(SocketHandle *shandle, int stringset_id)
 {
@@ -378,7 +1355,15 @@ ethtool_get_stringset(SocketHandle *shandle, int stringset_id)
 
     len = *pdata;
 
-    gstrings_len         = sizeof(*gstrings) + (len * ETH_GSTRING_LEN);
+    gstrings_len = sizeof(*gstrings) + (len * ETH_GSTRING_LEN);
+
+    if (stringset_id == ETH_SS_FEATURES) {
+        NM_G_MUTEX_LOCKED(&_ethtool_stringset_cache_lock);
+
+        if (_ethtool_stringset_cache_features && _ethtool_stringset_cache_features->len == len)
+            return nm_memdup(_ethtool_stringset_cache_features, gstrings_len);
+    }
+
     gstrings             = g_malloc0(gstrings_len);
     gstrings->cmd        = ETHTOOL_GSTRINGS;
     gstrings->string_set = stringset_id;
@@ -392,6 +1377,13 @@ ethtool_get_stringset(SocketHandle *shandle, int stringset_id)
         }
     }
 
+    if (stringset_id == ETH_SS_FEATURES) {
+        NM_G_MUTEX_LOCKED(&_ethtool_stringset_cache_lock);
+
+        g_free(_ethtool_stringset_cache_features);
+        _ethtool_stringset_cache_features = nm_memdup(gstrings, gstrings_len);
+    }
+
     return g_steal_pointer(&gstrings);
 }
 
@@ -570,35 +1562,22 @@ _ASSERT_ethtool_feature_infos(void)
 #endif
 }
 
+/* Creates the feature states from the flags of @blocks, which has one element
+ * for each 32 names in @ss_features. Both ioctl and netlink provide them. */
 static NMEthtoolFeatureStates *
-ethtool_get_features(SocketHandle *shandle)
+_ethtool_features_states_new(const struct ethtool_gstrings *        ss_features,
+                             const struct ethtool_get_features_block *blocks)
 {
-    gs_free NMEthtoolFeatureStates * states      = NULL;
-    gs_free struct ethtool_gstrings *ss_features = NULL;
+    gs_free NMEthtoolFeatureStates *states = NULL;
 
     _ASSERT_ethtool_feature_infos();
 
-    ss_features = ethtool_get_stringset(shandle, ETH_SS_FEATURES);
-    if (!ss_features)
-        return NULL;
-
     if (ss_features->len > 0) {
-        gs_free struct ethtool_gfeatures *  gfeatures_free = NULL;
-        struct ethtool_gfeatures *          gfeatures;
-        gsize                               gfeatures_len;
         guint                               idx;
         const NMEthtoolFeatureState *       states_list0   = NULL;
         const NMEthtoolFeatureState *const *states_plist0  = NULL;
         guint                               states_plist_n = 0;
 
-        gfeatures_len = sizeof(struct ethtool_gfeatures)
-                        + (NM_DIV_ROUND_UP(ss_features->len, 32u) * sizeof(gfeatures->features[0]));
-        gfeatures       = nm_malloc0_maybe_a(300, gfeatures_len, &gfeatures_free);
-        gfeatures->cmd  = ETHTOOL_GFEATURES;
-        gfeatures->size = NM_DIV_ROUND_UP(ss_features->len, 32u);
-        if (_ethtool_call_handle(shandle, gfeatures, gfeatures_len) < 0)
-            return NULL;
-
         for (idx = 0; idx < G_N_ELEMENTS(_ethtool_feature_infos); idx++) {
             const NMEthtoolFeatureInfo *info = &_ethtool_feature_infos[idx];
             guint                       idx_kernel_name;
@@ -635,10 +1614,10 @@ ethtool_get_features(SocketHandle *shandle)
                 kstate->info            = info;
                 kstate->idx_ss_features = i_feature;
                 kstate->idx_kernel_name = idx_kernel_name;
-                kstate->available       = !!(gfeatures->features[i_block].available & i_flag);
-                kstate->requested       = !!(gfeatures->features[i_block].requested & i_flag);
-                kstate->active          = !!(gfeatures->features[i_block].active & i_flag);
-                kstate->never_changed   = !!(gfeatures->features[i_block].never_changed & i_flag);
+                kstate->available       = !!(blocks[i_block].available & i_flag);
+                kstate->requested       = !!(blocks[i_block].requested & i_flag);
+                kstate->active          = !!(blocks[i_block].active & i_flag);
+                kstate->never_changed   = !!(blocks[i_block].never_changed & i_flag);
 
                 nm_assert(states_plist_n
                           < N_ETHTOOL_KERNEL_FEATURES + G_N_ELEMENTS(_ethtool_feature_infos));
@@ -662,15 +1641,68 @@ ethtool_get_features(SocketHandle *shandle)
     return g_steal_pointer(&states);
 }
 
+static NMEthtoolFeatureStates *
+ethtool_get_features(SocketHandle *shandle)
+{
+    gs_free struct ethtool_gstrings * ss_features    = NULL;
+    gs_free struct ethtool_gfeatures *gfeatures_free = NULL;
+    struct ethtool_gfeatures *        gfeatures;
+    gsize                             gfeatures_len;
+
+    ss_features = ethtool_get_stringset(shandle, ETH_SS_FEATURES);
+    if (!ss_features)
+        return NULL;
+
+    gfeatures_len = sizeof(struct ethtool_gfeatures)
+                    + (NM_DIV_ROUND_UP(ss_features->len, 32u) * sizeof(gfeatures->features[0]));
+    gfeatures       = nm_malloc0_maybe_a(300, gfeatures_len, &gfeatures_free);
+    gfeatures->cmd  = ETHTOOL_GFEATURES;
+    gfeatures->size = NM_DIV_ROUND_UP(ss_features->len, 32u);
+    if (ss_features->len > 0 && _ethtool_call_handle(shandle, gfeatures, gfeatures_len) < 0)
+        return NULL;
+
+    return _ethtool_features_states_new(ss_features, gfeatures->features);
+}
+
+static int
+_ethtool_nl_get_features(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolFeatureStates **out_features)
+{
+    gs_free struct ethtool_get_features_block *blocks_free = NULL;
+    struct ethtool_get_features_block *        blocks;
+    EthtoolNlLinkState *                       state;
+    guint                                      n_words;
+    guint                                      i;
+    int                                        r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_FEATURES, &state);
+    if (r < 0)
+        return r;
+
+    n_words = NM_DIV_ROUND_UP(enl->ss_features->len, 32u);
+    blocks  = nm_malloc0_maybe_a(300, n_words * sizeof(blocks[0]), &blocks_free);
+    for (i = 0; i < n_words; i++) {
+        blocks[i] = (struct ethtool_get_features_block){
+            .available     = state->features[i],
+            .requested     = state->features[n_words + i],
+            .active        = state->features[(2u * n_words) + i],
+            .never_changed = state->features[(3u * n_words) + i],
+        };
+    }
+
+    *out_features = _ethtool_features_states_new(enl->ss_features, blocks);
+    return 0;
+}
+
 NMEthtoolFeatureStates *
-nmp_utils_ethtool_get_features(int ifindex)
+nmp_utils_ethtool_get_features(NMPUtilsEthtoolNl *enl, int ifindex)
 {
-    nm_auto_socket_handle SocketHandle shandle = SOCKET_HANDLE_INIT(ifindex);
-    NMEthtoolFeatureStates *           features;
+    nm_auto_socket_handle SocketHandle shandle  = SOCKET_HANDLE_INIT(ifindex);
+    NMEthtoolFeatureStates *           features = NULL;
 
     g_return_val_if_fail(ifindex > 0, 0);
 
-    features = ethtool_get_features(&shandle);
+    if (!enl || _ethtool_nl_get_features(enl, ifindex, &features) == -EOPNOTSUPP)
+        features = ethtool_get_features(&shandle);
 
     if (!features) {
         nm_log_trace(LOGD_PLATFORM,
@@ -709,8 +1741,52 @@ _ethtool_feature_state_to_string(char *                       buf,
     return buf;
 }
 
+static int
+_ethtool_nl_set_features(NMPUtilsEthtoolNl *             enl,
+                         int                             ifindex,
+                         const struct ethtool_sfeatures *sfeatures)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    gs_free guint32 *            words_free = NULL;
+    guint32 *                    words;
+    struct nlattr *              nest;
+    guint                        i;
+
+    /* the bit indexes are those of the feature names that we got via netlink. */
+    if (!enl->ss_features || NM_DIV_ROUND_UP(enl->ss_features->len, 32u) != sfeatures->size)
+        return -EOPNOTSUPP;
+
+    msg = _ethtool_nl_msg_new(enl,
+                              ifindex,
+                              ETHTOOL_MSG_FEATURES_SET,
+                              ETHTOOL_FLAG_COMPACT_BITSETS | ETHTOOL_FLAG_OMIT_REPLY);
+    if (!msg)
+        return -ENOMEM;
+
+    words = nm_malloc0_maybe_a(300, 2u * sfeatures->size * sizeof(guint32), &words_free);
+    for (i = 0; i < sfeatures->size; i++) {
+        words[i]                   = sfeatures->features[i].requested;
+        words[sfeatures->size + i] = sfeatures->features[i].valid;
+    }
+
+    if (!(nest = nla_nest_start(msg, ETHTOOL_A_FEATURES_WANTED)))
+        goto nla_put_failure;
+    NLA_PUT_U32(msg, ETHTOOL_A_BITSET_SIZE, enl->ss_features->len);
+    NLA_PUT(msg, ETHTOOL_A_BITSET_VALUE, sfeatures->size * sizeof(guint32), &words[0]);
+    NLA_PUT(msg, ETHTOOL_A_BITSET_MASK, sfeatures->size * sizeof(guint32), &words[sfeatures->size]);
+    nla_nest_end(msg, nest);
+
+    _ethtool_nl_link_state_invalidate(enl, ifindex, ETHTOOL_NL_STATE_FEATURES);
+
+    return _ethtool_nl_request(enl, ifindex, "set-features", msg, NULL, NULL);
+
+nla_put_failure:
+    g_return_val_if_reached(-ENOMEM);
+}
+
 gboolean
 nmp_utils_ethtool_set_features(
+    NMPUtilsEthtoolNl *           enl,
     int                           ifindex,
     const NMEthtoolFeatureStates *features,
     const NMOptionBool *requested /* indexed by NMEthtoolID - _NM_ETHTOOL_ID_FEATURE_FIRST */,
@@ -841,14 +1917,18 @@ nmp_utils_ethtool_set_features(
             sfeatures->features[i_block].requested &= ~i_flag;
     }
 
-    r = _ethtool_call_handle(&shandle, sfeatures, sfeatures_len);
+    r = -EOPNOTSUPP;
+    if (enl)
+        r = _ethtool_nl_set_features(enl, ifindex, sfeatures);
+    if (r == -EOPNOTSUPP)
+        r = _ethtool_call_handle(&shandle, sfeatures, sfeatures_len);
     if (r < 0) {
         success = FALSE;
         nm_log_trace(LOGD_PLATFORM,
                      "ethtool[%d]: %s: failure setting features (%s)",
                      ifindex,
                      "set-features",
-                     nm_strerror_native(-r));
+                     nm_strerror(r));
         return FALSE;
     }
 
@@ -861,14 +1941,186 @@ nmp_utils_ethtool_set_features(
     return success;
 }
 
+/*****************************************************************************/
+
+static int
+_ethtool_nl_get_coalesce(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolCoalesceState *coalesce)
+{
+    EthtoolNlLinkState *state;
+    int                 r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_COALESCE, &state);
+    if (r < 0)
+        return r;
+
+    *coalesce = state->coalesce;
+    return 0;
+}
+
+static int
+_ethtool_nl_set_coalesce(NMPUtilsEthtoolNl *           enl,
+                         int                           ifindex,
+                         const NMEthtoolCoalesceState *coalesce)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    EthtoolNlLinkState *         state;
+    guint                        n_changed = 0;
+    guint                        i;
+    int                          r;
+
+    /* With netlink, kernel rejects every attribute that is not supported by the
+     * driver, even if the value is unchanged. Only send what differs from the
+     * current settings, which are usually cached already. */
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_COALESCE, &state);
+    if (r < 0)
+        return r;
+
+    msg = _ethtool_nl_msg_new(enl, ifindex, ETHTOOL_MSG_COALESCE_SET, 0);
+    if (!msg)
+        return -ENOMEM;
+
+    for (i = 0; i < _NM_ETHTOOL_ID_COALESCE_NUM; i++) {
+        const int attr = _ethtool_nl_coalesce_attrs[i];
+
+        if (coalesce->s[i] == state->coalesce.s[i])
+            continue;
+
+        if (_ethtool_nl_coalesce_attr_is_u8(attr))
+            NLA_PUT_U8(msg, attr, !!coalesce->s[i]);
+        else
+            NLA_PUT_U32(msg, attr, coalesce->s[i]);
+        n_changed++;
+    }
+
+    if (n_changed == 0)
+        return 0;
+
+    /* kernel notifies about the new settings before it acknowledges the request. */
+    _ethtool_nl_link_state_invalidate(enl, ifindex, ETHTOOL_NL_STATE_COALESCE);
+
+    return _ethtool_nl_request(enl, ifindex, "set-coalesce", msg, NULL, NULL);
+
+nla_put_failure:
+    g_return_val_if_reached(-ENOMEM);
+}
+
+static int
+_ethtool_nl_get_ring(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolRingState *ring)
+{
+    EthtoolNlLinkState *state;
+    int                 r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_RING, &state);
+    if (r < 0)
+        return r;
+
+    *ring = state->ring;
+    return 0;
+}
+
+static int
+_ethtool_nl_set_ring(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolRingState *ring)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    EthtoolNlLinkState *         state;
+    int                          r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_RING, &state);
+    if (r < 0)
+        return r;
+
+    if (memcmp(ring, &state->ring, sizeof(*ring)) == 0)
+        return 0;
+
+    msg = _ethtool_nl_msg_new(enl, ifindex, ETHTOOL_MSG_RINGS_SET, 0);
+    if (!msg)
+        return -ENOMEM;
+
+    if (ring->rx_pending != state->ring.rx_pending)
+        NLA_PUT_U32(msg, ETHTOOL_A_RINGS_RX, ring->rx_pending);
+    if (ring->rx_mini_pending != state->ring.rx_mini_pending)
+        NLA_PUT_U32(msg, ETHTOOL_A_RINGS_RX_MINI, ring->rx_mini_pending);
+    if (ring->rx_jumbo_pending != state->ring.rx_jumbo_pending)
+        NLA_PUT_U32(msg, ETHTOOL_A_RINGS_RX_JUMBO, ring->rx_jumbo_pending);
+    if (ring->tx_pending != state->ring.tx_pending)
+        NLA_PUT_U32(msg, ETHTOOL_A_RINGS_TX, ring->tx_pending);
+
+    _ethtool_nl_link_state_invalidate(enl, ifindex, ETHTOOL_NL_STATE_RING);
+
+    return _ethtool_nl_request(enl, ifindex, "set-ring", msg, NULL, NULL);
+
+nla_put_failure:
+    g_return_val_if_reached(-ENOMEM);
+}
+
+static int
+_ethtool_nl_get_pause(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolPauseState *pause)
+{
+    EthtoolNlLinkState *state;
+    int                 r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_PAUSE, &state);
+    if (r < 0)
+        return r;
+
+    *pause = state->pause;
+    return 0;
+}
+
+static int
+_ethtool_nl_set_pause(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolPauseState *pause)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    EthtoolNlLinkState *         state;
+    int                          r;
+
+    r = _ethtool_nl_link_state_get(enl, ifindex, ETHTOOL_NL_STATE_PAUSE, &state);
+    if (r < 0)
+        return r;
+
+    if (pause->autoneg == state->pause.autoneg && pause->rx == state->pause.rx
+        && pause->tx == state->pause.tx)
+        return 0;
+
+    msg = _ethtool_nl_msg_new(enl, ifindex, ETHTOOL_MSG_PAUSE_SET, 0);
+    if (!msg)
+        return -ENOMEM;
+
+    if (pause->autoneg != state->pause.autoneg)
+        NLA_PUT_U8(msg, ETHTOOL_A_PAUSE_AUTONEG, pause->autoneg ? 1 : 0);
+    if (pause->rx != state->pause.rx)
+        NLA_PUT_U8(msg, ETHTOOL_A_PAUSE_RX, pause->rx ? 1 : 0);
+    if (pause->tx != state->pause.tx)
+        NLA_PUT_U8(msg, ETHTOOL_A_PAUSE_TX, pause->tx ? 1 : 0);
+
+    _ethtool_nl_link_state_invalidate(enl, ifindex, ETHTOOL_NL_STATE_PAUSE);
+
+    return _ethtool_nl_request(enl, ifindex, "set-pause", msg, NULL, NULL);
+
+nla_put_failure:
+    g_return_val_if_reached(-ENOMEM);
+}
+
+/*****************************************************************************/
+
 gboolean
-nmp_utils_ethtool_get_coalesce(int ifindex, NMEthtoolCoalesceState *coalesce)
+nmp_utils_ethtool_get_coalesce(NMPUtilsEthtoolNl *     enl,
+                               int                     ifindex,
+                               NMEthtoolCoalesceState *coalesce)
 {
     struct ethtool_coalesce eth_data;
 
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(coalesce, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_get_coalesce(enl, ifindex, coalesce);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data.cmd = ETHTOOL_GCOALESCE;
 
     if (_ethtool_call_once(ifindex, &eth_data, sizeof(eth_data)) < 0) {
@@ -936,13 +2188,23 @@ nmp_utils_ethtool_get_coalesce(int ifindex, NMEthtoolCoalesceState *coalesce)
 }
 
 gboolean
-nmp_utils_ethtool_set_coalesce(int ifindex, const NMEthtoolCoalesceState *coalesce)
+nmp_utils_ethtool_set_coalesce(NMPUtilsEthtoolNl *           enl,
+                               int                           ifindex,
+                               const NMEthtoolCoalesceState *coalesce)
 {
     struct ethtool_coalesce eth_data;
 
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(coalesce, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_set_coalesce(enl, ifindex, coalesce);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data = (struct ethtool_coalesce){
         .cmd = ETHTOOL_SCOALESCE,
         .rx_coalesce_usecs =
@@ -1007,13 +2269,21 @@ nmp_utils_ethtool_set_coalesce(int ifindex, const NMEthtoolCoalesceState *coales
 }
 
 gboolean
-nmp_utils_ethtool_get_ring(int ifindex, NMEthtoolRingState *ring)
+nmp_utils_ethtool_get_ring(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolRingState *ring)
 {
     struct ethtool_ringparam eth_data;
 
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(ring, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_get_ring(enl, ifindex, ring);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data.cmd = ETHTOOL_GRINGPARAM;
 
     if (_ethtool_call_once(ifindex, &eth_data, sizeof(eth_data)) < 0) {
@@ -1039,13 +2309,21 @@ nmp_utils_ethtool_get_ring(int ifindex, NMEthtoolRingState *ring)
 }
 
 gboolean
-nmp_utils_ethtool_set_ring(int ifindex, const NMEthtoolRingState *ring)
+nmp_utils_ethtool_set_ring(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolRingState *ring)
 {
     struct ethtool_ringparam eth_data;
 
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(ring, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_set_ring(enl, ifindex, ring);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data = (struct ethtool_ringparam){
         .cmd              = ETHTOOL_SRINGPARAM,
         .rx_pending       = ring->rx_pending,
@@ -1067,7 +2345,7 @@ nmp_utils_ethtool_set_ring(int ifindex, const NMEthtoolRingState *ring)
 }
 
 gboolean
-nmp_utils_ethtool_get_pause(int ifindex, NMEthtoolPauseState *pause)
+nmp_utils_ethtool_get_pause(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolPauseState *pause)
 {
     struct ethtool_pauseparam          eth_data;
     nm_auto_socket_handle SocketHandle shandle = SOCKET_HANDLE_INIT(ifindex);
@@ -1075,6 +2353,14 @@ nmp_utils_ethtool_get_pause(int ifindex, NMEthtoolPauseState *pause)
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(pause, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_get_pause(enl, ifindex, pause);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data.cmd = ETHTOOL_GPAUSEPARAM;
     if (_ethtool_call_handle(&shandle, &eth_data, sizeof(struct ethtool_pauseparam)) != 0) {
         nm_log_trace(LOGD_PLATFORM,
@@ -1098,7 +2384,7 @@ nmp_utils_ethtool_get_pause(int ifindex, NMEthtoolPauseState *pause)
 }
 
 gboolean
-nmp_utils_ethtool_set_pause(int ifindex, const NMEthtoolPauseState *pause)
+nmp_utils_ethtool_set_pause(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolPauseState *pause)
 {
     struct ethtool_pauseparam          eth_data;
     nm_auto_socket_handle SocketHandle shandle = SOCKET_HANDLE_INIT(ifindex);
@@ -1106,6 +2392,14 @@ nmp_utils_ethtool_set_pause(int ifindex, const NMEthtoolPauseState *pause)
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(pause, FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_set_pause(enl, ifindex, pause);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     eth_data = (struct ethtool_pauseparam){
         .cmd      = ETHTOOL_SPAUSEPARAM,
         .autoneg  = pause->autoneg ? 1 : 0,
@@ -1286,8 +2580,107 @@ nmp_utils_ethtool_get_wake_on_lan(int ifindex)
     return wol.wolopts != 0;
 }
 
+/* link modes that we handle via netlink. Their bit numbers are those of the
+ * ioctl API. */
+#define ETHTOOL_NL_LINK_MODES_WORDS 8
+
+typedef struct {
+    guint32 supported[ETHTOOL_NL_LINK_MODES_WORDS];
+    guint32 advertised[ETHTOOL_NL_LINK_MODES_WORDS];
+    guint32 n_bits;
+    guint32 speed;
+    guint8  autoneg;
+    guint8  duplex;
+} EthtoolNlLinkModes;
+
+static int
+_ethtool_nl_link_modes_handler(struct nl_msg *msg, void *arg)
+{
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_LINKMODES_HEADER]  = {.type = NLA_NESTED},
+        [ETHTOOL_A_LINKMODES_AUTONEG] = {.type = NLA_U8},
+        [ETHTOOL_A_LINKMODES_OURS]    = {.type = NLA_NESTED},
+        [ETHTOOL_A_LINKMODES_SPEED]   = {.type = NLA_U32},
+        [ETHTOOL_A_LINKMODES_DUPLEX]  = {.type = NLA_U8},
+    };
+    static const struct nla_policy bitset_policy[] = {
+        [ETHTOOL_A_BITSET_NOMASK] = {.type = NLA_FLAG},
+        [ETHTOOL_A_BITSET_SIZE]   = {.type = NLA_U32},
+        [ETHTOOL_A_BITSET_BITS]   = {.type = NLA_NESTED},
+        [ETHTOOL_A_BITSET_VALUE]  = {.type = NLA_BINARY},
+        [ETHTOOL_A_BITSET_MASK]   = {.type = NLA_BINARY},
+    };
+    EthtoolNlLinkModes *link_modes = arg;
+    struct nlattr *     tb[G_N_ELEMENTS(policy)];
+    struct nlattr *     tb_bitset[G_N_ELEMENTS(bitset_policy)];
+
+    if (genlmsg_parse_arr(nlmsg_hdr(msg), 0, tb, policy) < 0)
+        return NL_SKIP;
+
+    *link_modes = (EthtoolNlLinkModes){
+        .autoneg = nla_get_u8_cond(tb, ETHTOOL_A_LINKMODES_AUTONEG, AUTONEG_DISABLE),
+        .speed   = tb[ETHTOOL_A_LINKMODES_SPEED] ? nla_get_u32(tb[ETHTOOL_A_LINKMODES_SPEED])
+                                                 : SPEED_UNKNOWN,
+        .duplex  = nla_get_u8_cond(tb, ETHTOOL_A_LINKMODES_DUPLEX, DUPLEX_UNKNOWN),
+    };
+
+    /* we request the compact form, where the mask are the supported modes. */
+    if (tb[ETHTOOL_A_LINKMODES_OURS]
+        && nla_parse_nested_arr(tb_bitset, tb[ETHTOOL_A_LINKMODES_OURS], bitset_policy) >= 0
+        && tb_bitset[ETHTOOL_A_BITSET_SIZE] && tb_bitset[ETHTOOL_A_BITSET_VALUE]
+        && tb_bitset[ETHTOOL_A_BITSET_MASK]) {
+        link_modes->n_bits = NM_MIN(nla_get_u32(tb_bitset[ETHTOOL_A_BITSET_SIZE]),
+                                    ETHTOOL_NL_LINK_MODES_WORDS * 32u);
+        nla_memcpy(link_modes->advertised,
+                   tb_bitset[ETHTOOL_A_BITSET_VALUE],
+                   sizeof(link_modes->advertised));
+        nla_memcpy(link_modes->supported,
+                   tb_bitset[ETHTOOL_A_BITSET_MASK],
+                   sizeof(link_modes->supported));
+    }
+
+    return NL_OK;
+}
+
+static int
+_ethtool_nl_get_link_modes(NMPUtilsEthtoolNl *enl, int ifindex, EthtoolNlLinkModes *link_modes)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+    msg = _ethtool_nl_msg_new(enl,
+                              ifindex,
+                              ETHTOOL_MSG_LINKMODES_GET,
+                              ETHTOOL_FLAG_COMPACT_BITSETS);
+
+    *link_modes = (EthtoolNlLinkModes){
+        .autoneg = AUTONEG_DISABLE,
+        .speed   = SPEED_UNKNOWN,
+        .duplex  = DUPLEX_UNKNOWN,
+    };
+    return _ethtool_nl_request(enl,
+                               ifindex,
+                               "get-link-modes",
+                               msg,
+                               _ethtool_nl_link_modes_handler,
+                               link_modes);
+}
+
+static NMPlatformLinkDuplexType
+_ethtool_duplex_from_native(guint8 duplex)
+{
+    switch (duplex) {
+    case DUPLEX_HALF:
+        return NM_PLATFORM_LINK_DUPLEX_HALF;
+    case DUPLEX_FULL:
+        return NM_PLATFORM_LINK_DUPLEX_FULL;
+    default: /* DUPLEX_UNKNOWN */
+        return NM_PLATFORM_LINK_DUPLEX_UNKNOWN;
+    }
+}
+
 gboolean
-nmp_utils_ethtool_get_link_settings(int                       ifindex,
+nmp_utils_ethtool_get_link_settings(NMPUtilsEthtoolNl *       enl,
+                                    int                       ifindex,
                                     gboolean *                out_autoneg,
                                     guint32 *                 out_speed,
                                     NMPlatformLinkDuplexType *out_duplex)
@@ -1298,6 +2691,24 @@ nmp_utils_ethtool_get_link_settings(int                       ifindex,
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
+    if (enl) {
+        EthtoolNlLinkModes link_modes;
+        int                r;
+
+        r = _ethtool_nl_get_link_modes(enl, ifindex, &link_modes);
+        if (r != -EOPNOTSUPP) {
+            if (r < 0)
+                return FALSE;
+
+            NM_SET_OUT(out_autoneg, (link_modes.autoneg == AUTONEG_ENABLE));
+            NM_SET_OUT(out_speed,
+                       NM_IN_SET(link_modes.speed, G_MAXUINT16, G_MAXUINT32) ? 0
+                                                                             : link_modes.speed);
+            NM_SET_OUT(out_duplex, _ethtool_duplex_from_native(link_modes.duplex));
+            return TRUE;
+        }
+    }
+
     if (_ethtool_call_once(ifindex, &edata, sizeof(edata)) < 0)
         return FALSE;
 
@@ -1313,19 +2724,7 @@ nmp_utils_ethtool_get_link_settings(int                       ifindex,
         *out_speed = speed;
     }
 
-    if (out_duplex) {
-        switch (edata.duplex) {
-        case DUPLEX_HALF:
-            *out_duplex = NM_PLATFORM_LINK_DUPLEX_HALF;
-            break;
-        case DUPLEX_FULL:
-            *out_duplex = NM_PLATFORM_LINK_DUPLEX_FULL;
-            break;
-        default: /* DUPLEX_UNKNOWN */
-            *out_duplex = NM_PLATFORM_LINK_DUPLEX_UNKNOWN;
-            break;
-        }
-    }
+    NM_SET_OUT(out_duplex, _ethtool_duplex_from_native(edata.duplex));
 
     return TRUE;
 }
@@ -1472,8 +2871,97 @@ set_link_settings_new(SocketHandle *           shandle,
     return _ethtool_call_handle(shandle, edata, edata_size) >= 0;
 }
 
+static int
+_ethtool_nl_set_link_modes(NMPUtilsEthtoolNl *      enl,
+                           int                      ifindex,
+                           gboolean                 autoneg,
+                           guint32                  speed,
+                           NMPlatformLinkDuplexType duplex)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    EthtoolNlLinkModes           link_modes;
+    struct nlattr *              nest;
+    guint8                       duplex_native;
+    int                          r;
+
+    if (autoneg) {
+        /* we need the supported modes to advertise them. */
+        r = _ethtool_nl_get_link_modes(enl, ifindex, &link_modes);
+        if (r < 0)
+            return r;
+        if (link_modes.n_bits == 0)
+            return -EOPNOTSUPP;
+
+        /* advertise all supported modes. */
+        memcpy(link_modes.advertised, link_modes.supported, sizeof(link_modes.advertised));
+
+        if (speed != 0) {
+            guint32 mode;
+
+            mode = get_baset_mode(speed, duplex);
+
+            if (mode == ADVERTISED_INVALID) {
+                nm_log_trace(LOGD_PLATFORM,
+                             "ethtool[%d]: %uBASE-T %s duplex mode cannot be advertised",
+                             ifindex,
+                             speed,
+                             nm_platform_link_duplex_type_to_string(duplex));
+                return -EINVAL;
+            }
+
+            /* We only support BASE-T modes in the first word */
+            if (!(link_modes.supported[0] & mode)) {
+                nm_log_trace(LOGD_PLATFORM,
+                             "ethtool[%d]: device does not support %uBASE-T %s duplex mode",
+                             ifindex,
+                             speed,
+                             nm_platform_link_duplex_type_to_string(duplex));
+                return -EINVAL;
+            }
+
+            link_modes.advertised[0] = (link_modes.advertised[0] & ~BASET_ALL_MODES) | mode;
+        }
+    }
+
+    msg = _ethtool_nl_msg_new(enl,
+                              ifindex,
+                              ETHTOOL_MSG_LINKMODES_SET,
+                              ETHTOOL_FLAG_COMPACT_BITSETS);
+    if (!msg)
+        return -ENOMEM;
+
+    if (autoneg) {
+        NLA_PUT_U8(msg, ETHTOOL_A_LINKMODES_AUTONEG, AUTONEG_ENABLE);
+
+        /* without mask, the bitset is the complete list of advertised modes. */
+        if (!(nest = nla_nest_start(msg, ETHTOOL_A_LINKMODES_OURS)))
+            goto nla_put_failure;
+        NLA_PUT_FLAG(msg, ETHTOOL_A_BITSET_NOMASK);
+        NLA_PUT_U32(msg, ETHTOOL_A_BITSET_SIZE, link_modes.n_bits);
+        NLA_PUT(msg,
+                ETHTOOL_A_BITSET_VALUE,
+                NM_DIV_ROUND_UP(link_modes.n_bits, 32u) * sizeof(guint32),
+                link_modes.advertised);
+        nla_nest_end(msg, nest);
+    } else {
+        NLA_PUT_U8(msg, ETHTOOL_A_LINKMODES_AUTONEG, AUTONEG_DISABLE);
+
+        if (speed)
+            NLA_PUT_U32(msg, ETHTOOL_A_LINKMODES_SPEED, speed);
+
+        if (platform_link_duplex_type_to_native(duplex, &duplex_native))
+            NLA_PUT_U8(msg, ETHTOOL_A_LINKMODES_DUPLEX, duplex_native);
+    }
+
+    return _ethtool_nl_request(enl, ifindex, "set-link-modes", msg, NULL, NULL);
+
+nla_put_failure:
+    g_return_val_if_reached(-ENOMEM);
+}
+
 gboolean
-nmp_utils_ethtool_set_link_settings(int                      ifindex,
+nmp_utils_ethtool_set_link_settings(NMPUtilsEthtoolNl *      enl,
+                                    int                      ifindex,
                                     gboolean                 autoneg,
                                     guint32                  speed,
                                     NMPlatformLinkDuplexType duplex)
@@ -1489,6 +2977,14 @@ nmp_utils_ethtool_set_link_settings(int                      ifindex,
                              || (!speed && duplex == NM_PLATFORM_LINK_DUPLEX_UNKNOWN),
                          FALSE);
 
+    if (enl) {
+        int r;
+
+        r = _ethtool_nl_set_link_modes(enl, ifindex, autoneg, speed, duplex);
+        if (r != -EOPNOTSUPP)
+            return r >= 0;
+    }
+
     ret = set_link_settings_new(&shandle, autoneg, speed, duplex);
     if (ret != NM_OPTION_BOOL_DEFAULT)
         return ret;
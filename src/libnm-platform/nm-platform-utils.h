@@ -22,11 +22,27 @@ gboolean    nmp_utils_ethtool_set_wake_on_lan(int                      ifindex,
 
 const char *nm_platform_link_duplex_type_to_string(NMPlatformLinkDuplexType duplex);
 
-gboolean nmp_utils_ethtool_get_link_settings(int                       ifindex,
+/* Requests to the "ethtool" generic netlink family. The settings that kernel
+ * notifies about are cached per ifindex.
+ *
+ * The following functions accept it optionally. If given, netlink is used and
+ * SIOCETHTOOL only as fallback. */
+typedef struct _NMPUtilsEthtoolNl NMPUtilsEthtoolNl;
+
+NMPUtilsEthtoolNl *nmp_utils_ethtool_nl_new(void);
+void               nmp_utils_ethtool_nl_free(NMPUtilsEthtoolNl *enl);
+int                nmp_utils_ethtool_nl_get_monitor_fd(NMPUtilsEthtoolNl *enl);
+void               nmp_utils_ethtool_nl_process_monitor(NMPUtilsEthtoolNl *enl);
+void               nmp_utils_ethtool_nl_forget_link(NMPUtilsEthtoolNl *enl, int ifindex);
+guint64            nmp_utils_ethtool_nl_get_n_round_trips(NMPUtilsEthtoolNl *enl);
+
+gboolean nmp_utils_ethtool_get_link_settings(NMPUtilsEthtoolNl *       enl,
+                                             int                       ifindex,
                                              gboolean *                out_autoneg,
                                              guint32 *                 out_speed,
                                              NMPlatformLinkDuplexType *out_duplex);
-gboolean nmp_utils_ethtool_set_link_settings(int                      ifindex,
+gboolean nmp_utils_ethtool_set_link_settings(NMPUtilsEthtoolNl *      enl,
+                                             int                      ifindex,
                                              gboolean                 autoneg,
                                              guint32                  speed,
                                              NMPlatformLinkDuplexType duplex);
@@ -35,25 +51,34 @@ gboolean nmp_utils_ethtool_get_permanent_address(int ifindex, guint8 *buf, size_
 
 gboolean nmp_utils_ethtool_get_driver_info(int ifindex, NMPUtilsEthtoolDriverInfo *data);
 
-NMEthtoolFeatureStates *nmp_utils_ethtool_get_features(int ifindex);
+NMEthtoolFeatureStates *nmp_utils_ethtool_get_features(NMPUtilsEthtoolNl *enl, int ifindex);
 
 gboolean nmp_utils_ethtool_set_features(
+    NMPUtilsEthtoolNl *           enl,
     int                           ifindex,
     const NMEthtoolFeatureStates *features,
     const NMOptionBool *requested /* indexed by NMEthtoolID - _NM_ETHTOOL_ID_FEATURE_FIRST */,
     gboolean            do_set /* or reset */);
 
-gboolean nmp_utils_ethtool_get_coalesce(int ifindex, NMEthtoolCoalesceState *coalesce);
+gboolean nmp_utils_ethtool_get_coalesce(NMPUtilsEthtoolNl *     enl,
+                                        int                     ifindex,
+                                        NMEthtoolCoalesceState *coalesce);
 
-gboolean nmp_utils_ethtool_set_coalesce(int ifindex, const NMEthtoolCoalesceState *coalesce);
+gboolean nmp_utils_ethtool_set_coalesce(NMPUtilsEthtoolNl *           enl,
+                                        int                           ifindex,
+                                        const NMEthtoolCoalesceState *coalesce);
 
-gboolean nmp_utils_ethtool_get_ring(int ifindex, NMEthtoolRingState *ring);
+gboolean
+nmp_utils_ethtool_get_ring(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolRingState *ring);
 
-gboolean nmp_utils_ethtool_set_ring(int ifindex, const NMEthtoolRingState *ring);
+gboolean
+nmp_utils_ethtool_set_ring(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolRingState *ring);
 
-gboolean nmp_utils_ethtool_get_pause(int ifindex, NMEthtoolPauseState *pause);
+gboolean
+nmp_utils_ethtool_get_pause(NMPUtilsEthtoolNl *enl, int ifindex, NMEthtoolPauseState *pause);
 
-gboolean nmp_utils_ethtool_set_pause(int ifindex, const NMEthtoolPauseState *pause);
+gboolean
+nmp_utils_ethtool_set_pause(NMPUtilsEthtoolNl *enl, int ifindex, const NMEthtoolPauseState *pause);
 
 /*****************************************************************************/
 
@@ -415,6 +415,57 @@ nm_platform_process_events(NMPlatform *self)
         klass->process_events(self);
 }
 
+/*****************************************************************************/
+
+NM_UTILS_LOOKUP_STR_DEFINE(nm_platform_dump_reason_to_string,
+                           NMPlatformDumpReason,
+                           NM_UTILS_LOOKUP_DEFAULT_NM_ASSERT(NULL),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PLATFORM_DUMP_REASON_SYNC, "sync"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PLATFORM_DUMP_REASON_REQUESTED, "requested"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PLATFORM_DUMP_REASON_ROUTE_RESYNC,
+                                                    "route-resync"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PLATFORM_DUMP_REASON_OVERFLOW, "overflow"),
+                           NM_UTILS_LOOKUP_ITEM_IGNORE(_NM_PLATFORM_DUMP_REASON_NUM), );
+
+/**
+ * nm_platform_get_statistics:
+ * @self: platform instance
+ * @out_stats: (out): the statistics
+ *
+ * Get counters about the netlink traffic and the content of the
+ * platform cache. This is cheap and meant for debugging.
+ */
+void
+nm_platform_get_statistics(NMPlatform *self, NMPlatformStatistics *out_stats)
+{
+    NMPObjectType obj_type;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    g_return_if_fail(out_stats);
+
+    memset(out_stats, 0, sizeof(*out_stats));
+
+    if (klass->get_netlink_stats)
+        klass->get_netlink_stats(self, &out_stats->netlink);
+
+    for (obj_type = NMP_OBJECT_TYPE_LINK; obj_type <= NMP_OBJECT_TYPE_TFILTER; obj_type++) {
+        const NMPClass *             klass_obj = nmp_class_from_type(obj_type);
+        const NMDedupMultiHeadEntry *head_entry;
+        NMPLookup                    lookup;
+
+        nmp_lookup_init_obj_type(&lookup, obj_type);
+        head_entry = nm_platform_lookup(self, &lookup);
+        if (!head_entry)
+            continue;
+
+        out_stats->cache[obj_type].n_objs = head_entry->len;
+        out_stats->cache[obj_type].size =
+            head_entry->len
+            * (G_STRUCT_OFFSET(NMPObject, object) + (gsize) klass_obj->sizeof_data);
+    }
+}
+
 const NMPlatformLink *
 nm_platform_process_events_ensure_link(NMPlatform *self, int ifindex, const char *ifname)
 {
@@ -2299,7 +2350,8 @@ static NM_UTILS_FLAGS2STR_DEFINE(
     NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS, "replace-peers"),
     NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_PRIVATE_KEY, "has-private-key"),
     NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT, "has-listen-port"),
-    NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK, "has-fwmark"), );
+    NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK, "has-fwmark"),
+    NM_UTILS_FLAGS2STR(NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC, "sync"), );
 
 static NM_UTILS_FLAGS2STR_DEFINE(
     _wireguard_change_peer_flags_to_string,
@@ -3203,6 +3255,14 @@ nm_platform_ethtool_set_wake_on_lan(NMPlatform *             self,
     return nmp_utils_ethtool_set_wake_on_lan(ifindex, wol, wol_password);
 }
 
+static NMPUtilsEthtoolNl *
+_ethtool_get_nl(NMPlatform *self, NMPlatformClass *klass)
+{
+    if (!klass->ethtool_get_nl)
+        return NULL;
+    return klass->ethtool_get_nl(self);
+}
+
 gboolean
 nm_platform_ethtool_set_link_settings(NMPlatform *             self,
                                       int                      ifindex,
@@ -3214,7 +3274,11 @@ nm_platform_ethtool_set_link_settings(NMPlatform *             self,
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_set_link_settings(ifindex, autoneg, speed, duplex);
+    return nmp_utils_ethtool_set_link_settings(_ethtool_get_nl(self, klass),
+                                               ifindex,
+                                               autoneg,
+                                               speed,
+                                               duplex);
 }
 
 gboolean
@@ -3228,7 +3292,11 @@ nm_platform_ethtool_get_link_settings(NMPlatform *              self,
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_get_link_settings(ifindex, out_autoneg, out_speed, out_duplex);
+    return nmp_utils_ethtool_get_link_settings(_ethtool_get_nl(self, klass),
+                                               ifindex,
+                                               out_autoneg,
+                                               out_speed,
+                                               out_duplex);
 }
 
 /*****************************************************************************/
@@ -3240,7 +3308,7 @@ nm_platform_ethtool_get_link_features(NMPlatform *self, int ifindex)
 
     g_return_val_if_fail(ifindex > 0, NULL);
 
-    return nmp_utils_ethtool_get_features(ifindex);
+    return nmp_utils_ethtool_get_features(_ethtool_get_nl(self, klass), ifindex);
 }
 
 gboolean
@@ -3255,7 +3323,11 @@ nm_platform_ethtool_set_features(
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_set_features(ifindex, features, requested, do_set);
+    return nmp_utils_ethtool_set_features(_ethtool_get_nl(self, klass),
+                                          ifindex,
+                                          features,
+                                          requested,
+                                          do_set);
 }
 
 gboolean
@@ -3268,7 +3340,7 @@ nm_platform_ethtool_get_link_coalesce(NMPlatform *            self,
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(coalesce, FALSE);
 
-    return nmp_utils_ethtool_get_coalesce(ifindex, coalesce);
+    return nmp_utils_ethtool_get_coalesce(_ethtool_get_nl(self, klass), ifindex, coalesce);
 }
 
 gboolean
@@ -3280,7 +3352,7 @@ nm_platform_ethtool_set_coalesce(NMPlatform *                  self,
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_set_coalesce(ifindex, coalesce);
+    return nmp_utils_ethtool_set_coalesce(_ethtool_get_nl(self, klass), ifindex, coalesce);
 }
 
 gboolean
@@ -3291,7 +3363,7 @@ nm_platform_ethtool_get_link_ring(NMPlatform *self, int ifindex, NMEthtoolRingSt
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(ring, FALSE);
 
-    return nmp_utils_ethtool_get_ring(ifindex, ring);
+    return nmp_utils_ethtool_get_ring(_ethtool_get_nl(self, klass), ifindex, ring);
 }
 
 gboolean
@@ -3301,7 +3373,7 @@ nm_platform_ethtool_set_ring(NMPlatform *self, int ifindex, const NMEthtoolRingS
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_set_ring(ifindex, ring);
+    return nmp_utils_ethtool_set_ring(_ethtool_get_nl(self, klass), ifindex, ring);
 }
 
 gboolean
@@ -3312,7 +3384,7 @@ nm_platform_ethtool_get_link_pause(NMPlatform *self, int ifindex, NMEthtoolPause
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(pause, FALSE);
 
-    return nmp_utils_ethtool_get_pause(ifindex, pause);
+    return nmp_utils_ethtool_get_pause(_ethtool_get_nl(self, klass), ifindex, pause);
 }
 
 gboolean
@@ -3322,7 +3394,7 @@ nm_platform_ethtool_set_pause(NMPlatform *self, int ifindex, const NMEthtoolPaus
 
     g_return_val_if_fail(ifindex > 0, FALSE);
 
-    return nmp_utils_ethtool_set_pause(ifindex, pause);
+    return nmp_utils_ethtool_set_pause(_ethtool_get_nl(self, klass), ifindex, pause);
 }
 
 /*****************************************************************************/
@@ -4887,6 +4959,7 @@ nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
     case NMP_OBJECT_TYPE_IP4_ROUTE:
     case NMP_OBJECT_TYPE_IP6_ROUTE:
     case NMP_OBJECT_TYPE_QDISC:
+    case NMP_OBJECT_TYPE_TCLASS:
     case NMP_OBJECT_TYPE_TFILTER:
         ifindex = NMP_OBJECT_CAST_OBJ_WITH_IFINDEX(obj)->ifindex;
         _LOG3D("%s: delete %s",
@@ -4900,6 +4973,67 @@ nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
     return klass->object_delete(self, obj);
 }
 
+/**
+ * nm_platform_object_apply:
+ * @self: the #NMPlatform instance
+ * @changes: the objects to add or delete
+ * @len: the number of elements in @changes
+ *
+ * Adds or deletes the objects in @changes, in the given order. Contrary to
+ * calling nm_platform_object_delete() and friends for each object, this
+ * does not wait for each request to complete before sending the next one.
+ * The changes are not atomic: on failure, some of the changes may be applied
+ * and others not.
+ *
+ * Returns: %TRUE if all changes were applied successfully.
+ */
+gboolean
+nm_platform_object_apply(NMPlatform *self, const NMPlatformObjChange *changes, guint len)
+{
+    gboolean success = TRUE;
+    guint    i;
+
+    _CHECK_SELF(self, klass, FALSE);
+
+    if (len == 0)
+        return TRUE;
+
+    if (klass->object_apply)
+        return klass->object_apply(self, changes, len);
+
+    for (i = 0; i < len; i++) {
+        const NMPlatformObjChange *change = &changes[i];
+        const NMPObject *         obj    = change->obj;
+
+        if (change->delete) {
+            success &= nm_platform_object_delete(self, obj);
+            continue;
+        }
+
+        switch (NMP_OBJECT_GET_TYPE(obj)) {
+        case NMP_OBJECT_TYPE_ROUTING_RULE:
+            success &=
+                (nm_platform_routing_rule_add(self, change->nlmflags, &obj->routing_rule) >= 0);
+            break;
+        case NMP_OBJECT_TYPE_QDISC:
+            success &= (nm_platform_qdisc_add(self, change->nlmflags, &obj->qdisc) >= 0);
+            break;
+        case NMP_OBJECT_TYPE_TCLASS:
+            success &= (nm_platform_tclass_add(self, change->nlmflags, &obj->tclass) >= 0);
+            break;
+        case NMP_OBJECT_TYPE_TFILTER:
+            success &= (nm_platform_tfilter_add(self, change->nlmflags, &obj->tfilter) >= 0);
+            break;
+        default:
+            nm_assert_not_reached();
+            success = FALSE;
+            break;
+        }
+    }
+
+    return success;
+}
+
 /*****************************************************************************/
 
 int
@@ -5248,113 +5382,488 @@ nm_platform_qdisc_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc
     return klass->qdisc_add(self, flags, qdisc);
 }
 
-/**
- * nm_platform_qdisc_sync:
- * @self: the #NMPlatform instance
- * @ifindex: the ifindex where to configure the qdiscs.
- * @known_qdiscs: the list of qdiscs (#NMPObject).
- *
- * The function promises not to take any reference to the qdisc
- * instances from @known_qdiscs, nor to keep them around after
- * the function returns. This is important, because it allows the
- * caller to pass NMPlatformQdisc instances which "kind" string
- * have a limited lifetime.
- *
- * Returns: %TRUE on success.
- */
-gboolean
-nm_platform_qdisc_sync(NMPlatform *self, int ifindex, GPtrArray *known_qdiscs)
+/*****************************************************************************/
+
+int
+nm_platform_tclass_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTclass *tclass)
+{
+    int ifindex = tclass->ifindex;
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    /* Note: @tclass must not be copied or kept alive because the lifetime of tclass.kind
+     * is undefined. */
+
+    _LOG3D("adding or updating a tclass: %s", nm_platform_tclass_to_string(tclass, NULL, 0));
+    return klass->tclass_add(self, flags, tclass);
+}
+
+/*****************************************************************************/
+
+int
+nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfilter *tfilter)
+{
+    int ifindex = tfilter->ifindex;
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    /* Note: @tfilter must not be copied or kept alive because the lifetime of tfilter.kind
+     * and tfilter.action.kind is undefined. */
+
+    _LOG3D("adding or updating a tfilter: %s", nm_platform_tfilter_to_string(tfilter, NULL, 0));
+    return klass->tfilter_add(self, flags, tfilter);
+}
+
+/*****************************************************************************/
+
+typedef enum {
+    /* the object is configured as requested. */
+    TC_SYNC_STATE_KEEP,
+
+    /* the object exists but its parameters must be changed in place. */
+    TC_SYNC_STATE_UPDATE,
+
+    /* the object must be deleted. */
+    TC_SYNC_STATE_DELETE,
+
+    /* the object gets deleted by kernel together with its parent (or is replaced),
+     * it must not be deleted explicitly. */
+    TC_SYNC_STATE_GONE,
+} TcSyncState;
+
+typedef struct _TcSyncEntry TcSyncEntry;
+
+struct _TcSyncEntry {
+    const NMPObject *obj;
+
+    TcSyncEntry *parent;
+
+    /* for entries from the platform cache, the matching known entry. */
+    TcSyncEntry *known;
+
+    guint       depth;
+    TcSyncState state;
+
+    /* for known entries, whether the object must be (re-)added. */
+    bool add : 1;
+};
+
+static guint32
+_tc_obj_get_handle(const NMPObject *obj)
+{
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_QDISC:
+        return obj->qdisc.handle;
+    case NMP_OBJECT_TYPE_TCLASS:
+        return obj->tclass.handle;
+    case NMP_OBJECT_TYPE_TFILTER:
+        return obj->tfilter.handle;
+    default:
+        return nm_assert_unreachable_val(0);
+    }
+}
+
+static guint32
+_tc_obj_get_parent(const NMPObject *obj)
+{
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_QDISC:
+        return obj->qdisc.parent;
+    case NMP_OBJECT_TYPE_TCLASS:
+        return obj->tclass.parent;
+    case NMP_OBJECT_TYPE_TFILTER:
+        return obj->tfilter.parent;
+    default:
+        return nm_assert_unreachable_val(0);
+    }
+}
+
+static TcSyncEntry *
+_tc_sync_entry_get_parent(GHashTable *by_handle, const TcSyncEntry *entry)
+{
+    TcSyncEntry *parent;
+
+    parent = g_hash_table_lookup(by_handle, GUINT_TO_POINTER(_tc_obj_get_parent(entry->obj)));
+    return parent != entry ? parent : NULL;
+}
+
+static guint
+_tc_sync_entry_get_depth(GHashTable *by_handle, TcSyncEntry *entry, guint level)
+{
+    TcSyncEntry *parent;
+
+    if (entry->depth != G_MAXUINT)
+        return entry->depth;
+
+    parent = _tc_sync_entry_get_parent(by_handle, entry);
+    if (!parent || level > 64) {
+        /* the root of the hierarchy (or a loop, which kernel would not allow). */
+        entry->depth = 0;
+    } else
+        entry->depth = _tc_sync_entry_get_depth(by_handle, parent, level + 1) + 1;
+
+    return entry->depth;
+}
+
+static int
+_tc_sync_entry_cmp_depth(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const TcSyncEntry *const *entry_a = a;
+    const TcSyncEntry *const *entry_b = b;
+
+    NM_CMP_DIRECT((*entry_a)->depth, (*entry_b)->depth);
+    /* otherwise, keep the original order. For example, the order of filters matters. */
+    NM_CMP_DIRECT(*entry_a, *entry_b);
+    return 0;
+}
+
+static TcSyncEntry **
+_tc_sync_entries_init(TcSyncEntry *entries, const NMPObject *const *objs, guint len)
+{
+    gs_unref_hashtable GHashTable *by_handle = NULL;
+    TcSyncEntry **                 sorted;
+    guint                          i;
+
+    by_handle = g_hash_table_new(nm_direct_hash, NULL);
+    for (i = 0; i < len; i++) {
+        guint32 handle = _tc_obj_get_handle(objs[i]);
+
+        entries[i] = (TcSyncEntry){
+            .obj   = objs[i],
+            .depth = G_MAXUINT,
+            .state = TC_SYNC_STATE_KEEP,
+        };
+
+        /* filters can't be the parent of something. Also, note that the handle
+         * of a qdisc and the handles of its classes are distinct. */
+        if (handle != 0 && NMP_OBJECT_GET_TYPE(objs[i]) != NMP_OBJECT_TYPE_TFILTER)
+            g_hash_table_insert(by_handle, GUINT_TO_POINTER(handle), &entries[i]);
+    }
+
+    sorted = g_new(TcSyncEntry *, len + 1);
+    for (i = 0; i < len; i++) {
+        entries[i].parent = _tc_sync_entry_get_parent(by_handle, &entries[i]);
+        _tc_sync_entry_get_depth(by_handle, &entries[i], 0);
+        sorted[i] = &entries[i];
+    }
+    sorted[len] = NULL;
+
+    /* parents come before their children. */
+    g_qsort_with_data(sorted, len, sizeof(TcSyncEntry *), _tc_sync_entry_cmp_depth, NULL);
+
+    return sorted;
+}
+
+static gboolean
+_tc_sync_htb_burst_equal(guint64 rate, guint32 known, guint32 plat)
+{
+    guint64 tolerance;
+
+    /* kernel keeps the burst as the time (in scheduler ticks) that it takes
+     * to send that many bytes at the given rate. The conversion back and forth
+     * is not exact. Accept a deviation of about two microseconds worth of data. */
+    if (known == 0)
+        known = NM_PLATFORM_TCLASS_HTB_DEFAULT_BURST;
+    tolerance = (rate / 1000000u) * 2u + 1u;
+    return (known > plat ? known - plat : plat - known) <= tolerance;
+}
+
+static TcSyncState
+_tc_sync_tclass_get_state(const NMPlatformTclass *known, const NMPlatformTclass *plat)
 {
-    gs_unref_ptrarray GPtrArray *plat_qdiscs = NULL;
+    guint64 ceil;
+
+    /* the parent of a class can't be changed in place. */
+    if (known->parent != plat->parent || !nm_streq0(known->kind, plat->kind))
+        return TC_SYNC_STATE_DELETE;
+
+    /* we don't compare the "info" field, for classes kernel reports there the
+     * handle of the leaf qdisc. Also, for other kinds than htb we don't know
+     * about any parameters. */
+    if (!nm_streq0(known->kind, "htb"))
+        return TC_SYNC_STATE_KEEP;
+
+    ceil = known->htb.ceil ?: known->htb.rate;
+
+    if (known->htb.rate != plat->htb.rate || ceil != plat->htb.ceil
+        || known->htb.prio != plat->htb.prio
+        || (known->htb.quantum != 0 && known->htb.quantum != plat->htb.quantum)
+        || !_tc_sync_htb_burst_equal(known->htb.rate, known->htb.burst, plat->htb.burst)
+        || !_tc_sync_htb_burst_equal(ceil, known->htb.cburst, plat->htb.cburst))
+        return TC_SYNC_STATE_UPDATE;
+
+    return TC_SYNC_STATE_KEEP;
+}
+
+static void
+_tc_sync_collect(NMPlatform *  self,
+                 int           ifindex,
+                 NMPObjectType obj_type,
+                 GPtrArray *   known,
+                 GPtrArray *   plat_objs,
+                 GPtrArray *   known_objs)
+{
+    gs_unref_ptrarray GPtrArray *objs = NULL;
     NMPLookup                    lookup;
     guint                        i;
-    gboolean                     success            = TRUE;
-    gs_unref_hashtable GHashTable *known_qdiscs_idx = NULL;
+
+    objs = nm_platform_lookup_clone(self,
+                                    nmp_lookup_init_object(&lookup, obj_type, ifindex),
+                                    NULL,
+                                    NULL);
+    if (objs) {
+        for (i = 0; i < objs->len; i++)
+            g_ptr_array_add(plat_objs, (gpointer) nmp_object_ref(objs->pdata[i]));
+    }
+
+    if (known) {
+        for (i = 0; i < known->len; i++)
+            g_ptr_array_add(known_objs, known->pdata[i]);
+    }
+}
+
+static gboolean
+_tc_sync(NMPlatform *self,
+         int         ifindex,
+         gboolean    sync_qdiscs,
+         GPtrArray * known_qdiscs,
+         gboolean    sync_tclasses,
+         GPtrArray * known_tclasses,
+         gboolean    sync_tfilters,
+         GPtrArray * known_tfilters)
+{
+    gs_unref_ptrarray GPtrArray *plat_objs   = NULL;
+    gs_unref_ptrarray GPtrArray *known_objs  = NULL;
+    gs_unref_hashtable GHashTable *known_idx = NULL;
+    gs_unref_array GArray *changes           = NULL;
+    gs_free TcSyncEntry *plat_entries        = NULL;
+    gs_free TcSyncEntry *known_entries       = NULL;
+    gs_free TcSyncEntry **plat_sorted        = NULL;
+    gs_free TcSyncEntry **known_sorted       = NULL;
+    guint                 n_keep             = 0;
+    guint                 n_delete;
+    guint                 i;
 
     nm_assert(NM_IS_PLATFORM(self));
     nm_assert(ifindex > 0);
 
-    known_qdiscs_idx =
-        g_hash_table_new((GHashFunc) nmp_object_id_hash, (GEqualFunc) nmp_object_id_equal);
-    if (known_qdiscs) {
-        for (i = 0; i < known_qdiscs->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_qdiscs, i);
+    plat_objs  = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    known_objs = g_ptr_array_new();
+    known_idx  = g_hash_table_new((GHashFunc) nmp_object_id_hash, (GEqualFunc) nmp_object_id_equal);
+
+    if (sync_qdiscs)
+        _tc_sync_collect(self, ifindex, NMP_OBJECT_TYPE_QDISC, known_qdiscs, plat_objs, known_objs);
+    if (sync_tclasses) {
+        _tc_sync_collect(self,
+                         ifindex,
+                         NMP_OBJECT_TYPE_TCLASS,
+                         known_tclasses,
+                         plat_objs,
+                         known_objs);
+    }
+    if (sync_tfilters) {
+        _tc_sync_collect(self,
+                         ifindex,
+                         NMP_OBJECT_TYPE_TFILTER,
+                         known_tfilters,
+                         plat_objs,
+                         known_objs);
+    }
 
-            if (!g_hash_table_insert(known_qdiscs_idx, (gpointer) q, (gpointer) q)) {
-                _LOGW("duplicate qdisc %s", nm_platform_qdisc_to_string(&q->qdisc, NULL, 0));
-                return FALSE;
-            }
+    known_entries = g_new(TcSyncEntry, known_objs->len);
+    known_sorted  = _tc_sync_entries_init(known_entries,
+                                         (const NMPObject *const *) known_objs->pdata,
+                                         known_objs->len);
+
+    for (i = 0; i < known_objs->len; i++) {
+        TcSyncEntry *entry = &known_entries[i];
+
+        entry->add = TRUE;
+
+        /* filters from the platform cache don't contain the action. We can't
+         * compare them and always replace all filters. */
+        if (NMP_OBJECT_GET_TYPE(entry->obj) == NMP_OBJECT_TYPE_TFILTER)
+            continue;
+
+        if (!g_hash_table_insert(known_idx, (gpointer) entry->obj, entry)) {
+            _LOGW("duplicate %s %s",
+                  NMP_OBJECT_GET_CLASS(entry->obj)->obj_type_name,
+                  nmp_object_to_string(entry->obj, NMP_OBJECT_TO_STRING_PUBLIC, NULL, 0));
+            return FALSE;
         }
     }
 
-    plat_qdiscs =
-        nm_platform_lookup_clone(self,
-                                 nmp_lookup_init_object(&lookup, NMP_OBJECT_TYPE_QDISC, ifindex),
-                                 NULL,
-                                 NULL);
-    if (plat_qdiscs) {
-        for (i = 0; i < plat_qdiscs->len; i++) {
-            const NMPObject *p = g_ptr_array_index(plat_qdiscs, i);
-            const NMPObject *k;
-
-            /* look up known qdisc with same parent */
-            k = g_hash_table_lookup(known_qdiscs_idx, p);
+    plat_entries = g_new(TcSyncEntry, plat_objs->len);
+    plat_sorted  = _tc_sync_entries_init(plat_entries,
+                                        (const NMPObject *const *) plat_objs->pdata,
+                                        plat_objs->len);
+
+    /* Determine the state of each object from the platform cache. As @plat_sorted
+     * is sorted by depth, the state of the parent is already final. */
+    for (i = 0; i < plat_objs->len; i++) {
+        TcSyncEntry *      entry  = plat_sorted[i];
+        const TcSyncEntry *parent = entry->parent;
+        TcSyncEntry *      known;
+
+        if (parent && NM_IN_SET(parent->state, TC_SYNC_STATE_DELETE, TC_SYNC_STATE_GONE)) {
+            /* Kernel destroys the children of a qdisc along with it, but
+             * refuses to delete a class that still has child classes or filters. */
+            if (parent->state == TC_SYNC_STATE_DELETE
+                && NMP_OBJECT_GET_TYPE(parent->obj) == NMP_OBJECT_TYPE_TCLASS
+                && NMP_OBJECT_GET_TYPE(entry->obj) != NMP_OBJECT_TYPE_QDISC)
+                entry->state = TC_SYNC_STATE_DELETE;
+            else
+                entry->state = TC_SYNC_STATE_GONE;
+        }
 
-            if (k) {
-                const NMPlatformQdisc *qdisc_k = NMP_OBJECT_CAST_QDISC(k);
-                const NMPlatformQdisc *qdisc_p = NMP_OBJECT_CAST_QDISC(p);
+        known        = g_hash_table_lookup(known_idx, entry->obj);
+        entry->known = known;
 
-                /* check other fields */
-                if (nm_platform_qdisc_cmp_full(qdisc_k, qdisc_p, FALSE) != 0
-                    || (qdisc_k->handle != qdisc_p->handle && qdisc_k != 0)) {
-                    k = NULL;
-                }
-            }
+        if (entry->state != TC_SYNC_STATE_KEEP)
+            continue;
 
-            if (k) {
-                g_hash_table_remove(known_qdiscs_idx, k);
-            } else {
-                /* can't delete qdisc with zero handle */
-                if (TC_H_MAJ(p->qdisc.handle) != 0) {
-                    success &= nm_platform_object_delete(self, p);
-                }
+        switch (NMP_OBJECT_GET_TYPE(entry->obj)) {
+        case NMP_OBJECT_TYPE_QDISC:
+        {
+            const NMPlatformQdisc *qdisc_p = NMP_OBJECT_CAST_QDISC(entry->obj);
+            const NMPlatformQdisc *qdisc_k = known ? NMP_OBJECT_CAST_QDISC(known->obj) : NULL;
+
+            if (qdisc_k && nm_platform_qdisc_cmp_full(qdisc_k, qdisc_p, FALSE) == 0
+                && (qdisc_k->handle == qdisc_p->handle || qdisc_k->handle == 0))
+                entry->state = TC_SYNC_STATE_KEEP;
+            else if (TC_H_MAJ(qdisc_p->handle) != 0)
+                entry->state = TC_SYNC_STATE_DELETE;
+            else {
+                /* can't delete qdisc with zero handle. Adding a new qdisc replaces it. */
+                entry->state = TC_SYNC_STATE_GONE;
             }
+            break;
+        }
+        case NMP_OBJECT_TYPE_TCLASS:
+            if (known) {
+                entry->state = _tc_sync_tclass_get_state(NMP_OBJECT_CAST_TCLASS(known->obj),
+                                                         NMP_OBJECT_CAST_TCLASS(entry->obj));
+            } else
+                entry->state = TC_SYNC_STATE_DELETE;
+            break;
+        default:
+            entry->state = TC_SYNC_STATE_DELETE;
+            break;
         }
     }
 
-    if (known_qdiscs) {
-        for (i = 0; i < known_qdiscs->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_qdiscs, i);
+    for (i = 0; i < plat_objs->len; i++) {
+        TcSyncEntry *entry = &plat_entries[i];
 
-            if (g_hash_table_contains(known_qdiscs_idx, q)) {
-                success &=
-                    (nm_platform_qdisc_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_QDISC(q)) >= 0);
-            }
+        if (entry->known && entry->state == TC_SYNC_STATE_KEEP) {
+            entry->known->add = FALSE;
+            n_keep++;
         }
     }
 
-    return success;
-}
+    changes = g_array_new(FALSE, FALSE, sizeof(NMPlatformObjChange));
 
-/*****************************************************************************/
+    /* first delete (children before their parents)... */
+    for (i = plat_objs->len; i > 0; i--) {
+        const TcSyncEntry *entry = plat_sorted[i - 1];
 
-int
-nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfilter *tfilter)
-{
-    int ifindex = tfilter->ifindex;
-    _CHECK_SELF(self, klass, -NME_BUG);
+        if (entry->state == TC_SYNC_STATE_DELETE) {
+            g_array_append_val(changes,
+                               ((NMPlatformObjChange){
+                                   .obj    = entry->obj,
+                                   .delete = TRUE,
+                               }));
+        }
+    }
+    n_delete = changes->len;
+
+    /* ... then add (parents before their children). Classes that exist already
+     * get modified in place. */
+    for (i = 0; i < known_objs->len; i++) {
+        const TcSyncEntry *entry = known_sorted[i];
+
+        if (entry->add) {
+            g_array_append_val(changes,
+                               ((NMPlatformObjChange){
+                                   .obj      = entry->obj,
+                                   .nlmflags = NMP_OBJECT_GET_TYPE(entry->obj)
+                                                       == NMP_OBJECT_TYPE_TCLASS
+                                                   ? NMP_NLM_FLAG_REPLACE
+                                                   : NMP_NLM_FLAG_ADD,
+                               }));
+        }
+    }
 
-    /* Note: @tfilter must not be copied or kept alive because the lifetime of tfilter.kind
-     * and tfilter.action.kind is undefined. */
+    _LOG3D("tc-sync: %u to delete, %u to add, %u unchanged",
+           n_delete,
+           changes->len - n_delete,
+           n_keep);
 
-    _LOG3D("adding or updating a tfilter: %s", nm_platform_tfilter_to_string(tfilter, NULL, 0));
-    return klass->tfilter_add(self, flags, tfilter);
+    return nm_platform_object_apply(self,
+                                    (const NMPlatformObjChange *) changes->data,
+                                    changes->len);
+}
+
+/**
+ * nm_platform_tc_sync:
+ * @self: the #NMPlatform instance
+ * @ifindex: the ifindex where to configure the traffic control objects.
+ * @known_qdiscs: the list of qdiscs (#NMPObject).
+ * @known_tclasses: the list of classes (#NMPObject).
+ * @known_tfilters: the list of tfilters (#NMPObject).
+ *
+ * Compares the qdiscs, classes and filters on the interface with the
+ * requested ones and only sends the differences to kernel. The requests
+ * are ordered so that children are deleted before their parents and
+ * added after them.
+ *
+ * The function promises not to take any reference to the instances
+ * from @known_qdiscs, @known_tclasses or @known_tfilters, nor to keep
+ * them around after the function returns. This is important, because
+ * it allows the caller to pass instances which "kind" string have a
+ * limited lifetime.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_platform_tc_sync(NMPlatform *self,
+                    int         ifindex,
+                    GPtrArray * known_qdiscs,
+                    GPtrArray * known_tclasses,
+                    GPtrArray * known_tfilters)
+{
+    return _tc_sync(self,
+                    ifindex,
+                    TRUE,
+                    known_qdiscs,
+                    TRUE,
+                    known_tclasses,
+                    TRUE,
+                    known_tfilters);
 }
 
 /**
  * nm_platform_qdisc_sync:
  * @self: the #NMPlatform instance
  * @ifindex: the ifindex where to configure the qdiscs.
+ * @known_qdiscs: the list of qdiscs (#NMPObject).
+ *
+ * The function promises not to take any reference to the qdisc
+ * instances from @known_qdiscs, nor to keep them around after
+ * the function returns. This is important, because it allows the
+ * caller to pass NMPlatformQdisc instances which "kind" string
+ * have a limited lifetime.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_platform_qdisc_sync(NMPlatform *self, int ifindex, GPtrArray *known_qdiscs)
+{
+    return _tc_sync(self, ifindex, TRUE, known_qdiscs, FALSE, NULL, FALSE, NULL);
+}
+
+/**
+ * nm_platform_tfilter_sync:
+ * @self: the #NMPlatform instance
+ * @ifindex: the ifindex where to configure the qdiscs.
  * @known_tfilters: the list of tfilters (#NMPObject).
  *
  * The function promises not to take any reference to the tfilter
@@ -5368,51 +5877,7 @@ nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfi
 gboolean
 nm_platform_tfilter_sync(NMPlatform *self, int ifindex, GPtrArray *known_tfilters)
 {
-    gs_unref_ptrarray GPtrArray *plat_tfilters = NULL;
-    NMPLookup                    lookup;
-    guint                        i;
-    gboolean                     success              = TRUE;
-    gs_unref_hashtable GHashTable *known_tfilters_idx = NULL;
-
-    nm_assert(NM_IS_PLATFORM(self));
-    nm_assert(ifindex > 0);
-
-    known_tfilters_idx =
-        g_hash_table_new((GHashFunc) nmp_object_id_hash, (GEqualFunc) nmp_object_id_equal);
-
-    if (known_tfilters) {
-        for (i = 0; i < known_tfilters->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_tfilters, i);
-
-            g_hash_table_insert(known_tfilters_idx, (gpointer) q, (gpointer) q);
-        }
-    }
-
-    plat_tfilters =
-        nm_platform_lookup_clone(self,
-                                 nmp_lookup_init_object(&lookup, NMP_OBJECT_TYPE_TFILTER, ifindex),
-                                 NULL,
-                                 NULL);
-
-    if (plat_tfilters) {
-        for (i = 0; i < plat_tfilters->len; i++) {
-            const NMPObject *q = g_ptr_array_index(plat_tfilters, i);
-
-            if (!g_hash_table_lookup(known_tfilters_idx, q))
-                success &= nm_platform_object_delete(self, q);
-        }
-    }
-
-    if (known_tfilters) {
-        for (i = 0; i < known_tfilters->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_tfilters, i);
-
-            success &=
-                (nm_platform_tfilter_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_TFILTER(q)) >= 0);
-        }
-    }
-
-    return success;
+    return _tc_sync(self, ifindex, FALSE, NULL, FALSE, NULL, TRUE, known_tfilters);
 }
 
 /*****************************************************************************/
@@ -6992,6 +7457,10 @@ nm_platform_qdisc_to_string(const NMPlatformQdisc *qdisc, char *buf, gsize len)
             nm_utils_strbuf_append(&buf, &len, " limit %u", qdisc->tbf.limit);
         if (qdisc->tbf.latency)
             nm_utils_strbuf_append(&buf, &len, " latency %uns", qdisc->tbf.latency);
+    } else if (nm_streq0(qdisc->kind, "htb")) {
+        nm_utils_strbuf_append(&buf, &len, " r2q %u", qdisc->htb.rate2quantum);
+        if (qdisc->htb.defcls)
+            nm_utils_strbuf_append(&buf, &len, " default %x", qdisc->htb.defcls);
     }
 
     return buf0;
@@ -7022,6 +7491,8 @@ nm_platform_qdisc_hash_update(const NMPlatformQdisc *obj, NMHashState *h)
                             obj->sfq.depth);
     } else if (nm_streq0(obj->kind, "tbf")) {
         nm_hash_update_vals(h, obj->tbf.rate, obj->tbf.burst, obj->tbf.limit, obj->tbf.latency);
+    } else if (nm_streq0(obj->kind, "htb")) {
+        nm_hash_update_vals(h, obj->htb.rate2quantum, obj->htb.defcls);
     }
 }
 
@@ -7060,6 +7531,9 @@ nm_platform_qdisc_cmp_full(const NMPlatformQdisc *a,
         NM_CMP_FIELD(a, b, tbf.burst);
         NM_CMP_FIELD(a, b, tbf.limit);
         NM_CMP_FIELD(a, b, tbf.latency);
+    } else if (nm_streq0(a->kind, "htb")) {
+        NM_CMP_FIELD(a, b, htb.rate2quantum);
+        NM_CMP_FIELD(a, b, htb.defcls);
     }
 
     return 0;
@@ -7071,6 +7545,83 @@ nm_platform_qdisc_cmp(const NMPlatformQdisc *a, const NMPlatformQdisc *b)
     return nm_platform_qdisc_cmp_full(a, b, TRUE);
 }
 
+const char *
+nm_platform_tclass_to_string(const NMPlatformTclass *tclass, char *buf, gsize len)
+{
+    char        str_dev[TO_STRING_DEV_BUF_SIZE];
+    const char *buf0;
+
+    if (!nm_utils_to_string_buffer_init_null(tclass, &buf, &len))
+        return buf;
+
+    buf0 = buf;
+
+    nm_utils_strbuf_append(&buf,
+                           &len,
+                           "%s%s family %u handle %x parent %x info %x",
+                           tclass->kind,
+                           _to_string_dev(NULL, tclass->ifindex, str_dev, sizeof(str_dev)),
+                           tclass->addr_family,
+                           tclass->handle,
+                           tclass->parent,
+                           tclass->info);
+
+    if (nm_streq0(tclass->kind, "htb")) {
+        nm_utils_strbuf_append(&buf, &len, " rate %" G_GUINT64_FORMAT, tclass->htb.rate);
+        if (tclass->htb.ceil)
+            nm_utils_strbuf_append(&buf, &len, " ceil %" G_GUINT64_FORMAT, tclass->htb.ceil);
+        if (tclass->htb.burst)
+            nm_utils_strbuf_append(&buf, &len, " burst %u", tclass->htb.burst);
+        if (tclass->htb.cburst)
+            nm_utils_strbuf_append(&buf, &len, " cburst %u", tclass->htb.cburst);
+        if (tclass->htb.quantum)
+            nm_utils_strbuf_append(&buf, &len, " quantum %u", tclass->htb.quantum);
+        if (tclass->htb.prio)
+            nm_utils_strbuf_append(&buf, &len, " prio %u", tclass->htb.prio);
+    }
+
+    return buf0;
+}
+
+void
+nm_platform_tclass_hash_update(const NMPlatformTclass *obj, NMHashState *h)
+{
+    nm_hash_update_str0(h, obj->kind);
+    nm_hash_update_vals(h, obj->ifindex, obj->addr_family, obj->handle, obj->parent, obj->info);
+    if (nm_streq0(obj->kind, "htb")) {
+        nm_hash_update_vals(h,
+                            obj->htb.rate,
+                            obj->htb.ceil,
+                            obj->htb.burst,
+                            obj->htb.cburst,
+                            obj->htb.quantum,
+                            obj->htb.prio);
+    }
+}
+
+int
+nm_platform_tclass_cmp(const NMPlatformTclass *a, const NMPlatformTclass *b)
+{
+    NM_CMP_SELF(a, b);
+    NM_CMP_FIELD(a, b, ifindex);
+    NM_CMP_FIELD(a, b, handle);
+    NM_CMP_FIELD(a, b, parent);
+    NM_CMP_FIELD_STR_INTERNED(a, b, kind);
+    NM_CMP_FIELD(a, b, addr_family);
+    NM_CMP_FIELD(a, b, info);
+
+    if (nm_streq0(a->kind, "htb")) {
+        NM_CMP_FIELD(a, b, htb.rate);
+        NM_CMP_FIELD(a, b, htb.ceil);
+        NM_CMP_FIELD(a, b, htb.burst);
+        NM_CMP_FIELD(a, b, htb.cburst);
+        NM_CMP_FIELD(a, b, htb.quantum);
+        NM_CMP_FIELD(a, b, htb.prio);
+    }
+
+    return 0;
+}
+
 const char *
 nm_platform_tfilter_to_string(const NMPlatformTfilter *tfilter, char *buf, gsize len)
 {
@@ -8661,6 +9212,19 @@ log_qdisc(NMPlatform *               self,
            nm_platform_qdisc_to_string(qdisc, NULL, 0));
 }
 
+static void
+log_tclass(NMPlatform *               self,
+           NMPObjectType              obj_type,
+           int                        ifindex,
+           NMPlatformTclass *         tclass,
+           NMPlatformSignalChangeType change_type,
+           gpointer                   user_data)
+{
+    _LOG3D("signal: tclass %7s: %s",
+           nm_platform_signal_change_type_to_string(change_type),
+           nm_platform_tclass_to_string(tclass, NULL, 0));
+}
+
 static void
 log_tfilter(NMPlatform *               self,
             NMPObjectType              obj_type,
@@ -8965,5 +9529,6 @@ nm_platform_class_init(NMPlatformClass *platform_class)
            NM_PLATFORM_SIGNAL_ROUTING_RULE_CHANGED,
            log_routing_rule);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_QDISC, NM_PLATFORM_SIGNAL_QDISC_CHANGED, log_qdisc);
+    SIGNAL(NM_PLATFORM_SIGNAL_ID_TCLASS, NM_PLATFORM_SIGNAL_TCLASS_CHANGED, log_tclass);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_TFILTER, NM_PLATFORM_SIGNAL_TFILTER_CHANGED, log_tfilter);
 }
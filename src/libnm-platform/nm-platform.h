@@ -37,6 +37,7 @@
 struct _NMPWireGuardPeer;
 
 struct udev_device;
+struct nl_sock;
 
 typedef gboolean (*NMPObjectPredicateFunc)(const NMPObject *obj, gpointer user_data);
 
@@ -264,6 +265,7 @@ typedef enum { /*< skip >*/
                NM_PLATFORM_SIGNAL_ID_IP6_ROUTE,
                NM_PLATFORM_SIGNAL_ID_ROUTING_RULE,
                NM_PLATFORM_SIGNAL_ID_QDISC,
+               NM_PLATFORM_SIGNAL_ID_TCLASS,
                NM_PLATFORM_SIGNAL_ID_TFILTER,
                _NM_PLATFORM_SIGNAL_ID_LAST,
 } NMPlatformSignalIdType;
@@ -697,6 +699,13 @@ typedef struct {
     guint32 latency;
 } NMPlatformQdiscTbf;
 
+typedef struct {
+    /* Beware: zero is not the default, you must always explicitly set
+     * this value (tc(8) uses 10). */
+    guint32 rate2quantum;
+    guint32 defcls;
+} NMPlatformQdiscHtb;
+
 typedef struct {
     __NMPlatformObjWithIfindex_COMMON;
 
@@ -712,9 +721,47 @@ typedef struct {
         NMPlatformQdiscFqCodel fq_codel;
         NMPlatformQdiscSfq     sfq;
         NMPlatformQdiscTbf     tbf;
+        NMPlatformQdiscHtb     htb;
     };
 } NMPlatformQdisc;
 
+/* The burst (in bytes) used for HTB classes that don't specify one. This
+ * matches what tc(8) picks for the default MTU. */
+#define NM_PLATFORM_TCLASS_HTB_DEFAULT_BURST 1600u
+
+typedef struct {
+    /* rate and ceil are in bytes per second. A zero ceil means to
+     * use the rate. */
+    guint64 rate;
+    guint64 ceil;
+
+    /* burst and cburst are in bytes. Zero means to use
+     * NM_PLATFORM_TCLASS_HTB_DEFAULT_BURST. */
+    guint32 burst;
+    guint32 cburst;
+
+    /* Zero means that kernel calculates the quantum from the rate
+     * and the rate2quantum of the qdisc. */
+    guint32 quantum;
+    guint32 prio;
+} NMPlatformTclassHtb;
+
+typedef struct {
+    __NMPlatformObjWithIfindex_COMMON;
+
+    /* beware, kind is embedded in an NMPObject, hence you must
+     * take care of the lifetime of the string. */
+    const char *kind;
+
+    int     addr_family;
+    guint32 handle;
+    guint32 parent;
+    guint32 info;
+    union {
+        NMPlatformTclassHtb htb;
+    };
+} NMPlatformTclass;
+
 typedef struct {
     char sdata[32];
 } NMPlatformActionSimple;
@@ -757,6 +804,17 @@ typedef struct {
 
 #undef __NMPlatformObjWithIfindex_COMMON
 
+typedef struct {
+    /* a routing rule, qdisc, tclass or tfilter object. For deletion, only
+     * the ID fields are relevant. */
+    const NMPObject *obj;
+
+    /* the flags for adding the object. */
+    NMPNlmFlags nlmflags;
+
+    bool delete : 1;
+} NMPlatformObjChange;
+
 typedef struct {
     gboolean      is_ip4;
     NMPObjectType obj_type;
@@ -976,6 +1034,11 @@ typedef enum {
     NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_PRIVATE_KEY = (1LL << 1),
     NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_LISTEN_PORT = (1LL << 2),
     NM_PLATFORM_WIREGUARD_CHANGE_FLAG_HAS_FWMARK      = (1LL << 3),
+
+    /* Compare the requested configuration with the current one and only
+     * send the differences. With REPLACE_PEERS, peers that are not requested
+     * get removed one by one, instead of resetting all peers. */
+    NM_PLATFORM_WIREGUARD_CHANGE_FLAG_SYNC = (1LL << 4),
 } NMPlatformWireGuardChangeFlags;
 
 typedef enum {
@@ -1051,6 +1114,62 @@ nm_platform_kernel_support_get(NMPlatformKernelSupportType type)
 
 /*****************************************************************************/
 
+typedef enum {
+    /* the initial dump and dumps that the platform cache schedules itself,
+     * for example because an event implies that other objects changed too. */
+    NM_PLATFORM_DUMP_REASON_SYNC,
+
+    /* a platform operation synchronously re-fetched a type, because the cache
+     * did not reflect the result of a request yet. */
+    NM_PLATFORM_DUMP_REASON_REQUESTED,
+
+    /* a route event could not be merged into the cache. */
+    NM_PLATFORM_DUMP_REASON_ROUTE_RESYNC,
+
+    /* netlink messages got lost (ENOBUFS or a truncated message). */
+    NM_PLATFORM_DUMP_REASON_OVERFLOW,
+
+    _NM_PLATFORM_DUMP_REASON_NUM,
+} NMPlatformDumpReason;
+
+const char *nm_platform_dump_reason_to_string(NMPlatformDumpReason reason);
+
+/* rtnetlink message types are small numbers. Larger types are counted
+ * together in "nl_msgs_other". */
+#define NM_PLATFORM_NETLINK_STATS_MSG_TYPE_NUM 128
+
+typedef struct {
+    /* received netlink messages from the kernel, indexed by nlmsg_type. */
+    guint64 nl_msgs[NM_PLATFORM_NETLINK_STATS_MSG_TYPE_NUM];
+    guint64 nl_msgs_other;
+
+    /* how often the receive buffer overflowed (ENOBUFS) or a message got truncated. */
+    guint64 nl_overflows;
+
+    /* dump requests that were sent, by reason. */
+    guint64 dumps[_NM_PLATFORM_DUMP_REASON_NUM];
+
+    /* dumps that completed (or failed), and how long the successful ones took. */
+    guint64 dumps_completed;
+    guint64 dumps_failed;
+    guint64 dump_time_total_usec;
+    guint64 dump_time_max_usec;
+} NMPlatformNetlinkStats;
+
+typedef struct {
+    NMPlatformNetlinkStats netlink;
+
+    /* the number of objects of each type in the platform cache, and the
+     * memory they use (not counting attached data like lnk objects). Indexed
+     * by NMPObjectType. */
+    struct {
+        guint n_objs;
+        gsize size;
+    } cache[NMP_OBJECT_TYPE_MAX + 1];
+} NMPlatformStatistics;
+
+/*****************************************************************************/
+
 struct _NMPlatformPrivate;
 
 struct _NMPlatform {
@@ -1080,6 +1199,8 @@ typedef struct {
     void (*refresh_all)(NMPlatform *self, NMPObjectType obj_type);
     void (*process_events)(NMPlatform *self);
 
+    void (*get_netlink_stats)(NMPlatform *self, NMPlatformNetlinkStats *out_stats);
+
     int (*link_add)(NMPlatform *           self,
                     NMLinkType             type,
                     const char *           name,
@@ -1168,6 +1289,8 @@ typedef struct {
                                          const NMPlatformLink **out_link);
     gboolean (*infiniband_partition_delete)(NMPlatform *self, int parent, int p_key);
 
+    struct _NMPUtilsEthtoolNl *(*ethtool_get_nl)(NMPlatform *self);
+
     gboolean (*wifi_get_capabilities)(NMPlatform *               self,
                                       int                        ifindex,
                                       _NMDeviceWifiCapabilities *caps);
@@ -1246,7 +1369,11 @@ typedef struct {
 
     int (*qdisc_add)(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc *qdisc);
 
+    int (*tclass_add)(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTclass *tclass);
+
     int (*tfilter_add)(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfilter *tfilter);
+
+    gboolean (*object_apply)(NMPlatform *self, const NMPlatformObjChange *changes, guint len);
 } NMPlatformClass;
 
 /* NMPlatform signals
@@ -1267,6 +1394,7 @@ typedef struct {
 #define NM_PLATFORM_SIGNAL_IP6_ROUTE_CHANGED    "ip6-route-changed"
 #define NM_PLATFORM_SIGNAL_ROUTING_RULE_CHANGED "routing-rule-changed"
 #define NM_PLATFORM_SIGNAL_QDISC_CHANGED        "qdisc-changed"
+#define NM_PLATFORM_SIGNAL_TCLASS_CHANGED       "tclass-changed"
 #define NM_PLATFORM_SIGNAL_TFILTER_CHANGED      "tfilter-changed"
 
 const char *nm_platform_signal_change_type_to_string(NMPlatformSignalChangeType change_type);
@@ -1815,6 +1943,8 @@ const char *nm_platform_link_get_type_name(NMPlatform *self, int ifindex);
 gboolean nm_platform_link_refresh(NMPlatform *self, int ifindex);
 void     nm_platform_process_events(NMPlatform *self);
 
+void nm_platform_get_statistics(NMPlatform *self, NMPlatformStatistics *out_stats);
+
 const NMPlatformLink *
 nm_platform_process_events_ensure_link(NMPlatform *self, int ifindex, const char *ifname);
 
@@ -2034,6 +2164,8 @@ nm_platform_ip6_address_get(NMPlatform *self, int ifindex, const struct in6_addr
 
 gboolean nm_platform_object_delete(NMPlatform *self, const NMPObject *route);
 
+gboolean nm_platform_object_apply(NMPlatform *self, const NMPlatformObjChange *changes, guint len);
+
 gboolean nm_platform_ip4_address_add(NMPlatform *self,
                                      int         ifindex,
                                      in_addr_t   address,
@@ -2188,9 +2320,17 @@ int nm_platform_routing_rule_add(NMPlatform *                 self,
 int      nm_platform_qdisc_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc *qdisc);
 gboolean nm_platform_qdisc_sync(NMPlatform *self, int ifindex, GPtrArray *known_qdiscs);
 
+int nm_platform_tclass_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTclass *tclass);
+
 int nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfilter *tfilter);
 gboolean nm_platform_tfilter_sync(NMPlatform *self, int ifindex, GPtrArray *known_tfilters);
 
+gboolean nm_platform_tc_sync(NMPlatform *self,
+                             int         ifindex,
+                             GPtrArray * known_qdiscs,
+                             GPtrArray * known_tclasses,
+                             GPtrArray * known_tfilters);
+
 const char *nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len);
 const char *nm_platform_lnk_bridge_to_string(const NMPlatformLnkBridge *lnk, char *buf, gsize len);
 const char *nm_platform_lnk_gre_to_string(const NMPlatformLnkGre *lnk, char *buf, gsize len);
@@ -2217,6 +2357,7 @@ const char *nm_platform_ip6_route_to_string(const NMPlatformIP6Route *route, cha
 const char *
 nm_platform_routing_rule_to_string(const NMPlatformRoutingRule *routing_rule, char *buf, gsize len);
 const char *nm_platform_qdisc_to_string(const NMPlatformQdisc *qdisc, char *buf, gsize len);
+const char *nm_platform_tclass_to_string(const NMPlatformTclass *tclass, char *buf, gsize len);
 const char *nm_platform_tfilter_to_string(const NMPlatformTfilter *tfilter, char *buf, gsize len);
 const char *nm_platform_vf_to_string(const NMPlatformVF *vf, char *buf, gsize len);
 const char *
@@ -2291,6 +2432,7 @@ int nm_platform_qdisc_cmp(const NMPlatformQdisc *a, const NMPlatformQdisc *b);
 int nm_platform_qdisc_cmp_full(const NMPlatformQdisc *a,
                                const NMPlatformQdisc *b,
                                gboolean               compare_handle);
+int nm_platform_tclass_cmp(const NMPlatformTclass *a, const NMPlatformTclass *b);
 int nm_platform_tfilter_cmp(const NMPlatformTfilter *a, const NMPlatformTfilter *b);
 
 void nm_platform_link_hash_update(const NMPlatformLink *obj, NMHashState *h);
@@ -2320,6 +2462,7 @@ void nm_platform_lnk_vxlan_hash_update(const NMPlatformLnkVxlan *obj, NMHashStat
 void nm_platform_lnk_wireguard_hash_update(const NMPlatformLnkWireGuard *obj, NMHashState *h);
 
 void nm_platform_qdisc_hash_update(const NMPlatformQdisc *obj, NMHashState *h);
+void nm_platform_tclass_hash_update(const NMPlatformTclass *obj, NMHashState *h);
 void nm_platform_tfilter_hash_update(const NMPlatformTfilter *obj, NMHashState *h);
 
 #define NM_PLATFORM_LINK_FLAGS2STR_MAX_LEN ((gsize) 162)
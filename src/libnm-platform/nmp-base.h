@@ -128,6 +128,8 @@ typedef enum {
 
     NMP_OBJECT_TYPE_QDISC,
 
+    NMP_OBJECT_TYPE_TCLASS,
+
     NMP_OBJECT_TYPE_TFILTER,
 
     NMP_OBJECT_TYPE_LNK_BRIDGE,
@@ -380,6 +380,7 @@ _idx_obj_part(const DedupMultiIdxType *idx_type,
                        NMP_OBJECT_TYPE_IP4_ROUTE,
                        NMP_OBJECT_TYPE_IP6_ROUTE,
                        NMP_OBJECT_TYPE_QDISC,
+                       NMP_OBJECT_TYPE_TCLASS,
                        NMP_OBJECT_TYPE_TFILTER)
             || !nmp_object_is_visible(obj_a)) {
             if (h)
@@ -489,6 +490,11 @@ static const NMDedupMultiIdxTypeClass _dedup_multi_idx_type_class = {
     .idx_obj_partitionable         = _idx_obj_partitionable,
     .idx_obj_partition_hash_update = _idx_obj_partition_hash_update,
     .idx_obj_partition_equal       = _idx_obj_partition_equal,
+
+    /* the platform cache is large and hashed often. Its objects are configured
+     * by privileged users or by the kernel, so we accept the cheaper hash that
+     * is not hash flooding resistant. */
+    .idx_obj_hash_fast = TRUE,
 };
 
 static void
@@ -1136,6 +1142,8 @@ _vt_cmd_plobj_to_string_id(ip6_address,
 
 _vt_cmd_plobj_to_string_id(qdisc, NMPlatformQdisc, "%d: %d", obj->ifindex, obj->parent);
 
+_vt_cmd_plobj_to_string_id(tclass, NMPlatformTclass, "%d: %d", obj->ifindex, obj->handle);
+
 _vt_cmd_plobj_to_string_id(tfilter, NMPlatformTfilter, "%d: %d", obj->ifindex, obj->parent);
 
 void
@@ -1522,6 +1530,11 @@ _vt_cmd_plobj_id_cmp(qdisc, NMPlatformQdisc, {
     NM_CMP_FIELD(obj1, obj2, parent);
 });
 
+_vt_cmd_plobj_id_cmp(tclass, NMPlatformTclass, {
+    NM_CMP_FIELD(obj1, obj2, ifindex);
+    NM_CMP_FIELD(obj1, obj2, handle);
+});
+
 _vt_cmd_plobj_id_cmp(tfilter, NMPlatformTfilter, {
     NM_CMP_FIELD(obj1, obj2, ifindex);
     NM_CMP_FIELD(obj1, obj2, handle);
@@ -1581,7 +1594,7 @@ nmp_object_id_hash(const NMPObject *obj)
     if (!obj)
         return nm_hash_static(914932607u);
 
-    nm_hash_init(&h, 914932607u);
+    nm_hash_init_fast(&h, 914932607u);
     nmp_object_id_hash_update(obj, &h);
     return nm_hash_complete(&h);
 }
@@ -1632,6 +1645,10 @@ _vt_cmd_plobj_id_hash_update(qdisc, NMPlatformQdisc, {
     nm_hash_update_vals(h, obj->ifindex, obj->parent);
 });
 
+_vt_cmd_plobj_id_hash_update(tclass, NMPlatformTclass, {
+    nm_hash_update_vals(h, obj->ifindex, obj->handle);
+});
+
 _vt_cmd_plobj_id_hash_update(tfilter, NMPlatformTfilter, {
     nm_hash_update_vals(h, obj->ifindex, obj->handle);
 });
@@ -1739,6 +1756,12 @@ _vt_cmd_obj_is_alive_qdisc(const NMPObject *obj)
     return NMP_OBJECT_CAST_QDISC(obj)->ifindex > 0;
 }
 
+static gboolean
+_vt_cmd_obj_is_alive_tclass(const NMPObject *obj)
+{
+    return NMP_OBJECT_CAST_TCLASS(obj)->ifindex > 0;
+}
+
 static gboolean
 _vt_cmd_obj_is_alive_tfilter(const NMPObject *obj)
 {
@@ -1833,6 +1856,7 @@ _vt_dedup_obj_clone(const NMDedupMultiObj *obj)
             (void (*)(const NMDedupMultiObj *obj, NMHashState *h)) nmp_object_hash_update, \
         .obj_full_equal = (gboolean(*)(const NMDedupMultiObj *obj_a,                       \
                                        const NMDedupMultiObj *obj_b)) nmp_object_equal,    \
+        .obj_full_hash_fast = TRUE,                                                        \
     }
 
 /*****************************************************************************/
@@ -2086,6 +2110,7 @@ nmp_lookup_init_obj_type(NMPLookup *lookup, NMPObjectType obj_type)
     case NMP_OBJECT_TYPE_IP6_ROUTE:
     case NMP_OBJECT_TYPE_ROUTING_RULE:
     case NMP_OBJECT_TYPE_QDISC:
+    case NMP_OBJECT_TYPE_TCLASS:
     case NMP_OBJECT_TYPE_TFILTER:
         _nmp_object_stackinit_from_type(&lookup->selector_obj, obj_type);
         lookup->cache_id_type = NMP_CACHE_ID_TYPE_OBJECT_TYPE;
@@ -2124,6 +2149,7 @@ nmp_lookup_init_object(NMPLookup *lookup, NMPObjectType obj_type, int ifindex)
                         NMP_OBJECT_TYPE_IP4_ROUTE,
                         NMP_OBJECT_TYPE_IP6_ROUTE,
                         NMP_OBJECT_TYPE_QDISC,
+                        NMP_OBJECT_TYPE_TCLASS,
                         NMP_OBJECT_TYPE_TFILTER));
 
     if (ifindex <= 0) {
@@ -3233,6 +3259,25 @@ const NMPClass _nmp_classes[NMP_OBJECT_TYPE_MAX] = {
             .cmd_plobj_hash_update    = (CmdPlobjHashUpdateFunc) nm_platform_qdisc_hash_update,
             .cmd_plobj_cmp            = (CmdPlobjCmpFunc) nm_platform_qdisc_cmp,
         },
+    [NMP_OBJECT_TYPE_TCLASS - 1] =
+        {
+            .parent                   = DEDUP_MULTI_OBJ_CLASS_INIT(),
+            .obj_type                 = NMP_OBJECT_TYPE_TCLASS,
+            .sizeof_data              = sizeof(NMPObjectTclass),
+            .sizeof_public            = sizeof(NMPlatformTclass),
+            .obj_type_name            = "tclass",
+            .rtm_gettype              = RTM_GETTCLASS,
+            .signal_type_id           = NM_PLATFORM_SIGNAL_ID_TCLASS,
+            .signal_type              = NM_PLATFORM_SIGNAL_TCLASS_CHANGED,
+            .supported_cache_ids      = _supported_cache_ids_object,
+            .cmd_obj_is_alive         = _vt_cmd_obj_is_alive_tclass,
+            .cmd_plobj_id_cmp         = _vt_cmd_plobj_id_cmp_tclass,
+            .cmd_plobj_id_hash_update = _vt_cmd_plobj_id_hash_update_tclass,
+            .cmd_plobj_to_string_id   = _vt_cmd_plobj_to_string_id_tclass,
+            .cmd_plobj_to_string      = (CmdPlobjToStringFunc) nm_platform_tclass_to_string,
+            .cmd_plobj_hash_update    = (CmdPlobjHashUpdateFunc) nm_platform_tclass_hash_update,
+            .cmd_plobj_cmp            = (CmdPlobjCmpFunc) nm_platform_tclass_cmp,
+        },
     [NMP_OBJECT_TYPE_TFILTER - 1] =
         {
             .parent                   = DEDUP_MULTI_OBJ_CLASS_INIT(),
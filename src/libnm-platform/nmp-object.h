@@ -332,6 +332,10 @@ typedef struct {
     NMPlatformQdisc _public;
 } NMPObjectQdisc;
 
+typedef struct {
+    NMPlatformTclass _public;
+} NMPObjectTclass;
+
 typedef struct {
     NMPlatformTfilter _public;
 } NMPObjectTfilter;
@@ -407,6 +411,8 @@ struct _NMPObject {
 
         NMPlatformQdisc   qdisc;
         NMPObjectQdisc    _qdisc;
+        NMPlatformTclass  tclass;
+        NMPObjectTclass   _tclass;
         NMPlatformTfilter tfilter;
         NMPObjectTfilter  _tfilter;
     };
@@ -490,6 +496,8 @@ _NMP_OBJECT_TYPE_IS_OBJ_WITH_IFINDEX(NMPObjectType obj_type)
 
     case NMP_OBJECT_TYPE_QDISC:
 
+    case NMP_OBJECT_TYPE_TCLASS:
+
     case NMP_OBJECT_TYPE_TFILTER:
 
     case NMP_OBJECT_TYPE_LNK_BRIDGE:
@@ -565,6 +573,7 @@ _NMP_OBJECT_TYPE_IS_OBJ_WITH_IFINDEX(NMPObjectType obj_type)
 #define NMP_OBJECT_CAST_ROUTING_RULE(obj) \
     _NMP_OBJECT_CAST(obj, routing_rule, NMP_OBJECT_TYPE_ROUTING_RULE)
 #define NMP_OBJECT_CAST_QDISC(obj)   _NMP_OBJECT_CAST(obj, qdisc, NMP_OBJECT_TYPE_QDISC)
+#define NMP_OBJECT_CAST_TCLASS(obj)  _NMP_OBJECT_CAST(obj, tclass, NMP_OBJECT_TYPE_TCLASS)
 #define NMP_OBJECT_CAST_TFILTER(obj) _NMP_OBJECT_CAST(obj, tfilter, NMP_OBJECT_TYPE_TFILTER)
 #define NMP_OBJECT_CAST_LNK_WIREGUARD(obj) \
     _NMP_OBJECT_CAST(obj, lnk_wireguard, NMP_OBJECT_TYPE_LNK_WIREGUARD)
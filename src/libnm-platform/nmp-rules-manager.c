@@ -18,7 +18,13 @@ struct _NMPRulesManager {
     GHashTable *by_obj;
     GHashTable *by_user_tag;
     GHashTable *by_data;
-    guint       ref_count;
+
+    /* the RulesObjData that need to be considered by the next sync. Those are
+     * the rules whose tracking changed, and the rules that changed in platform. */
+    CList sync_lst_head;
+
+    gulong platform_signal_id;
+    guint  ref_count;
 };
 
 /*****************************************************************************/
@@ -105,6 +111,7 @@ typedef enum {
 typedef struct {
     const NMPObject *obj;
     CList            obj_lst_head;
+    CList            sync_lst;
 
     /* indicates whether we configured/removed the rule (during sync()). We need that, so
      * if the rule gets untracked, that we know to remove/restore it.
@@ -247,10 +254,18 @@ _rules_obj_destroy(gpointer data)
     RulesObjData *obj_data = data;
 
     c_list_unlink_stale(&obj_data->obj_lst_head);
+    c_list_unlink(&obj_data->sync_lst);
     nmp_object_unref(obj_data->obj);
     g_slice_free(RulesObjData, obj_data);
 }
 
+static void
+_rules_obj_set_sync_pending(NMPRulesManager *self, RulesObjData *obj_data)
+{
+    if (c_list_is_empty(&obj_data->sync_lst))
+        c_list_link_tail(&self->sync_lst_head, &obj_data->sync_lst);
+}
+
 static guint
 _rules_user_tag_hash(gconstpointer data)
 {
@@ -362,6 +377,7 @@ nmp_rules_manager_track(NMPRulesManager *            self,
             *obj_data = (RulesObjData){
                 .obj          = nmp_object_ref(rules_data->obj),
                 .obj_lst_head = C_LIST_INIT(obj_data->obj_lst_head),
+                .sync_lst     = C_LIST_INIT(obj_data->sync_lst),
                 .config_state = CONFIG_STATE_NONE,
             };
             g_hash_table_add(self->by_obj, obj_data);
@@ -403,6 +419,7 @@ nmp_rules_manager_track(NMPRulesManager *            self,
     _rules_data_assert(rules_data, TRUE);
 
     if (changed) {
+        _rules_obj_set_sync_pending(self, g_hash_table_lookup(self->by_obj, &rules_data->obj));
         _LOGD("routing-rule: track [" NM_HASH_OBFUSCATE_PTR_FMT ",%s%u] \"%s\")",
               _USER_TAG_LOG(rules_data->user_tag),
               (rules_data->track_priority_val == 0
@@ -460,6 +477,8 @@ _rules_data_untrack(NMPRulesManager *self,
      * around for the next sync -- so that we can undo what we did earlier. */
     if (obj_data->config_state == CONFIG_STATE_NONE && c_list_length_is(&rules_data->obj_lst, 1))
         g_hash_table_remove(self->by_obj, &rules_data->obj);
+    else
+        _rules_obj_set_sync_pending(self, obj_data);
 
     g_hash_table_remove(self->by_data, rules_data);
 }
@@ -538,17 +557,48 @@ nmp_rules_manager_untrack_all(NMPRulesManager *self,
         g_hash_table_remove(self->by_user_tag, user_tag_data);
 }
 
+static gboolean
+_rules_apply(NMPRulesManager *self, GPtrArray *objs, gboolean delete)
+{
+    gs_free NMPlatformObjChange *changes = NULL;
+    guint                        i;
+
+    if (!objs || objs->len == 0)
+        return TRUE;
+
+    changes = g_new(NMPlatformObjChange, objs->len);
+    for (i = 0; i < objs->len; i++) {
+        changes[i] = (NMPlatformObjChange){
+            .obj      = objs->pdata[i],
+            .nlmflags = delete ? 0 : NMP_NLM_FLAG_ADD,
+            .delete   = delete,
+        };
+    }
+
+    return nm_platform_object_apply(self->platform, changes, objs->len);
+}
+
+/**
+ * nmp_rules_manager_sync:
+ * @self: the #NMPRulesManager instance
+ * @keep_deleted_rules: if %TRUE, don't remove rules that we added
+ *   earlier but are no longer tracked.
+ *
+ * Only the rules whose tracking changed since the last sync, and the
+ * tracked rules that changed in platform, are considered. All deletions
+ * are sent at once, followed by all additions.
+ */
 void
 nmp_rules_manager_sync(NMPRulesManager *self, gboolean keep_deleted_rules)
 {
-    const NMDedupMultiHeadEntry *pl_head_entry;
-    NMDedupMultiIter             pl_iter;
-    const NMPObject *            plobj;
     gs_unref_ptrarray GPtrArray *rules_to_delete = NULL;
+    gs_unref_ptrarray GPtrArray *rules_to_add    = NULL;
+    CList                        sync_lst_head   = C_LIST_INIT(sync_lst_head);
+    const NMPObject *            plobj;
     RulesObjData *               obj_data;
-    GHashTableIter               h_iter;
-    guint                        i;
+    RulesObjData *               obj_data_safe;
     const RulesData *            rd_best;
+    gboolean                     success = TRUE;
 
     g_return_if_fail(NMP_IS_RULES_MANAGER(self));
 
@@ -557,61 +607,56 @@ nmp_rules_manager_sync(NMPRulesManager *self, gboolean keep_deleted_rules)
 
     _LOGD("sync%s", keep_deleted_rules ? " (don't remove any rules)" : "");
 
-    pl_head_entry = nm_platform_lookup_obj_type(self->platform, NMP_OBJECT_TYPE_ROUTING_RULE);
-    if (pl_head_entry) {
-        nmp_cache_iter_for_each (&pl_iter, pl_head_entry, &plobj) {
-            obj_data = g_hash_table_lookup(self->by_obj, &plobj);
+    /* take the pending entries. Changes that happen in platform while we
+     * are syncing (which are mostly our own) don't make them pending again. */
+    c_list_splice(&sync_lst_head, &self->sync_lst_head);
 
-            if (!obj_data) {
-                /* this rule is not tracked. It was externally added, hence we
-                 * ignore it. */
+    c_list_for_each_entry (obj_data, &sync_lst_head, sync_lst) {
+        plobj =
+            nm_platform_lookup_obj(self->platform, NMP_CACHE_ID_TYPE_OBJECT_TYPE, obj_data->obj);
+        if (!plobj)
+            continue;
+
+        rd_best = _rules_obj_get_best_data(obj_data);
+        if (rd_best) {
+            if (rd_best->track_priority_present) {
+                if (obj_data->config_state == CONFIG_STATE_OWNED_BY_US)
+                    obj_data->config_state = CONFIG_STATE_ADDED_BY_US;
                 continue;
             }
-
-            rd_best = _rules_obj_get_best_data(obj_data);
-            if (rd_best) {
-                if (rd_best->track_priority_present) {
-                    if (obj_data->config_state == CONFIG_STATE_OWNED_BY_US)
-                        obj_data->config_state = CONFIG_STATE_ADDED_BY_US;
-                    continue;
-                }
-                if (rd_best->track_priority_val == 0) {
-                    if (!NM_IN_SET(obj_data->config_state,
-                                   CONFIG_STATE_ADDED_BY_US,
-                                   CONFIG_STATE_OWNED_BY_US)) {
-                        obj_data->config_state = CONFIG_STATE_NONE;
-                        continue;
-                    }
+            if (rd_best->track_priority_val == 0) {
+                if (!NM_IN_SET(obj_data->config_state,
+                               CONFIG_STATE_ADDED_BY_US,
+                               CONFIG_STATE_OWNED_BY_US)) {
                     obj_data->config_state = CONFIG_STATE_NONE;
+                    continue;
                 }
+                obj_data->config_state = CONFIG_STATE_NONE;
             }
+        }
 
-            if (keep_deleted_rules) {
-                _LOGD("forget/leak rule added by us: %s",
-                      nmp_object_to_string(plobj, NMP_OBJECT_TO_STRING_PUBLIC, NULL, 0));
-                continue;
-            }
+        if (keep_deleted_rules) {
+            _LOGD("forget/leak rule added by us: %s",
+                  nmp_object_to_string(plobj, NMP_OBJECT_TO_STRING_PUBLIC, NULL, 0));
+            continue;
+        }
 
-            if (!rules_to_delete)
-                rules_to_delete = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+        if (!rules_to_delete)
+            rules_to_delete = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
 
-            g_ptr_array_add(rules_to_delete, (gpointer) nmp_object_ref(plobj));
+        g_ptr_array_add(rules_to_delete, (gpointer) nmp_object_ref(plobj));
 
-            obj_data->config_state = CONFIG_STATE_REMOVED_BY_US;
-        }
+        obj_data->config_state = CONFIG_STATE_REMOVED_BY_US;
     }
 
-    if (rules_to_delete) {
-        for (i = 0; i < rules_to_delete->len; i++)
-            nm_platform_object_delete(self->platform, rules_to_delete->pdata[i]);
-    }
+    if (!_rules_apply(self, rules_to_delete, TRUE))
+        success = FALSE;
 
-    g_hash_table_iter_init(&h_iter, self->by_obj);
-    while (g_hash_table_iter_next(&h_iter, (gpointer *) &obj_data, NULL)) {
+    c_list_for_each_entry_safe (obj_data, obj_data_safe, &sync_lst_head, sync_lst) {
         rd_best = _rules_obj_get_best_data(obj_data);
 
         if (!rd_best) {
-            g_hash_table_iter_remove(&h_iter);
+            g_hash_table_remove(self->by_obj, obj_data);
             continue;
         }
 
@@ -635,10 +680,28 @@ nmp_rules_manager_sync(NMPRulesManager *self, gboolean keep_deleted_rules)
         if (plobj)
             continue;
 
+        if (!rules_to_add)
+            rules_to_add = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+
+        g_ptr_array_add(rules_to_add, (gpointer) nmp_object_ref(obj_data->obj));
+
         obj_data->config_state = CONFIG_STATE_ADDED_BY_US;
-        nm_platform_routing_rule_add(self->platform,
-                                     NMP_NLM_FLAG_ADD,
-                                     NMP_OBJECT_CAST_ROUTING_RULE(obj_data->obj));
+    }
+
+    if (!_rules_apply(self, rules_to_add, FALSE))
+        success = FALSE;
+
+    _LOGD("sync: %u rules deleted, %u rules added%s",
+          rules_to_delete ? rules_to_delete->len : 0u,
+          rules_to_add ? rules_to_add->len : 0u,
+          success ? "" : " (with errors)");
+
+    if (!success) {
+        /* retry on the next sync. */
+        c_list_splice(&self->sync_lst_head, &sync_lst_head);
+    } else {
+        c_list_for_each_entry_safe (obj_data, obj_data_safe, &sync_lst_head, sync_lst)
+            c_list_unlink(&obj_data->sync_lst);
     }
 }
 
@@ -768,6 +831,29 @@ _rules_init(NMPRulesManager *self)
 
 /*****************************************************************************/
 
+static void
+_platform_signal_cb(NMPlatform *                 platform,
+                    int                          obj_type_i,
+                    int                          ifindex,
+                    const NMPlatformRoutingRule *routing_rule,
+                    int                          change_type_i,
+                    NMPRulesManager *            self)
+{
+    const NMPObject *obj = NMP_OBJECT_UP_CAST(routing_rule);
+    RulesObjData *   obj_data;
+
+    if (!self->by_obj)
+        return;
+
+    /* only tracked rules are interesting. Untracked rules are ignored by sync
+     * anyway, and get considered once they are tracked. */
+    obj_data = g_hash_table_lookup(self->by_obj, &obj);
+    if (obj_data)
+        _rules_obj_set_sync_pending(self, obj_data);
+}
+
+/*****************************************************************************/
+
 NMPRulesManager *
 nmp_rules_manager_new(NMPlatform *platform)
 {
@@ -777,9 +863,14 @@ nmp_rules_manager_new(NMPlatform *platform)
 
     self  = g_slice_new(NMPRulesManager);
     *self = (NMPRulesManager){
-        .ref_count = 1,
-        .platform  = g_object_ref(platform),
+        .ref_count     = 1,
+        .platform      = g_object_ref(platform),
+        .sync_lst_head = C_LIST_INIT(self->sync_lst_head),
     };
+    self->platform_signal_id = g_signal_connect(platform,
+                                                NM_PLATFORM_SIGNAL_ROUTING_RULE_CHANGED,
+                                                G_CALLBACK(_platform_signal_cb),
+                                                self);
     return self;
 }
 
@@ -799,6 +890,8 @@ nmp_rules_manager_unref(NMPRulesManager *self)
     if (--self->ref_count > 0)
         return;
 
+    nm_clear_g_signal_handler(self->platform, &self->platform_signal_id);
+
     if (self->by_data) {
         g_hash_table_destroy(self->by_user_tag);
         g_hash_table_destroy(self->by_obj);
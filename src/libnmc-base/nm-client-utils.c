@@ -320,22 +320,29 @@ static NM_UTILS_LOOKUP_STR_DEFINE(
     NM_UTILS_LOOKUP_ITEM_IGNORE_OTHER(), );
 
 const char *
-nmc_device_state_to_string_with_external(NMDevice *device)
+nmc_device_state_to_string_with_ac_state_flags(NMDeviceState          state,
+                                               NMActivationStateFlags ac_state_flags)
 {
-    NMActiveConnection *ac;
-    NMDeviceState       state;
-    const char *        s;
-
-    state = nm_device_get_state(device);
+    const char *s;
 
-    if ((ac = nm_device_get_active_connection(device))
-        && NM_FLAGS_HAS(nm_active_connection_get_state_flags(ac), NM_ACTIVATION_STATE_FLAG_EXTERNAL)
+    if (NM_FLAGS_HAS(ac_state_flags, NM_ACTIVATION_STATE_FLAG_EXTERNAL)
         && (s = _device_state_to_string(state)))
         return s;
 
     return nmc_device_state_to_string(state);
 }
 
+const char *
+nmc_device_state_to_string_with_external(NMDevice *device)
+{
+    NMActiveConnection *ac;
+
+    ac = nm_device_get_active_connection(device);
+    return nmc_device_state_to_string_with_ac_state_flags(
+        nm_device_get_state(device),
+        ac ? nm_active_connection_get_state_flags(ac) : NM_ACTIVATION_STATE_FLAG_NONE);
+}
+
 NM_UTILS_LOOKUP_STR_DEFINE(nmc_device_metered_to_string,
                            NMMetered,
                            NM_UTILS_LOOKUP_DEFAULT(N_("unknown")),
@@ -3776,6 +3776,47 @@ _objlist_set_fcn_bridge_vlans(NMSetting * setting,
     return TRUE;
 }
 
+static void
+_objlist_obj_to_str_fcn_tc_config_tclasses(NMMetaAccessorGetType get_type,
+                                           NMSetting *           setting,
+                                           guint                 idx,
+                                           GString *             str)
+{
+    NMTCTclass *  tclass;
+    gs_free char *s = NULL;
+
+    tclass = nm_setting_tc_config_get_tclass(NM_SETTING_TC_CONFIG(setting), idx);
+    s      = nm_utils_tc_tclass_to_str(tclass, NULL);
+    if (s)
+        g_string_append(str, s);
+}
+
+static gboolean
+_objlist_set_fcn_tc_config_tclasses(NMSetting * setting,
+                                    gboolean    do_add,
+                                    const char *value,
+                                    GError **   error)
+{
+    gs_free_error GError *  local                 = NULL;
+    nm_auto_unref_tc_tclass NMTCTclass *tc_tclass = NULL;
+
+    tc_tclass = nm_utils_tc_tclass_from_str(value, &local);
+    if (!tc_tclass) {
+        nm_utils_error_set(
+            error,
+            NM_UTILS_ERROR_INVALID_ARGUMENT,
+            "%s. %s",
+            local->message,
+            _("The valid syntax is: 'classid <handle> parent <handle> <kind> [<attribute>...]'"));
+        return FALSE;
+    }
+    if (do_add)
+        nm_setting_tc_config_add_tclass(NM_SETTING_TC_CONFIG(setting), tc_tclass);
+    else
+        nm_setting_tc_config_remove_tclass_by_value(NM_SETTING_TC_CONFIG(setting), tc_tclass);
+    return TRUE;
+}
+
 static void
 _objlist_obj_to_str_fcn_tc_config_tfilters(NMMetaAccessorGetType get_type,
                                            NMSetting *           setting,
@@ -6859,6 +6900,19 @@ static const NMMetaPropertyInfo *const property_infos_TC_CONFIG[] = {
             ),
         ),
     ),
+    PROPERTY_INFO (NM_SETTING_TC_CONFIG_TCLASSES, DESCRIBE_DOC_NM_SETTING_TC_CONFIG_TCLASSES,
+        .property_type =                &_pt_objlist,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA (
+            PROPERTY_TYP_DATA_SUBTYPE (objlist,
+                .get_num_fcn =          OBJLIST_GET_NUM_FCN         (NMSettingTCConfig, nm_setting_tc_config_get_num_tclasses),
+                .clear_all_fcn =        OBJLIST_CLEAR_ALL_FCN       (NMSettingTCConfig, nm_setting_tc_config_clear_tclasses),
+                .obj_to_str_fcn =       _objlist_obj_to_str_fcn_tc_config_tclasses,
+                .set_fcn =              _objlist_set_fcn_tc_config_tclasses,
+                .remove_by_idx_fcn_u =  OBJLIST_REMOVE_BY_IDX_FCN_U (NMSettingTCConfig, nm_setting_tc_config_remove_tclass),
+                .strsplit_plain =       TRUE,
+            ),
+        ),
+    ),
     PROPERTY_INFO (NM_SETTING_TC_CONFIG_TFILTERS, DESCRIBE_DOC_NM_SETTING_TC_CONFIG_TFILTERS,
         .property_type =                &_pt_objlist,
         .property_typ_data = DEFINE_PROPERTY_TYP_DATA (
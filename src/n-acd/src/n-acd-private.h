@@ -33,6 +33,7 @@ struct NAcdConfig {
         unsigned int transport;
         uint8_t mac[ETH_ALEN];
         size_t n_mac;
+        NAcdShared *shared;
 };
 
 #define N_ACD_CONFIG_NULL(_x) {                                                 \
@@ -61,14 +62,32 @@ struct NAcdEventNode {
                 .probe_link = C_LIST_INIT((_x).probe_link),                     \
         }
 
+struct NAcdShared {
+        unsigned long n_refs;
+        int fd_epoll;
+        Timer timer;
+        CList pending_list;
+
+        /* flags */
+        bool preempted : 1;
+};
+
+#define N_ACD_SHARED_NULL(_x) {                                                 \
+                .n_refs = 1,                                                    \
+                .fd_epoll = -1,                                                 \
+                .timer = TIMER_NULL((_x).timer),                                \
+                .pending_list = C_LIST_INIT((_x).pending_list),                 \
+        }
+
 struct NAcd {
         unsigned long n_refs;
         unsigned int seed;
-        int fd_epoll;
         int fd_socket;
         CRBTree ip_tree;
         CList event_list;
-        Timer timer;
+        NAcdShared *shared;
+        CList shared_link;
+        void *userdata;
 
         /* BPF map */
         int fd_bpf_map;
@@ -78,18 +97,14 @@ struct NAcd {
         /* configuration */
         int ifindex;
         uint8_t mac[ETH_ALEN];
-
-        /* flags */
-        bool preempted : 1;
 };
 
 #define N_ACD_NULL(_x) {                                                        \
                 .n_refs = 1,                                                    \
-                .fd_epoll = -1,                                                 \
                 .fd_socket = -1,                                                \
                 .ip_tree = C_RBTREE_INIT,                                       \
                 .event_list = C_LIST_INIT((_x).event_list),                     \
-                .timer = TIMER_NULL((_x).timer),                                \
+                .shared_link = C_LIST_INIT((_x).shared_link),                   \
                 .fd_bpf_map = -1,                                               \
         }
 
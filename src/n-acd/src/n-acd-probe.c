@@ -160,7 +160,7 @@ _c_public_ void n_acd_probe_config_set_timeout(NAcdProbeConfig *config, uint64_t
 static void n_acd_probe_schedule(NAcdProbe *probe, uint64_t n_timeout, unsigned int n_jitter) {
         uint64_t n_time;
 
-        timer_now(&probe->acd->timer, &n_time);
+        timer_now(&probe->acd->shared->timer, &n_time);
         n_time += n_timeout;
 
         /*
@@ -176,7 +176,7 @@ static void n_acd_probe_schedule(NAcdProbe *probe, uint64_t n_timeout, unsigned
                 n_time += random % n_jitter;
         }
 
-        timeout_schedule(&probe->timeout, &probe->acd->timer, n_time);
+        timeout_schedule(&probe->timeout, &probe->acd->shared->timer, n_time);
 }
 
 static void n_acd_probe_unschedule(NAcdProbe *probe) {
@@ -522,7 +522,7 @@ int n_acd_probe_handle_packet(NAcdProbe *probe, struct ether_arp *packet, bool h
         uint64_t now;
         int r;
 
-        timer_now(&probe->acd->timer, &now);
+        timer_now(&probe->acd->shared->timer, &now);
 
         switch (probe->state) {
         case N_ACD_PROBE_STATE_PROBING:
@@ -22,6 +22,14 @@
  * context is specific to a linux network device and transport. If multiple
  * network devices are used, then separate `NAcd` contexts must be deployed.
  *
+ * Every `NAcd` context is attached to an `NAcdShared` object, which carries the
+ * epoll-fd and the timer all probes are scheduled on. By default, each context
+ * creates its own private shared object. Callers that run `ACD` on many
+ * interfaces can instead create a single `NAcdShared` object and attach all
+ * their contexts to it via n_acd_config_set_shared(). All those contexts are
+ * then driven through a single file-descriptor and a single timer, and their
+ * events are drained via n_acd_shared_pop_event().
+ *
  * The `NAcdProbe` object drives a single `ACD` state-machine. A probe is
  * created on an `NAcd` context by providing an address to probe for. The probe
  * will then raise notifications whether the address conflict detection found
@@ -68,11 +76,6 @@
 #include "n-acd.h"
 #include "n-acd-private.h"
 
-enum {
-        N_ACD_EPOLL_TIMER,
-        N_ACD_EPOLL_SOCKET,
-};
-
 static int n_acd_get_random(unsigned int *random) {
         uint8_t hash_seed[] = {
                 0x3a, 0x0c, 0xa6, 0xdd, 0x44, 0xef, 0x5f, 0x7a,
@@ -249,6 +252,20 @@ _c_public_ void n_acd_config_set_mac(NAcdConfig *config, const uint8_t *mac, siz
         memcpy(config->mac, mac, n_mac > ETH_ALEN ? ETH_ALEN : n_mac);
 }
 
+/**
+ * n_acd_config_set_shared() - set shared property
+ * @config:                     configuration to operate on
+ * @shared:                     shared context to use, or NULL
+ *
+ * This specifies the shared context a new ACD context is attached to. If
+ * @shared is NULL (the default), the new ACD context creates a private shared
+ * context. The caller retains ownership of @shared, the ACD context acquires
+ * its own reference when created.
+ */
+_c_public_ void n_acd_config_set_shared(NAcdConfig *config, NAcdShared *shared) {
+        config->shared = shared;
+}
+
 int n_acd_event_node_new(NAcdEventNode **nodep) {
         NAcdEventNode *node;
 
@@ -312,6 +329,117 @@ int n_acd_ensure_bpf_map_space(NAcd *acd) {
         return 0;
 }
 
+/**
+ * n_acd_shared_new() - create a new shared ACD context
+ * @sharedp:                    output argument for new shared context object
+ *
+ * Create a new shared context and return it in @sharedp. A shared context
+ * owns the epoll-fd and the timer that drive all ACD contexts attached to it.
+ * It allows running ACD on many network devices with a constant number of
+ * file-descriptors for the event-loop, and a single timer for all probes.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+_c_public_ int n_acd_shared_new(NAcdShared **sharedp) {
+        _c_cleanup_(n_acd_shared_unrefp) NAcdShared *shared = NULL;
+        struct epoll_event eevent;
+        int r;
+
+        shared = malloc(sizeof(*shared));
+        if (!shared)
+                return -ENOMEM;
+
+        *shared = (NAcdShared)N_ACD_SHARED_NULL(*shared);
+
+        shared->fd_epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (shared->fd_epoll < 0)
+                return -c_errno();
+
+        r = timer_init(&shared->timer);
+        if (r < 0)
+                return r;
+
+        /*
+         * The timer is tagged with a NULL pointer, all other entries in the
+         * epoll-set are the packet sockets of the attached ACD contexts.
+         */
+        eevent = (struct epoll_event){
+                .events = EPOLLIN,
+                .data.ptr = NULL,
+        };
+        r = epoll_ctl(shared->fd_epoll, EPOLL_CTL_ADD, shared->timer.fd, &eevent);
+        if (r < 0)
+                return -c_errno();
+
+        *sharedp = shared;
+        shared = NULL;
+        return 0;
+}
+
+static void n_acd_shared_free_internal(NAcdShared *shared) {
+        if (!shared)
+                return;
+
+        c_assert(c_list_is_empty(&shared->pending_list));
+
+        if (shared->timer.fd >= 0) {
+                c_assert(shared->fd_epoll >= 0);
+                epoll_ctl(shared->fd_epoll, EPOLL_CTL_DEL, shared->timer.fd, NULL);
+                timer_deinit(&shared->timer);
+        }
+
+        if (shared->fd_epoll >= 0) {
+                close(shared->fd_epoll);
+                shared->fd_epoll = -1;
+        }
+
+        free(shared);
+}
+
+/**
+ * n_acd_shared_ref() - acquire reference
+ * @shared:                     shared context to operate on, or NULL
+ *
+ * This acquires a single reference to the shared context specified as @shared.
+ * If @shared is NULL, this is a no-op.
+ *
+ * Return: @shared is returned.
+ */
+_c_public_ NAcdShared *n_acd_shared_ref(NAcdShared *shared) {
+        if (shared)
+                ++shared->n_refs;
+        return shared;
+}
+
+/**
+ * n_acd_shared_unref() - release reference
+ * @shared:                     shared context to operate on, or NULL
+ *
+ * This releases a single reference to the shared context @shared. If this is
+ * the last reference, the shared context is torn down and deallocated. Note
+ * that every ACD context attached to @shared holds a reference to it.
+ *
+ * Return: NULL is returned.
+ */
+_c_public_ NAcdShared *n_acd_shared_unref(NAcdShared *shared) {
+        if (shared && !--shared->n_refs)
+                n_acd_shared_free_internal(shared);
+        return NULL;
+}
+
+/**
+ * n_acd_shared_get_fd() - get pollable file descriptor
+ * @shared:                     shared context object to operate on
+ * @fdp:                        output argument for file descriptor
+ *
+ * This returns the backing file-descriptor of the shared context object
+ * @shared. The same rules as for n_acd_get_fd() apply. Whenever the
+ * file-descriptor polls readable, n_acd_shared_dispatch() should be called.
+ */
+_c_public_ void n_acd_shared_get_fd(NAcdShared *shared, int *fdp) {
+        *fdp = shared->fd_epoll;
+}
+
 /**
  * n_acd_new() - create a new ACD context
  * @acdp:                       output argument for new context object
@@ -323,6 +451,10 @@ int n_acd_ensure_bpf_map_space(NAcd *acd) {
  * the selected transport. The configuration is copied into the context. The
  * @config object thus does not have to be retained by the caller.
  *
+ * If @config specifies a shared context, the new context is attached to it and
+ * its probes are driven by n_acd_shared_dispatch(). Otherwise, a private shared
+ * context is created for it.
+ *
  * Return: 0 on success, negative error code on failure.
  */
 _c_public_ int n_acd_new(NAcd **acdp, NAcdConfig *config) {
@@ -349,13 +481,13 @@ _c_public_ int n_acd_new(NAcd **acdp, NAcdConfig *config) {
         if (r)
                 return r;
 
-        acd->fd_epoll = epoll_create1(EPOLL_CLOEXEC);
-        if (acd->fd_epoll < 0)
-                return -c_errno();
-
-        r = timer_init(&acd->timer);
-        if (r < 0)
-                return r;
+        if (config->shared) {
+                acd->shared = n_acd_shared_ref(config->shared);
+        } else {
+                r = n_acd_shared_new(&acd->shared);
+                if (r)
+                        return r;
+        }
 
         acd->max_bpf_map = 8;
 
@@ -373,17 +505,9 @@ _c_public_ int n_acd_new(NAcd **acdp, NAcdConfig *config) {
 
         eevent = (struct epoll_event){
                 .events = EPOLLIN,
-                .data.u32 = N_ACD_EPOLL_TIMER,
+                .data.ptr = acd,
         };
-        r = epoll_ctl(acd->fd_epoll, EPOLL_CTL_ADD, acd->timer.fd, &eevent);
-        if (r < 0)
-                return -c_errno();
-
-        eevent = (struct epoll_event){
-                .events = EPOLLIN,
-                .data.u32 = N_ACD_EPOLL_SOCKET,
-        };
-        r = epoll_ctl(acd->fd_epoll, EPOLL_CTL_ADD, acd->fd_socket, &eevent);
+        r = epoll_ctl(acd->shared->fd_epoll, EPOLL_CTL_ADD, acd->fd_socket, &eevent);
         if (r < 0)
                 return -c_errno();
 
@@ -403,9 +527,11 @@ static void n_acd_free_internal(NAcd *acd) {
 
         c_assert(c_rbtree_is_empty(&acd->ip_tree));
 
+        c_list_unlink(&acd->shared_link);
+
         if (acd->fd_socket >= 0) {
-                c_assert(acd->fd_epoll >= 0);
-                epoll_ctl(acd->fd_epoll, EPOLL_CTL_DEL, acd->fd_socket, NULL);
+                c_assert(acd->shared);
+                epoll_ctl(acd->shared->fd_epoll, EPOLL_CTL_DEL, acd->fd_socket, NULL);
                 close(acd->fd_socket);
                 acd->fd_socket = -1;
         }
@@ -415,16 +541,7 @@ static void n_acd_free_internal(NAcd *acd) {
                 acd->fd_bpf_map = -1;
         }
 
-        if (acd->timer.fd >= 0) {
-                c_assert(acd->fd_epoll >= 0);
-                epoll_ctl(acd->fd_epoll, EPOLL_CTL_DEL, acd->timer.fd, NULL);
-                timer_deinit(&acd->timer);
-        }
-
-        if (acd->fd_epoll >= 0) {
-                close(acd->fd_epoll);
-                acd->fd_epoll = -1;
-        }
+        acd->shared = n_acd_shared_unref(acd->shared);
 
         free(acd);
 }
@@ -459,6 +576,33 @@ _c_public_ NAcd *n_acd_unref(NAcd *acd) {
         return NULL;
 }
 
+/**
+ * n_acd_set_userdata() - set userdata
+ * @acd:                        context to operate on
+ * @userdata:                   userdata pointer
+ *
+ * This can be used to set a caller-controlled user-data pointer on @acd. The
+ * value of the pointer is never inspected or used by `n-acd` and is fully
+ * under control of the caller. It is mostly useful to map contexts returned
+ * by n_acd_shared_pop_event() back to the caller's own state.
+ *
+ * The default value is NULL.
+ */
+_c_public_ void n_acd_set_userdata(NAcd *acd, void *userdata) {
+        acd->userdata = userdata;
+}
+
+/**
+ * n_acd_get_userdata() - get userdata
+ * @acd:                        context to operate on
+ * @userdatap:                  output argument for userdata
+ *
+ * This returns the user-data of @acd. See n_acd_set_userdata() for details.
+ */
+_c_public_ void n_acd_get_userdata(NAcd *acd, void **userdatap) {
+        *userdatap = acd->userdata;
+}
+
 int n_acd_raise(NAcd *acd, NAcdEventNode **nodep, unsigned int event) {
         NAcdEventNode *node;
         int r;
@@ -470,6 +614,9 @@ int n_acd_raise(NAcd *acd, NAcdEventNode **nodep, unsigned int event) {
         node->event.event = event;
         c_list_link_tail(&acd->event_list, &node->acd_link);
 
+        if (!c_list_is_linked(&acd->shared_link))
+                c_list_link_tail(&acd->shared->pending_list, &acd->shared_link);
+
         if (nodep)
                 *nodep = node;
         return 0;
@@ -566,13 +713,15 @@ int n_acd_send(NAcd *acd, const struct in_addr *tpa, const struct in_addr *spa)
  * it. Whenever the file-descriptor polls readable, n_acd_dispatch() should be
  * called.
  *
- * Currently, the file-descriptor is an epoll-fd.
+ * Currently, the file-descriptor is an epoll-fd. It is the file-descriptor of
+ * the shared context @acd is attached to, so it is shared with all other
+ * contexts attached to the same shared context.
  */
 _c_public_ void n_acd_get_fd(NAcd *acd, int *fdp) {
-        *fdp = acd->fd_epoll;
+        *fdp = acd->shared->fd_epoll;
 }
 
-static int n_acd_handle_timeout(NAcd *acd) {
+static int n_acd_handle_timeout(NAcdShared *shared) {
         NAcdProbe *probe;
         uint64_t now;
         int r;
@@ -587,12 +736,12 @@ static int n_acd_handle_timeout(NAcd *acd) {
          * When there are no more timeouts to handle at the given time, we
          * rearm the timer to potentially wake us up again in the future.
          */
-        timer_now(&acd->timer, &now);
+        timer_now(&shared->timer, &now);
 
         for (;;) {
                 Timeout *timeout;
 
-                r = timer_pop_timeout(&acd->timer, now, &timeout);
+                r = timer_pop_timeout(&shared->timer, now, &timeout);
                 if (r < 0) {
                         return r;
                 } else if (!timeout) {
@@ -600,7 +749,7 @@ static int n_acd_handle_timeout(NAcd *acd) {
                          * There are no more timeouts pending before @now. Rearm
                          * the timer to fire again at the next timeout.
                          */
-                        timer_rearm(&acd->timer);
+                        timer_rearm(&shared->timer);
                         break;
                 }
 
@@ -702,7 +851,7 @@ static int n_acd_handle_packet(NAcd *acd, struct ether_arp *packet) {
         return 0;
 }
 
-static int n_acd_dispatch_timer(NAcd *acd, struct epoll_event *event) {
+static int n_acd_dispatch_timer(NAcdShared *shared, struct epoll_event *event) {
         int r;
 
         if (event->events & (EPOLLHUP | EPOLLERR)) {
@@ -715,7 +864,7 @@ static int n_acd_dispatch_timer(NAcd *acd, struct epoll_event *event) {
         }
 
         if (event->events & EPOLLIN) {
-                r = timer_read(&acd->timer);
+                r = timer_read(&shared->timer);
                 if (r <= 0)
                         return r;
 
@@ -727,7 +876,7 @@ static int n_acd_dispatch_timer(NAcd *acd, struct epoll_event *event) {
                  * timeouts, any new ones will be in the future, so not handled
                  * now, but guaranteed to wake us up again when they do trigger.
                  */
-                r = n_acd_handle_timeout(acd);
+                r = n_acd_handle_timeout(shared);
                 if (r)
                         return r;
         }
@@ -852,7 +1001,7 @@ static int n_acd_dispatch_socket(NAcd *acd, struct epoll_event *event) {
                  * preemption, an edge must have triggered and as such we will
                  * handle the event on the next turn.
                  */
-                acd->preempted = true;
+                acd->shared->preempted = true;
         }
 
         for (i = 0; (ssize_t)i < n; ++i) {
@@ -872,57 +1021,81 @@ static int n_acd_dispatch_socket(NAcd *acd, struct epoll_event *event) {
 }
 
 /**
- * n_acd_dispatch() - dispatch context
- * @acd:                        context object to operate on
+ * n_acd_shared_dispatch() - dispatch shared context
+ * @shared:                     shared context object to operate on
  *
  * This dispatches the internal state-machine of all probes and operations
- * running on the context @acd.
+ * running on any context attached to @shared.
  *
  * Any outside effect or event triggered by this dispatcher will be queued on
- * the event-queue of @acd. Whenever the dispatcher returns, the caller is
- * required to drain the event-queue via n_acd_pop_event() until it is empty.
+ * the event-queue of the context it originated on. Whenever the dispatcher
+ * returns, the caller is required to drain all event-queues, either via
+ * n_acd_shared_pop_event() or via n_acd_pop_event() on each attached context.
  *
  * This function dispatches as many events as possible up to a static limit to
  * prevent stalling execution. If the static limit is reached, this function
- * will return with N_ACD_E_PREEMPTED, otherwise 0 is returned. In most cases
- * preemption can be ignored, because level-triggered event notification
- * handles it automatically. However, in case of edge-triggered event
- * mechanisms, the caller must make sure to call the dispatcher again.
+ * will return with N_ACD_E_PREEMPTED, otherwise 0 is returned. See
+ * n_acd_dispatch() for details.
  *
  * Return: 0 on success, N_ACD_E_PREEMPTED on preemption, negative error code
  *         on failure.
  */
-_c_public_ int n_acd_dispatch(NAcd *acd) {
-        struct epoll_event events[2];
+_c_public_ int n_acd_shared_dispatch(NAcdShared *shared) {
+        struct epoll_event events[16];
         int n, i, r = 0;
 
-        n = epoll_wait(acd->fd_epoll, events, sizeof(events) / sizeof(*events), 0);
+        n = epoll_wait(shared->fd_epoll, events, sizeof(events) / sizeof(*events), 0);
         if (n < 0) {
                 /* Linux never returns EINTR if `timeout == 0'. */
                 return -c_errno();
         }
 
-        acd->preempted = false;
+        /*
+         * With many contexts attached, more sockets than fit into a single
+         * batch might be readable. Treat a full batch like a full recvmmsg(2)
+         * batch and tell the caller to call us again.
+         */
+        shared->preempted = (n >= (int)(sizeof(events) / sizeof(*events)));
 
         for (i = 0; i < n; ++i) {
-                switch (events[i].data.u32) {
-                case N_ACD_EPOLL_TIMER:
-                        r = n_acd_dispatch_timer(acd, events + i);
-                        break;
-                case N_ACD_EPOLL_SOCKET:
-                        r = n_acd_dispatch_socket(acd, events + i);
-                        break;
-                default:
-                        c_assert(0);
-                        r = 0;
-                        break;
-                }
+                if (!events[i].data.ptr)
+                        r = n_acd_dispatch_timer(shared, events + i);
+                else
+                        r = n_acd_dispatch_socket(events[i].data.ptr, events + i);
 
                 if (r)
                         return r;
         }
 
-        return acd->preempted ? N_ACD_E_PREEMPTED : 0;
+        return shared->preempted ? N_ACD_E_PREEMPTED : 0;
+}
+
+/**
+ * n_acd_dispatch() - dispatch context
+ * @acd:                        context object to operate on
+ *
+ * This dispatches the internal state-machine of all probes and operations
+ * running on the context @acd. Since the event-loop resources are owned by
+ * the shared context, this dispatches all contexts attached to the same
+ * shared context as @acd. It is equivalent to calling
+ * n_acd_shared_dispatch() on it.
+ *
+ * Any outside effect or event triggered by this dispatcher will be queued on
+ * the event-queue of @acd. Whenever the dispatcher returns, the caller is
+ * required to drain the event-queue via n_acd_pop_event() until it is empty.
+ *
+ * This function dispatches as many events as possible up to a static limit to
+ * prevent stalling execution. If the static limit is reached, this function
+ * will return with N_ACD_E_PREEMPTED, otherwise 0 is returned. In most cases
+ * preemption can be ignored, because level-triggered event notification
+ * handles it automatically. However, in case of edge-triggered event
+ * mechanisms, the caller must make sure to call the dispatcher again.
+ *
+ * Return: 0 on success, N_ACD_E_PREEMPTED on preemption, negative error code
+ *         on failure.
+ */
+_c_public_ int n_acd_dispatch(NAcd *acd) {
+        return n_acd_shared_dispatch(acd->shared);
 }
 
 /**
@@ -994,6 +1167,47 @@ _c_public_ int n_acd_pop_event(NAcd *acd, NAcdEvent **eventp) {
                 return 0;
         }
 
+        c_list_unlink(&acd->shared_link);
+        *eventp = NULL;
+        return 0;
+}
+
+/**
+ * n_acd_shared_pop_event() - get the next pending event of any context
+ * @shared:                     shared context object to operate on
+ * @acdp:                       output argument for the originating context
+ * @eventp:                     output argument for the event
+ *
+ * Returns a pointer to the next pending event of any context attached to
+ * @shared, together with the context it was queued on. This behaves like
+ * calling n_acd_pop_event() on each attached context in turn, but only ever
+ * visits contexts that actually have events queued. The same lifetime rules
+ * as for n_acd_pop_event() apply to the returned event.
+ *
+ * Returns: 0 on success, negative error code on failure. If no event is
+ *          pending on any context, NULL is placed in @acdp and @eventp and 0 is
+ *          returned.
+ */
+_c_public_ int n_acd_shared_pop_event(NAcdShared *shared, NAcd **acdp, NAcdEvent **eventp) {
+        NAcdEvent *event;
+        NAcd *acd;
+        int r;
+
+        while (!c_list_is_empty(&shared->pending_list)) {
+                acd = c_list_first_entry(&shared->pending_list, NAcd, shared_link);
+
+                r = n_acd_pop_event(acd, &event);
+                if (r)
+                        return r;
+
+                if (event) {
+                        *acdp = acd;
+                        *eventp = event;
+                        return 0;
+                }
+        }
+
+        *acdp = NULL;
         *eventp = NULL;
         return 0;
 }
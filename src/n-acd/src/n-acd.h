@@ -22,6 +22,7 @@ typedef struct NAcdConfig NAcdConfig;
 typedef struct NAcdEvent NAcdEvent;
 typedef struct NAcdProbe NAcdProbe;
 typedef struct NAcdProbeConfig NAcdProbeConfig;
+typedef struct NAcdShared NAcdShared;
 
 #define N_ACD_TIMEOUT_RFC5227 (UINT64_C(9000))
 
@@ -79,6 +80,7 @@ NAcdConfig *n_acd_config_free(NAcdConfig *config);
 void n_acd_config_set_ifindex(NAcdConfig *config, int ifindex);
 void n_acd_config_set_transport(NAcdConfig *config, unsigned int transport);
 void n_acd_config_set_mac(NAcdConfig *config, const uint8_t *mac, size_t n_mac);
+void n_acd_config_set_shared(NAcdConfig *config, NAcdShared *shared);
 
 int n_acd_probe_config_new(NAcdProbeConfig **configp);
 NAcdProbeConfig *n_acd_probe_config_free(NAcdProbeConfig *config);
@@ -86,12 +88,25 @@ NAcdProbeConfig *n_acd_probe_config_free(NAcdProbeConfig *config);
 void n_acd_probe_config_set_ip(NAcdProbeConfig *config, struct in_addr ip);
 void n_acd_probe_config_set_timeout(NAcdProbeConfig *config, uint64_t msecs);
 
+/* shared contexts */
+
+int n_acd_shared_new(NAcdShared **sharedp);
+NAcdShared *n_acd_shared_ref(NAcdShared *shared);
+NAcdShared *n_acd_shared_unref(NAcdShared *shared);
+
+void n_acd_shared_get_fd(NAcdShared *shared, int *fdp);
+int n_acd_shared_dispatch(NAcdShared *shared);
+int n_acd_shared_pop_event(NAcdShared *shared, NAcd **acdp, NAcdEvent **eventp);
+
 /* contexts */
 
 int n_acd_new(NAcd **acdp, NAcdConfig *config);
 NAcd *n_acd_ref(NAcd *acd);
 NAcd *n_acd_unref(NAcd *acd);
 
+void n_acd_set_userdata(NAcd *acd, void *userdata);
+void n_acd_get_userdata(NAcd *acd, void **userdatap);
+
 void n_acd_get_fd(NAcd *acd, int *fdp);
 int n_acd_dispatch(NAcd *acd);
 int n_acd_pop_event(NAcd *acd, NAcdEvent **eventp);
@@ -127,6 +142,15 @@ static inline void n_acd_probe_config_freev(NAcdProbeConfig *config) {
         n_acd_probe_config_free(config);
 }
 
+static inline void n_acd_shared_unrefp(NAcdShared **shared) {
+        if (*shared)
+                n_acd_shared_unref(*shared);
+}
+
+static inline void n_acd_shared_unrefv(NAcdShared *shared) {
+        n_acd_shared_unref(shared);
+}
+
 static inline void n_acd_unrefp(NAcd **acd) {
         if (*acd)
                 n_acd_unref(*acd);
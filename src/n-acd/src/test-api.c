@@ -38,6 +38,7 @@ static void test_api_types(void) {
         assert(sizeof(NAcdProbeConfig*));
         assert(sizeof(NAcd*));
         assert(sizeof(NAcdProbe*));
+        assert(sizeof(NAcdShared*));
 }
 
 static void test_api_functions(void) {
@@ -47,14 +48,24 @@ static void test_api_functions(void) {
                 (void *)n_acd_config_set_ifindex,
                 (void *)n_acd_config_set_transport,
                 (void *)n_acd_config_set_mac,
+                (void *)n_acd_config_set_shared,
                 (void *)n_acd_probe_config_new,
                 (void *)n_acd_probe_config_free,
                 (void *)n_acd_probe_config_set_ip,
                 (void *)n_acd_probe_config_set_timeout,
 
+                (void *)n_acd_shared_new,
+                (void *)n_acd_shared_ref,
+                (void *)n_acd_shared_unref,
+                (void *)n_acd_shared_get_fd,
+                (void *)n_acd_shared_dispatch,
+                (void *)n_acd_shared_pop_event,
+
                 (void *)n_acd_new,
                 (void *)n_acd_ref,
                 (void *)n_acd_unref,
+                (void *)n_acd_set_userdata,
+                (void *)n_acd_get_userdata,
                 (void *)n_acd_get_fd,
                 (void *)n_acd_dispatch,
                 (void *)n_acd_pop_event,
@@ -69,6 +80,8 @@ static void test_api_functions(void) {
                 (void *)n_acd_config_freev,
                 (void *)n_acd_probe_config_freep,
                 (void *)n_acd_probe_config_freev,
+                (void *)n_acd_shared_unrefp,
+                (void *)n_acd_shared_unrefv,
                 (void *)n_acd_unrefp,
                 (void *)n_acd_unrefv,
                 (void *)n_acd_probe_freep,
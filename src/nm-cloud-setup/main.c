@@ -264,100 +264,6 @@ _nmc_skip_connection(NMConnection *connection)
     return _nm_utils_ascii_str_to_bool(v, FALSE);
 }
 
-static gboolean
-_nmc_mangle_connection(NMDevice *                            device,
-                       NMConnection *                        connection,
-                       const NMCSProviderGetConfigIfaceData *config_data,
-                       gboolean *                            out_changed)
-{
-    NMSettingIPConfig *s_ip;
-    gsize              i;
-    in_addr_t          gateway;
-    gint64             rt_metric;
-    guint32            rt_table;
-    NMIPRoute *        route_entry;
-    gboolean           addrs_changed        = FALSE;
-    gboolean           rules_changed        = FALSE;
-    gboolean           routes_changed       = FALSE;
-    gs_unref_ptrarray GPtrArray *addrs_new  = NULL;
-    gs_unref_ptrarray GPtrArray *rules_new  = NULL;
-    gs_unref_ptrarray GPtrArray *routes_new = NULL;
-
-    if (!nm_streq0(nm_connection_get_connection_type(connection), NM_SETTING_WIRED_SETTING_NAME))
-        return FALSE;
-
-    s_ip = nm_connection_get_setting_ip4_config(connection);
-    if (!s_ip)
-        return FALSE;
-
-    addrs_new = g_ptr_array_new_full(config_data->ipv4s_len, (GDestroyNotify) nm_ip_address_unref);
-    rules_new =
-        g_ptr_array_new_full(config_data->ipv4s_len, (GDestroyNotify) nm_ip_routing_rule_unref);
-    routes_new = g_ptr_array_new_full(config_data->iproutes_len + !!config_data->ipv4s_len,
-                                      (GDestroyNotify) nm_ip_route_unref);
-
-    if (config_data->has_ipv4s && config_data->has_cidr) {
-        for (i = 0; i < config_data->ipv4s_len; i++) {
-            NMIPAddress *entry;
-
-            entry = nm_ip_address_new_binary(AF_INET,
-                                             &config_data->ipv4s_arr[i],
-                                             config_data->cidr_prefix,
-                                             NULL);
-            if (entry)
-                g_ptr_array_add(addrs_new, entry);
-        }
-
-        gateway = nm_utils_ip4_address_clear_host_address(config_data->cidr_addr,
-                                                          config_data->cidr_prefix);
-        ((guint8 *) &gateway)[3] += 1;
-
-        rt_metric = 10;
-        rt_table  = 30400 + config_data->iface_idx;
-
-        route_entry =
-            nm_ip_route_new_binary(AF_INET, &nm_ip_addr_zero, 0, &gateway, rt_metric, NULL);
-        nm_ip_route_set_attribute(route_entry,
-                                  NM_IP_ROUTE_ATTRIBUTE_TABLE,
-                                  g_variant_new_uint32(rt_table));
-        g_ptr_array_add(routes_new, route_entry);
-
-        for (i = 0; i < config_data->ipv4s_len; i++) {
-            NMIPRoutingRule *entry;
-            char             sbuf[NM_UTILS_INET_ADDRSTRLEN];
-
-            entry = nm_ip_routing_rule_new(AF_INET);
-            nm_ip_routing_rule_set_priority(entry, rt_table);
-            nm_ip_routing_rule_set_from(entry,
-                                        _nm_utils_inet4_ntop(config_data->ipv4s_arr[i], sbuf),
-                                        32);
-            nm_ip_routing_rule_set_table(entry, rt_table);
-
-            nm_assert(nm_ip_routing_rule_validate(entry, NULL));
-
-            g_ptr_array_add(rules_new, entry);
-        }
-    }
-
-    for (i = 0; i < config_data->iproutes_len; ++i)
-        g_ptr_array_add(routes_new, config_data->iproutes_arr[i]);
-
-    addrs_changed = nmcs_setting_ip_replace_ipv4_addresses(s_ip,
-                                                           (NMIPAddress **) addrs_new->pdata,
-                                                           addrs_new->len);
-
-    routes_changed = nmcs_setting_ip_replace_ipv4_routes(s_ip,
-                                                         (NMIPRoute **) routes_new->pdata,
-                                                         routes_new->len);
-
-    rules_changed = nmcs_setting_ip_replace_ipv4_rules(s_ip,
-                                                       (NMIPRoutingRule **) rules_new->pdata,
-                                                       rules_new->len);
-
-    NM_SET_OUT(out_changed, addrs_changed || routes_changed || rules_changed);
-    return TRUE;
-}
-
 /*****************************************************************************/
 
 static guint
@@ -436,7 +342,7 @@ try_again:
         return any_changes;
     }
 
-    if (!_nmc_mangle_connection(device, applied_connection, config_data, &changed)) {
+    if (!nmcs_provider_mangle_connection(config_data, applied_connection, &changed)) {
         _LOGD("config device %s: device has no suitable applied connection. Skip", hwaddr);
         return any_changes;
     }
@@ -511,6 +417,82 @@ _config_all(GCancellable *sigterm_cancellable, NMClient *nmc, GHashTable *config
 
 /*****************************************************************************/
 
+static void
+_wait_interval_cancelled_cb(GCancellable *source, gpointer user_data)
+{
+    g_main_loop_quit(user_data);
+}
+
+static gboolean
+_wait_interval_timeout_cb(gpointer user_data)
+{
+    g_main_loop_quit(user_data);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_wait_interval(GCancellable *sigterm_cancellable, guint interval_sec)
+{
+    nm_auto_unref_gmainloop GMainLoop *main_loop           = g_main_loop_new(NULL, FALSE);
+    nm_auto_destroy_and_unref_gsource GSource *timeout_src = NULL;
+    gulong                                     cancellable_signal_id;
+
+    cancellable_signal_id = g_cancellable_connect(sigterm_cancellable,
+                                                  G_CALLBACK(_wait_interval_cancelled_cb),
+                                                  main_loop,
+                                                  NULL);
+    if (!cancellable_signal_id)
+        return;
+
+    timeout_src = nm_g_source_attach(nm_g_timeout_source_new_seconds(interval_sec,
+                                                                     G_PRIORITY_DEFAULT,
+                                                                     _wait_interval_timeout_cb,
+                                                                     main_loop,
+                                                                     NULL),
+                                     NULL);
+
+    g_main_loop_run(main_loop);
+
+    nm_clear_g_signal_handler(sigterm_cancellable, &cancellable_signal_id);
+}
+
+static void
+_run_periodic(GCancellable *sigterm_cancellable,
+              NMCSProvider *provider,
+              NMClient *    nmc,
+              guint         interval_sec)
+{
+    /* In this mode, we keep the detected provider, the NMClient and the HTTP client
+     * (with its open connections and cached responses) around. Every run still
+     * compares the meta data against the current applied connections, so that
+     * we also repair changes that were done behind our back. Only devices that
+     * actually differ get reapplied. */
+    _LOGD("run every %u seconds", interval_sec);
+
+    while (!g_cancellable_is_cancelled(sigterm_cancellable)) {
+        gs_unref_hashtable GHashTable *config_dict = NULL;
+
+        if (!nm_client_get_nm_running(nmc)) {
+            _LOGD("NetworkManager is not running");
+            goto next;
+        }
+
+        config_dict = _get_config(sigterm_cancellable, provider, nmc);
+        if (!config_dict)
+            goto next;
+
+        if (_config_all(sigterm_cancellable, nmc, config_dict))
+            _LOGI("some changes were applied for provider %s", nmcs_provider_get_name(provider));
+        else
+            _LOGD("no changes were applied for provider %s", nmcs_provider_get_name(provider));
+
+next:
+        _wait_interval(sigterm_cancellable, interval_sec);
+    }
+}
+
+/*****************************************************************************/
+
 static gboolean
 sigterm_handler(gpointer user_data)
 {
@@ -535,6 +517,7 @@ main(int argc, const char *const *argv)
     gs_unref_object NMClient *nmc                             = NULL;
     gs_unref_hashtable GHashTable *config_dict                = NULL;
     gs_free_error GError *error                               = NULL;
+    guint                 interval_sec;
 
     _nm_logging_enabled_init(g_getenv(NMCS_ENV_VARIABLE("NM_CLOUD_SETUP_LOG")));
 
@@ -545,6 +528,13 @@ main(int argc, const char *const *argv)
         return EXIT_FAILURE;
     }
 
+    interval_sec =
+        _nm_utils_ascii_str_to_int64(g_getenv(NMCS_ENV_VARIABLE("NM_CLOUD_SETUP_INTERVAL")),
+                                     10,
+                                     0,
+                                     G_MAXINT32 / 1000,
+                                     0);
+
     sigterm_cancellable = g_cancellable_new();
 
     sigterm_source = nm_g_source_attach(nm_g_unix_signal_source_new(SIGTERM,
@@ -574,6 +564,11 @@ main(int argc, const char *const *argv)
         goto done;
     }
 
+    if (interval_sec > 0) {
+        _run_periodic(sigterm_cancellable, provider, nmc, interval_sec);
+        goto done;
+    }
+
     if (!nm_client_get_nm_running(nmc)) {
         _LOGI("NetworkManager is not running");
         goto done;
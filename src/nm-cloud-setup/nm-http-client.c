@@ -18,6 +18,11 @@ typedef struct {
     CURLM *       mhandle;
     GSource *     mhandle_source_timeout;
     GHashTable *  source_sockets_hashtable;
+
+    /* the last response with an ETag header, per URL. When we have an entry, we
+     * send a conditional request and the server can reply with 304 (Not Modified),
+     * instead of sending the same data again. */
+    GHashTable *etag_cache;
 } NMHttpClientPrivate;
 
 struct _NMHttpClient {
@@ -112,16 +117,48 @@ _get_result_free(gpointer data)
     nm_g_slice_free(get_result);
 }
 
+typedef struct {
+    char *  etag;
+    GBytes *response_data;
+} EtagCacheEntry;
+
+static void
+_etag_cache_entry_free(gpointer data)
+{
+    EtagCacheEntry *entry = data;
+
+    g_free(entry->etag);
+    g_bytes_unref(entry->response_data);
+    nm_g_slice_free(entry);
+}
+
+static GBytes *
+_bytes_dup_with_nul(GBytes *bytes)
+{
+    gconstpointer data;
+    gsize         len;
+    char *        buf;
+
+    data = g_bytes_get_data(bytes, &len);
+    buf  = g_malloc(len + 1);
+    if (len > 0)
+        memcpy(buf, data, len);
+    buf[len] = '\0';
+    return g_bytes_new_take(buf, len);
+}
+
 typedef struct {
     GTask *            task;
     GSource *          timeout_source;
     CURLcode           ehandle_result;
     CURL *             ehandle;
     char *             url;
+    char *             etag;
     NMStrBuf           recv_data;
     struct curl_slist *headers;
     gssize             max_data;
     gulong             cancellable_id;
+    bool               etag_sent : 1;
 } EHandleData;
 
 static void
@@ -148,9 +185,41 @@ _ehandle_free(EHandleData *edata)
     if (edata->headers)
         curl_slist_free_all(edata->headers);
     g_free(edata->url);
+    g_free(edata->etag);
     nm_g_slice_free(edata);
 }
 
+static void
+_etag_cache_update(EHandleData *edata, GetResult *get_result)
+{
+    NMHttpClientPrivate *priv = NM_HTTP_CLIENT_GET_PRIVATE(g_task_get_source_object(edata->task));
+    EtagCacheEntry *     entry;
+
+    if (get_result->response_code == 304 && edata->etag_sent) {
+        entry = g_hash_table_lookup(priv->etag_cache, edata->url);
+        if (entry) {
+            /* the data didn't change. Return the cached response, as if we got it again. */
+            _LOG2D(edata, "not modified (etag %s)", entry->etag);
+            g_bytes_unref(get_result->response_data);
+            get_result->response_code = 200;
+            get_result->response_data = _bytes_dup_with_nul(entry->response_data);
+            return;
+        }
+    }
+
+    if (get_result->response_code != 200 || !edata->etag) {
+        g_hash_table_remove(priv->etag_cache, edata->url);
+        return;
+    }
+
+    entry  = g_slice_new(EtagCacheEntry);
+    *entry = (EtagCacheEntry){
+        .etag          = g_steal_pointer(&edata->etag),
+        .response_data = _bytes_dup_with_nul(get_result->response_data),
+    };
+    g_hash_table_insert(priv->etag_cache, g_strdup(edata->url), entry);
+}
+
 static void
 _ehandle_complete(EHandleData *edata, GError *error_take)
 {
@@ -208,6 +277,8 @@ _ehandle_complete(EHandleData *edata, GError *error_take)
         .response_data = nm_str_buf_finalize_to_gbytes(&edata->recv_data),
     };
 
+    _etag_cache_update(edata, get_result);
+
     g_task_return_pointer(edata->task, get_result, _get_result_free);
 
     _ehandle_free(edata);
@@ -215,6 +286,23 @@ _ehandle_complete(EHandleData *edata, GError *error_take)
 
 /*****************************************************************************/
 
+static size_t
+_get_headerfunction_cb(char *ptr, size_t size, size_t nmemb, void *user_data)
+{
+    EHandleData *edata = user_data;
+    gsize        len   = size * nmemb;
+
+    if (len > NM_STRLEN("ETag:") && g_ascii_strncasecmp(ptr, "ETag:", NM_STRLEN("ETag:")) == 0) {
+        gs_free char *etag = g_strndup(&ptr[NM_STRLEN("ETag:")], len - NM_STRLEN("ETag:"));
+
+        g_strstrip(etag);
+        g_free(edata->etag);
+        edata->etag = etag[0] ? g_steal_pointer(&etag) : NULL;
+    }
+
+    return len;
+}
+
 static size_t
 _get_writefunction_cb(char *ptr, size_t size, size_t nmemb, void *user_data)
 {
@@ -268,6 +356,7 @@ nm_http_client_get(NMHttpClient *      self,
 {
     NMHttpClientPrivate *priv;
     EHandleData *        edata;
+    EtagCacheEntry *     etag_entry;
     guint                i;
 
     g_return_if_fail(NM_IS_HTTP_CLIENT(self));
@@ -304,8 +393,18 @@ nm_http_client_get(NMHttpClient *      self,
 
     curl_easy_setopt(edata->ehandle, CURLOPT_WRITEFUNCTION, _get_writefunction_cb);
     curl_easy_setopt(edata->ehandle, CURLOPT_WRITEDATA, edata);
+    curl_easy_setopt(edata->ehandle, CURLOPT_HEADERFUNCTION, _get_headerfunction_cb);
+    curl_easy_setopt(edata->ehandle, CURLOPT_HEADERDATA, edata);
     curl_easy_setopt(edata->ehandle, CURLOPT_PRIVATE, edata);
 
+    etag_entry = g_hash_table_lookup(priv->etag_cache, url);
+    if (etag_entry) {
+        gs_free char *h = g_strdup_printf("If-None-Match: %s", etag_entry->etag);
+
+        edata->headers   = curl_slist_append(edata->headers, h);
+        edata->etag_sent = !!edata->headers;
+    }
+
     if (http_headers) {
         for (i = 0; http_headers[i]; ++i) {
             struct curl_slist *tmp;
@@ -318,9 +417,10 @@ nm_http_client_get(NMHttpClient *      self,
             }
             edata->headers = tmp;
         }
+    }
 
+    if (edata->headers)
         curl_easy_setopt(edata->ehandle, CURLOPT_HTTPHEADER, edata->headers);
-    }
 
     if (timeout_msec > 0) {
         edata->timeout_source = _source_attach(self,
@@ -732,6 +832,8 @@ nm_http_client_init(NMHttpClient *self)
                               NULL,
                               NULL,
                               (GDestroyNotify) nm_g_source_destroy_and_unref);
+    priv->etag_cache =
+        g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, _etag_cache_entry_free);
 }
 
 static void
@@ -769,6 +871,7 @@ dispose(GObject *object)
 
     nm_clear_pointer(&priv->mhandle, curl_multi_cleanup);
     nm_clear_pointer(&priv->source_sockets_hashtable, g_hash_table_unref);
+    nm_clear_pointer(&priv->etag_cache, g_hash_table_unref);
 
     nm_clear_g_source_inst(&priv->mhandle_source_timeout);
 
@@ -41,6 +41,10 @@ nmcs_provider_get_config_iface_data_is_valid(const NMCSProviderGetConfigIfaceDat
 
 NMCSProviderGetConfigIfaceData *nmcs_provider_get_config_iface_data_new(gboolean was_requested);
 
+gboolean nmcs_provider_mangle_connection(const NMCSProviderGetConfigIfaceData *config_data,
+                                         NMConnection *                        connection,
+                                         gboolean *                            out_changed);
+
 typedef struct {
     GTask *task;
 
@@ -3,6 +3,8 @@
 #include "libnm-client-aux-extern/nm-default-client.h"
 
 #include "nm-cloud-setup/nm-cloud-setup-utils.h"
+#include "nm-cloud-setup/nm-http-client.h"
+#include "nm-cloud-setup/nmcs-provider.h"
 #include "libnm-core-aux-intern/nm-libnm-core-utils.h"
 
 #include "libnm-glib-aux/nm-test-utils.h"
@@ -104,6 +106,137 @@ test_replace_ipv4_addresses(void)
 
 /*****************************************************************************/
 
+static void
+test_mangle_connection(void)
+{
+    const in_addr_t ipv4s[] = {
+        nmtst_inet4_from_string("172.16.5.4"),
+        nmtst_inet4_from_string("172.16.5.5"),
+    };
+    NMCSProviderGetConfigIfaceData config_data = {
+        .ipv4s_arr   = (in_addr_t *) ipv4s,
+        .ipv4s_len   = G_N_ELEMENTS(ipv4s),
+        .iface_idx   = 1,
+        .cidr_addr   = nmtst_inet4_from_string("172.16.0.0"),
+        .cidr_prefix = 16,
+        .has_ipv4s   = TRUE,
+        .has_cidr    = TRUE,
+    };
+    gs_unref_object NMConnection *connection = NULL;
+    NMSettingIPConfig *           s_ip;
+    gboolean                      changed;
+
+    connection =
+        nmtst_create_minimal_connection("test", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+
+    g_assert(!nmcs_provider_mangle_connection(&config_data, connection, &changed));
+
+    s_ip = NM_SETTING_IP_CONFIG(nm_setting_ip4_config_new());
+    g_object_set(s_ip, NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_AUTO, NULL);
+    nm_connection_add_setting(connection, NM_SETTING(s_ip));
+
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(changed);
+    g_assert_cmpint(nm_setting_ip_config_get_num_addresses(s_ip), ==, 2);
+    g_assert_cmpint(nm_setting_ip_config_get_num_routes(s_ip), ==, 1);
+    g_assert_cmpint(nm_setting_ip_config_get_num_routing_rules(s_ip), ==, 2);
+
+    /* The applied connection is up to date, there is nothing to reapply. */
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(!changed);
+
+    /* Somebody removed an address and the route from the applied connection,
+     * although the meta data did not change. They must be restored. */
+    nm_setting_ip_config_remove_address(s_ip, 0);
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(changed);
+    g_assert_cmpint(nm_setting_ip_config_get_num_addresses(s_ip), ==, 2);
+
+    nm_setting_ip_config_clear_routes(s_ip);
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(changed);
+    g_assert_cmpint(nm_setting_ip_config_get_num_routes(s_ip), ==, 1);
+
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(!changed);
+
+    /* The meta data changed. */
+    config_data.ipv4s_len = 1;
+    g_assert(nmcs_provider_mangle_connection(&config_data, connection, &changed));
+    g_assert(changed);
+    g_assert_cmpint(nm_setting_ip_config_get_num_addresses(s_ip), ==, 1);
+    g_assert_cmpint(nm_setting_ip_config_get_num_routing_rules(s_ip), ==, 1);
+}
+
+/*****************************************************************************/
+
+#define FAKE_SERVER_ETAG "\"meta-data-v1\""
+#define FAKE_SERVER_DATA "10.0.0.5\n"
+
+typedef struct {
+    GBytes *response_data;
+    long    response_code;
+    bool    done : 1;
+} HttpGetData;
+
+static void
+_http_get_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    HttpGetData *data           = user_data;
+    gs_free_error GError *error = NULL;
+
+    nm_http_client_get_finish(NM_HTTP_CLIENT(source),
+                              result,
+                              &data->response_code,
+                              &data->response_data,
+                              &error);
+    g_assert_no_error(error);
+    data->done = TRUE;
+}
+
+static void
+test_http_etag(void)
+{
+    gs_unref_object NMHttpClient *http_client = NULL;
+    gs_free char *                url         = NULL;
+    NMTstHttpServer               server;
+    int                           i;
+
+    nmtst_http_server_start(&server, FAKE_SERVER_DATA, FAKE_SERVER_ETAG);
+    url = g_strdup_printf("http://127.0.0.1:%d/latest/meta-data/local-ipv4", server.port);
+
+    http_client = nm_http_client_new();
+
+    for (i = 0; i < 3; i++) {
+        HttpGetData data = {
+            .response_code = -1,
+        };
+        const char *str;
+        gsize       len;
+
+        nm_http_client_get(http_client, url, 5000, 1024, NULL, NULL, _http_get_cb, &data);
+        nmtst_main_context_iterate_until_assert(NULL, 5000, data.done);
+
+        /* the client hides the 304 response and returns the cached data. */
+        g_assert_cmpint(data.response_code, ==, 200);
+        g_assert(data.response_data);
+        str = g_bytes_get_data(data.response_data, &len);
+        g_assert_cmpmem(str, len, FAKE_SERVER_DATA, NM_STRLEN(FAKE_SERVER_DATA));
+        g_assert_cmpint(str[len], ==, '\0');
+        g_bytes_unref(data.response_data);
+    }
+
+    g_clear_object(&http_client);
+
+    nmtst_http_server_stop(&server);
+
+    g_assert_cmpint(server.n_requests, ==, 3);
+    g_assert_cmpint(server.n_not_modified, ==, 2);
+    g_assert_cmpint(server.n_connections, ==, 1);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -112,6 +245,8 @@ main(int argc, char **argv)
     nmtst_init(&argc, &argv, TRUE);
 
     g_test_add_func("/cloud-setup/general/replace-ipv4-addresses", test_replace_ipv4_addresses);
+    g_test_add_func("/cloud-setup/general/mangle-connection", test_mangle_connection);
+    g_test_add_func("/cloud-setup/general/http-etag", test_http_etag);
 
     return g_test_run();
 }
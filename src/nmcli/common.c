@@ -15,6 +15,7 @@
 
 #include "libnm-client-aux-extern/nm-libnm-aux.h"
 
+#include "libnm-glib-aux/nm-dbus-aux.h"
 #include "libnmc-base/nm-vpn-helpers.h"
 #include "libnmc-base/nm-client-utils.h"
 #include "libnm-glib-aux/nm-secret-utils.h"
@@ -1249,11 +1250,115 @@ got_client(GObject *source_object, GAsyncResult *res, gpointer user_data)
     nm_g_slice_free(call);
 }
 
+/*****************************************************************************/
+
+static GDBusConnection *
+_light_get_dbus_connection(GError **error)
+{
+    GBusType bus_type = G_BUS_TYPE_SYSTEM;
+
+    /* Like libnm, honor LIBNM_USE_SESSION_BUS so that the light path
+     * talks to the same (test) service as NMClient would. */
+    if (g_getenv("LIBNM_USE_SESSION_BUS"))
+        bus_type = G_BUS_TYPE_SESSION;
+
+    return g_bus_get_sync(bus_type, NULL, error);
+}
+
+/**
+ * nmc_light_call:
+ * @nmc: Client instance
+ * @object_path: the D-Bus object path on the NetworkManager service
+ * @interface_name: the D-Bus interface
+ * @method_name: the method to call
+ * @parameters: (allow-none): the floating parameters for the call
+ * @reply_type: the expected reply type
+ * @error: location for the error
+ *
+ * Synchronously calls a method on NetworkManager without creating an
+ * #NMClient. This is used by the light handlers of commands (see
+ * #NMCCommand.func_light), which only need a few properties and want to
+ * avoid fetching the entire object tree.
+ *
+ * Returns: (transfer full): the reply or %NULL on error.
+ */
+GVariant *
+nmc_light_call(NmCli *             nmc,
+               const char *        object_path,
+               const char *        interface_name,
+               const char *        method_name,
+               GVariant *          parameters,
+               const GVariantType *reply_type,
+               GError **           error)
+{
+    gs_unref_object GDBusConnection *dbus_connection = NULL;
+
+    dbus_connection = _light_get_dbus_connection(error);
+    if (!dbus_connection) {
+        nm_g_variant_unref_floating(parameters);
+        return NULL;
+    }
+
+    return g_dbus_connection_call_sync(dbus_connection,
+                                       NM_DBUS_SERVICE,
+                                       object_path,
+                                       interface_name,
+                                       method_name,
+                                       parameters,
+                                       reply_type,
+                                       G_DBUS_CALL_FLAGS_NO_AUTO_START,
+                                       nmc->timeout == -1 ? -1 : nmc->timeout * 1000,
+                                       NULL,
+                                       error);
+}
+
+/**
+ * nmc_light_get_all:
+ * @nmc: Client instance
+ * @object_path: the D-Bus object path on the NetworkManager service
+ * @interface_name: the D-Bus interface
+ * @error: location for the error
+ *
+ * Fetches all properties of one interface of one object.
+ *
+ * Returns: (transfer full): the properties as "a{sv}" or %NULL on error.
+ */
+GVariant *
+nmc_light_get_all(NmCli *nmc, const char *object_path, const char *interface_name, GError **error)
+{
+    gs_unref_variant GVariant *ret = NULL;
+    GVariant *                 dict;
+
+    ret = nmc_light_call(nmc,
+                         object_path,
+                         DBUS_INTERFACE_PROPERTIES,
+                         "GetAll",
+                         g_variant_new("(s)", interface_name),
+                         G_VARIANT_TYPE("(a{sv})"),
+                         error);
+    if (!ret)
+        return NULL;
+
+    g_variant_get(ret, "(@a{sv})", &dict);
+    return dict;
+}
+
+/*****************************************************************************/
+
 static void
 call_cmd(NmCli *nmc, GTask *task, const NMCCommand *cmd, int argc, const char *const *argv)
 {
     CmdCall *call;
 
+    if (!nmc->client && cmd->func_light && !nmc->complete
+        && cmd->func_light(cmd, nmc, argc, argv)) {
+        /* The command could be served with a few targeted D-Bus calls. We are done
+         * without ever creating an NMClient. */
+        g_task_return_boolean(task, TRUE);
+        g_object_unref(task);
+        return;
+    }
+
     if (nmc->client || !cmd->needs_client) {
         /* Check whether NetworkManager is running */
         if (cmd->needs_nm_running && !nm_client_get_nm_running(nmc->client)) {
@@ -59,6 +59,17 @@ char *nmc_parse_lldp_capabilities(guint value);
 void
 nmc_do_cmd(NmCli *nmc, const NMCCommand cmds[], const char *cmd, int argc, const char *const *argv);
 
+GVariant *nmc_light_call(NmCli *             nmc,
+                         const char *        object_path,
+                         const char *        interface_name,
+                         const char *        method_name,
+                         GVariant *          parameters,
+                         const GVariantType *reply_type,
+                         GError **           error);
+
+GVariant *
+nmc_light_get_all(NmCli *nmc, const char *object_path, const char *interface_name, GError **error);
+
 void nmc_complete_strv(const char *prefix, gssize nargs, const char *const *args);
 
 #define nmc_complete_strings(prefix, ...) \
@@ -443,6 +443,89 @@ const NmcMetaGenericInfo *const
 
 /*****************************************************************************/
 
+static gconstpointer _metagen_device_detail_timing_get_fcn(NMC_META_GENERIC_INFO_GET_FCN_ARGS)
+{
+    NMDevice *   d = target;
+    GVariant *   timing;
+    GVariantIter iter;
+    const char * stage;
+    guint64      timestamp;
+    guint64      first_timestamp = 0;
+    guint64      last_timestamp  = 0;
+    gsize        n;
+    gsize        i;
+    char **      arr;
+
+    NMC_HANDLE_COLOR(NM_META_COLOR_NONE);
+
+    timing = nm_device_get_activation_timing(d);
+    n      = timing ? g_variant_n_children(timing) : 0;
+
+    switch (info->info_type) {
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_DURATION:
+        if (n == 0)
+            return NULL;
+
+        g_variant_get_child(timing, 0, "(&st)", NULL, &first_timestamp);
+
+        /* The activation ends when the device becomes "activated" or "failed". The
+         * steps after that belong to the deactivation. While the device is still
+         * activating, show the time until the last step so far. */
+        for (i = 0; i < n; i++) {
+            g_variant_get_child(timing, i, "(&st)", &stage, &last_timestamp);
+            if (NM_IN_STRSET(stage, "activated", "failed"))
+                break;
+        }
+        timestamp = last_timestamp - first_timestamp;
+        return (*out_to_free = g_strdup_printf("%" G_GUINT64_FORMAT ".%03u ms",
+                                               timestamp / 1000u,
+                                               (guint) (timestamp % 1000u)));
+
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_STAGES:
+        if (!NM_FLAGS_HAS(get_flags, NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV))
+            return NULL;
+
+        arr = g_new(char *, n + 1);
+        i   = 0;
+        if (n > 0) {
+            g_variant_iter_init(&iter, timing);
+            while (g_variant_iter_next(&iter, "(&st)", &stage, &timestamp)) {
+                if (i == 0)
+                    first_timestamp = timestamp;
+                timestamp -= first_timestamp;
+                arr[i++] = g_strdup_printf("%s: +%" G_GUINT64_FORMAT ".%03u ms",
+                                           stage,
+                                           timestamp / 1000u,
+                                           (guint) (timestamp % 1000u));
+            }
+        }
+        arr[i] = NULL;
+
+        NM_SET_OUT(out_is_default, !arr[0]);
+        *out_flags |= NM_META_ACCESSOR_GET_OUT_FLAGS_STRV;
+        *out_to_free = arr;
+        return arr;
+
+    default:
+        break;
+    }
+
+    g_return_val_if_reached(NULL);
+}
+
+const NmcMetaGenericInfo *const
+    metagen_device_detail_timing[_NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_NUM + 1] = {
+#define _METAGEN_DEVICE_DETAIL_TIMING(type, name) \
+    [type] = NMC_META_GENERIC(name,               \
+                              .info_type = type,  \
+                              .get_fcn   = _metagen_device_detail_timing_get_fcn)
+        _METAGEN_DEVICE_DETAIL_TIMING(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_DURATION,
+                                      "DURATION"),
+        _METAGEN_DEVICE_DETAIL_TIMING(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_STAGES, "STAGES"),
+};
+
+/*****************************************************************************/
+
 static gconstpointer _metagen_device_detail_capabilities_get_fcn(NMC_META_GENERIC_INFO_GET_FCN_ARGS)
 {
     NMDevice *           d = target;
@@ -795,6 +878,7 @@ const NmcMetaGenericInfo *const nmc_fields_dev_show_sections[] = {
     NMC_META_GENERIC_WITH_NESTED("VLAN", nmc_fields_dev_show_vlan_prop + 1),        /* 15 */
     NMC_META_GENERIC_WITH_NESTED("BLUETOOTH", nmc_fields_dev_show_bluetooth + 1),   /* 16 */
     NMC_META_GENERIC_WITH_NESTED("CONNECTIONS", metagen_device_detail_connections), /* 17 */
+    NMC_META_GENERIC_WITH_NESTED("TIMING", metagen_device_detail_timing),           /* 18 */
     NULL,
 };
 #define NMC_FIELDS_DEV_SHOW_SECTIONS_COMMON                                 \
@@ -1521,6 +1605,38 @@ print_team_info(NMDevice *device, NmCli *nmc, const char *group_prefix, const ch
     return TRUE;
 }
 
+static void
+show_device_info_main_header(NmCli *nmc, const char *iface)
+{
+    gs_unref_array GArray *out_indices = NULL;
+    gs_free char *         header_name = NULL;
+    gs_free NmcOutputField *row        = NULL;
+    int                     i;
+
+    /* Main header (pretty only) */
+    header_name = construct_header_name(_("Device details"), iface);
+
+    /* Lazy way to retrieve sorted array from 0 to the number of dev fields */
+    out_indices =
+        parse_output_fields(NULL,
+                            (const NMMetaAbstractInfo *const *) metagen_device_detail_general,
+                            FALSE,
+                            NULL,
+                            NULL);
+
+    row = g_new0(NmcOutputField, G_N_ELEMENTS(metagen_device_detail_general));
+    for (i = 0; i < G_N_ELEMENTS(metagen_device_detail_general); i++)
+        row[i].info = (const NMMetaAbstractInfo *) &metagen_device_detail_general[i];
+
+    print_required_fields(&nmc->nmc_config,
+                          &nmc->pager_data,
+                          NMC_OF_FLAG_MAIN_HEADER_ONLY,
+                          out_indices,
+                          header_name,
+                          0,
+                          row);
+}
+
 static gboolean
 show_device_info(NMDevice *device, NmCli *nmc)
 {
@@ -1534,7 +1650,6 @@ show_device_info(NMDevice *device, NmCli *nmc)
     gboolean                         was_output = FALSE;
     NMIPConfig *                     cfg4, *cfg6;
     NMDhcpConfig *                   dhcp4, *dhcp6;
-    const char *                     base_hdr          = _("Device details");
     GPtrArray *                      fields_in_section = NULL;
 
     if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0)
@@ -1557,35 +1672,7 @@ show_device_info(NMDevice *device, NmCli *nmc)
         return FALSE;
     }
 
-    {
-        gs_unref_array GArray *out_indices = NULL;
-        gs_free char *         header_name = NULL;
-        gs_free NmcOutputField *row        = NULL;
-        int                     i;
-
-        /* Main header (pretty only) */
-        header_name = construct_header_name(base_hdr, nm_device_get_iface(device));
-
-        /* Lazy way to retrieve sorted array from 0 to the number of dev fields */
-        out_indices =
-            parse_output_fields(NULL,
-                                (const NMMetaAbstractInfo *const *) metagen_device_detail_general,
-                                FALSE,
-                                NULL,
-                                NULL);
-
-        row = g_new0(NmcOutputField, G_N_ELEMENTS(metagen_device_detail_general));
-        for (i = 0; i < G_N_ELEMENTS(metagen_device_detail_general); i++)
-            row[i].info = (const NMMetaAbstractInfo *) &metagen_device_detail_general[i];
-
-        print_required_fields(&nmc->nmc_config,
-                              &nmc->pager_data,
-                              NMC_OF_FLAG_MAIN_HEADER_ONLY,
-                              out_indices,
-                              header_name,
-                              0,
-                              row);
-    }
+    show_device_info_main_header(nmc, nm_device_get_iface(device));
 
     /* Loop through the required sections and print them. */
     for (k = 0; k < sections_array->len; k++) {
@@ -1863,6 +1950,27 @@ show_device_info(NMDevice *device, NmCli *nmc)
             was_output = TRUE;
             continue;
         }
+
+        if (nmc_fields_dev_show_sections[section_idx]->nested == metagen_device_detail_timing) {
+            GVariant *timing = nm_device_get_activation_timing(device);
+
+            /* Only show the section if the daemon recorded an activation. */
+            if (timing && g_variant_n_children(timing) > 0) {
+                gs_free char *f = section_fld ? g_strdup_printf("TIMING.%s", section_fld) : NULL;
+
+                nmc_print(&nmc->nmc_config,
+                          (gpointer[]){device, NULL},
+                          NULL,
+                          NULL,
+                          NMC_META_GENERIC_GROUP("TIMING",
+                                                 metagen_device_detail_timing,
+                                                 N_("NAME")),
+                          f,
+                          NULL);
+                was_output = TRUE;
+            }
+            continue;
+        }
     }
 
     if (sections_array)
@@ -1942,6 +2050,231 @@ do_devices_status(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
     }
 }
 
+/*****************************************************************************/
+
+typedef struct {
+    const char *dbus_path;
+    GVariant *  device; /* properties of NM_DBUS_INTERFACE_DEVICE */
+    const char *ac_path;
+    GVariant *  ac; /* properties of NM_DBUS_INTERFACE_ACTIVE_CONNECTION or NULL */
+} DeviceLightData;
+
+static const char *
+_device_light_get_str(GVariant *dict, const char *name)
+{
+    const char *s;
+
+    if (!dict || !g_variant_lookup(dict, name, "&s", &s))
+        return NULL;
+
+    /* like libnm, treat empty strings as unset. */
+    return nm_str_not_empty(s);
+}
+
+static void
+_device_light_get_state(const DeviceLightData *data, guint32 *out_state, guint32 *out_reason)
+{
+    *out_state  = NM_DEVICE_STATE_UNKNOWN;
+    *out_reason = NM_DEVICE_STATE_REASON_NONE;
+
+    /* like libnm, prefer "StateReason" which carries both values. */
+    if (!g_variant_lookup(data->device, "StateReason", "(uu)", out_state, out_reason))
+        g_variant_lookup(data->device, "State", "u", out_state);
+}
+
+static gconstpointer _metagen_device_light_general_get_fcn(NMC_META_GENERIC_INFO_GET_FCN_ARGS)
+{
+    const DeviceLightData *data = target;
+    guint32                state;
+    guint32                reason;
+    guint32                u32;
+    const char *           s;
+
+    NMC_HANDLE_COLOR(NM_META_COLOR_NONE);
+
+    switch (info->info_type) {
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_DEVICE:
+        return _device_light_get_str(data->device, "Interface");
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_DBUS_PATH:
+        return data->dbus_path;
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_HWADDR:
+        s = _device_light_get_str(data->device, "HwAddress");
+        return s ?: nmc_meta_generic_get_unknown(get_type);
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_MTU:
+        if (!g_variant_lookup(data->device, "Mtu", "u", &u32))
+            u32 = 0;
+        return (*out_to_free = g_strdup_printf("%u", (guint) u32));
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_STATE:
+        _device_light_get_state(data, &state, &reason);
+        if (!data->ac || !g_variant_lookup(data->ac, "StateFlags", "u", &u32))
+            u32 = NM_ACTIVATION_STATE_FLAG_NONE;
+        return (*out_to_free = nmc_meta_generic_get_enum_with_detail(
+                    NMC_META_GENERIC_GET_ENUM_TYPE_PARENTHESES,
+                    state,
+                    nmc_device_state_to_string_with_ac_state_flags(state, u32),
+                    get_type));
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_REASON:
+        _device_light_get_state(data, &state, &reason);
+        return (*out_to_free = nmc_meta_generic_get_enum_with_detail(
+                    NMC_META_GENERIC_GET_ENUM_TYPE_PARENTHESES,
+                    reason,
+                    nmc_device_reason_to_string(reason),
+                    get_type));
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_UDI:
+        return _device_light_get_str(data->device, "Udi");
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_IP_IFACE:
+        return _device_light_get_str(data->device, "IpInterface");
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CONNECTION:
+        return _device_light_get_str(data->ac, "Id");
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CON_UUID:
+        return _device_light_get_str(data->ac, "Uuid");
+    case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CON_PATH:
+        return data->ac_path;
+    default:
+        break;
+    }
+
+    g_return_val_if_reached(NULL);
+}
+
+/* The subset of metagen_device_detail_general that can be rendered from the
+ * D-Bus properties of the device and its active connection alone. */
+static const NmcMetaGenericInfo *const metagen_device_light_general[] = {
+#define _METAGEN_DEVICE_LIGHT_GENERAL(type, name) \
+    NMC_META_GENERIC(name, .info_type = type, .get_fcn = _metagen_device_light_general_get_fcn)
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_DEVICE, "DEVICE"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_DBUS_PATH,
+                                  "DBUS-PATH"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_HWADDR, "HWADDR"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_MTU, "MTU"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_STATE, "STATE"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_REASON, "REASON"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_UDI, "UDI"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_IP_IFACE,
+                                  "IP-IFACE"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CONNECTION,
+                                  "CONNECTION"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CON_UUID,
+                                  "CON-UUID"),
+    _METAGEN_DEVICE_LIGHT_GENERAL(NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_GENERAL_CON_PATH,
+                                  "CON-PATH"),
+    NULL,
+};
+
+static gboolean
+do_device_show_light(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
+{
+    gs_unref_array GArray *sections_array        = NULL;
+    gs_unref_ptrarray GPtrArray *fields_in_section = NULL;
+    gs_unref_variant GVariant *ret                 = NULL;
+    gs_unref_variant GVariant *device              = NULL;
+    gs_unref_variant GVariant *ac                  = NULL;
+    DeviceLightData            data;
+    const char *               ifname;
+    const char *               dbus_path;
+    const char *               ac_path;
+    gboolean                   real;
+    guint                      k;
+
+    next_arg(nmc, &argc, &argv, NULL);
+
+    /* Only "device show <ifname>" with explicitly selected GENERAL fields is
+     * served without NMClient. Everything else falls back to the full cache. */
+    if (argc != 1 || !nmc->required_fields)
+        return FALSE;
+
+    ifname = argv[0];
+
+    sections_array =
+        parse_output_fields(nmc->required_fields,
+                            (const NMMetaAbstractInfo *const *) nmc_fields_dev_show_sections,
+                            TRUE,
+                            &fields_in_section,
+                            NULL);
+    if (!sections_array)
+        return FALSE;
+
+    for (k = 0; k < sections_array->len; k++) {
+        int                                section_idx = g_array_index(sections_array, int, k);
+        const char *                       section_fld = fields_in_section->pdata[k];
+        gs_free NMMetaSelectionResultList *selection   = NULL;
+
+        if (nmc_fields_dev_show_sections[section_idx]->nested != metagen_device_detail_general
+            || !section_fld)
+            return FALSE;
+
+        selection = nm_meta_selection_create_parse_list(
+            (const NMMetaAbstractInfo *const *) metagen_device_light_general,
+            section_fld,
+            FALSE,
+            NULL);
+        if (!selection)
+            return FALSE;
+    }
+
+    ret = nmc_light_call(nmc,
+                         NM_DBUS_PATH,
+                         NM_DBUS_INTERFACE,
+                         "GetDeviceByIpIface",
+                         g_variant_new("(s)", ifname),
+                         G_VARIANT_TYPE("(o)"),
+                         NULL);
+    if (!ret)
+        return FALSE;
+
+    g_variant_get(ret, "(&o)", &dbus_path);
+
+    device = nmc_light_get_all(nmc, dbus_path, NM_DBUS_INTERFACE_DEVICE, NULL);
+    if (!device)
+        return FALSE;
+
+    /* GetDeviceByIpIface() matches the IP interface, but we select the device by
+     * its interface name. Also, NMClient does not expose unrealized devices. */
+    if (!nm_streq0(_device_light_get_str(device, "Interface"), ifname))
+        return FALSE;
+    if (g_variant_lookup(device, "Real", "b", &real) && !real)
+        return FALSE;
+
+    if (!g_variant_lookup(device, "ActiveConnection", "&o", &ac_path) || nm_streq(ac_path, "/"))
+        ac_path = NULL;
+    else {
+        ac = nmc_light_get_all(nmc, ac_path, NM_DBUS_INTERFACE_ACTIVE_CONNECTION, NULL);
+        if (!ac)
+            return FALSE;
+    }
+
+    data = (DeviceLightData){
+        .dbus_path = dbus_path,
+        .device    = device,
+        .ac_path   = ac_path,
+        .ac        = ac,
+    };
+
+    /* multiline mode is default for 'device show' */
+    if (!nmc->mode_specified)
+        nmc->nmc_config_mutable.multiline_output = TRUE;
+
+    show_device_info_main_header(nmc, ifname);
+
+    for (k = 0; k < sections_array->len; k++) {
+        gs_free char *f = g_strdup_printf("GENERAL.%s", (char *) fields_in_section->pdata[k]);
+
+        if (NM_IN_SET(nmc->nmc_config.print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
+            && !nmc->nmc_config.multiline_output && k > 0)
+            g_print("\n"); /* Print empty line between groups in tabular mode */
+
+        nmc_print(&nmc->nmc_config,
+                  (gpointer[]){&data, NULL},
+                  NULL,
+                  NULL,
+                  NMC_META_GENERIC_GROUP("GENERAL", metagen_device_light_general, N_("NAME")),
+                  f,
+                  NULL);
+    }
+
+    return TRUE;
+}
+
 static void
 do_device_show(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -5021,7 +5354,7 @@ nmc_command_func_device(const NMCCommand *cmd, NmCli *nmc, int argc, const char
 {
     static const NMCCommand cmds[] = {
         {"status", do_devices_status, usage_device_status, TRUE, TRUE},
-        {"show", do_device_show, usage_device_show, TRUE, TRUE},
+        {"show", do_device_show, usage_device_show, TRUE, TRUE, do_device_show_light},
         {"connect", do_device_connect, usage_device_connect, TRUE, TRUE},
         {"reapply", do_device_reapply, usage_device_reapply, TRUE, TRUE},
         {"disconnect", do_devices_disconnect, usage_device_disconnect, TRUE, TRUE},
@@ -283,15 +283,50 @@ static const NmcMetaGenericInfo
 
 /*****************************************************************************/
 
+typedef struct {
+    const char *name;
+    guint64     value;
+} GeneralStatisticsEntry;
+
+static gconstpointer _metagen_general_statistics_get_fcn(NMC_META_GENERIC_INFO_GET_FCN_ARGS)
+{
+    const GeneralStatisticsEntry *entry = target;
+
+    NMC_HANDLE_COLOR(NM_META_COLOR_NONE);
+
+    switch (info->info_type) {
+    case NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_NAME:
+        return entry->name;
+    case NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_VALUE:
+        return (*out_to_free = g_strdup_printf("%" G_GUINT64_FORMAT, entry->value));
+    default:
+        break;
+    }
+
+    g_return_val_if_reached(NULL);
+}
+
+static const NmcMetaGenericInfo
+    *const metagen_general_statistics[_NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_NUM + 1] = {
+#define _METAGEN_GENERAL_STATISTICS(type, name) \
+    [type] =                                    \
+        NMC_META_GENERIC(name, .info_type = type, .get_fcn = _metagen_general_statistics_get_fcn)
+        _METAGEN_GENERAL_STATISTICS(NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_NAME, "NAME"),
+        _METAGEN_GENERAL_STATISTICS(NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_VALUE, "VALUE"),
+};
+
+/*****************************************************************************/
+
 static void
 usage_general(void)
 {
     g_printerr(_("Usage: nmcli general { COMMAND | help }\n\n"
-                 "COMMAND := { status | hostname | permissions | logging }\n\n"
+                 "COMMAND := { status | hostname | permissions | logging | statistics }\n\n"
                  "  status\n\n"
                  "  hostname [<hostname>]\n\n"
                  "  permissions\n\n"
-                 "  logging [level <log level>] [domains <log domains>]\n\n"));
+                 "  logging [level <log level>] [domains <log domains>]\n\n"
+                 "  statistics\n\n"));
 }
 
 static void
@@ -371,6 +406,16 @@ usage_general_logging(void)
                  "for the list of possible logging domains.\n\n"));
 }
 
+static void
+usage_general_statistics(void)
+{
+    g_printerr(_("Usage: nmcli general statistics { help }\n"
+                 "\n"
+                 "Show internal counters of NetworkManager, like the number of netlink\n"
+                 "messages received and the size of the platform cache. These are meant\n"
+                 "for debugging and their names may change between versions.\n\n"));
+}
+
 static void
 usage_networking(void)
 {
@@ -875,6 +920,106 @@ do_general_logging(const NMCCommand *cmd, NmCli *nmc, int argc, const char *cons
     }
 }
 
+static int
+_general_statistics_entry_cmp(gconstpointer a, gconstpointer b)
+{
+    const GeneralStatisticsEntry *entry_a = a;
+    const GeneralStatisticsEntry *entry_b = b;
+
+    return strcmp(entry_a->name, entry_b->name);
+}
+
+static void
+_general_statistics_cb(GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    NmCli *          nmc                    = user_data;
+    gs_unref_variant GVariant *res          = NULL;
+    gs_unref_variant GVariant *dict         = NULL;
+    gs_free GeneralStatisticsEntry *entries = NULL;
+    gs_free gpointer *targets               = NULL;
+    gs_free_error GError *error             = NULL;
+    const char *          fields_str        = NULL;
+    GVariantIter          iter;
+    const char *          name;
+    GVariant *            value;
+    gsize                 n;
+    gsize                 i;
+
+    res = nm_client_dbus_call_finish(NM_CLIENT(object), result, &error);
+    if (!res) {
+        g_dbus_error_strip_remote_error(error);
+        g_string_printf(nmc->return_text,
+                        _("Error: failed to get statistics: %s"),
+                        nmc_error_get_simple_message(error));
+        nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
+        goto out;
+    }
+
+    g_variant_get(res, "(@a{sv})", &dict);
+
+    entries = g_new(GeneralStatisticsEntry, g_variant_n_children(dict));
+    n       = 0;
+    g_variant_iter_init(&iter, dict);
+    while (g_variant_iter_next(&iter, "{&sv}", &name, &value)) {
+        if (g_variant_is_of_type(value, G_VARIANT_TYPE_UINT64)) {
+            entries[n++] = (GeneralStatisticsEntry){
+                .name  = name,
+                .value = g_variant_get_uint64(value),
+            };
+        }
+        g_variant_unref(value);
+    }
+    qsort(entries, n, sizeof(GeneralStatisticsEntry), _general_statistics_entry_cmp);
+
+    targets = g_new(gpointer, n + 1);
+    for (i = 0; i < n; i++)
+        targets[i] = &entries[i];
+    targets[n] = NULL;
+
+    if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0) {
+        /* pass */
+    } else if (g_ascii_strcasecmp(nmc->required_fields, "all") == 0) {
+        /* pass */
+    } else
+        fields_str = nmc->required_fields;
+
+    nm_cli_spawn_pager(&nmc->nmc_config, &nmc->pager_data);
+
+    if (!nmc_print(&nmc->nmc_config,
+                   targets,
+                   NULL,
+                   _("NetworkManager statistics"),
+                   (const NMMetaAbstractInfo *const *) metagen_general_statistics,
+                   fields_str,
+                   &error)) {
+        g_string_printf(nmc->return_text, _("Error: 'general statistics': %s"), error->message);
+        nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+    }
+
+out:
+    quit();
+}
+
+static void
+do_general_statistics(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
+{
+    next_arg(nmc, &argc, &argv, NULL);
+    if (nmc->complete)
+        return;
+
+    nmc->should_wait++;
+    nm_client_dbus_call(nmc->client,
+                        NM_DBUS_PATH,
+                        NM_DBUS_INTERFACE_DEBUG,
+                        "GetStatistics",
+                        NULL,
+                        G_VARIANT_TYPE("(a{sv})"),
+                        -1,
+                        NULL,
+                        _general_statistics_cb,
+                        nmc);
+}
+
 static void
 save_hostname_cb(GObject *object, GAsyncResult *result, gpointer user_data)
 {
@@ -925,6 +1070,7 @@ nmc_command_func_general(const NMCCommand *cmd, NmCli *nmc, int argc, const char
         {"hostname", do_general_hostname, usage_general_hostname, TRUE, TRUE},
         {"permissions", do_general_permissions, usage_general_permissions, TRUE, TRUE},
         {"logging", do_general_logging, usage_general_logging, TRUE, TRUE},
+        {"statistics", do_general_statistics, usage_general_statistics, TRUE, TRUE},
         {"reload", do_general_reload, usage_general_reload, FALSE, FALSE},
         {NULL, do_general_status, usage_general, TRUE, TRUE},
     };
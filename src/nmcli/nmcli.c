@@ -97,6 +97,7 @@ static NmCli nm_cli = {
     .ask                         = FALSE,
     .complete                    = FALSE,
     .nmc_config.show_secrets     = FALSE,
+    .nmc_config.stream_output    = FALSE,
     .nmc_config.in_editor        = FALSE,
     .nmc_config.palette          = _NMC_COLOR_PALETTE_INIT(),
     .editor_status_line          = FALSE,
@@ -192,6 +193,7 @@ complete_fields(const char *option, const char *prefix)
     complete_field(h, metagen_device_status);
     complete_field(h, metagen_device_detail_general);
     complete_field(h, metagen_device_detail_connections);
+    complete_field(h, metagen_device_detail_timing);
     complete_field(h, metagen_device_detail_capabilities);
     complete_field(h, metagen_device_detail_wired_properties);
     complete_field(h, metagen_device_detail_wifi_properties);
@@ -250,6 +252,8 @@ usage(void)
         "  -o, --overview                           overview mode\n"
         "  -p, --pretty                             pretty output\n"
         "  -s, --show-secrets                       allow displaying passwords\n"
+        "      --stream                             print tabular output without waiting\n"
+        "                                           for all rows (column widths may vary)\n"
         "  -t, --terse                              terse output\n"
         "  -v, --version                            show program version\n"
         "  -w, --wait <seconds>                     set timeout waiting for finishing operations\n"
@@ -760,6 +764,7 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
                                  "--pretty",
                                  "--mode",
                                  "--overview",
+                                 "--stream",
                                  "--colors",
                                  "--escape",
                                  "--fields",
@@ -778,6 +783,8 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
 
         if (matches_arg(nmc, &argc, &argv, "-overview", NULL)) {
             nmc->nmc_config_mutable.overview = TRUE;
+        } else if (matches_arg(nmc, &argc, &argv, "-stream", NULL)) {
+            nmc->nmc_config_mutable.stream_output = TRUE;
         } else if (matches_arg(nmc, &argc, &argv, "-terse", NULL)) {
             if (nmc->nmc_config.print_output == NMC_PRINT_TERSE) {
                 g_string_printf(nmc->return_text,
@@ -100,7 +100,8 @@ typedef struct _NmcConfig {
     bool           in_editor;        /* Whether running the editor - nmcli con edit' */
     bool
         show_secrets; /* Whether to display secrets (both input and output): option '--show-secrets' */
-    bool            overview; /* Overview mode (hide default values) */
+    bool            overview;      /* Overview mode (hide default values) */
+    bool            stream_output; /* Print rows as they are produced: option '--stream' */
     NmcColorPalette palette;
 } NmcConfig;
 
@@ -178,6 +179,15 @@ typedef struct _NMCCommand {
     void (*usage)(void);
     bool needs_client;
     bool needs_nm_running;
+
+    /* Optional handler that serves read-only queries with a few targeted
+     * D-Bus calls, without creating an NMClient. It returns FALSE if the
+     * command is not eligible or the query failed, in which case the command
+     * falls back to @func with a full NMClient. */
+    gboolean (*func_light)(const struct _NMCCommand *cmd,
+                           NmCli *                   nmc,
+                           int                       argc,
+                           const char *const *       argv);
 } NMCCommand;
 
 void nmc_command_func_agent(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv);
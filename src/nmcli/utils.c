@@ -992,21 +992,11 @@ _print_data_cell_clear(gpointer cell_p)
     _print_data_cell_clear_text(cell);
 }
 
-static void
-_print_fill(const NmcConfig *   nmc_config,
-            gpointer const *    targets,
-            gpointer            targets_data,
-            const PrintDataCol *cols,
-            guint               cols_len,
-            GArray **           out_header_row,
-            GArray **           out_cells)
+static GArray *
+_print_fill_header(const NmcConfig *nmc_config, const PrintDataCol *cols, guint cols_len)
 {
-    GArray *               cells;
-    GArray *               header_row;
-    guint                  i_row, i_col;
-    guint                  targets_len;
-    NMMetaAccessorGetType  text_get_type;
-    NMMetaAccessorGetFlags text_get_flags;
+    GArray *header_row;
+    guint   i_col;
 
     header_row = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataHeaderCell), cols_len);
     g_array_set_clear_func(header_row, _print_data_header_cell_clear);
@@ -1048,10 +1038,33 @@ _print_fill(const NmcConfig *   nmc_config,
         }
     }
 
-    targets_len = NM_PTRARRAY_LEN(targets);
+    return header_row;
+}
+
+static GArray *
+_print_cells_new(const GArray *header_row, guint targets_len)
+{
+    GArray *cells;
 
     cells = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataCell), targets_len * header_row->len);
     g_array_set_clear_func(cells, _print_data_cell_clear);
+    return cells;
+}
+
+static void
+_print_fill_cells(const NmcConfig *nmc_config,
+                  gpointer const * targets,
+                  guint            targets_len,
+                  gpointer         targets_data,
+                  GArray *         header_row,
+                  GArray *         cells)
+{
+    guint                  i_row, i_col;
+    NMMetaAccessorGetType  text_get_type;
+    NMMetaAccessorGetFlags text_get_flags;
+
+    nm_assert(cells->len == 0);
+
     g_array_set_size(cells, targets_len * header_row->len);
 
     text_get_type  = nmc_print_output_to_accessor_get_type(nmc_config->print_output);
@@ -1145,6 +1158,12 @@ _print_fill(const NmcConfig *   nmc_config,
             }
         }
     }
+}
+
+static void
+_print_fill_widths(GArray *header_row, const GArray *cells, guint targets_len)
+{
+    guint i_row, i_col;
 
     for (i_col = 0; i_col < header_row->len; i_col++) {
         PrintDataHeaderCell *header_cell = &g_array_index(header_row, PrintDataHeaderCell, i_col);
@@ -1176,6 +1195,28 @@ _print_fill(const NmcConfig *   nmc_config,
 
         header_cell->width += 1;
     }
+}
+
+static void
+_print_fill(const NmcConfig *   nmc_config,
+            gpointer const *    targets,
+            gpointer            targets_data,
+            const PrintDataCol *cols,
+            guint               cols_len,
+            GArray **           out_header_row,
+            GArray **           out_cells)
+{
+    GArray *header_row;
+    GArray *cells;
+    guint   targets_len;
+
+    header_row = _print_fill_header(nmc_config, cols, cols_len);
+
+    targets_len = NM_PTRARRAY_LEN(targets);
+
+    cells = _print_cells_new(header_row, targets_len);
+    _print_fill_cells(nmc_config, targets, targets_len, targets_data, header_row, cells);
+    _print_fill_widths(header_row, cells, targets_len);
 
     *out_header_row = header_row;
     *out_cells      = cells;
@@ -1219,6 +1260,7 @@ _print_skip_column(const NmcConfig *nmc_config, const PrintDataHeaderCell *heade
 static void
 _print_do(const NmcConfig *          nmc_config,
           const char *               header_name_no_l10n,
+          gboolean                   print_header,
           guint                      col_len,
           guint                      row_len,
           const PrintDataHeaderCell *header_row,
@@ -1232,7 +1274,7 @@ _print_do(const NmcConfig *          nmc_config,
     g_assert(col_len);
 
     /* Main header */
-    if (nmc_config->print_output == NMC_PRINT_PRETTY && header_name_no_l10n) {
+    if (print_header && nmc_config->print_output == NMC_PRINT_PRETTY && header_name_no_l10n) {
         gs_free char *line = NULL;
         int           header_width;
         const char *  header_name = _(header_name_no_l10n);
@@ -1257,7 +1299,7 @@ _print_do(const NmcConfig *          nmc_config,
     str = !nmc_config->multiline_output ? g_string_sized_new(100) : NULL;
 
     /* print the header for the tabular form */
-    if (NM_IN_SET(nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
+    if (print_header && NM_IN_SET(nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
         && !nmc_config->multiline_output) {
         for (i_col = 0; i_col < col_len; i_col++) {
             const PrintDataHeaderCell *header_cell = &header_row[i_col];
@@ -1384,6 +1426,76 @@ _print_do(const NmcConfig *          nmc_config,
     }
 }
 
+/* Number of rows that we fill and print at once in streaming mode. In tabular
+ * mode, the column widths are determined by the first batch only. */
+#define PRINT_STREAM_BATCH_SIZE 500
+
+static gboolean
+_print_can_stream(const NmcConfig *nmc_config, const PrintDataCol *cols, guint cols_len)
+{
+    guint i_col;
+
+    /* Columns are only printed, if any row has a non-default value for it. In overview mode,
+     * and for properties that hide their default value, we only know that after seeing all
+     * rows. */
+    if (nmc_config->overview)
+        return FALSE;
+
+    for (i_col = 0; i_col < cols_len; i_col++) {
+        const NMMetaAbstractInfo *info = cols[i_col].selection_item->info;
+
+        if (cols[i_col].is_leaf && info->meta_type == &nm_meta_type_property_info
+            && ((const NMMetaPropertyInfo *) info)->hide_if_default)
+            return FALSE;
+    }
+
+    /* Only the tabular form needs the widths of all cells. For that, streaming is only
+     * used when requested, because later rows might not align with the sampled widths. */
+    return nmc_config->print_output == NMC_PRINT_TERSE || nmc_config->multiline_output
+           || nmc_config->stream_output;
+}
+
+static void
+_print_stream(const NmcConfig *   nmc_config,
+              gpointer const *    targets,
+              guint               targets_len,
+              gpointer            targets_data,
+              const char *        header_name_no_l10n,
+              const PrintDataCol *cols,
+              guint               cols_len)
+{
+    gs_unref_array GArray *header_row = NULL;
+    gs_unref_array GArray *cells      = NULL;
+    guint                  i_col;
+    guint                  i;
+
+    header_row = _print_fill_header(nmc_config, cols, cols_len);
+
+    /* we checked in _print_can_stream() that no cell will be hidden. */
+    for (i_col = 0; i_col < header_row->len; i_col++)
+        g_array_index(header_row, PrintDataHeaderCell, i_col).to_print = TRUE;
+
+    cells = _print_cells_new(header_row, NM_MIN(targets_len, PRINT_STREAM_BATCH_SIZE));
+
+    for (i = 0; i < targets_len; i += PRINT_STREAM_BATCH_SIZE) {
+        guint n = NM_MIN(targets_len - i, PRINT_STREAM_BATCH_SIZE);
+
+        _print_fill_cells(nmc_config, &targets[i], n, targets_data, header_row, cells);
+        if (i == 0)
+            _print_fill_widths(header_row, cells, n);
+
+        _print_do(nmc_config,
+                  header_name_no_l10n,
+                  i == 0,
+                  header_row->len,
+                  n,
+                  &g_array_index(header_row, PrintDataHeaderCell, 0),
+                  &g_array_index(cells, PrintDataCell, 0));
+
+        g_array_set_size(cells, 0);
+    }
+}
+
 gboolean
 nmc_print(const NmcConfig *                nmc_config,
           gpointer const *                 targets,
@@ -1398,14 +1510,30 @@ nmc_print(const NmcConfig *                nmc_config,
     guint                 cols_len;
     gs_unref_array GArray *header_row = NULL;
     gs_unref_array GArray *cells      = NULL;
+    guint                  targets_len;
 
     if (!_output_selection_parse(fields, fields_str, &cols_data, &cols_len, &gfree_keeper, error))
         return FALSE;
 
+    targets_len = NM_PTRARRAY_LEN(targets);
+
+    if (targets_len > 0 && cols_len > 0 && _print_can_stream(nmc_config, cols_data, cols_len)) {
+        /* print the rows as we go, instead of keeping all cells in memory. */
+        _print_stream(nmc_config,
+                      targets,
+                      targets_len,
+                      targets_data,
+                      header_name_no_l10n,
+                      cols_data,
+                      cols_len);
+        return TRUE;
+    }
+
     _print_fill(nmc_config, targets, targets_data, cols_data, cols_len, &header_row, &cells);
 
     _print_do(nmc_config,
               header_name_no_l10n,
+              TRUE,
               header_row->len,
               cells->len / header_row->len,
               &g_array_index(header_row, PrintDataHeaderCell, 0),
@@ -101,6 +101,10 @@ typedef enum {
     NMC_GENERIC_INFO_TYPE_GENERAL_LOGGING_DOMAINS,
     _NMC_GENERIC_INFO_TYPE_GENERAL_LOGGING_NUM,
 
+    NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_NAME = 0,
+    NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_VALUE,
+    _NMC_GENERIC_INFO_TYPE_GENERAL_STATISTICS_NUM,
+
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_ADDRESS = 0,
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_GATEWAY,
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_ROUTE,
@@ -233,6 +237,10 @@ typedef enum {
     NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_INTERFACE_FLAGS_PROMISC,
     _NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_INTERFACE_FLAGS_NUM,
 
+    NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_DURATION = 0,
+    NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_STAGES,
+    _NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_TIMING_NUM,
+
 } NmcGenericInfoType;
 
 #define NMC_HANDLE_COLOR(color)                          \
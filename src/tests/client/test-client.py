@@ -69,6 +69,10 @@ ENV_NM_TEST_REGENERATE = "NM_TEST_REGENERATE"
 # numbers enabled.
 ENV_NM_TEST_WITH_LINENO = "NM_TEST_WITH_LINENO"
 
+# (optional) Run the nmcli output benchmark with the given number of
+# connections. The benchmark only prints timings and is skipped by default.
+ENV_NM_TEST_CLIENT_BENCHMARK = "NM_TEST_CLIENT_BENCHMARK"
+
 ENV_NM_TEST_ASAN_OPTIONS = "NM_TEST_ASAN_OPTIONS"
 ENV_NM_TEST_LSAN_OPTIONS = "NM_TEST_LSAN_OPTIONS"
 ENV_NM_TEST_UBSAN_OPTIONS = "NM_TEST_UBSAN_OPTIONS"
@@ -431,6 +435,8 @@ class Configuration:
             v = os.environ.get(ENV_NM_TEST_REGENERATE, "0") == "1"
         elif name == ENV_NM_TEST_WITH_LINENO:
             v = os.environ.get(ENV_NM_TEST_WITH_LINENO, "0") == "1"
+        elif name == ENV_NM_TEST_CLIENT_BENCHMARK:
+            v = int(os.environ.get(ENV_NM_TEST_CLIENT_BENCHMARK, "0"))
         elif name in [
             ENV_NM_TEST_ASAN_OPTIONS,
             ENV_NM_TEST_LSAN_OPTIONS,
@@ -1663,6 +1669,282 @@ class TestNmcli(NmTestBase):
                 replace_cmd=replace_uuids,
             )
 
+    def _nmcli_env(self):
+        env = {}
+        for k in ["LD_LIBRARY_PATH", "DBUS_SESSION_BUS_ADDRESS"]:
+            val = os.environ.get(k, None)
+            if val is not None:
+                env[k] = val
+        env["LANG"] = "C"
+        env["LIBNM_USE_SESSION_BUS"] = "1"
+        env["LIBNM_USE_NO_UDEV"] = "1"
+        return env
+
+    def _run_nmcli(self, args, returncode=0, stderr=False):
+        # Unlike call_nmcli(), this does not compare against the expected
+        # output on disk but returns stdout (or stderr) for the caller to check.
+        p = subprocess.run(
+            [conf.get(ENV_NM_TEST_CLIENT_NMCLI_PATH)] + list(args),
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            env=self._nmcli_env(),
+        )
+        self.assertEqual(
+            p.returncode,
+            returncode,
+            "nmcli %s: %s" % (" ".join(args), p.stderr.decode("utf-8")),
+        )
+        return (p.stderr if stderr else p.stdout).decode("utf-8")
+
+    def _run_nmcli_multiline(self, args):
+        fields = {}
+        for line in self._run_nmcli(["-m", "multiline"] + list(args)).splitlines():
+            if not line:
+                continue
+            key, _, val = line.partition(":")
+            fields[key] = val.strip()
+        return fields
+
+    def _benchmark_nmcli(self, args):
+        start = time.monotonic()
+        p = subprocess.Popen(
+            [conf.get(ENV_NM_TEST_CLIENT_NMCLI_PATH)] + list(args),
+            stdout=subprocess.PIPE,
+            env=self._nmcli_env(),
+        )
+        t_first = None
+        n_lines = 0
+        for line in p.stdout:
+            if t_first is None:
+                t_first = time.monotonic() - start
+            n_lines += 1
+        p.stdout.close()
+        self.assertEqual(p.wait(), 0)
+        t_total = time.monotonic() - start
+        print(
+            "benchmark: nmcli %-16s: %6d lines, first line after %.3fs, total %.3fs"
+            % (" ".join(args), n_lines, t_first or 0.0, t_total)
+        )
+        return n_lines
+
+    def test_benchmark_con_show(self):
+        n = conf.get(ENV_NM_TEST_CLIENT_BENCHMARK)
+        if n <= 0:
+            self.skipTest(
+                "Benchmark disabled. Set %s to the number of connections"
+                % (ENV_NM_TEST_CLIENT_BENCHMARK)
+            )
+
+        self.srv = NMStubServer(self._testMethodName)
+        try:
+            for i in range(n):
+                self.srv.addConnection(
+                    {"connection": {"type": "802-3-ethernet", "id": "con-%d" % (i)}},
+                    do_verify_strict=False,
+                )
+
+            n_terse = self._benchmark_nmcli(["-t", "c", "s"])
+            n_table = self._benchmark_nmcli(["c", "s"])
+            n_stream = self._benchmark_nmcli(["--stream", "c", "s"])
+
+            self.assertEqual(n_terse, n)
+            self.assertEqual(n_table, n_stream)
+        finally:
+            self.srv.shutdown()
+            self.srv = None
+
+
+    def _set_activation_timing(self, dev_path, timing):
+        self.srv.setProperty(
+            dev_path,
+            "ActivationTiming",
+            dbus.Array(
+                [dbus.Struct((dbus.String(s), dbus.UInt64(t))) for s, t in timing],
+                signature="(st)",
+            ),
+        )
+
+    def test_device_show_timing(self):
+        self.srv = NMStubServer(self._testMethodName)
+        try:
+            eth0 = self.srv.op_AddObj("WiredDevice", iface="eth0")
+            self.srv.op_AddObj("WiredDevice", iface="eth1")
+
+            self._set_activation_timing(
+                eth0,
+                [
+                    ("prepare", 5000000),
+                    ("config", 5000500),
+                    ("ip-config", 5001000),
+                    ("dhcp4-start", 5001200),
+                    ("dhcp4-bound", 5250000),
+                    ("ip4-done", 5250100),
+                    ("ip-check", 5250200),
+                    ("secondaries", 5250300),
+                    ("activated", 5300250),
+                    ("deactivating", 9000000),
+                    ("disconnected", 9000100),
+                ],
+            )
+
+            f = self._run_nmcli_multiline(
+                ["-f", "GENERAL,TIMING", "device", "show", "eth0"]
+            )
+            self.assertEqual(f["GENERAL.DEVICE"], "eth0")
+            # The duration ends with "activated", the deactivation does not count.
+            self.assertEqual(f["TIMING.DURATION"], "300.250 ms")
+            self.assertEqual(f["TIMING.STAGES[1]"], "prepare: +0.000 ms")
+            self.assertEqual(f["TIMING.STAGES[5]"], "dhcp4-bound: +250.000 ms")
+            self.assertEqual(f["TIMING.STAGES[9]"], "activated: +300.250 ms")
+            self.assertEqual(f["TIMING.STAGES[11]"], "disconnected: +4000.100 ms")
+            self.assertNotIn("TIMING.STAGES[12]", f)
+
+            self.assertEqual(
+                self._run_nmcli(
+                    ["-g", "TIMING.DURATION", "device", "show", "eth0"]
+                ).strip(),
+                "300.250 ms",
+            )
+
+            self._set_activation_timing(
+                eth0,
+                [
+                    ("prepare", 1000),
+                    ("config", 2000),
+                    ("failed", 3501000),
+                    ("disconnected", 3600000),
+                ],
+            )
+            f = self._run_nmcli_multiline(["-f", "TIMING", "device", "show", "eth0"])
+            self.assertEqual(f["TIMING.DURATION"], "3500.000 ms")
+
+            # While still activating, the duration is until the last step.
+            self._set_activation_timing(eth0, [("prepare", 1000), ("config", 1500)])
+            f = self._run_nmcli_multiline(["-f", "TIMING", "device", "show", "eth0"])
+            self.assertEqual(f["TIMING.DURATION"], "0.500 ms")
+
+            # Without a recorded activation, the section is omitted.
+            f = self._run_nmcli_multiline(
+                ["-f", "GENERAL,TIMING", "device", "show", "eth1"]
+            )
+            self.assertEqual(f["GENERAL.DEVICE"], "eth1")
+            self.assertEqual([k for k in f if k.startswith("TIMING.")], [])
+        finally:
+            self.srv.shutdown()
+            self.srv = None
+
+    def test_device_show_light(self):
+        self.srv = NMStubServer(self._testMethodName)
+        try:
+            eth0 = self.srv.op_AddObj("WiredDevice", iface="eth0")
+            self.srv.op_AddObj("WiredDevice", iface="eth1")
+            self.srv.addConnection(
+                {
+                    "connection": {
+                        "type": "802-3-ethernet",
+                        "id": "con-1",
+                        "interface-name": "eth0",
+                    }
+                }
+            )
+
+            n_get_managed_objects = self.srv.op_GetManagedObjectsCount()
+
+            def get_value(field, ifname="eth0"):
+                return self._run_nmcli(
+                    ["-g", "GENERAL." + field, "device", "show", ifname]
+                ).rstrip("\n")
+
+            # These fields are served with a few D-Bus calls, without NMClient.
+            self.assertEqual(get_value("DEVICE"), "eth0")
+            self.assertEqual(get_value("DBUS-PATH"), eth0)
+            self.assertEqual(get_value("STATE"), "20 (unavailable)")
+            self.assertEqual(get_value("UDI"), "/sys/devices/virtual/eth0")
+            self.assertEqual(get_value("CONNECTION"), "")
+            self.assertEqual(
+                self.srv.op_GetManagedObjectsCount(), n_get_managed_objects
+            )
+
+            # Other fields, or an unknown device, need the full cache.
+            self.assertNotEqual(get_value("TYPE"), "")
+            self._run_nmcli(
+                ["-g", "GENERAL.STATE", "device", "show", "eth9"], returncode=10
+            )
+            self.assertEqual(
+                self.srv.op_GetManagedObjectsCount(), n_get_managed_objects + 2
+            )
+
+            self._run_nmcli(["connection", "up", "con-1"])
+
+            self.assertEqual(get_value("STATE"), "100 (connected)")
+            self.assertEqual(get_value("CONNECTION"), "con-1")
+            self.assertEqual(
+                get_value("CON-UUID"), self.srv.findConnectionUuid("con-1")
+            )
+
+            # The output matches the regular path, which is taken because of
+            # GENERAL.TYPE. Drop that line and compare the rest.
+            fields = "GENERAL.DEVICE,GENERAL.STATE,GENERAL.CONNECTION,GENERAL.CON-PATH"
+            for mode in [[], ["-t"], ["-p"]]:
+                light = self._run_nmcli(mode + ["-f", fields, "device", "show", "eth0"])
+                full = self._run_nmcli(
+                    mode + ["-f", fields + ",GENERAL.TYPE", "device", "show", "eth0"]
+                )
+                self.assertEqual(
+                    light.splitlines(),
+                    [
+                        l
+                        for l in full.splitlines()
+                        if not l.startswith("GENERAL.TYPE:")
+                    ],
+                )
+        finally:
+            self.srv.shutdown()
+            self.srv = None
+
+    def test_general_statistics(self):
+        self.srv = NMStubServer(self._testMethodName)
+        try:
+            self.assertIn(
+                "Error: failed to get statistics: Not authorized",
+                self._run_nmcli(["general", "statistics"], returncode=1, stderr=True),
+            )
+
+            self.srv.op_SetStatistics(
+                {
+                    "platform.netlink.rx.RTM_NEWROUTE": dbus.UInt64(1000),
+                    "auth.cache-hits": dbus.UInt64(7),
+                    "platform.dumps.sync": dbus.UInt64(0),
+                    "platform.dumps.time-max-usec": dbus.UInt64(1 << 40),
+                    # Values of other types are skipped.
+                    "platform.note": dbus.String("ignored"),
+                    "platform.count": dbus.UInt32(5),
+                }
+            )
+
+            # The entries are sorted by name.
+            self.assertEqual(
+                self._run_nmcli(["-t", "general", "statistics"]).splitlines(),
+                [
+                    "auth.cache-hits:7",
+                    "platform.dumps.sync:0",
+                    "platform.dumps.time-max-usec:1099511627776",
+                    "platform.netlink.rx.RTM_NEWROUTE:1000",
+                ],
+            )
+            self.assertEqual(
+                self._run_nmcli(["-g", "VALUE", "general", "statistics"]).splitlines(),
+                ["7", "0", "1099511627776", "1000"],
+            )
+
+            lines = self._run_nmcli(["general", "statistics"]).splitlines()
+            self.assertEqual(lines[0].split(), ["NAME", "VALUE"])
+            self.assertEqual(lines[1].split(), ["auth.cache-hits", "7"])
+            self.assertEqual(len(lines), 5)
+        finally:
+            self.srv.shutdown()
+            self.srv = None
+
 
 ###############################################################################
 
@@ -387,6 +387,7 @@ IFACE_DEVICE = "org.freedesktop.NetworkManager.Device"
 IFACE_WIFI = "org.freedesktop.NetworkManager.Device.Wireless"
 IFACE_TEST = "org.freedesktop.NetworkManager.LibnmGlibTest"
 IFACE_NM = "org.freedesktop.NetworkManager"
+IFACE_NM_DEBUG = "org.freedesktop.NetworkManager.Debug"
 IFACE_SETTINGS = "org.freedesktop.NetworkManager.Settings"
 IFACE_AGENT_MANAGER = "org.freedesktop.NetworkManager.AgentManager"
 IFACE_AGENT = "org.freedesktop.NetworkManager.SecretAgent"
@@ -811,6 +812,7 @@ PRP_DEVICE_DEVICE_TYPE = "DeviceType"
 PRP_DEVICE_AVAILABLE_CONNECTIONS = "AvailableConnections"
 PRP_DEVICE_LLDP_NEIGHBORS = "LldpNeighbors"
 PRP_DEVICE_INTERFACE_FLAGS = "InterfaceFlags"
+PRP_DEVICE_ACTIVATION_TIMING = "ActivationTiming"
 
 
 class Device(ExportedObj):
@@ -856,6 +858,7 @@ class Device(ExportedObj):
             PRP_DEVICE_DEVICE_TYPE: dbus.UInt32(devtype),
             PRP_DEVICE_AVAILABLE_CONNECTIONS: ExportedObj.to_path_array([]),
             PRP_DEVICE_INTERFACE_FLAGS: dbus.UInt32(3),  # up,lower-up
+            PRP_DEVICE_ACTIVATION_TIMING: dbus.Array([], signature="(st)"),
             PRP_DEVICE_LLDP_NEIGHBORS: dbus.Array(
                 [
                     dbus.Dictionary(
@@ -1532,6 +1535,7 @@ class NetworkManager(ExportedObj):
         ExportedObj.__init__(self, "/org/freedesktop/NetworkManager")
         self.devices = []
         self.active_connections = []
+        self.statistics = None
 
         props = {
             PRP_NM_DEVICES: ExportedObj.to_path_array(self.devices),
@@ -1730,6 +1734,16 @@ class NetworkManager(ExportedObj):
     def CheckConnectivity(self):
         raise BusErr.PermissionDeniedException("You fail")
 
+    @dbus.service.method(
+        dbus_interface=IFACE_NM_DEBUG, in_signature="", out_signature="a{sv}"
+    )
+    def GetStatistics(self):
+        # Like the D-Bus policy of the daemon, deny access until the test
+        # sets some statistics.
+        if self.statistics is None:
+            raise BusErr.PermissionDeniedException("Not authorized")
+        return self.statistics
+
     @dbus.service.signal(IFACE_NM, signature="o")
     def DeviceAdded(self, devpath):
         pass
@@ -1824,6 +1838,16 @@ class NetworkManager(ExportedObj):
     def Quit(self):
         gl.mainloop.quit()
 
+    # The number of GetManagedObjects() calls so far. Each NMClient makes one
+    # on start, so this tells whether a client used the full cache.
+    @dbus.service.method(IFACE_TEST, in_signature="", out_signature="u")
+    def GetManagedObjectsCount(self):
+        return gl.object_manager.get_managed_objects_count
+
+    @dbus.service.method(IFACE_TEST, in_signature="a{sv}", out_signature="")
+    def SetStatistics(self, statistics):
+        self.statistics = statistics
+
     @dbus.service.method(IFACE_TEST, in_signature="a{ss}", out_signature="a(sss)")
     def FindConnections(self, selector_args):
         return [
@@ -2814,6 +2838,7 @@ class ObjectManager(dbus.service.Object):
     def __init__(self, object_path):
         dbus.service.Object.__init__(self, gl.bus, object_path)
         self.objs = []
+        self.get_managed_objects_count = 0
 
     def find_object(self, path):
         for o in self.objs:
@@ -2844,6 +2869,7 @@ class ObjectManager(dbus.service.Object):
         sender_keyword="sender",
     )
     def GetManagedObjects(self, sender=None):
+        self.get_managed_objects_count += 1
         managed_objects = {}
         for obj in self.objs:
             managed_objects[obj.path] = obj.get_managed_ifaces()